@@ -0,0 +1,60 @@
+// Copyright (c) 2024, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Measure performance of double.parse and double.toString on values typical
+// of numeric JSON payloads.
+
+import 'package:benchmark_harness/benchmark_harness.dart';
+
+int checksum = 0;
+
+class DoubleParse extends BenchmarkBase {
+  final List<String> inputs;
+
+  DoubleParse(String name, this.inputs) : super('DoubleParse.$name');
+
+  @override
+  void run() {
+    for (final input in inputs) {
+      if (double.parse(input) > 0) checksum++;
+    }
+  }
+}
+
+class DoublePrint extends BenchmarkBase {
+  final List<double> inputs;
+
+  DoublePrint(String name, this.inputs) : super('DoublePrint.$name');
+
+  @override
+  void run() {
+    for (final input in inputs) {
+      checksum += input.toString().length;
+    }
+  }
+}
+
+// Values with a few fraction digits, e.g. latencies and ratios.
+final short = [for (int i = 1; i <= 100; i++) i * 1.25 + i / 100];
+
+// Values that need all 17 significant digits to round-trip.
+final long = [for (int i = 1; i <= 100; i++) 1 / (i + 0.3)];
+
+// Values with large exponents.
+final exponent = [for (int i = 1; i <= 100; i++) i * 1.5e200];
+
+void main() {
+  final benchmarks = [
+    DoubleParse('Short', [for (final d in short) d.toString()]),
+    DoubleParse('Long', [for (final d in long) d.toString()]),
+    DoubleParse('Exponent', [for (final d in exponent) d.toString()]),
+    DoublePrint('Short', short),
+    DoublePrint('Long', long),
+    DoublePrint('Exponent', exponent),
+  ];
+  for (final benchmark in benchmarks) {
+    benchmark.report();
+  }
+  if (checksum == 0) throw StateError('Unexpected checksum: 0');
+}
@@ -0,0 +1,157 @@
+// Copyright (c) 2024, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Models server-style allocation behavior: a steady-state live heap that is
+// continuously replaced, mixed with short-lived garbage, large objects, weak
+// references and finalizers.
+//
+// Each benchmark reports throughput, plus the distribution of the time taken
+// by fixed-size batches of work. GC pauses show up in the upper percentiles
+// of the batch times.
+
+import 'dart:typed_data';
+
+import 'package:benchmark_harness/benchmark_harness.dart';
+
+class Node {
+  Node? next;
+  final int value;
+  final List<int> payload;
+
+  Node(this.value, int payloadLength)
+      : payload = List<int>.filled(payloadLength, value);
+}
+
+abstract class GcChurn extends BenchmarkBase {
+  // Number of allocations per timed batch.
+  static const int batchSize = 1000;
+
+  // Number of batches timed by [measureBatchTimes].
+  static const int latencyBatches = 20000;
+
+  GcChurn(String name) : super('GcChurn.$name');
+
+  /// Allocates [batchSize] objects according to the benchmark's pattern.
+  void runBatch();
+
+  @override
+  void run() {
+    for (int i = 0; i < 10; i++) {
+      runBatch();
+    }
+  }
+
+  void measureBatchTimes() {
+    final times = Uint64List(latencyBatches);
+    final sw = Stopwatch()..start();
+    for (int i = 0; i < latencyBatches; i++) {
+      final start = sw.elapsedMicroseconds;
+      runBatch();
+      times[i] = sw.elapsedMicroseconds - start;
+    }
+    times.sort();
+    int percentile(int p) => times[p * times.length ~/ 100];
+    print('$name.BatchPercentile50(RunTimeRaw): ${percentile(50)} us.');
+    print('$name.BatchPercentile90(RunTimeRaw): ${percentile(90)} us.');
+    print('$name.BatchPercentile99(RunTimeRaw): ${percentile(99)} us.');
+    print('$name.BatchMax(RunTimeRaw): ${times.last} us.');
+  }
+}
+
+/// Objects that die young, with a small live heap: scavenger throughput.
+class ShortLived extends GcChurn {
+  int checksum = 0;
+
+  ShortLived() : super('ShortLived');
+
+  @override
+  void runBatch() {
+    for (int i = 0; i < GcChurn.batchSize; i++) {
+      checksum += Node(i, 4).payload.length;
+    }
+  }
+}
+
+/// A live heap of [liveNodes] objects where every allocation replaces the
+/// oldest one, so objects survive long enough to be promoted and old-space
+/// marking and sweeping is exercised.
+class SteadyState extends GcChurn {
+  final List<Node?> live;
+  int cursor = 0;
+
+  SteadyState(String name, int liveNodes)
+      : live = List<Node?>.filled(liveNodes, null),
+        super('SteadyState.$name');
+
+  @override
+  void runBatch() {
+    for (int i = 0; i < GcChurn.batchSize; i++) {
+      final node = Node(i, 8);
+      // Link to a live neighbour so the heap is a graph, not a flat array.
+      node.next = live[(cursor * 7) % live.length];
+      live[cursor] = node;
+      if (++cursor == live.length) cursor = 0;
+    }
+  }
+}
+
+/// Large objects allocated directly in old space, with a bounded live set.
+class LargeObjects extends GcChurn {
+  final List<Uint8List?> live = List<Uint8List?>.filled(64, null);
+  int cursor = 0;
+
+  LargeObjects() : super('LargeObjects');
+
+  @override
+  void runBatch() {
+    // Fewer, larger allocations per batch: 1000 x 256 KB would be too slow.
+    for (int i = 0; i < GcChurn.batchSize ~/ 100; i++) {
+      live[cursor] = Uint8List(256 * 1024);
+      if (++cursor == live.length) cursor = 0;
+    }
+  }
+}
+
+/// Weak references and finalizers attached to short- and medium-lived
+/// objects, exercising weak processing in both the scavenger and marker.
+class WeakAndFinalizable extends GcChurn {
+  static int finalized = 0;
+  static final Finalizer<int> finalizer = Finalizer((_) => finalized++);
+
+  final List<Object?> live = List<Object?>.filled(10000, null);
+  final List<WeakReference<Object>?> weak =
+      List<WeakReference<Object>?>.filled(10000, null);
+  int cursor = 0;
+
+  WeakAndFinalizable() : super('WeakAndFinalizable');
+
+  @override
+  void runBatch() {
+    for (int i = 0; i < GcChurn.batchSize; i++) {
+      final object = Node(i, 2);
+      weak[cursor] = WeakReference(object);
+      if ((i & 7) == 0) {
+        finalizer.attach(object, i);
+        live[cursor] = object;
+      }
+      if (++cursor == live.length) cursor = 0;
+    }
+  }
+}
+
+void main() {
+  final benchmarks = <GcChurn>[
+    ShortLived(),
+    SteadyState('Small', 10000),
+    SteadyState('Large', 1000000),
+    LargeObjects(),
+    WeakAndFinalizable(),
+  ];
+  for (final benchmark in benchmarks) {
+    benchmark.report();
+    benchmark.measureBatchTimes();
+  }
+  final shortLived = benchmarks[0] as ShortLived;
+  if (shortLived.checksum == 0) throw StateError('Unexpected checksum: 0');
+}
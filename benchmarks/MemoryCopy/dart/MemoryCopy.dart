@@ -224,6 +224,55 @@ class Uint8ListCopyViaSetRangeBenchmark extends Uint8ListCopyBenchmark {
   }
 }
 
+class Uint8ListCopyViaConstantSetRangeBenchmark
+    extends Uint8ListCopyBenchmark {
+  // Copies of a small constant length are unrolled by the compiler.
+  static const constantBytes = 64;
+
+  Uint8ListCopyViaConstantSetRangeBenchmark()
+      : super('setRangeConstant', constantBytes);
+
+  @override
+  void run(int rounds) {
+    for (int r = 0; r < rounds; r++) {
+      result.setRange(0, constantBytes, input);
+    }
+  }
+}
+
+class Uint8ListFillViaFillRangeBenchmark extends MemoryCopyBenchmark {
+  static const fillValue = 0x5a;
+
+  final int count;
+  late Uint8List result;
+
+  Uint8ListFillViaFillRangeBenchmark(int bytes)
+      : count = bytes,
+        super('$bytes.fillRange.TypedData.Uint8', bytes);
+
+  @override
+  void setup() {
+    result = Uint8List(maxSizeInBytes);
+  }
+
+  @override
+  void teardown() {
+    for (int i = 0; i < maxSizeInBytes; ++i) {
+      final expected = i < count ? fillValue : 0;
+      if (result[i] != expected) {
+        throw 'Expected result[$i] = $expected, got ${result[i]}';
+      }
+    }
+  }
+
+  @override
+  void run(int rounds) {
+    for (int r = 0; r < rounds; r++) {
+      result.fillRange(0, count, fillValue);
+    }
+  }
+}
+
 abstract class Float64ListCopyBenchmark extends MemoryCopyBenchmark {
   final int count;
   late Float64List input;
@@ -468,7 +517,9 @@ void main(List<String> args) {
       PointerDoubleCopyViaSetRangeBenchmark(bytes),
       Uint8ListCopyViaSetRangeBenchmark(bytes),
       Float64ListCopyViaSetRangeBenchmark(bytes),
+      Uint8ListFillViaFillRangeBenchmark(bytes),
     ],
+    Uint8ListCopyViaConstantSetRangeBenchmark(),
   ];
   for (var bench in benchmarks) {
     if (filter == null || bench.name.contains(filter)) {
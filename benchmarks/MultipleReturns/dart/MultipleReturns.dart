@@ -15,6 +15,9 @@ String input2 = input1.toString();
 const int N = 1000000;
 final int expectedSum = (input1 + input2.length) * N;
 
+double input3 = double.parse('0.5');
+final double expectedDoubleSum = 3 * input3 * N;
+
 class ResultClass {
   final int result0;
   final String result1;
@@ -84,6 +87,21 @@ ResultClass forwardedClass() => notInlinedClass();
 ({int result0, String result1}) forwardedRecordNamed() =>
     notInlinedRecordNamed();
 
+@pragma('vm:prefer-inline')
+@pragma('wasm:prefer-inline')
+@pragma('dart2js:prefer-inline')
+(double, double) inlinedRecordDouble() => (input3, 2 * input3);
+
+@pragma('vm:never-inline')
+@pragma('wasm:never-inline')
+@pragma('dart2js:never-inline')
+(double, double) notInlinedRecordDouble() => (input3, 2 * input3);
+
+@pragma('vm:never-inline')
+@pragma('wasm:never-inline')
+@pragma('dart2js:never-inline')
+(double, double) forwardedRecordDouble() => notInlinedRecordDouble();
+
 class BenchInlinedList extends BenchmarkBase {
   BenchInlinedList() : super('MultipleReturns.Inlined.List');
 
@@ -277,20 +295,73 @@ class BenchForwardedRecordNamed extends BenchmarkBase {
   }
 }
 
+class BenchInlinedRecordDouble extends BenchmarkBase {
+  BenchInlinedRecordDouble() : super('MultipleReturns.Inlined.RecordDouble');
+
+  @override
+  void run() {
+    double sum = 0;
+    for (int i = 0; i < N; ++i) {
+      final result = inlinedRecordDouble();
+      final double r0 = result.$1;
+      final double r1 = result.$2;
+      sum += r0 + r1;
+    }
+    if (sum != expectedDoubleSum) throw 'Bad result: $sum';
+  }
+}
+
+class BenchNotInlinedRecordDouble extends BenchmarkBase {
+  BenchNotInlinedRecordDouble()
+      : super('MultipleReturns.NotInlined.RecordDouble');
+
+  @override
+  void run() {
+    double sum = 0;
+    for (int i = 0; i < N; ++i) {
+      final result = notInlinedRecordDouble();
+      final double r0 = result.$1;
+      final double r1 = result.$2;
+      sum += r0 + r1;
+    }
+    if (sum != expectedDoubleSum) throw 'Bad result: $sum';
+  }
+}
+
+class BenchForwardedRecordDouble extends BenchmarkBase {
+  BenchForwardedRecordDouble()
+      : super('MultipleReturns.Forwarded.RecordDouble');
+
+  @override
+  void run() {
+    double sum = 0;
+    for (int i = 0; i < N; ++i) {
+      final result = forwardedRecordDouble();
+      final double r0 = result.$1;
+      final double r1 = result.$2;
+      sum += r0 + r1;
+    }
+    if (sum != expectedDoubleSum) throw 'Bad result: $sum';
+  }
+}
+
 void main() {
   final benchmarks = [
     BenchInlinedList(),
     BenchInlinedClass(),
     BenchInlinedRecord(),
     BenchInlinedRecordNamed(),
+    BenchInlinedRecordDouble(),
     BenchNotInlinedList(),
     BenchNotInlinedClass(),
     BenchNotInlinedRecord(),
     BenchNotInlinedRecordNamed(),
+    BenchNotInlinedRecordDouble(),
     BenchForwardedList(),
     BenchForwardedClass(),
     BenchForwardedRecord(),
     BenchForwardedRecordNamed(),
+    BenchForwardedRecordDouble(),
   ];
 
   for (final benchmark in benchmarks) {
@@ -0,0 +1,193 @@
+// Copyright (c) 2024, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+/// Benchmarks for the socket and file IO paths through the event handler:
+/// loopback TCP echo with one and many connections, TCP bulk transfer and
+/// parallel file reads.
+
+import 'dart:async';
+import 'dart:io';
+import 'dart:typed_data';
+
+import 'package:benchmark_harness/benchmark_harness.dart';
+
+/// One client connection to an echo server. [roundTrip] sends [message] and
+/// completes once the same number of bytes has been echoed back.
+class EchoClient {
+  final Socket socket;
+  Completer<void>? _pending;
+  int _expected = 0;
+
+  EchoClient(this.socket) {
+    socket.setOption(SocketOption.tcpNoDelay, true);
+    socket.listen((data) {
+      _expected -= data.length;
+      if (_expected == 0) {
+        final pending = _pending!;
+        _pending = null;
+        pending.complete();
+      }
+    });
+  }
+
+  Future<void> roundTrip(Uint8List message) {
+    _expected += message.length;
+    final pending = _pending = Completer<void>();
+    socket.add(message);
+    return pending.future;
+  }
+}
+
+/// Echoes every byte received back to the sender.
+Future<ServerSocket> startEchoServer() async {
+  final server = await ServerSocket.bind(InternetAddress.loopbackIPv4, 0);
+  server.listen((socket) {
+    socket.setOption(SocketOption.tcpNoDelay, true);
+    socket.listen(socket.add, onDone: socket.destroy);
+  });
+  return server;
+}
+
+/// Each run does one request/response round trip on every connection
+/// concurrently, like a server handling [connections] clients.
+class TcpEcho extends AsyncBenchmarkBase {
+  final int connections;
+  final Uint8List message;
+  late ServerSocket _server;
+  final List<EchoClient> _clients = [];
+
+  TcpEcho(this.connections, int messageSize)
+      : message = Uint8List(messageSize),
+        super('SocketEcho.TcpEcho.${connections}x$messageSize');
+
+  @override
+  Future<void> setup() async {
+    _server = await startEchoServer();
+    for (int i = 0; i < connections; i++) {
+      final socket = await Socket.connect(_server.address, _server.port);
+      _clients.add(EchoClient(socket));
+    }
+  }
+
+  @override
+  Future<void> teardown() async {
+    for (final client in _clients) {
+      client.socket.destroy();
+    }
+    _clients.clear();
+    await _server.close();
+  }
+
+  @override
+  Future<void> run() async {
+    await Future.wait([
+      for (final client in _clients) client.roundTrip(message),
+    ]);
+  }
+
+  /// Reports the distribution of single round-trip latencies.
+  Future<void> reportLatency(int samples) async {
+    await setup();
+    final times = Uint64List(samples);
+    final sw = Stopwatch()..start();
+    final client = _clients.first;
+    for (int i = 0; i < samples; i++) {
+      final start = sw.elapsedMicroseconds;
+      await client.roundTrip(message);
+      times[i] = sw.elapsedMicroseconds - start;
+    }
+    await teardown();
+    times.sort();
+    int percentile(int p) => times[p * times.length ~/ 100];
+    print('$name.Percentile50(RunTimeRaw): ${percentile(50)} us.');
+    print('$name.Percentile99(RunTimeRaw): ${percentile(99)} us.');
+  }
+}
+
+/// Each run streams [totalBytes] through a single connection and waits for
+/// all of it to be echoed back.
+class TcpBulk extends AsyncBenchmarkBase {
+  static const int totalBytes = 4 * 1024 * 1024;
+  static const int chunkSize = 64 * 1024;
+  final Uint8List chunk = Uint8List(chunkSize);
+  late ServerSocket _server;
+  late EchoClient _client;
+
+  TcpBulk() : super('SocketEcho.TcpBulk');
+
+  @override
+  Future<void> setup() async {
+    _server = await startEchoServer();
+    _client = EchoClient(await Socket.connect(_server.address, _server.port));
+  }
+
+  @override
+  Future<void> teardown() async {
+    _client.socket.destroy();
+    await _server.close();
+  }
+
+  @override
+  Future<void> run() async {
+    for (int sent = 0; sent < totalBytes; sent += chunkSize) {
+      await _client.roundTrip(chunk);
+    }
+  }
+}
+
+/// Each run reads [fileCount] files of [fileSize] bytes concurrently.
+class ParallelFileRead extends AsyncBenchmarkBase {
+  static const int fileCount = 16;
+  static const int fileSize = 256 * 1024;
+  late Directory _tempDir;
+  final List<File> _files = [];
+  int _bytesRead = 0;
+
+  ParallelFileRead() : super('SocketEcho.ParallelFileRead');
+
+  @override
+  Future<void> setup() async {
+    _tempDir = Directory.systemTemp.createTempSync();
+    for (int i = 0; i < fileCount; i++) {
+      final file = File(_tempDir.uri.resolve('file$i').toFilePath());
+      file.writeAsBytesSync(Uint8List(fileSize));
+      _files.add(file);
+    }
+  }
+
+  @override
+  Future<void> teardown() async {
+    _tempDir.deleteSync(recursive: true);
+    if (_bytesRead == 0) throw StateError('Nothing was read');
+  }
+
+  @override
+  Future<void> run() async {
+    final contents =
+        await Future.wait([for (final file in _files) file.readAsBytes()]);
+    for (final bytes in contents) {
+      _bytesRead += bytes.length;
+    }
+  }
+}
+
+void main() async {
+  final echoBenchmarks = [
+    TcpEcho(1, 64),
+    TcpEcho(64, 64),
+    TcpEcho(64, 4096),
+  ];
+  for (final benchmark in echoBenchmarks) {
+    await benchmark.report();
+    await benchmark.reportLatency(10000);
+  }
+
+  final benchmarks = [
+    TcpBulk(),
+    ParallelFileRead(),
+  ];
+  for (final benchmark in benchmarks) {
+    await benchmark.report();
+  }
+}
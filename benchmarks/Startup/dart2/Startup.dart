@@ -59,8 +59,9 @@ Future<void> main(List<String> args) async {
   void report(String name, String isolateId) {
     var filtered = events.where((event) => event['name'] == name);
     if (isolateId != null) {
-      filtered =
-          filtered.where((event) => event['args']['isolateId'] == isolateId);
+      // Events recorded before the isolate exists have no arguments.
+      filtered = filtered.where((event) =>
+          (event['args'] ?? const {})['isolateId'] == isolateId);
     }
     var micros;
     final durations = filtered.where((event) => event['ph'] == 'X');
@@ -81,7 +82,13 @@ Future<void> main(List<String> args) async {
     print('Startup.$name(StartupTime): $micros us.');
   }
 
+  report('Dart::Init', null);
+  report('ReadVMSnapshot', null);
   report('CreateIsolateGroupAndSetupHelper', null);
   report('InitializeIsolate', mainIsolateId);
   report('ReadProgramSnapshot', mainIsolateId);
+  // Phases of reading the program snapshot.
+  report('ReadAlloc', mainIsolateId);
+  report('ReadFill', mainIsolateId);
+  report('PostLoad', mainIsolateId);
 }
@@ -0,0 +1,54 @@
+// Copyright (c) 2024, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Measure performance of converting strings to lower and upper case.
+
+import 'package:benchmark_harness/benchmark_harness.dart';
+
+int changedCount = 0;
+
+class StringCase extends BenchmarkBase {
+  final List<String> inputs;
+
+  StringCase(String name, this.inputs) : super('StringCase.$name');
+
+  @override
+  void run() {
+    for (final input in inputs) {
+      if (!identical(input.toLowerCase(), input)) {
+        changedCount++;
+      }
+      if (!identical(input.toUpperCase(), input)) {
+        changedCount++;
+      }
+    }
+  }
+}
+
+// HTTP header names as they are usually sent.
+const headers = [
+  'Accept',
+  'Accept-Encoding',
+  'Cache-Control',
+  'Connection',
+  'Content-Length',
+  'Content-Type',
+  'Host',
+  'If-None-Match',
+  'User-Agent',
+  'X-Forwarded-For',
+];
+
+void main() {
+  final benchmarks = [
+    StringCase('Headers', headers),
+    StringCase('Headers.Lower', [for (final h in headers) h.toLowerCase()]),
+    StringCase('Latin1', [for (final h in headers) '$h-été']),
+    StringCase('TwoByte', [for (final h in headers) '$h-Δ']),
+  ];
+  for (final benchmark in benchmarks) {
+    benchmark.report();
+  }
+  if (changedCount == 0) throw StateError('Unexpected changedCount: 0');
+}
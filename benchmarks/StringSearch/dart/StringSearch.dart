@@ -0,0 +1,55 @@
+// Copyright (c) 2024, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Measure performance of searching for a substring in a long string.
+
+import 'package:benchmark_harness/benchmark_harness.dart';
+
+int foundCount = 0;
+
+class StringSearch extends BenchmarkBase {
+  final String haystack;
+  final List<String> needles;
+
+  StringSearch(String name, this.haystack, this.needles)
+      : super('StringSearch.$name.${haystack.length}');
+
+  @override
+  void run() {
+    for (final needle in needles) {
+      if (haystack.indexOf(needle) >= 0) {
+        foundCount++;
+      }
+      if (haystack.contains(needle, 1)) {
+        foundCount++;
+      }
+    }
+  }
+}
+
+// A haystack where the first character of the needles is rare.
+String rareFirst(int length) => 'abcdefghijklmnopqrstuvw' * (length ~/ 23);
+
+// A haystack where most positions match a prefix of the needles.
+String commonPrefix(int length) => 'a' * length;
+
+void main() {
+  const length = 1000;
+  final oneByteNeedles = ['xyz', 'wab', 'aaaab', 'key:1000'];
+  // The haystacks end in an em space, which makes them two-byte strings.
+  final twoByteNeedles = ['\u{1F600}x', 'w\u2003', 'aaaa\u2003'];
+  final benchmarks = [
+    StringSearch('OneByte.RareFirst', rareFirst(length), oneByteNeedles),
+    StringSearch('OneByte.CommonPrefix', commonPrefix(length), oneByteNeedles),
+    StringSearch(
+        'TwoByte.RareFirst', rareFirst(length) + '\u2003', twoByteNeedles),
+    StringSearch('TwoByte.CommonPrefix', commonPrefix(length) + '\u2003',
+        twoByteNeedles),
+  ];
+  for (final benchmark in benchmarks) {
+    benchmark.report();
+  }
+  // 'wab' is found in the RareFirst haystacks, with and without a start.
+  if (foundCount == 0) throw StateError('Unexpected foundCount: $foundCount');
+}
@@ -10,6 +10,8 @@ void main() {
     Int8ToInt8.new,
     Int8ToUint8Clamped.new,
     Int8ViewToInt8.new,
+    Int8SmallCopies.new,
+    Int8Fill.new,
     ByteSwap.new,
   ];
 
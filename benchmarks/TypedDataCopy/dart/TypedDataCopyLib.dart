@@ -118,6 +118,49 @@ class Int8ToUint8Clamped extends BenchmarkBase {
   }
 }
 
+class Int8SmallCopies extends BenchmarkBase {
+  Int8SmallCopies() : super('TypedDataCopy.Int8SmallCopies');
+
+  final a1 = Int8List(size);
+  final a2 = Int8List(size);
+
+  @override
+  void setup() {
+    for (int i = 0; i < a2.length; i++) {
+      a2[i] = i;
+    }
+  }
+
+  @override
+  void run() {
+    // Copy in chunks of 64 bytes.
+    for (int i = 0; i < size; i += 64) {
+      a1.setRange(i, i + 64, a2, i);
+    }
+    final check = a1[a1.length - 1];
+    if (check != -1) {
+      throw 'Bad $check';
+    }
+  }
+}
+
+class Int8Fill extends BenchmarkBase {
+  Int8Fill() : super('TypedDataCopy.Int8Fill');
+
+  final a1 = Int8List(size);
+  int value = 0;
+
+  @override
+  void run() {
+    value = (value + 1) & 0x7f;
+    a1.fillRange(0, a1.length, value);
+    final check = a1[a1.length - 1];
+    if (check != value) {
+      throw 'Bad $check';
+    }
+  }
+}
+
 class ByteSwap extends BenchmarkBase {
   ByteSwap() : super('TypedDataCopy.ByteSwap');
 
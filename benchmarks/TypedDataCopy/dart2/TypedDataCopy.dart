@@ -12,6 +12,8 @@ void main() {
     () => Int8ToInt8(),
     () => Int8ToUint8Clamped(),
     () => Int8ViewToInt8(),
+    () => Int8SmallCopies(),
+    () => Int8Fill(),
     () => ByteSwap(),
   ];
 
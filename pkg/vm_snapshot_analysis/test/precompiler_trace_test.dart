@@ -100,6 +100,28 @@ void main() async {
       });
     });
 
+    test('call-sites', () async {
+      await withFlag(testSource, '--trace_precompiler_to', (json) async {
+        final jsonRaw = await loadJson(File(json));
+        final strings = (jsonRaw['strings'] as List).cast<String>();
+        final calls = jsonRaw['calls'] as List;
+        expect(calls.length % 5, equals(0));
+
+        final kinds = <String>{};
+        final dynamicSelectors = <String>{};
+        for (var i = 0; i < calls.length; i += 5) {
+          final kind = calls[i + 2] as String;
+          kinds.add(kind);
+          if (kind == 'I' || kind == 'P') {
+            dynamicSelectors.add(strings[calls[i + 3] as int]);
+          }
+        }
+        expect(kinds, everyElement(isIn(['S', 'D', 'P', 'T', 'I', 'U'])));
+        // The tear-off is taken from a dynamic receiver.
+        expect(dynamicSelectors, contains(endsWith('get:tornOff')));
+      });
+    });
+
     test('collapse-by-package', () async {
       await withFlag(testSource, '--trace_precompiler_to', (json) async {
         final jsonRaw = await loadJson(File(json));
@@ -15,17 +15,30 @@
 namespace dart {
 namespace bin {
 
-static EventHandler* event_handler = nullptr;
+// The first entry is also used for timers.
+static EventHandler** event_handlers = nullptr;
+static intptr_t event_handler_count = 0;
 static Monitor* shutdown_monitor = nullptr;
 
+intptr_t EventHandler::thread_count_ = 1;
+
 void EventHandler::Start() {
   // Initialize global socket registry.
   ListeningSocketRegistry::Initialize();
+  Socket::InitLookupMonitor();
 
-  ASSERT(event_handler == nullptr);
+  ASSERT(event_handlers == nullptr);
   shutdown_monitor = new Monitor();
-  event_handler = new EventHandler();
-  event_handler->delegate_.Start(event_handler);
+#if defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID)
+  event_handler_count = thread_count_ > 1 ? thread_count_ : 1;
+#else
+  event_handler_count = 1;
+#endif
+  event_handlers = new EventHandler*[event_handler_count];
+  for (intptr_t i = 0; i < event_handler_count; i++) {
+    event_handlers[i] = new EventHandler();
+    event_handlers[i]->delegate_.Start(event_handlers[i]);
+  }
 
   if (!SocketBase::Initialize()) {
     FATAL("Failed to initialize sockets");
@@ -38,38 +51,55 @@ void EventHandler::NotifyShutdownDone() {
 }
 
 void EventHandler::Stop() {
-  if (event_handler == nullptr) {
+  if (event_handlers == nullptr) {
     return;
   }
 
-  // Wait until it has stopped.
-  {
-    MonitorLocker ml(shutdown_monitor);
+  for (intptr_t i = 0; i < event_handler_count; i++) {
+    // Wait until it has stopped.
+    {
+      MonitorLocker ml(shutdown_monitor);
 
-    // Signal to event handler that we want it to stop.
-    event_handler->delegate_.Shutdown();
-    ml.Wait(Monitor::kNoTimeout);
-  }
+      // Signal to event handler that we want it to stop.
+      event_handlers[i]->delegate_.Shutdown();
+      ml.Wait(Monitor::kNoTimeout);
+    }
 
-  // Cleanup
-  delete event_handler;
-  event_handler = nullptr;
+    // Cleanup
+    delete event_handlers[i];
+  }
+  delete[] event_handlers;
+  event_handlers = nullptr;
+  event_handler_count = 0;
   delete shutdown_monitor;
   shutdown_monitor = nullptr;
 
   // Destroy the global socket registry.
+  Socket::CleanupLookupMonitor();
   ListeningSocketRegistry::Cleanup();
 }
 
 EventHandlerImplementation* EventHandler::delegate() {
-  if (event_handler == nullptr) {
+  if (event_handlers == nullptr) {
     return nullptr;
   }
-  return &event_handler->delegate_;
+  return &event_handlers[0]->delegate_;
 }
 
 void EventHandler::SendFromNative(intptr_t id, Dart_Port port, int64_t data) {
-  event_handler->SendData(id, port, data);
+  EventHandler* handler = event_handlers[0];
+  if ((event_handler_count > 1) && (id != kTimerId)) {
+    // All Socket objects for a descriptor, e.g. the ones sharing a listening
+    // socket, and later reuses of the descriptor's number go to the same
+    // event handler, which keeps their commands ordered. The key is fixed
+    // when the socket is created, so a concurrent close can't move the
+    // socket to another event handler.
+    const intptr_t key = reinterpret_cast<Socket*>(id)->shard_key();
+    if (key >= 0) {
+      handler = event_handlers[key % event_handler_count];
+    }
+  }
+  handler->SendData(id, port, data);
 }
 
 /*
@@ -98,7 +128,7 @@ void FUNCTION_NAME(EventHandler_SendData)(Dart_NativeArguments args) {
     id = reinterpret_cast<intptr_t>(socket);
   }
   int64_t data = DartUtils::GetIntegerValue(Dart_GetNativeArgument(args, 2));
-  event_handler->SendData(id, dart_port, data);
+  EventHandler::SendFromNative(id, dart_port, data);
 }
 
 void FUNCTION_NAME(EventHandler_TimerMillisecondClock)(
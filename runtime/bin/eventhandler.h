@@ -623,14 +623,31 @@ class EventHandler {
    */
   static void Stop();
 
+  // The delegate of the first event handler. Only used on platforms that run
+  // a single event handler.
   static EventHandlerImplementation* delegate();
 
+  // Sends the command to the event handler owning the descriptor of the
+  // socket [id], or to the first event handler for timers.
   static void SendFromNative(intptr_t id, Dart_Port port, int64_t data);
 
+  // The number of event handler threads started by [Start]. Descriptors are
+  // sharded across them by their number. Only supported on Linux and
+  // Android; other platforms always use a single event handler.
+  static void set_thread_count(intptr_t thread_count) {
+    ASSERT((thread_count >= 1) && (thread_count <= kMaxThreadCount));
+    thread_count_ = thread_count;
+  }
+
+  // Each event handler thread also costs three descriptors.
+  static constexpr intptr_t kMaxThreadCount = 64;
+
  private:
   friend class EventHandlerImplementation;
   EventHandlerImplementation delegate_;
 
+  static intptr_t thread_count_;
+
   DISALLOW_COPY_AND_ASSIGN(EventHandler);
 };
 
@@ -390,7 +390,9 @@ void EventHandlerImplementation::HandleEvents(struct epoll_event* events,
 
 void EventHandlerImplementation::Poll(uword args) {
   ThreadSignalBlocker signal_blocker(SIGPROF);
-  const intptr_t kMaxEvents = 16;
+  // Busy servers have many descriptors ready at once, take them in few
+  // epoll_wait calls.
+  const intptr_t kMaxEvents = 128;
   struct epoll_event events[kMaxEvents];
   EventHandler* handler = reinterpret_cast<EventHandler*>(args);
   EventHandlerImplementation* handler_impl = &handler->delegate_;
@@ -103,7 +103,11 @@ static int InotifyEventToMask(struct inotify_event* e) {
 Dart_Handle FileSystemWatcher::ReadEvents(intptr_t id, intptr_t path_id) {
   USE(path_id);
   const intptr_t kEventSize = sizeof(struct inotify_event);
-  const intptr_t kBufferSize = kEventSize + NAME_MAX + 1;
+  // Read as many queued events as fit, instead of one per call, so that a
+  // burst of changes is delivered in a few batches.
+  const intptr_t kBufferSize = 16 * KB;
+  static_assert(kBufferSize >= kEventSize + NAME_MAX + 1,
+                "Buffer must hold the largest inotify event");
   uint8_t buffer[kBufferSize];
   intptr_t bytes =
       SocketBase::Read(id, buffer, kBufferSize, SocketBase::kAsync);
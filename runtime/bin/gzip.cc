@@ -4,9 +4,12 @@
 
 #include "bin/gzip.h"
 
+#include "bin/dartutils.h"
+#include "bin/file.h"
 #include "platform/allocation.h"
 #include "platform/assert.h"
 #include "platform/globals.h"
+#include "platform/utils.h"
 #include "zlib/zlib.h"
 
 namespace dart {
@@ -84,5 +87,119 @@ void Decompress(const uint8_t* input,
   free(chunk_out);
 }
 
+// The stream passed to the VM by GzipFileCallbacks for compressed files.
+struct GzipFileStream {
+  File* file;
+  z_stream* deflater;
+  uint8_t* buffer;
+};
+
+static constexpr intptr_t kGzipFileBufferSize = 64 * KB;
+static constexpr char kGzipFileSuffix[] = ".gz";
+
+// Set in the streams returned for compressed files, to tell them apart from
+// DartUtils streams. Both are malloc'ed, so the bit is otherwise clear.
+static constexpr uintptr_t kGzipFileStreamTag = 1;
+
+static GzipFileStream* AsGzipFileStream(void* stream) {
+  const uintptr_t address = reinterpret_cast<uintptr_t>(stream);
+  if ((address & kGzipFileStreamTag) == 0) {
+    return nullptr;
+  }
+  return reinterpret_cast<GzipFileStream*>(address & ~kGzipFileStreamTag);
+}
+
+static bool HasGzipSuffix(const char* name) {
+  const intptr_t name_length = strlen(name);
+  const intptr_t suffix_length = strlen(kGzipFileSuffix);
+  return (name_length > suffix_length) &&
+         (strcmp(name + name_length - suffix_length, kGzipFileSuffix) == 0);
+}
+
+// Compresses what's available in the deflater's input and writes the output.
+static void Deflate(GzipFileStream* stream, int flush) {
+  z_stream* deflater = stream->deflater;
+  int ret;
+  do {
+    deflater->avail_out = kGzipFileBufferSize;
+    deflater->next_out = stream->buffer;
+    ret = deflate(deflater, flush);
+    ASSERT((ret == Z_OK) || (ret == Z_STREAM_END) || (ret == Z_BUF_ERROR));
+    const intptr_t size_out = kGzipFileBufferSize - deflater->avail_out;
+    if (size_out > 0) {
+      bool bytes_written = stream->file->WriteFully(stream->buffer, size_out);
+      ASSERT(bytes_written);
+    }
+  } while ((deflater->avail_out == 0) ||
+           ((flush == Z_FINISH) && (ret != Z_STREAM_END)));
+}
+
+void* GzipFileCallbacks::Open(const char* name, bool write) {
+  void* file = DartUtils::OpenFile(name, write);
+  if ((file == nullptr) || !write || !HasGzipSuffix(name)) {
+    return file;
+  }
+  z_stream* deflater = reinterpret_cast<z_stream*>(malloc(sizeof(z_stream)));
+  deflater->zalloc = Z_NULL;
+  deflater->zfree = Z_NULL;
+  deflater->opaque = Z_NULL;
+  deflater->avail_in = 0;
+  deflater->next_in = Z_NULL;
+  // The fastest level still removes most of the redundancy of heap
+  // snapshots and similar outputs, without slowing down writing them much.
+  // 16 selects the gzip header.
+  int ret = deflateInit2(deflater, Z_BEST_SPEED, Z_DEFLATED, 16 + MAX_WBITS, 8,
+                         Z_DEFAULT_STRATEGY);
+  if (ret != Z_OK) {
+    free(deflater);
+    return file;
+  }
+  GzipFileStream* stream =
+      reinterpret_cast<GzipFileStream*>(malloc(sizeof(GzipFileStream)));
+  stream->file = reinterpret_cast<File*>(file);
+  stream->deflater = deflater;
+  stream->buffer = reinterpret_cast<uint8_t*>(malloc(kGzipFileBufferSize));
+  ASSERT((reinterpret_cast<uintptr_t>(stream) & kGzipFileStreamTag) == 0);
+  return reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(stream) |
+                                 kGzipFileStreamTag);
+}
+
+void GzipFileCallbacks::Write(const void* data,
+                              intptr_t length,
+                              void* stream) {
+  ASSERT(stream != nullptr);
+  GzipFileStream* gzip_stream = AsGzipFileStream(stream);
+  if (gzip_stream == nullptr) {
+    DartUtils::WriteFile(data, length, stream);
+    return;
+  }
+  const uint8_t* input = reinterpret_cast<const uint8_t*>(data);
+  while (length > 0) {
+    // avail_in is only 32 bits.
+    const intptr_t size_in = Utils::Minimum(length, kGzipFileBufferSize);
+    gzip_stream->deflater->avail_in = size_in;
+    gzip_stream->deflater->next_in = const_cast<uint8_t*>(input);
+    Deflate(gzip_stream, Z_NO_FLUSH);
+    ASSERT(gzip_stream->deflater->avail_in == 0);
+    input += size_in;
+    length -= size_in;
+  }
+}
+
+void GzipFileCallbacks::Close(void* stream) {
+  ASSERT(stream != nullptr);
+  GzipFileStream* gzip_stream = AsGzipFileStream(stream);
+  if (gzip_stream == nullptr) {
+    DartUtils::CloseFile(stream);
+    return;
+  }
+  Deflate(gzip_stream, Z_FINISH);
+  deflateEnd(gzip_stream->deflater);
+  free(gzip_stream->deflater);
+  free(gzip_stream->buffer);
+  DartUtils::CloseFile(gzip_stream->file);
+  free(gzip_stream);
+}
+
 }  // namespace bin
 }  // namespace dart
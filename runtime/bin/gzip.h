@@ -18,6 +18,25 @@ void Decompress(const uint8_t* input,
                 uint8_t** output,
                 intptr_t* output_length);
 
+// File callbacks for Dart_InitializeParams that compress the files opened for
+// writing whose names end in ".gz" with gzip as they are written, so that, for
+// example, heap snapshots written with NativeRuntime.writeHeapSnapshotToFile
+// can be stored and shipped compressed.
+//
+// Only those writes are wrapped. Open returns the DartUtils stream for any
+// other file, so reading uses DartUtils::ReadFile directly, and Write and
+// Close forward to DartUtils unless the stream is a compressed one.
+class GzipFileCallbacks {
+ public:
+  static void* Open(const char* name, bool write);
+  static void Write(const void* data, intptr_t length, void* stream);
+  static void Close(void* stream);
+
+ private:
+  DISALLOW_ALLOCATION();
+  DISALLOW_IMPLICIT_CONSTRUCTORS(GzipFileCallbacks);
+};
+
 }  // namespace bin
 }  // namespace dart
 
@@ -0,0 +1,86 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "bin/gzip.h"
+#include "bin/dartutils.h"
+#include "bin/directory.h"
+#include "bin/file.h"
+#include "platform/assert.h"
+#include "platform/globals.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+static const char* Concat(const char* a, const char* b) {
+  const intptr_t len = strlen(a) + strlen(b);
+  char* c = bin::DartUtils::ScopedCString(len + 1);
+  EXPECT_NOTNULL(c);
+  snprintf(c, len + 1, "%s%s", a, b);
+  return c;
+}
+
+// Writes [length] bytes of [data] in two calls through the callbacks.
+static void WriteWithCallbacks(const char* filename,
+                               const uint8_t* data,
+                               intptr_t length) {
+  void* stream = bin::GzipFileCallbacks::Open(filename, /*write=*/true);
+  EXPECT_NOTNULL(stream);
+  bin::GzipFileCallbacks::Write(data, length / 2, stream);
+  bin::GzipFileCallbacks::Write(data + length / 2, length - length / 2,
+                                stream);
+  bin::GzipFileCallbacks::Close(stream);
+}
+
+// Reads the whole file the way the VM does.
+static void ReadWithCallbacks(const char* filename,
+                              uint8_t** data,
+                              intptr_t* length) {
+  void* stream = bin::GzipFileCallbacks::Open(filename, /*write=*/false);
+  EXPECT_NOTNULL(stream);
+  bin::DartUtils::ReadFile(data, length, stream);
+  bin::GzipFileCallbacks::Close(stream);
+}
+
+TEST_CASE(GzipFileCallbacks) {
+  const char* temp_dir = bin::Directory::CreateTemp(
+      nullptr, Concat(bin::Directory::SystemTemp(nullptr), "/gzip_test"));
+  EXPECT_NOTNULL(temp_dir);
+
+  const intptr_t kLength = 200 * KB;
+  uint8_t* expected = reinterpret_cast<uint8_t*>(malloc(kLength));
+  for (intptr_t i = 0; i < kLength; i++) {
+    expected[i] = static_cast<uint8_t>((i / 7) ^ (i % 13));
+  }
+
+  // Files without the suffix are written as they are.
+  const char* plain = Concat(temp_dir, "/snapshot");
+  WriteWithCallbacks(plain, expected, kLength);
+  uint8_t* data = nullptr;
+  intptr_t length = -1;
+  ReadWithCallbacks(plain, &data, &length);
+  EXPECT_EQ(kLength, length);
+  EXPECT(memcmp(expected, data, kLength) == 0);
+  free(data);
+
+  // Files with the suffix are compressed, and read back compressed.
+  const char* compressed = Concat(temp_dir, "/snapshot.gz");
+  WriteWithCallbacks(compressed, expected, kLength);
+  data = nullptr;
+  length = -1;
+  ReadWithCallbacks(compressed, &data, &length);
+  EXPECT(length > 0);
+  EXPECT(length < kLength);
+  uint8_t* decompressed = nullptr;
+  intptr_t decompressed_length = -1;
+  bin::Decompress(data, length, &decompressed, &decompressed_length);
+  EXPECT_EQ(kLength, decompressed_length);
+  EXPECT(memcmp(expected, decompressed, kLength) == 0);
+  free(decompressed);
+  free(data);
+
+  free(expected);
+  bin::Directory::Delete(nullptr, temp_dir, /*recursive=*/true);
+}
+
+}  // namespace dart
@@ -14,16 +14,20 @@ Dart_Handle IOBuffer::Allocate(intptr_t size, uint8_t** buffer) {
   if (data == nullptr) {
     return Dart_Null();
   }
+  Dart_Handle result = Wrap(data, size);
+  if (buffer != nullptr) {
+    *buffer = data;
+  }
+  return result;
+}
+
+Dart_Handle IOBuffer::Wrap(uint8_t* data, intptr_t size) {
   Dart_Handle result = Dart_NewExternalTypedDataWithFinalizer(
       Dart_TypedData_kUint8, data, size, data, size, IOBuffer::Finalizer);
-
   if (Dart_IsError(result)) {
     Free(data);
     Dart_PropagateError(result);
   }
-  if (buffer != nullptr) {
-    *buffer = data;
-  }
   return result;
 }
 
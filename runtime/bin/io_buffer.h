@@ -20,6 +20,11 @@ class IOBuffer {
   // Allocate IO buffer storage.
   static uint8_t* Allocate(intptr_t size);
 
+  // Wrap IO buffer storage in an IO buffer dart object (of type Uint8List)
+  // which takes ownership of it. On failure the storage is freed and the
+  // error is propagated.
+  static Dart_Handle Wrap(uint8_t* data, intptr_t size);
+
   // Reallocate IO buffer storage.
   static uint8_t* Reallocate(uint8_t* buffer, intptr_t new_size);
 
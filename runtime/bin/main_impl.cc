@@ -134,6 +134,38 @@ static void WriteDepsFile() {
   file->Release();
 }
 
+// Key of the --jit-code-cache entry for the script being run, if any.
+static char* jit_code_cache_key = nullptr;
+
+#if !defined(DART_PRECOMPILED_RUNTIME)
+// Returns the --jit-code-cache snapshot if it was trained with the kernel
+// file 'script_name'. Otherwise switches to an app-jit training run which
+// replaces the cache on exit.
+static AppSnapshot* TryReadJITCodeCache(const char* script_name) {
+  jit_code_cache_key = Snapshot::JITCodeCacheKey(script_name);
+  if (jit_code_cache_key == nullptr) {
+    Syslog::PrintErr("Ignoring --jit-code-cache: %s is not a kernel file.\n",
+                     script_name);
+    return nullptr;
+  }
+  AppSnapshot* snapshot = Snapshot::TryReadJITCodeCache(
+      Options::jit_code_cache_filename(), jit_code_cache_key);
+  if (snapshot == nullptr) {
+    Options::TrainJITCodeCache();
+  }
+  return snapshot;
+}
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+
+static void GenerateAppJITSnapshot() {
+  if (jit_code_cache_key != nullptr) {
+    Snapshot::GenerateJITCodeCache(Options::snapshot_filename(),
+                                   jit_code_cache_key);
+  } else {
+    Snapshot::GenerateAppJIT(Options::snapshot_filename());
+  }
+}
+
 static void OnExitHook(int64_t exit_code) {
   if (Dart_CurrentIsolate() != main_isolate) {
     Syslog::PrintErr(
@@ -144,7 +176,7 @@ static void OnExitHook(int64_t exit_code) {
   }
   if (exit_code == 0) {
     if (Options::gen_snapshot_kind() == kAppJIT) {
-      Snapshot::GenerateAppJIT(Options::snapshot_filename());
+      GenerateAppJITSnapshot();
     }
     WriteDepsFile();
   }
@@ -1102,7 +1134,7 @@ void RunMainIsolate(const char* script_name,
   // Generate an app snapshot after execution if specified.
   if (Options::gen_snapshot_kind() == kAppJIT) {
     if (!Dart_IsCompilationError(result)) {
-      Snapshot::GenerateAppJIT(Options::snapshot_filename());
+      GenerateAppJITSnapshot();
     }
   }
   CHECK_RESULT(result);
@@ -1306,6 +1338,11 @@ void main(int argc, char** argv) {
     if (!CheckForInvalidPath(script_name)) {
       Platform::Exit(0);
     }
+#if !defined(DART_PRECOMPILED_RUNTIME)
+    if (Options::jit_code_cache_filename() != nullptr) {
+      app_snapshot = TryReadJITCodeCache(script_name);
+    }
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
     try_load_snapshots_lambda();
   }
 
@@ -1373,10 +1410,10 @@ void main(int argc, char** argv) {
   init_params.shutdown_isolate = OnIsolateShutdown;
   init_params.cleanup_isolate = DeleteIsolateData;
   init_params.cleanup_group = DeleteIsolateGroupData;
-  init_params.file_open = DartUtils::OpenFile;
+  init_params.file_open = GzipFileCallbacks::Open;
   init_params.file_read = DartUtils::ReadFile;
-  init_params.file_write = DartUtils::WriteFile;
-  init_params.file_close = DartUtils::CloseFile;
+  init_params.file_write = GzipFileCallbacks::Write;
+  init_params.file_close = GzipFileCallbacks::Close;
   init_params.entropy_source = DartUtils::EntropySource;
   init_params.get_service_assets = GetVMServiceAssetsArchiveCallback;
 #if !defined(DART_PRECOMPILED_RUNTIME)
@@ -1457,6 +1494,7 @@ void main(int argc, char** argv) {
 
   delete app_snapshot;
   free(app_script_uri);
+  free(jit_code_cache_key);
   if (ran_dart_dev && script_name != nullptr) {
     free(script_name);
   }
@@ -10,6 +10,7 @@
 
 #include "bin/dartdev_isolate.h"
 #include "bin/error_exit.h"
+#include "bin/eventhandler.h"
 #include "bin/file_system_watcher.h"
 #include "bin/options.h"
 #include "bin/platform.h"
@@ -178,6 +179,10 @@ void Options::PrintUsage() {
 "    <snapshot-kind> controls the kind of snapshot, it could be\n"
 "                    kernel(default) or app-jit\n"
 "    <file_name> specifies the file into which the snapshot is written\n"
+"--jit-code-cache=<file_name>\n"
+"  When running a kernel file, start from the app-jit snapshot in\n"
+"  <file_name> if it was trained with the same kernel file and SDK.\n"
+"  Otherwise run normally and write a new app-jit snapshot there on exit.\n"
 "--version\n"
 "  Print the SDK version.\n");
   } else {
@@ -244,6 +249,11 @@ void Options::PrintUsage() {
 "  The path to a directory that dart:io calls will treat as the root of the\n"
 "  filesystem.\n"
 #endif  // defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID)
+#if defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID)
+"--event-handler-threads=<count>\n"
+"  The number of threads dispatching dart:io events. Descriptors are\n"
+"  spread across them. Between 1 and 64, defaults to 1.\n"
+#endif  // defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_ANDROID)
 "\n"
 "The following options are only used for VM development and may\n"
 "be changed in any future version:\n");
@@ -751,6 +761,19 @@ bool Options::ParseArguments(int argc,
     snapshot_deps_filename_ = nullptr;
   }
 
+  if (event_handler_threads_ != nullptr) {
+    char* end = nullptr;
+    const int64_t count = strtoll(event_handler_threads_, &end, 10);
+    if ((end == event_handler_threads_) || (*end != '\0') || (count < 1) ||
+        (count > EventHandler::kMaxThreadCount)) {
+      Syslog::PrintErr(
+          "--event-handler-threads must be a number between 1 and %" Pd ".\n",
+          EventHandler::kMaxThreadCount);
+      return false;
+    }
+    EventHandler::set_thread_count(count);
+  }
+
   if ((packages_file_ != nullptr) && (strlen(packages_file_) == 0)) {
     Syslog::PrintErr("Empty package file name specified.\n");
     return false;
@@ -768,6 +791,13 @@ bool Options::ParseArguments(int argc,
         " (--depfile-output-filename or --snapshot).\n");
     return false;
   }
+  if ((jit_code_cache_filename_ != nullptr) &&
+      ((gen_snapshot_kind_ != kNone) || (snapshot_filename_ != nullptr))) {
+    Syslog::PrintErr(
+        "Specifying --jit-code-cache and an option to generate a snapshot"
+        " is invalid.\n");
+    return false;
+  }
   if ((gen_snapshot_kind_ != kNone) && vm_run_app_snapshot) {
     Syslog::PrintErr(
         "Specifying an option to generate a snapshot and"
@@ -21,12 +21,14 @@ namespace bin {
   V(packages, packages_file)                                                   \
   V(snapshot, snapshot_filename)                                               \
   V(snapshot_depfile, snapshot_deps_filename)                                  \
+  V(jit_code_cache, jit_code_cache_filename)                                   \
   V(depfile, depfile)                                                          \
   V(depfile_output_filename, depfile_output_filename)                          \
   V(root_certs_file, root_certs_file)                                          \
   V(root_certs_cache, root_certs_cache)                                        \
   V(namespace, namespc)                                                        \
-  V(write_service_info, vm_write_service_info_filename)
+  V(write_service_info, vm_write_service_info_filename)                        \
+  V(event_handler_threads, event_handler_threads)
 
 // As STRING_OPTIONS_LIST but for boolean valued options. The default value is
 // always false, and the presence of the flag switches the value to true.
@@ -153,6 +155,13 @@ class Options {
 #if !defined(DART_PRECOMPILED_RUNTIME)
   static DFE* dfe() { return dfe_; }
   static void set_dfe(DFE* dfe) { dfe_ = dfe; }
+
+  // Turns this run into an app-jit training run which writes the snapshot to
+  // the --jit-code-cache file.
+  static void TrainJITCodeCache() {
+    gen_snapshot_kind_ = kAppJIT;
+    snapshot_filename_ = jit_code_cache_filename_;
+  }
 #endif  // !defined(DART_PRECOMPILED_RUNTIME)
 
   static void PrintUsage();
@@ -225,34 +225,12 @@ class SignalInfo {
 // allocated.
 class BufferListBase {
  protected:
+  // Initial capacity of the buffer, which then doubles whenever it is full.
   static constexpr intptr_t kBufferSize = 16 * 1024;
 
-  class BufferListNode {
-   public:
-    explicit BufferListNode(intptr_t size) {
-      data_ = new uint8_t[size];
-      // We check for a failed allocation below in Allocate()
-      next_ = nullptr;
-    }
-
-    ~BufferListNode() { delete[] data_; }
-
-    bool Valid() const { return data_ != nullptr; }
-
-    uint8_t* data() const { return data_; }
-    BufferListNode* next() const { return next_; }
-    void set_next(BufferListNode* n) { next_ = n; }
-
-   private:
-    uint8_t* data_;
-    BufferListNode* next_;
-
-    DISALLOW_IMPLICIT_CONSTRUCTORS(BufferListNode);
-  };
-
  public:
   BufferListBase()
-      : head_(nullptr), tail_(nullptr), data_size_(0), free_size_(0) {}
+      : data_(nullptr), capacity_(0), data_size_(0), free_size_(0) {}
   ~BufferListBase() {
     Free();
     DEBUG_ASSERT(IsEmpty());
@@ -260,71 +238,74 @@ class BufferListBase {
 
   // Returns the collected data as a Uint8List. If an error occurs an
   // error handle is returned.
+  //
+  // The collected bytes are handed over as the external storage of the
+  // Uint8List. They are copied into an exactly sized buffer first when the
+  // doubling left unused capacity. If that copy fails, the whole capacity is
+  // reported as external size.
   Dart_Handle GetData() {
-    uint8_t* buffer;
-    intptr_t buffer_position = 0;
-    Dart_Handle result = IOBuffer::Allocate(data_size_, &buffer);
-    if (Dart_IsNull(result)) {
-      return DartUtils::NewDartOSError();
-    }
-    if (Dart_IsError(result)) {
+    if (data_size_ == 0) {
       Free();
-      return result;
+      uint8_t* buffer;
+      Dart_Handle result = IOBuffer::Allocate(0, &buffer);
+      return Dart_IsNull(result) ? DartUtils::NewDartOSError() : result;
     }
-    for (BufferListNode* current = head_; current != nullptr;
-         current = current->next()) {
-      intptr_t to_copy = dart::Utils::Minimum(data_size_, kBufferSize);
-      memmove(buffer + buffer_position, current->data(), to_copy);
-      buffer_position += to_copy;
-      data_size_ -= to_copy;
+    uint8_t* data = data_;
+    const intptr_t size = data_size_;
+    intptr_t external_size = capacity_;
+    if (size < capacity_) {
+      // realloc() doesn't reliably give memory back when shrinking, see
+      // IOBuffer::Reallocate.
+      uint8_t* shrunk = IOBuffer::Reallocate(data, size);
+      if (shrunk != nullptr) {
+        data = shrunk;
+        external_size = size;
+      }
     }
-    ASSERT(data_size_ == 0);
+    data_ = nullptr;
     Free();
+    Dart_Handle result = Dart_NewExternalTypedDataWithFinalizer(
+        Dart_TypedData_kUint8, data, size, data, external_size,
+        IOBuffer::Finalizer);
+    if (Dart_IsError(result)) {
+      IOBuffer::Free(data);
+    }
     return result;
   }
 
 #if defined(DEBUG)
-  bool IsEmpty() const { return (head_ == nullptr) && (tail_ == nullptr); }
+  bool IsEmpty() const { return data_ == nullptr; }
 #endif
 
  protected:
+  // Grows the buffer once its free space is used up.
   bool Allocate() {
     ASSERT(free_size_ == 0);
-    BufferListNode* node = new BufferListNode(kBufferSize);
-    if ((node == nullptr) || !node->Valid()) {
-      // Failed to allocate a buffer for the node.
-      delete node;
+    const intptr_t capacity = (capacity_ == 0) ? kBufferSize : 2 * capacity_;
+    uint8_t* data = reinterpret_cast<uint8_t*>(realloc(data_, capacity));
+    if (data == nullptr) {
+      // Failed to grow the buffer. The collected data stays valid.
       return false;
     }
-    if (head_ == nullptr) {
-      head_ = node;
-      tail_ = node;
-    } else {
-      ASSERT(tail_->next() == nullptr);
-      tail_->set_next(node);
-      tail_ = node;
-    }
-    free_size_ = kBufferSize;
+    data_ = data;
+    free_size_ = capacity - capacity_;
+    capacity_ = capacity;
     return true;
   }
 
   void Free() {
-    BufferListNode* current = head_;
-    while (current != nullptr) {
-      BufferListNode* tmp = current;
-      current = current->next();
-      delete tmp;
-    }
-    head_ = nullptr;
-    tail_ = nullptr;
+    IOBuffer::Free(data_);
+    data_ = nullptr;
+    capacity_ = 0;
     data_size_ = 0;
     free_size_ = 0;
   }
 
   // Returns the address of the first byte in the free space.
-  uint8_t* FreeSpaceAddress() {
-    return tail_->data() + (kBufferSize - free_size_);
-  }
+  uint8_t* FreeSpaceAddress() { return data_ + (capacity_ - free_size_); }
+
+  // The collected data, which is contiguous.
+  uint8_t* data() const { return data_; }
 
   intptr_t data_size() const { return data_size_; }
   void set_data_size(intptr_t size) { data_size_ = size; }
@@ -332,18 +313,16 @@ class BufferListBase {
   intptr_t free_size() const { return free_size_; }
   void set_free_size(intptr_t size) { free_size_ = size; }
 
-  BufferListNode* head() const { return head_; }
-  BufferListNode* tail() const { return tail_; }
-
  private:
-  // Linked list for data collected.
-  BufferListNode* head_;
-  BufferListNode* tail_;
+  // Data collected, allocated as IO buffer storage so that it can be handed
+  // to Dart without a copy.
+  uint8_t* data_;
+  intptr_t capacity_;
 
-  // Number of bytes of data collected in the linked list.
+  // Number of bytes of data collected.
   intptr_t data_size_;
 
-  // Number of free bytes in the last node in the list.
+  // Number of free bytes at the end of the buffer.
   intptr_t free_size_;
 
   DISALLOW_COPY_AND_ASSIGN(BufferListBase);
@@ -365,7 +344,6 @@ class BufferList : public BufferListBase {
         }
       }
       ASSERT(free_size() > 0);
-      ASSERT(free_size() <= kBufferSize);
       intptr_t block_size = dart::Utils::Minimum(free_size(), available);
 #if defined(DART_HOST_OS_FUCHSIA)
       intptr_t bytes = NO_RETRY_EXPECTED(
@@ -10,9 +10,12 @@
 #include <errno.h>         // NOLINT
 #include <fcntl.h>         // NOLINT
 #include <poll.h>          // NOLINT
+#include <sched.h>         // NOLINT
+#include <signal.h>        // NOLINT
 #include <stdio.h>         // NOLINT
 #include <stdlib.h>        // NOLINT
 #include <string.h>        // NOLINT
+#include <sys/mman.h>      // NOLINT
 #include <sys/resource.h>  // NOLINT
 #include <sys/wait.h>      // NOLINT
 #include <unistd.h>        // NOLINT
@@ -73,6 +76,15 @@ class ProcessInfoList {
 
   static void AddProcess(pid_t pid, intptr_t fd) {
     MutexLocker locker(mutex_);
+    AddProcessLocked(pid, fd);
+  }
+
+  // Holding this lock while a process is created, and until it has been added
+  // with AddProcessLocked, keeps the exit code handler from looking up the
+  // process before it is known.
+  static Mutex* mutex() { return mutex_; }
+
+  static void AddProcessLocked(pid_t pid, intptr_t fd) {
     ProcessInfo* info = new ProcessInfo(pid, fd);
     info->set_next(active_processes_);
     active_processes_ = info;
@@ -311,6 +323,14 @@ class ProcessStarter {
       return err;
     }
 
+#if defined(DART_HOST_OS_LINUX)
+    if (CanStartWithVfork()) {
+      pid_t pid = -1;
+      err = StartWithVfork(&pid);
+      return (err != 0) ? err : CompleteStart(pid);
+    }
+#endif
+
     // Fork to create the new process.
     pid_t pid = TEMP_FAILURE_RETRY(fork());
     if (pid < 0) {
@@ -344,6 +364,17 @@ class ProcessStarter {
       return CleanupAndReturnError();
     }
 
+    return CompleteStart(pid);
+  }
+
+ private:
+  static constexpr int kErrorBufferSize = 1024;
+
+  // Reads the result of exec in the child process [pid] and connects its
+  // stdio.
+  int CompleteStart(pid_t pid) {
+    int err;
+
     // Read the result of executing the child process.
     close(exec_control_[1]);
     exec_control_[1] = -1;
@@ -397,9 +428,6 @@ class ProcessStarter {
     return 0;
   }
 
- private:
-  static constexpr int kErrorBufferSize = 1024;
-
   int CreatePipes() {
     int result;
     result = TEMP_FAILURE_RETRY(pipe2(exec_control_, O_CLOEXEC));
@@ -580,6 +608,99 @@ class ProcessStarter {
     }
   }
 
+#if defined(DART_HOST_OS_LINUX)
+  // Size of the stack used by the child process between clone and exec.
+  static constexpr intptr_t kVforkStackSize = 1 * MB;
+
+  // Whether the child can be set up from a process sharing our memory. This
+  // rules out anything that would touch memory of the parent in the child:
+  // replacing environ, resolving paths through a namespace and the double
+  // fork of detached processes.
+  bool CanStartWithVfork() {
+    return Process::ModeIsAttached(mode_) && Namespace::IsDefault(namespc_) &&
+           (program_environment_ == nullptr);
+  }
+
+  // Starts the child with clone(CLONE_VM | CLONE_VFORK) instead of fork, so
+  // that the cost of starting a process does not grow with the size of this
+  // one: the page tables are not copied, and this thread is suspended only
+  // until the child has called exec or exited.
+  //
+  // Since the child has exec'ed by the time clone returns, the process is
+  // added to ProcessInfoList with the list locked across clone, rather than
+  // being held back from exec by a notification as in the fork path.
+  int StartWithVfork(pid_t* pid) {
+    int event_fds[2];
+    if (TEMP_FAILURE_RETRY(pipe2(event_fds, O_CLOEXEC)) < 0) {
+      return CleanupAndReturnError();
+    }
+    void* stack = mmap(nullptr, kVforkStackSize, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+    if (stack == MAP_FAILED) {
+      int actual_errno = errno;
+      close(event_fds[0]);
+      close(event_fds[1]);
+      errno = actual_errno;
+      return CleanupAndReturnError();
+    }
+
+    // Signal handlers of this process must not run in the child while it
+    // shares our memory. Block all signals until the child has reset them.
+    sigset_t all_signals;
+    sigfillset(&all_signals);
+    VOID_NO_RETRY_EXPECTED(
+        pthread_sigmask(SIG_BLOCK, &all_signals, &parent_signal_mask_));
+    int clone_errno = 0;
+    {
+      MutexLocker locker(ProcessInfoList::mutex());
+      *pid = clone(VforkChildEntry,
+                   reinterpret_cast<uint8_t*>(stack) + kVforkStackSize,
+                   CLONE_VM | CLONE_VFORK | SIGCHLD, this);
+      clone_errno = errno;
+      if (*pid > 0) {
+        ExitCodeHandler::ProcessStarted();
+        ProcessInfoList::AddProcessLocked(*pid, event_fds[1]);
+      }
+    }
+    VOID_NO_RETRY_EXPECTED(
+        pthread_sigmask(SIG_SETMASK, &parent_signal_mask_, nullptr));
+    munmap(stack, kVforkStackSize);
+
+    if (*pid < 0) {
+      close(event_fds[0]);
+      close(event_fds[1]);
+      errno = clone_errno;
+      return CleanupAndReturnError();
+    }
+    *exit_event_ = event_fds[0];
+    FDUtils::SetNonBlocking(event_fds[0]);
+    return 0;
+  }
+
+  static int VforkChildEntry(void* starter) {
+    reinterpret_cast<ProcessStarter*>(starter)->VforkChild();
+    return 1;
+  }
+
+  void VforkChild() {
+    // Restore the default disposition of all handled signals before the
+    // signal mask of the parent is reinstated. Ignored signals stay ignored
+    // across exec, as they do in the fork path.
+    for (int signal = 1; signal < NSIG; signal++) {
+      struct sigaction act = {};
+      if ((sigaction(signal, nullptr, &act) == 0) &&
+          (act.sa_handler != SIG_DFL) && (act.sa_handler != SIG_IGN)) {
+        act = {};
+        act.sa_handler = SIG_DFL;
+        sigaction(signal, &act, nullptr);
+      }
+    }
+    VOID_NO_RETRY_EXPECTED(
+        pthread_sigmask(SIG_SETMASK, &parent_signal_mask_, nullptr));
+    ExecProcess();
+  }
+#endif  // defined(DART_HOST_OS_LINUX)
+
   int RegisterProcess(pid_t pid) {
     int result;
     int event_fds[2];
@@ -775,6 +896,9 @@ class ProcessStarter {
   int read_err_[2];      // Pipe for stderr to child process.
   int write_out_[2];     // Pipe for stdin to child process.
   int exec_control_[2];  // Pipe to get the result from exec.
+#if defined(DART_HOST_OS_LINUX)
+  sigset_t parent_signal_mask_;  // Signal mask to restore after clone.
+#endif
 
   char** program_arguments_;
   char** program_environment_;
@@ -692,7 +692,6 @@ class BufferList : public BufferListBase {
       }
     }
     ASSERT(free_size() > 0);
-    ASSERT(free_size() <= kBufferSize);
     *buffer = FreeSpaceAddress();
     *size = free_size();
     read_pending_ = true;
@@ -702,10 +701,8 @@ class BufferList : public BufferListBase {
   intptr_t GetDataSize() { return data_size(); }
 
   uint8_t* GetFirstDataBuffer() {
-    ASSERT(head() != nullptr);
-    ASSERT(head() == tail());
-    ASSERT(data_size() <= kBufferSize);
-    return head()->data();
+    ASSERT(data() != nullptr);
+    return data();
   }
 
   void FreeDataBuffer() { Free(); }
@@ -102,13 +102,14 @@ void FUNCTION_NAME(SecureSocket_Init)(Dart_NativeArguments args) {
 
 void FUNCTION_NAME(SecureSocket_Connect)(Dart_NativeArguments args) {
   Dart_Handle host_name_object = ThrowIfError(Dart_GetNativeArgument(args, 1));
-  Dart_Handle context_object = ThrowIfError(Dart_GetNativeArgument(args, 2));
-  bool is_server = DartUtils::GetBooleanValue(Dart_GetNativeArgument(args, 3));
+  int64_t port = DartUtils::GetIntegerValue(Dart_GetNativeArgument(args, 2));
+  Dart_Handle context_object = ThrowIfError(Dart_GetNativeArgument(args, 3));
+  bool is_server = DartUtils::GetBooleanValue(Dart_GetNativeArgument(args, 4));
   bool request_client_certificate =
-      DartUtils::GetBooleanValue(Dart_GetNativeArgument(args, 4));
-  bool require_client_certificate =
       DartUtils::GetBooleanValue(Dart_GetNativeArgument(args, 5));
-  Dart_Handle protocols_handle = ThrowIfError(Dart_GetNativeArgument(args, 6));
+  bool require_client_certificate =
+      DartUtils::GetBooleanValue(Dart_GetNativeArgument(args, 6));
+  Dart_Handle protocols_handle = ThrowIfError(Dart_GetNativeArgument(args, 7));
 
   const char* host_name = nullptr;
   // TODO(whesse): Is truncating a Dart string containing \0 what we want?
@@ -124,7 +125,7 @@ void FUNCTION_NAME(SecureSocket_Connect)(Dart_NativeArguments args) {
   // The protocols_handle is guaranteed to be a valid Uint8List.
   // It will have the correct length encoding of the protocols array.
   ASSERT(!Dart_IsNull(protocols_handle));
-  GetFilter(args)->Connect(host_name, context, is_server,
+  GetFilter(args)->Connect(host_name, port, context, is_server,
                            request_client_certificate,
                            require_client_certificate, protocols_handle);
 }
@@ -482,6 +483,7 @@ void SSLFilter::InitializeLibrary() {
 }
 
 void SSLFilter::Connect(const char* hostname,
+                        int64_t port,
                         SSLCertContext* context,
                         bool is_server,
                         bool request_client_certificate,
@@ -532,10 +534,16 @@ void SSLFilter::Connect(const char* hostname,
     status = SSL_set_tlsext_host_name(ssl_, hostname);
     SecureSocketUtils::CheckStatusSSL(status, "TlsException",
                                       "Set SNI host name", ssl_);
+    SSL_SESSION* session = context->LookupClientSession(hostname, port);
+    if (session != nullptr) {
+      SSL_set_session(ssl_, session);
+      SSL_SESSION_free(session);
+    }
     // Sets the hostname in the certificate-checking object, so it is checked
     // against the certificate presented by the server.
     X509_VERIFY_PARAM* certificate_checking_parameters = SSL_get0_param(ssl_);
     hostname_ = Utils::StrDup(hostname);
+    port_ = port;
     X509_VERIFY_PARAM_set_flags(
         certificate_checking_parameters,
         X509_V_FLAG_PARTIAL_CHAIN | X509_V_FLAG_TRUSTED_FIRST);
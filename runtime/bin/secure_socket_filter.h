@@ -65,16 +65,19 @@ class SSLFilter : public ReferenceCounted<SSLFilter> {
         handshake_complete_(nullptr),
         bad_certificate_callback_(nullptr),
         in_handshake_(false),
-        hostname_(nullptr) {}
+        hostname_(nullptr),
+        port_(0) {}
 
   ~SSLFilter();
 
   char* hostname() const { return hostname_; }
+  int64_t port() const { return port_; }
   bool is_server() const { return is_server_; }
   bool is_client() const { return !is_server_; }
 
   Dart_Handle Init(Dart_Handle dart_this);
   void Connect(const char* hostname,
+               int64_t port,
                SSLCertContext* context,
                bool is_server,
                bool request_client_certificate,
@@ -141,6 +144,7 @@ class SSLFilter : public ReferenceCounted<SSLFilter> {
   bool in_handshake_;
   bool is_server_;
   char* hostname_;
+  int64_t port_;
 
   Dart_Port reply_port_ = ILLEGAL_PORT;
   Dart_Port trust_evaluate_reply_port_ = ILLEGAL_PORT;
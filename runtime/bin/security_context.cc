@@ -19,6 +19,7 @@
 #include "bin/secure_socket_filter.h"
 #include "bin/secure_socket_utils.h"
 #include "platform/syslog.h"
+#include "platform/utils.h"
 
 // Return the error from the containing function if handle is an error handle.
 #define RETURN_IF_ERROR(handle)                                                \
@@ -92,6 +93,92 @@ void SSLCertContext::KeyLogCallback(const SSL* ssl, const char* line) {
   }
 }
 
+int SSLCertContext::NewSessionCallback(SSL* ssl, SSL_SESSION* session) {
+  if (SSL_is_server(ssl)) {
+    return 0;
+  }
+  SSLFilter* filter = static_cast<SSLFilter*>(
+      SSL_get_ex_data(ssl, SSLFilter::filter_ssl_index));
+  SSLCertContext* context = static_cast<SSLCertContext*>(
+      SSL_get_ex_data(ssl, SSLFilter::ssl_cert_context_index));
+  // Only cache sessions whose certificate passed BoringSSL's own verification.
+  // A certificate accepted by a bad certificate callback, or by a
+  // platform-specific trust evaluation, was accepted for that connection only.
+  if ((filter == nullptr) || (filter->hostname() == nullptr) ||
+      (context == nullptr) || (context->GetTrustEvaluateHandler() != nullptr) ||
+      (SSL_get_verify_result(ssl) != X509_V_OK)) {
+    return 0;
+  }
+  context->CacheClientSession(filter->hostname(), filter->port(), session);
+  return 1;
+}
+
+bool SSLCertContext::ClientSession::Matches(const char* hostname,
+                                            int64_t port) const {
+  return (this->hostname != nullptr) && (this->port == port) &&
+         (strcmp(this->hostname, hostname) == 0);
+}
+
+void SSLCertContext::CacheClientSession(const char* hostname,
+                                        int64_t port,
+                                        SSL_SESSION* session) {
+  MutexLocker ml(&client_sessions_mutex_);
+  intptr_t slot = next_client_session_;
+  for (intptr_t i = 0; i < kClientSessionCacheSize; i++) {
+    if (client_sessions_[i].Matches(hostname, port)) {
+      slot = i;
+      break;
+    }
+  }
+  ClientSession* entry = &client_sessions_[slot];
+  if (!entry->Matches(hostname, port)) {
+    // Evict the oldest server.
+    free(entry->hostname);
+    entry->hostname = Utils::StrDup(hostname);
+    entry->port = port;
+    next_client_session_ = (next_client_session_ + 1) % kClientSessionCacheSize;
+  }
+  if (entry->session != nullptr) {
+    SSL_SESSION_free(entry->session);
+  }
+  entry->session = session;
+}
+
+SSL_SESSION* SSLCertContext::LookupClientSession(const char* hostname,
+                                                 int64_t port) {
+  MutexLocker ml(&client_sessions_mutex_);
+  for (intptr_t i = 0; i < kClientSessionCacheSize; i++) {
+    ClientSession* entry = &client_sessions_[i];
+    if ((entry->session == nullptr) || !entry->Matches(hostname, port)) {
+      continue;
+    }
+    SSL_SESSION* session = entry->session;
+    if (SSL_SESSION_should_be_single_use(session)) {
+      // TLS 1.3 tickets are not reused, so that separate connections cannot
+      // be linked by their ticket. The caller takes over the cache's reference.
+      entry->session = nullptr;
+    } else {
+      SSL_SESSION_up_ref(session);
+    }
+    return session;
+  }
+  return nullptr;
+}
+
+void SSLCertContext::ClearClientSessionCache() {
+  MutexLocker ml(&client_sessions_mutex_);
+  for (intptr_t i = 0; i < kClientSessionCacheSize; i++) {
+    ClientSession* entry = &client_sessions_[i];
+    if (entry->session != nullptr) {
+      SSL_SESSION_free(entry->session);
+      entry->session = nullptr;
+    }
+    free(entry->hostname);
+    entry->hostname = nullptr;
+    entry->port = 0;
+  }
+}
+
 SSLCertContext* SSLCertContext::GetSecurityContext(Dart_NativeArguments args) {
   SSLCertContext* context;
   Dart_Handle dart_this = ThrowIfError(Dart_GetNativeArgument(args, 0));
@@ -809,6 +896,7 @@ void FUNCTION_NAME(SecurityContext_UsePrivateKeyBytes)(
     Dart_ThrowException(DartUtils::NewDartArgumentError(
         "Expected private key, but none was found"));
   }
+  context->ClearClientSessionCache();
   status = SSL_CTX_use_PrivateKey(context->context(), key);
   // SSL_CTX_use_PrivateKey increments the reference count of key on success,
   // so we have to call EVP_PKEY_free on both success and failure.
@@ -829,6 +917,10 @@ void FUNCTION_NAME(SecurityContext_Allocate)(Dart_NativeArguments args) {
   SSL_CTX_set_keylog_callback(ctx, SSLCertContext::KeyLogCallback);
   SSL_CTX_set_min_proto_version(ctx, TLS1_2_VERSION);
   SSL_CTX_set_cipher_list(ctx, "HIGH:MEDIUM");
+  // Servers keep BoringSSL's internal session cache. Clients never use it, and
+  // have their sessions stored in the SSLCertContext by NewSessionCallback.
+  SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_BOTH);
+  SSL_CTX_sess_set_new_cb(ctx, SSLCertContext::NewSessionCallback);
   SSLCertContext* context = new SSLCertContext(ctx);
   Dart_Handle err = SetSecurityContext(args, context);
   if (Dart_IsError(err)) {
@@ -845,6 +937,7 @@ void FUNCTION_NAME(SecurityContext_SetTrustedCertificatesBytes)(
 
   ASSERT(context != nullptr);
   ASSERT(password != nullptr);
+  context->ClearClientSessionCache();
   context->SetTrustedCertificatesBytes(cert_bytes, password);
 }
 
@@ -870,6 +963,7 @@ void FUNCTION_NAME(SecurityContext_UseCertificateChainBytes)(
   ASSERT(context != nullptr);
   ASSERT(password != nullptr);
 
+  context->ClearClientSessionCache();
   int status = context->UseCertificateChainBytes(cert_chain_bytes, password);
 
   SecureSocketUtils::CheckStatus(status, "TlsException",
@@ -882,6 +976,7 @@ void FUNCTION_NAME(SecurityContext_TrustBuiltinRoots)(
 
   ASSERT(context != nullptr);
 
+  context->ClearClientSessionCache();
   context->TrustBuiltinRoots();
 }
 
@@ -32,15 +32,18 @@ class SSLCertContext : public ReferenceCounted<SSLCertContext> {
         context_(context),
         alpn_protocol_string_(nullptr),
         trust_builtin_(false),
-        allow_tls_renegotiation_(false) {}
+        allow_tls_renegotiation_(false),
+        next_client_session_(0) {}
 
   ~SSLCertContext() {
+    ClearClientSessionCache();
     SSL_CTX_free(context_);
     free(alpn_protocol_string_);
   }
 
   static int CertificateCallback(int preverify_ok, X509_STORE_CTX* store_ctx);
   static void KeyLogCallback(const SSL* ssl, const char* line);
+  static int NewSessionCallback(SSL* ssl, SSL_SESSION* session);
 
   static SSLCertContext* GetSecurityContext(Dart_NativeArguments args);
   static const char* GetPasswordArgument(Dart_NativeArguments args,
@@ -93,6 +96,22 @@ class SSLCertContext : public ReferenceCounted<SSLCertContext> {
   void RegisterCallbacks(SSL* ssl);
   TrustEvaluateHandlerFunc GetTrustEvaluateHandler() const;
 
+  // Client sessions are cached per host name and port, so that later
+  // connections through this context to the same server can resume them
+  // instead of doing a full handshake. Returns a new reference to the cached
+  // session, or nullptr.
+  SSL_SESSION* LookupClientSession(const char* hostname, int64_t port);
+
+  // Takes ownership of [session].
+  void CacheClientSession(const char* hostname,
+                          int64_t port,
+                          SSL_SESSION* session);
+
+  // Drops all cached client sessions. Called whenever the trust or identity
+  // configured in this context changes, since a resumed session skips
+  // certificate verification.
+  void ClearClientSessionCache();
+
   static bool long_ssl_cert_evaluation() { return long_ssl_cert_evaluation_; }
   static void set_long_ssl_cert_evaluation(bool long_ssl_cert_evaluation) {
     long_ssl_cert_evaluation_ = long_ssl_cert_evaluation;
@@ -111,6 +130,15 @@ class SSLCertContext : public ReferenceCounted<SSLCertContext> {
   void LoadRootCertFile(const char* file);
   void LoadRootCertCache(const char* cache);
 
+  struct ClientSession {
+    char* hostname;
+    int64_t port;
+    SSL_SESSION* session;
+
+    bool Matches(const char* hostname, int64_t port) const;
+  };
+  static constexpr intptr_t kClientSessionCacheSize = 16;
+
   static const char* root_certs_file_;
   static const char* root_certs_cache_;
 
@@ -119,6 +147,12 @@ class SSLCertContext : public ReferenceCounted<SSLCertContext> {
 
   bool trust_builtin_;
   bool allow_tls_renegotiation_;
+
+  Mutex client_sessions_mutex_;
+  ClientSession client_sessions_[kClientSessionCacheSize] = {};
+  // Slot to replace when a session for a new server is cached.
+  intptr_t next_client_session_;
+
   static bool long_ssl_cert_evaluation_;
   static bool bypass_trusting_system_roots_;
 
@@ -0,0 +1,74 @@
+// Copyright (c) 2024, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#if !defined(DART_IO_SECURE_SOCKET_DISABLED)
+
+#include <openssl/ssl.h>
+
+#include "bin/security_context.h"
+#include "platform/globals.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+namespace bin {
+
+static SSL_SESSION* NewSession(SSL_CTX* ctx, uint16_t version) {
+  SSL_SESSION* session = SSL_SESSION_new(ctx);
+  EXPECT(session != nullptr);
+  EXPECT(SSL_SESSION_set_protocol_version(session, version) == 1);
+  return session;
+}
+
+VM_UNIT_TEST_CASE(SecurityContext_ClientSessionsKeyedByHostAndPort) {
+  SSL_CTX* ctx = SSL_CTX_new(TLS_method());
+  SSLCertContext* context = new SSLCertContext(ctx);
+
+  SSL_SESSION* https = NewSession(ctx, TLS1_2_VERSION);
+  SSL_SESSION* other = NewSession(ctx, TLS1_2_VERSION);
+  context->CacheClientSession("example.com", 443, https);
+  context->CacheClientSession("example.com", 8443, other);
+
+  // Each server gets back the session it handed out, and a session cached
+  // for one port is never offered to another.
+  SSL_SESSION* session = context->LookupClientSession("example.com", 443);
+  EXPECT(session == https);
+  SSL_SESSION_free(session);
+  session = context->LookupClientSession("example.com", 8443);
+  EXPECT(session == other);
+  SSL_SESSION_free(session);
+  EXPECT(context->LookupClientSession("example.com", 80) == nullptr);
+  EXPECT(context->LookupClientSession("example.org", 443) == nullptr);
+
+  // A new session for a server replaces only that server's entry.
+  SSL_SESSION* renewed = NewSession(ctx, TLS1_2_VERSION);
+  context->CacheClientSession("example.com", 443, renewed);
+  session = context->LookupClientSession("example.com", 443);
+  EXPECT(session == renewed);
+  SSL_SESSION_free(session);
+  session = context->LookupClientSession("example.com", 8443);
+  EXPECT(session == other);
+  SSL_SESSION_free(session);
+
+  context->ClearClientSessionCache();
+  EXPECT(context->LookupClientSession("example.com", 443) == nullptr);
+  context->Release();
+}
+
+VM_UNIT_TEST_CASE(SecurityContext_ClientSessionTls13TicketsAreSingleUse) {
+  SSL_CTX* ctx = SSL_CTX_new(TLS_method());
+  SSLCertContext* context = new SSLCertContext(ctx);
+
+  SSL_SESSION* ticket = NewSession(ctx, TLS1_3_VERSION);
+  context->CacheClientSession("example.com", 443, ticket);
+  SSL_SESSION* session = context->LookupClientSession("example.com", 443);
+  EXPECT(session == ticket);
+  SSL_SESSION_free(session);
+  EXPECT(context->LookupClientSession("example.com", 443) == nullptr);
+  context->Release();
+}
+
+}  // namespace bin
+}  // namespace dart
+
+#endif  // !defined(DART_IO_SECURE_SOCKET_DISABLED)
@@ -805,6 +805,103 @@ void Snapshot::GenerateAppJIT(const char* snapshot_filename) {
 #endif
 }
 
+static char* JITCodeCacheKeyFilename(const char* cache_filename) {
+  return Utils::SCreate("%s.key", cache_filename);
+}
+
+char* Snapshot::JITCodeCacheKey(const char* script_uri) {
+  auto decoded_path = File::UriToPath(script_uri);
+  if (decoded_path == nullptr) {
+    return nullptr;
+  }
+  if (File::GetType(nullptr, decoded_path.get(), true) != File::kIsFile) {
+    return nullptr;
+  }
+  File* file = File::Open(nullptr, decoded_path.get(), File::kRead);
+  if (file == nullptr) {
+    return nullptr;
+  }
+  RefCntReleaseScope<File> rs(file);
+  const int64_t length = file->Length();
+  if (length < DartUtils::kMaxMagicNumberSize) {
+    return nullptr;
+  }
+  std::unique_ptr<MappedMemory> mapping(
+      file->Map(File::kReadOnly, 0, length));
+  if (mapping == nullptr) {
+    return nullptr;
+  }
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(mapping->address());
+  if (DartUtils::SniffForMagicNumber(bytes, length) !=
+      DartUtils::kKernelMagicNumber) {
+    return nullptr;
+  }
+
+  // 64-bit FNV-1a over the whole program. The kernel file already contains
+  // the source fingerprints of every member, so any change to the program
+  // changes the key.
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (int64_t i = 0; i < length; i++) {
+    hash ^= bytes[i];
+    hash *= 0x100000001b3ULL;
+  }
+  return Utils::SCreate("%016" Px64 " %" Pd64 " %s", hash, length,
+                        Dart_VersionString());
+}
+
+AppSnapshot* Snapshot::TryReadJITCodeCache(const char* cache_filename,
+                                           const char* key) {
+  Utils::CStringUniquePtr key_filename(JITCodeCacheKeyFilename(cache_filename),
+                                       std::free);
+  File* file = File::Open(nullptr, key_filename.get(), File::kRead);
+  if (file == nullptr) {
+    return nullptr;
+  }
+  RefCntReleaseScope<File> rs(file);
+  const intptr_t key_length = strlen(key);
+  if (file->Length() != key_length) {
+    return nullptr;
+  }
+  std::unique_ptr<char[]> stored_key(new char[key_length]);
+  if (!file->ReadFully(stored_key.get(), key_length) ||
+      (strncmp(stored_key.get(), key, key_length) != 0)) {
+    return nullptr;
+  }
+  AppSnapshot* snapshot = TryReadAppSnapshot(
+      cache_filename, /*force_load_elf_from_memory=*/false,
+      /*decode_uri=*/false);
+  if ((snapshot != nullptr) && !snapshot->IsJIT()) {
+    delete snapshot;
+    return nullptr;
+  }
+  return snapshot;
+}
+
+void Snapshot::GenerateJITCodeCache(const char* cache_filename,
+                                    const char* key) {
+  // Remove the key first: if we fail while writing the snapshot, the next
+  // run will train the cache again instead of loading a truncated file.
+  Utils::CStringUniquePtr key_filename(JITCodeCacheKeyFilename(cache_filename),
+                                       std::free);
+  File::Delete(nullptr, key_filename.get());
+  GenerateAppJIT(cache_filename);
+
+  File* file = File::Open(nullptr, key_filename.get(), File::kWriteTruncate);
+  if (file == nullptr) {
+    Syslog::PrintErr("Unable to write JIT code cache key '%s'\n",
+                     key_filename.get());
+    return;
+  }
+  if (!file->WriteFully(key, strlen(key))) {
+    Syslog::PrintErr("Unable to write JIT code cache key '%s'\n",
+                     key_filename.get());
+    file->Release();
+    File::Delete(nullptr, key_filename.get());
+    return;
+  }
+  file->Release();
+}
+
 static void StreamingWriteCallback(void* callback_data,
                                    const uint8_t* buffer,
                                    intptr_t size) {
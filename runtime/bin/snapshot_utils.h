@@ -44,6 +44,21 @@ class Snapshot {
                              const char* script_name,
                              const char* package_config);
   static void GenerateAppJIT(const char* snapshot_filename);
+
+  // A JIT code cache is an app-jit snapshot accompanied by a key file which
+  // identifies the kernel program and the VM that produced it. The key is
+  // computed before the program runs, so that updating the kernel file while
+  // the cache is being trained doesn't produce a stale cache.
+  //
+  // Returns a malloced key for the kernel file 'script_uri', or nullptr if
+  // it isn't a kernel file.
+  static char* JITCodeCacheKey(const char* script_uri);
+  // Returns the cached snapshot if it was generated with 'key', nullptr
+  // otherwise.
+  static AppSnapshot* TryReadJITCodeCache(const char* cache_filename,
+                                          const char* key);
+  static void GenerateJITCodeCache(const char* cache_filename,
+                                   const char* key);
   static void GenerateAppAOTAsAssembly(const char* snapshot_filename);
 
 #if defined(DART_TARGET_OS_MACOS)
@@ -72,4 +72,45 @@ TEST_CASE(CanDetectMachOFiles) {
 }
 #endif
 
+static void WriteTestFile(const char* filename,
+                          const uint8_t* contents,
+                          intptr_t size) {
+  auto* const file = bin::DartUtils::OpenFile(filename, /*write=*/true);
+  bin::DartUtils::WriteFile(contents, size, file);
+  bin::DartUtils::CloseFile(file);
+}
+
+TEST_CASE(JITCodeCacheKey) {
+  const char* kKernelFilename = "jit_code_cache_test.dill";
+  const char* kCacheFilename = "jit_code_cache_test.jitcache";
+  uint8_t kernel[] = {0x90, 0xab, 0xcd, 0xef, 0x00, 0x00, 0x00, 0x01,
+                      0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09};
+
+  WriteTestFile(kKernelFilename, kernel, ARRAY_SIZE(kernel));
+  char* key = bin::Snapshot::JITCodeCacheKey(kKernelFilename);
+  EXPECT(key != nullptr);
+  char* same_key = bin::Snapshot::JITCodeCacheKey(kKernelFilename);
+  EXPECT_STREQ(key, same_key);
+  free(same_key);
+
+  // Changing the program changes the key.
+  kernel[ARRAY_SIZE(kernel) - 1]++;
+  WriteTestFile(kKernelFilename, kernel, ARRAY_SIZE(kernel));
+  char* other_key = bin::Snapshot::JITCodeCacheKey(kKernelFilename);
+  EXPECT(other_key != nullptr);
+  EXPECT(strcmp(key, other_key) != 0);
+  free(other_key);
+
+  // There is no cache yet.
+  EXPECT(bin::Snapshot::TryReadJITCodeCache(kCacheFilename, key) == nullptr);
+  free(key);
+
+  // Only kernel files have a key.
+  kernel[0] = 0;
+  WriteTestFile(kKernelFilename, kernel, ARRAY_SIZE(kernel));
+  EXPECT(bin::Snapshot::JITCodeCacheKey(kKernelFilename) == nullptr);
+
+  EXPECT(bin::File::Delete(nullptr, kKernelFilename));
+}
+
 }  // namespace dart
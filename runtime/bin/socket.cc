@@ -538,38 +538,35 @@ void FUNCTION_NAME(Socket_Read)(Dart_NativeArguments args) {
     if (Socket::short_socket_read()) {
       length = (length + 1) / 2;
     }
-    uint8_t* buffer = nullptr;
-    Dart_Handle result = IOBuffer::Allocate(length, &buffer);
-    if (Dart_IsNull(result)) {
+    // Only wrap the storage in a Uint8List once we know how much was read, so
+    // a short read neither leaves a second, full-sized external buffer behind
+    // for the GC nor needs a second finalizer.
+    uint8_t* buffer = IOBuffer::Allocate(length);
+    if (buffer == nullptr) {
       Dart_ThrowException(DartUtils::NewDartOSError());
     }
-    if (Dart_IsError(result)) {
-      Dart_PropagateError(result);
-    }
-    ASSERT(buffer != nullptr);
     intptr_t bytes_read =
         SocketBase::Read(socket->fd(), buffer, length, SocketBase::kAsync);
     if (bytes_read == length) {
-      Dart_SetReturnValue(args, result);
+      Dart_SetReturnValue(args, IOBuffer::Wrap(buffer, length));
     } else if (bytes_read > 0) {
-      uint8_t* new_buffer = nullptr;
-      Dart_Handle new_result = IOBuffer::Allocate(bytes_read, &new_buffer);
-      if (Dart_IsNull(new_result)) {
+      uint8_t* new_buffer = IOBuffer::Reallocate(buffer, bytes_read);
+      if (new_buffer == nullptr) {
+        IOBuffer::Free(buffer);
         Dart_ThrowException(DartUtils::NewDartOSError());
       }
-      if (Dart_IsError(new_result)) {
-        Dart_PropagateError(new_result);
-      }
-      ASSERT(new_buffer != nullptr);
-      memmove(new_buffer, buffer, bytes_read);
-      Dart_SetReturnValue(args, new_result);
+      Dart_SetReturnValue(args, IOBuffer::Wrap(new_buffer, bytes_read));
     } else if (bytes_read == 0) {
       // On MacOS when reading from a tty Ctrl-D will result in reading one
       // less byte then reported as available.
+      IOBuffer::Free(buffer);
       Dart_SetReturnValue(args, Dart_Null());
     } else {
       ASSERT(bytes_read == -1);
-      Dart_ThrowException(DartUtils::NewDartOSError());
+      // Create the error first, freeing the buffer may clobber errno.
+      Dart_Handle error = DartUtils::NewDartOSError();
+      IOBuffer::Free(buffer);
+      Dart_ThrowException(error);
     }
   } else {
     Dart_Handle exception;
@@ -1054,15 +1051,142 @@ void FUNCTION_NAME(ServerSocket_Accept)(Dart_NativeArguments args) {
   }
 }
 
+// Concurrent lookups of the same host and address type share a single
+// SocketBase::LookupAddress call, so that a burst of connections to one host
+// sends one query to the resolver rather than one per connection. The joining
+// requests still hold their IO service threads while they wait for the
+// result. Results are not cached beyond the lookup itself, as getaddrinfo
+// does not report TTLs.
+class PendingLookup {
+ public:
+  static void Init() {
+    ASSERT(monitor_ == nullptr);
+    monitor_ = new Monitor();
+  }
+
+  static void Cleanup() {
+    ASSERT(monitor_ != nullptr);
+    ASSERT(pending_ == nullptr);
+    delete monitor_;
+    monitor_ = nullptr;
+  }
+
+  // Returns the lookup in flight for [host] and [type], or starts a new one.
+  // [*started] is set when the caller has to perform the lookup and then
+  // call Complete.
+  static PendingLookup* Join(const char* host, int type, bool* started) {
+    MonitorLocker ml(monitor_);
+    for (PendingLookup* lookup = pending_; lookup != nullptr;
+         lookup = lookup->next_) {
+      if ((lookup->type_ == type) && (strcmp(lookup->host_, host) == 0)) {
+        lookup->users_++;
+        *started = false;
+        return lookup;
+      }
+    }
+    PendingLookup* lookup = new PendingLookup(host, type);
+    lookup->next_ = pending_;
+    pending_ = lookup;
+    *started = true;
+    return lookup;
+  }
+
+  // Publishes the result. Takes ownership of [addresses] and [os_error].
+  void Complete(AddressList<SocketAddress>* addresses, OSError* os_error) {
+    MonitorLocker ml(monitor_);
+    // Lookups started from now on do not join this one.
+    PendingLookup** link = &pending_;
+    while (*link != this) {
+      link = &(*link)->next_;
+    }
+    *link = next_;
+    addresses_ = addresses;
+    os_error_ = os_error;
+    done_ = true;
+    ml.NotifyAll();
+  }
+
+  void WaitForResult() {
+    MonitorLocker ml(monitor_);
+    while (!done_) {
+      ml.Wait(Monitor::kNoTimeout);
+    }
+  }
+
+  // The result stays valid until this user calls Release.
+  AddressList<SocketAddress>* addresses() const { return addresses_; }
+  OSError* os_error() const { return os_error_; }
+
+  void Release() {
+    bool last;
+    {
+      MonitorLocker ml(monitor_);
+      last = (--users_ == 0);
+    }
+    if (last) {
+      delete this;
+    }
+  }
+
+ private:
+  PendingLookup(const char* host, int type)
+      : host_(Utils::StrDup(host)),
+        type_(type),
+        users_(1),
+        done_(false),
+        addresses_(nullptr),
+        os_error_(nullptr),
+        next_(nullptr) {}
+
+  ~PendingLookup() {
+    free(host_);
+    delete addresses_;
+    delete os_error_;
+  }
+
+  static Monitor* monitor_;
+  static PendingLookup* pending_;
+
+  char* host_;
+  const int type_;
+  intptr_t users_;
+  bool done_;
+  AddressList<SocketAddress>* addresses_;
+  OSError* os_error_;
+  PendingLookup* next_;
+
+  DISALLOW_COPY_AND_ASSIGN(PendingLookup);
+};
+
+Monitor* PendingLookup::monitor_ = nullptr;
+PendingLookup* PendingLookup::pending_ = nullptr;
+
+void Socket::InitLookupMonitor() {
+  PendingLookup::Init();
+}
+
+void Socket::CleanupLookupMonitor() {
+  PendingLookup::Cleanup();
+}
+
 CObject* Socket::LookupRequest(const CObjectArray& request) {
   if ((request.Length() == 2) && request[0]->IsString() &&
       request[1]->IsInt32()) {
     CObjectString host(request[0]);
     CObjectInt32 type(request[1]);
     CObject* result = nullptr;
-    OSError* os_error = nullptr;
-    AddressList<SocketAddress>* addresses =
-        SocketBase::LookupAddress(host.CString(), type.Value(), &os_error);
+    bool started = false;
+    PendingLookup* lookup =
+        PendingLookup::Join(host.CString(), type.Value(), &started);
+    if (started) {
+      OSError* os_error = nullptr;
+      AddressList<SocketAddress>* addresses =
+          SocketBase::LookupAddress(host.CString(), type.Value(), &os_error);
+      lookup->Complete(addresses, os_error);
+    } else {
+      lookup->WaitForResult();
+    }
+    AddressList<SocketAddress>* addresses = lookup->addresses();
     if (addresses != nullptr) {
       CObjectArray* array =
           new CObjectArray(CObject::NewArray(addresses->count() + 1));
@@ -1090,11 +1214,10 @@ CObject* Socket::LookupRequest(const CObjectArray& request) {
         array->SetAt(i + 1, entry);
       }
       result = array;
-      delete addresses;
     } else {
-      result = CObject::NewOSError(os_error);
-      delete os_error;
+      result = CObject::NewOSError(lookup->os_error());
     }
+    lookup->Release();
     return result;
   }
   return CObject::IllegalArgumentError();
@@ -51,6 +51,10 @@ class Socket : public ReferenceCounted<Socket> {
 
   intptr_t fd() const { return fd_; }
 
+  // The descriptor this socket was created with. Unlike [fd] it never
+  // changes, so any thread may read it to pick the socket's event handler.
+  intptr_t shard_key() const { return shard_key_; }
+
   // Close fd and may need to decrement the count of handle by calling
   // release().
   void CloseFd();
@@ -68,6 +72,11 @@ class Socket : public ReferenceCounted<Socket> {
 
   static bool Initialize();
 
+  // Creates and deletes the monitor shared by concurrent lookup requests for
+  // the same host.
+  static void InitLookupMonitor();
+  static void CleanupLookupMonitor();
+
   // Creates a socket which is bound and connected. The port to connect to is
   // specified as the port component of the passed RawAddr structure.
   static intptr_t CreateConnect(const RawAddr& addr);
@@ -125,6 +134,7 @@ class Socket : public ReferenceCounted<Socket> {
   static bool short_socket_write_;
 
   intptr_t fd_;
+  const intptr_t shard_key_;
   Dart_Port isolate_port_;
   Dart_Port port_;
   uint8_t* udp_receive_buffer_;
@@ -219,28 +219,28 @@ void FUNCTION_NAME(SynchronousSocket_Read)(Dart_NativeArguments args) {
                                   "First parameter must be an integer."));
     return;
   }
-  uint8_t* buffer = nullptr;
-  result = IOBuffer::Allocate(length, &buffer);
-  if (Dart_IsNull(result)) {
+  uint8_t* buffer = IOBuffer::Allocate(length);
+  if (buffer == nullptr) {
     Dart_SetReturnValue(args, DartUtils::NewDartOSError());
     return;
   }
-  ASSERT(buffer != nullptr);
   intptr_t bytes_read = SynchronousSocket::Read(socket->fd(), buffer, length);
   if (bytes_read == length) {
-    Dart_SetReturnValue(args, result);
+    Dart_SetReturnValue(args, IOBuffer::Wrap(buffer, length));
   } else if (bytes_read > 0) {
-    uint8_t* new_buffer = nullptr;
-    Dart_Handle new_result = IOBuffer::Allocate(bytes_read, &new_buffer);
-    if (Dart_IsNull(new_result)) {
+    uint8_t* new_buffer = IOBuffer::Reallocate(buffer, bytes_read);
+    if (new_buffer == nullptr) {
+      IOBuffer::Free(buffer);
       Dart_SetReturnValue(args, DartUtils::NewDartOSError());
       return;
     }
-    ASSERT(new_buffer != nullptr);
-    memmove(new_buffer, buffer, bytes_read);
-    Dart_SetReturnValue(args, new_result);
-  } else if (bytes_read == -1) {
-    Dart_SetReturnValue(args, DartUtils::NewDartOSError());
+    Dart_SetReturnValue(args, IOBuffer::Wrap(new_buffer, bytes_read));
+  } else {
+    // Create the error first, freeing the buffer may clobber errno.
+    if (bytes_read == -1) {
+      Dart_SetReturnValue(args, DartUtils::NewDartOSError());
+    }
+    IOBuffer::Free(buffer);
   }
 }
 
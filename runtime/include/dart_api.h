@@ -1367,6 +1367,23 @@ DART_EXPORT void Dart_NotifyDestroyed(void);
  */
 DART_EXPORT void Dart_NotifyLowMemory(void);
 
+/**
+ * Freezes the deeply immutable object graph reachable from |object|, such as
+ * a large constant lookup table, into permanently live old-space objects.
+ * Collections no longer trace the frozen objects and never free them, even
+ * after |object| becomes unreachable.
+ *
+ * Requires there to be a current isolate.
+ *
+ * \param object An object.
+ * \param frozen_size Returns the number of bytes frozen. This is 0 if the
+ *   graph is not deeply immutable.
+ *
+ * \return A valid handle if no error occurs during the operation.
+ */
+DART_EXPORT Dart_Handle Dart_MakePermanent(Dart_Handle object,
+                                           intptr_t* frozen_size);
+
 typedef enum {
   /**
    * Balanced
@@ -2268,6 +2285,29 @@ DART_EXPORT Dart_Handle Dart_NewStringFromCString(const char* str);
 DART_EXPORT Dart_Handle Dart_NewStringFromUTF8(const uint8_t* utf8_array,
                                                intptr_t length);
 
+/**
+ * Creates several Strings from UTF-8 encoded characters packed back to back
+ * in one array.
+ *
+ * This is equivalent to calling Dart_NewStringFromUTF8 for each string, but
+ * enters the VM only once.
+ *
+ * If any of the strings is not valid UTF-8, an error occurs and no Strings are
+ * created.
+ *
+ * \param utf8_array An array holding the UTF-8 encoded characters of all
+ *   strings, one after the other.
+ * \param lengths An array of count lengths, one for each string.
+ * \param count The number of strings to create.
+ * \param strings An array of count handles to fill with the new Strings.
+ *
+ * \return Success if no error occurs during the operation.
+ */
+DART_EXPORT Dart_Handle Dart_NewStringsFromUTF8(const uint8_t* utf8_array,
+                                                const intptr_t* lengths,
+                                                intptr_t count,
+                                                Dart_Handle* strings);
+
 /**
  * Returns a String built from an array of UTF-16 encoded characters.
  *
@@ -2537,6 +2577,58 @@ DART_EXPORT Dart_Handle Dart_ListSetAt(Dart_Handle list,
                                        intptr_t index,
                                        Dart_Handle value);
 
+/**
+ * Sets a range of Objects in a List.
+ *
+ * This is equivalent to calling Dart_ListSetAt for each element, but enters
+ * the VM only once.
+ *
+ * If any of the requested index values are out of bounds, an error occurs.
+ * If any of the values is not an Instance, an error occurs and the List is left
+ * unchanged.
+ *
+ * May generate an unhandled exception error.
+ *
+ * \param list A List.
+ * \param offset The offset of the first item to set.
+ * \param length The number of items to set.
+ * \param values An array of length objects to put in the List.
+ *
+ * \return Success if no error occurs during the operation.
+ */
+DART_EXPORT Dart_Handle Dart_ListSetRange(Dart_Handle list,
+                                          intptr_t offset,
+                                          intptr_t length,
+                                          const Dart_Handle* values);
+
+/**
+ * Gets the UTF-8 encoded representations of a range of Strings in a List.
+ *
+ * The encodings are packed back to back into a single array, in the layout
+ * expected by Dart_NewStringsFromUTF8. Unpaired surrogates are converted as in
+ * Dart_StringToUTF8.
+ *
+ * If any of the requested index values are out of bounds, or any of the
+ * elements is not a String, an error occurs.
+ *
+ * May generate an unhandled exception error.
+ *
+ * \param list A List of Strings.
+ * \param offset The offset of the first String to get.
+ * \param length The number of Strings to get.
+ * \param utf8_array Returns the UTF-8 code units of all Strings. This array is
+ *   scope allocated and is only valid until the next call to Dart_ExitScope.
+ * \param lengths An array of length entries to fill with the length of each
+ *   String's encoding.
+ *
+ * \return Success if no error occurs during the operation.
+ */
+DART_EXPORT Dart_Handle Dart_ListGetStringsAsUTF8(Dart_Handle list,
+                                                  intptr_t offset,
+                                                  intptr_t length,
+                                                  uint8_t** utf8_array,
+                                                  intptr_t* lengths);
+
 /**
  * May generate an unhandled exception error.
  */
@@ -126,6 +126,27 @@ typedef struct _Dart_CObject {
  */
 DART_EXPORT bool Dart_PostCObject(Dart_Port port_id, Dart_CObject* message);
 
+/**
+ * Posts several messages on some port, as if by calling Dart_PostCObject for
+ * each of them in order, but taking the receiver's locks and waking it up only
+ * once for the whole batch.
+ *
+ * Either all messages are enqueued or none is. If false is returned, ownership
+ * of external typed data in all messages remains with the caller.
+ *
+ * This function may be called on any thread when the VM is running (that is,
+ * after Dart_Initialize has returned and before Dart_Cleanup has been called).
+ *
+ * \param port_id The destination port.
+ * \param num_messages The number of entries in 'messages'.
+ * \param messages The messages to send.
+ *
+ * \return True if the messages were posted.
+ */
+DART_EXPORT bool Dart_PostCObjects(Dart_Port port_id,
+                                   intptr_t num_messages,
+                                   Dart_CObject** messages);
+
 /**
  * Posts a message on some port. The message will contain the integer 'message'.
  *
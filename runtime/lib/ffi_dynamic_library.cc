@@ -29,6 +29,80 @@
 
 namespace dart {
 
+struct NativeAssetsLibrary {
+  char* path;  // nullptr for the executable.
+  void* handle;
+};
+
+static Mutex* native_assets_libraries_mutex = nullptr;
+static MallocGrowableArray<NativeAssetsLibrary>* native_assets_libraries =
+    nullptr;
+
+void NativeAssetsLibraries::Init() {
+  ASSERT(native_assets_libraries_mutex == nullptr);
+  native_assets_libraries_mutex =
+      new Mutex(NOT_IN_PRODUCT("native_assets_libraries_mutex"));
+  ASSERT(native_assets_libraries == nullptr);
+  native_assets_libraries = new MallocGrowableArray<NativeAssetsLibrary>();
+}
+
+void NativeAssetsLibraries::Cleanup() {
+  // The libraries themselves stay loaded, as code may still refer to them.
+  for (intptr_t i = 0; i < native_assets_libraries->length(); i++) {
+    free(native_assets_libraries->At(i).path);
+  }
+  delete native_assets_libraries;
+  native_assets_libraries = nullptr;
+  delete native_assets_libraries_mutex;
+  native_assets_libraries_mutex = nullptr;
+}
+
+// Returns whether [path] is in the cache, and if so its handle in [handle].
+// Requires native_assets_libraries_mutex to be held.
+static bool FindNativeAssetsLibrary(const char* path, void** handle) {
+  for (intptr_t i = 0; i < native_assets_libraries->length(); i++) {
+    const NativeAssetsLibrary& library = native_assets_libraries->At(i);
+    if ((library.path == nullptr) ? (path == nullptr)
+                                  : (path != nullptr &&
+                                     strcmp(library.path, path) == 0)) {
+      *handle = library.handle;
+      return true;
+    }
+  }
+  return false;
+}
+
+void* NativeAssetsLibraries::Load(const char* path, char** error) {
+  void* handle = nullptr;
+  {
+    MutexLocker ml(native_assets_libraries_mutex);
+    if (FindNativeAssetsLibrary(path, &handle)) {
+      return handle;
+    }
+  }
+  // Loading runs the library's initializers, which may be slow or load
+  // further assets, so it happens without holding the mutex.
+  char* utils_error = nullptr;
+  handle = Utils::LoadDynamicLibrary(path, &utils_error);
+  if (utils_error != nullptr) {
+    *error = OS::SCreate(
+        /*use malloc*/ nullptr, "Failed to load dynamic library '%s': %s",
+        path != nullptr ? path : "<process>", utils_error);
+    free(utils_error);
+    return nullptr;
+  }
+  MutexLocker ml(native_assets_libraries_mutex);
+  void* loaded = nullptr;
+  if (FindNativeAssetsLibrary(path, &loaded)) {
+    // Another thread loaded the library meanwhile. Drop the extra reference.
+    Utils::UnloadDynamicLibrary(handle);
+    return loaded;
+  }
+  native_assets_libraries->Add(
+      {path != nullptr ? Utils::StrDup(path) : nullptr, handle});
+  return handle;
+}
+
 #if defined(USING_SIMULATOR) || (defined(DART_PRECOMPILER) && !defined(TESTING))
 
 DART_NORETURN static void SimulatorUnsupported() {
@@ -376,6 +450,27 @@ static char* AvailableAssetsToCString(Thread* const thread) {
   return buffer.buffer();
 }
 
+// The script URI relative native assets are resolved against. It is the same
+// for every lookup in an isolate group, so it is computed once.
+static const char* GetPlatformScriptUri(Thread* thread) {
+  IsolateGroupSource* const source = thread->isolate_group()->source();
+  char* uri = source->native_assets_script_uri.load();
+  if (uri == nullptr) {
+    char* const new_uri = OS::SCreate(
+        /*use malloc*/ nullptr, "%s%s", file_schema,
+        String::Handle(thread->zone(), GetPlatformScriptPath(thread))
+            .ToCString());
+    if (source->native_assets_script_uri.compare_exchange_strong(uri,
+                                                                 new_uri)) {
+      uri = new_uri;
+    } else {
+      // Another isolate of the group got there first.
+      free(new_uri);
+    }
+  }
+  return uri;
+}
+
 // If an error occurs populates |error| with an error message
 // (caller must free this message when it is no longer needed).
 //
@@ -398,31 +493,27 @@ static void* FfiResolveAsset(Thread* const thread,
   }
   void* handle = nullptr;
   if (asset_type.Equals(Symbols::absolute())) {
-    handle = LoadDynamicLibrary(path.ToCString(), error);
+    handle = NativeAssetsLibraries::Load(path.ToCString(), error);
   } else if (asset_type.Equals(Symbols::relative())) {
-    const auto& platform_script_uri = String::Handle(
-        zone,
-        String::NewFormatted(
-            "%s%s", file_schema,
-            String::Handle(zone, GetPlatformScriptPath(thread)).ToCString()));
+    const char* platform_script_uri = GetPlatformScriptUri(thread);
     const char* target_uri = nullptr;
     char* path_cstr = path.ToMallocCString();
 #if defined(DART_TARGET_OS_WINDOWS)
     ReplaceBackSlashes(path_cstr);
 #endif
     const bool resolved =
-        ResolveUri(path_cstr, platform_script_uri.ToCString(), &target_uri);
+        ResolveUri(path_cstr, platform_script_uri, &target_uri);
     free(path_cstr);
     if (!resolved) {
       *error = OS::SCreate(/*use malloc*/ nullptr,
                            "Failed to resolve '%s' relative to '%s'.",
-                           path.ToCString(), platform_script_uri.ToCString());
+                           path.ToCString(), platform_script_uri);
     } else {
       const char* target_path = target_uri + file_schema_length;
-      handle = LoadDynamicLibrary(target_path, error);
+      handle = NativeAssetsLibraries::Load(target_path, error);
     }
   } else if (asset_type.Equals(Symbols::system())) {
-    handle = LoadDynamicLibrary(path.ToCString(), error);
+    handle = NativeAssetsLibraries::Load(path.ToCString(), error);
   } else if (asset_type.Equals(Symbols::process())) {
 #if defined(DART_HOST_OS_LINUX) || defined(DART_HOST_OS_MACOS) ||              \
     defined(DART_HOST_OS_ANDROID) || defined(DART_HOST_OS_FUCHSIA)
@@ -431,7 +522,7 @@ static void* FfiResolveAsset(Thread* const thread,
     handle = kWindowsDynamicLibraryProcessPtr;
 #endif
   } else if (asset_type.Equals(Symbols::executable())) {
-    handle = LoadDynamicLibrary(nullptr, error);
+    handle = NativeAssetsLibraries::Load(nullptr, error);
   } else {
     UNREACHABLE();
   }
@@ -5,10 +5,31 @@
 #ifndef RUNTIME_LIB_FFI_DYNAMIC_LIBRARY_H_
 #define RUNTIME_LIB_FFI_DYNAMIC_LIBRARY_H_
 
+#include "vm/allocation.h"
 #include "vm/object.h"
 
 namespace dart {
 
+// Handles of the dynamic libraries loaded for native assets, shared by all
+// isolate groups.
+//
+// Every @Native function bound to a native asset resolves its symbol on first
+// call, and an asset usually provides many symbols. With the cache each
+// library is only located and loaded once per process instead of once per
+// symbol.
+class NativeAssetsLibraries : public AllStatic {
+ public:
+  static void Init();
+  static void Cleanup();
+
+  // Returns the handle of the library at [path], loading it if it has not
+  // been loaded yet. [path] may be nullptr for the executable.
+  //
+  // If an error occurs populates |error| with an error message
+  // (caller must free this message when it is no longer needed).
+  static void* Load(const char* path, char** error);
+};
+
 intptr_t FfiResolveInternal(const String& asset,
                             const String& symbol,
                             uintptr_t args_n,
@@ -139,17 +139,10 @@ DEFINE_NATIVE_ENTRY(RegExp_getGroupNameMap, 0, 1) {
   return Object::null();
 }
 
-static ObjectPtr ExecuteMatch(Zone* zone,
-                              NativeArguments* arguments,
-                              bool sticky) {
-  const RegExp& regexp = RegExp::CheckedHandle(zone, arguments->NativeArgAt(0));
-  ASSERT(!regexp.IsNull());
-  GET_NON_NULL_NATIVE_ARGUMENT(String, subject, arguments->NativeArgAt(1));
-  GET_NON_NULL_NATIVE_ARGUMENT(Smi, start_index, arguments->NativeArgAt(2));
-
-  // Both generated code and the interpreter are using 32-bit registers and
-  // 32-bit backtracking stack so they can't work with strings which are
-  // larger than that. Validate these assumptions before running the regexp.
+// Both generated code and the interpreter are using 32-bit registers and
+// 32-bit backtracking stack so they can't work with strings which are
+// larger than that. Validate these assumptions before running the regexp.
+static void CheckMatchArguments(const String& subject, const Smi& start_index) {
   if (!Utils::IsInt(32, subject.Length())) {
     Exceptions::ThrowRangeError("length",
                                 Integer::Handle(Integer::New(subject.Length())),
@@ -159,9 +152,21 @@ static ObjectPtr ExecuteMatch(Zone* zone,
     Exceptions::ThrowRangeError("start_index", Integer::Cast(start_index),
                                 kMinInt32, kMaxInt32);
   }
+}
+
+static ObjectPtr ExecuteMatch(Zone* zone,
+                              NativeArguments* arguments,
+                              bool sticky) {
+  const RegExp& regexp = RegExp::CheckedHandle(zone, arguments->NativeArgAt(0));
+  ASSERT(!regexp.IsNull());
+  GET_NON_NULL_NATIVE_ARGUMENT(String, subject, arguments->NativeArgAt(1));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, start_index, arguments->NativeArgAt(2));
+  CheckMatchArguments(subject, start_index);
 
 #if !defined(DART_PRECOMPILED_RUNTIME)
-  if (!FLAG_interpret_irregexp) {
+  if (!FLAG_interpret_irregexp &&
+      RegExpEngine::TierUpIfNeeded(Thread::Current(), regexp,
+                                   subject.GetClassId(), sticky)) {
     return IRRegExpMacroAssembler::Execute(regexp, subject, start_index,
                                            /*sticky=*/sticky, zone);
   }
@@ -180,4 +185,35 @@ DEFINE_NATIVE_ENTRY(RegExp_ExecuteMatchSticky, 0, 3) {
   return ExecuteMatch(zone, arguments, /*sticky=*/true);
 }
 
+static bool InterpretsMatches() {
+#if defined(DART_PRECOMPILED_RUNTIME)
+  return true;
+#else
+  return FLAG_interpret_irregexp;
+#endif
+}
+
+DEFINE_NATIVE_ENTRY(RegExp_interpretsMatches, 0, 0) {
+  return Bool::Get(InterpretsMatches()).ptr();
+}
+
+DEFINE_NATIVE_ENTRY(RegExp_ExecuteMatchInto, 0, 4) {
+  const RegExp& regexp = RegExp::CheckedHandle(zone, arguments->NativeArgAt(0));
+  ASSERT(!regexp.IsNull());
+  GET_NON_NULL_NATIVE_ARGUMENT(String, subject, arguments->NativeArgAt(1));
+  GET_NON_NULL_NATIVE_ARGUMENT(Smi, start_index, arguments->NativeArgAt(2));
+  GET_NON_NULL_NATIVE_ARGUMENT(TypedData, indices, arguments->NativeArgAt(3));
+  CheckMatchArguments(subject, start_index);
+  // The caller makes sure [indices] can hold the start and end of each group.
+  ASSERT(indices.GetClassId() == kTypedDataInt32ArrayCid);
+  ASSERT(indices.Length() >= (regexp.num_bracket_expressions() + 1) * 2);
+  // Generated code allocates its result, so with it the caller uses the
+  // intrinsified RegExp_ExecuteMatch instead.
+  ASSERT(InterpretsMatches());
+  return Bool::Get(BytecodeRegExpMacroAssembler::InterpretInto(
+                       regexp, subject, start_index, /*sticky=*/false, indices,
+                       zone))
+      .ptr();
+}
+
 }  // namespace dart
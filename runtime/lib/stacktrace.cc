@@ -34,21 +34,39 @@ static StackTracePtr CreateStackTraceObject(
   return StackTrace::New(code_array, pc_offset_array);
 }
 
+static StackTracePtr CreateStackTraceObject(
+    Zone* zone,
+    const GrowableArray<const Code*>& code_list,
+    const GrowableArray<uword>& pc_offset_list) {
+  ASSERT_EQUAL(code_list.length(), pc_offset_list.length());
+  const auto& code_array = Array::Handle(zone, Array::New(code_list.length()));
+  for (intptr_t i = 0; i < code_list.length(); i++) {
+    code_array.SetAt(i, *code_list[i]);
+  }
+  const auto& pc_offset_array = TypedData::Handle(
+      zone, TypedData::New(kUintPtrCid, pc_offset_list.length()));
+  {
+    NoSafepointScope no_safepoint;
+    memmove(pc_offset_array.DataAddr(0), pc_offset_list.data(),
+            pc_offset_list.length() * kWordSize);
+  }
+  return StackTrace::New(code_array, pc_offset_array);
+}
+
 // Gets current stack trace for `thread`.
 static StackTracePtr CurrentStackTrace(Thread* thread,
                                        intptr_t skip_frames = 1) {
   Zone* zone = thread->zone();
 
-  const auto& code_array = GrowableObjectArray::ZoneHandle(
-      zone, GrowableObjectArray::New(kDefaultStackAllocation));
+  // Collect the frames into zone memory, so that only the final, exactly sized
+  // arrays are allocated in the heap.
+  GrowableArray<const Code*> code_array(kDefaultStackAllocation);
   GrowableArray<uword> pc_offset_array(kDefaultStackAllocation);
-
-  // Collect the frames.
-  StackTraceUtils::CollectFrames(thread, skip_frames,
-                                 [&](const StackTraceUtils::Frame& frame) {
-                                   code_array.Add(frame.code);
-                                   pc_offset_array.Add(frame.pc_offset);
-                                 });
+  StackTraceUtils::CollectFrames(
+      thread, skip_frames, [&](const StackTraceUtils::Frame& frame) {
+        code_array.Add(&Code::ZoneHandle(zone, frame.code.ptr()));
+        pc_offset_array.Add(frame.pc_offset);
+      });
 
   return CreateStackTraceObject(zone, code_array, pc_offset_array);
 }
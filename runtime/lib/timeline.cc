@@ -44,6 +44,10 @@ DEFINE_NATIVE_ENTRY(Timeline_reportTaskEvent, 0, 5) {
   GET_NON_NULL_NATIVE_ARGUMENT(String, name, arguments->NativeArgAt(3));
   GET_NON_NULL_NATIVE_ARGUMENT(String, args, arguments->NativeArgAt(4));
 
+  if (!DartTimelineEventHelpers::ShouldReport(isolate, type.Value())) {
+    return Object::null();
+  }
+
   TimelineEventRecorder* recorder = Timeline::recorder();
   if (recorder == nullptr) {
     return Object::null();
@@ -163,18 +163,30 @@ void SimpleHashMap::Initialize(uint32_t capacity) {
 
 void SimpleHashMap::Resize() {
   Entry* map = map_;
-  uint32_t n = occupancy_;
+  const uint32_t occupancy = occupancy_;
 
   // Allocate larger map.
   Initialize(capacity_ * 2);
 
-  // Rehash all current entries.
+  // Rehash all current entries. The keys are known to be distinct, so each
+  // entry goes into the first free slot of its probe sequence without calling
+  // the match function.
+  const Entry* end = map_end();
+  uint32_t n = occupancy;
   for (Entry* p = map; n > 0; p++) {
     if (p->key != nullptr) {
-      Lookup(p->key, p->hash, true)->value = p->value;
+      Entry* q = map_ + (p->hash & (capacity_ - 1));
+      while (q->key != nullptr) {
+        q++;
+        if (q >= end) {
+          q = map_;
+        }
+      }
+      *q = *p;
       n--;
     }
   }
+  occupancy_ = occupancy;
 
   // Delete old map.
   delete[] map;
@@ -220,14 +220,17 @@ main() {
     "Dart_ListGetAsBytes",
     "Dart_ListGetAt",
     "Dart_ListGetRange",
+    "Dart_ListGetStringsAsUTF8",
     "Dart_ListLength",
     "Dart_ListSetAsBytes",
     "Dart_ListSetAt",
+    "Dart_ListSetRange",
     "Dart_LoadingUnitLibraryUris",
     "Dart_LoadLibrary",
     "Dart_LoadLibraryFromKernel",
     "Dart_LoadScriptFromKernel",
     "Dart_LookupLibrary",
+    "Dart_MakePermanent",
     "Dart_MapContainsKey",
     "Dart_MapGetAt",
     "Dart_MapKeys",
@@ -254,6 +257,7 @@ main() {
     "Dart_NewStringFromUTF16",
     "Dart_NewStringFromUTF32",
     "Dart_NewStringFromUTF8",
+    "Dart_NewStringsFromUTF8",
     "Dart_NewTypedData",
     "Dart_NewUnhandledExceptionError",
     "Dart_NewUnmodifiableExternalTypedDataWithFinalizer",
@@ -267,6 +271,7 @@ main() {
     "Dart_ObjectIsType",
     "Dart_Post",
     "Dart_PostCObject",
+    "Dart_PostCObjects",
     "Dart_PostInteger",
     "Dart_Precompile",
     "Dart_PrepareToAbort",
@@ -0,0 +1,47 @@
+// Copyright (c) 2024, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Verifies that identity hash codes can be computed for constant doubles,
+// which in AOT snapshots come from the snapshot rather than being allocated
+// at runtime.
+
+import 'dart:collection';
+import 'dart:isolate';
+
+import 'package:expect/expect.dart';
+
+const double kHalf = 0.5;
+const double kOne = 1.0;
+const List<double> kDoubles = [0.5, 1.0, -2.25, 1e300, double.infinity];
+
+@pragma('vm:never-inline')
+double boxed(double value) => value;
+
+main() async {
+  Expect.equals(identityHashCode(kHalf), identityHashCode(0.5));
+  Expect.equals(identityHashCode(kHalf), identityHashCode(boxed(0.5)));
+  Expect.equals(identityHashCode(kOne), identityHashCode(boxed(1.0)));
+  Expect.equals(identityHashCode(kHalf), identityHashCode(kHalf));
+
+  final map = LinkedHashMap<Object, int>.identity();
+  for (int i = 0; i < kDoubles.length; i++) {
+    map[kDoubles[i]] = i;
+  }
+  for (int i = 0; i < kDoubles.length; i++) {
+    Expect.equals(i, map[kDoubles[i]]);
+    Expect.equals(i, map[boxed(kDoubles[i])]);
+  }
+
+  final set = HashSet<Object>.identity()..addAll(kDoubles);
+  Expect.isTrue(set.contains(kHalf));
+  Expect.isTrue(set.contains(boxed(-2.25)));
+
+  // Constant doubles inside an identity map that is copied to another
+  // isolate are rehashed on the receiving side.
+  final copy = await Isolate.run(() => map);
+  Expect.equals(kDoubles.length, copy.length);
+  for (int i = 0; i < kDoubles.length; i++) {
+    Expect.equals(i, copy[kDoubles[i]]);
+  }
+}
@@ -0,0 +1,132 @@
+// Copyright (c) 2024, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Sends large graphs while another isolate of the group keeps collecting
+// garbage, so the fast object copy checks in to safepoints (and sees objects
+// move) in the middle of a copy and has to resume it.
+
+// VMOptions=--enable-fast-object-copy --new_gen_semi_max_size=32
+// VMOptions=--enable-fast-object-copy --new_gen_semi_max_size=32 --force-evacuation
+// VMOptions=--enable-fast-object-copy --new_gen_semi_max_size=32 --verify_after_gc
+// VMOptions=--enable-fast-object-copy --gc-on-foc-slow-path --force-evacuation
+
+import 'dart:async';
+import 'dart:isolate';
+import 'dart:typed_data';
+
+import 'package:expect/expect.dart';
+
+import 'fast_object_copy_test.dart' show SendReceiveTestBase;
+
+const int kNumNodes = 100000;
+const int kRounds = 20;
+
+class Node {
+  final int id;
+  final String name;
+  final Float64List data;
+  final Map<int, Node> byId;
+  final List<Node> children = [];
+  Node? parent;
+  Object? shared;
+
+  Node(this.id)
+      : name = 'node$id',
+        data = Float64List.fromList([id.toDouble(), id / 2]),
+        byId = <int, Node>{};
+}
+
+Node buildGraph() {
+  final shared = <Object>['shared', 42, Uint8List(16)];
+  final nodes = <Node>[];
+  for (int i = 0; i < kNumNodes; i++) {
+    final node = Node(i);
+    if (i > 0) {
+      final parent = nodes[(i - 1) ~/ 4];
+      parent.children.add(node);
+      parent.byId[i] = node;
+      node.parent = parent;
+    }
+    if (i % 100 == 0) {
+      node.shared = shared;
+    }
+    nodes.add(node);
+  }
+  return nodes.first;
+}
+
+void verifyGraph(Node original, Node copy) {
+  Expect.notIdentical(original, copy);
+  Object? shared;
+  int count = 0;
+  final worklist = <Node>[copy];
+  while (worklist.isNotEmpty) {
+    final node = worklist.removeLast();
+    count++;
+    Expect.equals('node${node.id}', node.name);
+    Expect.equals(node.id.toDouble(), node.data[0]);
+    Expect.equals(node.id / 2, node.data[1]);
+    Expect.equals(node.children.length, node.byId.length);
+    for (final child in node.children) {
+      Expect.identical(node, child.parent);
+      Expect.identical(child, node.byId[child.id]);
+      worklist.add(child);
+    }
+    if (node.id % 100 == 0) {
+      // The shared list is copied once and stays shared within the copy.
+      shared ??= node.shared;
+      Expect.identical(shared, node.shared);
+    } else {
+      Expect.isNull(node.shared);
+    }
+  }
+  Expect.equals(kNumNodes, count);
+  Expect.notIdentical(original.shared, shared);
+  Expect.listEquals(['shared', 42], (shared as List).sublist(0, 2));
+  Expect.equals(16, (shared[2] as Uint8List).length);
+}
+
+Future<void> churn(SendPort stopped) async {
+  final stop = ReceivePort();
+  stopped.send(stop.sendPort);
+  bool running = true;
+  stop.listen((_) {
+    running = false;
+    stop.close();
+  });
+  var survivors = <List>[];
+  while (running) {
+    for (int i = 0; i < 10000; i++) {
+      final garbage = List<int?>.filled(16, i);
+      if (i % 64 == 0) survivors.add(garbage);
+    }
+    if (survivors.length > 10000) survivors = <List>[];
+    await Future.delayed(Duration.zero);
+  }
+  stopped.send(null);
+}
+
+class SafepointDuringCopyTest extends SendReceiveTestBase {
+  Future runTests() async {
+    final port = ReceivePort();
+    final events = StreamIterator(port);
+    await Isolate.spawn(churn, port.sendPort);
+    Expect.isTrue(await events.moveNext());
+    final stop = events.current as SendPort;
+
+    final graph = buildGraph();
+    for (int i = 0; i < kRounds; i++) {
+      verifyGraph(graph, await sendReceive(graph));
+    }
+
+    stop.send(null);
+    Expect.isTrue(await events.moveNext());
+    await events.cancel();
+    port.close();
+  }
+}
+
+main() async {
+  await SafepointDuringCopyTest().run();
+}
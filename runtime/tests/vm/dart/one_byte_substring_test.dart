@@ -0,0 +1,21 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Verifies that substrings of one-byte strings are copied correctly for all
+// lengths and alignments, covering the word, byte and rep movsb copies of
+// the x64 intrinsic.
+
+import "package:expect/expect.dart";
+
+void main() {
+  final source = String.fromCharCodes(
+      List<int>.generate(300, (i) => 0x20 + (i * 7) % 0x5f));
+  for (int start = 0; start < 16; start++) {
+    for (int length = 0; length <= 160; length++) {
+      final expected = String.fromCharCodes(
+          source.codeUnits.getRange(start, start + length));
+      Expect.equals(expected, source.substring(start, start + length));
+    }
+  }
+}
@@ -0,0 +1,119 @@
+// Copyright (c) 2024, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Tests RegExp.hasMatch, RegExp.stringMatch and String.replaceAll, which find
+// matches without allocating a RegExpMatch when regexps are interpreted.
+//
+// VMOptions=
+// VMOptions=--interpret_irregexp
+// VMOptions=--regexp_tier_up_threshold=2
+
+import 'package:expect/expect.dart';
+
+void testGroups() {
+  final re = RegExp(r'(\w+)@(\w+)\.com');
+  Expect.isTrue(re.hasMatch('mail alice@example.com now'));
+  Expect.isFalse(re.hasMatch('mail alice at example dot com'));
+  Expect.equals('alice@example.com', re.stringMatch('to alice@example.com'));
+  Expect.isNull(re.stringMatch('nobody'));
+  Expect.equals('to X and X.',
+      'to alice@example.com and bob@test.com.'.replaceAll(re, 'X'));
+
+  // More groups than any regexp used before, so the shared index buffer
+  // has to grow.
+  final many = RegExp(r'(a)(b)(c)(d)(e)(f)(g)(h)(i)(j)(k)(l)');
+  Expect.isTrue(many.hasMatch('xxabcdefghijklxx'));
+  Expect.equals('abcdefghijkl', many.stringMatch('xxabcdefghijklxx'));
+  Expect.equals('xx-xx-', 'xxabcdefghijklxxabcdefghijkl'.replaceAll(many, '-'));
+
+  // Optional groups that do not participate.
+  final optional = RegExp(r'a(b)?(c)?d');
+  Expect.equals('ad', optional.stringMatch('xadx'));
+  Expect.equals('abd', optional.stringMatch('xabdx'));
+  Expect.equals('x_x_x', 'xadxacdx'.replaceAll(optional, '_'));
+}
+
+void testSticky() {
+  final re = RegExp(r'\d+');
+  // matchAsPrefix is sticky and must not be affected by the other methods
+  // sharing buffers.
+  Expect.isTrue(re.hasMatch('abc123'));
+  Expect.isNull(re.matchAsPrefix('abc123'));
+  Expect.equals('123', re.matchAsPrefix('abc123', 3)![0]);
+  Expect.equals('123', re.stringMatch('abc123'));
+  Expect.equals('12', re.matchAsPrefix('12ab34')![0]);
+  Expect.equals('#ab#', '12ab34'.replaceAll(re, '#'));
+}
+
+void testEmptyMatches() {
+  final empty = RegExp(r'');
+  Expect.isTrue(empty.hasMatch(''));
+  Expect.isTrue(empty.hasMatch('abc'));
+  Expect.equals('', empty.stringMatch('abc'));
+  Expect.equals('-', ''.replaceAll(empty, '-'));
+  Expect.equals('-a-b-c-', 'abc'.replaceAll(empty, '-'));
+
+  final star = RegExp(r'x*');
+  Expect.equals('', star.stringMatch('abc'));
+  Expect.equals('xx', star.stringMatch('xxabc'));
+  Expect.equals('--a--b-', 'xxaxb'.replaceAll(star, '-'));
+  Expect.equals('abc', 'abc'.replaceAll(RegExp(r'(?:)'), ''));
+
+  final boundary = RegExp(r'\b');
+  Expect.equals('|ab| |cd|', 'ab cd'.replaceAll(boundary, '|'));
+}
+
+void testUnicode() {
+  const smile = '\u{1F600}';
+  const input = 'a${smile}b';
+
+  // Zero-width matches advance past whole code points in unicode mode, and
+  // by code unit otherwise.
+  Expect.equals(
+      '-a-$smile-b-', input.replaceAll(RegExp(r'', unicode: true), '-'));
+  Expect.equals('-a-\u{D83D}-\u{DE00}-b-', input.replaceAll(RegExp(r''), '-'));
+
+  final dot = RegExp(r'.', unicode: true);
+  Expect.equals(smile, dot.stringMatch(smile));
+  Expect.equals('\u{D83D}', RegExp(r'.').stringMatch(smile));
+  Expect.equals('***', input.replaceAll(dot, '*'));
+  Expect.equals('****', input.replaceAll(RegExp(r'.'), '*'));
+
+  final emoji = RegExp(r'\p{Emoji_Presentation}', unicode: true);
+  Expect.isTrue(emoji.hasMatch(input));
+  Expect.isFalse(emoji.hasMatch('ab'));
+  Expect.equals('a:)b', input.replaceAll(emoji, ':)'));
+
+  // Two-byte subjects with non-unicode patterns.
+  final re = RegExp(r'[à-ÿ]+');
+  Expect.isTrue(re.hasMatch('café 中'));
+  Expect.equals('éè', re.stringMatch('xéè中'));
+  Expect.equals('caf_ 中', 'café 中'.replaceAll(re, '_'));
+}
+
+void testReentrantReplacement() {
+  // Matches found while the match of another regexp is still in use must not
+  // disturb it.
+  final outer = RegExp(r'(\d)(\d)');
+  final inner = RegExp(r'[a-z]+');
+  final result = '12ab34'.replaceAllMapped(outer, (m) {
+    Expect.equals('ab', inner.stringMatch('12ab34'));
+    Expect.isTrue(inner.hasMatch('x'));
+    return '${m[2]}${m[1]}';
+  });
+  Expect.equals('21ab43', result);
+  Expect.equals('<>ab<>', '12ab34'.replaceAll(outer, '<>'));
+}
+
+void main() {
+  // Run often enough for regexps to be tiered up to generated code where
+  // that is enabled.
+  for (int i = 0; i < 5; i++) {
+    testGroups();
+    testSticky();
+    testEmptyMatches();
+    testUnicode();
+    testReentrantReplacement();
+  }
+}
@@ -0,0 +1,68 @@
+// Copyright (c) 2024, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Drives a dynamic call site past --max_polymorphic_checks so that it
+// switches to a megamorphic call, and checks every receiver still reaches its
+// own target afterwards.
+
+import 'package:expect/expect.dart';
+
+class C0 {
+  String foo(int x) => 'C0($x)';
+}
+
+class C1 {
+  String foo(int x) => 'C1($x)';
+}
+
+class C2 {
+  String foo(int x) => 'C2($x)';
+}
+
+class C3 {
+  String foo(int x) => 'C3($x)';
+}
+
+class C4 {
+  String foo(int x) => 'C4($x)';
+}
+
+class C5 {
+  String foo(int x) => 'C5($x)';
+}
+
+class C6 {
+  String foo(int x) => 'C6($x)';
+}
+
+class C7 {
+  String foo(Object? x) => 'C7($x)';
+}
+
+final List<dynamic> receivers = [
+  C0(),
+  C1(),
+  C2(),
+  C3(),
+  C4(),
+  C5(),
+  C6(),
+  C7(),
+];
+
+@pragma('vm:never-inline')
+String callFoo(dynamic receiver, dynamic arg) => receiver.foo(arg);
+
+main() {
+  for (int round = 0; round < 3; round++) {
+    for (int i = 0; i < receivers.length; i++) {
+      Expect.equals('C$i($round)', callFoo(receivers[i], round));
+    }
+  }
+  // The call site is megamorphic now and still performs the dynamic
+  // argument checks of each target.
+  Expect.throwsTypeError(() => callFoo(receivers[0], 'a'));
+  Expect.equals('C7(a)', callFoo(receivers[7], 'a'));
+  Expect.throwsNoSuchMethodError(() => callFoo(Object(), 1));
+}
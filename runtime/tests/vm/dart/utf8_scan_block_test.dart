@@ -0,0 +1,63 @@
+// Copyright (c) 2024, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Decodes UTF-8 input long enough for the optimized scan to check ASCII bytes
+// in 16 byte blocks, with non-ASCII bytes placed at every position of a block
+// and unaligned start offsets.
+//
+// VMOptions=--optimization_counter_threshold=10 --no-background-compilation
+// VMOptions=
+
+import 'dart:convert';
+import 'dart:typed_data';
+
+import 'package:expect/expect.dart';
+
+const String kAscii = 'abcdefghijklmnopqrstuvwxyz0123456789ABCDEFGHIJKLMNOPQR';
+
+void testAscii() {
+  for (int length = 0; length <= kAscii.length; length++) {
+    final string = kAscii.substring(0, length);
+    final bytes = Uint8List.fromList(utf8.encode(string));
+    Expect.equals(string, utf8.decode(bytes));
+    for (int start = 0; start <= length && start < 9; start++) {
+      Expect.equals(string.substring(start),
+          utf8.decoder.convert(bytes, start, bytes.length));
+    }
+  }
+}
+
+void testNonAsciiAtEveryPosition() {
+  for (final special in ['é', '二', '\u{1F600}']) {
+    for (int position = 0; position < 40; position++) {
+      final string = kAscii.substring(0, position) +
+          special +
+          kAscii.substring(position, 40);
+      final bytes = Uint8List.fromList(utf8.encode(string));
+      Expect.equals(string, utf8.decode(bytes));
+      Expect.equals(
+          string.substring(1), utf8.decoder.convert(bytes, 1, bytes.length));
+    }
+  }
+}
+
+void testMalformed() {
+  for (int position = 0; position < 40; position++) {
+    final bytes = Uint8List.fromList(utf8.encode(kAscii.substring(0, 40)));
+    bytes[position] = 0xFF;
+    Expect.throwsFormatException(() => utf8.decode(bytes));
+    final expected = kAscii.substring(0, position) +
+        '�' +
+        kAscii.substring(position + 1, 40);
+    Expect.equals(expected, utf8.decode(bytes, allowMalformed: true));
+  }
+}
+
+main() {
+  for (int i = 0; i < 20; i++) {
+    testAscii();
+    testNonAsciiAtEveryPosition();
+    testMalformed();
+  }
+}
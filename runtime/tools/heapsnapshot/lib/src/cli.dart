@@ -4,6 +4,7 @@
 
 import 'dart:io';
 import 'dart:async';
+import 'dart:typed_data';
 
 import 'package:args/args.dart';
 
@@ -137,7 +138,10 @@ class LoadCommand extends Command {
       return;
     }
     try {
-      final bytes = mmapOrReadFileSync(filename);
+      var bytes = mmapOrReadFileSync(filename);
+      if (filename.endsWith('.gz')) {
+        bytes = Uint8List.fromList(gzip.decode(bytes));
+      }
       state.initialize(
           Analysis(HeapSnapshotGraph.fromChunks([bytes.buffer.asByteData()])));
       state.output.print('Loaded heapsnapshot from "$filename".');
@@ -149,7 +153,10 @@ class LoadCommand extends Command {
 
   String? completeCommand(CliState state, String text) {
     return tryCompleteFileSystemEntity(
-        text, (filename) => filename.endsWith('.heapsnapshot'));
+        text,
+        (filename) =>
+            filename.endsWith('.heapsnapshot') ||
+            filename.endsWith('.heapsnapshot.gz'));
   }
 }
 
@@ -1753,6 +1753,10 @@ class FunctionSerializationCluster : public SerializationCluster {
         NOT_IN_PRECOMPILED(WriteCompressedField(func, unoptimized_code));
         WriteCompressedField(func, code);
         WriteCompressedField(func, ic_data_array);
+        // Keep the training run's usage count so that functions which were
+        // about to be optimized tier up just as early after loading.
+        s->Write<int32_t>(
+            Utils::Maximum<int32_t>(func->untag()->usage_counter_, 0));
       }
 
       if (kind != Snapshot::kFullAOT) {
@@ -1929,10 +1933,12 @@ class FunctionDeserializationCluster : public DeserializationCluster {
       }
 #else
       ASSERT(kind != Snapshot::kFullAOT);
+      int32_t usage_counter = 0;
       if (kind == Snapshot::kFullJIT) {
         func->untag()->unoptimized_code_ = static_cast<CodePtr>(d.ReadRef());
         func->untag()->code_ = static_cast<CodePtr>(d.ReadRef());
         func->untag()->ic_data_array_ = static_cast<ArrayPtr>(d.ReadRef());
+        usage_counter = d.Read<int32_t>();
       }
 #endif
 
@@ -1954,7 +1960,7 @@ class FunctionDeserializationCluster : public DeserializationCluster {
 
       func->untag()->kind_tag_ = d.Read<uint32_t>();
 #if !defined(DART_PRECOMPILED_RUNTIME)
-      func->untag()->usage_counter_ = 0;
+      func->untag()->usage_counter_ = usage_counter;
       func->untag()->optimized_instruction_count_ = 0;
       func->untag()->optimized_call_site_count_ = 0;
       func->untag()->deoptimization_counter_ = 0;
@@ -2739,6 +2745,7 @@ class CodeSerializationCluster : public SerializationCluster {
     CodePtr code;
     intptr_t not_discarded;  // 1 if this code was not discarded and
                              // 0 otherwise.
+    intptr_t rank;           // See ComputeCodeRanks.
     intptr_t instructions_id;
   };
 
@@ -2753,18 +2760,49 @@ class CodeSerializationCluster : public SerializationCluster {
   // there is no way to identify which specific Code object (out of those
   // which point to the specific instructions range) actually corresponds
   // to a particular frame.
+  //
+  // Within each of the two groups, code of functions in the --aot_profile
+  // comes first, hottest first, and code of cold functions comes last, to
+  // improve i-cache and TLB locality.
   static int CompareCodeOrderInfo(CodeOrderInfo const* a,
                                   CodeOrderInfo const* b) {
     if (a->not_discarded < b->not_discarded) return -1;
     if (a->not_discarded > b->not_discarded) return 1;
+    if (a->rank < b->rank) return -1;
+    if (a->rank > b->rank) return 1;
     if (a->instructions_id < b->instructions_id) return -1;
     if (a->instructions_id > b->instructions_id) return 1;
     return 0;
   }
 
+  static constexpr intptr_t kUnrankedCode = kIntptrMax - 1;
+  static constexpr intptr_t kColdCode = kIntptrMax;
+
+  // Maps profiled code to its position in ObjectStore::code_order plus one
+  // and code in ObjectStore::cold_code to kColdCode. Other code is ranked
+  // kUnrankedCode.
+  static void ComputeCodeRanks(Serializer* s, IntMap<intptr_t>* ranks) {
+    auto const object_store = s->isolate_group()->object_store();
+    auto& code = Array::Handle(s->zone(), object_store->code_order());
+    for (intptr_t i = 0; !code.IsNull() && i < code.Length(); i++) {
+      const intptr_t key = static_cast<intptr_t>(code.At(i));
+      if (!ranks->HasKey(key)) {
+        ranks->Insert(key, i + 1);
+      }
+    }
+    code = object_store->cold_code();
+    for (intptr_t i = 0; !code.IsNull() && i < code.Length(); i++) {
+      const intptr_t key = static_cast<intptr_t>(code.At(i));
+      if (!ranks->HasKey(key)) {
+        ranks->Insert(key, kColdCode);
+      }
+    }
+  }
+
   static void Insert(Serializer* s,
                      GrowableArray<CodeOrderInfo>* order_list,
                      IntMap<intptr_t>* order_map,
+                     const IntMap<intptr_t>& ranks,
                      CodePtr code) {
     InstructionsPtr instr = code->untag()->instructions_;
     intptr_t key = static_cast<intptr_t>(instr);
@@ -2783,14 +2821,18 @@ class CodeSerializationCluster : public SerializationCluster {
     info.code = code;
     info.instructions_id = instructions_id;
     info.not_discarded = Code::IsDiscarded(code) ? 0 : 1;
+    const intptr_t rank = ranks.Lookup(static_cast<intptr_t>(code));
+    info.rank = (rank == 0) ? kUnrankedCode : rank;
     order_list->Add(info);
   }
 
   static void Sort(Serializer* s, GrowableArray<CodePtr>* codes) {
     GrowableArray<CodeOrderInfo> order_list;
     IntMap<intptr_t> order_map;
+    IntMap<intptr_t> ranks;
+    ComputeCodeRanks(s, &ranks);
     for (intptr_t i = 0; i < codes->length(); i++) {
-      Insert(s, &order_list, &order_map, (*codes)[i]);
+      Insert(s, &order_list, &order_map, ranks, (*codes)[i]);
     }
     order_list.Sort(CompareCodeOrderInfo);
     ASSERT(order_list.length() == codes->length());
@@ -2802,8 +2844,10 @@ class CodeSerializationCluster : public SerializationCluster {
   static void Sort(Serializer* s, GrowableArray<Code*>* codes) {
     GrowableArray<CodeOrderInfo> order_list;
     IntMap<intptr_t> order_map;
+    IntMap<intptr_t> ranks;
+    ComputeCodeRanks(s, &ranks);
     for (intptr_t i = 0; i < codes->length(); i++) {
-      Insert(s, &order_list, &order_map, (*codes)[i]->ptr());
+      Insert(s, &order_list, &order_map, ranks, (*codes)[i]->ptr());
     }
     order_list.Sort(CompareCodeOrderInfo);
     ASSERT(order_list.length() == codes->length());
@@ -6054,6 +6098,7 @@ class RegExpDeserializationCluster : public DeserializationCluster {
       regexp->untag()->num_one_byte_registers_ = d.Read<int32_t>();
       regexp->untag()->num_two_byte_registers_ = d.Read<int32_t>();
       regexp->untag()->type_flags_ = d.Read<int8_t>();
+      regexp->untag()->interpreted_count_ = 0;
     }
   }
 };
@@ -8047,7 +8092,8 @@ void Serializer::PrepareInstructions(
     //    - a binary search table mapping an Instructions entry point to its
     //      stack maps (by offset from the beginning of the Data object);
     //    - followed by stack maps bytes;
-    //    - followed by canonical stack map entries.
+    //    - followed by canonical stack map entries;
+    //    - followed by the page index into the binary search table.
     //
     struct StackMapInfo : public ZoneAllocated {
       CompressedStackMapsPtr map;
@@ -8162,6 +8208,7 @@ void Serializer::PrepareInstructions(
     // search table.
     pc_mapping.SetPosition(
         sizeof(UntaggedInstructionsTable::Data));  // Skip the header.
+    GrowableArray<uint32_t> pc_offsets(total);
     for (auto& cmd : writer_commands) {
       if (cmd.op == ImageWriterCommand::InsertInstructionOfCode) {
         CompressedStackMapsPtr smap =
@@ -8174,11 +8221,33 @@ void Serializer::PrepareInstructions(
 
         pc_mapping.WriteFixed<UntaggedInstructionsTable::DataEntry>(
             {static_cast<uint32_t>(entry), offset});
+        pc_offsets.Add(static_cast<uint32_t>(entry));
       }
     }
     // Restore position so that Steal does not truncate the buffer.
     pc_mapping.SetPosition(total_bytes);
 
+    // Write the page index: for every page of the instructions the index of
+    // the last entry starting at or before the beginning of the page.
+    {
+      constexpr intptr_t kShift = UntaggedInstructionsTable::kPageIndexShift;
+      const intptr_t page_count = (pc_offsets.Last() >> kShift) + 1;
+      pc_mapping.Align(sizeof(uint32_t));
+      auto header = reinterpret_cast<UntaggedInstructionsTable::Data*>(
+          pc_mapping.buffer());
+      header->page_index_offset = pc_mapping.bytes_written();
+      header->page_index_length = page_count;
+      intptr_t entry_index = 0;
+      for (intptr_t page = 0; page < page_count; page++) {
+        const uint32_t page_start = page << kShift;
+        while ((entry_index + 1 < pc_offsets.length()) &&
+               (pc_offsets[entry_index + 1] <= page_start)) {
+          entry_index++;
+        }
+        pc_mapping.WriteFixed<uint32_t>(entry_index);
+      }
+    }
+
     intptr_t length = 0;
     uint8_t* bytes = pc_mapping.Steal(&length);
 
@@ -9425,6 +9494,11 @@ void Deserializer::Deserialize(DeserializationRoots* roots) {
       TIMELINE_DURATION(thread(), Isolate, "ReadAlloc");
       for (intptr_t i = 0; i < num_clusters_; i++) {
         clusters_[i] = ReadCluster();
+#if defined(SUPPORT_TIMELINE)
+        // Per-cluster events show which clusters dominate startup.
+        TimelineBeginEndScope tbes_cluster(
+            thread(), Timeline::GetIsolateStream(), clusters_[i]->name());
+#endif
         clusters_[i]->ReadAlloc(this);
 #if defined(DEBUG)
         intptr_t serializers_next_ref_index_ = Read<int32_t>();
@@ -9439,6 +9513,10 @@ void Deserializer::Deserialize(DeserializationRoots* roots) {
     {
       TIMELINE_DURATION(thread(), Isolate, "ReadFill");
       for (intptr_t i = 0; i < num_clusters_; i++) {
+#if defined(SUPPORT_TIMELINE)
+        TimelineBeginEndScope tbes_cluster(
+            thread(), Timeline::GetIsolateStream(), clusters_[i]->name());
+#endif
         clusters_[i]->ReadFill(this, primary);
 #if defined(DEBUG)
         int32_t section_marker = Read<int32_t>();
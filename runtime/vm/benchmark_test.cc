@@ -18,8 +18,10 @@
 #include "vm/app_snapshot.h"
 #include "vm/dart_api_impl.h"
 #include "vm/datastream.h"
+#include "vm/heap/weak_table.h"
 #include "vm/message_snapshot.h"
 #include "vm/stack_frame.h"
+#include "vm/symbols.h"
 #include "vm/timer.h"
 
 using dart::bin::File;
@@ -566,6 +568,91 @@ BENCHMARK(LargeMap) {
   benchmark->set_score(elapsed_time);
 }
 
+BENCHMARK(WeakTableLookup) {
+  TransitionNativeToVM transition(thread);
+  StackZone zone(thread);
+  const intptr_t kNumObjects = 100000;
+  const intptr_t kLoopCount = 10;
+  const Array& objects = Array::Handle(Array::New(kNumObjects, Heap::kOld));
+  Object& object = Object::Handle();
+  WeakTable table;
+  for (intptr_t i = 0; i < kNumObjects; i++) {
+    object = Array::New(0, Heap::kOld);
+    objects.SetAt(i, object);
+  }
+  // No allocation from here on, so the keys don't move.
+  for (intptr_t i = 0; i < kNumObjects; i++) {
+    table.SetValueExclusive(objects.At(i), i + 1);
+  }
+  Timer timer;
+  timer.Start();
+  intptr_t found = 0;
+  for (intptr_t j = 0; j < kLoopCount; j++) {
+    for (intptr_t i = 0; i < kNumObjects; i++) {
+      // Alternate between present and absent keys.
+      found += table.GetValue(objects.At(i)) != WeakTable::kNoValue ? 1 : 0;
+      found += table.GetValue(Smi::New(i)) != WeakTable::kNoValue ? 1 : 0;
+    }
+  }
+  timer.Stop();
+  EXPECT_EQ(kNumObjects * kLoopCount, found);
+  int64_t elapsed_time = timer.TotalElapsedTime();
+  benchmark->set_score(elapsed_time);
+}
+
+BENCHMARK(ZoneAllocation) {
+  TransitionNativeToVM transition(thread);
+  const intptr_t kNumAllocations = 10000;
+  const intptr_t kLoopCount = 1000;
+  Timer timer;
+  timer.Start();
+  uword checksum = 0;
+  for (intptr_t j = 0; j < kLoopCount; j++) {
+    StackZone zone(thread);
+    for (intptr_t i = 0; i < kNumAllocations; i++) {
+      // Mix of sizes typical of compiler data structures.
+      const intptr_t size = 16 + (i & 7) * 8;
+      checksum += reinterpret_cast<uword>(zone.GetZone()->Alloc<uint8_t>(size));
+    }
+  }
+  timer.Stop();
+  EXPECT(checksum != 0);
+  int64_t elapsed_time = timer.TotalElapsedTime();
+  benchmark->set_score(elapsed_time);
+}
+
+BENCHMARK(SymbolLookup) {
+  TransitionNativeToVM transition(thread);
+  StackZone zone(thread);
+  const intptr_t kNumSymbols = 10000;
+  const intptr_t kLoopCount = 10;
+  const Array& strings = Array::Handle(Array::New(kNumSymbols, Heap::kOld));
+  String& str = String::Handle();
+  char buffer[32];
+  for (intptr_t i = 0; i < kNumSymbols; i++) {
+    Utils::SNPrint(buffer, sizeof(buffer), "benchmarkSymbol%" Pd, i);
+    str = String::New(buffer, Heap::kOld);
+    strings.SetAt(i, str);
+    Symbols::New(thread, str);
+  }
+  // Every lookup below finds an existing symbol, so only probing is timed.
+  String& symbol = String::Handle();
+  Timer timer;
+  timer.Start();
+  intptr_t found = 0;
+  for (intptr_t j = 0; j < kLoopCount; j++) {
+    for (intptr_t i = 0; i < kNumSymbols; i++) {
+      str ^= strings.At(i);
+      symbol = Symbols::New(thread, str);
+      found += symbol.IsSymbol() ? 1 : 0;
+    }
+  }
+  timer.Stop();
+  EXPECT_EQ(kNumSymbols * kLoopCount, found);
+  int64_t elapsed_time = timer.TotalElapsedTime();
+  benchmark->set_score(elapsed_time);
+}
+
 BENCHMARK_MEMORY(InitialRSS) {
   benchmark->set_score(bin::Process::MaxRSS());
 }
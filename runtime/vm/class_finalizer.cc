@@ -7,6 +7,7 @@
 
 #include "vm/class_finalizer.h"
 
+#include "vm/bit_vector.h"
 #include "vm/canonical_tables.h"
 #include "vm/closure_functions_cache.h"
 #include "vm/compiler/jit/compiler.h"
@@ -937,9 +938,14 @@ void ClassFinalizer::SortClasses() {
   }
 
   intptr_t next_new_cid = kNumPredefinedCids;
+  GrowableArray<intptr_t> roots;
+  GrowableArray<intptr_t> implementor_roots;
   GrowableArray<intptr_t> dfs_stack;
+  BitVector visited(Z, num_cids);
   Class& cls = Class::Handle(Z);
   GrowableObjectArray& subclasses = GrowableObjectArray::Handle(Z);
+  GrowableObjectArray& implementors = GrowableObjectArray::Handle(Z);
+  const ClassPtr object_class = IG->object_store()->object_class();
 
   // Object doesn't use its subclasses list.
   for (intptr_t cid = kNumPredefinedCids; cid < num_cids; cid++) {
@@ -950,13 +956,32 @@ void ClassFinalizer::SortClasses() {
     if (!cls.is_declaration_loaded()) {
       continue;
     }
-    if (cls.SuperClass() == IG->object_store()->object_class()) {
-      dfs_stack.Add(cid);
+    if (cls.SuperClass() == object_class) {
+      roots.Add(cid);
     }
   }
 
-  while (dfs_stack.length() > 0) {
+  // Number the classes in preorder of the class hierarchy, so the subclasses
+  // of a class get a single range of cids. After the tree of a root, number
+  // the trees of the roots that implement one of its classes, so the
+  // implementors of an interface often directly follow its subclasses and
+  // type tests against it need fewer cid ranges.
+  intptr_t next_root = 0;
+  while (true) {
+    if (dfs_stack.is_empty()) {
+      if (!implementor_roots.is_empty()) {
+        dfs_stack.Add(implementor_roots.RemoveLast());
+      } else if (next_root < roots.length()) {
+        dfs_stack.Add(roots[next_root++]);
+      } else {
+        break;
+      }
+    }
     intptr_t cid = dfs_stack.RemoveLast();
+    if (visited.Contains(cid)) {
+      continue;
+    }
+    visited.Add(cid);
     ASSERT(table->HasValidClassAt(cid));
     cls = table->At(cid);
     ASSERT(!cls.IsNull());
@@ -967,7 +992,17 @@ void ClassFinalizer::SortClasses() {
                   cls.ToCString(), cid);
       }
     }
+    implementors = cls.direct_implementors();
     subclasses = cls.direct_subclasses();
+    if (!implementors.IsNull()) {
+      for (intptr_t i = implementors.Length() - 1; i >= 0; i--) {
+        cls ^= implementors.At(i);
+        ASSERT(!cls.IsNull());
+        if (!visited.Contains(cls.id()) && cls.SuperClass() == object_class) {
+          implementor_roots.Add(cls.id());
+        }
+      }
+    }
     if (!subclasses.IsNull()) {
       for (intptr_t i = 0; i < subclasses.Length(); i++) {
         cls ^= subclasses.At(i);
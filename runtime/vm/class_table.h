@@ -398,12 +398,32 @@ class ClassTable : public MallocAllocated {
 #if !defined(PRODUCT)
   bool ShouldTraceAllocationFor(intptr_t cid) {
     return !IsTopLevelCid(cid) &&
-           (classes_.At<kAllocationTracingStateIndex>(cid) != kTracingDisabled);
+           ((classes_.At<kAllocationTracingStateIndex>(cid) &
+             ~kPretenureBit) != kTracingDisabled);
   }
 
   void SetTraceAllocationFor(intptr_t cid, bool trace) {
-    classes_.At<kAllocationTracingStateIndex>(cid) =
-        trace ? kTraceAllocationBit : kTracingDisabled;
+    auto& slot = classes_.At<kAllocationTracingStateIndex>(cid);
+    slot = (slot & kPretenureBit) |
+           (trace ? kTraceAllocationBit : kTracingDisabled);
+  }
+
+  // Pretenured classes fail the inline allocation fast path (which checks
+  // the whole tracing state byte) and are allocated in old space by the
+  // runtime. See Scavenger::UpdatePretenuring.
+  bool ShouldPretenureAllocationFor(intptr_t cid) {
+    return !IsTopLevelCid(cid) &&
+           ((classes_.At<kAllocationTracingStateIndex>(cid) & kPretenureBit) !=
+            0);
+  }
+
+  void SetPretenureAllocationFor(intptr_t cid, bool pretenure) {
+    auto& slot = classes_.At<kAllocationTracingStateIndex>(cid);
+    if (pretenure) {
+      slot |= kPretenureBit;
+    } else {
+      slot &= ~kPretenureBit;
+    }
   }
 
   void SetCollectInstancesFor(intptr_t cid, bool trace) {
@@ -600,6 +620,7 @@ class ClassTable : public MallocAllocated {
       kTracingDisabled = 0,
       kTraceAllocationBit = (1 << 0),
       kCollectInstancesBit = (1 << 1),
+      kPretenureBit = (1 << 2),
   };
 #endif  // !PRODUCT
 
@@ -629,6 +629,57 @@ void CodeSourceMapReader::GetInlinedFunctionsAt(
   }
 }
 
+void CodeSourceMapReader::GetSourcePositionRanges(
+    GrowableArray<SourcePositionRange>* ranges) {
+  GrowableArray<const Function*> function_stack;
+  GrowableArray<TokenPosition> token_positions;
+
+  NoSafepointScope no_safepoint;
+  ReadStream stream(map_.Data(), map_.Length());
+
+  int32_t current_pc_offset = 0;
+  function_stack.Add(&root_);
+  token_positions.Add(InitialPosition());
+
+  while (stream.PendingBytes() > 0) {
+    int32_t arg;
+    const uint8_t opcode = CodeSourceMapOps::Read(&stream, &arg);
+    switch (opcode) {
+      case CodeSourceMapOps::kChangePosition: {
+        const TokenPosition& old_token = token_positions.Last();
+        token_positions.Last() = TokenPosition::Deserialize(
+            Utils::AddWithWrapAround(arg, old_token.Serialize()));
+        break;
+      }
+      case CodeSourceMapOps::kAdvancePC: {
+        ranges->Add({current_pc_offset, current_pc_offset + arg,
+                     function_stack.Last(), token_positions.Last()});
+        current_pc_offset += arg;
+        break;
+      }
+      case CodeSourceMapOps::kPushFunction: {
+        function_stack.Add(
+            &Function::Handle(Function::RawCast(functions_.At(arg))));
+        token_positions.Add(InitialPosition());
+        break;
+      }
+      case CodeSourceMapOps::kPopFunction: {
+        // We never pop the root function.
+        ASSERT(function_stack.length() > 1);
+        ASSERT(token_positions.length() > 1);
+        function_stack.RemoveLast();
+        token_positions.RemoveLast();
+        break;
+      }
+      case CodeSourceMapOps::kNullCheck: {
+        break;
+      }
+      default:
+        UNREACHABLE();
+    }
+  }
+}
+
 #ifndef PRODUCT
 void CodeSourceMapReader::PrintJSONInlineIntervals(JSONObject* jsobj) {
   {
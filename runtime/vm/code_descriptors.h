@@ -339,6 +339,20 @@ class CodeSourceMapReader : public ValueObject {
   void GetInlinedFunctionsAt(int32_t pc_offset,
                              GrowableArray<const Function*>* function_stack,
                              GrowableArray<TokenPosition>* token_positions);
+
+  // A range of PC offsets [start, end) and the innermost, possibly inlined,
+  // function and position it was generated for.
+  struct SourcePositionRange {
+    int32_t start;
+    int32_t end;
+    const Function* function;
+    TokenPosition position;
+  };
+
+  // Adds the source position ranges of the whole map to [ranges], in
+  // increasing PC order.
+  void GetSourcePositionRanges(GrowableArray<SourcePositionRange>* ranges);
+
   NOT_IN_PRODUCT(void PrintJSONInlineIntervals(JSONObject* jsobj));
   void DumpInlineIntervals(uword start);
   void DumpSourcePositions(uword start);
@@ -27,7 +27,7 @@ class ExternalCodeObserverAdapter : public CodeObserver {
                       uword prologue_offset,
                       uword size,
                       bool optimized,
-                      const CodeComments* comments) {
+                      const Code& code) {
     return delegate_.on_new_code(&delegate_, name, base, size);
   }
 
@@ -51,12 +51,12 @@ void CodeObservers::NotifyAll(const char* name,
                               uword prologue_offset,
                               uword size,
                               bool optimized,
-                              const CodeComments* comments) {
+                              const Code& code) {
   ASSERT(!AreActive() || (strlen(name) != 0));
   for (intptr_t i = 0; i < observers_length_; i++) {
     if (observers_[i]->IsActive()) {
       observers_[i]->Notify(name, base, prologue_offset, size, optimized,
-                            comments);
+                            code);
     }
   }
 }
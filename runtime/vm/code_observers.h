@@ -13,7 +13,7 @@
 #if !defined(PRODUCT)
 namespace dart {
 
-class CodeComments;
+class Code;
 
 // Object observing code creation events. Used by external profilers and
 // debuggers to map address ranges to function names.
@@ -28,13 +28,14 @@ class CodeObserver {
   virtual bool IsActive() const = 0;
 
   // Notify code observer about a newly created code object with the
-  // given properties.
+  // given properties. [code] gives access to the comments and the source
+  // map of the code object.
   virtual void Notify(const char* name,
                       uword base,
                       uword prologue_offset,
                       uword size,
                       bool optimized,
-                      const CodeComments* comments) = 0;
+                      const Code& code) = 0;
 
  private:
   DISALLOW_COPY_AND_ASSIGN(CodeObserver);
@@ -56,7 +57,7 @@ class CodeObservers : public AllStatic {
                         uword prologue_offset,
                         uword size,
                         bool optimized,
-                        const CodeComments* comments);
+                        const Code& code);
 
   // Returns true if there is at least one active code observer.
   static bool AreActive();
@@ -0,0 +1,354 @@
+// Copyright (c) 2024, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/aot/aot_profile.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "platform/text_buffer.h"
+#include "vm/compiler/aot/precompiler.h"
+#include "vm/dart.h"
+#include "vm/flags.h"
+#include "vm/object.h"
+#include "vm/os_thread.h"
+#include "vm/program_visitor.h"
+#include "vm/zone_text_buffer.h"
+
+namespace dart {
+
+DEFINE_FLAG(charp,
+            write_aot_profile_to,
+            nullptr,
+            "Write an execution profile for --aot_profile into the given file "
+            "when the VM shuts down.");
+DEFINE_FLAG(charp,
+            aot_profile,
+            nullptr,
+            "Use the execution profile in the given file (see "
+            "--write_aot_profile_to) to guide AOT compilation.");
+DEFINE_FLAG(int,
+            aot_profile_hotness,
+            10,
+            "Functions whose count is at least this percentage of the count "
+            "of the hottest function in the --aot_profile are hot.");
+
+const AotProfile* AotProfile::Current() {
+#if defined(DART_PRECOMPILER)
+  if (Precompiler* precompiler = Precompiler::Instance()) {
+    return precompiler->profile();
+  }
+#endif  // defined(DART_PRECOMPILER)
+  return nullptr;
+}
+
+AotProfile* AotProfile::Load(Zone* zone, const char* path) {
+  if (path == nullptr) return nullptr;
+
+  auto file_open = Dart::file_open_callback();
+  auto file_read = Dart::file_read_callback();
+  auto file_close = Dart::file_close_callback();
+  if ((file_open == nullptr) || (file_read == nullptr) ||
+      (file_close == nullptr)) {
+    OS::PrintErr("warning: Could not access file callbacks.");
+    return nullptr;
+  }
+
+  void* file = file_open(path, /*write=*/false);
+  if (file == nullptr) {
+    OS::PrintErr("warning: Failed to read AOT profile: %s\n", path);
+    return nullptr;
+  }
+  uint8_t* data = nullptr;
+  intptr_t length = -1;
+  file_read(&data, &length, file);
+  file_close(file);
+  if (length < 0) {
+    OS::PrintErr("warning: Failed to read AOT profile: %s\n", path);
+    return nullptr;
+  }
+
+  AotProfile* profile =
+      Parse(zone, reinterpret_cast<const char*>(data), length);
+  free(data);
+  if (profile == nullptr) {
+    OS::PrintErr("warning: Malformed AOT profile: %s\n", path);
+  }
+  return profile;
+}
+
+// Parses a non-negative decimal number at [*pos] followed by [separator].
+static bool ParseCount(const char** pos,
+                       const char* end,
+                       intptr_t* result,
+                       char separator = ' ') {
+  const char* p = *pos;
+  if ((p == end) || (*p < '0') || (*p > '9')) return false;
+  intptr_t value = 0;
+  while ((p != end) && (*p >= '0') && (*p <= '9')) {
+    if (value > (kIntptrMax - 9) / 10) return false;
+    value = value * 10 + (*p - '0');
+    ++p;
+  }
+  if ((p == end) || (*p != separator)) return false;
+  *pos = p + 1;
+  *result = value;
+  return true;
+}
+
+AotProfile* AotProfile::Parse(Zone* zone, const char* text, intptr_t length) {
+  AotProfile* profile = new (zone) AotProfile(zone);
+  const char* const end = text + length;
+  const char* line = text;
+  while (line < end) {
+    const char* line_end = line;
+    while ((line_end != end) && (*line_end != '\n')) {
+      ++line_end;
+    }
+    const char* pos = line;
+    line = (line_end == end) ? end : line_end + 1;
+    if ((pos == line_end) || (*pos == '#')) {
+      continue;
+    }
+
+    Entry entry;
+    if (!ParseCount(&pos, line_end, &entry.count) ||
+        !ParseCount(&pos, line_end, &entry.num_blocks) ||
+        (entry.num_blocks > (line_end - pos) / 4)) {
+      return nullptr;
+    }
+    intptr_t* block_deopt_ids = zone->Alloc<intptr_t>(entry.num_blocks);
+    intptr_t* block_counts = zone->Alloc<intptr_t>(entry.num_blocks);
+    for (intptr_t i = 0; i < entry.num_blocks; ++i) {
+      if (!ParseCount(&pos, line_end, &block_deopt_ids[i], ':') ||
+          !ParseCount(&pos, line_end, &block_counts[i]) ||
+          ((i > 0) && (block_deopt_ids[i] <= block_deopt_ids[i - 1]))) {
+        return nullptr;
+      }
+    }
+    entry.block_deopt_ids = block_deopt_ids;
+    entry.block_counts = block_counts;
+    if (pos == line_end) {
+      return nullptr;
+    }
+    const char* name = zone->MakeCopyOfStringN(pos, line_end - pos);
+    entry.name = name;
+
+    // Closures with the same name in the same function can't be told
+    // apart, keep the hottest one.
+    const intptr_t index = profile->index_.LookupValue(name);
+    if (index == CStringIntMapKeyValueTrait::kNoValue) {
+      profile->index_.Insert({name, profile->entries_.length()});
+      profile->entries_.Add(entry);
+    } else if (profile->entries_[index].count < entry.count) {
+      profile->entries_[index] = entry;
+    }
+    profile->max_count_ = Utils::Maximum(profile->max_count_, entry.count);
+  }
+  return profile;
+}
+
+intptr_t AotProfile::Entry::BlockCount(intptr_t deopt_id) const {
+  intptr_t lo = 0;
+  intptr_t hi = num_blocks - 1;
+  while (lo <= hi) {
+    const intptr_t mid = lo + (hi - lo) / 2;
+    if (block_deopt_ids[mid] == deopt_id) {
+      return block_counts[mid];
+    }
+    if (block_deopt_ids[mid] < deopt_id) {
+      lo = mid + 1;
+    } else {
+      hi = mid - 1;
+    }
+  }
+  return -1;
+}
+
+namespace {
+class ProfilePrinter : public FunctionVisitor {
+ public:
+  ProfilePrinter(Zone* zone, BaseTextBuffer* buffer)
+      : buffer_(buffer),
+        ic_data_array_(Array::Handle(zone)),
+        edge_counters_(Array::Handle(zone)),
+        edge_counter_keys_(Array::Handle(zone)),
+        blocks_(zone, 16) {}
+
+  void VisitFunction(const Function& function) {
+    intptr_t count = function.usage_counter();
+    edge_counters_ = Array::null();
+    edge_counter_keys_ = Array::null();
+    ic_data_array_ = function.ic_data_array();
+    if (!ic_data_array_.IsNull()) {
+      edge_counters_ ^=
+          ic_data_array_.At(Function::ICDataArrayIndices::kEdgeCounters);
+      edge_counter_keys_ ^=
+          ic_data_array_.At(Function::ICDataArrayIndices::kEdgeCounterKeys);
+    }
+    blocks_.Clear();
+    if (!edge_counters_.IsNull()) {
+      for (intptr_t i = 0; i < edge_counters_.Length(); ++i) {
+        count = Utils::Maximum(count, BlockCount(i));
+      }
+    }
+    // Code compiled before the keys were recorded, e.g. code loaded from an
+    // app-jit snapshot, only contributes the function's count.
+    if (!edge_counters_.IsNull() && !edge_counter_keys_.IsNull()) {
+      for (intptr_t i = 0; i < edge_counters_.Length(); ++i) {
+        const intptr_t deopt_id =
+            Smi::Value(Smi::RawCast(edge_counter_keys_.At(i)));
+        if (deopt_id >= 0) {
+          blocks_.Add({deopt_id, BlockCount(i)});
+        }
+      }
+      blocks_.Sort(Block::Compare);
+    }
+    if (count <= 0) {
+      return;
+    }
+    // Blocks sharing a deopt id can't be told apart, drop them.
+    intptr_t num_blocks = 0;
+    for (intptr_t i = 0; i < blocks_.length(); ++i) {
+      if (!IsDuplicate(i)) {
+        ++num_blocks;
+      }
+    }
+    buffer_->Printf("%" Pd " %" Pd " ", count, num_blocks);
+    for (intptr_t i = 0; i < blocks_.length(); ++i) {
+      if (!IsDuplicate(i)) {
+        buffer_->Printf("%" Pd ":%" Pd " ", blocks_[i].deopt_id,
+                        blocks_[i].count);
+      }
+    }
+    buffer_->Printf("%s\n", function.ToFullyQualifiedCString());
+  }
+
+ private:
+  struct Block {
+    intptr_t deopt_id;
+    intptr_t count;
+
+    static int Compare(const Block* a, const Block* b) {
+      if (a->deopt_id == b->deopt_id) return 0;
+      return (a->deopt_id < b->deopt_id) ? -1 : 1;
+    }
+  };
+
+  intptr_t BlockCount(intptr_t i) const {
+    return Utils::Maximum<intptr_t>(
+        0, Smi::Value(Smi::RawCast(edge_counters_.At(i))));
+  }
+
+  bool IsDuplicate(intptr_t i) const {
+    const intptr_t deopt_id = blocks_[i].deopt_id;
+    return ((i > 0) && (blocks_[i - 1].deopt_id == deopt_id)) ||
+           ((i + 1 < blocks_.length()) &&
+            (blocks_[i + 1].deopt_id == deopt_id));
+  }
+
+  BaseTextBuffer* const buffer_;
+  Array& ic_data_array_;
+  Array& edge_counters_;
+  Array& edge_counter_keys_;
+  GrowableArray<Block> blocks_;
+};
+}  // namespace
+
+void AotProfile::Print(Zone* zone,
+                       IsolateGroup* isolate_group,
+                       BaseTextBuffer* buffer) {
+  buffer->AddString(
+      "# <count> <number of blocks> <deopt id>:<block count>... <name>\n");
+  ProfilePrinter printer(zone, buffer);
+  ProgramVisitor::WalkProgram(zone, isolate_group, &printer);
+}
+
+// The profiles of the isolate groups which have shut down, guarded by
+// [collected_mutex].
+static Mutex* collected_mutex = nullptr;
+static char* collected = nullptr;
+static intptr_t collected_length = 0;
+
+void AotProfile::Init() {
+  ASSERT(collected_mutex == nullptr);
+  collected_mutex = new Mutex(NOT_IN_PRODUCT("AotProfile::collected_mutex"));
+}
+
+void AotProfile::Cleanup() {
+  free(collected);
+  collected = nullptr;
+  collected_length = 0;
+  delete collected_mutex;
+  collected_mutex = nullptr;
+}
+
+void AotProfile::CollectIfRequested(Thread* thread) {
+  if (FLAG_write_aot_profile_to == nullptr) {
+    return;
+  }
+  ZoneTextBuffer buffer(thread->zone(), 64 * KB);
+  Print(thread->zone(), thread->isolate_group(), &buffer);
+
+  MutexLocker ml(collected_mutex);
+  collected = reinterpret_cast<char*>(
+      realloc(collected, collected_length + buffer.length()));
+  memmove(collected + collected_length, buffer.buffer(), buffer.length());
+  collected_length += buffer.length();
+}
+
+void AotProfile::WriteIfRequested() {
+  const char* filename = FLAG_write_aot_profile_to;
+  if (filename == nullptr) {
+    return;
+  }
+  auto file_open = Dart::file_open_callback();
+  auto file_write = Dart::file_write_callback();
+  auto file_close = Dart::file_close_callback();
+  if ((file_open == nullptr) || (file_write == nullptr) ||
+      (file_close == nullptr)) {
+    OS::PrintErr("warning: Could not access file callbacks.");
+    return;
+  }
+  void* file = file_open(filename, /*write=*/true);
+  if (file == nullptr) {
+    OS::PrintErr("warning: Failed to write AOT profile: %s\n", filename);
+    return;
+  }
+
+  MutexLocker ml(collected_mutex);
+  if (collected != nullptr) {
+    file_write(collected, collected_length, file);
+  }
+  file_close(file);
+}
+
+void AotProfile::PrintTo(BaseTextBuffer* buffer) const {
+  for (const Entry& entry : entries_) {
+    buffer->Printf("%" Pd " %" Pd " ", entry.count, entry.num_blocks);
+    for (intptr_t i = 0; i < entry.num_blocks; ++i) {
+      buffer->Printf("%" Pd ":%" Pd " ", entry.block_deopt_ids[i],
+                     entry.block_counts[i]);
+    }
+    buffer->Printf("%s\n", entry.name);
+  }
+}
+
+const AotProfile::Entry* AotProfile::Lookup(const Function& function) const {
+  const intptr_t index =
+      index_.LookupValue(function.ToFullyQualifiedCString());
+  if (index == CStringIntMapKeyValueTrait::kNoValue) {
+    return nullptr;
+  }
+  return &entries_[index];
+}
+
+bool AotProfile::IsHot(const Function& function) const {
+  const Entry* entry = Lookup(function);
+  return (entry != nullptr) &&
+         (static_cast<double>(entry->count) * 100 >=
+          static_cast<double>(max_count_) * FLAG_aot_profile_hotness);
+}
+
+}  // namespace dart
@@ -0,0 +1,102 @@
+// Copyright (c) 2024, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_COMPILER_AOT_AOT_PROFILE_H_
+#define RUNTIME_VM_COMPILER_AOT_AOT_PROFILE_H_
+
+#if defined(DART_PRECOMPILED_RUNTIME)
+#error "AOT runtime should not use compiler sources (including header files)"
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+
+#include "vm/allocation.h"
+#include "vm/growable_array.h"
+#include "vm/hash_map.h"
+
+namespace dart {
+
+class BaseTextBuffer;
+class Function;
+class IsolateGroup;
+class Thread;
+
+// An execution profile of a program collected by the JIT
+// (--write_aot_profile_to) and used by the precompiler (--aot_profile) to
+// guide inlining, block layout and the order of code in the snapshot.
+//
+// The profile is a text file with a line for each function which was
+// executed:
+//
+//   <count> <number of blocks> <deopt id>:<block count>... <function name>
+//
+// The count of a function is the count of its hottest block. The block
+// counts are the edge counters of its unoptimized code. Each is keyed by the
+// deopt id of its block, which the flow graph builder assigns the same way
+// for the JIT and the precompiler. Blocks are listed in increasing deopt id
+// order.
+class AotProfile : public ZoneAllocated {
+ public:
+  struct Entry {
+    const char* name;
+    intptr_t count;
+    intptr_t num_blocks;
+    const intptr_t* block_deopt_ids;
+    const intptr_t* block_counts;
+
+    // Returns the count of the block with [deopt_id], or -1 if the profile
+    // has no such block.
+    intptr_t BlockCount(intptr_t deopt_id) const;
+  };
+
+  // Returns the profile used by the current precompilation, if any.
+  static const AotProfile* Current();
+
+  // Reads the profile from [path]. Prints a warning and returns nullptr if
+  // it can't be read.
+  static AotProfile* Load(Zone* zone, const char* path);
+
+  // Parses the profile from [length] characters of [text]. Returns nullptr
+  // if it is malformed.
+  static AotProfile* Parse(Zone* zone, const char* text, intptr_t length);
+
+  // Prints the profile of all functions of [isolate_group] executed so far.
+  static void Print(Zone* zone,
+                    IsolateGroup* isolate_group,
+                    BaseTextBuffer* buffer);
+
+  static void Init();
+  static void Cleanup();
+
+  // Adds the profile of the isolate group of [thread] to the one written by
+  // [WriteIfRequested]. Called when the last isolate of a group shuts down.
+  static void CollectIfRequested(Thread* thread);
+
+  // Writes the profiles of all isolate groups collected so far into the file
+  // given by --write_aot_profile_to. Called once, when the VM shuts down.
+  static void WriteIfRequested();
+
+  // Prints this profile in the format read by [Parse].
+  void PrintTo(BaseTextBuffer* buffer) const;
+
+  const Entry* Lookup(const Function& function) const;
+
+  // Whether [function] is one of the hottest functions of the profile
+  // (see --aot_profile_hotness).
+  bool IsHot(const Function& function) const;
+
+  intptr_t length() const { return entries_.length(); }
+
+ private:
+  explicit AotProfile(Zone* zone) : entries_(zone, 16), index_(zone) {}
+
+  GrowableArray<Entry> entries_;
+  // Maps function names to indices into [entries_].
+  CStringIntMap index_;
+  intptr_t max_count_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(AotProfile);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_COMPILER_AOT_AOT_PROFILE_H_
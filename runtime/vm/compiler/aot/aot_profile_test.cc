@@ -0,0 +1,146 @@
+// Copyright (c) 2024, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/aot/aot_profile.h"
+
+#include "vm/compiler/backend/il_test_helper.h"
+#include "vm/object.h"
+#include "vm/unit_test.h"
+#include "vm/zone_text_buffer.h"
+
+namespace dart {
+
+DECLARE_FLAG(charp, write_aot_profile_to);
+
+static const char* kProfiledScript = R"(
+    int foo(int n) {
+      int sum = 0;
+      for (int i = 0; i < n; i++) {
+        sum += i;
+      }
+      return sum;
+    }
+
+    int bar() => 42;
+
+    main() {
+      int sum = 0;
+      for (int i = 0; i < 10; i++) {
+        sum += foo(100);
+      }
+      return sum;
+    }
+  )";
+
+ISOLATE_UNIT_TEST_CASE(AotProfile_PrintAndParse) {
+  // Makes the JIT record the deopt ids of the blocks.
+  SetFlagScope<const char*> sfs(&FLAG_write_aot_profile_to, "unused");
+
+  const auto& root_library = Library::Handle(LoadTestScript(kProfiledScript));
+  const auto& foo = Function::Handle(GetFunction(root_library, "foo"));
+  const auto& bar = Function::Handle(GetFunction(root_library, "bar"));
+  Invoke(root_library, "main");
+
+  ZoneTextBuffer buffer(thread->zone());
+  AotProfile::Print(thread->zone(), thread->isolate_group(), &buffer);
+  const AotProfile* profile =
+      AotProfile::Parse(thread->zone(), buffer.buffer(), buffer.length());
+  EXPECT(profile != nullptr);
+
+  // The loop body of [foo] was executed 1000 times.
+  const AotProfile::Entry* entry = profile->Lookup(foo);
+  EXPECT(entry != nullptr);
+  EXPECT(entry->count >= 1000);
+  EXPECT(entry->num_blocks > 0);
+  for (intptr_t i = 0; i < entry->num_blocks; ++i) {
+    EXPECT_EQ(entry->block_counts[i],
+              entry->BlockCount(entry->block_deopt_ids[i]));
+  }
+
+  EXPECT(profile->Lookup(bar) == nullptr);
+  EXPECT(!profile->IsHot(bar));
+
+  // The precompiler finds the blocks of its own graph by deopt id.
+  TestPipeline pipeline(foo, CompilerPass::kAOT);
+  FlowGraph* flow_graph = pipeline.RunPasses({CompilerPass::kComputeSSA});
+  BlockEntryInstr* normal_entry = flow_graph->graph_entry()->normal_entry();
+  EXPECT(entry->BlockCount(normal_entry->deopt_id()) > 0);
+}
+
+ISOLATE_UNIT_TEST_CASE(AotProfile_PrintParseRoundTrip) {
+  SetFlagScope<const char*> sfs(&FLAG_write_aot_profile_to, "unused");
+
+  const auto& root_library = Library::Handle(LoadTestScript(kProfiledScript));
+  Invoke(root_library, "main");
+
+  // The profile written by the JIT reads back unchanged.
+  ZoneTextBuffer buffer(thread->zone());
+  AotProfile::Print(thread->zone(), thread->isolate_group(), &buffer);
+  const AotProfile* profile =
+      AotProfile::Parse(thread->zone(), buffer.buffer(), buffer.length());
+  EXPECT(profile != nullptr);
+  EXPECT(profile->length() > 0);
+
+  ZoneTextBuffer printed(thread->zone());
+  profile->PrintTo(&printed);
+  const AotProfile* reparsed =
+      AotProfile::Parse(thread->zone(), printed.buffer(), printed.length());
+  EXPECT(reparsed != nullptr);
+  ZoneTextBuffer reprinted(thread->zone());
+  reparsed->PrintTo(&reprinted);
+  EXPECT_STREQ(printed.buffer(), reprinted.buffer());
+}
+
+ISOLATE_UNIT_TEST_CASE(AotProfile_Parse) {
+  const char* kProfile =
+      "# comment\n"
+      "5 2 1:5 4:0 file:///a.dart_::_foo\n"
+      "3 0 file:///a.dart_A_<anonymous closure>\n";
+  const AotProfile* profile =
+      AotProfile::Parse(thread->zone(), kProfile, strlen(kProfile));
+  EXPECT(profile != nullptr);
+  EXPECT_EQ(2, profile->length());
+
+  const char* kMissingBlockCount = "5 2 1:5 file:///a.dart_::_foo\n";
+  EXPECT(AotProfile::Parse(thread->zone(), kMissingBlockCount,
+                           strlen(kMissingBlockCount)) == nullptr);
+
+  const char* kMissingDeoptId = "5 2 5 4:0 file:///a.dart_::_foo\n";
+  EXPECT(AotProfile::Parse(thread->zone(), kMissingDeoptId,
+                           strlen(kMissingDeoptId)) == nullptr);
+
+  const char* kUnsorted = "5 2 4:0 1:5 file:///a.dart_::_foo\n";
+  EXPECT(AotProfile::Parse(thread->zone(), kUnsorted, strlen(kUnsorted)) ==
+         nullptr);
+
+  const char* kMissingName = "5 0 \n";
+  EXPECT(AotProfile::Parse(thread->zone(), kMissingName,
+                           strlen(kMissingName)) == nullptr);
+}
+
+ISOLATE_UNIT_TEST_CASE(AotProfile_BlockCount) {
+  const char* kProfile =
+      "7 3 1:7 4:0 9:3 file:///a.dart_::_foo\n"
+      "3 0 file:///a.dart_::_bar\n";
+  const AotProfile* profile =
+      AotProfile::Parse(thread->zone(), kProfile, strlen(kProfile));
+  EXPECT(profile != nullptr);
+
+  // Printing a parsed profile gives back its text.
+  ZoneTextBuffer printed(thread->zone());
+  profile->PrintTo(&printed);
+  EXPECT_STREQ(kProfile, printed.buffer());
+
+  const intptr_t deopt_ids[] = {1, 4, 9};
+  const intptr_t counts[] = {7, 0, 3};
+  const AotProfile::Entry entry = {"foo", 7, 3, deopt_ids, counts};
+  EXPECT_EQ(7, entry.BlockCount(1));
+  EXPECT_EQ(0, entry.BlockCount(4));
+  EXPECT_EQ(3, entry.BlockCount(9));
+  EXPECT_EQ(-1, entry.BlockCount(0));
+  EXPECT_EQ(-1, entry.BlockCount(5));
+  EXPECT_EQ(-1, entry.BlockCount(10));
+}
+
+}  // namespace dart
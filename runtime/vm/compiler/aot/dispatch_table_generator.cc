@@ -10,12 +10,19 @@
 
 #include "vm/compiler/frontend/kernel_translation_helper.h"
 #include "vm/dispatch_table.h"
+#include "vm/flags.h"
 #include "vm/stub_code.h"
 #include "vm/thread.h"
 
 #define Z zone_
 
 namespace dart {
+
+DEFINE_FLAG(bool,
+            print_dispatch_table_stats,
+            false,
+            "Print the size and fill ratio of the dispatch table.");
+
 namespace compiler {
 
 class Interval {
@@ -519,32 +526,23 @@ void DispatchTableGenerator::SetupSelectorRows() {
   }
 
   // Find all regions that have [cid] as parent (which should include [cid])!
+  // Visiting concrete classes in cid order and extending the regions of all
+  // their superclasses yields maximal regions in increasing order, and takes
+  // time proportional to the number of classes times the hierarchy depth
+  // rather than quadratic in the number of classes.
   std::unique_ptr<GrowableArray<Interval>[]> cid_subclass_ranges(
       new GrowableArray<Interval>[num_classes_]());
-  for (classid_t cid = kIllegalCid + 1; cid < num_classes_; cid++) {
-    classid_t start = kIllegalCid;
-    for (classid_t sub_cid = kIllegalCid + 1; sub_cid < num_classes_;
-         sub_cid++) {
-      // Is [sub_cid] a subclass of [cid]?
-      classid_t pcid = sub_cid;
-      while (pcid != kIllegalCid && pcid != cid) {
-        pcid = parent_cids[pcid];
-      }
-      const bool is_subclass = cid == pcid;
-      const bool in_range = is_subclass && is_concrete_class[sub_cid];
-
-      if (start == kIllegalCid && in_range) {
-        start = sub_cid;
-      } else if (start != kIllegalCid && !in_range) {
-        Interval range(start, sub_cid);
-        cid_subclass_ranges[cid].Add(range);
-        start = kIllegalCid;
+  for (classid_t sub_cid = kIllegalCid + 1; sub_cid < num_classes_;
+       sub_cid++) {
+    if (!is_concrete_class[sub_cid]) continue;
+    for (classid_t cid = sub_cid; cid != kIllegalCid; cid = parent_cids[cid]) {
+      GrowableArray<Interval>& ranges = cid_subclass_ranges[cid];
+      if (!ranges.is_empty() && ranges.Last().end() == sub_cid) {
+        ranges.Last().set_end(sub_cid + 1);
+      } else {
+        ranges.Add(Interval(sub_cid, sub_cid + 1));
       }
     }
-    if (start != kIllegalCid) {
-      Interval range(start, num_classes_);
-      cid_subclass_ranges[cid].Add(range);
-    }
   }
 
   // Initialize selector rows.
@@ -635,10 +633,15 @@ void DispatchTableGenerator::ComputeSelectorOffsets() {
   }
 
   // Sort the table rows according to popularity / size, descending.
+  // The products are computed in 64 bits, as they overflow 32 bits for
+  // programs with many classes and call sites.
   struct PopularitySizeRatioSorter {
     static int Compare(SelectorRow* const* a, SelectorRow* const* b) {
-      return (*b)->CallCount() * (*a)->total_size() -
-             (*a)->CallCount() * (*b)->total_size();
+      const int64_t lhs = static_cast<int64_t>((*b)->CallCount()) *
+                          static_cast<int64_t>((*a)->total_size());
+      const int64_t rhs = static_cast<int64_t>((*a)->CallCount()) *
+                          static_cast<int64_t>((*b)->total_size());
+      return (lhs > rhs) ? 1 : ((lhs < rhs) ? -1 : 0);
     }
   };
   table_rows_.Sort(PopularitySizeRatioSorter::Compare);
@@ -649,10 +652,15 @@ void DispatchTableGenerator::ComputeSelectorOffsets() {
     fitter.FitAndAllocate(table_rows_[i], 0, max_offset);
   }
 
-  // Sort the table rows according to size, descending.
+  // Sort the table rows according to size, descending (first-fit
+  // decreasing). Among rows of the same size, more popular ones come first
+  // so they are packed at lower offsets.
   struct SizeSorter {
     static int Compare(SelectorRow* const* a, SelectorRow* const* b) {
-      return (*b)->total_size() - (*a)->total_size();
+      if ((*a)->total_size() != (*b)->total_size()) {
+        return (*b)->total_size() - (*a)->total_size();
+      }
+      return (*b)->CallCount() - (*a)->CallCount();
     }
   };
   table_rows_.Sort(SizeSorter::Compare);
@@ -664,6 +672,46 @@ void DispatchTableGenerator::ComputeSelectorOffsets() {
   }
 
   table_size_ = fitter.TableSize();
+
+  if (FLAG_print_dispatch_table_stats) {
+    PrintStatistics();
+  }
+}
+
+void DispatchTableGenerator::PrintStatistics() const {
+  const int32_t optimal_offset = DispatchTable::kOriginElement;
+  const int32_t max_small_offset = DispatchTable::kLargestSmallOffset;
+  intptr_t optimal_rows = 0;
+  intptr_t small_rows = 0;
+  int64_t used_entries = 0;
+  int64_t call_sites = 0;
+  int64_t small_call_sites = 0;
+  for (intptr_t i = 0; i < table_rows_.length(); i++) {
+    const SelectorRow* row = table_rows_[i];
+    const int32_t offset = row->selector()->offset;
+    used_entries += row->total_size();
+    call_sites += row->CallCount();
+    if (offset == optimal_offset) {
+      optimal_rows++;
+    }
+    if (offset <= max_small_offset) {
+      small_rows++;
+      small_call_sites += row->CallCount();
+    }
+  }
+  const double fill_ratio =
+      (table_size_ == 0)
+          ? 0.0
+          : 100.0 * used_entries / static_cast<double>(table_size_);
+  THR_Print("Dispatch table:\n");
+  THR_Print("  classes: %" Pd32 ", selectors: %" Pd ", size: %" Pd32
+            " entries\n",
+            num_classes_, table_rows_.length(), table_size_);
+  THR_Print("  used entries: %" Pd64 " (%.1f%% fill ratio)\n", used_entries,
+            fill_ratio);
+  THR_Print("  selectors at optimal offset: %" Pd ", at small offsets: %" Pd
+            " (%" Pd64 " of %" Pd64 " call sites)\n",
+            optimal_rows, small_rows, small_call_sites, call_sites);
 }
 
 ArrayPtr DispatchTableGenerator::BuildCodeArray() {
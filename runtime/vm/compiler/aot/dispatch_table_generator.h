@@ -104,6 +104,9 @@ class DispatchTableGenerator {
   void NumberSelectors();
   void SetupSelectorRows();
   void ComputeSelectorOffsets();
+  // Prints the size and fill ratio of the table (see
+  // --print_dispatch_table_stats).
+  void PrintStatistics() const;
 
   Zone* const zone_;
   ClassTable* classes_;
@@ -13,9 +13,11 @@
 #include "vm/closure_functions_cache.h"
 #include "vm/code_patcher.h"
 #include "vm/compiler/aot/aot_call_specializer.h"
+#include "vm/compiler/aot/aot_profile.h"
 #include "vm/compiler/aot/precompiler_tracer.h"
 #include "vm/compiler/assembler/assembler.h"
 #include "vm/compiler/assembler/disassembler.h"
+#include "vm/compiler/backend/block_scheduler.h"
 #include "vm/compiler/backend/branch_optimizer.h"
 #include "vm/compiler/backend/constant_propagator.h"
 #include "vm/compiler/backend/flow_graph.h"
@@ -85,7 +87,13 @@ DEFINE_FLAG(charp,
             write_retained_reasons_to,
             nullptr,
             "Print reasons for retaining objects to the given file");
+DEFINE_FLAG(bool,
+            split_cold_code,
+            false,
+            "Place the code of functions which are unlikely to run at the end "
+            "of the instructions section.");
 
+DECLARE_FLAG(charp, aot_profile);
 DECLARE_FLAG(bool, print_flow_graph);
 DECLARE_FLAG(bool, print_flow_graph_optimized);
 DECLARE_FLAG(bool, trace_compiler);
@@ -384,7 +392,7 @@ void Precompiler::ReportStats() {
     return;
   }
 
-  thread()->compiler_timings()->Print();
+  thread()->compiler_timings()->Print("Precompilation");
 }
 
 Precompiler::Precompiler(Thread* thread)
@@ -468,6 +476,8 @@ void Precompiler::DoCompileAll() {
     // to use handles which survive that long, so we use [zone_] here.
     global_object_pool_builder_.InitializeWithZone(zone_);
 
+    profile_ = AotProfile::Load(zone_, FLAG_aot_profile);
+
     {
       HANDLESCOPE(T);
 
@@ -593,6 +603,7 @@ void Precompiler::DoCompileAll() {
         TraceForRetainedFunctions();
       }
 
+      OrderCode();
       FinalizeDispatchTable();
       ReplaceFunctionStaticCallEntries();
 
@@ -660,6 +671,7 @@ void Precompiler::DoCompileAll() {
       retained_reasons_writer_ = nullptr;
     }
 
+    profile_ = nullptr;
     zone_ = nullptr;
   }
 
@@ -2023,6 +2035,76 @@ void Precompiler::TraceForRetainedFunctions() {
 #endif  // DEBUG
 }
 
+// Whether [function], which is not in the --aot_profile, is unlikely to run,
+// or to run more than once.
+bool Precompiler::IsColdFunction(const Function& function) const {
+  // The function was never executed in the JIT.
+  if (profile_ != nullptr) {
+    return true;
+  }
+  if (function.IsFieldInitializer()) {
+    return true;
+  }
+  // Functions which never return are typically the throw helpers of hot
+  // code.
+  return AbstractType::Handle(Z, function.result_type()).IsNeverType();
+}
+
+// Records the code of the functions in the --aot_profile, hottest first, and
+// the code of cold functions (see --split_cold_code), so that the snapshot
+// writer can place them at the start and at the end of the instructions
+// section respectively.
+void Precompiler::OrderCode() {
+  if ((profile_ == nullptr) && !FLAG_split_cold_code) {
+    return;
+  }
+
+  struct ProfiledCode {
+    intptr_t count;
+    intptr_t index;
+    const Code* code;
+
+    static int Compare(const ProfiledCode* a, const ProfiledCode* b) {
+      if (a->count != b->count) return (a->count > b->count) ? -1 : 1;
+      return (a->index < b->index) ? -1 : ((a->index > b->index) ? 1 : 0);
+    }
+  };
+
+  HANDLESCOPE(T);
+  GrowableArray<ProfiledCode> profiled_code;
+  const auto& cold_code =
+      GrowableObjectArray::Handle(Z, GrowableObjectArray::New());
+  FunctionSet::Iterator it(&functions_to_retain_);
+  Function& function = Function::Handle(Z);
+  while (it.MoveNext()) {
+    function ^= functions_to_retain_.GetKey(it.Current());
+    if (!function.HasCode()) continue;
+    const AotProfile::Entry* entry =
+        (profile_ != nullptr) ? profile_->Lookup(function) : nullptr;
+    if (entry != nullptr) {
+      profiled_code.Add({entry->count, profiled_code.length(),
+                         &Code::Handle(Z, function.CurrentCode())});
+    } else if (FLAG_split_cold_code && IsColdFunction(function)) {
+      cold_code.Add(Code::Handle(Z, function.CurrentCode()));
+    }
+  }
+  profiled_code.Sort(ProfiledCode::Compare);
+
+  const auto& code_order =
+      Array::Handle(Z, Array::New(profiled_code.length(), Heap::kOld));
+  for (intptr_t i = 0; i < profiled_code.length(); ++i) {
+    code_order.SetAt(i, *profiled_code[i].code);
+  }
+  IG->object_store()->set_code_order(code_order);
+  IG->object_store()->set_cold_code(
+      Array::Handle(Z, Array::MakeFixedLength(cold_code)));
+
+  if (FLAG_trace_precompiler) {
+    THR_Print("Ordered code of %" Pd " profiled and %" Pd " cold functions\n",
+              profiled_code.length(), cold_code.Length());
+  }
+}
+
 void Precompiler::FinalizeDispatchTable() {
   PRECOMPILER_TIMER_SCOPE(this, FinalizeDispatchTable);
   HANDLESCOPE(T);
@@ -3505,6 +3587,10 @@ bool PrecompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
         flow_graph->PopulateWithICData(function);
       }
 
+      if (flow_graph->should_reorder_blocks()) {
+        BlockScheduler::AssignEdgeWeights(flow_graph);
+      }
+
       const bool print_flow_graph =
           (FLAG_print_flow_graph ||
            (optimized() && FLAG_print_flow_graph_optimized)) &&
@@ -3568,6 +3654,7 @@ bool PrecompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
         // At the moment we are leaking CodeStatistics objects for
         // simplicity because this is just a development mode flag.
         function_stats = new CodeStatistics(&assembler);
+        function_stats->RecordRegisterAllocation(*flow_graph);
       }
 
       FlowGraphCompiler graph_compiler(
@@ -3584,6 +3671,9 @@ bool PrecompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
         FinalizeCompilation(&assembler, &graph_compiler, flow_graph,
                             function_stats);
       }
+      if (optimized()) {
+        SideEffectSummary::Record(flow_graph);
+      }
 
       if (precompiler_->phase() ==
           Precompiler::Phase::kFixpointCodeGeneration) {
@@ -3622,6 +3712,13 @@ bool PrecompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
         done = false;
         continue;
       }
+      if (precompiler_->is_tracing() &&
+          (precompiler_->phase() ==
+           Precompiler::Phase::kFixpointCodeGeneration)) {
+        precompiler_->tracer()->WriteCallSites(
+            flow_graph, pass_state.inline_id_to_function);
+      }
+
       // Exit the loop and the function with the correct result value.
       is_compiled = true;
       done = true;
@@ -21,6 +21,7 @@
 namespace dart {
 
 // Forward declarations.
+class AotProfile;
 class Class;
 class Error;
 class Field;
@@ -276,10 +277,14 @@ class Precompiler : public ValueObject {
   Phase phase() const { return phase_; }
 
   bool is_tracing() const { return is_tracing_; }
+  PrecompilerTracer* tracer() const { return tracer_; }
 
   Thread* thread() const { return thread_; }
   Zone* zone() const { return zone_; }
 
+  // The execution profile given by --aot_profile, if any.
+  const AotProfile* profile() const { return profile_; }
+
  private:
   static Precompiler* singleton_;
 
@@ -339,6 +344,8 @@ class Precompiler : public ValueObject {
   void AttachOptimizedTypeTestingStub();
 
   void TraceForRetainedFunctions();
+  bool IsColdFunction(const Function& function) const;
+  void OrderCode();
   void FinalizeDispatchTable();
   void ReplaceFunctionStaticCallEntries();
   void DropFunctions();
@@ -413,6 +420,7 @@ class Precompiler : public ValueObject {
   Phase phase_ = Phase::kPreparation;
   PrecompilerTracer* tracer_ = nullptr;
   RetainedReasonsWriter* retained_reasons_writer_ = nullptr;
+  const AotProfile* profile_ = nullptr;
   bool is_tracing_ = false;
 };
 
@@ -5,6 +5,8 @@
 #include "vm/compiler/aot/precompiler_tracer.h"
 
 #include "vm/compiler/aot/precompiler.h"
+#include "vm/compiler/backend/flow_graph.h"
+#include "vm/compiler/backend/il.h"
 #include "vm/zone_text_buffer.h"
 
 namespace dart {
@@ -40,6 +42,7 @@ PrecompilerTracer::PrecompilerTracer(Precompiler* precompiler, void* stream)
     : zone_(Thread::Current()->zone()),
       precompiler_(precompiler),
       buffer_(1024),
+      call_sites_(1024),
       stream_(stream),
       strings_(HashTables::New<StringTable>(1024)),
       entities_(HashTables::New<EntityTable>(1024)),
@@ -50,6 +53,8 @@ PrecompilerTracer::PrecompilerTracer(Precompiler* precompiler, void* stream)
 
 void PrecompilerTracer::Finalize() {
   Write("\"E\"],");
+  WriteCallSiteTable();
+  Write(",");
   WriteEntityTable();
   Write(",");
   WriteStringTable();
@@ -65,6 +70,67 @@ void PrecompilerTracer::Finalize() {
   entities_.Release();
 }
 
+void PrecompilerTracer::WriteCallSites(
+    FlowGraph* flow_graph,
+    const GrowableArray<const Function*>& inline_id_to_function) {
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    for (ForwardInstructionIterator it(block_it.Current()); !it.Done();
+         it.Advance()) {
+      Instruction* instr = it.Current();
+      char kind;
+      intptr_t target;
+      Value* receiver = nullptr;
+      if (auto* call = instr->AsStaticCall()) {
+        const Function& function = call->function();
+        if (function.IsDynamicFunction()) {
+          kind = 'D';
+          receiver = call->Receiver();
+        } else {
+          kind = 'S';
+        }
+        target = InternEntity(function);
+      } else if (auto* call = instr->AsPolymorphicInstanceCall()) {
+        kind = 'P';
+        target = InternString(call->function_name());
+        receiver = call->Receiver();
+      } else if (auto* call = instr->AsInstanceCall()) {
+        kind = 'I';
+        target = InternString(call->function_name());
+        receiver = call->Receiver();
+      } else if (auto* call = instr->AsDispatchTableCall()) {
+        kind = 'T';
+        target = InternString(call->selector_name());
+        receiver = call->Receiver();
+      } else if (instr->IsClosureCall()) {
+        kind = 'U';
+        target = -1;
+      } else {
+        continue;
+      }
+
+      // Attribute the call to the function containing it in the source,
+      // which differs from the compiled function for inlined code.
+      const intptr_t inlining_id = instr->inlining_id();
+      const Function& owner = (inlining_id >= 0)
+                                  ? *inline_id_to_function[inlining_id]
+                                  : flow_graph->function();
+      const TokenPosition pos = instr->token_pos();
+      const intptr_t receiver_type =
+          (receiver != nullptr) ? InternString(receiver->Type()->ToCString())
+                                : -1;
+      call_sites_.Printf("%s%" Pd ",%" Pd ",\"%c\",%" Pd ",%" Pd "",
+                         call_sites_.length() > 0 ? "," : "",
+                         InternEntity(owner), pos.IsReal() ? pos.Pos() : -1,
+                         kind, target, receiver_type);
+    }
+  }
+}
+
+void PrecompilerTracer::WriteCallSiteTable() {
+  Write("\"calls\":[%s]", call_sites_.buffer());
+}
+
 void PrecompilerTracer::WriteEntityTable() {
   Write("\"entities\":[");
   const auto& entities_by_id =
@@ -145,6 +211,11 @@ intptr_t PrecompilerTracer::InternString(const String& str) {
   return Smi::Cast(object_).Value();
 }
 
+intptr_t PrecompilerTracer::InternString(const char* str) {
+  const intptr_t length = strlen(str);
+  return InternString(CString{str, length, String::Hash(str, length)});
+}
+
 intptr_t PrecompilerTracer::InternEntity(const Object& obj) {
   ASSERT(obj.IsFunction() || obj.IsClass() || obj.IsField());
   const auto num_occupied = entities_.NumOccupied();
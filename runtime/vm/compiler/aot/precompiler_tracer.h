@@ -16,6 +16,7 @@
 namespace dart {
 
 // Forward declarations.
+class FlowGraph;
 class Precompiler;
 
 #if defined(DART_PRECOMPILER)
@@ -50,6 +51,12 @@ class PrecompilerTracer : public ZoneAllocated {
     WriteEntityRef(function);
   }
 
+  // Records how each call in the final [flow_graph] of a compiled function
+  // is going to be performed.
+  void WriteCallSites(
+      FlowGraph* flow_graph,
+      const GrowableArray<const Function*>& inline_id_to_function);
+
  private:
   struct CString {
     const char* str;
@@ -114,6 +121,7 @@ class PrecompilerTracer : public ZoneAllocated {
 
   intptr_t InternString(const CString& cstr);
   intptr_t InternString(const String& str);
+  intptr_t InternString(const char* str);
   intptr_t InternEntity(const Object& obj);
 
   void Write(const char* format, ...) PRINTF_ATTRIBUTE(2, 3) {
@@ -125,12 +133,14 @@ class PrecompilerTracer : public ZoneAllocated {
 
   CString NameForTrace(const Function& f);
 
+  void WriteCallSiteTable();
   void WriteEntityTable();
   void WriteStringTable();
 
   Zone* zone_;
   Precompiler* precompiler_;
   TextBuffer buffer_;
+  TextBuffer call_sites_;
   void* stream_;
   StringTable strings_;
   EntityTable entities_;
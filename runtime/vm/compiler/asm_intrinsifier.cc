@@ -37,7 +37,7 @@ void AsmIntrinsifier::StringEquality(Assembler* assembler,
                                      Register result,
                                      Label* normal_ir_body,
                                      intptr_t string_cid) {
-  Label is_true, is_false, loop;
+  Label is_true, is_false, compare_contents;
 
   __ CompareRegisters(obj1, obj2);
   __ BranchIf(EQUAL, &is_true, AssemblerBase::kNearJump);
@@ -45,6 +45,18 @@ void AsmIntrinsifier::StringEquality(Assembler* assembler,
   __ CompareClassId(obj2, string_cid, temp1);
   __ BranchIf(NOT_EQUAL, normal_ir_body, AssemblerBase::kNearJump);
 
+  // Strings with different hash codes differ. The hash code is zero (or a
+  // zero Smi) while it has not been computed.
+  __ LoadFromOffset(temp1, FieldAddress(obj1, target::String::hash_offset()),
+                    kUnsignedFourBytes);
+  __ BranchIfZero(temp1, &compare_contents, AssemblerBase::kNearJump);
+  __ LoadFromOffset(temp2, FieldAddress(obj2, target::String::hash_offset()),
+                    kUnsignedFourBytes);
+  __ BranchIfZero(temp2, &compare_contents, AssemblerBase::kNearJump);
+  __ CompareRegisters(temp1, temp2);
+  __ BranchIf(NOT_EQUAL, &is_false, AssemblerBase::kNearJump);
+
+  __ Bind(&compare_contents);
   __ LoadFromOffset(temp1, FieldAddress(obj1, target::String::length_offset()));
   __ CompareWithMemoryValue(
       temp1, FieldAddress(obj2, target::String::length_offset()));
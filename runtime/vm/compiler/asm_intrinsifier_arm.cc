@@ -1737,8 +1737,13 @@ void AsmIntrinsifier::IntrinsifyRegExpExecuteMatch(Assembler* assembler,
   __ LoadClassId(R1, R1);
   __ AddImmediate(R1, -kOneByteStringCid);
   __ add(R1, R2, Operand(R1, LSL, target::kWordSizeLog2));
-  __ ldr(FUNCTION_REG, FieldAddress(R1, target::RegExp::function_offset(
-                                            kOneByteStringCid, sticky)));
+  __ ldr(R2, FieldAddress(R1, target::RegExp::function_offset(
+                                  kOneByteStringCid, sticky)));
+  // Until the regexp is tiered up (see --regexp_tier_up_threshold) the slot
+  // holds bytecode or null and the native interprets the regexp.
+  __ CompareClassId(R2, kFunctionCid, R1);
+  __ b(normal_ir_body, NE);
+  __ mov(FUNCTION_REG, Operand(R2));
 
   // Registers are now set up for the lazy compile stub. It expects the function
   // in R0, the argument descriptor in R4, and IC-Data in R9.
@@ -1974,9 +1974,13 @@ void AsmIntrinsifier::IntrinsifyRegExpExecuteMatch(Assembler* assembler,
 #else
   __ add(R1, R2, Operand(R1, LSL, target::kWordSizeLog2 - 1));
 #endif
-  __ LoadCompressed(FUNCTION_REG,
-                    FieldAddress(R1, target::RegExp::function_offset(
-                                         kOneByteStringCid, sticky)));
+  __ LoadCompressed(R2, FieldAddress(R1, target::RegExp::function_offset(
+                                           kOneByteStringCid, sticky)));
+  // Until the regexp is tiered up (see --regexp_tier_up_threshold) the slot
+  // holds bytecode or null and the native interprets the regexp.
+  __ CompareClassId(R2, kFunctionCid);
+  __ b(normal_ir_body, NE);
+  __ mov(FUNCTION_REG, R2);
 
   // Registers are now set up for the lazy compile stub. It expects the function
   // in R0, the argument descriptor in R4, and IC-Data in R5.
@@ -1774,9 +1774,14 @@ void AsmIntrinsifier::IntrinsifyRegExpExecuteMatch(Assembler* assembler,
   __ movl(EDI, Address(ESP, kStringParamOffset));
   __ LoadClassId(EDI, EDI);
   __ SubImmediate(EDI, Immediate(kOneByteStringCid));
-  __ movl(FUNCTION_REG, FieldAddress(EBX, EDI, TIMES_4,
-                                     target::RegExp::function_offset(
-                                         kOneByteStringCid, sticky)));
+  __ movl(EBX, FieldAddress(EBX, EDI, TIMES_4,
+                            target::RegExp::function_offset(kOneByteStringCid,
+                                                            sticky)));
+  // Until the regexp is tiered up (see --regexp_tier_up_threshold) the slot
+  // holds bytecode or null and the native interprets the regexp.
+  __ CompareClassId(EBX, kFunctionCid, EDI);
+  __ j(NOT_EQUAL, normal_ir_body);
+  __ movl(FUNCTION_REG, EBX);
 
   // Registers are now set up for the lazy compile stub. It expects the function
   // in EAX, the argument descriptor in EDX, and IC-Data in ECX.
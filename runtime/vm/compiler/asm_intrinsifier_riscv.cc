@@ -1993,8 +1993,13 @@ void AsmIntrinsifier::IntrinsifyRegExpExecuteMatch(Assembler* assembler,
   __ AddImmediate(T1, -kOneByteStringCid);
   __ slli(T1, T1, target::kWordSizeLog2);
   __ add(T1, T1, T2);
-  __ lx(FUNCTION_REG, FieldAddress(T1, target::RegExp::function_offset(
-                                           kOneByteStringCid, sticky)));
+  __ lx(T2, FieldAddress(T1, target::RegExp::function_offset(
+                                 kOneByteStringCid, sticky)));
+  // Until the regexp is tiered up (see --regexp_tier_up_threshold) the slot
+  // holds bytecode or null and the native interprets the regexp.
+  __ CompareClassId(T2, kFunctionCid, T1);
+  __ BranchIf(NE, normal_ir_body);
+  __ mv(FUNCTION_REG, T2);
 
   // Registers are now set up for the lazy compile stub. It expects the function
   // in T0, the argument descriptor in S4, and IC-Data in S5.
@@ -1740,22 +1740,44 @@ void AsmIntrinsifier::OneByteString_substringUnchecked(Assembler* assembler,
   __ movq(RCX, Address(RSP, +kEndIndexOffset));
   __ SmiUntag(RCX);
   __ subq(RCX, RBX);
-  __ xorq(RDX, RDX);
-  // RSI: Start address to copy from (untagged).
+  __ leaq(RDI, FieldAddress(RAX, target::OneByteString::data_offset()));
+  // RDI: Start address to copy to (untagged).
   // RCX: Untagged number of bytes to copy.
   // RAX: Tagged result string
-  // RDX: Loop counter.
   // RBX: Scratch register.
-  Label loop, check;
-  __ jmp(&check, Assembler::kNearJump);
-  __ Bind(&loop);
-  __ movzxb(RBX, Address(RSI, RDX, TIMES_1, 0));
-  __ movb(FieldAddress(RAX, RDX, TIMES_1, target::OneByteString::data_offset()),
-          ByteRegisterOf(RBX));
-  __ incq(RDX);
-  __ Bind(&check);
-  __ cmpq(RDX, RCX);
-  __ j(LESS, &loop, Assembler::kNearJump);
+
+  // rep movsb has a startup cost that only pays off for longer copies on
+  // CPUs without fast short rep mov (FSRM), so copy short substrings a word
+  // at a time.
+  const intptr_t kRepMovsbThreshold = 64;
+  Label short_copy, word_loop, byte_check, byte_loop, done;
+  __ cmpq(RCX, Immediate(kRepMovsbThreshold));
+  __ j(LESS, &short_copy, Assembler::kNearJump);
+  __ rep_movsb();
+  __ ret();
+
+  __ Bind(&short_copy);
+  __ cmpq(RCX, Immediate(target::kWordSize));
+  __ j(LESS, &byte_check, Assembler::kNearJump);
+  __ Bind(&word_loop);
+  __ movq(RBX, Address(RSI, 0));
+  __ movq(Address(RDI, 0), RBX);
+  __ addq(RSI, Immediate(target::kWordSize));
+  __ addq(RDI, Immediate(target::kWordSize));
+  __ subq(RCX, Immediate(target::kWordSize));
+  __ cmpq(RCX, Immediate(target::kWordSize));
+  __ j(GREATER_EQUAL, &word_loop, Assembler::kNearJump);
+  __ Bind(&byte_check);
+  __ testq(RCX, RCX);
+  __ j(ZERO, &done, Assembler::kNearJump);
+  __ Bind(&byte_loop);
+  __ movzxb(RBX, Address(RSI, 0));
+  __ movb(Address(RDI, 0), ByteRegisterOf(RBX));
+  __ incq(RSI);
+  __ incq(RDI);
+  __ decq(RCX);
+  __ j(NOT_ZERO, &byte_loop, Assembler::kNearJump);
+  __ Bind(&done);
   __ ret();
   __ Bind(normal_ir_body);
 }
@@ -1865,14 +1887,19 @@ void AsmIntrinsifier::IntrinsifyRegExpExecuteMatch(Assembler* assembler,
   __ LoadClassId(RDI, RDI);
   __ SubImmediate(RDI, Immediate(kOneByteStringCid));
 #if !defined(DART_COMPRESSED_POINTERS)
-  __ movq(FUNCTION_REG, FieldAddress(RBX, RDI, TIMES_8,
-                                     target::RegExp::function_offset(
-                                         kOneByteStringCid, sticky)));
+  __ movq(RBX, FieldAddress(RBX, RDI, TIMES_8,
+                            target::RegExp::function_offset(kOneByteStringCid,
+                                                            sticky)));
 #else
-  __ LoadCompressed(FUNCTION_REG, FieldAddress(RBX, RDI, TIMES_4,
-                                               target::RegExp::function_offset(
-                                                   kOneByteStringCid, sticky)));
+  __ LoadCompressed(RBX, FieldAddress(RBX, RDI, TIMES_4,
+                                      target::RegExp::function_offset(
+                                          kOneByteStringCid, sticky)));
 #endif
+  // Until the regexp is tiered up (see --regexp_tier_up_threshold) the slot
+  // holds bytecode or null and the native interprets the regexp.
+  __ CompareClassId(RBX, kFunctionCid);
+  __ j(NOT_EQUAL, normal_ir_body);
+  __ movq(FUNCTION_REG, RBX);
 
   // Registers are now set up for the lazy compile stub. It expects the function
   // in RAX, the argument descriptor in R10, and IC-Data in RCX.
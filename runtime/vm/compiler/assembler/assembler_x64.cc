@@ -473,6 +473,55 @@ void Assembler::EmitW(Register dst,
   EmitRegisterOperand(dst & 7, src);
 }
 
+void Assembler::EmitVexPrefix(int reg,
+                              uint8_t rm_rex,
+                              VexPrefix pp,
+                              bool is_256) {
+  ASSERT(reg <= XMM15);
+  ASSERT((rm_rex & ~(REX_X | REX_B)) == 0);
+  // The R, X, B and vvvv fields are stored inverted. No instruction emitted
+  // here has a second source operand, so vvvv is always 1111b.
+  const uint8_t vvvv_l_pp = 0x78 | (is_256 ? 0x4 : 0x0) | pp;
+  if (rm_rex == REX_NONE) {
+    EmitUint8(0xC5);
+    EmitUint8((reg > 7 ? 0x00 : 0x80) | vvvv_l_pp);
+  } else {
+    // Only the three byte form can encode the X and B bits. The opcode map is
+    // always 0F.
+    EmitUint8(0xC4);
+    EmitUint8((reg > 7 ? 0x00 : 0x80) | ((rm_rex & REX_X) != 0 ? 0x00 : 0x40) |
+              ((rm_rex & REX_B) != 0 ? 0x00 : 0x20) | 0x01);
+    EmitUint8(vvvv_l_pp);
+  }
+}
+
+void Assembler::vmovdqu(XmmRegister dst, const Address& src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVexPrefix(dst, src.rex(), kVexF3, /*is_256=*/true);
+  EmitUint8(0x6F);
+  EmitOperand(dst & 7, src);
+}
+
+void Assembler::vmovdqu(const Address& dst, XmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVexPrefix(src, dst.rex(), kVexF3, /*is_256=*/true);
+  EmitUint8(0x7F);
+  EmitOperand(src & 7, dst);
+}
+
+void Assembler::vpmovmskb(Register dst, XmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVexPrefix(dst, src > 7 ? REX_B : REX_NONE, kVex66, /*is_256=*/true);
+  EmitUint8(0xD7);
+  EmitRegisterOperand(dst & 7, src);
+}
+
+void Assembler::vzeroupper() {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVexPrefix(0, REX_NONE, kVexNone, /*is_256=*/false);
+  EmitUint8(0x77);
+}
+
 #define UNARY_XMM_WITH_CONSTANT(name, constant, op)                            \
   void Assembler::name(XmmRegister dst, XmmRegister src) {                     \
     movq(TMP, Address(THR, target::Thread::constant##_address_offset()));      \
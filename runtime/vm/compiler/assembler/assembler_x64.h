@@ -536,6 +536,15 @@ class Assembler : public AssemblerBase {
     EmitL(dst, src, 0xD7, 0x0F, 0x66);
   }
 
+  // VEX encoded AVX2 instructions, which operate on the full 256-bit YMM
+  // register aliasing the given XMM register. They may only be used if
+  // TargetCPUFeatures::avx2_supported(), and code using them must execute
+  // vzeroupper before any SSE instruction to avoid state transition stalls.
+  void vmovdqu(XmmRegister dst, const Address& src);
+  void vmovdqu(const Address& dst, XmmRegister src);
+  void vpmovmskb(Register dst, XmmRegister src);
+  void vzeroupper();
+
   void btl(Register dst, Register src) { EmitL(src, dst, 0xA3, 0x0F); }
   void btq(Register dst, Register src) { EmitQ(src, dst, 0xA3, 0x0F); }
 
@@ -1544,6 +1553,15 @@ class Assembler : public AssemblerBase {
              int prefix2 = -1,
              int prefix1 = -1);
   void EmitB(int reg, const Address& address, int opcode);
+
+  // The implied SIMD prefix of a VEX encoded instruction.
+  enum VexPrefix {
+    kVexNone = 0,
+    kVex66 = 1,
+    kVexF3 = 2,
+    kVexF2 = 3,
+  };
+  void EmitVexPrefix(int reg, uint8_t rm_rex, VexPrefix pp, bool is_256);
   void CmpPS(XmmRegister dst, XmmRegister src, int condition);
 
   inline void EmitUint8(uint8_t value);
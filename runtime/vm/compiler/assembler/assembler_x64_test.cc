@@ -709,6 +709,38 @@ ASSEMBLER_TEST_RUN(Popcnt, test) {
       "ret\n");
 }
 
+static const int8_t kAvx2Source[32] = {
+    -1, 1, 2, 3, 4, -5, 6, 7,  8,  9,  10, 11, 12, 13, 14, 15,
+    16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, -31};
+static int8_t avx2_destination[32];
+
+ASSEMBLER_TEST_GENERATE(Avx2MoveMask, assembler) {
+  __ movq(R9, Immediate(reinterpret_cast<uword>(&kAvx2Source[0])));
+  __ movq(RAX, Immediate(reinterpret_cast<uword>(&avx2_destination[0])));
+  __ vmovdqu(XMM1, Address(R9, 0));
+  __ vmovdqu(Address(RAX, 0), XMM1);
+  __ vpmovmskb(R10, XMM1);
+  __ vzeroupper();
+  __ movq(RAX, R10);
+  __ ret();
+}
+
+ASSEMBLER_TEST_RUN(Avx2MoveMask, test) {
+  EXPECT_DISASSEMBLY_ENDS_WITH(
+      "vmovdqu ymm1,[r9]\n"
+      "vmovdqu [rax],ymm1\n"
+      "vpmovmskb r10,ymm1\n"
+      "vzeroupper\n"
+      "movq rax,r10\n"
+      "ret\n");
+  if (!HostCPUFeatures::avx2_supported()) {
+    return;
+  }
+  typedef int64_t (*MoveMaskCode)();
+  EXPECT_EQ(0x80000021, reinterpret_cast<MoveMaskCode>(test->entry())());
+  EXPECT_EQ(0, memcmp(kAvx2Source, avx2_destination, sizeof(kAvx2Source)));
+}
+
 ASSEMBLER_TEST_GENERATE(Lzcnt, assembler) {
   __ movq(RCX, Immediate(0x0f00));
   __ lzcntq(RAX, RCX);
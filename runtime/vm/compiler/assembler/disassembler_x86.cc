@@ -234,6 +234,9 @@ static constexpr int kMaxXmmRegisters = 16;
 static const char* xmm_regs[kMaxXmmRegisters] = {
     "xmm0", "xmm1", "xmm2",  "xmm3",  "xmm4",  "xmm5",  "xmm6",  "xmm7",
     "xmm8", "xmm9", "xmm10", "xmm11", "xmm12", "xmm13", "xmm14", "xmm15"};
+static const char* ymm_regs[kMaxXmmRegisters] = {
+    "ymm0", "ymm1", "ymm2",  "ymm3",  "ymm4",  "ymm5",  "ymm6",  "ymm7",
+    "ymm8", "ymm9", "ymm10", "ymm11", "ymm12", "ymm13", "ymm14", "ymm15"};
 
 class DisassemblerX64 : public ValueObject {
  public:
@@ -325,6 +328,11 @@ class DisassemblerX64 : public ValueObject {
     return xmm_regs[reg];
   }
 
+  const char* NameOfYMMRegister(int reg) const {
+    ASSERT((0 <= reg) && (reg < kMaxXmmRegisters));
+    return ymm_regs[reg];
+  }
+
   void Print(const char* format, ...) PRINTF_ATTRIBUTE(2, 3);
   void PrintJump(uint8_t* pc, int32_t disp);
   void PrintAddress(uint8_t* addr);
@@ -347,6 +355,9 @@ class DisassemblerX64 : public ValueObject {
   const char* TwoByteMnemonic(uint8_t opcode);
   int TwoByteOpcodeInstruction(uint8_t* data);
   int Print660F38Instruction(uint8_t* data);
+#if defined(TARGET_ARCH_X64)
+  int VexInstruction(uint8_t* data);
+#endif
 
   int F6F7Instruction(uint8_t* data);
   int ShiftInstruction(uint8_t* data);
@@ -1270,6 +1281,61 @@ int DisassemblerX64::Print660F38Instruction(uint8_t* current) {
 // Handle all two-byte opcodes, which start with 0x0F.
 // These instructions may be affected by an 0x66, 0xF2, or 0xF3 prefix.
 // We do not use any three-byte opcodes, which start with 0x0F38 or 0x0F3A.
+#if defined(TARGET_ARCH_X64)
+// Handles the VEX encoded instructions emitted by the assembler.
+// Returns number of bytes used, including *data.
+int DisassemblerX64::VexInstruction(uint8_t* data) {
+  uint8_t* current = data;
+  // Translate the inverted R, X and B bits into a REX prefix, so the ModRM
+  // operand can be decoded as usual.
+  uint8_t rex = 0x40;
+  intptr_t map = 1;
+  uint8_t w_vvvv_l_pp;
+  if (*current == 0xC5) {
+    w_vvvv_l_pp = current[1] & 0x7F;
+    if ((current[1] & 0x80) == 0) rex |= 0x04;
+    current += 2;
+  } else {
+    ASSERT(*current == 0xC4);
+    const uint8_t rxb_map = current[1];
+    if ((rxb_map & 0x80) == 0) rex |= 0x04;
+    if ((rxb_map & 0x40) == 0) rex |= 0x02;
+    if ((rxb_map & 0x20) == 0) rex |= 0x01;
+    map = rxb_map & 0x1F;
+    w_vvvv_l_pp = current[2];
+    if ((w_vvvv_l_pp & 0x80) != 0) rex |= 0x08;
+    current += 3;
+  }
+  setRex(rex);
+  const bool is_256 = (w_vvvv_l_pp & 0x04) != 0;
+  const intptr_t pp = w_vvvv_l_pp & 0x03;
+  const RegisterNameMapping vector_register_name =
+      is_256 ? &DisassemblerX64::NameOfYMMRegister
+             : &DisassemblerX64::NameOfXMMRegister;
+  const uint8_t opcode = *current++;
+  int mod, regop, rm;
+  if (map == 1 && pp == 0 && opcode == 0x77) {
+    Print(is_256 ? "vzeroall" : "vzeroupper");
+  } else if (map == 1 && pp == 2 && opcode == 0x6F) {
+    get_modrm(*current, &mod, &regop, &rm);
+    Print("vmovdqu %s,", (this->*vector_register_name)(regop));
+    current += PrintRightOperandHelper(current, vector_register_name);
+  } else if (map == 1 && pp == 2 && opcode == 0x7F) {
+    get_modrm(*current, &mod, &regop, &rm);
+    Print("vmovdqu ");
+    current += PrintRightOperandHelper(current, vector_register_name);
+    Print(",%s", (this->*vector_register_name)(regop));
+  } else if (map == 1 && pp == 1 && opcode == 0xD7) {
+    get_modrm(*current, &mod, &regop, &rm);
+    Print("vpmovmskb %s,", NameOfCPURegister(regop));
+    current += PrintRightOperandHelper(current, vector_register_name);
+  } else {
+    UnimplementedInstruction(opcode);
+  }
+  return current - data;
+}
+#endif  // defined(TARGET_ARCH_X64)
+
 int DisassemblerX64::TwoByteOpcodeInstruction(uint8_t* data) {
   uint8_t opcode = *(data + 1);
   uint8_t* current = data + 2;
@@ -1692,6 +1758,14 @@ int DisassemblerX64::InstructionDecode(uword pc) {
         data += TwoByteOpcodeInstruction(data);
         break;
 
+#if defined(TARGET_ARCH_X64)
+      case 0xC4:
+        FALL_THROUGH;
+      case 0xC5:
+        data += VexInstruction(data);
+        break;
+#endif
+
       case 0x8F: {
         data++;
         int mod, regop, rm;
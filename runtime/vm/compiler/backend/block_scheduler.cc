@@ -6,6 +6,7 @@
 
 #include "vm/allocation.h"
 #include "vm/code_patcher.h"
+#include "vm/compiler/aot/aot_profile.h"
 #include "vm/compiler/backend/flow_graph.h"
 #include "vm/compiler/jit/compiler.h"
 
@@ -46,11 +47,62 @@ static void SetEdgeWeight(BlockEntryInstr* block,
   }
 }
 
+// Under AOT the block counts come from the --aot_profile, which has them for
+// the unoptimized flow graph of the function in the JIT. Blocks are matched
+// by deopt id, so this is called on the graph as the builder produced it.
+// Blocks the profile doesn't know, e.g. because the builder added them only
+// for AOT, keep the default weight.
+//
+// The entry count of the graph is not set, as AOT has no call counts to
+// scale the weights of inlined callees with.
+static void AssignEdgeWeightsFromProfile(FlowGraph* flow_graph) {
+  const AotProfile* profile = AotProfile::Current();
+  if (profile == nullptr) {
+    return;
+  }
+  const AotProfile::Entry* entry = profile->Lookup(flow_graph->function());
+  if (entry == nullptr) {
+    return;
+  }
+  BlockEntryInstr* normal_entry = flow_graph->graph_entry()->normal_entry();
+  if (normal_entry == nullptr) {
+    return;
+  }
+  const intptr_t entry_count = entry->BlockCount(normal_entry->deopt_id());
+  if (entry_count <= 0) {
+    return;
+  }
+
+  auto set_weight = [&](BlockEntryInstr* block, auto set_edge_weight) {
+    const intptr_t count = entry->BlockCount(block->deopt_id());
+    if (count == 0) {
+      set_edge_weight(BlockScheduler::kNeverExecutedWeight);
+    } else if (count > 0) {
+      set_edge_weight(static_cast<double>(count) /
+                      static_cast<double>(entry_count));
+    }
+  };
+  for (BlockIterator it = flow_graph->reverse_postorder_iterator(); !it.Done();
+       it.Advance()) {
+    BlockEntryInstr* block = it.Current();
+    Instruction* last = block->last_instruction();
+    for (intptr_t i = 0; i < last->SuccessorCount(); ++i) {
+      BlockEntryInstr* succ = last->SuccessorAt(i);
+      if (auto target = succ->AsTargetEntry()) {
+        set_weight(target, [&](double w) { target->set_edge_weight(w); });
+      } else if (auto jump = last->AsGoto()) {
+        set_weight(block, [&](double w) { jump->set_edge_weight(w); });
+      }
+    }
+  }
+}
+
 void BlockScheduler::AssignEdgeWeights(FlowGraph* flow_graph) {
   if (!FLAG_reorder_basic_blocks) {
     return;
   }
   if (CompilerState::Current().is_aot()) {
+    AssignEdgeWeightsFromProfile(flow_graph);
     return;
   }
 
@@ -93,6 +145,25 @@ void BlockScheduler::AssignEdgeWeights(FlowGraph* flow_graph) {
   }
 }
 
+bool BlockScheduler::IsNeverExecuted(BlockEntryInstr* block) {
+  if (auto target = block->AsTargetEntry()) {
+    return target->edge_weight() == kNeverExecutedWeight;
+  }
+  if (auto join = block->AsJoinEntry()) {
+    if (join->PredecessorCount() == 0) {
+      return false;
+    }
+    for (intptr_t i = 0; i < join->PredecessorCount(); ++i) {
+      auto jump = join->PredecessorAt(i)->last_instruction()->AsGoto();
+      if ((jump == nullptr) || (jump->edge_weight() != kNeverExecutedWeight)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  return false;
+}
+
 // A weighted control-flow graph edge.
 struct Edge {
   Edge(BlockEntryInstr* source, BlockEntryInstr* target, double weight)
@@ -240,13 +311,16 @@ void BlockScheduler::ReorderBlocksJIT(FlowGraph* flow_graph) {
   }
 }
 
-// AOT block order is based on reverse post order but with two changes:
+// AOT block order is based on reverse post order but with a few changes:
 //
 // - Blocks which always throw and their direct predecessors are considered
 // *cold* and moved to the end of the order.
 // - Blocks which belong to the same loop are kept together (where possible)
 // and not interspersed with other blocks.
 //
+// With an --aot_profile, blocks which were never executed are cold as well
+// and the more frequent successor of a branch follows it.
+//
 namespace {
 class AOTBlockScheduler {
  public:
@@ -286,6 +360,10 @@ class AOTBlockScheduler {
       if ((marks & kVisitedMark) == 0) {
         marks |= kVisitedMark;
 
+        if (BlockScheduler::IsNeverExecuted(block)) {
+          marks |= kColdMark;
+        }
+
         if (last->IsThrow() || last->IsReThrow()) {
           marks |= kColdMark;
         } else {
@@ -307,6 +385,12 @@ class AOTBlockScheduler {
               PushBlock(succ0);
               PushBlock(succ1);
             }
+          } else if (successor_count == 2 &&
+                     EdgeWeight(last->SuccessorAt(1)) >
+                         EdgeWeight(last->SuccessorAt(0))) {
+            // Successors pushed first are emitted first.
+            PushBlock(last->SuccessorAt(1));
+            PushBlock(last->SuccessorAt(0));
           } else {
             for (intptr_t i = 0; i < successor_count; i++) {
               PushBlock(last->SuccessorAt(i));
@@ -355,6 +439,11 @@ class AOTBlockScheduler {
   // The block should not move to cold section.
   static constexpr uint8_t kPinnedMark = 1 << 3;
 
+  static double EdgeWeight(BlockEntryInstr* block) {
+    auto target = block->AsTargetEntry();
+    return (target != nullptr) ? target->edge_weight() : 0.0;
+  }
+
   uint8_t& MarksOf(BlockEntryInstr* block) {
     return marks_[block->preorder_number()];
   }
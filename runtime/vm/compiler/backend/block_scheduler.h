@@ -13,13 +13,22 @@
 
 namespace dart {
 
+class BlockEntryInstr;
 class FlowGraph;
 
 class BlockScheduler : public AllStatic {
  public:
+  // Under AOT, the weight of edges which the --aot_profile shows were never
+  // taken. Edges without a weight, e.g. ones created by optimization passes,
+  // have weight 0.
+  static constexpr double kNeverExecutedWeight = -1.0;
+
   static void AssignEdgeWeights(FlowGraph* flow_graph);
   static void ReorderBlocks(FlowGraph* flow_graph);
 
+  // Whether all edges into [block] have kNeverExecutedWeight.
+  static bool IsNeverExecuted(BlockEntryInstr* block);
+
  private:
   static void ReorderBlocksAOT(FlowGraph* flow_graph);
   static void ReorderBlocksJIT(FlowGraph* flow_graph);
@@ -4,6 +4,7 @@
 
 #include "vm/compiler/backend/branch_optimizer.h"
 
+#include "vm/bit_vector.h"
 #include "vm/compiler/backend/flow_graph.h"
 #include "vm/compiler/backend/il.h"
 
@@ -348,4 +349,257 @@ void IfConverter::Simplify(FlowGraph* flow_graph) {
   }
 }
 
+namespace {
+
+// A case of a chain of class id tests: control continues at [target] if the
+// class id is in [lower, upper].
+struct CidCase {
+  uword lower;
+  uword upper;
+  TargetEntryInstr* target;
+};
+
+// Builds the binary search over the class ids of a chain of cases.
+class CidSearchBuilder : public ValueObject {
+ public:
+  CidSearchBuilder(FlowGraph* flow_graph,
+                   LoadClassIdInstr* cid,
+                   const InstructionSource& source,
+                   intptr_t try_index,
+                   const GrowableArray<CidCase>& cases,
+                   JoinEntryInstr* no_match)
+      : flow_graph_(flow_graph),
+        cid_(cid),
+        source_(source),
+        try_index_(try_index),
+        cases_(cases),
+        no_match_(no_match) {}
+
+  // Returns a branch to the target of the case among [first, last] matching
+  // the class id, or to [no_match_] if there is none.
+  BranchInstr* Build(intptr_t first, intptr_t last) {
+    if (first == last) {
+      const CidCase& c = cases_[first];
+      BranchInstr* branch = NewBranch(c.lower, c.upper);
+      *branch->true_successor_address() = c.target;
+      *branch->false_successor_address() =
+          NewTarget(new (zone()) GotoInstr(no_match_, DeoptId::kNone));
+      return branch;
+    }
+    // Cases are sorted and disjoint, and the lower bound of the middle case is
+    // above the lower bound of the first one, so at least 1.
+    const intptr_t middle = (first + last + 1) / 2;
+    BranchInstr* branch = NewBranch(0, cases_[middle].lower - 1);
+    *branch->true_successor_address() = NewTarget(Build(first, middle - 1));
+    *branch->false_successor_address() = NewTarget(Build(middle, last));
+    return branch;
+  }
+
+ private:
+  Zone* zone() const { return flow_graph_->zone(); }
+
+  // Returns a branch taken if the class id is in [lower, upper].
+  BranchInstr* NewBranch(uword lower, uword upper) {
+    ComparisonInstr* comparison;
+    if (lower == upper) {
+      ConstantInstr* constant = flow_graph_->GetConstant(
+          Smi::Handle(zone(), Smi::New(lower)), kUnboxedUword);
+      comparison = new (zone()) EqualityCompareInstr(
+          source_, Token::kEQ, new (zone()) Value(cid_),
+          new (zone()) Value(constant), kIntegerCid, DeoptId::kNone,
+          /*null_aware=*/false, Instruction::kNotSpeculative);
+    } else {
+      comparison = new (zone()) TestRangeInstr(
+          source_, new (zone()) Value(cid_), lower, upper, kUnboxedUword);
+    }
+    return new (zone()) BranchInstr(comparison, DeoptId::kNone);
+  }
+
+  TargetEntryInstr* NewTarget(Instruction* last) {
+    TargetEntryInstr* target = new (zone()) TargetEntryInstr(
+        flow_graph_->allocate_block_id(), try_index_, DeoptId::kNone);
+    target->LinkTo(last);
+    target->set_last_instruction(last);
+    return target;
+  }
+
+  FlowGraph* const flow_graph_;
+  LoadClassIdInstr* const cid_;
+  const InstructionSource source_;
+  const intptr_t try_index_;
+  const GrowableArray<CidCase>& cases_;
+  JoinEntryInstr* const no_match_;
+};
+
+}  // namespace
+
+static bool HasPhis(BlockEntryInstr* block) {
+  JoinEntryInstr* join = block->AsJoinEntry();
+  return (join != nullptr) && (join->phis() != nullptr) &&
+         !join->phis()->is_empty();
+}
+
+// Matches a branch which tests whether a class id is in a range. On success
+// returns the class id in [cid], the range and the target taken for class ids
+// in the range in [match], and the other target in [no_match].
+static bool MatchCidTest(BranchInstr* branch,
+                         LoadClassIdInstr** cid,
+                         CidCase* match,
+                         TargetEntryInstr** no_match) {
+  ComparisonInstr* comparison = branch->comparison();
+  if (comparison->CanDeoptimize()) {
+    return false;
+  }
+  Definition* value = nullptr;
+  bool taken_in_range = false;
+  if (auto* test = comparison->AsTestRange()) {
+    value = test->value()->definition();
+    match->lower = test->lower();
+    match->upper = test->upper();
+    taken_in_range = (test->kind() == Token::kIS);
+  } else if (auto* compare = comparison->AsEqualityCompare()) {
+    if (!compare->right()->BindsToSmiConstant()) {
+      return false;
+    }
+    const intptr_t constant =
+        Smi::Cast(compare->right()->BoundConstant()).Value();
+    if (constant < 0) {
+      return false;
+    }
+    value = compare->left()->definition();
+    match->lower = match->upper = constant;
+    taken_in_range = (compare->kind() == Token::kEQ);
+  } else {
+    return false;
+  }
+  // Comparisons of class ids can be done on their widened representation.
+  if (auto* converter = value->AsIntConverter()) {
+    value = converter->value()->definition();
+  }
+  *cid = value->AsLoadClassId();
+  if ((*cid == nullptr) || ((*cid)->representation() != kUnboxedUword)) {
+    return false;
+  }
+  match->target =
+      taken_in_range ? branch->true_successor() : branch->false_successor();
+  *no_match =
+      taken_in_range ? branch->false_successor() : branch->true_successor();
+  return true;
+}
+
+// Skips blocks which only jump to a block with no other predecessors.
+static BlockEntryInstr* SkipEmptyBlocks(BlockEntryInstr* block) {
+  while (block->next() == block->last_instruction()) {
+    GotoInstr* jump = block->last_instruction()->AsGoto();
+    if (jump == nullptr) break;
+    JoinEntryInstr* successor = jump->successor();
+    if ((successor->PredecessorCount() != 1) || HasPhis(successor)) break;
+    block = successor;
+  }
+  return block;
+}
+
+void CidSwitchOptimizer::Optimize(FlowGraph* flow_graph) {
+  // Shorter chains are not slower than a binary search.
+  const intptr_t kMinCases = 4;
+
+  Zone* zone = flow_graph->zone();
+  bool changed = false;
+
+  // Blocks which are part of a chain starting in an earlier block, or which
+  // were replaced while rewriting a chain.
+  BitVector* processed =
+      new (zone) BitVector(zone, flow_graph->preorder().length());
+  GrowableArray<CidCase> cases;
+  GrowableArray<BranchInstr*> branches;
+
+  // The reverse postorder visits the head of a chain before its other
+  // blocks.
+  for (BlockIterator it = flow_graph->reverse_postorder_iterator(); !it.Done();
+       it.Advance()) {
+    BlockEntryInstr* head = it.Current();
+    if (processed->Contains(head->preorder_number())) continue;
+    BranchInstr* branch = head->last_instruction()->AsBranch();
+    if (branch == nullptr) continue;
+
+    // Find the chain:
+    //
+    // B_head:
+    //   ...
+    //   Branch if TestRange(v0, lower0, upper0) goto (B_case0, B1)
+    // B1:
+    //   Branch if EqualityCompare(v0 == cid1) goto (B_case1, B2)
+    // ...
+    // Bn:
+    //   Branch if TestRange(v0, lowerN, upperN) goto (B_caseN, B_no_match)
+    //
+    // B1...Bn can also be reached through blocks which only jump to them.
+    LoadClassIdInstr* cid = nullptr;
+    CidCase match;
+    TargetEntryInstr* no_match = nullptr;
+    if (!MatchCidTest(branch, &cid, &match, &no_match)) continue;
+    cases.Clear();
+    branches.Clear();
+    cases.Add(match);
+    branches.Add(branch);
+    while (true) {
+      BlockEntryInstr* next = SkipEmptyBlocks(no_match);
+      BranchInstr* next_branch = next->last_instruction()->AsBranch();
+      LoadClassIdInstr* next_cid = nullptr;
+      TargetEntryInstr* next_no_match = nullptr;
+      if ((next_branch == nullptr) || (next->next() != next_branch) ||
+          (next->PredecessorCount() != 1) || HasPhis(next) ||
+          (next->try_index() != head->try_index()) ||
+          !MatchCidTest(next_branch, &next_cid, &match, &next_no_match) ||
+          (next_cid != cid)) {
+        break;
+      }
+      processed->Add(next->preorder_number());
+      cases.Add(match);
+      branches.Add(next_branch);
+      no_match = next_no_match;
+    }
+    if (cases.length() < kMinCases) continue;
+
+    // The order of the tests doesn't matter if the ranges are disjoint.
+    cases.Sort([](const CidCase* a, const CidCase* b) {
+      return (a->lower < b->lower) ? -1 : ((a->lower > b->lower) ? 1 : 0);
+    });
+    bool disjoint = true;
+    for (intptr_t i = 1; i < cases.length(); ++i) {
+      if (cases[i - 1].upper >= cases[i].lower) {
+        disjoint = false;
+        break;
+      }
+    }
+    if (!disjoint) continue;
+
+    if (FLAG_trace_optimization && flow_graph->should_print()) {
+      THR_Print("Binary search over %" Pd " class id tests in B%" Pd "\n",
+                cases.length(), head->block_id());
+    }
+
+    // The block taken if no case matches is reached from several leaves of
+    // the search.
+    processed->Add(no_match->preorder_number());
+    JoinEntryInstr* join = BranchSimplifier::ToJoinEntry(zone, no_match);
+    CidSearchBuilder builder(flow_graph, cid, branch->source(),
+                             head->try_index(), cases, join);
+    BranchInstr* search = builder.Build(0, cases.length() - 1);
+    branch->previous()->LinkTo(search);
+    head->set_last_instruction(search);
+    for (BranchInstr* old_branch : branches) {
+      old_branch->UnuseAllInputs();
+    }
+    changed = true;
+  }
+
+  if (changed) {
+    // We changed the block order and the dominator tree.
+    flow_graph->DiscoverBlocks();
+    GrowableArray<BitVector*> dominance_frontier;
+    flow_graph->ComputeDominators(&dominance_frontier);
+  }
+}
+
 }  // namespace dart
@@ -60,6 +60,15 @@ class IfConverter : public AllStatic {
   static void Simplify(FlowGraph* flow_graph);
 };
 
+// Rewrite chains of branches which test the class id of the same value
+// against disjoint class ids or class id ranges into a binary search over the
+// class id. Such chains are e.g. the result of switching over the subclasses
+// of a sealed class.
+class CidSwitchOptimizer : public AllStatic {
+ public:
+  static void Optimize(FlowGraph* flow_graph);
+};
+
 }  // namespace dart
 
 #endif  // RUNTIME_VM_COMPILER_BACKEND_BRANCH_OPTIMIZER_H_
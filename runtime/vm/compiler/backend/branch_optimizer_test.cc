@@ -0,0 +1,119 @@
+// Copyright (c) 2024, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/backend/branch_optimizer.h"
+
+#include "vm/compiler/backend/block_builder.h"
+#include "vm/compiler/backend/il.h"
+#include "vm/compiler/backend/il_test_helper.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+// Follows the branches of [flow_graph] for a receiver with the class id [cid]
+// and returns the constant returned. Sets [tests] to the number of branches
+// taken.
+static intptr_t EvaluateCidTests(FlowGraph* flow_graph,
+                                 uword cid,
+                                 intptr_t* tests) {
+  BlockEntryInstr* block = flow_graph->graph_entry()->normal_entry();
+  *tests = 0;
+  while (true) {
+    Instruction* last = block->last_instruction();
+    if (auto* ret = last->AsReturn()) {
+      return Smi::Cast(ret->value()->BoundConstant()).Value();
+    }
+    if (auto* jump = last->AsGoto()) {
+      block = jump->successor();
+      continue;
+    }
+    BranchInstr* branch = last->AsBranch();
+    EXPECT(branch != nullptr);
+    bool result;
+    if (auto* test = branch->comparison()->AsTestRange()) {
+      result = (test->lower() <= cid) && (cid <= test->upper());
+      if (test->kind() == Token::kISNOT) result = !result;
+    } else {
+      auto* compare = branch->comparison()->AsEqualityCompare();
+      EXPECT(compare != nullptr);
+      result = static_cast<uword>(
+                   Smi::Cast(compare->right()->BoundConstant()).Value()) ==
+               cid;
+      if (compare->kind() == Token::kNE) result = !result;
+    }
+    ++(*tests);
+    block = result ? branch->true_successor() : branch->false_successor();
+  }
+}
+
+ISOLATE_UNIT_TEST_CASE(CidSwitchOptimizer_BinarySearch) {
+  using compiler::BlockBuilder;
+
+  CompilerState S(thread, /*is_aot=*/true, /*is_optimizing=*/true);
+
+  FlowGraphBuilderHelper H(/*num_parameters=*/1);
+  H.AddVariable("v0", AbstractType::ZoneHandle(Type::DynamicType()));
+
+  // Class id ranges tested in order, [lower, upper].
+  const uword kRanges[][2] = {{100, 103}, {110, 110}, {90, 95}, {120, 120}};
+  const intptr_t kNumCases = ARRAY_SIZE(kRanges);
+
+  auto normal_entry = H.flow_graph()->graph_entry()->normal_entry();
+  BlockEntryInstr* test_block = normal_entry;
+  Definition* cid = nullptr;
+  for (intptr_t i = 0; i < kNumCases; ++i) {
+    BlockBuilder builder(H.flow_graph(), test_block);
+    if (i == 0) {
+      Definition* v0 = builder.AddParameter(0, kTagged);
+      cid = builder.AddDefinition(
+          new LoadClassIdInstr(new Value(v0), kUnboxedUword));
+    }
+    ComparisonInstr* comparison;
+    if (kRanges[i][0] == kRanges[i][1]) {
+      comparison = new EqualityCompareInstr(
+          InstructionSource(), Token::kEQ, new Value(cid),
+          new Value(H.flow_graph()->GetConstant(
+              Smi::Handle(Smi::New(kRanges[i][0])), kUnboxedUword)),
+          kIntegerCid, DeoptId::kNone, /*null_aware=*/false,
+          Instruction::kNotSpeculative);
+    } else {
+      comparison =
+          new TestRangeInstr(InstructionSource(), new Value(cid),
+                             kRanges[i][0], kRanges[i][1], kUnboxedUword);
+    }
+    auto match = H.TargetEntry();
+    auto no_match = H.TargetEntry();
+    builder.AddBranch(comparison, match, no_match);
+    {
+      BlockBuilder builder(H.flow_graph(), match);
+      builder.AddReturn(new Value(H.IntConstant(i)));
+    }
+    test_block = no_match;
+  }
+  {
+    BlockBuilder builder(H.flow_graph(), test_block);
+    builder.AddReturn(new Value(H.IntConstant(-1)));
+  }
+
+  H.FinishGraph();
+
+  const uword kCids[] = {0,   1,   89,  90,  93,  95,  96,  99,  100, 103,
+                         104, 109, 110, 111, 119, 120, 121, 1000};
+  intptr_t expected[ARRAY_SIZE(kCids)];
+  intptr_t tests = 0;
+  for (intptr_t i = 0; i < ARRAY_SIZE(kCids); ++i) {
+    expected[i] = EvaluateCidTests(H.flow_graph(), kCids[i], &tests);
+  }
+  EvaluateCidTests(H.flow_graph(), 120, &tests);
+  EXPECT_EQ(4, tests);
+
+  CidSwitchOptimizer::Optimize(H.flow_graph());
+
+  for (intptr_t i = 0; i < ARRAY_SIZE(kCids); ++i) {
+    EXPECT_EQ(expected[i], EvaluateCidTests(H.flow_graph(), kCids[i], &tests));
+    EXPECT(tests <= 3);
+  }
+}
+
+}  // namespace dart
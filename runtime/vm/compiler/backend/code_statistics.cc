@@ -4,6 +4,9 @@
 
 #include "vm/compiler/backend/code_statistics.h"
 
+#include "vm/compiler/backend/flow_graph.h"
+#include "vm/compiler/backend/linearscan.h"
+
 namespace dart {
 
 CombinedCodeStatistics::CombinedCodeStatistics() {
@@ -12,6 +15,12 @@ CombinedCodeStatistics::CombinedCodeStatistics() {
   object_header_bytes_ = 0;
   return_const_count_ = 0;
   return_const_with_load_field_count_ = 0;
+  spill_slot_count_ = 0;
+  spill_move_count_ = 0;
+  thorough_allocation_count_ = 0;
+  thorough_allocation_bytes_ = 0;
+  thorough_allocation_spill_move_count_ = 0;
+  shared_slow_path_call_count_ = 0;
   intptr_t i = 0;
 
 #define DO(type, attrs)                                                        \
@@ -59,8 +68,14 @@ void CombinedCodeStatistics::DumpStatistics() {
   qsort(sorted, kNumEntries, sizeof(Entry*), &CompareEntries);
 
   intptr_t instruction_bytes = 0;
+  intptr_t slow_path_bytes = 0;
+  intptr_t slow_path_count = 0;
   for (intptr_t i = 0; i < kNumEntries; i++) {
     instruction_bytes += entries_[i].bytes;
+    if (i >= kTagGraphEntrySlowPath && i < kTagAssertAssignableParameterCheck) {
+      slow_path_bytes += entries_[i].bytes;
+      slow_path_count += entries_[i].count;
+    }
   }
   intptr_t total = object_header_bytes_ + instruction_bytes +
                    unaccounted_bytes_ + alignment_bytes_;
@@ -105,6 +120,24 @@ void CombinedCodeStatistics::DumpStatistics() {
   OS::PrintErr("% 8" Pd " return-constant-with-load-field functions\n",
                return_const_with_load_field_count_);
   OS::PrintErr("--------------------\n");
+  OS::PrintErr("% 8" Pd " spill slots\n", spill_slot_count_);
+  OS::PrintErr("% 8" Pd " spill moves\n", spill_move_count_);
+  OS::PrintErr("% 8" Pd " functions with thorough register allocation\n",
+               thorough_allocation_count_);
+  OS::PrintErr("% 8" Pd " bytes in functions with thorough register "
+               "allocation\n",
+               thorough_allocation_bytes_);
+  OS::PrintErr("% 8" Pd " spill moves in functions with thorough register "
+               "allocation\n",
+               thorough_allocation_spill_move_count_);
+  OS::PrintErr("--------------------\n");
+  OS::PrintErr("% 8" Pd " bytes in %" Pd " out-of-line slow paths\n",
+               slow_path_bytes, slow_path_count);
+  // Instructions calling shared slow-path stubs save and restore the live
+  // registers in the stub instead of in code emitted at every call site.
+  OS::PrintErr("% 8" Pd " calls to shared slow-path stubs\n",
+               shared_slow_path_call_count_);
+  OS::PrintErr("--------------------\n");
 }
 
 int CombinedCodeStatistics::CompareEntries(const void* a, const void* b) {
@@ -125,6 +158,10 @@ CodeStatistics::CodeStatistics(compiler::Assembler* assembler)
   instruction_bytes_ = 0;
   unaccounted_bytes_ = 0;
   alignment_bytes_ = 0;
+  spill_slot_count_ = 0;
+  spill_move_count_ = 0;
+  shared_slow_path_call_count_ = 0;
+  thorough_allocation_ = false;
 
   stack_index_ = -1;
   for (intptr_t i = 0; i < kStackSize; i++)
@@ -132,6 +169,10 @@ CodeStatistics::CodeStatistics(compiler::Assembler* assembler)
 }
 
 void CodeStatistics::Begin(Instruction* instruction) {
+  if (instruction->HasLocs() &&
+      instruction->locs()->call_on_shared_slow_path()) {
+    shared_slow_path_call_count_++;
+  }
   SpecialBegin(static_cast<intptr_t>(instruction->statistics_tag()));
 }
 
@@ -163,6 +204,39 @@ void CodeStatistics::SpecialEnd(intptr_t tag) {
   stack_index_--;
 }
 
+static bool IsSpillSlot(Location loc) {
+  return loc.IsStackSlot() || loc.IsDoubleStackSlot() || loc.IsQuadStackSlot();
+}
+
+static intptr_t CountSpillMoves(ParallelMoveInstr* parallel_move) {
+  intptr_t count = 0;
+  if (parallel_move == nullptr) return count;
+  for (intptr_t i = 0; i < parallel_move->NumMoves(); i++) {
+    MoveOperands* move = parallel_move->MoveOperandsAt(i);
+    if (IsSpillSlot(move->src()) != IsSpillSlot(move->dest())) {
+      count++;
+    }
+  }
+  return count;
+}
+
+void CodeStatistics::RecordRegisterAllocation(const FlowGraph& flow_graph) {
+  spill_slot_count_ = flow_graph.graph_entry()->spill_slot_count();
+  spill_move_count_ = 0;
+  for (auto block : flow_graph.reverse_postorder()) {
+    spill_move_count_ += CountSpillMoves(block->parallel_move());
+    for (ForwardInstructionIterator it(block); !it.Done(); it.Advance()) {
+      if (auto parallel_move = it.Current()->AsParallelMove()) {
+        spill_move_count_ += CountSpillMoves(parallel_move);
+      } else if (auto goto_instr = it.Current()->AsGoto()) {
+        spill_move_count_ += CountSpillMoves(goto_instr->parallel_move());
+      }
+    }
+  }
+  thorough_allocation_ =
+      FlowGraphAllocator::ShouldAllocateThoroughly(flow_graph.function());
+}
+
 void CodeStatistics::Finalize() {
   intptr_t function_size = assembler_->CodeSize();
   unaccounted_bytes_ = function_size - instruction_bytes_;
@@ -201,6 +275,15 @@ void CodeStatistics::AppendTo(CombinedCodeStatistics* stat) {
   stat->alignment_bytes_ += alignment_bytes_;
   stat->object_header_bytes_ += Instructions::HeaderSize();
 
+  stat->spill_slot_count_ += spill_slot_count_;
+  stat->spill_move_count_ += spill_move_count_;
+  stat->shared_slow_path_call_count_ += shared_slow_path_call_count_;
+  if (thorough_allocation_) {
+    stat->thorough_allocation_count_++;
+    stat->thorough_allocation_bytes_ += instruction_bytes_ + unaccounted_bytes_;
+    stat->thorough_allocation_spill_move_count_ += spill_move_count_;
+  }
+
   if (returns_constant) stat->return_const_count_++;
   if (returns_const_with_load_field_) {
     stat->return_const_with_load_field_count_++;
@@ -67,6 +67,12 @@ class CombinedCodeStatistics {
   intptr_t object_header_bytes_;
   intptr_t return_const_count_;
   intptr_t return_const_with_load_field_count_;
+  intptr_t spill_slot_count_;
+  intptr_t spill_move_count_;
+  intptr_t thorough_allocation_count_;
+  intptr_t thorough_allocation_bytes_;
+  intptr_t thorough_allocation_spill_move_count_;
+  intptr_t shared_slow_path_call_count_;
 };
 
 class CodeStatistics {
@@ -81,6 +87,10 @@ class CodeStatistics {
 
   void AppendTo(CombinedCodeStatistics* stat);
 
+  // Records the number of spill slots and of moves to and from spill slots
+  // in the register allocated [flow_graph].
+  void RecordRegisterAllocation(const FlowGraph& flow_graph);
+
   void Finalize();
 
  private:
@@ -97,6 +107,10 @@ class CodeStatistics {
   intptr_t instruction_bytes_;
   intptr_t unaccounted_bytes_;
   intptr_t alignment_bytes_;
+  intptr_t spill_slot_count_;
+  intptr_t spill_move_count_;
+  intptr_t shared_slow_path_call_count_;
+  bool thorough_allocation_;
 
   intptr_t stack_[kStackSize];
   intptr_t stack_index_;
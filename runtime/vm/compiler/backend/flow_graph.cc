@@ -607,10 +607,12 @@ Instruction* FlowGraph::CreateCheckClass(Definition* to_check,
 
 Definition* FlowGraph::CreateCheckBound(Definition* length,
                                         Definition* index,
-                                        intptr_t deopt_id) {
+                                        intptr_t deopt_id,
+                                        bool speculative) {
   Value* val1 = new (zone()) Value(length);
   Value* val2 = new (zone()) Value(index);
-  if (CompilerState::Current().is_aot()) {
+  if (CompilerState::Current().is_aot() ||
+      (!speculative && index->Type()->IsInt())) {
     return new (zone()) GenericCheckBoundInstr(val1, val2, deopt_id);
   }
   return new (zone()) CheckArrayBoundInstr(val1, val2, deopt_id);
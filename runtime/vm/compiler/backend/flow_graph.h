@@ -234,9 +234,14 @@ class FlowGraph : public ZoneAllocated {
                                 intptr_t deopt_id,
                                 const InstructionSource& source);
 
+  // Creates a bounds check of [index] against [length]. In JIT mode the
+  // check deoptimizes when it fails, unless [speculative] is false and
+  // [index] is known to be an integer: such checks throw the RangeError
+  // directly, similar to AOT.
   Definition* CreateCheckBound(Definition* length,
                                Definition* index,
-                               intptr_t deopt_id);
+                               intptr_t deopt_id,
+                               bool speculative = true);
 
   void AddExactnessGuard(InstanceCallInstr* call, intptr_t receiver_cid);
 
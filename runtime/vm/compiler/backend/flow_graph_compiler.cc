@@ -66,10 +66,12 @@ DECLARE_FLAG(charp, deoptimize_filter);
 DECLARE_FLAG(bool, intrinsify);
 DECLARE_FLAG(int, regexp_optimization_counter_threshold);
 DECLARE_FLAG(int, reoptimization_counter_threshold);
+DECLARE_FLAG(int, baseline_tier_up_threshold);
 DECLARE_FLAG(int, stacktrace_every);
 DECLARE_FLAG(charp, stacktrace_filter);
 DECLARE_FLAG(int, gc_every);
 DECLARE_FLAG(bool, trace_compiler);
+DECLARE_FLAG(charp, write_aot_profile_to);
 
 #if defined(TARGET_ARCH_ARM) || defined(TARGET_ARCH_ARM64)
 compiler::LRState ComputeInnerLRState(const FlowGraph& flow_graph) {
@@ -172,7 +174,8 @@ FlowGraphCompiler::FlowGraphCompiler(
                                         .LookupClass(Symbols::List()))),
       pending_deoptimization_env_(nullptr),
       deopt_id_to_ic_data_(deopt_id_to_ic_data),
-      edge_counters_array_(Array::ZoneHandle()) {
+      edge_counters_array_(Array::ZoneHandle()),
+      edge_counter_keys_array_(Array::ZoneHandle()) {
   ASSERT(flow_graph->parsed_function().function().ptr() ==
          parsed_function.function().ptr());
   if (is_optimizing) {
@@ -212,6 +215,7 @@ void FlowGraphCompiler::InitCompiler() {
   catch_entry_moves_maps_builder_ = new (zone()) CatchEntryMovesMapBuilder();
 #endif
   block_info_.Clear();
+  may_reoptimize_ = is_baseline_tier();
   // Initialize block info and search optimized (non-OSR) code for calls
   // indicating a non-leaf routine and calls without IC data indicating
   // possible reoptimization.
@@ -244,6 +248,19 @@ void FlowGraphCompiler::InitCompiler() {
       edge_counters.SetAt(i, Object::smi_zero());
     }
     edge_counters_array_ = edge_counters.ptr();
+
+    // Edge counters are indexed by block preorder number, which the
+    // precompiler can't match. Record the deopt ids of the blocks as a
+    // stable key for them.
+    if (FLAG_write_aot_profile_to != nullptr) {
+      const auto& keys = Array::Handle(Array::New(num_counters, Heap::kOld));
+      auto& key = Smi::Handle();
+      for (intptr_t i = 0; i < num_counters; ++i) {
+        key = Smi::New(flow_graph_.preorder()[i]->deopt_id());
+        keys.SetAt(i, key);
+      }
+      edge_counter_keys_array_ = keys.ptr();
+    }
   }
 }
 
@@ -1902,9 +1919,15 @@ const ICData* FlowGraphCompiler::GetOrAddStaticCallICData(
   return &ic_data;
 }
 
+bool FlowGraphCompiler::is_baseline_tier() const {
+  return is_optimizing() && thread()->compiler_state().is_baseline_tier();
+}
+
 intptr_t FlowGraphCompiler::GetOptimizationThreshold() const {
   intptr_t threshold;
-  if (is_optimizing()) {
+  if (is_baseline_tier()) {
+    threshold = FLAG_baseline_tier_up_threshold;
+  } else if (is_optimizing()) {
     threshold = FLAG_reoptimization_counter_threshold;
   } else if (parsed_function_.function().IsIrregexpFunction()) {
     threshold = FLAG_regexp_optimization_counter_threshold;
@@ -2498,6 +2521,32 @@ FlowGraphCompiler::GenerateInstantiatedTypeWithArgumentsTest(
     return GenerateSubtype1TestCacheLookup(source, type_class, is_instance_lbl,
                                            is_not_instance_lbl);
   }
+  // With the whole class hierarchy known, only instances of generic subclasses
+  // of [type_class] need to have their type arguments checked.
+  if (auto const hi = thread()->hierarchy_info()) {
+    CidRangeVector instance_ranges;
+    CidRangeVector unknown_ranges;
+    if (hi->SplitSubtypeRangesForGenericType(type, &instance_ranges,
+                                             &unknown_ranges) &&
+        (instance_ranges.length() + unknown_ranges.length() <=
+         kMaxNumberOfCidRangesToTest)) {
+      __ LoadClassId(kScratchReg, TypeTestABI::kInstanceReg);
+      if (GenerateCidRangesCheck(assembler(), kScratchReg, instance_ranges,
+                                 is_instance_lbl)) {
+        // The check biased the class id, reload it.
+        __ LoadClassId(kScratchReg, TypeTestABI::kInstanceReg);
+      }
+      if (unknown_ranges.is_empty()) {
+        __ Jump(is_not_instance_lbl);
+        return SubtypeTestCache::null();  // No need for an STC.
+      }
+      compiler::Label check_type_arguments;
+      GenerateCidRangesCheck(assembler(), kScratchReg, unknown_ranges,
+                             &check_type_arguments, is_not_instance_lbl,
+                             /*fall_through_if_inside=*/true);
+      __ Bind(&check_type_arguments);
+    }
+  }
   // If one type argument only, check if type argument is a top type.
   if (type_arguments.Length() == 1) {
     const AbstractType& tp_argument =
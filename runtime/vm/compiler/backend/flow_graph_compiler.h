@@ -193,6 +193,14 @@ class BoxAllocationSlowPath : public TemplateSlowPathCode<Instruction> {
                        Register result,
                        Register temp);
 
+  // Allocates a Mint into [result]. If [instruction] calls on a shared slow
+  // path, this calls the shared AllocateMint stubs and [result] is
+  // AllocateMintABI::kResultReg.
+  static void AllocateMint(FlowGraphCompiler* compiler,
+                           Instruction* instruction,
+                           Register result,
+                           Register temp);
+
  private:
   const Class& cls_;
   const Register result_;
@@ -878,6 +886,10 @@ class FlowGraphCompiler : public ValueObject {
 
   bool may_reoptimize() const { return may_reoptimize_; }
 
+  // Baseline optimized code counts its invocations at the entry like
+  // unoptimized code does, to tier up to the full optimizing pipeline.
+  bool is_baseline_tier() const;
+
   // Use in unoptimized compilation to preserve/reuse ICData.
   //
   // If [binary_smi_target] is non-null and we have to create the ICData, the
@@ -912,6 +924,9 @@ class FlowGraphCompiler : public ValueObject {
   void AddDispatchTableCallTarget(const compiler::TableSelector* selector);
 
   ArrayPtr edge_counters_array() const { return edge_counters_array_.ptr(); }
+  ArrayPtr edge_counter_keys_array() const {
+    return edge_counter_keys_array_.ptr();
+  }
 
   ArrayPtr InliningIdToFunction() const;
 
@@ -1236,6 +1251,8 @@ class FlowGraphCompiler : public ValueObject {
 
   ZoneGrowableArray<const ICData*>* deopt_id_to_ic_data_;
   Array& edge_counters_array_;
+  // The deopt id of the block owning each edge counter, for the AOT profile.
+  Array& edge_counter_keys_array_;
 
   // Instruction currently running EmitNativeCode().
   Instruction* current_instruction_ = nullptr;
@@ -224,8 +224,9 @@ void FlowGraphCompiler::EmitFrameEntry() {
                            Function::usage_counter_offset(),
                            compiler::kFourBytes);
     // Reoptimization of an optimized function is triggered by counting in
-    // IC stubs, but not at the entry of the function.
-    if (!is_optimizing()) {
+    // IC stubs, but not at the entry of the function, except for baseline
+    // optimized code which tiers up on invocations.
+    if (!is_optimizing() || is_baseline_tier()) {
       __ addi(usage_reg, usage_reg, 1);
       __ StoreFieldToOffset(usage_reg, function_reg,
                             Function::usage_counter_offset(),
@@ -247,8 +247,9 @@ void FlowGraphCompiler::EmitFrameEntry() {
               compiler::FieldAddress(CODE_REG, Code::owner_offset()));
 
       // Reoptimization of an optimized function is triggered by counting in
-      // IC stubs, but not at the entry of the function.
-      if (!is_optimizing()) {
+      // IC stubs, but not at the entry of the function, except for baseline
+      // optimized code which tiers up on invocations.
+      if (!is_optimizing() || is_baseline_tier()) {
         __ incl(compiler::FieldAddress(function_reg,
                                        Function::usage_counter_offset()));
       }
@@ -406,6 +406,78 @@ bool HierarchyInfo::CanUseRecordSubtypeRangeCheckFor(const AbstractType& type) {
   return true;
 }
 
+bool HierarchyInfo::SplitSubtypeRangesForGenericType(
+    const AbstractType& type,
+    CidRangeVector* instance_ranges,
+    CidRangeVector* unknown_ranges) {
+  ASSERT(type.IsFinalized());
+  ASSERT(instance_ranges->is_empty() && unknown_ranges->is_empty());
+
+  // See [CanUseGenericSubtypeRangeCheckFor] for why FutureOr<T> is excluded.
+  if (!type.IsInstantiated() || !type.IsType() || type.IsFutureOrType()) {
+    return false;
+  }
+
+  Zone* zone = thread()->zone();
+  const Class& type_class = Class::Handle(zone, type.type_class());
+  if (!type_class.IsGeneric()) {
+    return false;
+  }
+
+  // Classes outside of these ranges are not subtypes of [type_class], so
+  // their instances cannot be instances of [type] either.
+  const CidRangeVector& ranges =
+      SubtypeRangesForClass(type_class, /*include_abstract=*/false,
+                            /*exclude_null=*/true);
+
+  ClassTable* const table = thread()->isolate_group()->class_table();
+  auto& klass = Class::Handle(zone);
+  auto& subtype = AbstractType::Handle(zone);
+  for (intptr_t i = 0; i < ranges.length(); ++i) {
+    // The vector the currently open range [start, end] is added to, if any.
+    CidRangeVector* open_ranges = nullptr;
+    intptr_t start = -1;
+    intptr_t end = -1;
+    for (intptr_t cid = ranges[i].cid_start; cid <= ranges[i].cid_end;
+         ++cid) {
+      // Cids without instances can be added to either kind of range.
+      if (!table->HasValidClassAt(cid)) continue;
+      if (cid == kTypeArgumentsCid || cid == kVoidCid || cid == kDynamicCid ||
+          cid == kNeverCid) {
+        continue;
+      }
+      klass = table->At(cid);
+      if (klass.is_abstract() || klass.IsTopLevel()) continue;
+
+      // The type arguments of instances of non-generic classes are fixed by
+      // their class, so the result of the subtype test is known statically.
+      CidRangeVector* cid_ranges = unknown_ranges;
+      if (cid != kNullCid && klass.is_finalized() && !klass.IsGeneric()) {
+        subtype = klass.RareType();
+        // Create local zone because deep hierarchies may allocate lots of
+        // handles.
+        StackZone stack_zone(thread());
+        HANDLESCOPE(thread());
+        cid_ranges =
+            subtype.IsSubtypeOf(type, Heap::kNew) ? instance_ranges : nullptr;
+      }
+
+      if (cid_ranges != open_ranges) {
+        if (open_ranges != nullptr) {
+          open_ranges->Add({start, end});
+        }
+        open_ranges = cid_ranges;
+        start = cid;
+      }
+      end = cid;
+    }
+    if (open_ranges != nullptr) {
+      open_ranges->Add({start, end});
+    }
+  }
+  return true;
+}
+
 bool HierarchyInfo::InstanceOfHasClassRange(const AbstractType& type,
                                             intptr_t* lower_limit,
                                             intptr_t* upper_limit) {
@@ -3229,6 +3301,20 @@ bool BoxIntegerInstr::ValueFitsSmi() const {
   return RangeUtils::Fits(range, RangeBoundary::kRangeBoundarySmi);
 }
 
+bool BoxIntegerInstr::UseSharedSlowPathStub(bool is_optimizing) const {
+  // The shared slow path can only be used after VM isolate stubs were replaced
+  // with isolate-specific stubs.
+  auto object_store = IsolateGroup::Current()->object_store();
+  const bool stubs_in_vm_isolate =
+      object_store->allocate_mint_with_fpu_regs_stub()
+          ->untag()
+          ->InVMIsolateHeap() ||
+      object_store->allocate_mint_without_fpu_regs_stub()
+          ->untag()
+          ->InVMIsolateHeap();
+  return SlowPathSharingSupported(is_optimizing) && !stubs_in_vm_isolate;
+}
+
 Definition* BoxIntegerInstr::Canonicalize(FlowGraph* flow_graph) {
   if (input_use_list() == nullptr) {
     // Environments can accommodate any representation. No need to box.
@@ -5675,6 +5761,15 @@ bool PolymorphicInstanceCallInstr::IsSureToCallSingleRecognizedTarget() const {
   return targets_.HasSingleRecognizedTarget();
 }
 
+bool StaticCallInstr::AttributesEqual(const Instruction& other) const {
+  auto const other_call = other.AsStaticCall();
+  ASSERT(other_call != nullptr);
+  return (function().ptr() == other_call->function().ptr()) &&
+         (type_args_len() == other_call->type_args_len()) &&
+         (argument_names().ptr() == other_call->argument_names().ptr()) &&
+         (entry_kind() == other_call->entry_kind());
+}
+
 bool StaticCallInstr::InitResultType(Zone* zone) {
   const intptr_t list_cid = FactoryRecognizer::GetResultCidOfListFactory(
       zone, function(), ArgumentCount());
@@ -6339,6 +6434,36 @@ void BoxAllocationSlowPath::Allocate(FlowGraphCompiler* compiler,
   }
 }
 
+void BoxAllocationSlowPath::AllocateMint(FlowGraphCompiler* compiler,
+                                         Instruction* instruction,
+                                         Register result,
+                                         Register temp) {
+  if (compiler->intrinsic_mode()) {
+    __ TryAllocate(compiler->mint_class(),
+                   compiler->intrinsic_slow_path_label(),
+                   compiler::Assembler::kNearJump, result, temp);
+    return;
+  }
+  LocationSummary* locs = instruction->locs();
+  if (!locs->call_on_shared_slow_path()) {
+    Allocate(compiler, instruction, compiler->mint_class(), result, temp);
+    return;
+  }
+  ASSERT(result == AllocateMintABI::kResultReg);
+  ASSERT(
+      !locs->live_registers()->ContainsRegister(AllocateMintABI::kResultReg));
+  auto object_store = compiler->isolate_group()->object_store();
+  const bool live_fpu_regs = locs->live_registers()->FpuRegisterCount() > 0;
+  const auto& stub = Code::ZoneHandle(
+      compiler->zone(),
+      live_fpu_regs ? object_store->allocate_mint_with_fpu_regs_stub()
+                    : object_store->allocate_mint_without_fpu_regs_stub());
+  auto extended_env = compiler->SlowPathEnvironmentFor(instruction, 0);
+  compiler->GenerateStubCall(instruction->source(), stub,
+                             UntaggedPcDescriptors::kOther, locs,
+                             DeoptId::kNone, extended_env);
+}
+
 void DoubleToIntegerSlowPath::EmitNativeCode(FlowGraphCompiler* compiler) {
   __ Comment("DoubleToIntegerSlowPath");
   __ Bind(entry_label());
@@ -6945,8 +7070,9 @@ Representation StoreIndexedInstr::RequiredInputRepresentation(
   return ValueRepresentation(class_id());
 }
 
-#if defined(TARGET_ARCH_ARM64)
-// We can emit a 16 byte move in a single instruction using LDP/STP.
+#if defined(TARGET_ARCH_ARM64) || defined(TARGET_ARCH_X64)
+// We can emit a 16 byte move in a single instruction using LDP/STP on ARM64
+// and an XMM register on X64.
 static const intptr_t kMaxElementSizeForEfficientCopy = 16;
 #else
 static const intptr_t kMaxElementSizeForEfficientCopy =
@@ -7109,8 +7235,9 @@ void MemoryCopyInstr::EmitUnrolledCopy(FlowGraphCompiler* compiler,
                                        bool reversed) {
   ASSERT(element_size_ <= 16);
   const intptr_t num_bytes = num_elements * element_size_;
-#if defined(TARGET_ARCH_ARM64)
-  // We use LDP/STP with TMP/TMP2 to handle 16-byte moves.
+#if defined(TARGET_ARCH_ARM64) || defined(TARGET_ARCH_X64)
+  // We use LDP/STP with TMP/TMP2 on ARM64 and FpuTMP on X64 to handle 16-byte
+  // moves.
   const intptr_t mov_size = element_size_;
 #else
   const intptr_t mov_size =
@@ -7160,6 +7287,9 @@ void MemoryCopyInstr::EmitUnrolledCopy(FlowGraphCompiler* compiler,
         __ stp(
             TMP, TMP2,
             compiler::Address(dest_reg, offset, compiler::Address::PairOffset));
+#elif defined(TARGET_ARCH_X64)
+        __ movups(FpuTMP, compiler::Address(src_reg, offset));
+        __ movups(compiler::Address(dest_reg, offset), FpuTMP);
 #else
         UNREACHABLE();
 #endif
@@ -311,6 +311,19 @@ class HierarchyInfo : public ThreadStackResource {
   // simple [CidRange]-based subtype-check.
   bool CanUseRecordSubtypeRangeCheckFor(const AbstractType& type);
 
+  // Splits the concrete, non-null subtypes of the class of the instantiated
+  // generic [type] by the answer of the subtype test against [type].
+  //
+  // Instances of classes in [instance_ranges] are instances of [type]
+  // regardless of their type arguments, for instances of classes in
+  // [unknown_ranges] the type arguments have to be checked. All other
+  // non-null instances are not instances of [type].
+  //
+  // Returns `false` if [type] cannot be handled this way.
+  bool SplitSubtypeRangesForGenericType(const AbstractType& type,
+                                        CidRangeVector* instance_ranges,
+                                        CidRangeVector* unknown_ranges);
+
  private:
   // Does not use any hierarchy information available in the system but computes
   // it via O(n) class table traversal.
@@ -5520,6 +5533,13 @@ class StaticCallInstr : public TemplateDartCall<0> {
   virtual bool HasUnknownSideEffects() const { return true; }
   virtual bool CanCallDart() const { return true; }
 
+  // Calls to pure functions with the same arguments return the same value,
+  // see Function::is_pure(). The summary is only recorded in AOT.
+  virtual bool AllowsCSE() const {
+    return CompilerState::Current().is_aot() && function().is_pure();
+  }
+  virtual bool AttributesEqual(const Instruction& other) const;
+
   // Initialize result type of this call instruction if target is a recognized
   // method or has pragma annotation.
   // Returns true on success, false if result type is still unknown.
@@ -8497,6 +8517,10 @@ class BoxIntegerInstr : public BoxInstr {
 
   virtual bool CanTriggerGC() const { return !ValueFitsSmi(); }
 
+  // Mints are allocated by calling the shared AllocateMint stubs, which save
+  // all registers themselves, instead of a slow path at every allocation site.
+  virtual bool UseSharedSlowPathStub(bool is_optimizing) const;
+
   DECLARE_ABSTRACT_INSTRUCTION(BoxInteger)
 
   DECLARE_EMPTY_SERIALIZATION(BoxIntegerInstr, BoxInstr)
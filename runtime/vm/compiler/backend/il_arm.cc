@@ -4454,19 +4454,7 @@ LocationSummary* BoxInt64Instr::MakeLocationSummary(Zone* zone,
                                                     bool opt) const {
   const intptr_t kNumInputs = 1;
   const intptr_t kNumTemps = ValueFitsSmi() ? 0 : 1;
-  // Shared slow path is used in BoxInt64Instr::EmitNativeCode in
-  // precompiled mode and only after VM isolate stubs where
-  // replaced with isolate-specific stubs.
-  auto object_store = IsolateGroup::Current()->object_store();
-  const bool stubs_in_vm_isolate =
-      object_store->allocate_mint_with_fpu_regs_stub()
-          ->untag()
-          ->InVMIsolateHeap() ||
-      object_store->allocate_mint_without_fpu_regs_stub()
-          ->untag()
-          ->InVMIsolateHeap();
-  const bool shared_slow_path_call =
-      SlowPathSharingSupported(opt) && !stubs_in_vm_isolate;
+  const bool shared_slow_path_call = UseSharedSlowPathStub(opt);
   LocationSummary* summary = new (zone) LocationSummary(
       zone, kNumInputs, kNumTemps,
       ValueFitsSmi()
@@ -4509,27 +4497,7 @@ void BoxInt64Instr::EmitNativeCode(FlowGraphCompiler* compiler) {
   __ cmp(value_hi, compiler::Operand(out_reg, ASR, 31), EQ);
   __ b(&done, EQ);
 
-  if (compiler->intrinsic_mode()) {
-    __ TryAllocate(compiler->mint_class(),
-                   compiler->intrinsic_slow_path_label(),
-                   compiler::Assembler::kNearJump, out_reg, tmp);
-  } else if (locs()->call_on_shared_slow_path()) {
-    auto object_store = compiler->isolate_group()->object_store();
-    const bool live_fpu_regs = locs()->live_registers()->FpuRegisterCount() > 0;
-    const auto& stub = Code::ZoneHandle(
-        compiler->zone(),
-        live_fpu_regs ? object_store->allocate_mint_with_fpu_regs_stub()
-                      : object_store->allocate_mint_without_fpu_regs_stub());
-
-    ASSERT(!locs()->live_registers()->ContainsRegister(
-        AllocateMintABI::kResultReg));
-    auto extended_env = compiler->SlowPathEnvironmentFor(this, 0);
-    compiler->GenerateStubCall(source(), stub, UntaggedPcDescriptors::kOther,
-                               locs(), DeoptId::kNone, extended_env);
-  } else {
-    BoxAllocationSlowPath::Allocate(compiler, this, compiler->mint_class(),
-                                    out_reg, tmp);
-  }
+  BoxAllocationSlowPath::AllocateMint(compiler, this, out_reg, tmp);
 
   __ StoreFieldToOffset(value_lo, out_reg,
                         compiler::target::Mint::value_offset());
@@ -1861,7 +1861,7 @@ void StringToCharCodeInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
 LocationSummary* Utf8ScanInstr::MakeLocationSummary(Zone* zone,
                                                     bool opt) const {
   const intptr_t kNumInputs = 5;
-  const intptr_t kNumTemps = 0;
+  const intptr_t kNumTemps = 1;
   LocationSummary* summary = new (zone)
       LocationSummary(zone, kNumInputs, kNumTemps, LocationSummary::kNoCall);
   summary->set_in(0, Location::Any());               // decoder
@@ -1869,6 +1869,7 @@ LocationSummary* Utf8ScanInstr::MakeLocationSummary(Zone* zone,
   summary->set_in(2, Location::WritableRegister());  // start
   summary->set_in(3, Location::WritableRegister());  // end
   summary->set_in(4, Location::WritableRegister());  // table
+  summary->set_temp(0, Location::RequiresRegister());
   summary->set_out(0, Location::RequiresRegister());
   return summary;
 }
@@ -1883,14 +1884,20 @@ void Utf8ScanInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
   const Register bytes_ptr_reg = start_reg;
   const Register bytes_end_reg = end_reg;
   const Register flags_reg = bytes_reg;
+  const Register bytes_limit_reg = locs()->temp(0).reg();
   const Register temp_reg = TMP;
+  const Register temp2_reg = TMP2;
   const Register decoder_temp_reg = start_reg;
   const Register flags_temp_reg = end_reg;
 
+  // ASCII bytes are scanned in blocks of two words.
+  const intptr_t kBlockSize = 2 * kWordSize;
+  const int64_t kNonAsciiMask = 0x8080808080808080;
+
   const intptr_t kSizeMask = 0x03;
   const intptr_t kFlagsMask = 0x3C;
 
-  compiler::Label loop, loop_in;
+  compiler::Label block_loop, scan_block, scan_rest, loop, loop_in;
 
   // Address of input bytes.
   __ LoadFromSlot(bytes_reg, bytes_reg, Slot::PointerBase_data());
@@ -1908,7 +1915,30 @@ void Utf8ScanInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
   __ mov(size_reg, ZR);
   __ mov(flags_reg, ZR);
 
+  // Loop over blocks of ASCII bytes, which each add one to the size and
+  // nothing to the flags.
+  __ Bind(&block_loop);
+  __ sub(temp_reg, bytes_end_reg, compiler::Operand(bytes_ptr_reg));
+  __ CompareImmediate(temp_reg, kBlockSize);
+  __ b(&scan_rest, LT);
+  __ ldp(temp_reg, temp2_reg,
+         compiler::Address(bytes_ptr_reg, 0, compiler::Address::PairOffset));
+  __ orr(temp_reg, temp_reg, compiler::Operand(temp2_reg));
+  __ TestImmediate(temp_reg, kNonAsciiMask);
+  __ b(&scan_block, NOT_ZERO);
+  __ AddImmediate(bytes_ptr_reg, kBlockSize);
+  __ AddImmediate(size_reg, kBlockSize);
+  __ b(&block_loop);
+
+  // Less than kBlockSize bytes left. Process them individually.
+  __ Bind(&scan_rest);
+  __ mov(bytes_limit_reg, bytes_end_reg);
   __ b(&loop_in);
+
+  // The block contains a non-ASCII byte. Process its bytes individually.
+  __ Bind(&scan_block);
+  __ AddImmediate(bytes_limit_reg, bytes_ptr_reg, kBlockSize);
+
   __ Bind(&loop);
 
   // Read byte and increment pointer.
@@ -1923,10 +1953,12 @@ void Utf8ScanInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
   __ andi(temp_reg, temp_reg, compiler::Immediate(kSizeMask));
   __ add(size_reg, size_reg, compiler::Operand(temp_reg));
 
-  // Stop if end is reached.
+  // Stop if the end of the block or the input is reached.
   __ Bind(&loop_in);
-  __ cmp(bytes_ptr_reg, compiler::Operand(bytes_end_reg));
+  __ cmp(bytes_ptr_reg, compiler::Operand(bytes_limit_reg));
   __ b(&loop, UNSIGNED_LESS);
+  __ cmp(bytes_ptr_reg, compiler::Operand(bytes_end_reg));
+  __ b(&block_loop, UNSIGNED_LESS);
 
   // Write flags to field.
   __ AndImmediate(flags_reg, flags_reg, kFlagsMask);
@@ -3624,16 +3656,25 @@ LocationSummary* BoxInteger32Instr::MakeLocationSummary(Zone* zone,
 #else
   const bool kMayAllocateMint = !ValueFitsSmi();
 #endif
+  const bool shared_slow_path_call =
+      kMayAllocateMint && UseSharedSlowPathStub(opt);
   const intptr_t kNumInputs = 1;
   const intptr_t kNumTemps = kMayAllocateMint ? 1 : 0;
-  LocationSummary* summary = new (zone)
-      LocationSummary(zone, kNumInputs, kNumTemps,
-                      kMayAllocateMint ? LocationSummary::kCallOnSlowPath
-                                       : LocationSummary::kNoCall);
+  LocationSummary* summary = new (zone) LocationSummary(
+      zone, kNumInputs, kNumTemps,
+      !kMayAllocateMint       ? LocationSummary::kNoCall
+      : shared_slow_path_call ? LocationSummary::kCallOnSharedSlowPath
+                              : LocationSummary::kCallOnSlowPath);
   summary->set_in(0, Location::RequiresRegister());
-  summary->set_out(0, Location::RequiresRegister());
-  if (kMayAllocateMint) {
-    summary->set_temp(0, Location::RequiresRegister());
+  if (shared_slow_path_call) {
+    summary->set_out(0,
+                     Location::RegisterLocation(AllocateMintABI::kResultReg));
+    summary->set_temp(0, Location::RegisterLocation(AllocateMintABI::kTempReg));
+  } else {
+    summary->set_out(0, Location::RequiresRegister());
+    if (kMayAllocateMint) {
+      summary->set_temp(0, Location::RequiresRegister());
+    }
   }
   return summary;
 }
@@ -3676,8 +3717,7 @@ void BoxInteger32Instr::EmitNativeCode(FlowGraphCompiler* compiler) {
   }
 
   Register temp = locs()->temp(0).reg();
-  BoxAllocationSlowPath::Allocate(compiler, this, compiler->mint_class(), out,
-                                  temp);
+  BoxAllocationSlowPath::AllocateMint(compiler, this, out, temp);
   if (from_representation() == kUnboxedInt32) {
     __ sxtw(temp, value);  // Sign-extend.
   } else {
@@ -3692,19 +3732,7 @@ LocationSummary* BoxInt64Instr::MakeLocationSummary(Zone* zone,
                                                     bool opt) const {
   const intptr_t kNumInputs = 1;
   const intptr_t kNumTemps = ValueFitsSmi() ? 0 : 1;
-  // Shared slow path is used in BoxInt64Instr::EmitNativeCode in
-  // precompiled mode and only after VM isolate stubs where
-  // replaced with isolate-specific stubs.
-  auto object_store = IsolateGroup::Current()->object_store();
-  const bool stubs_in_vm_isolate =
-      object_store->allocate_mint_with_fpu_regs_stub()
-          ->untag()
-          ->InVMIsolateHeap() ||
-      object_store->allocate_mint_without_fpu_regs_stub()
-          ->untag()
-          ->InVMIsolateHeap();
-  const bool shared_slow_path_call =
-      SlowPathSharingSupported(opt) && !stubs_in_vm_isolate;
+  const bool shared_slow_path_call = UseSharedSlowPathStub(opt);
   LocationSummary* summary = new (zone) LocationSummary(
       zone, kNumInputs, kNumTemps,
       ValueFitsSmi()          ? LocationSummary::kNoCall
@@ -3745,27 +3773,7 @@ void BoxInt64Instr::EmitNativeCode(FlowGraphCompiler* compiler) {
 #endif
 
   Register temp = locs()->temp(0).reg();
-  if (compiler->intrinsic_mode()) {
-    __ TryAllocate(compiler->mint_class(),
-                   compiler->intrinsic_slow_path_label(),
-                   compiler::Assembler::kNearJump, out, temp);
-  } else if (locs()->call_on_shared_slow_path()) {
-    auto object_store = compiler->isolate_group()->object_store();
-    const bool live_fpu_regs = locs()->live_registers()->FpuRegisterCount() > 0;
-    const auto& stub = Code::ZoneHandle(
-        compiler->zone(),
-        live_fpu_regs ? object_store->allocate_mint_with_fpu_regs_stub()
-                      : object_store->allocate_mint_without_fpu_regs_stub());
-
-    ASSERT(!locs()->live_registers()->ContainsRegister(
-        AllocateMintABI::kResultReg));
-    auto extended_env = compiler->SlowPathEnvironmentFor(this, 0);
-    compiler->GenerateStubCall(source(), stub, UntaggedPcDescriptors::kOther,
-                               locs(), DeoptId::kNone, extended_env);
-  } else {
-    BoxAllocationSlowPath::Allocate(compiler, this, compiler->mint_class(), out,
-                                    temp);
-  }
+  BoxAllocationSlowPath::AllocateMint(compiler, this, out, temp);
 
   __ StoreToOffset(in, out, Mint::value_offset() - kHeapObjectTag);
   __ Bind(&done);
@@ -4025,6 +4033,9 @@ DEFINE_EMIT(SimdUnaryOp, (VRegister result, VRegister value)) {
         __ vdups(result, value, 2);
       } else if (mask == 0xFF) {
         __ vdups(result, value, 3);
+      } else if (mask == 0xE4) {
+        // Identity shuffle (x, y, z, w).
+        __ vmov(result, value);
       } else {
         for (intptr_t i = 0; i < 4; i++) {
           __ vinss(result, i, value, (mask >> (2 * i)) & 0x3);
@@ -4179,7 +4190,7 @@ DEFINE_EMIT(Float64x2With,
 DEFINE_EMIT(
     Int32x4FromInts,
     (VRegister result, Register v0, Register v1, Register v2, Register v3)) {
-  __ veor(result, result, result);
+  // All four lanes are written, so no need to clear [result] first.
   __ vinsw(result, 0, v0);
   __ vinsw(result, 1, v1);
   __ vinsw(result, 2, v2);
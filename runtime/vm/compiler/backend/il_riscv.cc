@@ -4080,19 +4080,7 @@ void BoxInteger32Instr::EmitNativeCode(FlowGraphCompiler* compiler) {
 
 LocationSummary* BoxInt64Instr::MakeLocationSummary(Zone* zone,
                                                     bool opt) const {
-  // Shared slow path is used in BoxInt64Instr::EmitNativeCode in
-  // FLAG_use_bare_instructions mode and only after VM isolate stubs where
-  // replaced with isolate-specific stubs.
-  auto object_store = IsolateGroup::Current()->object_store();
-  const bool stubs_in_vm_isolate =
-      object_store->allocate_mint_with_fpu_regs_stub()
-          ->untag()
-          ->InVMIsolateHeap() ||
-      object_store->allocate_mint_without_fpu_regs_stub()
-          ->untag()
-          ->InVMIsolateHeap();
-  const bool shared_slow_path_call =
-      SlowPathSharingSupported(opt) && !stubs_in_vm_isolate;
+  const bool shared_slow_path_call = UseSharedSlowPathStub(opt);
   const intptr_t kNumInputs = 1;
   const intptr_t kNumTemps = ValueFitsSmi() ? 0 : 1;
   LocationSummary* summary = new (zone) LocationSummary(
@@ -4143,27 +4131,7 @@ void BoxInt64Instr::EmitNativeCode(FlowGraphCompiler* compiler) {
   __ beq(value_hi, TMP, &done, compiler::Assembler::kNearJump);
 
   __ Bind(&overflow);
-  if (compiler->intrinsic_mode()) {
-    __ TryAllocate(compiler->mint_class(),
-                   compiler->intrinsic_slow_path_label(),
-                   compiler::Assembler::kNearJump, out_reg, TMP);
-  } else if (locs()->call_on_shared_slow_path()) {
-    auto object_store = compiler->isolate_group()->object_store();
-    const bool live_fpu_regs = locs()->live_registers()->FpuRegisterCount() > 0;
-    const auto& stub = Code::ZoneHandle(
-        compiler->zone(),
-        live_fpu_regs ? object_store->allocate_mint_with_fpu_regs_stub()
-                      : object_store->allocate_mint_without_fpu_regs_stub());
-
-    ASSERT(!locs()->live_registers()->ContainsRegister(
-        AllocateMintABI::kResultReg));
-    auto extended_env = compiler->SlowPathEnvironmentFor(this, 0);
-    compiler->GenerateStubCall(source(), stub, UntaggedPcDescriptors::kOther,
-                               locs(), DeoptId::kNone, extended_env);
-  } else {
-    BoxAllocationSlowPath::Allocate(compiler, this, compiler->mint_class(),
-                                    out_reg, TMP);
-  }
+  BoxAllocationSlowPath::AllocateMint(compiler, this, out_reg, TMP);
 
   __ StoreFieldToOffset(value_lo, out_reg,
                         compiler::target::Mint::value_offset());
@@ -4186,27 +4154,7 @@ void BoxInt64Instr::EmitNativeCode(FlowGraphCompiler* compiler) {
   __ SmiUntag(TMP, out);
   __ beq(in, TMP, &done);  // No overflow.
 
-  if (compiler->intrinsic_mode()) {
-    __ TryAllocate(compiler->mint_class(),
-                   compiler->intrinsic_slow_path_label(),
-                   compiler::Assembler::kNearJump, out, TMP);
-  } else if (locs()->call_on_shared_slow_path()) {
-    auto object_store = compiler->isolate_group()->object_store();
-    const bool live_fpu_regs = locs()->live_registers()->FpuRegisterCount() > 0;
-    const auto& stub = Code::ZoneHandle(
-        compiler->zone(),
-        live_fpu_regs ? object_store->allocate_mint_with_fpu_regs_stub()
-                      : object_store->allocate_mint_without_fpu_regs_stub());
-
-    ASSERT(!locs()->live_registers()->ContainsRegister(
-        AllocateMintABI::kResultReg));
-    auto extended_env = compiler->SlowPathEnvironmentFor(this, 0);
-    compiler->GenerateStubCall(source(), stub, UntaggedPcDescriptors::kOther,
-                               locs(), DeoptId::kNone, extended_env);
-  } else {
-    BoxAllocationSlowPath::Allocate(compiler, this, compiler->mint_class(), out,
-                                    TMP);
-  }
+  BoxAllocationSlowPath::AllocateMint(compiler, this, out, TMP);
 
   __ StoreToOffset(in, out, Mint::value_offset() - kHeapObjectTag);
   __ Bind(&done);
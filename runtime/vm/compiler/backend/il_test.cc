@@ -651,6 +651,47 @@ ISOLATE_UNIT_TEST_CASE(HierarchyInfo_String_Subtype) {
   RANGES_CONTAIN_EXPECTED_CIDS(abstract_range, expected_cids);
 }
 
+ISOLATE_UNIT_TEST_CASE(HierarchyInfo_GenericType_Split) {
+  const char* kScript = R"(
+    class A<T> {}
+    class B extends A<int> {}
+    class C extends A<String> {}
+    class D<T> extends A<T> {}
+    class E {}
+
+    main() => [B(), C(), D<int>(), E()];
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  Invoke(root_library, "main");
+  const auto& class_b = Class::Handle(GetClass(root_library, "B"));
+  const auto& class_c = Class::Handle(GetClass(root_library, "C"));
+  const auto& class_d = Class::Handle(GetClass(root_library, "D"));
+  const auto& class_e = Class::Handle(GetClass(root_library, "E"));
+
+  // A<int>
+  const auto& type = Type::Handle(class_b.super_type());
+
+  HierarchyInfo hi(thread);
+  CidRangeVector instance_ranges;
+  CidRangeVector unknown_ranges;
+  EXPECT(hi.SplitSubtypeRangesForGenericType(type, &instance_ranges,
+                                             &unknown_ranges));
+
+  // B is always an A<int>.
+  EXPECT(CidRangeVectorUtils::ContainsCid(instance_ranges, class_b.id()));
+  EXPECT(!CidRangeVectorUtils::ContainsCid(unknown_ranges, class_b.id()));
+  // C is never an A<int>.
+  EXPECT(!CidRangeVectorUtils::ContainsCid(instance_ranges, class_c.id()));
+  EXPECT(!CidRangeVectorUtils::ContainsCid(unknown_ranges, class_c.id()));
+  // Whether D is an A<int> depends on its type arguments.
+  EXPECT(!CidRangeVectorUtils::ContainsCid(instance_ranges, class_d.id()));
+  EXPECT(CidRangeVectorUtils::ContainsCid(unknown_ranges, class_d.id()));
+  // E is not a subclass of A.
+  EXPECT(!CidRangeVectorUtils::ContainsCid(instance_ranges, class_e.id()));
+  EXPECT(!CidRangeVectorUtils::ContainsCid(unknown_ranges, class_e.id()));
+}
+
 // This test verifies that double == Smi is recognized and
 // implemented using EqualityCompare.
 // Regression test for https://github.com/dart-lang/sdk/issues/47031.
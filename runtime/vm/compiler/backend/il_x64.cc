@@ -1757,11 +1757,15 @@ void Utf8ScanInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
 
   const Register bytes_ptr_reg = start_reg;
   const Register bytes_end_reg = end_reg;
-  const Register bytes_end_minus_16_reg = bytes_reg;
+  const Register bytes_end_minus_vector_reg = bytes_reg;
   const Register flags_reg = locs()->temp(0).reg();
   const Register temp_reg = TMP;
   const XmmRegister vector_reg = FpuTMP;
 
+  // With AVX2 the ASCII bytes are scanned using the full YMM register.
+  const bool use_avx2 = TargetCPUFeatures::avx2_supported();
+  const intptr_t kVectorSize = use_avx2 ? 32 : 16;
+
   const intptr_t kSizeMask = 0x03;
   const intptr_t kFlagsMask = 0x3C;
 
@@ -1771,10 +1775,11 @@ void Utf8ScanInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
   // Address of input bytes.
   __ LoadFromSlot(bytes_reg, bytes_reg, Slot::PointerBase_data());
 
-  // Pointers to start, end and end-16.
+  // Pointers to start, end and end-kVectorSize.
   __ leaq(bytes_ptr_reg, compiler::Address(bytes_reg, start_reg, TIMES_1, 0));
   __ leaq(bytes_end_reg, compiler::Address(bytes_reg, end_reg, TIMES_1, 0));
-  __ leaq(bytes_end_minus_16_reg, compiler::Address(bytes_end_reg, -16));
+  __ leaq(bytes_end_minus_vector_reg,
+          compiler::Address(bytes_end_reg, -kVectorSize));
 
   // Initialize size and flags.
   __ xorq(size_reg, size_reg);
@@ -1782,27 +1787,35 @@ void Utf8ScanInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
 
   __ jmp(&scan_ascii, compiler::Assembler::kNearJump);
 
-  // Loop scanning through ASCII bytes one 16-byte vector at a time.
+  // Loop scanning through ASCII bytes one vector at a time.
   // While scanning, the size register contains the size as it was at the start
   // of the current block of ASCII bytes, minus the address of the start of the
   // block. After the block, the end address of the block is added to update the
   // size to include the bytes in the block.
   __ Bind(&ascii_loop);
-  __ addq(bytes_ptr_reg, compiler::Immediate(16));
+  __ addq(bytes_ptr_reg, compiler::Immediate(kVectorSize));
   __ Bind(&ascii_loop_in);
 
-  // Exit vectorized loop when there are less than 16 bytes left.
-  __ cmpq(bytes_ptr_reg, bytes_end_minus_16_reg);
+  // Exit vectorized loop when there are less than kVectorSize bytes left.
+  __ cmpq(bytes_ptr_reg, bytes_end_minus_vector_reg);
   __ j(UNSIGNED_GREATER, &rest, compiler::Assembler::kNearJump);
 
-  // Find next non-ASCII byte within the next 16 bytes.
+  // Find next non-ASCII byte within the next kVectorSize bytes.
   // Note: In principle, we should use MOVDQU here, since the loaded value is
   // used as input to an integer instruction. In practice, according to Agner
   // Fog, there is no penalty for using the wrong kind of load.
-  __ movups(vector_reg, compiler::Address(bytes_ptr_reg, 0));
-  __ pmovmskb(temp_reg, vector_reg);
+  if (use_avx2) {
+    __ vmovdqu(vector_reg, compiler::Address(bytes_ptr_reg, 0));
+    __ vpmovmskb(temp_reg, vector_reg);
+  } else {
+    __ movups(vector_reg, compiler::Address(bytes_ptr_reg, 0));
+    __ pmovmskb(temp_reg, vector_reg);
+  }
   __ bsfq(temp_reg, temp_reg);
   __ j(EQUAL, &ascii_loop, compiler::Assembler::kNearJump);
+  if (use_avx2) {
+    __ vzeroupper();
+  }
 
   // Point to non-ASCII byte and update size.
   __ addq(bytes_ptr_reg, temp_reg);
@@ -1837,8 +1850,12 @@ void Utf8ScanInstr::EmitNativeCode(FlowGraphCompiler* compiler) {
   __ subq(size_reg, bytes_ptr_reg);
   __ jmp(&ascii_loop_in);
 
-  // Less than 16 bytes left. Process the remaining bytes individually.
+  // Less than kVectorSize bytes left. Process the remaining bytes
+  // individually.
   __ Bind(&rest);
+  if (use_avx2) {
+    __ vzeroupper();
+  }
 
   // Update size after ASCII scanning loop.
   __ addq(size_reg, bytes_ptr_reg);
@@ -3939,16 +3956,25 @@ LocationSummary* BoxInteger32Instr::MakeLocationSummary(Zone* zone,
 #else
   const bool kMayAllocateMint = !ValueFitsSmi();
 #endif
+  const bool shared_slow_path_call =
+      kMayAllocateMint && UseSharedSlowPathStub(opt);
   const intptr_t kNumInputs = 1;
   const intptr_t kNumTemps = kMayAllocateMint ? 1 : 0;
-  LocationSummary* summary = new (zone)
-      LocationSummary(zone, kNumInputs, kNumTemps,
-                      kMayAllocateMint ? LocationSummary::kCallOnSlowPath
-                                       : LocationSummary::kNoCall);
+  LocationSummary* summary = new (zone) LocationSummary(
+      zone, kNumInputs, kNumTemps,
+      !kMayAllocateMint       ? LocationSummary::kNoCall
+      : shared_slow_path_call ? LocationSummary::kCallOnSharedSlowPath
+                              : LocationSummary::kCallOnSlowPath);
   summary->set_in(0, Location::RequiresRegister());
-  summary->set_out(0, Location::RequiresRegister());
-  if (kMayAllocateMint) {
-    summary->set_temp(0, Location::RequiresRegister());
+  if (shared_slow_path_call) {
+    summary->set_out(0,
+                     Location::RegisterLocation(AllocateMintABI::kResultReg));
+    summary->set_temp(0, Location::RegisterLocation(AllocateMintABI::kTempReg));
+  } else {
+    summary->set_out(0, Location::RequiresRegister());
+    if (kMayAllocateMint) {
+      summary->set_temp(0, Location::RequiresRegister());
+    }
   }
   return summary;
 }
@@ -3991,8 +4017,7 @@ void BoxInteger32Instr::EmitNativeCode(FlowGraphCompiler* compiler) {
   // the type so it can be preserved untagged on the slow path
   locs()->live_registers()->Add(locs()->in(0), from_representation());
   const Register temp = locs()->temp(0).reg();
-  BoxAllocationSlowPath::Allocate(compiler, this, compiler->mint_class(), out,
-                                  temp);
+  BoxAllocationSlowPath::AllocateMint(compiler, this, out, temp);
   if (from_representation() == kUnboxedInt32) {
     __ movsxd(temp, value);  // Sign-extend.
   } else {
@@ -4007,19 +4032,7 @@ LocationSummary* BoxInt64Instr::MakeLocationSummary(Zone* zone,
                                                     bool opt) const {
   const intptr_t kNumInputs = 1;
   const intptr_t kNumTemps = ValueFitsSmi() ? 0 : 1;
-  // Shared slow path is used in BoxInt64Instr::EmitNativeCode in
-  // precompiled mode and only after VM isolate stubs where
-  // replaced with isolate-specific stubs.
-  auto object_store = IsolateGroup::Current()->object_store();
-  const bool stubs_in_vm_isolate =
-      object_store->allocate_mint_with_fpu_regs_stub()
-          ->untag()
-          ->InVMIsolateHeap() ||
-      object_store->allocate_mint_without_fpu_regs_stub()
-          ->untag()
-          ->InVMIsolateHeap();
-  const bool shared_slow_path_call =
-      SlowPathSharingSupported(opt) && !stubs_in_vm_isolate;
+  const bool shared_slow_path_call = UseSharedSlowPathStub(opt);
   LocationSummary* summary = new (zone) LocationSummary(
       zone, kNumInputs, kNumTemps,
       ValueFitsSmi()
@@ -4068,27 +4081,7 @@ void BoxInt64Instr::EmitNativeCode(FlowGraphCompiler* compiler) {
   __ j(BELOW, &done);
 #endif
 
-  if (compiler->intrinsic_mode()) {
-    __ TryAllocate(compiler->mint_class(),
-                   compiler->intrinsic_slow_path_label(),
-                   compiler::Assembler::kNearJump, out, temp);
-  } else if (locs()->call_on_shared_slow_path()) {
-    auto object_store = compiler->isolate_group()->object_store();
-    const bool live_fpu_regs = locs()->live_registers()->FpuRegisterCount() > 0;
-    const auto& stub = Code::ZoneHandle(
-        compiler->zone(),
-        live_fpu_regs ? object_store->allocate_mint_with_fpu_regs_stub()
-                      : object_store->allocate_mint_without_fpu_regs_stub());
-
-    ASSERT(!locs()->live_registers()->ContainsRegister(
-        AllocateMintABI::kResultReg));
-    auto extended_env = compiler->SlowPathEnvironmentFor(this, 0);
-    compiler->GenerateStubCall(source(), stub, UntaggedPcDescriptors::kOther,
-                               locs(), DeoptId::kNone, extended_env);
-  } else {
-    BoxAllocationSlowPath::Allocate(compiler, this, compiler->mint_class(), out,
-                                    temp);
-  }
+  BoxAllocationSlowPath::AllocateMint(compiler, this, out, temp);
 
   __ movq(compiler::FieldAddress(out, Mint::value_offset()), value);
   __ Bind(&done);
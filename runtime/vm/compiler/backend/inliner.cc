@@ -5,6 +5,7 @@
 #include "vm/compiler/backend/inliner.h"
 
 #include "vm/compiler/aot/aot_call_specializer.h"
+#include "vm/compiler/aot/aot_profile.h"
 #include "vm/compiler/aot/precompiler.h"
 #include "vm/compiler/backend/block_scheduler.h"
 #include "vm/compiler/backend/branch_optimizer.h"
@@ -70,6 +71,25 @@ DEFINE_FLAG(int,
             10,
             "Inline only hotter calls, in percents (0 .. 100); "
             "default 10%: calls above-equal 10% of max-count are inlined.");
+DEFINE_FLAG(int,
+            inlining_hot_call_count,
+            2000,
+            "Call sites executed at least this many times are hot and may "
+            "inline callees up to --inlining_hot_callee_size_threshold (JIT).");
+DEFINE_FLAG(int,
+            inlining_hot_callee_size_threshold,
+            400,
+            "Do not inline callees larger than threshold at hot call sites.");
+DEFINE_FLAG(int,
+            inlining_unboxed_args_callee_size_threshold,
+            80,
+            "Inline callees up to threshold that receive arguments which "
+            "would otherwise be boxed at the call (JIT).");
+DEFINE_FLAG(bool,
+            inlining_prioritize_hot_calls,
+            true,
+            "In JIT mode, inline the call sites found at each depth in the "
+            "order of decreasing call count per callee instruction.");
 DEFINE_FLAG(int,
             inlining_recursion_depth_threshold,
             1,
@@ -243,6 +263,25 @@ class GraphInfoCollector : public ValueObject {
   intptr_t instruction_count_;
 };
 
+// Hash map trait for the per-inliner cache of parsed callees.
+class ParsedFunctionKeyValueTrait {
+ public:
+  // Typedefs needed for the DirectChainedHashMap template.
+  typedef const Function* Key;
+  typedef ParsedFunction* Value;
+  typedef ParsedFunction* Pair;
+
+  static Key KeyOf(Pair kv) { return &kv->function(); }
+
+  static Value ValueOf(Pair kv) { return kv; }
+
+  static inline uword Hash(Key key) { return key->Hash(); }
+
+  static inline bool IsKeyEqual(Pair pair, Key key) {
+    return pair->function().ptr() == key->ptr();
+  }
+};
+
 // Structure for collecting inline data needed to print inlining tree.
 struct InlinedInfo {
   const Function* caller;
@@ -292,6 +331,8 @@ class CallSites : public ValueObject {
     intptr_t nesting_depth;
     intptr_t call_count;
     double ratio = 0.0;
+    // Estimated benefit of inlining this call per instruction of the callee.
+    double priority = 0.0;
 
     CallInfo(FlowGraph* caller_graph,
              CallType* call,
@@ -396,6 +437,16 @@ class CallSites : public ValueObject {
     ComputeCallRatio(*calls_, calls_start_ix, max_count);
   }
 
+  // Orders the call sites collected so far by decreasing priority, so that
+  // the inlining budget of the caller (--inlining_caller_size_threshold) is
+  // spent on the call sites executed most often per inlined instruction.
+  // The targets of closure calls are only resolved when inlining, so these
+  // keep their order.
+  void SortByPriority() {
+    SortByPriority(&static_calls_);
+    SortByPriority(&instance_calls_);
+  }
+
   static void RecordAllNotInlinedFunction(
       FlowGraph* graph,
       intptr_t depth,
@@ -428,6 +479,33 @@ class CallSites : public ValueObject {
     }
   }
 
+  static const Function& TargetOf(StaticCallInstr* call) {
+    return call->function();
+  }
+
+  static const Function& TargetOf(PolymorphicInstanceCallInstr* call) {
+    return call->targets().FirstTarget();
+  }
+
+  template <typename CallType>
+  static int CompareByPriority(const CallInfo<CallType>* a,
+                               const CallInfo<CallType>* b) {
+    if (a->priority == b->priority) return 0;
+    return (a->priority > b->priority) ? -1 : 1;
+  }
+
+  template <typename CallType>
+  static void SortByPriority(GrowableArray<CallInfo<CallType>>* calls) {
+    for (auto& info : *calls) {
+      // The size of callees which were not compiled yet is unknown; assume
+      // that they are just small enough to be inlined.
+      intptr_t cost = TargetOf(info.call).optimized_instruction_count();
+      if (cost == 0) cost = FLAG_inlining_size_threshold;
+      info.priority = static_cast<double>(info.call_count) / (cost + 1);
+    }
+    calls->Sort(CompareByPriority<CallType>);
+  }
+
   template <typename CallType>
   static void PruneRemovedCallsIn(GrowableArray<CallInfo<CallType>>* arr) {
     intptr_t j = 0;
@@ -748,6 +826,17 @@ struct InlinedCallData {
         exit_collector(nullptr),
         caller(caller) {}
 
+  // Whether the call site is executed often enough to inline larger callees
+  // (see --inlining_hot_call_count). AOT has no call counts, so calls of
+  // the hottest functions in the --aot_profile are hot instead.
+  bool IsHot(const Function& callee) const {
+    if (CompilerState::Current().is_aot()) {
+      const AotProfile* profile = AotProfile::Current();
+      return (profile != nullptr) && profile->IsHot(callee);
+    }
+    return call_count >= FLAG_inlining_hot_call_count;
+  }
+
   Definition* call;
   const Array& arguments_descriptor;
   const intptr_t first_arg_index;
@@ -756,6 +845,9 @@ struct InlinedCallData {
   ZoneGrowableArray<Definition*>* parameter_stubs;
   InlineExitCollector* exit_collector;
   const Function& caller;
+  // Number of times the call site (or the inlined target of a polymorphic
+  // call) was executed according to type feedback.
+  intptr_t call_count = 0;
 };
 
 class CallSiteInliner;
@@ -1041,14 +1133,22 @@ class CallSiteInliner : public ValueObject {
   // Inlining heuristics based on Cooper et al. 2008.
   InliningDecision ShouldWeInline(const Function& callee,
                                   intptr_t instr_count,
-                                  intptr_t call_site_count) {
+                                  intptr_t call_site_count,
+                                  bool is_hot_call_site,
+                                  intptr_t unboxed_arg_count) {
+    // Hot call sites may inline larger callees.
+    const intptr_t callee_size_threshold =
+        is_hot_call_site
+            ? Utils::Maximum(FLAG_inlining_callee_size_threshold,
+                             FLAG_inlining_hot_callee_size_threshold)
+            : FLAG_inlining_callee_size_threshold;
     // Pragma or size heuristics.
     if (inliner_->AlwaysInline(callee)) {
       return InliningDecision::Yes("AlwaysInline");
     } else if (inlined_size_ > FLAG_inlining_caller_size_threshold) {
       // Prevent caller methods becoming humongous and thus slow to compile.
       return InliningDecision::No("--inlining-caller-size-threshold");
-    } else if (instr_count > FLAG_inlining_callee_size_threshold) {
+    } else if (instr_count > callee_size_threshold) {
       // Prevent inlining of callee methods that exceed certain size.
       return InliningDecision::No("--inlining-callee-size-threshold");
     }
@@ -1068,6 +1168,15 @@ class CallSiteInliner : public ValueObject {
       return InliningDecision::Yes("--inlining-size-threshold");
     } else if (call_site_count <= FLAG_inlining_callee_call_sites_threshold) {
       return InliningDecision::Yes("--inlining-callee-call-sites-threshold");
+    } else if (is_hot_call_site) {
+      return InliningDecision::Yes("--inlining-hot-call-count");
+    } else if (unboxed_arg_count > 0 && !CompilerState::Current().is_aot() &&
+               (instr_count <=
+                FLAG_inlining_unboxed_args_callee_size_threshold)) {
+      // JIT calls pass all arguments boxed, so inlining a moderately sized
+      // callee lets double and int64 arguments stay unboxed.
+      return InliningDecision::Yes(
+          "--inlining-unboxed-args-callee-size-threshold");
     }
     return InliningDecision::No("default");
   }
@@ -1106,6 +1215,12 @@ class CallSiteInliner : public ValueObject {
       collected_call_sites_ = inlining_call_sites_;
       inlining_call_sites_ = call_sites_temp;
       collected_call_sites_->Clear();
+      // In AOT the call counts are only estimated from the loop depth, so
+      // keep the collection order there.
+      if (FLAG_inlining_prioritize_hot_calls &&
+          !CompilerState::Current().is_aot()) {
+        inlining_call_sites_->SortByPriority();
+      }
       // Inline call sites at the current depth.
       bool inlined_instance = InlineInstanceCalls();
       bool inlined_statics = InlineStaticCalls();
@@ -1202,6 +1317,17 @@ class CallSiteInliner : public ValueObject {
       return false;
     }
 
+    // Don't grow code which was never executed according to the
+    // --aot_profile.
+    if (CompilerState::Current().is_aot() &&
+        !inliner_->AlwaysInline(function) &&
+        BlockScheduler::IsNeverExecuted(call_data->call->GetBlock())) {
+      TRACE_INLINING(THR_Print("     Bailout: never executed\n"));
+      PRINT_INLINING_TREE("Never executed", &call_data->caller, &function,
+                          call_data->call);
+      return false;
+    }
+
     // Don't inline any intrinsified functions in precompiled mode
     // to reduce code size and make sure we use the intrinsic code.
     if (CompilerState::Current().is_aot() && function.is_intrinsic() &&
@@ -1252,8 +1378,10 @@ class CallSiteInliner : public ValueObject {
         constant_arg_count == 0 ? function.optimized_instruction_count() : 0;
     const intptr_t call_site_count =
         constant_arg_count == 0 ? function.optimized_call_site_count() : 0;
+    const intptr_t unboxed_arg_count = CountUnboxedArguments(*arguments);
     InliningDecision decision =
-        ShouldWeInline(function, instruction_count, call_site_count);
+        ShouldWeInline(function, instruction_count, call_site_count,
+                       call_data->IsHot(function), unboxed_arg_count);
     if (!decision.value) {
       TRACE_INLINING(
           THR_Print("     Bailout: early heuristics (%s) with "
@@ -1514,15 +1642,21 @@ class CallSiteInliner : public ValueObject {
         {
           COMPILER_TIMINGS_TIMER_SCOPE(thread(), MakeInliningDecision);
           InliningDecision decision =
-              ShouldWeInline(function, instruction_count, call_site_count);
+              ShouldWeInline(function, instruction_count, call_site_count,
+                             call_data->IsHot(function), unboxed_arg_count);
           if (!decision.value) {
             // If size is larger than all thresholds, don't consider it again.
+            // Hot call sites elsewhere may still inline it unless it is also
+            // too large for them.
 
             // TODO(dartbug.com/49665): Make compiler smart enough so it itself
             // can identify highly-specialized functions that should always
             // be considered for inlining, without relying on a pragma.
             if ((instruction_count > FLAG_inlining_size_threshold) &&
-                (call_site_count > FLAG_inlining_callee_call_sites_threshold)) {
+                (call_site_count > FLAG_inlining_callee_call_sites_threshold) &&
+                (CompilerState::Current().is_aot() ||
+                 (instruction_count >
+                  FLAG_inlining_hot_callee_size_threshold))) {
               // Will keep trying to inline the function if it can be
               // specialized based on argument types.
               if (!FlowGraphInliner::FunctionHasAlwaysConsiderInliningPragma(
@@ -1578,7 +1712,7 @@ class CallSiteInliner : public ValueObject {
 
         // Add the function to the cache.
         if (!in_cache) {
-          function_cache_.Add(parsed_function);
+          function_cache_.Insert(parsed_function);
         }
 
         // Build succeeded so we restore the bailout jump.
@@ -1750,15 +1884,27 @@ class CallSiteInliner : public ValueObject {
     return count;
   }
 
+  // Counts arguments that are known to be doubles or non-Smi integers and so
+  // would be boxed when passed to a non-inlined callee.
+  static intptr_t CountUnboxedArguments(
+      const GrowableArray<Value*>& arguments) {
+    intptr_t count = 0;
+    for (intptr_t i = 0; i < arguments.length(); i++) {
+      if (arguments[i]->BindsToConstant()) continue;
+      CompileType* type = arguments[i]->Type();
+      if (type->IsDouble() || (type->IsInt() && !type->IsNullableSmi())) {
+        count++;
+      }
+    }
+    return count;
+  }
+
   // Parse a function reusing the cache if possible.
   ParsedFunction* GetParsedFunction(const Function& function, bool* in_cache) {
-    // TODO(zerny): Use a hash map for the cache.
-    for (intptr_t i = 0; i < function_cache_.length(); ++i) {
-      ParsedFunction* parsed_function = function_cache_[i];
-      if (parsed_function->function().ptr() == function.ptr()) {
-        *in_cache = true;
-        return parsed_function;
-      }
+    ParsedFunction* cached = function_cache_.LookupValue(&function);
+    if (cached != nullptr) {
+      *in_cache = true;
+      return cached;
     }
     *in_cache = false;
     ParsedFunction* parsed_function =
@@ -1801,6 +1947,7 @@ class CallSiteInliner : public ValueObject {
       InlinedCallData call_data(
           call, Array::ZoneHandle(Z, call->GetArgumentsDescriptor()),
           call->FirstArgIndex(), &arguments, call_info[call_idx].caller());
+      call_data.call_count = call_info[call_idx].call_count;
 
       // Under AOT, calls outside loops may pass our regular heuristics due
       // to a relatively high ratio. So, unless we are optimizing solely for
@@ -1809,6 +1956,7 @@ class CallSiteInliner : public ValueObject {
       bool stricter_heuristic = CompilerState::Current().is_aot() &&
                                 FLAG_optimization_level <= 2 &&
                                 !inliner_->AlwaysInline(target) &&
+                                !call_data.IsHot(target) &&
                                 call_info[call_idx].nesting_depth == 0;
       if (TryInlining(call->function(), call->argument_names(), &call_data,
                       stricter_heuristic)) {
@@ -1865,6 +2013,7 @@ class CallSiteInliner : public ValueObject {
       InlinedCallData call_data(call, arguments_descriptor,
                                 call->FirstArgIndex(), &arguments,
                                 call_info[call_idx].caller());
+      call_data.call_count = call_info[call_idx].call_count;
       if (TryInlining(target, call->argument_names(), &call_data, false)) {
         InlineCall(&call_data);
         inlined = true;
@@ -2004,7 +2153,7 @@ class CallSiteInliner : public ValueObject {
   intptr_t inlining_depth_threshold_;
   CallSites* collected_call_sites_;
   CallSites* inlining_call_sites_;
-  GrowableArray<ParsedFunction*> function_cache_;
+  DirectChainedHashMap<ParsedFunctionKeyValueTrait> function_cache_;
   GrowableArray<InlinedInfo> inlined_info_;
 
   DISALLOW_COPY_AND_ASSIGN(CallSiteInliner);
@@ -2128,6 +2277,7 @@ bool PolymorphicInliner::TryInliningPoly(const TargetInfo& target_info) {
       Array::ZoneHandle(Z, call_->GetArgumentsDescriptor());
   InlinedCallData call_data(call_, arguments_descriptor, call_->FirstArgIndex(),
                             &arguments, caller_function_);
+  call_data.call_count = target_info.count;
   Function& target = Function::ZoneHandle(zone(), target_info.target->ptr());
   if (!owner_->TryInlining(target, call_->argument_names(), &call_data,
                            false)) {
@@ -2727,6 +2877,19 @@ static bool CanUnboxDouble() {
 #undef Z
 #define Z (flow_graph->zone())
 
+// Returns false if a bounds check inlined for [call] already deoptimized
+// the function, so that the next version doesn't fail the same way.
+static bool ShouldSpeculateOnBoundsCheck(Instruction* call) {
+  const ICData* ic_data = nullptr;
+  if (auto* instance_call = call->AsInstanceCallBase()) {
+    ic_data = instance_call->ic_data();
+  } else if (auto* static_call = call->AsStaticCall()) {
+    ic_data = static_call->ic_data();
+  }
+  return (ic_data == nullptr) || ic_data->IsNull() ||
+         !ic_data->HasDeoptReason(ICData::kDeoptCheckArrayBound);
+}
+
 static bool InlineTypedDataIndexCheck(FlowGraph* flow_graph,
                                       Instruction* call,
                                       Definition* receiver,
@@ -2755,7 +2918,8 @@ static bool InlineTypedDataIndexCheck(FlowGraph* flow_graph,
     cursor = flow_graph->AppendTo(cursor, null_check, call->env(),
                                   FlowGraph::kEffect);
   }
-  index = flow_graph->CreateCheckBound(length, index, call->deopt_id());
+  index = flow_graph->CreateCheckBound(length, index, call->deopt_id(),
+                                       ShouldSpeculateOnBoundsCheck(call));
   cursor = flow_graph->AppendTo(cursor, index, call->env(), FlowGraph::kValue);
 
   *last = cursor;
@@ -2784,7 +2948,8 @@ static intptr_t PrepareInlineIndexedOp(FlowGraph* flow_graph,
     *cursor = flow_graph->AppendTo(*cursor, null_check, call->env(),
                                    FlowGraph::kEffect);
   }
-  *index = flow_graph->CreateCheckBound(length, *index, call->deopt_id());
+  *index = flow_graph->CreateCheckBound(length, *index, call->deopt_id(),
+                                        ShouldSpeculateOnBoundsCheck(call));
   *cursor =
       flow_graph->AppendTo(*cursor, *index, call->env(), FlowGraph::kValue);
 
@@ -3118,7 +3283,8 @@ static Definition* PrepareInlineStringIndexOp(FlowGraph* flow_graph,
     cursor = flow_graph->AppendTo(cursor, null_check, call->env(),
                                   FlowGraph::kEffect);
   }
-  index = flow_graph->CreateCheckBound(length, index, call->deopt_id());
+  index = flow_graph->CreateCheckBound(length, index, call->deopt_id(),
+                                       ShouldSpeculateOnBoundsCheck(call));
   cursor = flow_graph->AppendTo(cursor, index, call->env(), FlowGraph::kValue);
 
   LoadIndexedInstr* load_indexed = new (Z) LoadIndexedInstr(
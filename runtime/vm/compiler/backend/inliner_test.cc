@@ -14,6 +14,13 @@
 
 namespace dart {
 
+DECLARE_FLAG(int, inlining_callee_call_sites_threshold);
+DECLARE_FLAG(int, inlining_callee_size_threshold);
+DECLARE_FLAG(int, inlining_hot_call_count);
+DECLARE_FLAG(int, inlining_hot_callee_size_threshold);
+DECLARE_FLAG(int, inlining_size_threshold);
+DECLARE_FLAG(int, inlining_unboxed_args_callee_size_threshold);
+
 // Test that the redefinition for an inlined polymorphic function used with
 // multiple receiver cids does not have a concrete type.
 ISOLATE_UNIT_TEST_CASE(Inliner_PolyInliningRedefinition) {
@@ -667,4 +674,200 @@ void main() {
   EXPECT_EQ(epilogue_count * 2, prologue_count);
 }
 
+static bool HasStaticCallTo(FlowGraph* flow_graph, const char* name) {
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    for (ForwardInstructionIterator it(block_it.Current()); !it.Done();
+         it.Advance()) {
+      if (auto call = it.Current()->AsStaticCall()) {
+        if (strcmp(call->function().UserVisibleNameCString(), name) == 0) {
+          return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+
+// Verifies that callees which are too large for the regular size thresholds
+// are still inlined into call sites which are executed often enough.
+ISOLATE_UNIT_TEST_CASE(Inliner_HotCallSite) {
+  const char* kScript = R"(
+    @pragma('vm:never-inline')
+    int sideEffect(int x) => x;
+
+    int callee(int x) => sideEffect(x) + sideEffect(x + 1);
+
+    int caller(int n) {
+      int sum = 0;
+      for (int i = 0; i < n; i++) {
+        sum += callee(i);
+      }
+      return sum;
+    }
+
+    main() => caller(3000);
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  const auto& function = Function::Handle(GetFunction(root_library, "caller"));
+  Invoke(root_library, "main");
+
+  // Make [callee] too large to be inlined by the regular heuristics.
+  SetFlagScope<int> sfs1(&FLAG_inlining_size_threshold, 1);
+  SetFlagScope<int> sfs2(&FLAG_inlining_callee_size_threshold, 1);
+  SetFlagScope<int> sfs3(&FLAG_inlining_callee_call_sites_threshold, 0);
+  SetFlagScope<int> sfs4(&FLAG_inlining_hot_callee_size_threshold, 1000);
+
+  {
+    SetFlagScope<int> sfs(&FLAG_inlining_hot_call_count, kMaxInt32);
+    TestPipeline pipeline(function, CompilerPass::kJIT);
+    FlowGraph* flow_graph = pipeline.RunPasses({});
+    EXPECT(HasStaticCallTo(flow_graph, "callee"));
+  }
+
+  {
+    SetFlagScope<int> sfs(&FLAG_inlining_hot_call_count, 1000);
+    TestPipeline pipeline(function, CompilerPass::kJIT);
+    FlowGraph* flow_graph = pipeline.RunPasses({});
+    EXPECT(!HasStaticCallTo(flow_graph, "callee"));
+    EXPECT(HasStaticCallTo(flow_graph, "sideEffect"));
+  }
+}
+
+// Checks that [callee], which receives an unboxed argument from [caller], is
+// inlined exactly up to --inlining_unboxed_args_callee_size_threshold.
+static void TestUnboxedArgsCalleeSizeThreshold(const Library& root_library,
+                                               const char* caller_name,
+                                               const char* callee_name) {
+  const auto& caller =
+      Function::Handle(GetFunction(root_library, caller_name));
+  const auto& callee =
+      Function::Handle(GetFunction(root_library, callee_name));
+
+  // Make [callee] too large to be inlined by the other heuristics.
+  SetFlagScope<int> sfs1(&FLAG_inlining_size_threshold, 1);
+  SetFlagScope<int> sfs2(&FLAG_inlining_callee_call_sites_threshold, 0);
+  SetFlagScope<int> sfs3(&FLAG_inlining_hot_call_count, kMaxInt32);
+
+  {
+    SetFlagScope<int> sfs(&FLAG_inlining_unboxed_args_callee_size_threshold,
+                          0);
+    TestPipeline pipeline(caller, CompilerPass::kJIT);
+    FlowGraph* flow_graph = pipeline.RunPasses({});
+    EXPECT(HasStaticCallTo(flow_graph, callee_name));
+  }
+
+  // The size of [callee] is recorded when it is first considered.
+  const intptr_t callee_size = callee.optimized_instruction_count();
+  EXPECT(callee_size > 1);
+
+  {
+    SetFlagScope<int> sfs(&FLAG_inlining_unboxed_args_callee_size_threshold,
+                          callee_size);
+    TestPipeline pipeline(caller, CompilerPass::kJIT);
+    FlowGraph* flow_graph = pipeline.RunPasses({});
+    EXPECT(!HasStaticCallTo(flow_graph, callee_name));
+  }
+
+  {
+    SetFlagScope<int> sfs(&FLAG_inlining_unboxed_args_callee_size_threshold,
+                          callee_size - 1);
+    TestPipeline pipeline(caller, CompilerPass::kJIT);
+    FlowGraph* flow_graph = pipeline.RunPasses({});
+    EXPECT(HasStaticCallTo(flow_graph, callee_name));
+  }
+}
+
+ISOLATE_UNIT_TEST_CASE(Inliner_UnboxedArgsCalleeSizeThreshold) {
+  const char* kScript = R"(
+    @pragma('vm:never-inline')
+    double sinkDouble(double x) => x;
+
+    @pragma('vm:never-inline')
+    int sinkInt(int x) => x;
+
+    double scaleDouble(double x) => sinkDouble(x * 1.5) + sinkDouble(x - 0.5);
+
+    int scaleInt(int x) => sinkInt(x * 3) + sinkInt(x - 1);
+
+    double callerDouble(double v) => scaleDouble(v * 2.0);
+
+    int callerInt(int v) => scaleInt(v * 0x100000000);
+
+    main() {
+      for (int i = 0; i < 10; i++) {
+        callerDouble(i.toDouble());
+        callerInt(i);
+      }
+    }
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  Invoke(root_library, "main");
+
+  TestUnboxedArgsCalleeSizeThreshold(root_library, "callerDouble",
+                                     "scaleDouble");
+  TestUnboxedArgsCalleeSizeThreshold(root_library, "callerInt", "scaleInt");
+}
+
+static intptr_t CountInstructions(FlowGraph* flow_graph,
+                                  bool (*predicate)(Instruction*)) {
+  intptr_t count = 0;
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    for (ForwardInstructionIterator it(block_it.Current()); !it.Done();
+         it.Advance()) {
+      if (predicate(it.Current())) {
+        count++;
+      }
+    }
+  }
+  return count;
+}
+
+ISOLATE_UNIT_TEST_CASE(Inliner_DeoptimizedBoundsCheck) {
+  const char* kScript = R"(
+    int foo(List<int> list, int i) => list[i];
+
+    main() => foo(List<int>.filled(3, 1), 2);
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  const auto& function = Function::Handle(GetFunction(root_library, "foo"));
+  Invoke(root_library, "main");
+
+  auto is_check_array_bound = [](Instruction* instr) {
+    return instr->IsCheckArrayBound();
+  };
+  auto is_generic_check_bound = [](Instruction* instr) {
+    return instr->IsGenericCheckBound();
+  };
+
+  {
+    TestPipeline pipeline(function, CompilerPass::kJIT);
+    FlowGraph* flow_graph = pipeline.RunPasses({});
+    EXPECT_EQ(1, CountInstructions(flow_graph, is_check_array_bound));
+    EXPECT_EQ(0, CountInstructions(flow_graph, is_generic_check_bound));
+  }
+
+  // Pretend that the bounds check of the inlined [] deoptimized.
+  const auto& ic_data_array = Array::Handle(function.ic_data_array());
+  auto& ic_data = ICData::Handle();
+  for (intptr_t i = Function::ICDataArrayIndices::kFirstICData;
+       i < ic_data_array.Length(); i++) {
+    ic_data ^= ic_data_array.At(i);
+    if (String::Handle(ic_data.target_name()).Equals("[]")) {
+      ic_data.AddDeoptReason(ICData::kDeoptCheckArrayBound);
+    }
+  }
+
+  {
+    TestPipeline pipeline(function, CompilerPass::kJIT);
+    FlowGraph* flow_graph = pipeline.RunPasses({});
+    EXPECT_EQ(0, CountInstructions(flow_graph, is_check_array_bound));
+    EXPECT_EQ(1, CountInstructions(flow_graph, is_generic_check_bound));
+  }
+}
+
 }  // namespace dart
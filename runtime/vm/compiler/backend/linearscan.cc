@@ -17,6 +17,12 @@
 
 namespace dart {
 
+DEFINE_FLAG(bool,
+            thorough_register_allocation,
+            false,
+            "Use the thorough register allocation mode for all functions "
+            "compiled in AOT mode.");
+
 #if !defined(PRODUCT)
 #define INCLUDE_LINEAR_SCAN_TRACING_CODE
 #endif
@@ -115,7 +121,10 @@ FlowGraphAllocator::FlowGraphAllocator(const FlowGraph& flow_graph,
       quad_spill_slots_(),
       untagged_spill_slots_(),
       cpu_spill_slot_count_(0),
-      intrinsic_mode_(intrinsic_mode) {
+      intrinsic_mode_(intrinsic_mode),
+      thorough_(!intrinsic_mode &&
+                ShouldAllocateThoroughly(flow_graph.function())),
+      back_edge_phi_hints_() {
   for (intptr_t i = 0; i < vreg_count_; i++) {
     live_ranges_.Add(nullptr);
   }
@@ -2340,6 +2349,12 @@ bool FlowGraphAllocator::AllocateFreeRegister(LiveRange* unallocated) {
     }
   }
 
+  // In thorough mode try to coalesce values flowing into loop phis on the
+  // back edge with the phi to avoid moves on the back edge.
+  if (thorough_ && !hint.IsMachineRegister() && unallocated->vreg() >= 0) {
+    hint = BackEdgePhiHint(unallocated);
+  }
+
   if (hint.IsMachineRegister()) {
     if (!blocked_registers_[hint.register_code()]) {
       free_until =
@@ -2558,6 +2573,31 @@ void FlowGraphAllocator::AllocateAnyRegister(LiveRange* unallocated) {
 
   ASSERT(candidate != kNoRegister);
 
+  // In thorough mode prefer evicting constants, which don't need a spill
+  // slot store or a reload from memory, as long as the register stays
+  // available until the register use.
+  if (thorough_ &&
+      !IsRematerializableRegister(candidate, unallocated->Start())) {
+    for (intptr_t i = 0; i < NumberOfRegisters(); ++i) {
+      intptr_t reg = (i + kRegisterAllocationBias) % NumberOfRegisters();
+      if (blocked_registers_[reg] || (reg == candidate) ||
+          !IsRematerializableRegister(reg, unallocated->Start())) {
+        continue;
+      }
+      intptr_t reg_free_until = register_use_pos - 1;
+      intptr_t reg_blocked_at = kMaxPosition;
+      if (UpdateFreeUntil(reg, unallocated, &reg_free_until,
+                          &reg_blocked_at)) {
+        TRACE_ALLOC(THR_Print("evicting constants from %s instead of %s\n",
+                              MakeRegisterLocation(reg).Name(),
+                              MakeRegisterLocation(candidate).Name()));
+        candidate = reg;
+        blocked_at = reg_blocked_at;
+        break;
+      }
+    }
+  }
+
   TRACE_ALLOC(THR_Print("assigning blocked register "));
   TRACE_ALLOC(MakeRegisterLocation(candidate).Print());
   TRACE_ALLOC(THR_Print(" to live range v%" Pd " until %" Pd "\n",
@@ -2637,6 +2677,21 @@ void FlowGraphAllocator::RemoveEvicted(intptr_t reg, intptr_t first_evicted) {
   registers_[reg]->TruncateTo(to);
 }
 
+bool FlowGraphAllocator::IsRematerializableRegister(intptr_t reg,
+                                                    intptr_t pos) {
+  for (intptr_t i = 0; i < registers_[reg]->length(); i++) {
+    LiveRange* allocated = (*registers_[reg])[i];
+    if (!allocated->finger()->first_pending_use_interval()->Contains(pos)) {
+      continue;
+    }
+    if ((allocated->vreg() < 0) ||
+        !GetLiveRange(allocated->vreg())->spill_slot().IsConstant()) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void FlowGraphAllocator::AssignNonFreeRegister(LiveRange* unallocated,
                                                intptr_t reg) {
   intptr_t first_evicted = -1;
@@ -3401,6 +3456,51 @@ void FlowGraphAllocator::ScheduleParallelMoves() {
   }
 }
 
+bool FlowGraphAllocator::ShouldAllocateThoroughly(const Function& function) {
+  if (!CompilerState::Current().is_aot()) {
+    return false;
+  }
+  if (FLAG_thorough_register_allocation) {
+    return true;
+  }
+  Object& options = Object::Handle();
+  return Library::FindPragma(Thread::Current(), /*only_core=*/false, function,
+                             Symbols::vm_thorough_register_allocation(),
+                             /*multiple=*/false, &options);
+}
+
+void FlowGraphAllocator::CollectBackEdgePhiHints() {
+  for (intptr_t i = 0; i < vreg_count_; i++) {
+    back_edge_phi_hints_.Add(kNoVirtualRegister);
+  }
+  for (auto block : block_order_) {
+    JoinEntryInstr* join = block->AsJoinEntry();
+    if ((join == nullptr) || !join->IsLoopHeader()) continue;
+    LoopInfo* loop_info = join->loop_info();
+    for (PhiIterator it(join); !it.Done(); it.Advance()) {
+      PhiInstr* phi = it.Current();
+      for (intptr_t j = 0; j < phi->InputCount(); j++) {
+        if (!loop_info->IsBackEdge(join->PredecessorAt(j))) continue;
+        Definition* input = phi->InputAt(j)->definition();
+        if (!loop_info->Contains(input->GetBlock())) continue;
+        back_edge_phi_hints_[input->vreg(0)] = phi->vreg(0);
+        if (phi->HasPairRepresentation()) {
+          back_edge_phi_hints_[input->vreg(1)] = phi->vreg(1);
+        }
+      }
+    }
+  }
+}
+
+Location FlowGraphAllocator::BackEdgePhiHint(LiveRange* unallocated) {
+  const intptr_t phi_vreg = back_edge_phi_hints_[unallocated->vreg()];
+  if (phi_vreg == kNoVirtualRegister) {
+    return Location();
+  }
+  const Location loc = GetLiveRange(phi_vreg)->assigned_location();
+  return (loc.kind() == register_kind_) ? loc : Location();
+}
+
 void FlowGraphAllocator::AllocateRegisters() {
   CollectRepresentations();
 
@@ -3417,6 +3517,10 @@ void FlowGraphAllocator::AllocateRegisters() {
   // Update stackmaps after all safepoints are collected.
   UpdateStackmapsForSuspendState();
 
+  if (thorough_) {
+    CollectBackEdgePhiHints();
+  }
+
   if (FLAG_print_ssa_liveranges && CompilerState::ShouldTrace()) {
     const Function& function = flow_graph_.function();
     THR_Print("-- [before ssa allocator] ranges [%s] ---------\n",
@@ -63,6 +63,17 @@ class FlowGraphAllocator : public ValueObject {
 
   void AllocateRegisters();
 
+  // Returns true if [function] should be allocated in the thorough mode,
+  // which spends more compile time on avoiding moves and memory traffic:
+  // values flowing into loop phis on the back edge are hinted to the phi's
+  // register and registers holding constants are evicted first, because
+  // constants are rematerialized instead of spilled.
+  //
+  // Thorough mode is only used in AOT, for functions annotated with
+  // @pragma('vm:thorough-register-allocation') or for all functions
+  // when --thorough_register_allocation is passed.
+  static bool ShouldAllocateThoroughly(const Function& function);
+
   // Map a virtual register number to its live range.
   LiveRange* GetLiveRange(intptr_t vreg);
 
@@ -227,6 +238,19 @@ class FlowGraphAllocator : public ValueObject {
   // parts of interfering live ranges.  Place non-spilled parts into
   // the list of unallocated ranges.
   void AssignNonFreeRegister(LiveRange* unallocated, intptr_t reg);
+
+  // Returns true if all ranges active at [pos] in the given register
+  // hold constants, which are cheap to evict because they are
+  // rematerialized instead of being reloaded from a spill slot.
+  bool IsRematerializableRegister(intptr_t reg, intptr_t pos);
+
+  // In thorough mode, records for all values defined in a loop which flow
+  // into a phi of its header on the back edge the phi they flow into.
+  void CollectBackEdgePhiHints();
+
+  // Returns the register assigned to the loop phi the given range flows
+  // into on the back edge, or an invalid location.
+  Location BackEdgePhiHint(LiveRange* unallocated);
   bool EvictIntersection(LiveRange* allocated, LiveRange* unallocated);
   void RemoveEvicted(intptr_t reg, intptr_t first_evicted);
 
@@ -374,6 +398,12 @@ class FlowGraphAllocator : public ValueObject {
 
   const bool intrinsic_mode_;
 
+  const bool thorough_;
+
+  // Maps virtual registers to the virtual register of the loop phi they
+  // flow into on the back edge (see CollectBackEdgePhiHints).
+  GrowableArray<intptr_t> back_edge_phi_hints_;
+
   DISALLOW_COPY_AND_ASSIGN(FlowGraphAllocator);
 };
 
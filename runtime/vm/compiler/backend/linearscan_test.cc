@@ -0,0 +1,85 @@
+// Copyright (c) 2024, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/backend/linearscan.h"
+
+#include "vm/compiler/backend/il.h"
+#include "vm/compiler/backend/il_test_helper.h"
+#include "vm/compiler/backend/loops.h"
+#include "vm/compiler/compiler_pass.h"
+#include "vm/compiler/compiler_state.h"
+#include "vm/flags.h"
+#include "vm/object.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+DECLARE_FLAG(bool, thorough_register_allocation);
+
+static intptr_t CountMoves(ParallelMoveInstr* parallel_move) {
+  return (parallel_move != nullptr) ? parallel_move->NumMoves() : 0;
+}
+
+// Counts moves emitted on the back edges of the loops in [flow_graph].
+static intptr_t CountBackEdgeMoves(FlowGraph* flow_graph) {
+  intptr_t moves = 0;
+  for (auto block : flow_graph->reverse_postorder()) {
+    GotoInstr* goto_instr = block->last_instruction()->AsGoto();
+    if ((goto_instr == nullptr) || (block->loop_info() == nullptr) ||
+        !block->loop_info()->IsBackEdge(block)) {
+      continue;
+    }
+    moves += CountMoves(goto_instr->parallel_move());
+  }
+  return moves;
+}
+
+ISOLATE_UNIT_TEST_CASE(RegisterAllocation_ThoroughPragma) {
+  const char* kScript = R"(
+    @pragma('vm:thorough-register-allocation')
+    int foo(int n) {
+      int a = 0;
+      int b = 1;
+      for (int i = 0; i < n; i++) {
+        final t = (a + b) & 0xFFFF;
+        a = b;
+        b = t;
+      }
+      return a;
+    }
+
+    int bar(int n) => foo(n);
+
+    main() => foo(10);
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  const auto& foo = Function::Handle(GetFunction(root_library, "foo"));
+  const auto& bar = Function::Handle(GetFunction(root_library, "bar"));
+
+  intptr_t default_moves = 0;
+  {
+    SetFlagScope<bool> sfs(&FLAG_thorough_register_allocation, false);
+    TestPipeline pipeline(foo, CompilerPass::kAOT);
+    FlowGraph* flow_graph = pipeline.RunPasses({});
+    EXPECT(FlowGraphAllocator::ShouldAllocateThoroughly(foo));
+    EXPECT(!FlowGraphAllocator::ShouldAllocateThoroughly(bar));
+    default_moves = CountBackEdgeMoves(flow_graph);
+  }
+
+  // Hinting the values flowing into the loop phis to the phi registers
+  // doesn't add moves on the back edge.
+  SetFlagScope<bool> sfs(&FLAG_thorough_register_allocation, true);
+  TestPipeline pipeline(foo, CompilerPass::kAOT);
+  FlowGraph* flow_graph = pipeline.RunPasses({});
+  EXPECT(FlowGraphAllocator::ShouldAllocateThoroughly(bar));
+  EXPECT(CountBackEdgeMoves(flow_graph) <= default_moves);
+
+  pipeline.CompileGraphAndAttachFunction();
+  const auto& result = Object::Handle(Invoke(root_library, "main"));
+  EXPECT(result.IsSmi());
+  EXPECT_EQ(55, Smi::Cast(result).Value());
+}
+
+}  // namespace dart
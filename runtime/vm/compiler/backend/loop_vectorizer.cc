@@ -0,0 +1,550 @@
+// Copyright (c) 2024, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/backend/loop_vectorizer.h"
+
+#include "vm/compiler/backend/flow_graph.h"
+#include "vm/compiler/backend/flow_graph_compiler.h"
+#include "vm/compiler/backend/il.h"
+#include "vm/compiler/backend/loops.h"
+#include "vm/flags.h"
+
+namespace dart {
+
+DEFINE_FLAG(bool,
+            loop_vectorization,
+            false,
+            "Vectorize simple loops over Float64List elements.");
+
+#if defined(TARGET_ARCH_X64) || defined(TARGET_ARCH_ARM64)
+
+// Upper bound on the number of element-wise operations in a
+// vectorized loop body.
+static constexpr intptr_t kMaxVectorOperations = 32;
+
+// A loop accepted for vectorization, together with everything the
+// rewrite needs to know about it.
+class VectorLoop : public ZoneAllocated {
+ public:
+  explicit VectorLoop(Zone* zone)
+      : arrays(zone, 2),
+        lengths(zone, 2),
+        operations(zone, 4),
+        invariants(zone, 2) {}
+
+  JoinEntryInstr* header = nullptr;
+  TargetEntryInstr* body = nullptr;
+  BlockEntryInstr* preheader = nullptr;
+  PhiInstr* phi = nullptr;
+  Definition* initial = nullptr;
+  Definition* next = nullptr;
+  Definition* limit = nullptr;
+
+  // Distinct arrays accessed in the body.
+  GrowableArray<Definition*> arrays;
+  // Lengths of bounds checks in the body other than the array lengths.
+  GrowableArray<Definition*> lengths;
+  // Loads, arithmetic and the final store of the body, in order.
+  GrowableArray<Instruction*> operations;
+  // Loop invariant doubles used by the arithmetic.
+  GrowableArray<Definition*> invariants;
+
+  // Blocks created by the rewrite and the definitions flowing into the new
+  // join from the vector and the scalar path.
+  TargetEntryInstr* vector_entry = nullptr;
+  JoinEntryInstr* join = nullptr;
+  Definition* vector_next = nullptr;
+};
+
+static bool IsInvariant(LoopInfo* loop, Definition* def) {
+  return !loop->Contains(def->GetBlock());
+}
+
+static bool IsArrayLength(Definition* length, Definition* array) {
+  LoadFieldInstr* load = length->AsLoadField();
+  return (load != nullptr) &&
+         (&load->slot() == &Slot::TypedDataBase_length()) &&
+         (load->instance()->definition()->OriginalDefinition() ==
+          array->OriginalDefinition());
+}
+
+static bool Includes(const GrowableArray<Definition*>& defs, Definition* def) {
+  for (intptr_t i = 0; i < defs.length(); i++) {
+    if (defs[i] == def) return true;
+  }
+  return false;
+}
+
+// Returns true if [use] refers to an element-wise operation already accepted
+// in the body or to a loop invariant double, which will be splatted.
+static bool AcceptOperand(LoopInfo* loop, VectorLoop* vloop, Value* use) {
+  Definition* def = use->definition();
+  for (intptr_t i = 0; i < vloop->operations.length(); i++) {
+    if (vloop->operations[i] == def) return true;
+  }
+  if (IsInvariant(loop, def) && (def->representation() == kUnboxedDouble)) {
+    if (!Includes(vloop->invariants, def)) {
+      vloop->invariants.Add(def);
+    }
+    return true;
+  }
+  return false;
+}
+
+// Returns true if the indexed access at [instr] can be widened to load or
+// store two consecutive elements.
+template <typename T>
+static bool AcceptIndexedAccess(LoopInfo* loop, VectorLoop* vloop, T* instr) {
+  if ((instr->class_id() != kTypedDataFloat64ArrayCid) ||
+      (instr->index()->definition()->OriginalDefinition() != vloop->phi) ||
+      (instr->RequiredInputRepresentation(T::kIndexPos) !=
+       vloop->phi->representation())) {
+    return false;
+  }
+  Definition* array = instr->array()->definition();
+  if ((array->representation() != kTagged) || !IsInvariant(loop, array)) {
+    return false;
+  }
+  if (!Includes(vloop->arrays, array)) {
+    vloop->arrays.Add(array);
+  }
+  return true;
+}
+
+// Returns true if [next] is the increment of the induction [phi] by one.
+static bool IsUnitIncrement(PhiInstr* phi, Definition* next) {
+  BinaryIntegerOpInstr* add = next->AsBinaryIntegerOp();
+  return (add != nullptr) && (add->op_kind() == Token::kADD) &&
+         (add->representation() == phi->representation()) &&
+         (add->left()->definition() == phi) &&
+         add->right()->BindsToSmiConstant() &&
+         (add->right()->BoundSmiConstant() == 1);
+}
+
+// Finds the loop limit U of the looping condition i < U as a tagged Smi
+// which is available in the preheader.
+static Definition* FindLimit(FlowGraph* flow_graph,
+                             LoopInfo* loop,
+                             InductionVar* induction,
+                             BranchInstr* branch) {
+  for (auto bound : induction->bounds()) {
+    if (bound.branch_ != branch) continue;
+    InductionVar* limit = bound.limit_;
+    int64_t value = 0;
+    if (InductionVar::IsConstant(limit, &value)) {
+      if ((value < 0) || !Smi::IsValid(value)) return nullptr;
+      return flow_graph->GetConstant(
+          Smi::ZoneHandle(flow_graph->zone(), Smi::New(value)));
+    }
+    if (!InductionVar::IsInvariant(limit) || (limit->offset() != 0) ||
+        (limit->mult() != 1)) {
+      return nullptr;
+    }
+    Definition* def = limit->def();
+    if ((def->representation() != kTagged) ||
+        (def->Type()->ToCid() != kSmiCid) || !IsInvariant(loop, def)) {
+      return nullptr;
+    }
+    return def;
+  }
+  return nullptr;
+}
+
+// Only instructions which may be skipped on every other iteration are
+// allowed in the header.
+static bool IsHeaderVectorizable(JoinEntryInstr* header) {
+  for (ForwardInstructionIterator it(header); !it.Done(); it.Advance()) {
+    Instruction* instr = it.Current();
+    if (instr->IsCheckStackOverflow() || instr->IsBranch()) continue;
+    if ((instr->IsBox() || instr->IsUnbox() || instr->IsIntConverter()) &&
+        !instr->CanDeoptimize()) {
+      continue;
+    }
+    return false;
+  }
+  return true;
+}
+
+static VectorLoop* Analyze(FlowGraph* flow_graph, LoopInfo* loop) {
+  if ((loop->inner() != nullptr) || (loop->back_edges().length() != 1)) {
+    return nullptr;
+  }
+  JoinEntryInstr* header = loop->header()->AsJoinEntry();
+  if ((header == nullptr) || (header->PredecessorCount() != 2) ||
+      (header->phis() == nullptr) || (header->phis()->length() != 1)) {
+    return nullptr;
+  }
+  BranchInstr* branch = header->last_instruction()->AsBranch();
+  TargetEntryInstr* body = loop->back_edges()[0]->AsTargetEntry();
+  if ((branch == nullptr) || (body == nullptr) ||
+      (branch->true_successor() != body) ||
+      !body->last_instruction()->IsGoto() || !IsHeaderVectorizable(header)) {
+    return nullptr;
+  }
+  const intptr_t back_index = header->IndexOfPredecessor(body);
+  BlockEntryInstr* preheader = header->PredecessorAt(1 - back_index);
+  if (!preheader->last_instruction()->IsGoto()) {
+    return nullptr;
+  }
+
+  // The loop must count up from a non-negative constant by one.
+  PhiInstr* phi = (*header->phis())[0];
+  if ((phi->representation() != kTagged) &&
+      (phi->representation() != kUnboxedInt64)) {
+    return nullptr;
+  }
+  InductionVar* induction = loop->LookupInduction(phi);
+  int64_t stride = 0;
+  int64_t start = 0;
+  if ((induction != loop->control()) ||
+      !InductionVar::IsLinear(induction, &stride) || (stride != 1) ||
+      !InductionVar::IsConstant(induction->initial(), &start) || (start < 0)) {
+    return nullptr;
+  }
+  Definition* next = phi->InputAt(back_index)->definition();
+  if (!IsUnitIncrement(phi, next) || (next->GetBlock() != body)) {
+    return nullptr;
+  }
+  Definition* limit = FindLimit(flow_graph, loop, induction, branch);
+  if (limit == nullptr) {
+    return nullptr;
+  }
+
+  auto vloop = new (flow_graph->zone()) VectorLoop(flow_graph->zone());
+  vloop->header = header;
+  vloop->body = body;
+  vloop->preheader = preheader;
+  vloop->phi = phi;
+  vloop->initial = phi->InputAt(1 - back_index)->definition();
+  vloop->next = next;
+  vloop->limit = limit;
+
+  // The body must be a straight line of element-wise operations on the
+  // current elements, ending in a single store.
+  bool has_store = false;
+  for (ForwardInstructionIterator it(body); !it.Done(); it.Advance()) {
+    Instruction* instr = it.Current();
+    if ((instr == next) || instr->IsGoto()) continue;
+    if (has_store || (vloop->operations.length() >= kMaxVectorOperations)) {
+      return nullptr;
+    }
+    if (CheckBoundBaseInstr* check = instr->AsCheckBoundBase()) {
+      Definition* length = check->length()->definition();
+      if ((check->index()->definition()->OriginalDefinition() != phi) ||
+          (length->representation() != kTagged) ||
+          !IsInvariant(loop, length)) {
+        return nullptr;
+      }
+      if (!Includes(vloop->lengths, length)) {
+        vloop->lengths.Add(length);
+      }
+      continue;
+    }
+    if (LoadIndexedInstr* load = instr->AsLoadIndexed()) {
+      if (!AcceptIndexedAccess(loop, vloop, load)) return nullptr;
+    } else if (StoreIndexedInstr* store = instr->AsStoreIndexed()) {
+      if (!AcceptIndexedAccess(loop, vloop, store) ||
+          !AcceptOperand(loop, vloop, store->value())) {
+        return nullptr;
+      }
+      has_store = true;
+    } else if (BinaryDoubleOpInstr* op = instr->AsBinaryDoubleOp()) {
+      switch (op->op_kind()) {
+        case Token::kADD:
+        case Token::kSUB:
+        case Token::kMUL:
+        case Token::kDIV:
+          break;
+        default:
+          return nullptr;
+      }
+      if ((op->representation() != kUnboxedDouble) ||
+          !AcceptOperand(loop, vloop, op->left()) ||
+          !AcceptOperand(loop, vloop, op->right())) {
+        return nullptr;
+      }
+    } else if (UnaryDoubleOpInstr* op = instr->AsUnaryDoubleOp()) {
+      if (((op->op_kind() != Token::kNEGATE) &&
+           (op->op_kind() != Token::kSQRT)) ||
+          (op->representation() != kUnboxedDouble) ||
+          !AcceptOperand(loop, vloop, op->value())) {
+        return nullptr;
+      }
+    } else {
+      return nullptr;
+    }
+    vloop->operations.Add(instr);
+  }
+  if (!has_store) {
+    return nullptr;
+  }
+
+  // Lanes of distinct arrays can only be proven independent when none
+  // of them is a view on the storage of another.
+  if (vloop->arrays.length() > 1) {
+    for (intptr_t i = 0; i < vloop->arrays.length(); i++) {
+      if (vloop->arrays[i]->Type()->ToCid() != kTypedDataFloat64ArrayCid) {
+        return nullptr;
+      }
+    }
+  }
+
+  // Lengths of the accessed arrays are covered by the vector limit anyway.
+  for (intptr_t i = vloop->lengths.length() - 1; i >= 0; i--) {
+    for (intptr_t j = 0; j < vloop->arrays.length(); j++) {
+      if (IsArrayLength(vloop->lengths[i], vloop->arrays[j])) {
+        vloop->lengths.RemoveAt(i);
+        break;
+      }
+    }
+  }
+  return vloop;
+}
+
+static Definition* NewIncrement(FlowGraph* flow_graph, Definition* index) {
+  const Representation rep = index->representation();
+  Definition* one = flow_graph->GetConstant(
+      Smi::ZoneHandle(flow_graph->zone(), Smi::New(1)), rep);
+  return BinaryIntegerOpInstr::Make(
+      rep, Token::kADD, new Value(index), new Value(one), DeoptId::kNone,
+      /*can_overflow=*/false, /*is_truncating=*/false, /*range=*/nullptr,
+      Instruction::kNotSpeculative);
+}
+
+// Computes the vector limit, the smallest of the loop limit and the lengths
+// of all arrays accessed in the loop, in the preheader.
+static Definition* EmitVectorLimit(FlowGraph* flow_graph, VectorLoop* vloop) {
+  Instruction* last = vloop->preheader->last_instruction();
+  Definition* limit = vloop->limit;
+  GrowableArray<Definition*> lengths(vloop->lengths.length() +
+                                     vloop->arrays.length());
+  lengths.AddArray(vloop->lengths);
+  for (intptr_t i = 0; i < vloop->arrays.length(); i++) {
+    Definition* length = new LoadFieldInstr(new Value(vloop->arrays[i]),
+                                            Slot::TypedDataBase_length(),
+                                            InstructionSource());
+    flow_graph->InsertBefore(last, length, nullptr, FlowGraph::kValue);
+    lengths.Add(length);
+  }
+  for (intptr_t i = 0; i < lengths.length(); i++) {
+    Definition* min =
+        new MathMinMaxInstr(MethodRecognizer::kMathMin, new Value(limit),
+                            new Value(lengths[i]), DeoptId::kNone, kSmiCid);
+    flow_graph->InsertBefore(last, min, nullptr, FlowGraph::kValue);
+    limit = min;
+  }
+  if (vloop->phi->representation() != kTagged) {
+    Definition* unbox =
+        UnboxInstr::Create(vloop->phi->representation(), new Value(limit),
+                           DeoptId::kNone, Instruction::kNotSpeculative);
+    flow_graph->InsertBefore(last, unbox, nullptr, FlowGraph::kValue);
+    limit = unbox;
+  }
+  return limit;
+}
+
+// Emits the Float64x2 counterpart of the scalar operation [instr] after
+// [cursor] and returns it.
+static Instruction* EmitVectorOperation(
+    FlowGraph* flow_graph,
+    VectorLoop* vloop,
+    Instruction* instr,
+    Instruction* cursor,
+    const GrowableArray<Definition*>& vector_defs,
+    const GrowableArray<Definition*>& splats) {
+  auto vector_operand = [&](Value* use) -> Value* {
+    Definition* def = use->definition();
+    for (intptr_t i = 0; i < vloop->operations.length(); i++) {
+      if (vloop->operations[i] == def) return new Value(vector_defs[i]);
+    }
+    for (intptr_t i = 0; i < vloop->invariants.length(); i++) {
+      if (vloop->invariants[i] == def) return new Value(splats[i]);
+    }
+    UNREACHABLE();
+    return nullptr;
+  };
+
+  if (LoadIndexedInstr* load = instr->AsLoadIndexed()) {
+    const bool index_unboxed =
+        load->RequiredInputRepresentation(LoadIndexedInstr::kIndexPos) !=
+        kTagged;
+    auto vector = new LoadIndexedInstr(
+        new Value(load->array()->definition()), new Value(vloop->phi),
+        index_unboxed, load->index_scale(), kTypedDataFloat64x2ArrayCid,
+        load->aligned() ? kAlignedAccess : kUnalignedAccess, DeoptId::kNone,
+        load->source());
+    return flow_graph->AppendTo(cursor, vector, nullptr, FlowGraph::kValue);
+  }
+  if (StoreIndexedInstr* store = instr->AsStoreIndexed()) {
+    const bool index_unboxed =
+        store->RequiredInputRepresentation(StoreIndexedInstr::kIndexPos) !=
+        kTagged;
+    auto vector = new StoreIndexedInstr(
+        new Value(store->array()->definition()), new Value(vloop->phi),
+        vector_operand(store->value()), kNoStoreBarrier, index_unboxed,
+        store->index_scale(), kTypedDataFloat64x2ArrayCid,
+        store->aligned() ? kAlignedAccess : kUnalignedAccess, DeoptId::kNone,
+        store->source(), Instruction::kNotSpeculative);
+    return flow_graph->AppendTo(cursor, vector, nullptr, FlowGraph::kEffect);
+  }
+  if (BinaryDoubleOpInstr* op = instr->AsBinaryDoubleOp()) {
+    auto vector = SimdOpInstr::Create(
+        SimdOpInstr::KindForOperator(kFloat64x2Cid, op->op_kind()),
+        vector_operand(op->left()), vector_operand(op->right()),
+        DeoptId::kNone);
+    return flow_graph->AppendTo(cursor, vector, nullptr, FlowGraph::kValue);
+  }
+  UnaryDoubleOpInstr* op = instr->AsUnaryDoubleOp();
+  ASSERT(op != nullptr);
+  auto vector = SimdOpInstr::Create(op->op_kind() == Token::kNEGATE
+                                        ? MethodRecognizer::kFloat64x2Negate
+                                        : MethodRecognizer::kFloat64x2Sqrt,
+                                    vector_operand(op->value()),
+                                    DeoptId::kNone);
+  return flow_graph->AppendTo(cursor, vector, nullptr, FlowGraph::kValue);
+}
+
+// Rewrites
+//
+//     header: i = phi(initial, next); if (i < limit) goto body else exit
+//     body:   <scalar body>; next = i + 1; goto header
+//
+// into
+//
+//     preheader: splats; vector_limit = min(limit, lengths)
+//     header:    i = phi(initial, join_next); ...
+//     body:      i1 = i + 1; if (i1 < vector_limit) goto vector else scalar
+//     vector:    <Float64x2 body>; i2 = i1 + 1; goto join
+//     scalar:    <scalar body>; next = i + 1; goto join
+//     join:      join_next = phi(i2, next); goto header
+//
+// The phis are only created in FinishRewrite, once the predecessors of the
+// new blocks are known.
+static void Rewrite(FlowGraph* flow_graph, VectorLoop* vloop) {
+  Zone* zone = flow_graph->zone();
+  TargetEntryInstr* body = vloop->body;
+  const intptr_t try_index = body->try_index();
+
+  Instruction* preheader_last = vloop->preheader->last_instruction();
+  GrowableArray<Definition*> splats(vloop->invariants.length());
+  for (intptr_t i = 0; i < vloop->invariants.length(); i++) {
+    Definition* splat =
+        SimdOpInstr::Create(MethodRecognizer::kFloat64x2Splat,
+                            new Value(vloop->invariants[i]), DeoptId::kNone);
+    flow_graph->InsertBefore(preheader_last, splat, nullptr,
+                             FlowGraph::kValue);
+    splats.Add(splat);
+  }
+  Definition* vector_limit = EmitVectorLimit(flow_graph, vloop);
+
+  auto vector_entry = new (zone) TargetEntryInstr(
+      flow_graph->allocate_block_id(), try_index, DeoptId::kNone);
+  auto scalar_entry = new (zone) TargetEntryInstr(
+      flow_graph->allocate_block_id(), try_index, DeoptId::kNone);
+  auto join = new (zone) JoinEntryInstr(flow_graph->allocate_block_id(),
+                                        try_index, DeoptId::kNone);
+
+  // Move the scalar body into its own block and let the goto back to the
+  // header start from the join instead.
+  GotoInstr* back_edge = body->last_instruction()->AsGoto();
+  Instruction* scalar_last = back_edge->previous();
+  scalar_entry->LinkTo(body->next());
+  auto scalar_goto = new (zone) GotoInstr(join, DeoptId::kNone);
+  scalar_last->LinkTo(scalar_goto);
+  scalar_entry->set_last_instruction(scalar_goto);
+  join->LinkTo(back_edge);
+  join->set_last_instruction(back_edge);
+
+  // Decide between the vector and the scalar path.
+  Definition* lane1 = NewIncrement(flow_graph, vloop->phi);
+  flow_graph->AppendTo(body, lane1, nullptr, FlowGraph::kValue);
+  auto compare = new RelationalOpInstr(
+      InstructionSource(), Token::kLT, new Value(lane1),
+      new Value(vector_limit),
+      lane1->representation() == kTagged ? kSmiCid : kMintCid, DeoptId::kNone,
+      Instruction::kNotSpeculative);
+  auto branch = new (zone) BranchInstr(compare, DeoptId::kNone);
+  flow_graph->AppendTo(lane1, branch, nullptr, FlowGraph::kEffect);
+  body->set_last_instruction(branch);
+  *branch->true_successor_address() = vector_entry;
+  *branch->false_successor_address() = scalar_entry;
+
+  // Emit the vector path.
+  GrowableArray<Definition*> vector_defs(vloop->operations.length());
+  Instruction* cursor = vector_entry;
+  for (intptr_t i = 0; i < vloop->operations.length(); i++) {
+    cursor = EmitVectorOperation(flow_graph, vloop, vloop->operations[i],
+                                 cursor, vector_defs, splats);
+    vector_defs.Add(cursor->AsDefinition());
+  }
+  Definition* lane2 = NewIncrement(flow_graph, lane1);
+  cursor = flow_graph->AppendTo(cursor, lane2, nullptr, FlowGraph::kValue);
+  auto vector_goto = new (zone) GotoInstr(join, DeoptId::kNone);
+  flow_graph->AppendTo(cursor, vector_goto, nullptr, FlowGraph::kEffect);
+  vector_entry->set_last_instruction(vector_goto);
+
+  vloop->vector_entry = vector_entry;
+  vloop->join = join;
+  vloop->vector_next = lane2;
+}
+
+static void FinishRewrite(FlowGraph* flow_graph, VectorLoop* vloop) {
+  JoinEntryInstr* join = vloop->join;
+  const bool vector_first = join->PredecessorAt(0) == vloop->vector_entry;
+  PhiInstr* join_phi =
+      flow_graph->AddPhi(join, vector_first ? vloop->vector_next : vloop->next,
+                         vector_first ? vloop->next : vloop->vector_next);
+  join_phi->set_representation(vloop->phi->representation());
+  join_phi->UpdateType(*vloop->next->Type());
+
+  // Predecessors of the header may have been reordered.
+  JoinEntryInstr* header = vloop->header;
+  for (intptr_t i = 0; i < header->PredecessorCount(); i++) {
+    vloop->phi->InputAt(i)->BindTo(header->PredecessorAt(i) == join
+                                       ? join_phi
+                                       : vloop->initial);
+  }
+}
+
+void LoopVectorizer::Optimize(FlowGraph* flow_graph) {
+  if (!FLAG_loop_vectorization || flow_graph->IsCompiledForOsr() ||
+      !FlowGraphCompiler::SupportsUnboxedSimd128()) {
+    return;
+  }
+
+  const LoopHierarchy& loop_hierarchy = flow_graph->GetLoopHierarchy();
+  loop_hierarchy.ComputeInduction();
+
+  // Analyze all loops before changing the graph, which invalidates the
+  // loop hierarchy.
+  GrowableArray<VectorLoop*> vector_loops;
+  const auto& headers = loop_hierarchy.headers();
+  for (intptr_t i = 0; i < headers.length(); i++) {
+    VectorLoop* vloop = Analyze(flow_graph, headers[i]->loop_info());
+    if (vloop != nullptr) {
+      vector_loops.Add(vloop);
+    }
+  }
+  if (vector_loops.is_empty()) {
+    return;
+  }
+
+  for (intptr_t i = 0; i < vector_loops.length(); i++) {
+    Rewrite(flow_graph, vector_loops[i]);
+  }
+  flow_graph->DiscoverBlocks();
+  GrowableArray<BitVector*> dominance_frontier;
+  flow_graph->ComputeDominators(&dominance_frontier);
+  for (intptr_t i = 0; i < vector_loops.length(); i++) {
+    FinishRewrite(flow_graph, vector_loops[i]);
+  }
+}
+
+#else
+
+void LoopVectorizer::Optimize(FlowGraph* flow_graph) {}
+
+#endif  // defined(TARGET_ARCH_X64) || defined(TARGET_ARCH_ARM64)
+
+}  // namespace dart
@@ -0,0 +1,39 @@
+// Copyright (c) 2024, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_COMPILER_BACKEND_LOOP_VECTORIZER_H_
+#define RUNTIME_VM_COMPILER_BACKEND_LOOP_VECTORIZER_H_
+
+#if defined(DART_PRECOMPILED_RUNTIME)
+#error "AOT runtime should not use compiler sources (including header files)"
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+
+#include "vm/allocation.h"
+
+namespace dart {
+
+class FlowGraph;
+
+// Vectorizes innermost counted loops that map Float64List elements
+// element-wise, e.g.
+//
+//     for (int i = 0; i < out.length; i++) {
+//       out[i] = a * x[i] + y[i];
+//     }
+//
+// Each iteration of such a loop first checks whether lane i + 1 is still
+// in range of the loop limit and of the lengths of all accessed arrays (the
+// minimum of which is computed once in the preheader). If so, two lanes are
+// handled at once with Float64x2 operations, otherwise the original scalar
+// body runs. Loops accessing more than one array are only vectorized when
+// all arrays are known to be internal typed data, so that the same index
+// can't refer to overlapping elements of two arrays.
+class LoopVectorizer : public AllStatic {
+ public:
+  static void Optimize(FlowGraph* flow_graph);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_COMPILER_BACKEND_LOOP_VECTORIZER_H_
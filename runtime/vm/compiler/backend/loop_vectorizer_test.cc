@@ -0,0 +1,134 @@
+// Copyright (c) 2024, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/compiler/backend/loop_vectorizer.h"
+
+#include "vm/compiler/backend/flow_graph_compiler.h"
+#include "vm/compiler/backend/il.h"
+#include "vm/compiler/backend/il_test_helper.h"
+#include "vm/compiler/compiler_pass.h"
+#include "vm/flags.h"
+#include "vm/object.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+#if defined(TARGET_ARCH_X64) || defined(TARGET_ARCH_ARM64)
+
+DECLARE_FLAG(bool, loop_vectorization);
+
+static void CountVectorAccesses(FlowGraph* flow_graph,
+                                intptr_t* loads,
+                                intptr_t* stores) {
+  *loads = 0;
+  *stores = 0;
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    for (ForwardInstructionIterator it(block_it.Current()); !it.Done();
+         it.Advance()) {
+      Instruction* instr = it.Current();
+      if (instr->IsLoadIndexed() &&
+          instr->AsLoadIndexed()->class_id() == kTypedDataFloat64x2ArrayCid) {
+        (*loads)++;
+      } else if (instr->IsStoreIndexed() &&
+                 instr->AsStoreIndexed()->class_id() ==
+                     kTypedDataFloat64x2ArrayCid) {
+        (*stores)++;
+      }
+    }
+  }
+}
+
+ISOLATE_UNIT_TEST_CASE(LoopVectorizer_Map) {
+  if (!FlowGraphCompiler::SupportsUnboxedSimd128()) {
+    return;
+  }
+  SetFlagScope<bool> sfs(&FLAG_loop_vectorization, true);
+
+  // An odd length exercises the scalar path for the last element.
+  const char* kScript = R"(
+    import 'dart:typed_data';
+
+    double foo() {
+      final x = Float64List(9);
+      final y = Float64List(9);
+      final out = Float64List(9);
+      for (int i = 0; i < x.length; i++) {
+        x[i] = i.toDouble();
+        y[i] = 1.0;
+      }
+      for (int i = 0; i < out.length; i++) {
+        out[i] = 2.0 * x[i] + y[i];
+      }
+      double sum = 0.0;
+      for (int i = 0; i < out.length; i++) {
+        sum += out[i];
+      }
+      return sum;
+    }
+
+    main() => foo();
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  const auto& function = Function::Handle(GetFunction(root_library, "foo"));
+  Invoke(root_library, "main");
+
+  TestPipeline pipeline(function, CompilerPass::kJIT);
+  FlowGraph* flow_graph = pipeline.RunPasses({});
+
+  // Only the map loop is vectorized: the first loop converts integers and
+  // the last one is a reduction.
+  intptr_t loads = 0;
+  intptr_t stores = 0;
+  CountVectorAccesses(flow_graph, &loads, &stores);
+  EXPECT_EQ(2, loads);
+  EXPECT_EQ(1, stores);
+
+  pipeline.CompileGraphAndAttachFunction();
+  const auto& result = Object::Handle(Invoke(root_library, "main"));
+  EXPECT(result.IsDouble());
+  EXPECT_EQ(81.0, Double::Cast(result).value());
+}
+
+ISOLATE_UNIT_TEST_CASE(LoopVectorizer_MayAlias) {
+  if (!FlowGraphCompiler::SupportsUnboxedSimd128()) {
+    return;
+  }
+  SetFlagScope<bool> sfs(&FLAG_loop_vectorization, true);
+
+  // [a] and [b] may be views on overlapping storage.
+  const char* kScript = R"(
+    import 'dart:typed_data';
+
+    void foo(Float64List a, Float64List b) {
+      for (int i = 0; i < a.length; i++) {
+        a[i] = b[i] + 1.0;
+      }
+    }
+
+    main() {
+      final data = Float64List(10);
+      foo(Float64List.sublistView(data, 1), data);
+      return data[9];
+    }
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  const auto& function = Function::Handle(GetFunction(root_library, "foo"));
+  Invoke(root_library, "main");
+
+  TestPipeline pipeline(function, CompilerPass::kJIT);
+  FlowGraph* flow_graph = pipeline.RunPasses({});
+
+  intptr_t loads = 0;
+  intptr_t stores = 0;
+  CountVectorAccesses(flow_graph, &loads, &stores);
+  EXPECT_EQ(0, loads);
+  EXPECT_EQ(0, stores);
+}
+
+#endif  // defined(TARGET_ARCH_X64) || defined(TARGET_ARCH_ARM64)
+
+}  // namespace dart
@@ -499,6 +499,7 @@ MEMORY_TEST(14, 13, 15, 16)
 MEMORY_TEST(2, 2, 8, 1)     // promoted to 2.
 MEMORY_TEST(4, 4, 8, 1)     // promoted to 4.
 MEMORY_TEST(8, 8, 8, 1)     // promoted to 8.
-MEMORY_TEST(16, 16, 16, 1)  // promoted to 16 on ARM64.
+MEMORY_TEST(16, 16, 16, 1)  // promoted to 16 on ARM64 and X64.
+MEMORY_TEST(32, 64, 64, 1)  // promoted to 16 on ARM64 and X64.
 
 }  // namespace dart
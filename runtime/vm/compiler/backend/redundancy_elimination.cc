@@ -1724,6 +1724,14 @@ bool DelayAllocations::IsOneTimeUse(Instruction* use, Definition* def) {
   return true;
 }
 
+// Calls to functions without side effects don't write any memory, so they
+// don't kill loads even though they might read arbitrary memory.
+static bool IsCallWithoutSideEffects(Instruction* instr) {
+  StaticCallInstr* call = instr->AsStaticCall();
+  return (call != nullptr) && CompilerState::Current().is_aot() &&
+         call->function().has_no_side_effects();
+}
+
 class LoadOptimizer : public ValueObject {
  public:
   LoadOptimizer(FlowGraph* graph, AliasedSet* aliased_set)
@@ -2136,7 +2144,8 @@ class LoadOptimizer : public ValueObject {
         }
 
         // If instruction has effects then kill all loads affected.
-        if (instr->HasUnknownSideEffects()) {
+        if (instr->HasUnknownSideEffects() &&
+            !IsCallWithoutSideEffects(instr)) {
           kill->AddAll(aliased_set_->aliased_by_effects());
           // There is no need to clear out_values when removing values from GEN
           // set because only those values that are in the GEN set
@@ -3267,6 +3276,18 @@ static bool IsSupportedAllocation(Instruction* instr) {
           IsValidLengthForAllocationSinking(instr->AsArrayAllocation()));
 }
 
+// Redefinitions of an allocation carry no information that is not already
+// known from the allocation itself: its type is exact and it is never null.
+// Inlined callees often leave such redefinitions behind (e.g. of closures
+// and contexts passed as arguments), so allocation sinking looks through
+// them and folds them away for all candidates (see FoldRedefinitions).
+static Definition* UnwrapRedefinitions(Definition* defn) {
+  while (auto* const redef = defn->AsRedefinition()) {
+    defn = redef->value()->definition();
+  }
+  return defn;
+}
+
 // Check if the use is safe for allocation sinking. Allocation sinking
 // candidates can only be used as inputs to store and allocation instructions:
 //
@@ -3276,6 +3297,8 @@ static bool IsSupportedAllocation(Instruction* instr) {
 //       an allocation candidate.
 //     - use as input to another allocation is only safe if the other allocation
 //       is a candidate.
+//     - use as input to a redefinition is safe if all uses of the
+//       redefinition are safe.
 //
 // We use a simple fix-point algorithm to discover the set of valid candidates
 // (see CollectCandidates method), that's why this IsSafeUse can operate in two
@@ -3290,12 +3313,22 @@ static bool IsSupportedAllocation(Instruction* instr) {
 // optimistically and then checks each collected candidate strictly and unmarks
 // invalid candidates transitively until only strictly valid ones remain.
 bool AllocationSinking::IsSafeUse(Value* use, SafeUseCheck check_type) {
-  ASSERT(IsSupportedAllocation(use->definition()));
+  ASSERT(IsSupportedAllocation(UnwrapRedefinitions(use->definition())));
 
   if (use->instruction()->IsMaterializeObject()) {
     return true;
   }
 
+  if (auto* const redef = use->instruction()->AsRedefinition()) {
+    for (Value* redef_use = redef->input_use_list(); redef_use != nullptr;
+         redef_use = redef_use->next_use()) {
+      if (!IsSafeUse(redef_use, check_type)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
   if (auto* const alloc = use->instruction()->AsAllocation()) {
     return IsSupportedAllocation(alloc) &&
            ((check_type == kOptimisticCheck) ||
@@ -3304,7 +3337,8 @@ bool AllocationSinking::IsSafeUse(Value* use, SafeUseCheck check_type) {
 
   if (auto* store = use->instruction()->AsStoreField()) {
     if (use == store->value()) {
-      Definition* instance = store->instance()->definition();
+      Definition* instance =
+          UnwrapRedefinitions(store->instance()->definition());
       return IsSupportedAllocation(instance) &&
              ((check_type == kOptimisticCheck) ||
               instance->Identity().IsAllocationSinkingCandidate());
@@ -3320,13 +3354,13 @@ bool AllocationSinking::IsSafeUse(Value* use, SafeUseCheck check_type) {
       if (!store->index()->BindsToSmiConstant()) {
         return false;
       }
+      Definition* array = UnwrapRedefinitions(use->definition());
       const intptr_t index = store->index()->BoundSmiConstant();
-      if (index < 0 || index >= use->definition()
-                                    ->AsArrayAllocation()
-                                    ->GetConstantNumElements()) {
+      if (index < 0 ||
+          index >= array->AsArrayAllocation()->GetConstantNumElements()) {
         return false;
       }
-      if (auto* alloc_typed_data = use->definition()->AsAllocateTypedData()) {
+      if (auto* alloc_typed_data = array->AsAllocateTypedData()) {
         if (store->class_id() != alloc_typed_data->class_id() ||
             !store->aligned() ||
             store->index_scale() != compiler::target::Instance::ElementSizeFor(
@@ -3336,7 +3370,7 @@ bool AllocationSinking::IsSafeUse(Value* use, SafeUseCheck check_type) {
       }
     }
     if (use == store->value()) {
-      Definition* instance = store->array()->definition();
+      Definition* instance = UnwrapRedefinitions(store->array()->definition());
       return IsSupportedAllocation(instance) &&
              ((check_type == kOptimisticCheck) ||
               instance->Identity().IsAllocationSinkingCandidate());
@@ -3504,6 +3538,29 @@ void AllocationSinking::CollectCandidates() {
   candidates_.TruncateTo(j);
 }
 
+// Replace all redefinitions of the given candidate with the candidate itself,
+// so that the rest of the pass only has to deal with direct uses.
+void AllocationSinking::FoldRedefinitions(Definition* alloc) {
+  bool changed;
+  do {
+    changed = false;
+    for (Value* use = alloc->input_use_list(); use != nullptr;
+         use = use->next_use()) {
+      if (auto* const redef = use->instruction()->AsRedefinition()) {
+        if (FLAG_trace_optimization && flow_graph_->should_print()) {
+          THR_Print("folding redefinition v%" Pd " of v%" Pd "\n",
+                    redef->ssa_temp_index(), alloc->ssa_temp_index());
+        }
+        // Removing the redefinition changes the use list, so restart.
+        redef->ReplaceUsesWith(alloc);
+        redef->RemoveFromGraph();
+        changed = true;
+        break;
+      }
+    }
+  } while (changed);
+}
+
 // If materialization references an allocation sinking candidate then replace
 // this reference with a materialization which should have been computed for
 // this side-exit. CollectAllExits should have collected this exit.
@@ -3650,6 +3707,10 @@ void AllocationSinking::Optimize() {
 
   CollectCandidates();
 
+  for (intptr_t i = 0; i < candidates_.length(); i++) {
+    FoldRedefinitions(candidates_[i]);
+  }
+
   // Insert MaterializeObject instructions that will describe the state of the
   // object at all deoptimization points. Each inserted materialization looks
   // like this (where v_0 is allocation that we are going to eliminate):
@@ -4565,4 +4626,75 @@ void CheckStackOverflowElimination::EliminateStackOverflow(FlowGraph* graph) {
   }
 }
 
+// Returns false if [instr] may write memory or may behave differently after
+// deoptimization. Clears [is_pure] if its result may depend on mutable memory
+// or be a new object.
+static bool IsFreeOfSideEffects(Instruction* instr, bool* is_pure) {
+  if (StaticCallInstr* call = instr->AsStaticCall()) {
+    *is_pure = *is_pure && call->function().is_pure();
+    return call->function().has_no_side_effects();
+  }
+  // Eager deoptimization might take the unoptimized code to calls this code
+  // doesn't make, e.g. after a failed class check. Lazy deoptimization
+  // (e.g. at stack overflow checks) continues on the same path.
+  if (instr->HasUnknownSideEffects() ||
+      ((instr->env() != nullptr) && instr->ComputeCanDeoptimize())) {
+    return false;
+  }
+  switch (instr->tag()) {
+    case Instruction::kStoreIndexedUnsafe:
+    case Instruction::kMemoryCopy:
+    case Instruction::kRawStoreField:
+    case Instruction::kTailCall:
+      return false;
+    default:
+      break;
+  }
+  bool is_load = false;
+  bool is_store = false;
+  Place place(instr, &is_load, &is_store);
+  if (is_store) {
+    return false;
+  }
+  if (is_load) {
+    LoadFieldInstr* load = instr->AsLoadField();
+    if ((load == nullptr) || !load->slot().is_immutable()) {
+      *is_pure = false;
+    }
+  }
+  if (instr->IsAllocation()) {
+    *is_pure = false;
+  }
+  return true;
+}
+
+void SideEffectSummary::Record(FlowGraph* flow_graph) {
+  // The summary is never cleared, so it is only recorded in AOT, where the
+  // code it is derived from is final. In JIT, hot reload, deoptimization and
+  // class loading (invalidating CHA) can change the callee's behavior.
+  if (!CompilerState::Current().is_aot()) {
+    return;
+  }
+  const Function& function = flow_graph->function();
+  if (function.is_pure() || flow_graph->IsCompiledForOsr()) {
+    return;
+  }
+
+  bool is_pure = true;
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    for (ForwardInstructionIterator it(block_it.Current()); !it.Done();
+         it.Advance()) {
+      if (!IsFreeOfSideEffects(it.Current(), &is_pure)) {
+        return;
+      }
+    }
+  }
+
+  function.set_has_no_side_effects();
+  if (is_pure) {
+    function.set_is_pure();
+  }
+}
+
 }  // namespace dart
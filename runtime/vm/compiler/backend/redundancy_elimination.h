@@ -58,6 +58,8 @@ class AllocationSinking : public ZoneAllocated {
 
   void CollectCandidates();
 
+  void FoldRedefinitions(Definition* alloc);
+
   void NormalizeMaterializations();
 
   void RemoveUnusedMaterializations();
@@ -160,6 +162,15 @@ class DelayAllocations : public AllStatic {
   static bool IsOneTimeUse(Instruction* use, Definition* def);
 };
 
+// Summarizes the side effects of an optimized function on the Function
+// object, see Function::has_no_side_effects() and Function::is_pure().
+// Load forwarding doesn't treat calls to functions without side effects as
+// clobbering memory, and calls to pure functions are subject to CSE.
+class SideEffectSummary : public AllStatic {
+ public:
+  static void Record(FlowGraph* flow_graph);
+};
+
 class CheckStackOverflowElimination : public AllStatic {
  public:
   // For leaf functions with only a single [StackOverflowInstr] we remove it.
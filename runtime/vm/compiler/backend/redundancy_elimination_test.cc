@@ -1205,6 +1205,70 @@ main() {
 
 #endif  // !defined(TARGET_ARCH_IA32)
 
+// Verifies that redefinitions of an allocation don't prevent it from being
+// eliminated by allocation sinking.
+ISOLATE_UNIT_TEST_CASE(AllocationSinking_Redefinition) {
+  const char* script_chars = R"(
+    class K {
+      var field;
+    }
+  )";
+  const Library& lib = Library::Handle(LoadTestScript(script_chars));
+
+  const Class& cls = Class::ZoneHandle(
+      lib.LookupClass(String::Handle(Symbols::New(thread, "K"))));
+  const Error& err = Error::Handle(cls.EnsureIsFinalized(thread));
+  EXPECT(err.IsNull());
+
+  const Field& original_field = Field::Handle(
+      cls.LookupField(String::Handle(Symbols::New(thread, "field"))));
+  EXPECT(!original_field.IsNull());
+  const Field& field = Field::Handle(original_field.CloneFromOriginal());
+
+  using compiler::BlockBuilder;
+  CompilerState S(thread, /*is_aot=*/false, /*is_optimizing=*/true);
+  FlowGraphBuilderHelper H;
+
+  // We are going to build the following graph:
+  //
+  // B0[graph_entry]
+  // B1[function_entry]:
+  //   v0 <- AllocateObject(class K)
+  //   v1 <- Redefinition(v0)
+  //   v2 <- Redefinition(v1)
+  //   StoreField(v2 . K.field = 1)
+  //   Return null
+
+  auto b1 = H.flow_graph()->graph_entry()->normal_entry();
+  AllocateObjectInstr* v0;
+  RedefinitionInstr* v1;
+  RedefinitionInstr* v2;
+  StoreFieldInstr* store;
+
+  {
+    BlockBuilder builder(H.flow_graph(), b1);
+    auto& slot = Slot::Get(field, &H.flow_graph()->parsed_function());
+    v0 = builder.AddDefinition(
+        new AllocateObjectInstr(InstructionSource(), cls, S.GetNextDeoptId()));
+    v1 = builder.AddDefinition(new RedefinitionInstr(new Value(v0)));
+    v2 = builder.AddDefinition(new RedefinitionInstr(new Value(v1)));
+    store = builder.AddInstruction(new StoreFieldInstr(
+        slot, new Value(v2), new Value(H.IntConstant(1)), kEmitStoreBarrier,
+        InstructionSource()));
+    builder.AddReturn(new Value(H.flow_graph()->constant_null()));
+  }
+  H.FinishGraph();
+
+  AllocationSinking sinking(H.flow_graph());
+  sinking.Optimize();
+
+  EXPECT_EQ(1, sinking.candidates().length());
+  EXPECT_PROPERTY(v0, it.next() == nullptr && it.previous() == nullptr);
+  EXPECT_PROPERTY(v1, it.next() == nullptr && it.previous() == nullptr);
+  EXPECT_PROPERTY(v2, it.next() == nullptr && it.previous() == nullptr);
+  EXPECT_PROPERTY(store, it.next() == nullptr && it.previous() == nullptr);
+}
+
 ISOLATE_UNIT_TEST_CASE(AllocationSinking_Arrays) {
   const char* kScript = R"(
 import 'dart:typed_data';
@@ -2038,4 +2102,68 @@ ISOLATE_UNIT_TEST_CASE(LICM_Deopt_Regress50245) {
   EXPECT(function.HasOptimizedCode());
 }
 
+ISOLATE_UNIT_TEST_CASE(LoadOptimizer_ForwardAcrossPureCall) {
+  const char* kScript = R"(
+    class A {
+      int x;
+      A(this.x);
+    }
+
+    @pragma('vm:never-inline')
+    int helper(int v) => v * 3;
+
+    int foo(A a) {
+      final r1 = a.x + helper(7);
+      final r2 = a.x + helper(7);
+      return r1 + r2;
+    }
+
+    main() => foo(A(1));
+  )";
+
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  const auto& helper = Function::Handle(GetFunction(root_library, "helper"));
+  const auto& function = Function::Handle(GetFunction(root_library, "foo"));
+  Invoke(root_library, "main");
+
+  // The side effect summary is not recorded in JIT mode.
+  Compiler::CompileOptimizedFunction(thread, helper);
+  EXPECT(helper.HasOptimizedCode());
+  EXPECT(!helper.has_no_side_effects());
+  EXPECT(!helper.is_pure());
+
+  // It is recorded from the optimized AOT graph of [helper].
+  {
+    TestPipeline helper_pipeline(helper, CompilerPass::kAOT);
+    SideEffectSummary::Record(helper_pipeline.RunPasses({}));
+  }
+  EXPECT(helper.has_no_side_effects());
+  EXPECT(helper.is_pure());
+
+  TestPipeline pipeline(function, CompilerPass::kAOT);
+  FlowGraph* flow_graph = pipeline.RunPasses({});
+
+  // The second load of [x] is forwarded across the call and the second call
+  // is replaced with the first one.
+  intptr_t loads = 0;
+  intptr_t calls = 0;
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done(); block_it.Advance()) {
+    for (ForwardInstructionIterator it(block_it.Current()); !it.Done();
+         it.Advance()) {
+      if (auto load = it.Current()->AsLoadField()) {
+        if (load->slot().IsDartField()) {
+          loads++;
+        }
+      } else if (auto call = it.Current()->AsStaticCall()) {
+        if (call->function().ptr() == helper.ptr()) {
+          calls++;
+        }
+      }
+    }
+  }
+  EXPECT_EQ(1, loads);
+  EXPECT_EQ(1, calls);
+}
+
 }  // namespace dart
@@ -42,6 +42,7 @@ namespace dart {
   V(LICM)                                                                      \
   V(OptimisticallySpecializeSmiPhis)                                           \
   V(OptimizeBranches)                                                          \
+  V(OptimizeCidSwitches)                                                       \
   V(OptimizeTypedDataAccesses)                                                 \
   V(RangeAnalysis)                                                             \
   V(ReorderBlocks)                                                             \
@@ -52,6 +53,7 @@ namespace dart {
   V(TryOptimizePatterns)                                                       \
   V(TypePropagation)                                                           \
   V(UseTableDispatch)                                                          \
+  V(VectorizeLoops)                                                            \
   V(WidenSmiToInt32)                                                           \
   V(EliminateWriteBarriers)                                                    \
   V(TestILSerialization)                                                       \
@@ -177,6 +179,12 @@ class CompilerPass {
       CompilerPassState* state,
       std::initializer_list<CompilerPass::Id> passes);
 
+  // Reduced JIT pipeline for the first optimization of a function under
+  // --baseline_optimizing_tier. It relies on type feedback, but leaves out
+  // inlining and the expensive loop, range and allocation optimizations.
+  DART_WARN_UNUSED_RESULT
+  static FlowGraph* RunBaselinePipeline(CompilerPassState* state);
+
   // Pipeline which is used for "force-optimized" functions.
   //
   // Must not include speculative or inter-procedural optimizations.
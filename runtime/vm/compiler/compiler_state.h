@@ -75,6 +75,11 @@ class CompilerState : public ThreadStackResource {
   bool is_aot() const { return is_aot_; }
 
   bool is_optimizing() const { return is_optimizing_; }
+
+  // Whether the function is optimized with the reduced baseline pipeline,
+  // whose code counts invocations to tier up to the full pipeline.
+  bool is_baseline_tier() const { return is_baseline_tier_; }
+  void set_is_baseline_tier(bool value) { is_baseline_tier_ = value; }
   bool should_clone_fields() {
     return !is_aot() && (is_optimizing() || FLAG_force_clone_compiler_objects);
   }
@@ -134,6 +139,7 @@ class CompilerState : public ThreadStackResource {
 
   const bool is_aot_;
   const bool is_optimizing_;
+  bool is_baseline_tier_ = false;
 
   const CompilerTracing tracing_;
 
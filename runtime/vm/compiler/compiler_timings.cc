@@ -75,10 +75,11 @@ void CompilerTimings::PrintTimers(
 
       // Note: don't emit EOL because PrintTimers can print self timing.
       OS::PrintErr(
-          "%*s[%6.2f%%] %-*s %-10s", indent, "", pct, 60 - indent,
+          "%*s[%6.2f%%] %-*s %-10s %8" Pu " KB", indent, "", pct, 60 - indent,
           timer_names[timer_id],
           Timer::FormatElapsedHumanReadable(zone, timer->TotalElapsedTime(),
-                                            timer->TotalElapsedTimeCpu()));
+                                            timer->TotalElapsedTimeCpu()),
+          timers->zone_bytes_[timer_id] / KB);
 
       // Print nested timers if any or just emit EOL.
       if (timers->nested_[timer_id] != nullptr) {
@@ -90,11 +91,39 @@ void CompilerTimings::PrintTimers(
   }
 }
 
-void CompilerTimings::Print() {
+void CompilerTimings::MergeTimers(std::unique_ptr<Timers>* to,
+                                  const std::unique_ptr<Timers>& from) {
+  if (from == nullptr) return;
+  if (*to == nullptr) {
+    *to = std::make_unique<Timers>();
+  }
+  for (intptr_t i = 0; i < kNumTimers; i++) {
+    (*to)->timers_[i].AddTotal(from->timers_[i]);
+    (*to)->zone_bytes_[i] += from->zone_bytes_[i];
+    MergeTimers(&(*to)->nested_[i], from->nested_[i]);
+  }
+}
+
+void CompilerTimings::Merge(CompilerTimings* other) {
+  ASSERT(other->nested_ == &other->root_);
+  if (other->total_.running()) {
+    other->total_.Stop();
+  }
+  if (total_.running()) {
+    // Only the merged totals are accounted for, not the time in between.
+    total_.Stop();
+    total_.Reset();
+  }
+  total_.AddTotal(other->total_);
+  MergeTimers(&root_, other->root_);
+  try_inlining_success_.AddTotal(other->try_inlining_success_);
+  try_inlining_failure_.AddTotal(other->try_inlining_failure_);
+}
+
+void CompilerTimings::Print(const char* what) {
   Zone* zone = Thread::Current()->zone();
 
-  OS::PrintErr("Precompilation took: %s\n",
-               total_.FormatElapsedHumanReadable(zone));
+  OS::PrintErr("%s took: %s\n", what, total_.FormatElapsedHumanReadable(zone));
 
   PrintTimers(zone, root_, total_, 0);
 
@@ -65,6 +65,9 @@ namespace dart {
 // within two different compiler passes like |IfConvert| and |BranchSimplify|
 // then |CompilerTimings| will separate these two invocations and measure each
 // separately.
+//
+// Each timer also accumulates how much the current thread's zone grew while
+// it was running, which approximates the memory allocated by the pass.
 class CompilerTimings : public MallocAllocated {
  private:
 #define INC(Name) +1
@@ -73,6 +76,7 @@ class CompilerTimings : public MallocAllocated {
 
   struct Timers : public MallocAllocated {
     Timer timers_[kNumTimers];
+    uintptr_t zone_bytes_[kNumTimers] = {};
     std::unique_ptr<Timers> nested_[kNumTimers];
   };
 
@@ -96,8 +100,11 @@ class CompilerTimings : public MallocAllocated {
         }
 
         timer_ = &(*outer_nested_)->timers_[id];
+        zone_bytes_ = &(*outer_nested_)->zone_bytes_[id];
         stats_->nested_ = &(*outer_nested_)->nested_[id];
 
+        zone_ = thread->zone();
+        zone_size_at_start_ = zone_ != nullptr ? zone_->SizeInBytes() : 0;
         timer_->Start();
       }
     }
@@ -105,6 +112,9 @@ class CompilerTimings : public MallocAllocated {
     ~Scope() {
       if (stats_ != nullptr) {
         timer_->Stop();
+        if (zone_ != nullptr) {
+          *zone_bytes_ += zone_->SizeInBytes() - zone_size_at_start_;
+        }
         stats_->nested_ = outer_nested_;
       }
     }
@@ -112,11 +122,18 @@ class CompilerTimings : public MallocAllocated {
    private:
     CompilerTimings* const stats_;
     Timer* timer_;
+    uintptr_t* zone_bytes_;
+    Zone* zone_;
+    uintptr_t zone_size_at_start_;
     std::unique_ptr<Timers>* outer_nested_;
   };
 
   CompilerTimings() { total_.Start(); }
 
+  // Adds the timers and zone growth recorded by |other| to this instance.
+  // Stops the total timer of |other|, which must not be installed on a thread.
+  void Merge(CompilerTimings* other);
+
   void RecordInliningStatsByOutcome(bool success, const Timer& timer) {
     if (success) {
       try_inlining_success_.AddTotal(timer);
@@ -125,9 +142,13 @@ class CompilerTimings : public MallocAllocated {
     }
   }
 
-  void Print();
+  // Prints the timers, titling the report with |what| (e.g. "Precompilation").
+  void Print(const char* what);
 
  private:
+  static void MergeTimers(std::unique_ptr<Timers>* to,
+                          const std::unique_ptr<Timers>& from);
+
   void PrintTimers(Zone* zone,
                    const std::unique_ptr<CompilerTimings::Timers>& timers,
                    const Timer& total,
@@ -22,6 +22,7 @@
 #include "vm/compiler/cha.h"
 #include "vm/compiler/compiler_pass.h"
 #include "vm/compiler/compiler_state.h"
+#include "vm/compiler/compiler_timings.h"
 #include "vm/compiler/ffi/callback.h"
 #include "vm/compiler/frontend/flow_graph_builder.h"
 #include "vm/compiler/frontend/kernel_to_il.h"
@@ -53,6 +54,11 @@ DEFINE_FLAG(
     max_deoptimization_counter_threshold,
     16,
     "How many times we allow deoptimization before we disallow optimization.");
+DEFINE_FLAG(int,
+            reoptimization_backoff_limit,
+            4,
+            "Each deoptimization of a function doubles the time until it is "
+            "reoptimized, up to 2^N times the optimization counter threshold.");
 DEFINE_FLAG(charp,
             optimization_filter,
             nullptr,
@@ -67,6 +73,25 @@ DEFINE_FLAG(bool,
             false,
             "Print the deopt-id to ICData map in optimizing compiler.");
 DEFINE_FLAG(bool, print_code_source_map, false, "Print code source map.");
+DEFINE_FLAG(bool,
+            baseline_optimizing_tier,
+            false,
+            "First optimize functions with a cheaper pass list, and only run "
+            "the full optimizing pipeline once they get very hot.");
+DEFINE_FLAG(int,
+            baseline_tier_up_threshold,
+            20000,
+            "Invocation count at which baseline optimized code is recompiled "
+            "with the full optimizing pipeline.");
+DEFINE_FLAG(int,
+            background_compiler_workers,
+            1,
+            "Number of threads optimizing functions in the background.");
+DEFINE_FLAG(bool,
+            print_background_compiler_timings,
+            false,
+            "Print per-pass time and zone growth of background compilations "
+            "when the isolate group shuts down.");
 DEFINE_FLAG(bool,
             stress_test_background_compilation,
             false,
@@ -424,10 +449,36 @@ CodePtr CompileParsedFunctionHelper::FinalizeCompilation(
       }
     }
 
+#if !defined(PRODUCT)
+    // Setting a breakpoint only deoptimizes the code the function is inlined
+    // into, so make sure code compiled concurrently does not inline it.
+    if (code_is_valid) {
+      const Array& inlined = Array::Handle(code.inlined_id_to_function());
+      const intptr_t num_inlined = inlined.IsNull() ? 0 : inlined.Length();
+      Function& inlined_function = Function::Handle();
+      // The first entry is [function] itself, checked below.
+      for (intptr_t i = 1; i < num_inlined; i++) {
+        inlined_function ^= inlined.At(i);
+        if (inlined_function.HasBreakpoint()) {
+          code_is_valid = false;
+          if (trace_compiler) {
+            THR_Print("--> FAIL: Inlined function %s has a breakpoint.",
+                      inlined_function.ToFullyQualifiedCString());
+          }
+          break;
+        }
+      }
+    }
+#endif
+
     // Setting breakpoints at runtime could make a function non-optimizable.
     if (code_is_valid && Compiler::CanOptimizeFunction(thread(), function)) {
       if (osr_id() == Compiler::kNoOSRDeoptId) {
         function.InstallOptimizedCode(code);
+        if (thread()->compiler_state().is_baseline_tier()) {
+          // The next optimization of this function uses the full pipeline.
+          function.SetWasBaselineOptimized(true);
+        }
       } else {
         // OSR is not compiled in background.
         ASSERT(!Compiler::IsBackgroundCompilation());
@@ -466,6 +517,7 @@ CodePtr CompileParsedFunctionHelper::FinalizeCompilation(
     function.SaveICDataMap(
         graph_compiler->deopt_id_to_ic_data(),
         Array::Handle(zone, graph_compiler->edge_counters_array()),
+        Array::Handle(zone, graph_compiler->edge_counter_keys_array()),
         flow_graph->coverage_array());
     function.set_unoptimized_code(code);
     function.AttachCode(code);
@@ -519,6 +571,10 @@ CodePtr CompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
       CompilerState compiler_state(thread(), /*is_aot=*/false, optimized(),
                                    CompilerState::ShouldTrace(function));
       compiler_state.set_function(function);
+      compiler_state.set_is_baseline_tier(
+          FLAG_baseline_optimizing_tier && optimized() &&
+          (osr_id() == Compiler::kNoOSRDeoptId) && !function.ForceOptimize() &&
+          !function.IsIrregexpFunction() && !function.WasBaselineOptimized());
 
       {
         // Extract type feedback before the graph is built, as the graph
@@ -577,7 +633,12 @@ CodePtr CompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
         JitCallSpecializer call_specializer(flow_graph, &speculative_policy);
         pass_state.call_specializer = &call_specializer;
 
-        flow_graph = CompilerPass::RunPipeline(CompilerPass::kJIT, &pass_state);
+        if (compiler_state.is_baseline_tier()) {
+          flow_graph = CompilerPass::RunBaselinePipeline(&pass_state);
+        } else {
+          flow_graph =
+              CompilerPass::RunPipeline(CompilerPass::kJIT, &pass_state);
+        }
       }
 
       ASSERT(pass_state.inline_id_to_function.length() ==
@@ -1023,10 +1084,11 @@ class QueueElement {
 };
 
 // Allocated in C-heap. Handles both input and output of background compilation.
-// It implements a FIFO queue, using Peek, Add, Remove operations.
+// It implements a FIFO queue, using Peek, Add, Remove operations, and lets the
+// hottest function jump the queue with RemoveHottest.
 class BackgroundCompilationQueue {
  public:
-  BackgroundCompilationQueue() : first_(nullptr), last_(nullptr) {}
+  BackgroundCompilationQueue() : first_(nullptr), last_(nullptr), length_(0) {}
   virtual ~BackgroundCompilationQueue() { Clear(); }
 
   void VisitObjectPointers(ObjectPointerVisitor* visitor) {
@@ -1039,6 +1101,7 @@ class BackgroundCompilationQueue {
   }
 
   bool IsEmpty() const { return first_ == nullptr; }
+  intptr_t Length() const { return length_; }
 
   void Add(QueueElement* value) {
     ASSERT(value != nullptr);
@@ -1051,6 +1114,7 @@ class BackgroundCompilationQueue {
       last_->set_next(value);
     }
     last_ = value;
+    length_++;
     ASSERT(first_ != nullptr && last_ != nullptr);
   }
 
@@ -1072,9 +1136,50 @@ class BackgroundCompilationQueue {
     if (first_ == nullptr) {
       last_ = nullptr;
     }
+    length_--;
+    result->set_next(nullptr);
     return result;
   }
 
+  // Removes the element whose function has the highest usage counter, the
+  // oldest one among equally hot functions. The counters keep changing while
+  // functions wait, so they are compared when an element is taken rather than
+  // when it is added.
+  QueueElement* RemoveHottest(Function* scratch) {
+    ASSERT(first_ != nullptr);
+    QueueElement* hottest = first_;
+    *scratch = hottest->Function();
+    intptr_t hottest_usage = scratch->usage_counter();
+    for (QueueElement* p = first_->next(); p != nullptr; p = p->next()) {
+      *scratch = p->Function();
+      if (scratch->usage_counter() > hottest_usage) {
+        hottest = p;
+        hottest_usage = scratch->usage_counter();
+      }
+    }
+    RemoveElement(hottest);
+    return hottest;
+  }
+
+  void RemoveElement(QueueElement* element) {
+    ASSERT(element != nullptr);
+    if (element == first_) {
+      Remove();
+      return;
+    }
+    QueueElement* previous = first_;
+    while (previous->next() != element) {
+      previous = previous->next();
+      ASSERT(previous != nullptr);
+    }
+    previous->set_next(element->next());
+    if (element == last_) {
+      last_ = previous;
+    }
+    length_--;
+    element->set_next(nullptr);
+  }
+
   bool ContainsObj(const Object& obj) const {
     QueueElement* p = first_;
     while (p != nullptr) {
@@ -1091,12 +1196,13 @@ class BackgroundCompilationQueue {
       QueueElement* e = Remove();
       delete e;
     }
-    ASSERT((first_ == nullptr) && (last_ == nullptr));
+    ASSERT((first_ == nullptr) && (last_ == nullptr) && (length_ == 0));
   }
 
  private:
   QueueElement* first_;
   QueueElement* last_;
+  intptr_t length_;
 
   DISALLOW_COPY_AND_ASSIGN(BackgroundCompilationQueue);
 };
@@ -1119,13 +1225,28 @@ BackgroundCompiler::BackgroundCompiler(IsolateGroup* isolate_group)
     : isolate_group_(isolate_group),
       monitor_(),
       function_queue_(new BackgroundCompilationQueue()),
+      compiling_(new BackgroundCompilationQueue()),
       running_(false),
-      done_(true),
-      disabled_depth_(0) {}
+      num_workers_(0),
+      disabled_depth_(0),
+      timings_(nullptr),
+      slowest_compilation_micros_(0),
+      slowest_compilation_function_(nullptr) {}
 
 // Fields all deleted in ::Stop; here clear them.
 BackgroundCompiler::~BackgroundCompiler() {
   delete function_queue_;
+  delete compiling_;
+  delete timings_;
+  free(slowest_compilation_function_);
+}
+
+bool BackgroundCompiler::StartWorkerLocked() {
+  if (!Dart::thread_pool()->Run<BackgroundCompilerTask>(this)) {
+    return false;
+  }
+  num_workers_++;
+  return true;
 }
 
 void BackgroundCompiler::Run() {
@@ -1142,14 +1263,42 @@ void BackgroundCompiler::Run() {
     {
       SafepointMonitorLocker ml(&monitor_);
       if (running_ && !function_queue()->IsEmpty()) {
-        element = function_queue()->Remove();
+        element = function_queue()->RemoveHottest(&function);
         function ^= element->function();
+        // Keeps other workers from compiling the function at the same time.
+        compiling_->Add(element);
       }
     }
     if (element != nullptr) {
+      // The function may have been given up on after deoptimizing too often
+      // since it was queued. Functions that already have optimized code are
+      // still compiled: they are queued again to be reoptimized.
+      CompilerTimings* timings = nullptr;
+      int64_t start_micros = 0;
+      if (function.IsOptimizable() ||
+          FLAG_stress_test_background_compilation) {
+        if (FLAG_print_background_compiler_timings) {
+          timings = new CompilerTimings();
+          thread->set_compiler_timings(timings);
+          start_micros = OS::GetCurrentMonotonicMicros();
+        }
+        Compiler::CompileOptimizedFunction(thread, function,
+                                           Compiler::kNoOSRDeoptId);
+        if (timings != nullptr) {
+          thread->set_compiler_timings(nullptr);
+        }
+      }
+      {
+        SafepointMonitorLocker ml(&monitor_);
+        compiling_->RemoveElement(element);
+        if (timings != nullptr) {
+          RecordTimingsLocked(
+              timings, function,
+              OS::GetCurrentMonotonicMicros() - start_micros);
+        }
+      }
+      delete timings;
       delete element;
-      Compiler::CompileOptimizedFunction(thread, function,
-                                         Compiler::kNoOSRDeoptId);
 
       // If an optimizable method is not optimized, put it back on
       // the background queue (unless it was passed to foreground).
@@ -1168,15 +1317,14 @@ void BackgroundCompiler::Run() {
   Thread::ExitIsolateGroupAsHelper(/*bypass_safepoint=*/false);
   {
     MonitorLocker ml(&monitor_);
-    if (running_ && !function_queue()->IsEmpty() &&
-        Dart::thread_pool()->Run<BackgroundCompilerTask>(this)) {
+    num_workers_--;
+    if (running_ && !function_queue()->IsEmpty() && StartWorkerLocked()) {
       // Successfully scheduled a new task.
-    } else {
+    } else if (num_workers_ == 0) {
       // Background compiler done. This notification must happen after the
       // thread leaves to group to avoid a shutdown race with the thread
       // registry.
       running_ = false;
-      done_ = true;
       ml.NotifyAll();
     }
   }
@@ -1189,32 +1337,39 @@ bool BackgroundCompiler::EnqueueCompilation(const Function& function) {
 
   SafepointMonitorLocker ml(&monitor_);
   if (disabled_depth_ > 0) return false;
-  if (!running_ && done_) {
+  if (!running_ && num_workers_ == 0) {
     running_ = true;
-    done_ = false;
     // If we ever wanted to run the BG compiler on the
     // `IsolateGroup::mutator_pool()` we would need to ensure the BG compiler
     // stops when it's idle - otherwise the [MutatorThreadPool]-based idle
     // notification would not work anymore.
-    if (!Dart::thread_pool()->Run<BackgroundCompilerTask>(this)) {
+    if (!StartWorkerLocked()) {
       running_ = false;
-      done_ = true;
       return false;
     }
   }
 
   ASSERT(running_);
-  if (function_queue()->ContainsObj(function)) {
+  if (function_queue()->ContainsObj(function) ||
+      compiling_->ContainsObj(function)) {
     return true;
   }
   QueueElement* elem = new QueueElement(function);
   function_queue()->Add(elem);
+  // Each worker compiles one function and then reschedules itself while the
+  // queue is not empty. More workers are only started for functions that no
+  // idle worker is about to pick up.
+  if (num_workers_ < FLAG_background_compiler_workers &&
+      num_workers_ - compiling_->Length() < function_queue()->Length()) {
+    StartWorkerLocked();
+  }
   ml.NotifyAll();
   return true;
 }
 
 void BackgroundCompiler::VisitPointers(ObjectPointerVisitor* visitor) {
   function_queue_->VisitObjectPointers(visitor);
+  compiling_->VisitObjectPointers(visitor);
 }
 
 void BackgroundCompiler::Stop() {
@@ -1222,15 +1377,50 @@ void BackgroundCompiler::Stop() {
   ASSERT(thread->isolate() == nullptr || !thread->BypassSafepoints());
   ASSERT(thread->CanAcquireSafepointLocks());
 
-  SafepointMonitorLocker ml(&monitor_);
-  StopLocked(thread, &ml);
+  {
+    SafepointMonitorLocker ml(&monitor_);
+    StopLocked(thread, &ml);
+  }
+  PrintTimings(thread);
+}
+
+void BackgroundCompiler::RecordTimingsLocked(CompilerTimings* timings,
+                                             const Function& function,
+                                             int64_t elapsed_micros) {
+  ASSERT(monitor_.IsOwnedByCurrentThread());
+  if (timings_ == nullptr) {
+    timings_ = new CompilerTimings();
+  }
+  timings_->Merge(timings);
+  if (elapsed_micros > slowest_compilation_micros_) {
+    slowest_compilation_micros_ = elapsed_micros;
+    free(slowest_compilation_function_);
+    slowest_compilation_function_ =
+        Utils::StrDup(function.ToFullyQualifiedCString());
+  }
+}
+
+void BackgroundCompiler::PrintTimings(Thread* thread) {
+  // No workers are running anymore, so the timings can be read unlocked.
+  if (timings_ == nullptr) return;
+  StackZone stack_zone(thread);
+  timings_->Print("Background compilation");
+  OS::PrintErr("Slowest background compilation: %s (%s)\n",
+               slowest_compilation_function_,
+               Timer::FormatTime(stack_zone.GetZone(),
+                                 slowest_compilation_micros_));
+  delete timings_;
+  timings_ = nullptr;
+  free(slowest_compilation_function_);
+  slowest_compilation_function_ = nullptr;
+  slowest_compilation_micros_ = 0;
 }
 
 void BackgroundCompiler::StopLocked(Thread* thread,
                                     SafepointMonitorLocker* locker) {
   running_ = false;
   function_queue_->Clear();
-  while (!done_) {
+  while (num_workers_ > 0) {
     locker->Wait();
   }
 }
@@ -1254,7 +1444,7 @@ void BackgroundCompiler::Disable() {
 
   SafepointMonitorLocker ml(&monitor_);
   disabled_depth_++;
-  if (done_) return;
+  if (num_workers_ == 0) return;
   StopLocked(thread, &ml);
 }
 
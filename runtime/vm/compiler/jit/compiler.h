@@ -18,6 +18,7 @@ class BackgroundCompilationQueue;
 class Class;
 class Code;
 class CompilationWorkQueue;
+class CompilerTimings;
 class FlowGraph;
 class Function;
 class IndirectGotoInstr;
@@ -143,18 +144,29 @@ class BackgroundCompiler {
 
   void Stop();
   void StopLocked(Thread* thread, SafepointMonitorLocker* done_locker);
+  void RecordTimingsLocked(CompilerTimings* timings,
+                           const Function& function,
+                           int64_t elapsed_micros);
+  void PrintTimings(Thread* thread);
   void Enable();
   void Disable();
-  bool IsRunning() { return !done_; }
+  bool IsRunning() { return num_workers_ > 0; }
+  bool StartWorkerLocked();
 
   IsolateGroup* isolate_group_;
 
-  Monitor monitor_;  // Controls access to the queue and running state.
+  Monitor monitor_;  // Controls access to the queues and running state.
   BackgroundCompilationQueue* function_queue_;
-  bool running_;            // While true, will try to read queue and compile.
-  bool done_;               // True if the thread is done.
+  BackgroundCompilationQueue* compiling_;  // Functions taken by workers.
+  bool running_;          // While true, will try to read queue and compile.
+  intptr_t num_workers_;  // Scheduled or running worker tasks.
   int16_t disabled_depth_;
 
+  // Aggregated over all workers when --print-background-compiler-timings.
+  CompilerTimings* timings_;
+  int64_t slowest_compilation_micros_;
+  char* slowest_compilation_function_;
+
   DISALLOW_IMPLICIT_CONSTRUCTORS(BackgroundCompiler);
 };
 
@@ -134,6 +134,11 @@ class WriteBarrierElimination : public ValueObject {
   // is processed at least once.
   BitVector* processed_blocks_;
 
+  // Number of stores which needed a write barrier before this pass and the
+  // number of those whose write barrier was removed.
+  intptr_t barrier_count_ = 0;
+  intptr_t eliminated_barrier_count_ = 0;
+
 #if defined(DEBUG)
   bool tracing_ = false;
 #else
@@ -187,6 +192,11 @@ void WriteBarrierElimination::SaveResults() {
     vector_->CopyFrom(usable_allocs_in_[i]);
     UpdateVectorForBlock(block_order_->At(i), /*finalize=*/true);
   }
+  if (tracing_) {
+    THR_Print("Removed %" Pd " of %" Pd " write barriers in %s.\n",
+              eliminated_barrier_count_, barrier_count_,
+              flow_graph_->function().ToFullyQualifiedCString());
+  }
 }
 
 static bool IsCreateLargeArray(Definition* defn) {
@@ -386,15 +396,21 @@ void WriteBarrierElimination::UpdateVectorForBlock(BlockEntryInstr* entry,
 
     if (finalize) {
       if (StoreFieldInstr* instr = current->AsStoreField()) {
+        const bool needs_barrier = instr->ShouldEmitStoreBarrier();
+        barrier_count_ += needs_barrier ? 1 : 0;
         Definition* const container = instr->instance()->definition();
         if (IsUsable(container) && vector_->Contains(Index(container))) {
           DEBUG_ASSERT(SlotEligibleForWBE(instr->slot()));
           instr->set_emit_store_barrier(kNoStoreBarrier);
+          eliminated_barrier_count_ += needs_barrier ? 1 : 0;
         }
       } else if (StoreIndexedInstr* instr = current->AsStoreIndexed()) {
+        const bool needs_barrier = instr->ShouldEmitStoreBarrier();
+        barrier_count_ += needs_barrier ? 1 : 0;
         Definition* const array = instr->array()->definition();
         if (IsUsable(array) && vector_->Contains(Index(array))) {
           instr->set_emit_store_barrier(StoreBarrierType::kNoStoreBarrier);
+          eliminated_barrier_count_ += needs_barrier ? 1 : 0;
         }
       }
     }
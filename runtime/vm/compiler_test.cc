@@ -6,7 +6,9 @@
 #include "platform/assert.h"
 #include "vm/class_finalizer.h"
 #include "vm/code_patcher.h"
+#include "vm/compiler/backend/il_test_helper.h"
 #include "vm/dart_api_impl.h"
+#include "vm/debugger.h"
 #include "vm/heap/safepoint.h"
 #include "vm/kernel_isolate.h"
 #include "vm/object.h"
@@ -100,6 +102,137 @@ ISOLATE_UNIT_TEST_CASE(OptimizeCompileFunctionOnHelperThread) {
   delete m;
 }
 
+DECLARE_FLAG(int, background_compiler_workers);
+
+ISOLATE_UNIT_TEST_CASE(OptimizeCompileFunctionsOnHelperThreads) {
+  const char* kScriptChars =
+      "class A {\n"
+      "  static foo() { return 42; }\n"
+      "  static bar() { return 43; }\n"
+      "  static baz() { return 44; }\n"
+      "}\n";
+  Dart_Handle library;
+  {
+    TransitionVMToNative transition(thread);
+    library = TestCase::LoadTestScript(kScriptChars, nullptr);
+  }
+  const Library& lib =
+      Library::Handle(Library::RawCast(Api::UnwrapHandle(library)));
+  EXPECT(ClassFinalizer::ProcessPendingClasses());
+  Class& cls =
+      Class::Handle(lib.LookupClass(String::Handle(Symbols::New(thread, "A"))));
+  EXPECT(!cls.IsNull());
+  const auto& error = cls.EnsureIsFinalized(thread);
+  EXPECT(error == Error::null());
+  const char* kNames[] = {"foo", "bar", "baz"};
+  const intptr_t kNumFunctions = ARRAY_SIZE(kNames);
+  Function* functions[kNumFunctions];
+  for (intptr_t i = 0; i < kNumFunctions; i++) {
+    functions[i] = &Function::Handle(
+        cls.LookupStaticFunction(String::Handle(String::New(kNames[i]))));
+    CompilerTest::TestCompileFunction(*functions[i]);
+    EXPECT(functions[i]->HasCode());
+    EXPECT(!functions[i]->HasOptimizedCode());
+    functions[i]->SetUsageCounter(i);
+  }
+#if !defined(PRODUCT)
+  // Constant in product mode.
+  FLAG_background_compilation = true;
+#endif
+  const intptr_t saved_workers = FLAG_background_compiler_workers;
+  FLAG_background_compiler_workers = 2;
+  auto isolate_group = thread->isolate_group();
+  for (intptr_t i = 0; i < kNumFunctions; i++) {
+    EXPECT(isolate_group->background_compiler()->EnqueueCompilation(
+        *functions[i]));
+    // Already queued.
+    EXPECT(isolate_group->background_compiler()->EnqueueCompilation(
+        *functions[i]));
+  }
+  Monitor* m = new Monitor();
+  for (intptr_t i = 0; i < kNumFunctions; i++) {
+    SafepointMonitorLocker ml(m);
+    while (!functions[i]->HasOptimizedCode()) {
+      ml.Wait(1);
+    }
+  }
+  delete m;
+  FLAG_background_compiler_workers = saved_workers;
+}
+
+DECLARE_FLAG(bool, baseline_optimizing_tier);
+
+ISOLATE_UNIT_TEST_CASE(BaselineOptimizingTier) {
+  const char* kScript = R"(
+    int foo(int x) => x + 1;
+    main() => foo(41);
+  )";
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  const auto& function = Function::Handle(GetFunction(root_library, "foo"));
+  Invoke(root_library, "main");
+  EXPECT(!function.HasOptimizedCode());
+
+  const bool saved_baseline_optimizing_tier = FLAG_baseline_optimizing_tier;
+  FLAG_baseline_optimizing_tier = true;
+  // The first optimization uses the baseline pipeline.
+  Compiler::CompileOptimizedFunction(thread, function);
+  EXPECT(function.HasOptimizedCode());
+  EXPECT(function.WasBaselineOptimized());
+  const auto& baseline_code = Code::Handle(function.CurrentCode());
+
+  // Tiering up replaces it with fully optimized code.
+  Compiler::CompileOptimizedFunction(thread, function);
+  EXPECT(function.HasOptimizedCode());
+  EXPECT(function.CurrentCode() != baseline_code.ptr());
+  EXPECT_EQ(42, Smi::Value(Smi::RawCast(Invoke(root_library, "main"))));
+  FLAG_baseline_optimizing_tier = saved_baseline_optimizing_tier;
+}
+
+#if !defined(PRODUCT)
+static bool CodeInlines(const Code& code, const Function& function) {
+  const auto& inlined = Array::Handle(code.inlined_id_to_function());
+  for (intptr_t i = 1; !inlined.IsNull() && i < inlined.Length(); i++) {
+    if (inlined.At(i) == function.ptr()) return true;
+  }
+  return false;
+}
+
+ISOLATE_UNIT_TEST_CASE(BreakpointDeoptimizesOnlyCodeContainingIt) {
+  const char* kScript = R"(
+    int target(int x) => x + 1;
+    int caller(int x) => target(x) * 2;
+    int other(int x) => x * 3;
+    main() => caller(1) + other(1);
+  )";
+  const auto& root_library = Library::Handle(LoadTestScript(kScript));
+  const auto& target = Function::Handle(GetFunction(root_library, "target"));
+  const auto& caller = Function::Handle(GetFunction(root_library, "caller"));
+  const auto& other = Function::Handle(GetFunction(root_library, "other"));
+  Invoke(root_library, "main");
+
+  Compiler::CompileOptimizedFunction(thread, caller);
+  Compiler::CompileOptimizedFunction(thread, other);
+  EXPECT(caller.HasOptimizedCode());
+  EXPECT(other.HasOptimizedCode());
+  EXPECT(CodeInlines(Code::Handle(caller.CurrentCode()), target));
+
+  Breakpoint* bpt =
+      thread->isolate()->debugger()->SetBreakpointAtEntry(target, false);
+  EXPECT(bpt != nullptr);
+  EXPECT(target.HasBreakpoint());
+
+  // Only the code [target] is inlined into is deoptimized.
+  EXPECT(!caller.HasOptimizedCode());
+  EXPECT(other.HasOptimizedCode());
+
+  // Code optimized from now on calls [target] instead of inlining it.
+  Compiler::CompileOptimizedFunction(thread, caller);
+  if (caller.HasOptimizedCode()) {
+    EXPECT(!CodeInlines(Code::Handle(caller.CurrentCode()), target));
+  }
+}
+#endif  // !defined(PRODUCT)
+
 ISOLATE_UNIT_TEST_CASE(CompileFunctionOnHelperThread) {
   // Create a simple function and compile it without optimization.
   const char* kScriptChars =
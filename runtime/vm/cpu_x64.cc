@@ -13,6 +13,7 @@
 namespace dart {
 
 DEFINE_FLAG(bool, use_sse41, true, "Use SSE 4.1 if available");
+DEFINE_FLAG(bool, use_avx2, true, "Use AVX2 if available");
 
 void CPU::FlushICache(uword start, uword size) {
   // Nothing to be done here.
@@ -31,6 +32,7 @@ bool HostCPUFeatures::sse2_supported_ = true;
 bool HostCPUFeatures::sse4_1_supported_ = false;
 bool HostCPUFeatures::popcnt_supported_ = false;
 bool HostCPUFeatures::abm_supported_ = false;
+bool HostCPUFeatures::avx2_supported_ = false;
 
 #if defined(DEBUG)
 bool HostCPUFeatures::initialized_ = false;
@@ -44,6 +46,7 @@ void HostCPUFeatures::Init() {
                       CpuInfo::FieldContains(kCpuInfoFeatures, "sse4.1");
   popcnt_supported_ = CpuInfo::FieldContains(kCpuInfoFeatures, "popcnt");
   abm_supported_ = CpuInfo::FieldContains(kCpuInfoFeatures, "abm");
+  avx2_supported_ = CpuInfo::FieldContains(kCpuInfoFeatures, "avx2");
 #if defined(DEBUG)
   initialized_ = true;
 #endif
@@ -68,6 +71,7 @@ void HostCPUFeatures::Init() {
   sse4_1_supported_ = false;
   popcnt_supported_ = false;
   abm_supported_ = false;
+  avx2_supported_ = false;
 #if defined(DEBUG)
   initialized_ = true;
 #endif
@@ -15,6 +15,7 @@
 namespace dart {
 
 DECLARE_FLAG(bool, use_sse41);
+DECLARE_FLAG(bool, use_avx2);
 
 class HostCPUFeatures : public AllStatic {
  public:
@@ -40,6 +41,10 @@ class HostCPUFeatures : public AllStatic {
     DEBUG_ASSERT(initialized_);
     return abm_supported_ && !FLAG_target_unknown_cpu;
   }
+  static bool avx2_supported() {
+    DEBUG_ASSERT(initialized_);
+    return avx2_supported_ && FLAG_use_avx2 && !FLAG_target_unknown_cpu;
+  }
 
  private:
   static const char* hardware_;
@@ -47,6 +52,7 @@ class HostCPUFeatures : public AllStatic {
   static bool sse4_1_supported_;
   static bool popcnt_supported_;
   static bool abm_supported_;
+  static bool avx2_supported_;
 #if defined(DEBUG)
   static bool initialized_;
 #endif
@@ -61,6 +67,7 @@ class TargetCPUFeatures : public AllStatic {
   static bool sse4_1_supported() { return HostCPUFeatures::sse4_1_supported(); }
   static bool popcnt_supported() { return HostCPUFeatures::popcnt_supported(); }
   static bool abm_supported() { return HostCPUFeatures::abm_supported(); }
+  static bool avx2_supported() { return HostCPUFeatures::avx2_supported(); }
   static bool double_truncate_round_supported() {
     return HostCPUFeatures::sse4_1_supported();
   }
@@ -25,6 +25,7 @@ bool CpuId::sse2_ = false;
 bool CpuId::sse41_ = false;
 bool CpuId::popcnt_ = false;
 bool CpuId::abm_ = false;
+bool CpuId::avx2_ = false;
 
 const char* CpuId::id_string_ = nullptr;
 const char* CpuId::brand_string_ = nullptr;
@@ -41,6 +42,25 @@ static void GetCpuId(int32_t level, uint32_t info[4]) {
 #endif
 }
 
+static void GetCpuIdCount(int32_t level, int32_t count, uint32_t info[4]) {
+#if defined(DART_HOST_OS_WINDOWS)
+  __cpuidex(reinterpret_cast<int*>(info), level, count);
+#else
+  __get_cpuid_count(level, count, &info[0], &info[1], &info[2], &info[3]);
+#endif
+}
+
+// Returns the state components enabled by the OS in XCR0.
+static uint64_t GetXCR0() {
+#if defined(DART_HOST_OS_WINDOWS)
+  return _xgetbv(0);
+#else
+  uint32_t eax, edx;
+  __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+  return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+}
+
 void CpuId::Init() {
   const int info_length = 4;
   uint32_t info[info_length] = {static_cast<uint32_t>(-1)};
@@ -78,6 +98,26 @@ void CpuId::Init() {
                  CpuId::popcnt_ ? "yes" : "no");
   }
 
+  // AVX2 also needs the OS to save the upper halves of the YMM registers.
+  const bool osxsave = (info[2] & (1 << 27)) != 0;
+  const bool avx = (info[2] & (1 << 28)) != 0;
+  const uint64_t kXmmYmmState = 0x6;
+  if (osxsave && avx && ((GetXCR0() & kXmmYmmState) == kXmmYmmState)) {
+    GetCpuId(0, info);
+    if (info[0] >= 7) {
+      GetCpuIdCount(7, 0, info);
+      if (FLAG_trace_cpuid) {
+        for (intptr_t i = 0; i < info_length; i++) {
+          OS::PrintErr("cpuid(7, 0) info[%" Pd "]: %0x\n", i, info[i]);
+        }
+      }
+      CpuId::avx2_ = (info[1] & (1 << 5)) != 0;
+    }
+  }
+  if (FLAG_trace_cpuid) {
+    OS::PrintErr("avx2? %s\n", CpuId::avx2_ ? "yes" : "no");
+  }
+
   GetCpuId(0x80000001, info);
   if (FLAG_trace_cpuid) {
     for (intptr_t i = 0; i < info_length; i++) {
@@ -152,6 +192,9 @@ const char* CpuId::field(CpuInfoIndices idx) {
       if (abm()) {
         p += snprintf(p, q - p, "abm ");
       }
+      if (avx2()) {
+        p += snprintf(p, q - p, "avx2 ");
+      }
       // Remove last space before returning string.
       if (p != buffer) *(p - 1) = '\0';
       return Utils::StrDup(buffer);
@@ -35,11 +35,13 @@ class CpuId : public AllStatic {
   static bool sse41() { return sse41_; }
   static bool popcnt() { return popcnt_; }
   static bool abm() { return abm_; }
+  static bool avx2() { return avx2_; }
 
   static bool sse2_;
   static bool sse41_;
   static bool popcnt_;
   static bool abm_;
+  static bool avx2_;
   static const char* id_string_;
   static const char* brand_string_;
 };
@@ -7,11 +7,15 @@
 
 #include "vm/dart.h"
 
+#include "lib/ffi_dynamic_library.h"
 #include "platform/thread_sanitizer.h"
 #include "platform/unwinding_records.h"
 
 #include "vm/app_snapshot.h"
 #include "vm/code_observers.h"
+#if !defined(DART_PRECOMPILED_RUNTIME)
+#include "vm/compiler/aot/aot_profile.h"
+#endif
 #include "vm/compiler/runtime_offsets_extracted.h"
 #include "vm/compiler/runtime_offsets_list.h"
 #include "vm/cpu.h"
@@ -41,6 +45,7 @@
 #include "vm/profiler.h"
 #include "vm/raw_object_fields.h"
 #include "vm/reverse_pc_lookup_cache.h"
+#include "vm/runtime_entry.h"
 #include "vm/service_isolate.h"
 #include "vm/simulator.h"
 #include "vm/snapshot.h"
@@ -347,6 +352,10 @@ char* Dart::DartInit(const Dart_InitializeParams* params) {
   MarkingStack::Init();
   TargetCPUFeatures::Init();
   FfiCallbackMetadata::Init();
+  NativeAssetsLibraries::Init();
+#if !defined(DART_PRECOMPILED_RUNTIME)
+  AotProfile::Init();
+#endif
 
 #if defined(USING_SIMULATOR)
   Simulator::Init();
@@ -696,6 +705,16 @@ char* Dart::Cleanup() {
   // before shutting down the thread pool.
   WaitForIsolateShutdown();
 
+#if !defined(PRODUCT)
+  if (FLAG_print_runtime_entry_stats) {
+    RuntimeEntryStats::PrintAll();
+  }
+#endif  // !defined(PRODUCT)
+
+#if !defined(DART_PRECOMPILED_RUNTIME)
+  AotProfile::WriteIfRequested();
+#endif
+
   // Shutdown the thread pool. On return, all thread pool threads have exited.
   if (FLAG_trace_shutdown) {
     OS::PrintErr("[+%" Pd64 "ms] SHUTDOWN: Deleting thread pool\n",
@@ -751,6 +770,10 @@ char* Dart::Cleanup() {
   ICData::Cleanup();
   ArgumentsDescriptor::Cleanup();
   OffsetsTable::Cleanup();
+  NativeAssetsLibraries::Cleanup();
+#if !defined(DART_PRECOMPILED_RUNTIME)
+  AotProfile::Cleanup();
+#endif
   FfiCallbackMetadata::Cleanup();
   TargetCPUFeatures::Cleanup();
   MarkingStack::Cleanup();
@@ -1795,6 +1795,21 @@ DART_EXPORT void Dart_NotifyDestroyed() {
   T->heap()->NotifyDestroyed();
 }
 
+DART_EXPORT Dart_Handle Dart_MakePermanent(Dart_Handle object,
+                                           intptr_t* frozen_size) {
+  DARTSCOPE(Thread::Current());
+  API_TIMELINE_DURATION(T);
+  if (frozen_size == nullptr) {
+    RETURN_NULL_ERROR(frozen_size);
+  }
+  const Object& obj = Object::Handle(Z, Api::UnwrapHandle(object));
+  if (obj.IsError()) {
+    return object;
+  }
+  *frozen_size = T->heap()->MakePermanent(T, obj);
+  return Api::Success();
+}
+
 DART_EXPORT void Dart_EnableHeapSampling() {
 #if !defined(PRODUCT) || defined(FORCE_INCLUDE_SAMPLING_HEAP_PROFILER)
   HeapProfileSampler::Enable(true);
@@ -2867,6 +2882,41 @@ DART_EXPORT Dart_Handle Dart_NewStringFromUTF8(const uint8_t* utf8_array,
   return Api::NewHandle(T, String::FromUTF8(utf8_array, length));
 }
 
+DART_EXPORT Dart_Handle Dart_NewStringsFromUTF8(const uint8_t* utf8_array,
+                                                const intptr_t* lengths,
+                                                intptr_t count,
+                                                Dart_Handle* strings) {
+  DARTSCOPE(Thread::Current());
+  API_TIMELINE_DURATION(T);
+  if (lengths == nullptr) {
+    RETURN_NULL_ERROR(lengths);
+  }
+  if (strings == nullptr) {
+    RETURN_NULL_ERROR(strings);
+  }
+  CHECK_LENGTH(count, Array::kMaxElements);
+  // Check all strings up front so that an error creates no handles.
+  const uint8_t* utf8 = utf8_array;
+  for (intptr_t i = 0; i < count; ++i) {
+    CHECK_LENGTH(lengths[i], String::kMaxElements);
+    if (utf8_array == nullptr && lengths[i] != 0) {
+      RETURN_NULL_ERROR(utf8_array);
+    }
+    if (!Utf8::IsValid(utf8, lengths[i])) {
+      return Api::NewError("%s expects string %" Pd " to be valid UTF-8.",
+                           CURRENT_FUNC, i);
+    }
+    utf8 += lengths[i];
+  }
+  CHECK_CALLBACK_STATE(T);
+  utf8 = utf8_array;
+  for (intptr_t i = 0; i < count; ++i) {
+    strings[i] = Api::NewHandle(T, String::FromUTF8(utf8, lengths[i]));
+    utf8 += lengths[i];
+  }
+  return Api::Success();
+}
+
 DART_EXPORT Dart_Handle Dart_NewStringFromUTF16(const uint16_t* utf16_array,
                                                 intptr_t length) {
   DARTSCOPE(Thread::Current());
@@ -3324,6 +3374,165 @@ DART_EXPORT Dart_Handle Dart_ListSetAt(Dart_Handle list,
   }
 }
 
+#define SET_LIST_RANGE(type, obj, offset, length, values)                      \
+  const type& array = type::Cast(obj);                                         \
+  if (Utils::RangeCheck(offset, length, array.Length())) {                     \
+    for (intptr_t i = 0; i < length; ++i) {                                   \
+      value_obj = Api::UnwrapHandle(values[i]);                                \
+      array.SetAt(offset + i, value_obj);                                      \
+    }                                                                          \
+    return Api::Success();                                                     \
+  }                                                                            \
+  return Api::NewError("Invalid offset/length passed into set list range");
+
+DART_EXPORT Dart_Handle Dart_ListSetRange(Dart_Handle list,
+                                          intptr_t offset,
+                                          intptr_t length,
+                                          const Dart_Handle* values) {
+  DARTSCOPE(Thread::Current());
+  if (values == nullptr) {
+    RETURN_NULL_ERROR(values);
+  }
+  // Check all values up front so that a bad value leaves the list unchanged.
+  Object& value_obj = Object::Handle(Z);
+  for (intptr_t i = 0; i < length; ++i) {
+    value_obj = Api::UnwrapHandle(values[i]);
+    if (!value_obj.IsNull() && !value_obj.IsInstance()) {
+      RETURN_TYPE_ERROR(Z, values[i], Instance);
+    }
+  }
+  const Object& obj = Object::Handle(Z, Api::UnwrapHandle(list));
+  // If the list is immutable we call into Dart for the indexed setter to
+  // get the unsupported operation exception as the result.
+  if (obj.IsArray() && !Array::Cast(obj).IsImmutable()) {
+    SET_LIST_RANGE(Array, obj, offset, length, values);
+  } else if (obj.IsGrowableObjectArray()) {
+    SET_LIST_RANGE(GrowableObjectArray, obj, offset, length, values);
+  } else if (obj.IsError()) {
+    return list;
+  } else {
+    CHECK_CALLBACK_STATE(T);
+
+    // Check and handle a dart object that implements the List interface.
+    const Instance& instance = Instance::Handle(Z, GetListInstance(Z, obj));
+    if (!instance.IsNull()) {
+      const intptr_t kNumArgs = 3;
+      const Function& function = Function::Handle(
+          Z, FindCoreLibPrivateFunction(Z, Symbols::_listSetAt()));
+      const Array& args = Array::Handle(Z, Array::New(kNumArgs));
+      args.SetAt(0, instance);
+      Integer& index_obj = Integer::Handle(Z);
+      Object& result = Object::Handle(Z);
+      for (intptr_t i = 0; i < length; ++i) {
+        value_obj = Api::UnwrapHandle(values[i]);
+        index_obj = Integer::New(offset + i);
+        args.SetAt(1, index_obj);
+        args.SetAt(2, value_obj);
+        result = DartEntry::InvokeFunction(function, args);
+        if (result.IsError()) {
+          return Api::NewHandle(T, result.ptr());
+        }
+      }
+      return Api::Success();
+    }
+    return Api::NewArgumentError(
+        "Object does not implement the 'List' interface");
+  }
+}
+
+// Encodes the Strings list[offset, offset + length) back to back into a scope
+// allocated buffer, storing the length of each encoding in [lengths].
+template <typename ListType>
+static Dart_Handle ListStringsToUTF8(Thread* thread,
+                                     const char* current_func,
+                                     const ListType& list,
+                                     intptr_t offset,
+                                     intptr_t length,
+                                     uint8_t** utf8_array,
+                                     intptr_t* lengths) {
+  if (!Utils::RangeCheck(offset, length, list.Length())) {
+    return Api::NewError("Invalid offset/length passed into access list");
+  }
+  String& str = String::Handle(thread->zone());
+  Object& element = Object::Handle(thread->zone());
+  intptr_t total_length = 0;
+  for (intptr_t i = 0; i < length; ++i) {
+    element = list.At(offset + i);
+    if (!element.IsString()) {
+      return Api::NewError("%s expects the list elements to be Strings.",
+                           current_func);
+    }
+    str ^= element.ptr();
+    lengths[i] = Utf8::Length(str);
+    total_length += lengths[i];
+  }
+  uint8_t* utf8 = Api::TopScope(thread)->zone()->Alloc<uint8_t>(total_length);
+  *utf8_array = utf8;
+  for (intptr_t i = 0; i < length; ++i) {
+    str ^= list.At(offset + i);
+    str.ToUTF8(utf8, lengths[i]);
+    utf8 += lengths[i];
+  }
+  return Api::Success();
+}
+
+DART_EXPORT Dart_Handle Dart_ListGetStringsAsUTF8(Dart_Handle list,
+                                                  intptr_t offset,
+                                                  intptr_t length,
+                                                  uint8_t** utf8_array,
+                                                  intptr_t* lengths) {
+  DARTSCOPE(Thread::Current());
+  API_TIMELINE_DURATION(T);
+  if (utf8_array == nullptr) {
+    RETURN_NULL_ERROR(utf8_array);
+  }
+  if (lengths == nullptr) {
+    RETURN_NULL_ERROR(lengths);
+  }
+  const Object& obj = Object::Handle(Z, Api::UnwrapHandle(list));
+  if (obj.IsArray()) {
+    return ListStringsToUTF8(T, CURRENT_FUNC, Array::Cast(obj), offset, length,
+                             utf8_array, lengths);
+  } else if (obj.IsGrowableObjectArray()) {
+    return ListStringsToUTF8(T, CURRENT_FUNC, GrowableObjectArray::Cast(obj),
+                             offset, length, utf8_array, lengths);
+  } else if (obj.IsError()) {
+    return list;
+  } else {
+    CHECK_CALLBACK_STATE(T);
+
+    // Check and handle a dart object that implements the List interface.
+    const Instance& instance = Instance::Handle(Z, GetListInstance(Z, obj));
+    if (!instance.IsNull()) {
+      if (offset < 0) {
+        return Api::NewError("Invalid offset/length passed into access list");
+      }
+      CHECK_LENGTH(length, Array::kMaxElements);
+      const intptr_t kNumArgs = 2;
+      const Function& function = Function::Handle(
+          Z, FindCoreLibPrivateFunction(Z, Symbols::_listGetAt()));
+      const Array& args = Array::Handle(Z, Array::New(kNumArgs));
+      args.SetAt(0, instance);
+      const Array& elements = Array::Handle(Z, Array::New(length));
+      Integer& index = Integer::Handle(Z);
+      Object& element = Object::Handle(Z);
+      for (intptr_t i = 0; i < length; ++i) {
+        index = Integer::New(offset + i);
+        args.SetAt(1, index);
+        element = DartEntry::InvokeFunction(function, args);
+        if (element.IsError()) {
+          return Api::NewHandle(T, element.ptr());
+        }
+        elements.SetAt(i, element);
+      }
+      return ListStringsToUTF8(T, CURRENT_FUNC, elements, 0, length, utf8_array,
+                               lengths);
+    }
+    return Api::NewArgumentError(
+        "Object does not implement the 'List' interface");
+  }
+}
+
 static ObjectPtr ResolveConstructor(const char* current_func,
                                     const Class& cls,
                                     const String& class_name,
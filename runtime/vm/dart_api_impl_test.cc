@@ -1634,6 +1634,37 @@ TEST_CASE(DartAPI_NewString) {
   EXPECT(Dart_IsError(invalid_str));
 }
 
+TEST_CASE(DartAPI_NewStringsFromUTF8) {
+  // "ab", "", U+4E8C, packed back to back.
+  const uint8_t data[] = {'a', 'b', 0xE4, 0xBA, 0x8c};
+  const intptr_t lengths[] = {2, 0, 3};
+  const intptr_t kCount = ARRAY_SIZE(lengths);
+  Dart_Handle strings[kCount];
+  Dart_Handle result = Dart_NewStringsFromUTF8(data, lengths, kCount, strings);
+  EXPECT_VALID(result);
+  const char* expected[] = {"ab", "", "\xE4\xBA\x8C"};
+  for (intptr_t i = 0; i < kCount; i++) {
+    EXPECT(Dart_IsString(strings[i]));
+    const char* cstr = nullptr;
+    EXPECT_VALID(Dart_StringToCString(strings[i], &cstr));
+    EXPECT_STREQ(expected[i], cstr);
+  }
+
+  // Nothing is created if any of the strings is malformed.
+  const intptr_t bad_lengths[] = {2, 2, 1};
+  strings[0] = Dart_Null();
+  result = Dart_NewStringsFromUTF8(data, bad_lengths, kCount, strings);
+  EXPECT_ERROR(result, "expects string 1 to be valid UTF-8");
+  EXPECT(Dart_IsNull(strings[0]));
+
+  result = Dart_NewStringsFromUTF8(data, nullptr, kCount, strings);
+  EXPECT(Dart_IsError(result));
+  result = Dart_NewStringsFromUTF8(data, lengths, kCount, nullptr);
+  EXPECT(Dart_IsError(result));
+  result = Dart_NewStringsFromUTF8(nullptr, lengths, kCount, strings);
+  EXPECT(Dart_IsError(result));
+}
+
 TEST_CASE(DartAPI_MalformedStringToUTF8) {
   // 1D11E = treble clef
   // [0] should be high surrogate D834
@@ -1870,6 +1901,24 @@ TEST_CASE(DartAPI_ListAccess) {
   EXPECT_VALID(result);
   EXPECT_EQ(30, value);
 
+  // Check if we can set a range of values.
+  values[0] = Dart_NewInteger(40);
+  values[1] = Dart_NewInteger(50);
+  result = Dart_ListSetRange(list_access_test_obj, 2, kRangeLength, values);
+  EXPECT(Dart_IsError(result));
+  result = Dart_ListSetRange(list_access_test_obj, kRangeOffset, kRangeLength,
+                             nullptr);
+  EXPECT(Dart_IsError(result));
+
+  result = Dart_ListSetRange(list_access_test_obj, kRangeOffset, kRangeLength,
+                             values);
+  EXPECT_VALID(result);
+  result = Dart_ListGetAsBytes(list_access_test_obj, 0, native_array, 3);
+  EXPECT_VALID(result);
+  EXPECT_EQ(10, native_array[0]);
+  EXPECT_EQ(40, native_array[1]);
+  EXPECT_EQ(50, native_array[2]);
+
   // Check that we get an exception (and not a fatal error) when
   // calling ListSetAt and ListSetAsBytes with an immutable list.
   list_access_test_obj = Dart_Invoke(lib, NewString("immutable"), 0, nullptr);
@@ -1883,6 +1932,137 @@ TEST_CASE(DartAPI_ListAccess) {
   result = Dart_ListSetAt(list_access_test_obj, 0, Dart_NewInteger(42));
   EXPECT(Dart_IsError(result));
   EXPECT(Dart_IsUnhandledExceptionError(result));
+
+  result = Dart_ListSetRange(list_access_test_obj, 0, kRangeLength, values);
+  EXPECT(Dart_IsError(result));
+  EXPECT(Dart_IsUnhandledExceptionError(result));
+}
+
+TEST_CASE(DartAPI_ListAccessUserDefinedList) {
+  const char* kScriptChars = R"(
+import 'dart:collection';
+
+class MyList extends ListBase<Object?> {
+  final _items = List<Object?>.filled(4, null);
+
+  int get length => _items.length;
+  set length(int value) => throw UnsupportedError('fixed length');
+  Object? operator [](int index) => _items[index];
+  void operator []=(int index, Object? value) {
+    _items[index] = value;
+  }
+}
+
+List testMain() => MyList();
+)";
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, nullptr);
+  Dart_Handle list = Dart_Invoke(lib, NewString("testMain"), 0, nullptr);
+  EXPECT_VALID(list);
+  EXPECT(Dart_IsList(list));
+
+  // Setting a range goes through _listSetAt for each element.
+  const intptr_t kRangeLength = 2;
+  Dart_Handle values[kRangeLength] = {Dart_NewInteger(40),
+                                      Dart_NewInteger(50)};
+  Dart_Handle result = Dart_ListSetRange(list, 1, kRangeLength, values);
+  EXPECT_VALID(result);
+  int64_t value = 0;
+  EXPECT_VALID(Dart_IntegerToInt64(Dart_ListGetAt(list, 1), &value));
+  EXPECT_EQ(40, value);
+  EXPECT_VALID(Dart_IntegerToInt64(Dart_ListGetAt(list, 2), &value));
+  EXPECT_EQ(50, value);
+  EXPECT(Dart_IsNull(Dart_ListGetAt(list, 0)));
+  EXPECT(Dart_IsNull(Dart_ListGetAt(list, 3)));
+
+  // The list's own indexed setter reports out of range indices.
+  result = Dart_ListSetRange(list, 3, kRangeLength, values);
+  EXPECT(Dart_IsError(result));
+  EXPECT(Dart_IsUnhandledExceptionError(result));
+
+  // A value that is not an Instance leaves the list unchanged.
+  values[1] = Dart_NewApiError("not an instance");
+  result = Dart_ListSetRange(list, 0, kRangeLength, values);
+  EXPECT(Dart_IsError(result));
+  EXPECT(Dart_IsNull(Dart_ListGetAt(list, 0)));
+
+  // Strings are read back through _listGetAt.
+  const uint8_t data[] = {'a', 'b', 0xE4, 0xBA, 0x8c};
+  const intptr_t lengths[] = {2, 3};
+  Dart_Handle strings[kRangeLength];
+  EXPECT_VALID(Dart_NewStringsFromUTF8(data, lengths, kRangeLength, strings));
+  EXPECT_VALID(Dart_ListSetRange(list, 2, kRangeLength, strings));
+
+  uint8_t* utf8 = nullptr;
+  intptr_t utf8_lengths[kRangeLength];
+  result =
+      Dart_ListGetStringsAsUTF8(list, 2, kRangeLength, &utf8, utf8_lengths);
+  EXPECT_VALID(result);
+  EXPECT_EQ(2, utf8_lengths[0]);
+  EXPECT_EQ(3, utf8_lengths[1]);
+  EXPECT_EQ(0, memcmp(data, utf8, ARRAY_SIZE(data)));
+
+  // Element 1 is an integer.
+  result =
+      Dart_ListGetStringsAsUTF8(list, 1, kRangeLength, &utf8, utf8_lengths);
+  EXPECT_ERROR(result, "expects the list elements to be Strings");
+  result =
+      Dart_ListGetStringsAsUTF8(list, 3, kRangeLength, &utf8, utf8_lengths);
+  EXPECT(Dart_IsUnhandledExceptionError(result));
+}
+
+TEST_CASE(DartAPI_ListGetStringsAsUTF8) {
+  const char* kScriptChars = R"(
+List growable() => ['ab', '', '\u{4E8C}', '\u{1D11E}'[0]];
+List fixed() => List<Object>.of(growable(), growable: false);
+List mixed() => ['ab', 1];
+)";
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, nullptr);
+  const char* kFunctions[] = {"growable", "fixed"};
+  for (const char* function : kFunctions) {
+    Dart_Handle list = Dart_Invoke(lib, NewString(function), 0, nullptr);
+    EXPECT_VALID(list);
+
+    uint8_t* utf8 = nullptr;
+    intptr_t lengths[4];
+    Dart_Handle result = Dart_ListGetStringsAsUTF8(list, 0, 4, &utf8, lengths);
+    EXPECT_VALID(result);
+    EXPECT_EQ(2, lengths[0]);
+    EXPECT_EQ(0, lengths[1]);
+    EXPECT_EQ(3, lengths[2]);
+    // Unpaired surrogate is encoded as replacement character.
+    EXPECT_EQ(3, lengths[3]);
+    const uint8_t expected[] = {'a', 'b', 0xE4, 0xBA, 0x8C, 0xEF, 0xBF, 0xBD};
+    EXPECT_EQ(0, memcmp(expected, utf8, ARRAY_SIZE(expected)));
+
+    // The encodings round-trip through Dart_NewStringsFromUTF8.
+    Dart_Handle strings[4];
+    EXPECT_VALID(Dart_NewStringsFromUTF8(utf8, lengths, 3, strings));
+    bool equal = false;
+    EXPECT_VALID(
+        Dart_ObjectEquals(strings[2], Dart_ListGetAt(list, 2), &equal));
+    EXPECT(equal);
+
+    result = Dart_ListGetStringsAsUTF8(list, 2, 1, &utf8, lengths);
+    EXPECT_VALID(result);
+    EXPECT_EQ(3, lengths[0]);
+    EXPECT_EQ(0, memcmp(expected + 2, utf8, 3));
+
+    result = Dart_ListGetStringsAsUTF8(list, 2, 3, &utf8, lengths);
+    EXPECT(Dart_IsError(result));
+    result = Dart_ListGetStringsAsUTF8(list, -1, 1, &utf8, lengths);
+    EXPECT(Dart_IsError(result));
+    result = Dart_ListGetStringsAsUTF8(list, 0, 1, nullptr, lengths);
+    EXPECT(Dart_IsError(result));
+    result = Dart_ListGetStringsAsUTF8(list, 0, 1, &utf8, nullptr);
+    EXPECT(Dart_IsError(result));
+  }
+
+  Dart_Handle mixed = Dart_Invoke(lib, NewString("mixed"), 0, nullptr);
+  EXPECT_VALID(mixed);
+  uint8_t* utf8 = nullptr;
+  intptr_t lengths[2];
+  Dart_Handle result = Dart_ListGetStringsAsUTF8(mixed, 0, 2, &utf8, lengths);
+  EXPECT_ERROR(result, "expects the list elements to be Strings");
 }
 
 TEST_CASE(DartAPI_MapAccess) {
@@ -8036,6 +8216,72 @@ TEST_CASE(DartAPI_PostCObject_DoesNotRunFinalizerOnFailure) {
   free(my_str);  // Never a double-free.
 }
 
+TEST_CASE(DartAPI_PostCObjects_DoesNotRunFinalizerOnFailure) {
+  char* my_str =
+      Utils::StrDup("Ownership of this memory remains with the caller");
+
+  Dart_CObject integer;
+  integer.type = Dart_CObject_kInt32;
+  integer.value.as_int32 = 42;
+  Dart_CObject data;
+  data.type = Dart_CObject_kExternalTypedData;
+  data.value.as_external_typed_data.type = Dart_TypedData_kUint8;
+  data.value.as_external_typed_data.length = strlen(my_str);
+  data.value.as_external_typed_data.data = reinterpret_cast<uint8_t*>(my_str);
+  data.value.as_external_typed_data.peer = my_str;
+  data.value.as_external_typed_data.callback = UnreachableFinalizer;
+
+  Dart_CObject* messages[] = {&integer, &data};
+  bool success = Dart_PostCObjects(ILLEGAL_PORT, 2, messages);
+  EXPECT(!success);
+
+  free(my_str);  // Never a double-free.
+}
+
+static Monitor* batch_monitor = nullptr;
+static intptr_t batch_received = 0;
+static int32_t batch_values[3];
+
+static void NewNativePort_receiveBatch(Dart_Port dest_port_id,
+                                       Dart_CObject* message) {
+  EXPECT_NOTNULL(message);
+  EXPECT_EQ(Dart_CObject_kInt32, message->type);
+  MonitorLocker ml(batch_monitor);
+  batch_values[batch_received++] = message->value.as_int32;
+  ml.Notify();
+}
+
+VM_UNIT_TEST_CASE(DartAPI_NativePortPostCObjects) {
+  Monitor monitor;
+  batch_monitor = &monitor;
+  batch_received = 0;
+  Dart_Port port_id =
+      Dart_NewNativePort("PortBatch", NewNativePort_receiveBatch, true);
+  EXPECT_NE(ILLEGAL_PORT, port_id);
+
+  Dart_CObject objects[3];
+  Dart_CObject* messages[3];
+  for (intptr_t i = 0; i < 3; i++) {
+    objects[i].type = Dart_CObject_kInt32;
+    objects[i].value.as_int32 = 10 + i;
+    messages[i] = &objects[i];
+  }
+  EXPECT(Dart_PostCObjects(port_id, 3, messages));
+  {
+    MonitorLocker ml(&monitor);
+    while (batch_received < 3) {
+      ml.Wait();
+    }
+  }
+  // Messages are delivered in order.
+  EXPECT_EQ(10, batch_values[0]);
+  EXPECT_EQ(11, batch_values[1]);
+  EXPECT_EQ(12, batch_values[2]);
+
+  EXPECT(Dart_CloseNativePort(port_id));
+  batch_monitor = nullptr;
+}
+
 VM_UNIT_TEST_CASE(DartAPI_NewNativePort) {
   // Create a port with a bogus handler.
   Dart_Port error_port = Dart_NewNativePort("Foo", nullptr, true);
@@ -9966,6 +10212,41 @@ void main() {
   EXPECT_VALID(result);
 }
 
+TEST_CASE(DartAPI_MakePermanent) {
+  const char* kScriptChars = R"(
+const table = <String>["alpha", "beta", "gamma", "delta"];
+List<String> getTable() => table;
+List<String> getMutableTable() => ["alpha", "beta"];
+)";
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, nullptr);
+  Dart_Handle table = Dart_Invoke(lib, NewString("getTable"), 0, nullptr);
+  EXPECT_VALID(table);
+  intptr_t frozen_size = -1;
+  EXPECT_VALID(Dart_MakePermanent(table, &frozen_size));
+  EXPECT(frozen_size > 0);
+  {
+    TransitionNativeToVM transition(thread);
+    GCTestHelper::CollectAllGarbage();
+    GCTestHelper::WaitForGCTasks();
+    EXPECT(Api::UnwrapHandle(table)->untag()->IsPermanent());
+  }
+  Dart_Handle element = Dart_ListGetAt(table, 3);
+  EXPECT_VALID(element);
+  const char* str = nullptr;
+  EXPECT_VALID(Dart_StringToCString(element, &str));
+  EXPECT_STREQ("delta", str);
+
+  Dart_Handle mutable_table =
+      Dart_Invoke(lib, NewString("getMutableTable"), 0, nullptr);
+  EXPECT_VALID(mutable_table);
+  EXPECT_VALID(Dart_MakePermanent(mutable_table, &frozen_size));
+  EXPECT_EQ(0, frozen_size);
+
+  EXPECT_ERROR(Dart_MakePermanent(table, nullptr),
+               "Dart_MakePermanent expects argument 'frozen_size' to be "
+               "non-null.");
+}
+
 // There exists another test by name DartAPI_Invoke_CrossLibrary.
 // However, that currently fails for the dartk configuration as it
 // uses Dart_LoadLibrary. This test here effectively tests the same
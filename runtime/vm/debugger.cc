@@ -1512,91 +1512,167 @@ bool Debugger::SetResumeAction(ResumeAction action,
   }
 }
 
-// Deoptimize all functions in the isolate.
-// TODO(hausner): Actually we only need to deoptimize those functions
-// that inline the function that contains the newly created breakpoint.
-// We currently don't have this info so we deoptimize all functions.
-void Debugger::DeoptimizeWorld() {
-#if defined(DART_PRECOMPILED_RUNTIME)
-  UNREACHABLE();
-#else
-  if (FLAG_trace_deoptimization) {
-    THR_Print("Deopt for debugger\n");
-  }
-  isolate_->set_has_attempted_stepping(true);
-
-  DeoptimizeFunctionsOnStack();
-
-  // Iterate over all classes, deoptimize functions.
-  // TODO(hausner): Could possibly be combined with RemoveOptimizedCode()
-  const ClassTable& class_table = *isolate_->group()->class_table();
-  auto thread = Thread::Current();
-  auto isolate_group = thread->isolate_group();
+#if !defined(DART_PRECOMPILED_RUNTIME)
+// Calls [visit] for every function of the isolate group that can have code:
+// the functions of all classes, their implicit closure functions and all
+// closure functions. Must be called with the program lock held for writing.
+static void ForEachFunction(Thread* thread,
+                            const std::function<void(const Function&)>& visit) {
+  const ClassTable& class_table = *thread->isolate_group()->class_table();
   auto zone = thread->zone();
-  CallSiteResetter resetter(zone);
   Class& cls = Class::Handle(zone);
   Array& functions = Array::Handle(zone);
   Function& function = Function::Handle(zone);
-  Code& code = Code::Handle(zone);
 
   const intptr_t num_classes = class_table.NumCids();
   const intptr_t num_tlc_classes = class_table.NumTopLevelCids();
-  SafepointWriteRwLocker ml(thread, isolate_group->program_lock());
   for (intptr_t i = 1; i < num_classes + num_tlc_classes; i++) {
     const intptr_t cid =
         i < num_classes ? i : ClassTable::CidFromTopLevelIndex(i - num_classes);
     if (class_table.HasValidClassAt(cid)) {
       cls = class_table.At(cid);
-
-      // Disable optimized functions.
       functions = cls.functions();
       if (!functions.IsNull()) {
         intptr_t num_functions = functions.Length();
         for (intptr_t pos = 0; pos < num_functions; pos++) {
           function ^= functions.At(pos);
           ASSERT(!function.IsNull());
-          // Force-optimized functions don't have unoptimized code and can't
-          // deoptimize. Their optimized codes are still valid.
-          if (!function.ForceOptimize()) {
-            if (function.HasOptimizedCode()) {
-              function.SwitchToUnoptimizedCode();
-            }
-            code = function.unoptimized_code();
-            if (!code.IsNull()) {
-              resetter.ResetSwitchableCalls(code);
-            }
-          }
-          // Also disable any optimized implicit closure functions.
+          visit(function);
           if (function.HasImplicitClosureFunction()) {
             function = function.ImplicitClosureFunction();
-            if (!function.ForceOptimize()) {
-              if (function.HasOptimizedCode()) {
-                function.SwitchToUnoptimizedCode();
-              }
-              code = function.unoptimized_code();
-              if (!code.IsNull()) {
-                resetter.ResetSwitchableCalls(code);
-              }
-            }
+            visit(function);
           }
         }
       }
     }
   }
-
-  // Disable optimized closure functions.
   ClosureFunctionsCache::ForAllClosureFunctions([&](const Function& function) {
-    if (!function.ForceOptimize()) {
-      if (function.HasOptimizedCode()) {
-        function.SwitchToUnoptimizedCode();
-      }
-      code = function.unoptimized_code();
-      if (!code.IsNull()) {
-        resetter.ResetSwitchableCalls(code);
+    visit(function);
+    return true;  // Continue iteration.
+  });
+}
+
+// Whether [code] was compiled for one of [functions] or has one of them
+// inlined into it.
+static bool CodeIncludesAnyOf(Zone* zone,
+                              const Code& code,
+                              const GrowableObjectArray& functions) {
+  const intptr_t num_functions = functions.Length();
+  const Array& inlined = Array::Handle(zone, code.inlined_id_to_function());
+  const intptr_t num_inlined = inlined.IsNull() ? 0 : inlined.Length();
+  const Object& owner = Object::Handle(zone, code.owner());
+  for (intptr_t i = 0; i < num_functions; i++) {
+    const ObjectPtr function = functions.At(i);
+    if (owner.ptr() == function) {
+      return true;
+    }
+    for (intptr_t j = 0; j < num_inlined; j++) {
+      if (inlined.At(j) == function) {
+        return true;
       }
     }
-    return true;  // Continue iteration.
+  }
+  return false;
+}
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+
+// Deoptimize all functions in the isolate group. Single stepping needs this,
+// since any frame may be stepped into or returned to. Breakpoints only need
+// the code containing them deoptimized, see DeoptimizeFunctions.
+void Debugger::DeoptimizeWorld() {
+#if defined(DART_PRECOMPILED_RUNTIME)
+  UNREACHABLE();
+#else
+  if (FLAG_trace_deoptimization) {
+    THR_Print("Deopt for debugger\n");
+  }
+  isolate_->set_has_attempted_stepping(true);
+
+  DeoptimizeFunctionsOnStack();
+
+  auto thread = Thread::Current();
+  auto isolate_group = thread->isolate_group();
+  auto zone = thread->zone();
+  CallSiteResetter resetter(zone);
+  Code& code = Code::Handle(zone);
+
+  SafepointWriteRwLocker ml(thread, isolate_group->program_lock());
+  ForEachFunction(thread, [&](const Function& function) {
+    // Force-optimized functions don't have unoptimized code and can't
+    // deoptimize. Their optimized codes are still valid.
+    if (function.ForceOptimize()) {
+      return;
+    }
+    if (function.HasOptimizedCode()) {
+      function.SwitchToUnoptimizedCode();
+    }
+    code = function.unoptimized_code();
+    if (!code.IsNull()) {
+      resetter.ResetSwitchableCalls(code);
+    }
+  });
+#endif  // defined(DART_PRECOMPILED_RUNTIME)
+}
+
+// Deoptimize the code of [functions] and all optimized code they are inlined
+// into, so that code breakpoints set in their unoptimized code are hit.
+// Functions with breakpoints are neither optimized nor inlined later on (see
+// Compiler::CanOptimizeFunction and Function::CanBeInlined).
+void Debugger::DeoptimizeFunctions(const GrowableObjectArray& functions) {
+#if defined(DART_PRECOMPILED_RUNTIME)
+  UNREACHABLE();
+#else
+  if (FLAG_trace_deoptimization) {
+    THR_Print("Deopt for breakpoint\n");
+  }
+  // Code breakpoints patch the instance call stubs of the unoptimized code,
+  // which requires its switchable calls to stay unlinked.
+  isolate_->set_has_attempted_stepping(true);
+
+  auto thread = Thread::Current();
+  auto isolate_group = thread->isolate_group();
+  auto zone = thread->zone();
+  CallSiteResetter resetter(zone);
+  Code& code = Code::Handle(zone);
+
+  SafepointWriteRwLocker ml(thread, isolate_group->program_lock());
+  isolate_group->ForEachIsolate(
+      [&](Isolate* isolate) {
+        auto mutator_thread = isolate->mutator_thread();
+        if (mutator_thread == nullptr) {
+          return;
+        }
+        DartFrameIterator iterator(
+            mutator_thread, StackFrameIterator::kAllowCrossThreadIteration);
+        for (StackFrame* frame = iterator.NextFrame(); frame != nullptr;
+             frame = iterator.NextFrame()) {
+          code = frame->LookupDartCode();
+          if (code.is_optimized() && !code.is_force_optimized() &&
+              CodeIncludesAnyOf(zone, code, functions)) {
+            DeoptimizeAt(mutator_thread, code, frame);
+          }
+        }
+      },
+      /*at_safepoint=*/true);
+
+  ForEachFunction(thread, [&](const Function& function) {
+    if (function.ForceOptimize() || !function.HasOptimizedCode()) {
+      return;
+    }
+    code = function.CurrentCode();
+    if (CodeIncludesAnyOf(zone, code, functions)) {
+      function.SwitchToUnoptimizedCode();
+    }
   });
+
+  Function& function = Function::Handle(zone);
+  for (intptr_t i = 0; i < functions.Length(); i++) {
+    function ^= functions.At(i);
+    code = function.unoptimized_code();
+    if (!code.IsNull()) {
+      resetter.ResetSwitchableCalls(code);
+    }
+  }
 #endif  // defined(DART_PRECOMPILED_RUNTIME)
 }
 
@@ -1612,6 +1688,18 @@ void Debugger::RunWithStoppedDeoptimizedWorld(std::function<void()> fun) {
 #endif
 }
 
+void Debugger::RunWithStoppedDeoptimizedFunctions(
+    const GrowableObjectArray& functions,
+    std::function<void()> fun) {
+#if !defined(DART_PRECOMPILED_RUNTIME)
+  RELOAD_OPERATION_SCOPE(Thread::Current());
+  group_debugger()->isolate_group()->RunWithStoppedMutators([&]() {
+    DeoptimizeFunctions(functions);
+    fun();
+  });
+#endif
+}
+
 void Debugger::NotifySingleStepping(bool value) {
   if (value) {
     // Setting breakpoint requires unoptimized code, make sure we stop all
@@ -2637,8 +2725,8 @@ BreakpointLocation* Debugger::SetBreakpoint(
       BreakpointLocation* loc = nullptr;
       // Ensure that code stays deoptimized (and background compiler disabled)
       // until we have installed the breakpoint (at which point the compiler
-      // will not try to optimize it anymore).
-      RunWithStoppedDeoptimizedWorld([&] {
+      // will not try to optimize or inline it anymore).
+      RunWithStoppedDeoptimizedFunctions(code_functions, [&] {
         loc = SetCodeBreakpoints(scripts, token_pos, last_token_pos,
                                  requested_line, requested_column,
                                  exact_token_pos, code_functions);
@@ -802,7 +802,10 @@ class Debugger {
                    TokenPosition last_token_pos,
                    Function* best_fit);
   void DeoptimizeWorld();
+  void DeoptimizeFunctions(const GrowableObjectArray& functions);
   void RunWithStoppedDeoptimizedWorld(std::function<void()> fun);
+  void RunWithStoppedDeoptimizedFunctions(const GrowableObjectArray& functions,
+                                          std::function<void()> fun);
   void NotifySingleStepping(bool value);
   BreakpointLocation* SetCodeBreakpoints(
       const GrowableHandlePtrArray<const Script>& scripts,
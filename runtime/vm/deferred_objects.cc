@@ -15,6 +15,7 @@
 
 namespace dart {
 
+DECLARE_FLAG(int, reoptimization_backoff_limit);
 DECLARE_FLAG(bool, trace_deoptimization);
 DECLARE_FLAG(bool, trace_deoptimization_verbose);
 
@@ -146,6 +147,26 @@ void DeferredRetAddr::Materialize(DeoptContext* deopt_context) {
   }
 }
 
+// Returns the usage counter to restart [function] with after it
+// deoptimized. A function which deoptimized several times is likely to
+// repeat with the feedback collected so far, so every deoptimization
+// doubles the time until it is reoptimized. The number of reoptimizations is
+// capped by --max-deoptimization-counter-threshold.
+static int32_t ReoptimizationUsageCounter(Thread* thread,
+                                          const Function& function) {
+  const intptr_t threshold =
+      thread->isolate_group()->optimization_counter_threshold();
+  const intptr_t deopts = function.deoptimization_counter();
+  if ((threshold <= 0) || (deopts <= 1)) {
+    return 0;
+  }
+  const intptr_t shift = Utils::Minimum<intptr_t>(
+      deopts - 1, Utils::Maximum(FLAG_reoptimization_backoff_limit, 0));
+  const int64_t delay = static_cast<int64_t>(threshold) *
+                        ((static_cast<int64_t>(1) << shift) - 1);
+  return -static_cast<int32_t>(Utils::Minimum<int64_t>(delay, kMaxInt32));
+}
+
 void DeferredPcMarker::Materialize(DeoptContext* deopt_context) {
   Thread* thread = deopt_context->thread();
   Zone* zone = deopt_context->zone();
@@ -182,7 +203,7 @@ void DeferredPcMarker::Materialize(DeoptContext* deopt_context) {
   }
   // Clear invocation counter so that hopefully the function gets reoptimized
   // only after more feedback has been collected.
-  function.SetUsageCounter(0);
+  function.SetUsageCounter(ReoptimizationUsageCounter(thread, function));
   if (function.HasOptimizedCode()) {
     function.SwitchToUnoptimizedCode();
   }
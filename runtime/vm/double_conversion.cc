@@ -152,11 +152,58 @@ StringPtr DoubleToStringAsPrecision(double d, int precision) {
   return String::New(builder.Finalize());
 }
 
+// Parses [str] if it is a plain decimal numeral like "-123.45" with at most 15
+// digits. Both the digits, read as an integer, and the power of ten for the
+// fraction digits are then exact doubles, so a single (correctly rounded)
+// division yields the correctly rounded result. Returns false for anything
+// else, which is left to the double-conversion library.
+static bool SimpleDecimalToDouble(const char* str,
+                                  intptr_t length,
+                                  double* result) {
+  static constexpr intptr_t kMaxDigits = 15;
+  static constexpr double kPowersOfTen[kMaxDigits + 1] = {
+      1e0, 1e1, 1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+      1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15};
+
+  // Allow for a sign and a decimal point. This also keeps [digits] from
+  // overflowing below.
+  if (length > kMaxDigits + 2) return false;
+  intptr_t i = 0;
+  const bool is_negative = str[0] == '-';
+  if (is_negative) i++;
+  int64_t digits = 0;
+  const intptr_t digits_start = i;
+  while (i < length && Utils::IsDecimalDigit(str[i])) {
+    digits = digits * 10 + (str[i++] - '0');
+  }
+  if (i == digits_start) return false;
+  intptr_t fraction_digits = 0;
+  if (i < length && str[i] == '.') {
+    const intptr_t fraction_start = ++i;
+    while (i < length && Utils::IsDecimalDigit(str[i])) {
+      digits = digits * 10 + (str[i++] - '0');
+    }
+    fraction_digits = i - fraction_start;
+    if (fraction_digits == 0) return false;
+  }
+  if (i != length) return false;
+  // Count the digits just scanned, not the sign and decimal point.
+  if (length - is_negative - (fraction_digits > 0) > kMaxDigits) return false;
+  double value = static_cast<double>(digits);
+  if (fraction_digits > 0) value /= kPowersOfTen[fraction_digits];
+  *result = is_negative ? -value : value;
+  return true;
+}
+
 bool CStringToDouble(const char* str, intptr_t length, double* result) {
   if (length == 0) {
     return false;
   }
 
+  if (SimpleDecimalToDouble(str, length, result)) {
+    return true;
+  }
+
   double_conversion::StringToDoubleConverter converter(
       double_conversion::StringToDoubleConverter::NO_FLAGS, 0.0, 0.0,
       kInfinitySymbol, kNaNSymbol);
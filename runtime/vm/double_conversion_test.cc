@@ -0,0 +1,92 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/double_conversion.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "platform/assert.h"
+#include "platform/utils.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+static void ExpectParsesLikeStrtod(const char* str) {
+  double result = 0.0;
+  EXPECT(CStringToDouble(str, strlen(str), &result));
+  const double expected = strtod(str, nullptr);
+  // Compare bits so that 0.0 and -0.0 are told apart.
+  EXPECT_EQ(bit_cast<int64_t>(expected), bit_cast<int64_t>(result));
+}
+
+VM_UNIT_TEST_CASE(CStringToDouble_Integers) {
+  ExpectParsesLikeStrtod("0");
+  ExpectParsesLikeStrtod("123");
+  ExpectParsesLikeStrtod("-123");
+  // 15 digits take the fast path, 16 and more do not.
+  ExpectParsesLikeStrtod("999999999999999");
+  ExpectParsesLikeStrtod("-999999999999999");
+  ExpectParsesLikeStrtod("9007199254740993");
+  ExpectParsesLikeStrtod("-9007199254740993");
+  ExpectParsesLikeStrtod("12345678901234567890");
+}
+
+VM_UNIT_TEST_CASE(CStringToDouble_Fractions) {
+  ExpectParsesLikeStrtod("0.1");
+  ExpectParsesLikeStrtod("-0.5");
+  ExpectParsesLikeStrtod("3.14159");
+  // 15 and 16 significant digits, with and without a sign.
+  ExpectParsesLikeStrtod("0.12345678901234");
+  ExpectParsesLikeStrtod("1.23456789012345");
+  ExpectParsesLikeStrtod("-1.23456789012345");
+  ExpectParsesLikeStrtod("1.234567890123456");
+  ExpectParsesLikeStrtod("-1.234567890123456");
+  ExpectParsesLikeStrtod("0.3333333333333333");
+}
+
+VM_UNIT_TEST_CASE(CStringToDouble_NegativeZero) {
+  double result = 0.0;
+  EXPECT(CStringToDouble("-0", 2, &result));
+  EXPECT_EQ(0.0, result);
+  EXPECT(signbit(result));
+  EXPECT(CStringToDouble("-0.0", 4, &result));
+  EXPECT_EQ(0.0, result);
+  EXPECT(signbit(result));
+  EXPECT(CStringToDouble("0.0", 3, &result));
+  EXPECT(!signbit(result));
+}
+
+VM_UNIT_TEST_CASE(CStringToDouble_TrailingDecimalPoint) {
+  // Rejected by the fast path and accepted by the full converter.
+  double result = 0.0;
+  EXPECT(CStringToDouble("1.", 2, &result));
+  EXPECT_EQ(1.0, result);
+  EXPECT(CStringToDouble("-25.", 4, &result));
+  EXPECT_EQ(-25.0, result);
+}
+
+VM_UNIT_TEST_CASE(CStringToDouble_LeadingZeros) {
+  // Few significant digits, but too long for the fast path.
+  ExpectParsesLikeStrtod("000000000000000001");
+  ExpectParsesLikeStrtod("-000000000000000001");
+  ExpectParsesLikeStrtod("0000000000000000.5");
+  ExpectParsesLikeStrtod("0.00000000000000001");
+  ExpectParsesLikeStrtod("00000000000000012.25");
+}
+
+VM_UNIT_TEST_CASE(CStringToDouble_Invalid) {
+  double result = 0.0;
+  EXPECT(!CStringToDouble("", 0, &result));
+  EXPECT(!CStringToDouble("-", 1, &result));
+  EXPECT(!CStringToDouble(".", 1, &result));
+  EXPECT(!CStringToDouble("1.2.3", 5, &result));
+  EXPECT(!CStringToDouble("12a", 3, &result));
+  // Only the first [length] characters are parsed.
+  EXPECT(CStringToDouble("12a", 2, &result));
+  EXPECT_EQ(12.0, result);
+}
+
+}  // namespace dart
@@ -663,11 +663,13 @@ void Dwarf::WriteSyntheticLineNumberProgram(LineNumberProgramWriter* writer) {
 
 void Dwarf::WriteLineNumberProgramFromCodeSourceMaps(
     LineNumberProgramWriter* writer) {
-  Function& root_function = Function::Handle(zone_);
+  Function& function = Function::Handle(zone_);
   Script& script = Script::Handle(zone_);
   CodeSourceMap& map = CodeSourceMap::Handle(zone_);
   Array& functions = Array::Handle(zone_);
-  GrowableArray<const Function*> function_stack(zone_, 8);
+  // The file index of the script of each function on the inlining stack,
+  // so rows don't need a script lookup.
+  GrowableArray<intptr_t> file_stack(zone_, 8);
   GrowableArray<DwarfPosition> token_positions(zone_, 8);
 
   for (intptr_t i = 0; i < codes_.length(); i++) {
@@ -679,13 +681,13 @@ void Dwarf::WriteLineNumberProgramFromCodeSourceMaps(
     if (map.IsNull()) {
       continue;
     }
-    root_function = code.function();
+    function = code.function();
     functions = code.inlined_id_to_function();
 
     NoSafepointScope no_safepoint;
     ReadStream code_map_stream(map.Data(), map.Length());
 
-    function_stack.Clear();
+    file_stack.Clear();
     token_positions.Clear();
 
     // CodeSourceMap might start in the following way:
@@ -709,7 +711,8 @@ void Dwarf::WriteLineNumberProgramFromCodeSourceMaps(
     bool function_entry_position_was_emitted = false;
 
     int32_t current_pc_offset = 0;
-    function_stack.Add(&root_function);
+    script = function.script();
+    file_stack.Add(LookupScript(script));
     token_positions.Add(kNoDwarfPositionInfo);
 
     while (code_map_stream.PendingBytes() > 0) {
@@ -726,9 +729,7 @@ void Dwarf::WriteLineNumberProgramFromCodeSourceMaps(
         case CodeSourceMapOps::kAdvancePC: {
           // Emit a row for the previous PC value if the source location
           // changed since the last row was emitted.
-          const Function& function = *(function_stack.Last());
-          script = function.script();
-          const intptr_t file = LookupScript(script);
+          const intptr_t file = file_stack.Last();
           const intptr_t line = token_positions.Last().line();
           const intptr_t column = token_positions.Last().column();
           intptr_t pc_offset_adjustment = 0;
@@ -758,17 +759,17 @@ void Dwarf::WriteLineNumberProgramFromCodeSourceMaps(
           break;
         }
         case CodeSourceMapOps::kPushFunction: {
-          auto child_func =
-              &Function::Handle(zone_, Function::RawCast(functions.At(arg1)));
-          function_stack.Add(child_func);
+          function ^= functions.At(arg1);
+          script = function.script();
+          file_stack.Add(LookupScript(script));
           token_positions.Add(kNoDwarfPositionInfo);
           break;
         }
         case CodeSourceMapOps::kPopFunction: {
           // We never pop the root function.
-          ASSERT(function_stack.length() > 1);
+          ASSERT(file_stack.length() > 1);
           ASSERT(token_positions.length() > 1);
-          function_stack.RemoveLast();
+          file_stack.RemoveLast();
           token_positions.RemoveLast();
           break;
         }
@@ -0,0 +1,51 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "lib/ffi_dynamic_library.h"
+
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "platform/assert.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+VM_UNIT_TEST_CASE(NativeAssetsLibraries_LoadsOnce) {
+  char* error = nullptr;
+  void* const handle = NativeAssetsLibraries::Load(nullptr, &error);
+  EXPECT(error == nullptr);
+  EXPECT(handle != nullptr);
+
+  // Concurrent loads of a library all get the cached handle.
+  const intptr_t kThreads = 8;
+  std::vector<void*> handles(kThreads, nullptr);
+  std::vector<std::thread> threads;
+  for (intptr_t i = 0; i < kThreads; i++) {
+    threads.push_back(std::thread([&handles, i]() {
+      char* error = nullptr;
+      handles[i] = NativeAssetsLibraries::Load(nullptr, &error);
+      EXPECT(error == nullptr);
+    }));
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (intptr_t i = 0; i < kThreads; i++) {
+    EXPECT_EQ(handle, handles[i]);
+  }
+}
+
+VM_UNIT_TEST_CASE(NativeAssetsLibraries_FailedLoadIsNotCached) {
+  const char* kPath = "/does/not/exist/libnative_asset_test.so";
+  for (intptr_t i = 0; i < 2; i++) {
+    char* error = nullptr;
+    EXPECT(NativeAssetsLibraries::Load(kPath, &error) == nullptr);
+    EXPECT(error != nullptr);
+    EXPECT_SUBSTRING("libnative_asset_test.so", error);
+    free(error);
+  }
+}
+
+}  // namespace dart
@@ -60,7 +60,12 @@ bool FieldTable::Register(const Field& field, intptr_t expected_field_id) {
   if (free_head_ < 0) {
     bool grown_backing_store = false;
     if (top_ == capacity_) {
-      const intptr_t new_capacity = capacity_ + kCapacityIncrement;
+      // Grow geometrically: the old backing stores are only freed at the next
+      // GC, so growing by a constant amount while a large program registers
+      // its static fields would retain and copy quadratically many slots.
+      const intptr_t increment =
+          Utils::Maximum<intptr_t>(kCapacityIncrement, capacity_ / 2);
+      const intptr_t new_capacity = capacity_ + increment;
       Grow(new_capacity);
       grown_backing_store = true;
     }
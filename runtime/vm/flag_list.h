@@ -95,6 +95,8 @@ constexpr bool FLAG_support_il_printer = false;
     "The number of tasks to use for parallel compaction.")                     \
   P(concurrent_mark, bool, true, "Concurrent mark for old generation.")        \
   P(concurrent_sweep, bool, true, "Concurrent sweep for old generation.")      \
+  P(sweeper_tasks, int, 2,                                                     \
+    "The number of tasks to use for concurrent sweeping.")                     \
   C(deoptimize_alot, false, false, bool, false,                                \
     "Deoptimizes we are about to return to Dart code from native entries.")    \
   C(deoptimize_every, 0, 0, int, 0,                                            \
@@ -128,6 +130,9 @@ constexpr bool FLAG_support_il_printer = false;
   P(idle_duration_micros, int, kMaxInt32,                                      \
     "Allow idle tasks to run for this long.")                                  \
   P(interpret_irregexp, bool, false, "Use irregexp bytecode interpreter")      \
+  P(regexp_tier_up_threshold, int, 0,                                          \
+    "Interpret a regexp this many times before compiling it to machine "      \
+    "code (0 means compile on first use).")                                    \
   P(lazy_async_stacks, bool, true, "Obsolete, ignored.")                       \
   P(link_natives_lazily, bool, false, "Link native calls lazily")              \
   R(log_marker_tasks, false, bool, false,                                      \
@@ -166,6 +171,8 @@ constexpr bool FLAG_support_il_printer = false;
   P(polymorphic_with_deopt, bool, true,                                        \
     "Polymorphic calls with deoptimization / megamorphic call")                \
   P(precompiled_mode, bool, false, "Precompilation compiler mode")             \
+  R(print_runtime_entry_stats, false, bool, false,                             \
+    "Print call counts and times of runtime entries at VM shutdown.")          \
   P(print_snapshot_sizes, bool, false, "Print sizes of generated snapshots.")  \
   P(print_snapshot_sizes_verbose, bool, false,                                 \
     "Print cluster sizes of generated snapshots.")                             \
@@ -94,7 +94,7 @@ class Handles {
 
   // Allocates space for a scoped handle.
   uword AllocateScopedHandle() {
-    if (scoped_blocks_->IsFull()) {
+    if (UNLIKELY(scoped_blocks_->IsFull())) {
       SetupNextScopeBlock();
     }
     return scoped_blocks_->AllocateHandle();
@@ -209,7 +209,7 @@ class Handles {
 
   // Allocates space for a zone handle.
   uword AllocateHandleInZone() {
-    if (zone_blocks_ == nullptr || zone_blocks_->IsFull()) {
+    if (UNLIKELY(zone_blocks_ == nullptr || zone_blocks_->IsFull())) {
       SetupNextZoneBlock();
     }
     return zone_blocks_->AllocateHandle();
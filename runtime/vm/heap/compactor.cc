@@ -583,7 +583,9 @@ uword CompactorTask::SlideBlock(uword first_object,
           static_cast<TypedDataPtr>(new_obj)->untag()->RecomputeDataField();
         }
       }
-      new_obj->untag()->ClearMarkBit();
+      if (!new_obj->untag()->IsPermanent()) {
+        new_obj->untag()->ClearMarkBit();
+      }
       new_obj->untag()->VisitPointers(compactor_);
 
       ASSERT(free_current_ == new_addr);
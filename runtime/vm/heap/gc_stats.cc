@@ -0,0 +1,204 @@
+// Copyright (c) 2024, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/heap/gc_stats.h"
+
+#include "platform/utils.h"
+#include "vm/heap/heap.h"
+#include "vm/json_stream.h"
+#include "vm/lockers.h"
+#include "vm/os.h"
+#include "vm/timeline.h"
+
+namespace dart {
+
+intptr_t PauseHistogram::BucketFor(int64_t micros) {
+  if (micros < (1 << kSubBucketBits)) {
+    return micros < 0 ? 0 : static_cast<intptr_t>(micros);
+  }
+  const intptr_t highest_bit = Utils::HighestBit(micros);
+  if (highest_bit >= kMaxValueBits) {
+    return kNumBuckets - 1;
+  }
+  const intptr_t shift = highest_bit - (kSubBucketBits - 1);
+  return shift * kHalfSubBuckets + static_cast<intptr_t>(micros >> shift);
+}
+
+int64_t PauseHistogram::BucketLimit(intptr_t bucket) {
+  ASSERT((bucket >= 0) && (bucket < kNumBuckets));
+  if (bucket < (1 << kSubBucketBits)) {
+    return bucket;
+  }
+  const intptr_t shift = bucket / kHalfSubBuckets - 1;
+  const int64_t lower = static_cast<int64_t>(bucket - shift * kHalfSubBuckets)
+                        << shift;
+  return lower + (static_cast<int64_t>(1) << shift) - 1;
+}
+
+void PauseHistogram::Add(int64_t micros) {
+  buckets_[BucketFor(micros)]++;
+  count_++;
+  total_micros_ += micros;
+  max_micros_ = Utils::Maximum(max_micros_, micros);
+}
+
+void PauseHistogram::Reset() {
+  count_ = 0;
+  total_micros_ = 0;
+  max_micros_ = 0;
+  for (intptr_t i = 0; i < kNumBuckets; i++) {
+    buckets_[i] = 0;
+  }
+}
+
+int64_t PauseHistogram::Percentile(double percentile) const {
+  if (count_ == 0) {
+    return 0;
+  }
+  ASSERT((percentile >= 0.0) && (percentile <= 100.0));
+  int64_t rank = static_cast<int64_t>(count_ * percentile / 100.0 + 0.5);
+  rank = Utils::Minimum(Utils::Maximum(rank, static_cast<int64_t>(1)), count_);
+  int64_t seen = 0;
+  for (intptr_t i = 0; i < kNumBuckets; i++) {
+    seen += buckets_[i];
+    if (seen >= rank) {
+      return Utils::Minimum(BucketLimit(i), max_micros_);
+    }
+  }
+  UNREACHABLE();
+  return max_micros_;
+}
+
+#ifndef PRODUCT
+void PauseHistogram::PrintJSON(JSONObject* jsobj) const {
+  jsobj->AddProperty64("count", count_);
+  jsobj->AddProperty64("totalMicros", total_micros_);
+  jsobj->AddProperty64("maxMicros", max_micros_);
+  jsobj->AddProperty64("p50Micros", Percentile(50));
+  jsobj->AddProperty64("p90Micros", Percentile(90));
+  jsobj->AddProperty64("p99Micros", Percentile(99));
+  jsobj->AddProperty64("p999Micros", Percentile(99.9));
+  // Only the non-empty buckets, as [limit in micros, count] pairs.
+  JSONArray buckets(jsobj, "buckets");
+  for (intptr_t i = 0; i < kNumBuckets; i++) {
+    if (buckets_[i] != 0) {
+      JSONArray bucket(&buckets);
+      bucket.AddValue64(BucketLimit(i));
+      bucket.AddValue64(buckets_[i]);
+    }
+  }
+}
+#endif  // !PRODUCT
+
+const char* GCPauseStats::PhaseName(GCPhase phase) {
+  switch (phase) {
+#define PHASE_NAME(name, json_name)                                            \
+  case GCPhase::k##name:                                                       \
+    return json_name;
+    GC_PHASE_LIST(PHASE_NAME)
+#undef PHASE_NAME
+    default:
+      UNREACHABLE();
+      return "";
+  }
+}
+
+void GCPauseStats::RecordPause(GCType type, int64_t micros) {
+  {
+    MutexLocker ml(&mutex_);
+    pauses_[static_cast<intptr_t>(type)].Add(micros);
+    for (intptr_t i = 0; i < kNumPhases; i++) {
+      const int64_t phase_micros = pending_phase_micros_[i].exchange(0);
+      if (phase_micros != 0) {
+        phases_[i].Add(phase_micros);
+      }
+    }
+  }
+  PrintCountersToTimeline(type);
+}
+
+int64_t GCPauseStats::PausePercentile(GCType type, double percentile) {
+  MutexLocker ml(&mutex_);
+  return pauses_[static_cast<intptr_t>(type)].Percentile(percentile);
+}
+
+int64_t GCPauseStats::PhasePercentile(GCPhase phase, double percentile) {
+  MutexLocker ml(&mutex_);
+  return phases_[static_cast<intptr_t>(phase)].Percentile(percentile);
+}
+
+int64_t GCPauseStats::PauseCount(GCType type) {
+  MutexLocker ml(&mutex_);
+  return pauses_[static_cast<intptr_t>(type)].Count();
+}
+
+int64_t GCPauseStats::PhaseCount(GCPhase phase) {
+  MutexLocker ml(&mutex_);
+  return phases_[static_cast<intptr_t>(phase)].Count();
+}
+
+void GCPauseStats::Reset() {
+  MutexLocker ml(&mutex_);
+  for (intptr_t i = 0; i < kNumTypes; i++) {
+    pauses_[i].Reset();
+  }
+  for (intptr_t i = 0; i < kNumPhases; i++) {
+    phases_[i].Reset();
+    pending_phase_micros_[i] = 0;
+  }
+}
+
+void GCPauseStats::PrintCountersToTimeline(GCType type) {
+#if defined(SUPPORT_TIMELINE)
+  TimelineEvent* event = Timeline::GetGCStream()->StartEvent();
+  if (event == nullptr) {
+    return;
+  }
+  int64_t p50, p99, max;
+  {
+    MutexLocker ml(&mutex_);
+    const PauseHistogram& pauses = pauses_[static_cast<intptr_t>(type)];
+    p50 = pauses.Percentile(50);
+    p99 = pauses.Percentile(99);
+    max = pauses.MaxMicros();
+  }
+  event->Counter(OS::SCreate(nullptr, "%s Pause", Heap::GCTypeToString(type)));
+  event->set_owns_label(true);
+  event->SetNumArguments(3);
+  event->FormatArgument(0, "p50 (us)", "%" Pd64 "", p50);
+  event->FormatArgument(1, "p99 (us)", "%" Pd64 "", p99);
+  event->FormatArgument(2, "max (us)", "%" Pd64 "", max);
+  event->Complete();
+#endif  // defined(SUPPORT_TIMELINE)
+}
+
+#ifndef PRODUCT
+void GCPauseStats::PrintJSON(JSONObject* jsobj) {
+  MutexLocker ml(&mutex_);
+  {
+    JSONObject pauses(jsobj, "pauses");
+    for (intptr_t i = 0; i < kNumTypes; i++) {
+      JSONObject pause(&pauses,
+                       Heap::GCTypeToString(static_cast<GCType>(i)));
+      pauses_[i].PrintJSON(&pause);
+    }
+  }
+  {
+    JSONObject phases(jsobj, "phases");
+    for (intptr_t i = 0; i < kNumPhases; i++) {
+      JSONObject phase(&phases, PhaseName(static_cast<GCPhase>(i)));
+      phases_[i].PrintJSON(&phase);
+    }
+  }
+}
+#endif  // !PRODUCT
+
+GCPhaseScope::GCPhaseScope(GCPauseStats* stats, GCPhase phase)
+    : stats_(stats), phase_(phase), start_(OS::GetCurrentMonotonicMicros()) {}
+
+GCPhaseScope::~GCPhaseScope() {
+  stats_->AddPhaseMicros(phase_, OS::GetCurrentMonotonicMicros() - start_);
+}
+
+}  // namespace dart
@@ -0,0 +1,142 @@
+// Copyright (c) 2024, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#ifndef RUNTIME_VM_HEAP_GC_STATS_H_
+#define RUNTIME_VM_HEAP_GC_STATS_H_
+
+#include "platform/assert.h"
+#include "platform/atomic.h"
+#include "vm/allocation.h"
+#include "vm/globals.h"
+#include "vm/heap/spaces.h"
+#include "vm/os_thread.h"
+
+namespace dart {
+
+class JSONObject;
+
+// Histogram of durations in microseconds. Buckets are logarithmic, and each
+// power of two is split into linear sub-buckets, so a recorded value keeps a
+// relative precision of 1/kHalfSubBuckets over the whole range (the scheme
+// used by HdrHistogram).
+class PauseHistogram {
+ public:
+  PauseHistogram() { Reset(); }
+
+  void Add(int64_t micros);
+  void Reset();
+
+  int64_t Count() const { return count_; }
+  int64_t TotalMicros() const { return total_micros_; }
+  int64_t MaxMicros() const { return max_micros_; }
+
+  // Returns an upper bound of the given percentile (0-100) of the recorded
+  // values, precise to a bucket's width, or 0 if nothing was recorded.
+  int64_t Percentile(double percentile) const;
+
+#ifndef PRODUCT
+  void PrintJSON(JSONObject* jsobj) const;
+#endif  // !PRODUCT
+
+  static constexpr intptr_t kSubBucketBits = 5;
+  static constexpr intptr_t kHalfSubBuckets = 1 << (kSubBucketBits - 1);
+  // Values at or above 2^kMaxValueBits microseconds (more than an hour) land
+  // in the last bucket.
+  static constexpr intptr_t kMaxValueBits = 32;
+  static constexpr intptr_t kNumBuckets =
+      (kMaxValueBits - kSubBucketBits + 2) * kHalfSubBuckets;
+
+  static intptr_t BucketFor(int64_t micros);
+  // The largest value that falls into the bucket.
+  static int64_t BucketLimit(intptr_t bucket);
+
+ private:
+  int64_t count_;
+  int64_t total_micros_;
+  int64_t max_micros_;
+  int64_t buckets_[kNumBuckets];
+
+  DISALLOW_COPY_AND_ASSIGN(PauseHistogram);
+};
+
+// The parts of the collections whose durations are tracked. Phases that run
+// on several GC workers record the time summed over the workers.
+#define GC_PHASE_LIST(V)                                                       \
+  V(ScavengeRoots, "scavengeRoots")                                            \
+  V(ScavengeStoreBuffer, "scavengeStoreBuffer")                                \
+  V(ScavengeWeak, "scavengeWeak")                                              \
+  V(MarkRoots, "markRoots")                                                    \
+  V(MarkWeak, "markWeak")                                                      \
+  V(Sweep, "sweep")                                                            \
+  V(Compact, "compact")
+
+enum class GCPhase {
+#define DEFINE_PHASE(name, json_name) k##name,
+  GC_PHASE_LIST(DEFINE_PHASE)
+#undef DEFINE_PHASE
+      kNumPhases,
+};
+
+// Pause and per-phase duration distributions of an isolate group's
+// collections since startup.
+class GCPauseStats {
+ public:
+  GCPauseStats() {}
+
+  // Called by GC workers while a collection is in progress.
+  void AddPhaseMicros(GCPhase phase, int64_t micros) {
+    pending_phase_micros_[static_cast<intptr_t>(phase)].fetch_add(micros);
+  }
+
+  // Called at the end of each collection with its pause time.
+  void RecordPause(GCType type, int64_t micros);
+
+  int64_t PausePercentile(GCType type, double percentile);
+  int64_t PhasePercentile(GCPhase phase, double percentile);
+  int64_t PauseCount(GCType type);
+  int64_t PhaseCount(GCPhase phase);
+
+  void Reset();
+
+#ifndef PRODUCT
+  void PrintJSON(JSONObject* jsobj);
+#endif  // !PRODUCT
+
+  static const char* PhaseName(GCPhase phase);
+
+ private:
+  static constexpr intptr_t kNumPhases =
+      static_cast<intptr_t>(GCPhase::kNumPhases);
+  static constexpr intptr_t kNumTypes =
+      static_cast<intptr_t>(GCType::kMarkCompact) + 1;
+
+  void PrintCountersToTimeline(GCType type);
+
+  // Guards the histograms, which the service reads concurrently with the
+  // collections.
+  Mutex mutex_;
+  PauseHistogram pauses_[kNumTypes];
+  PauseHistogram phases_[kNumPhases];
+  RelaxedAtomic<int64_t> pending_phase_micros_[kNumPhases] = {};
+
+  DISALLOW_COPY_AND_ASSIGN(GCPauseStats);
+};
+
+// Adds the time spent in its scope to a GC phase.
+class GCPhaseScope : public ValueObject {
+ public:
+  GCPhaseScope(GCPauseStats* stats, GCPhase phase);
+  ~GCPhaseScope();
+
+ private:
+  GCPauseStats* const stats_;
+  const GCPhase phase_;
+  const int64_t start_;
+
+  DISALLOW_COPY_AND_ASSIGN(GCPhaseScope);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_HEAP_GC_STATS_H_
@@ -0,0 +1,85 @@
+// Copyright (c) 2024, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "platform/assert.h"
+#include "vm/heap/gc_stats.h"
+#include "vm/heap/heap.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+TEST_CASE(PauseHistogram_Buckets) {
+  // Small values have their own bucket.
+  for (int64_t i = 0; i < (1 << PauseHistogram::kSubBucketBits); i++) {
+    EXPECT_EQ(i, PauseHistogram::BucketFor(i));
+    EXPECT_EQ(i, PauseHistogram::BucketLimit(i));
+  }
+  // Buckets are contiguous, and each value is no larger than its bucket's
+  // limit and larger than the previous bucket's.
+  for (int64_t micros = 1; micros < 10 * 1000 * 1000;
+       micros += micros / 7 + 1) {
+    const intptr_t bucket = PauseHistogram::BucketFor(micros);
+    EXPECT_LE(micros, PauseHistogram::BucketLimit(bucket));
+    EXPECT_LT(PauseHistogram::BucketLimit(bucket - 1), micros);
+  }
+  EXPECT_EQ(PauseHistogram::kNumBuckets - 1,
+            PauseHistogram::BucketFor(kMaxInt64));
+}
+
+TEST_CASE(PauseHistogram_Percentile) {
+  PauseHistogram histogram;
+  EXPECT_EQ(0, histogram.Percentile(99));
+  for (intptr_t i = 1; i <= 1000; i++) {
+    histogram.Add(i * 100);
+  }
+  EXPECT_EQ(1000, histogram.Count());
+  EXPECT_EQ(100 * 1000, histogram.MaxMicros());
+  // Within a bucket's precision.
+  const int64_t p50 = histogram.Percentile(50);
+  EXPECT_LE(50 * 1000, p50);
+  EXPECT_LE(p50, 50 * 1000 + 50 * 1000 / PauseHistogram::kHalfSubBuckets);
+  const int64_t p99 = histogram.Percentile(99);
+  EXPECT_LE(99 * 1000, p99);
+  EXPECT_LE(p99, 100 * 1000);
+  EXPECT_EQ(100 * 1000, histogram.Percentile(100));
+  histogram.Reset();
+  EXPECT_EQ(0, histogram.Count());
+}
+
+ISOLATE_UNIT_TEST_CASE(GCPauseStats_Collections) {
+  GCPauseStats* stats = thread->isolate_group()->heap()->pause_stats();
+  stats->Reset();
+  GCTestHelper::CollectNewSpace();
+  GCTestHelper::CollectNewSpace();
+  GCTestHelper::CollectAllGarbage(/*compact=*/true);
+  GCTestHelper::WaitForGCTasks();
+  EXPECT_LE(2, stats->PauseCount(GCType::kScavenge));
+  EXPECT_LE(1, stats->PauseCount(GCType::kMarkCompact));
+  EXPECT(stats->PausePercentile(GCType::kMarkCompact, 100) >=
+         stats->PhasePercentile(GCPhase::kCompact, 0));
+}
+
+ISOLATE_UNIT_TEST_CASE(GCPauseStats_ConcurrentMarkPhases) {
+  Heap* heap = thread->isolate_group()->heap();
+  GCPauseStats* stats = heap->pause_stats();
+  GCTestHelper::CollectAllGarbage();
+  GCTestHelper::WaitForGCTasks();
+  stats->Reset();
+  heap->StartConcurrentMarking(thread, GCReason::kDebugging);
+  // Scavenges while the concurrent markers run must not pick up their work.
+  for (intptr_t i = 0; i < 3; i++) {
+    GCTestHelper::CollectNewSpace();
+  }
+  GCTestHelper::CollectAllGarbage();
+  GCTestHelper::WaitForGCTasks();
+  // Roots are only marked in the pause that starts concurrent marking and in
+  // the one that finalizes it.
+  const int64_t finalize_pauses = stats->PauseCount(GCType::kMarkSweep) +
+                                  stats->PauseCount(GCType::kMarkCompact);
+  EXPECT_LE(stats->PhaseCount(GCPhase::kMarkRoots),
+            stats->PauseCount(GCType::kStartConcurrentMark) + finalize_pauses);
+  EXPECT_LE(stats->PhaseCount(GCPhase::kMarkWeak), finalize_pauses);
+}
+
+}  // namespace dart
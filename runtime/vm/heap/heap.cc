@@ -20,7 +20,9 @@
 #include "vm/isolate.h"
 #include "vm/lockers.h"
 #include "vm/object.h"
+#include "vm/object_graph_copy.h"
 #include "vm/object_set.h"
+#include "vm/object_store.h"
 #include "vm/os.h"
 #include "vm/raw_object.h"
 #include "vm/service.h"
@@ -39,6 +41,12 @@ DEFINE_FLAG(bool,
             disable_heap_verification,
             false,
             "Explicitly disable heap verification.");
+DEFINE_FLAG(bool,
+            idle_gc_prediction,
+            true,
+            "Use the allocation rate and the interval between idle "
+            "notifications to collect during idle time before a collection "
+            "would otherwise be needed during work.");
 
 Heap::Heap(IsolateGroup* isolate_group,
            bool is_vm_isolate,
@@ -121,6 +129,14 @@ uword Heap::AllocateOld(Thread* thread, intptr_t size, bool is_exec) {
     if (addr != 0) {
       return addr;
     }
+    if (!is_exec) {
+      // Sweep on demand rather than waiting for the concurrent sweeper to
+      // finish all pages.
+      addr = old_space_.TryAllocateSweepingOnDemand(size);
+      if (addr != 0) {
+        return addr;
+      }
+    }
     // Wait for any GC tasks that are in progress.
     WaitForSweeperTasks(thread);
     addr = old_space_.TryAllocate(size, is_exec);
@@ -335,6 +351,11 @@ void HeapIterationScope::IterateObjects(ObjectVisitor* visitor) const {
   heap_->VisitObjects(visitor);
 }
 
+void HeapIterationScope::CollectPages(MallocGrowableArray<Page*>* pages) const {
+  heap_->new_space()->AddPagesTo(pages);
+  heap_->old_space()->AddPagesTo(pages);
+}
+
 void HeapIterationScope::IterateObjectsNoImagePages(
     ObjectVisitor* visitor) const {
   heap_->new_space()->VisitObjects(visitor);
@@ -377,11 +398,16 @@ void Heap::NotifyIdle(int64_t deadline) {
   {
     GcSafepointOperationScope safepoint_operation(thread);
 
+    // Isolates of the group may notify idleness concurrently, the safepoint
+    // serializes their updates of the idle state.
+    const int64_t interval =
+        UpdateIdleInterval(OS::GetCurrentMonotonicMicros(), deadline);
+
     // Check if we want to collect new-space first, because if we want to
     // collect both new-space and old-space, the new-space collection should run
     // first to shrink the root set (make old-space GC faster) and avoid
     // intergenerational garbage (make old-space GC free more memory).
-    if (new_space_.ShouldPerformIdleScavenge(deadline)) {
+    if (new_space_.ShouldPerformIdleScavenge(deadline, interval)) {
       CollectNewSpaceGarbage(thread, GCType::kScavenge, GCReason::kIdle);
     }
 
@@ -403,7 +429,7 @@ void Heap::NotifyIdle(int64_t deadline) {
       // Compare the tail end of Heap::CollectNewSpaceGarbage.
       // Blocks for O(heap).
       CollectOldSpaceGarbage(thread, GCType::kMarkSweep, GCReason::kIdle);
-    } else if (old_space_.ShouldStartIdleMarkSweep(deadline) ||
+    } else if (old_space_.ShouldStartIdleMarkSweep(deadline, interval) ||
                old_space_.ReachedSoftThreshold()) {
       // If we have both work to do and enough time, start or finish GC.
       // If we have crossed the soft threshold, ignore time; the next old-space
@@ -428,10 +454,26 @@ void Heap::NotifyIdle(int64_t deadline) {
   }
 
   if (OS::GetCurrentMonotonicMicros() < deadline) {
-    Page::ClearCache();
+    Page::NotifyIdle();
   }
 }
 
+int64_t Heap::UpdateIdleInterval(int64_t now, int64_t deadline) {
+  // A notification before the previous deadline is part of the same idle
+  // period and would only drag the average down.
+  if (now >= last_idle_deadline_) {
+    if (last_idle_micros_ != 0) {
+      const int64_t interval = now - last_idle_micros_;
+      idle_interval_micros_ = idle_interval_micros_ == 0
+                                  ? interval
+                                  : (3 * idle_interval_micros_ + interval) / 4;
+    }
+    last_idle_micros_ = now;
+  }
+  last_idle_deadline_ = Utils::Maximum(last_idle_deadline_, deadline);
+  return FLAG_idle_gc_prediction ? idle_interval_micros_ : 0;
+}
+
 void Heap::NotifyDestroyed() {
   TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "NotifyDestroyed");
   CollectAllGarbage(GCReason::kDestroyed, /*compact=*/true);
@@ -527,6 +569,12 @@ void Heap::CollectOldSpaceGarbage(Thread* thread,
     TIMELINE_FUNCTION_GC_DURATION(thread, "CollectOldGeneration");
     old_space_.CollectGarbage(thread, /*compact=*/type == GCType::kMarkCompact,
                               /*finalize=*/true);
+    NOT_IN_PRODUCT(new_space_.ResetPretenuring());
+    if (old_space_.last_collection_compacted()) {
+      // Marking found old-space fragmented and upgraded the mark-sweep.
+      type = GCType::kMarkCompact;
+      stats_.type_ = type;
+    }
     RecordAfterGC(type);
     PrintStats();
 #if defined(SUPPORT_TIMELINE)
@@ -571,6 +619,155 @@ void Heap::CollectAllGarbage(GCReason reason, bool compact) {
       thread, compact ? GCType::kMarkCompact : GCType::kMarkSweep, reason);
 }
 
+// Collects the object graph that Heap::MakePermanent freezes. Visited objects
+// are tagged with the permanent bit so each is traced once. The tags are
+// either committed by marking the frozen objects or rolled back.
+class PermanentGraphVisitor : public ObjectPointerVisitor {
+ public:
+  explicit PermanentGraphVisitor(IsolateGroup* isolate_group)
+      : ObjectPointerVisitor(isolate_group) {}
+
+  ~PermanentGraphVisitor() {
+    for (intptr_t i = 0; i < boundary_.length(); i++) {
+      boundary_[i]->untag()->ClearPermanentUnsynchronized();
+    }
+  }
+
+  void VisitPointers(ObjectPtr* from, ObjectPtr* to) override {
+    for (ObjectPtr* ptr = from; ptr <= to; ptr++) {
+      Add(*ptr);
+    }
+  }
+
+#if defined(DART_COMPRESSED_POINTERS)
+  void VisitCompressedPointers(uword heap_base,
+                               CompressedObjectPtr* from,
+                               CompressedObjectPtr* to) override {
+    for (CompressedObjectPtr* ptr = from; ptr <= to; ptr++) {
+      Add(ptr->Decompress(heap_base));
+    }
+  }
+#endif
+
+  // Returns false if the graph reaches a new-space object.
+  bool Trace(ObjectPtr root) {
+    Add(root);
+    // The frozen list doubles as the work queue.
+    for (intptr_t i = 0; (i < frozen_.length()) && !failed_; i++) {
+      frozen_[i]->untag()->VisitPointers(this);
+    }
+    return !failed_;
+  }
+
+  const MallocGrowableArray<ObjectPtr>& boundary() const { return boundary_; }
+
+  intptr_t Commit() {
+    intptr_t size = 0;
+    for (intptr_t i = 0; i < frozen_.length(); i++) {
+      ObjectPtr obj = frozen_[i];
+      obj->untag()->SetMarkBitUnsynchronized();
+      size += obj->untag()->HeapSize();
+    }
+    frozen_.Clear();
+    return size;
+  }
+
+  void Rollback() {
+    for (intptr_t i = 0; i < frozen_.length(); i++) {
+      frozen_[i]->untag()->ClearPermanentUnsynchronized();
+    }
+    frozen_.Clear();
+  }
+
+ private:
+  void Add(ObjectPtr obj) {
+    if (failed_ || !obj->IsHeapObject()) return;
+    // Objects on image pages, in the VM isolate or already frozen are marked.
+    if (obj->untag()->IsMarked()) return;
+    if (obj->untag()->IsPermanent()) return;  // Already visited.
+    if (!obj->IsOldObject()) {
+      failed_ = true;
+      return;
+    }
+    obj->untag()->SetPermanentUnsynchronized();
+    if (CanShareObjectAcrossIsolates(obj)) {
+      frozen_.Add(obj);
+    } else {
+      boundary_.Add(obj);
+    }
+  }
+
+  MallocGrowableArray<ObjectPtr> frozen_;
+  MallocGrowableArray<ObjectPtr> boundary_;
+  bool failed_ = false;
+
+  DISALLOW_COPY_AND_ASSIGN(PermanentGraphVisitor);
+};
+
+intptr_t Heap::MakePermanent(Thread* thread, const Object& root) {
+  ASSERT(!thread->OwnsGCSafepoint());
+  if (!root.ptr()->IsHeapObject() ||
+      !CanShareObjectAcrossIsolates(root.ptr())) {
+    return 0;
+  }
+  // Promote any part of the graph that is still in new space.
+  CollectNewSpaceGarbage(thread, GCType::kEvacuate, GCReason::kFull);
+
+  Zone* zone = thread->zone();
+  ObjectStore* object_store = isolate_group()->object_store();
+
+  // First pass: find the objects that end the graph. They must be rooted
+  // before the frozen objects stop being traced, which requires allocation,
+  // so it cannot happen during the heap iteration below.
+  GrowableArray<const Object*> boundary;
+  {
+    HeapIterationScope iteration(thread);
+    NoSafepointScope no_safepoint(thread);
+    PermanentGraphVisitor visitor(isolate_group());
+    const bool traced = visitor.Trace(root.ptr());
+    visitor.Rollback();
+    if (!traced) {
+      return 0;
+    }
+    for (intptr_t i = 0; i < visitor.boundary().length(); i++) {
+      boundary.Add(&Object::Handle(zone, visitor.boundary()[i]));
+    }
+  }
+  {
+    SafepointMutexLocker ml(&permanent_roots_mutex_);
+    GrowableObjectArray& roots =
+        GrowableObjectArray::Handle(zone, object_store->permanent_roots());
+    if (roots.IsNull()) {
+      roots = GrowableObjectArray::New(Heap::kOld);
+      object_store->set_permanent_roots(roots);
+    }
+    for (intptr_t i = 0; i < boundary.length(); i++) {
+      roots.Add(*boundary[i], Heap::kOld);
+    }
+  }
+
+  // Second pass: the graph is immutable, so it is the same as before, though
+  // it may have moved.
+  intptr_t size;
+  {
+    HeapIterationScope iteration(thread);
+    NoSafepointScope no_safepoint(thread);
+    PermanentGraphVisitor visitor(isolate_group());
+    if (!visitor.Trace(root.ptr()) ||
+        (visitor.boundary().length() != boundary.length())) {
+      visitor.Rollback();
+      return 0;
+    }
+    size = visitor.Commit();
+  }
+  permanent_in_words_.fetch_add(size >> kWordSizeLog2);
+  if (FLAG_verbose_gc) {
+    OS::PrintErr("[ Permanent ] %" Pd "kB frozen, %" Pd " boundary objects\n",
+                 size / KB, boundary.length());
+  }
+  return size;
+}
+
 void Heap::CheckCatchUp(Thread* thread) {
   ASSERT(!thread->force_growth());
   if (old_space()->ReachedHardThreshold()) {
@@ -845,6 +1042,30 @@ const char* Heap::GCTypeToString(GCType type) {
   }
 }
 
+const char* Heap::WeakSelectorToString(WeakSelector selector) {
+  switch (selector) {
+    case kPeers:
+      return "peers";
+#if !defined(HASH_IN_OBJECT_HEADER)
+    case kIdentityHashes:
+      return "identityHashes";
+#endif
+    case kCanonicalHashes:
+      return "canonicalHashes";
+    case kObjectIds:
+      return "objectIds";
+    case kLoadingUnits:
+      return "loadingUnits";
+#if !defined(PRODUCT) || defined(FORCE_INCLUDE_SAMPLING_HEAP_PROFILER)
+    case kHeapSamplingData:
+      return "heapSamplingData";
+#endif
+    default:
+      UNREACHABLE();
+      return "";
+  }
+}
+
 const char* Heap::GCReasonToString(GCReason gc_reason) {
   switch (gc_reason) {
     case GCReason::kNewSpace:
@@ -988,8 +1209,125 @@ void Heap::PrintMemoryUsageJSON(JSONObject* jsobj) const {
   jsobj->AddProperty64("heapCapacity", TotalCapacityInWords() * kWordSize);
   jsobj->AddProperty64("externalUsage", TotalExternalInWords() * kWordSize);
 }
+
+void Heap::PrintGCStatsJSON(JSONStream* stream) {
+  JSONObject jsobj(stream);
+  jsobj.AddProperty("type", "_GCStats");
+  pause_stats_.PrintJSON(&jsobj);
+  isolate_group_->safepoint_handler()->PrintJSON(&jsobj);
+  JSONObject weak_tables(&jsobj, "weakTableMicros");
+  for (intptr_t sel = 0; sel < kNumWeakSelectors; sel++) {
+    const auto selector = static_cast<WeakSelector>(sel);
+    weak_tables.AddProperty64(WeakSelectorToString(selector),
+                              WeakTableMicros(selector));
+  }
+}
+
+void Heap::PrintObjectLayoutJSON(Thread* thread, JSONStream* stream) {
+  ClassTable* class_table = isolate_group_->class_table();
+  const intptr_t num_cids = class_table->NumCids();
+  std::unique_ptr<ObjectLayoutStats[]> stats(new ObjectLayoutStats[num_cids]);
+  CollectObjectLayoutStats(thread, stats.get(), num_cids);
+
+  auto print_stats = [](JSONObject* jsobj, const ObjectLayoutStats& stats) {
+    jsobj->AddProperty64("count", stats.count);
+    jsobj->AddProperty64("bytes", stats.size_in_bytes);
+    jsobj->AddProperty64("headerBytes", stats.header_in_bytes);
+    jsobj->AddProperty64("paddingBytes", stats.padding_in_bytes);
+    jsobj->AddProperty64("compactAlignmentBytes",
+                         stats.compact_alignment_in_bytes);
+    jsobj->AddProperty64("compactHeaderBytes", stats.compact_header_in_bytes);
+  };
+
+  JSONObject jsobj(stream);
+  jsobj.AddProperty("type", "_ObjectLayoutStats");
+  jsobj.AddProperty64("headerSize", sizeof(UntaggedObject));
+  jsobj.AddProperty64("objectAlignment", kObjectAlignment);
+  jsobj.AddProperty64("compactAlignment", kCompressedWordSize);
+  ObjectLayoutStats total;
+  {
+    JSONArray members(&jsobj, "members");
+    Class& cls = Class::Handle(thread->zone());
+    for (intptr_t cid = 1; cid < num_cids; cid++) {
+      if (stats[cid].count == 0 || !class_table->HasValidClassAt(cid)) {
+        continue;
+      }
+      total.Add(stats[cid]);
+      cls = class_table->At(cid);
+      JSONObject member(&members);
+      member.AddProperty("class", cls);
+      print_stats(&member, stats[cid]);
+    }
+  }
+  JSONObject totals(&jsobj, "total");
+  print_stats(&totals, total);
+}
 #endif  // PRODUCT
 
+void Heap::ObjectLayoutStats::Add(const ObjectLayoutStats& other) {
+  count += other.count;
+  size_in_bytes += other.size_in_bytes;
+  header_in_bytes += other.header_in_bytes;
+  padding_in_bytes += other.padding_in_bytes;
+  compact_alignment_in_bytes += other.compact_alignment_in_bytes;
+  compact_header_in_bytes += other.compact_header_in_bytes;
+}
+
+class ObjectLayoutVisitor : public ObjectVisitor {
+ public:
+  ObjectLayoutVisitor(ClassTable* class_table,
+                      Heap::ObjectLayoutStats* stats,
+                      intptr_t num_cids)
+      : class_table_(class_table), stats_(stats), num_cids_(num_cids) {}
+
+  void VisitObject(ObjectPtr obj) override {
+    if (obj->IsFreeListElement() || obj->IsForwardingCorpse()) {
+      return;
+    }
+    const intptr_t cid = obj->GetClassId();
+    if (cid >= num_cids_) {
+      return;
+    }
+    const intptr_t size = obj->untag()->HeapSize();
+    Heap::ObjectLayoutStats* stats = &stats_[cid];
+    stats->count++;
+    stats->size_in_bytes += size;
+    stats->header_in_bytes += sizeof(UntaggedObject);
+    if ((cid < kNumPredefinedCids) || !class_table_->HasValidClassAt(cid)) {
+      // The unpadded size of predefined objects is not recorded anywhere, so
+      // count them at their current size.
+      stats->compact_alignment_in_bytes += size;
+      stats->compact_header_in_bytes += size;
+      return;
+    }
+    const intptr_t unpadded_size =
+        Class::host_next_field_offset_in_words(class_table_->At(cid)) *
+        kCompressedWordSize;
+    ASSERT(unpadded_size <= size);
+    stats->padding_in_bytes += size - unpadded_size;
+    stats->compact_alignment_in_bytes +=
+        Utils::RoundUp(unpadded_size, kCompressedWordSize);
+    stats->compact_header_in_bytes += Utils::RoundUp(
+        unpadded_size - sizeof(UntaggedObject) + sizeof(uint32_t),
+        kCompressedWordSize);
+  }
+
+ private:
+  ClassTable* const class_table_;
+  Heap::ObjectLayoutStats* const stats_;
+  const intptr_t num_cids_;
+
+  DISALLOW_COPY_AND_ASSIGN(ObjectLayoutVisitor);
+};
+
+void Heap::CollectObjectLayoutStats(Thread* thread,
+                                    ObjectLayoutStats* stats,
+                                    intptr_t num_cids) {
+  HeapIterationScope iteration(thread);
+  ObjectLayoutVisitor visitor(isolate_group_->class_table(), stats, num_cids);
+  iteration.IterateObjects(&visitor);
+}
+
 void Heap::RecordBeforeGC(GCType type, GCReason reason) {
   stats_.num_++;
   stats_.type_ = type;
@@ -1013,6 +1351,7 @@ void Heap::RecordAfterGC(GCType type) {
   stats_.after_.new_ = new_space_.GetCurrentUsage();
   stats_.after_.old_ = old_space_.GetCurrentUsage();
   stats_.after_.store_buffer_ = isolate_group_->store_buffer()->Size();
+  pause_stats_.RecordPause(type, delta);
 #ifndef PRODUCT
   // For now we'll emit the same GC events on all isolates.
   if (Service::gc_stream.enabled()) {
@@ -15,6 +15,7 @@
 #include "vm/allocation.h"
 #include "vm/flags.h"
 #include "vm/globals.h"
+#include "vm/heap/gc_stats.h"
 #include "vm/heap/pages.h"
 #include "vm/heap/scavenger.h"
 #include "vm/heap/spaces.h"
@@ -98,6 +99,8 @@ class Heap {
   bool DataContains(uword addr) const;
 
   void NotifyIdle(int64_t deadline);
+  // The running average of the time between idle notifications.
+  int64_t IdleIntervalMicros() const { return idle_interval_micros_; }
   void NotifyDestroyed();
 
   Dart_PerformanceMode mode() const { return mode_; }
@@ -113,6 +116,17 @@ class Heap {
   void CollectAllGarbage(GCReason reason = GCReason::kFull,
                          bool compact = false);
 
+  // Freezes the deeply immutable object graph reachable from 'root' into
+  // permanently live old-space objects, which keep their mark bit across
+  // collections so the marker no longer traces them. Objects that cannot be
+  // shared across isolates (type-testing stubs, for example) end the graph and
+  // are instead kept alive as ordinary roots. Returns the number of bytes
+  // frozen, which is 0 if the graph could not be frozen.
+  intptr_t MakePermanent(Thread* thread, const Object& root);
+  intptr_t PermanentInWords() const { return permanent_in_words_; }
+
+  GCPauseStats* pause_stats() { return &pause_stats_; }
+
   void CheckCatchUp(Thread* thread);
   void CheckConcurrentMarking(Thread* thread, GCReason reason, intptr_t size);
   void CheckFinalizeMarking(Thread* thread);
@@ -241,6 +255,16 @@ class Heap {
   void ForwardWeakEntries(ObjectPtr before_object, ObjectPtr after_object);
   void ForwardWeakTables(ObjectPointerVisitor* visitor);
 
+  // Time the collections spent pruning and rehashing each kind of weak table,
+  // summed over both spaces and all GC workers.
+  void AddWeakTableMicros(WeakSelector selector, int64_t micros) {
+    weak_table_micros_[selector].fetch_add(micros);
+  }
+  int64_t WeakTableMicros(WeakSelector selector) const {
+    return weak_table_micros_[selector];
+  }
+  static const char* WeakSelectorToString(WeakSelector selector);
+
 #if !defined(PRODUCT) || defined(FORCE_INCLUDE_SAMPLING_HEAP_PROFILER)
   void ReportSurvivingAllocations(Dart_HeapSamplingReportCallback callback,
                                   void* context) {
@@ -261,6 +285,12 @@ class Heap {
   void PrintMemoryUsageJSON(JSONStream* stream) const;
   void PrintMemoryUsageJSON(JSONObject* jsobj) const;
 
+  void PrintGCStatsJSON(JSONStream* stream);
+
+  // Prints the space taken by object headers and alignment padding per
+  // class, and what the denser layouts of ObjectLayoutStats would save.
+  void PrintObjectLayoutJSON(Thread* thread, JSONStream* stream);
+
   // The heap map contains the sizes and class ids for the objects in each page.
   void PrintHeapMapToJSONStream(IsolateGroup* isolate_group,
                                 JSONStream* stream) {
@@ -268,6 +298,28 @@ class Heap {
   }
 #endif  // PRODUCT
 
+  // Space taken by the objects of a class, split into header, fields and
+  // alignment padding, and the sizes they would have with denser layouts.
+  struct ObjectLayoutStats {
+    intptr_t count = 0;
+    intptr_t size_in_bytes = 0;
+    intptr_t header_in_bytes = 0;
+    // Only known for instances of non-predefined classes; 0 for the others.
+    intptr_t padding_in_bytes = 0;
+    // The size if objects were only aligned to kCompressedWordSize.
+    intptr_t compact_alignment_in_bytes = 0;
+    // The size if, in addition, the header were a single 32-bit word with
+    // the identity hash kept elsewhere.
+    intptr_t compact_header_in_bytes = 0;
+
+    void Add(const ObjectLayoutStats& other);
+  };
+
+  // Fills 'stats', indexed by class id, for all objects in the heap.
+  void CollectObjectLayoutStats(Thread* thread,
+                                ObjectLayoutStats* stats,
+                                intptr_t num_cids);
+
   intptr_t ReachabilityBarrier() { return old_space_.collections(); }
 
   IsolateGroup* isolate_group() const { return isolate_group_; }
@@ -343,6 +395,11 @@ class Heap {
 
   void AddRegionsToObjectSet(ObjectSet* set) const;
 
+  // Records an idle notification at 'now' and returns the expected time until
+  // the next idle period, or 0 if not known or not used for scheduling.
+  // Must be called inside a safepoint operation.
+  int64_t UpdateIdleInterval(int64_t now, int64_t deadline);
+
   // Trigger major GC if 'gc_on_nth_allocation_' is set.
   void CollectForDebugging(Thread* thread);
 
@@ -355,9 +412,11 @@ class Heap {
 
   WeakTable* new_weak_tables_[kNumWeakSelectors];
   WeakTable* old_weak_tables_[kNumWeakSelectors];
+  RelaxedAtomic<int64_t> weak_table_micros_[kNumWeakSelectors] = {};
 
   // GC stats collection.
   GCStats stats_;
+  GCPauseStats pause_stats_;
 
   RelaxedAtomic<Dart_PerformanceMode> mode_ = {Dart_PerformanceMode_Default};
 
@@ -366,6 +425,16 @@ class Heap {
 
   bool assume_scavenge_will_fail_;
 
+  int64_t last_idle_micros_ = 0;
+  int64_t last_idle_deadline_ = 0;
+  int64_t idle_interval_micros_ = 0;
+
+  // Size of the objects frozen by MakePermanent.
+  RelaxedAtomic<intptr_t> permanent_in_words_ = {0};
+  // Guards the creation of and appends to ObjectStore::permanent_roots(),
+  // which isolates of the group freeze objects into concurrently.
+  Mutex permanent_roots_mutex_;
+
   static constexpr intptr_t kNoForcedGarbageCollection = -1;
 
   // Whether the next heap allocation (new or old) should trigger
@@ -397,6 +466,8 @@ class HeapIterationScope : public ThreadStackResource {
   ~HeapIterationScope();
 
   void IterateObjects(ObjectVisitor* visitor) const;
+  // Adds the pages visited by IterateObjects, in the same order.
+  void CollectPages(MallocGrowableArray<Page*>* pages) const;
   void IterateObjectsNoImagePages(ObjectVisitor* visitor) const;
   void IterateOldObjects(ObjectVisitor* visitor) const;
   void IterateOldObjectsNoImagePages(ObjectVisitor* visitor) const;
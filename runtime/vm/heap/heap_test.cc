@@ -25,6 +25,9 @@
 namespace dart {
 
 DECLARE_FLAG(int, early_tenuring_threshold);
+DECLARE_FLAG(int, pretenure_threshold);
+DECLARE_FLAG(int, pretenure_min_kb);
+DECLARE_FLAG(int, compact_fragmentation_threshold);
 
 TEST_CASE(OldGC) {
   const char* kScriptChars =
@@ -997,6 +1000,189 @@ ISOLATE_UNIT_TEST_CASE(WeakProperty_Generations) {
   WeakProperty_Generations(kOld, kImm, kImm, false, false, false);
 }
 
+ISOLATE_UNIT_TEST_CASE(CompactFragmentationThreshold) {
+  PageSpace* old_space = thread->isolate_group()->heap()->old_space();
+  auto capacity_after_fragmenting = [&]() {
+    HANDLESCOPE(thread);
+    const intptr_t num_elements = 32 * MB / Array::InstanceSize(128);
+    const Array& list = Array::Handle(Array::New(num_elements, Heap::kOld));
+    {
+      HANDLESCOPE(thread);
+      Array& element = Array::Handle();
+      for (intptr_t i = 0; i < num_elements; i++) {
+        element = Array::New(128, Heap::kOld);
+        list.SetAt(i, element);
+      }
+    }
+    GCTestHelper::CollectOldSpace();
+    const intptr_t before = old_space->CapacityInWords();
+
+    // Keep one element every 64 KB so no page becomes empty.
+    const intptr_t m = 64 * KB / Array::InstanceSize(128);
+    for (intptr_t i = 0; i < num_elements; i++) {
+      if ((i % m) != 0) {
+        list.SetAt(i, Object::null_object());
+      }
+    }
+    GCTestHelper::CollectOldSpace();
+    GCTestHelper::WaitForGCTasks();
+    const intptr_t after = old_space->CapacityInWords();
+    OS::PrintErr("%" Pd " -> %" Pd " words\n", before, after);
+    return after;
+  };
+
+  FLAG_compact_fragmentation_threshold = 0;
+  const intptr_t swept = capacity_after_fragmenting();
+  GCPauseStats* pause_stats = thread->isolate_group()->heap()->pause_stats();
+  const int64_t compactions_before =
+      pause_stats->PauseCount(GCType::kMarkCompact);
+  FLAG_compact_fragmentation_threshold = 50;
+  const intptr_t compacted = capacity_after_fragmenting();
+  FLAG_compact_fragmentation_threshold = 0;
+  EXPECT(compacted < swept / 2);
+  // The upgraded collection is accounted as a mark-compact.
+  EXPECT(pause_stats->PauseCount(GCType::kMarkCompact) > compactions_before);
+}
+
+ISOLATE_UNIT_TEST_CASE(ParallelConcurrentSweep) {
+  const intptr_t saved_sweeper_tasks = FLAG_sweeper_tasks;
+  FLAG_sweeper_tasks = 4;
+  PageSpace* old_space = thread->isolate_group()->heap()->old_space();
+  const intptr_t num_elements = 16 * MB / Array::InstanceSize(128);
+  {
+    HANDLESCOPE(thread);
+    const Array& list = Array::Handle(Array::New(num_elements, Heap::kOld));
+    Array& element = Array::Handle();
+    for (intptr_t i = 0; i < num_elements; i++) {
+      element = Array::New(128, Heap::kOld);
+      list.SetAt(i, element);
+    }
+    GCTestHelper::CollectOldSpace();
+  }
+  const intptr_t before = old_space->CapacityInWords();
+
+  GCTestHelper::CollectOldSpace();
+  {
+    // Allocate while the sweeper tasks may still be running to exercise
+    // sweeping on demand.
+    HANDLESCOPE(thread);
+    Array& element = Array::Handle();
+    for (intptr_t i = 0; i < 1024; i++) {
+      element = Array::New(128, Heap::kOld);
+    }
+  }
+  GCTestHelper::WaitForGCTasks();
+  {
+    MonitorLocker ml(old_space->tasks_lock());
+    EXPECT_EQ(PageSpace::kDone, old_space->phase());
+    EXPECT_EQ(0, old_space->concurrent_sweeper_tasks());
+  }
+  const intptr_t after = old_space->CapacityInWords();
+  OS::PrintErr("%" Pd " -> %" Pd " words\n", before, after);
+  EXPECT(after < before / 2);
+  FLAG_sweeper_tasks = saved_sweeper_tasks;
+}
+
+ISOLATE_UNIT_TEST_CASE(MakePermanent) {
+  Heap* heap = thread->isolate_group()->heap();
+  const intptr_t num_elements = 1024;
+  const Array& list =
+      Array::Handle(ImmutableArray::New(num_elements, Heap::kNew));
+  String& element = String::Handle();
+  for (intptr_t i = 0; i < num_elements; i++) {
+    element = OneByteString::New("permanent", Heap::kNew);
+    list.SetAt(i, element);
+  }
+  const intptr_t frozen = heap->MakePermanent(thread, list);
+  EXPECT(frozen > 0);
+  EXPECT(list.ptr()->untag()->IsPermanent());
+  EXPECT(list.ptr()->untag()->IsMarked());
+
+  GCTestHelper::CollectAllGarbage();
+  GCTestHelper::WaitForGCTasks();
+  EXPECT(list.ptr()->untag()->IsPermanent());
+  EXPECT(list.ptr()->untag()->IsMarked());
+  // The marker skips the frozen objects, but they are still accounted as used.
+  EXPECT(heap->PermanentInWords() >= (frozen >> kWordSizeLog2));
+  EXPECT(heap->old_space()->UsedInWords() >= heap->PermanentInWords());
+  for (intptr_t i = 0; i < num_elements; i++) {
+    element ^= list.At(i);
+    EXPECT(element.ptr()->untag()->IsPermanent());
+    EXPECT(element.Equals("permanent"));
+  }
+
+  // A mutable graph cannot be frozen.
+  const Array& mutable_list = Array::Handle(Array::New(1, Heap::kOld));
+  EXPECT_EQ(0, heap->MakePermanent(thread, mutable_list));
+  EXPECT(!mutable_list.ptr()->untag()->IsPermanent());
+}
+
+#if !defined(PRODUCT)
+ISOLATE_UNIT_TEST_CASE(PretenureLongLivedClass) {
+  FLAG_early_tenuring_threshold = 100;  // I.e., off.
+  FLAG_pretenure_threshold = 50;
+  FLAG_pretenure_min_kb = 64;
+  ClassTable* class_table = thread->isolate_group()->class_table();
+  EXPECT(!class_table->ShouldPretenureAllocationFor(kArrayCid));
+
+  HANDLESCOPE(thread);
+  const intptr_t num_elements = 1024;
+  const Array& list = Array::Handle(Array::New(num_elements, Heap::kOld));
+  Array& element = Array::Handle();
+  for (intptr_t i = 0; i < num_elements; i++) {
+    element = Array::New(32);
+    list.SetAt(i, element);
+  }
+
+  // First scavenge copies the arrays within new-space, making them promotion
+  // candidates. The second promotes all of them.
+  GCTestHelper::CollectNewSpace();
+  EXPECT(!class_table->ShouldPretenureAllocationFor(kArrayCid));
+  GCTestHelper::CollectNewSpace();
+  EXPECT(class_table->ShouldPretenureAllocationFor(kArrayCid));
+
+  // Old-space collections forget the decision.
+  GCTestHelper::CollectOldSpace();
+  EXPECT(!class_table->ShouldPretenureAllocationFor(kArrayCid));
+
+  FLAG_pretenure_threshold = 0;
+}
+
+static bool IsOldObject(Dart_Handle handle) {
+  EXPECT_VALID(handle);
+  TransitionNativeToVM transition(Thread::Current());
+  return Api::UnwrapHandle(handle)->IsOldObject();
+}
+
+// Every allocation runtime entry honors the pretenuring decision of the class
+// it allocates.
+TEST_CASE(PretenuredRuntimeAllocations) {
+  const char* kScriptChars = R"(
+Function closure(int x) => () => x;
+Object smallRecord(int x) => (x, x + 1);
+Object largeRecord(int x) => (x, x + 1, x + 2, x + 3, x + 4);
+)";
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, nullptr);
+  Dart_Handle args[] = {Dart_NewInteger(1)};
+  const char* kFunctions[] = {"closure", "smallRecord", "largeRecord"};
+  for (const char* function : kFunctions) {
+    EXPECT(!IsOldObject(Dart_Invoke(lib, NewString(function), 1, args)));
+  }
+
+  ClassTable* class_table = thread->isolate_group()->class_table();
+  const intptr_t kPretenuredCids[] = {kClosureCid, kContextCid, kRecordCid};
+  for (intptr_t cid : kPretenuredCids) {
+    class_table->SetPretenureAllocationFor(cid, true);
+  }
+  for (const char* function : kFunctions) {
+    EXPECT(IsOldObject(Dart_Invoke(lib, NewString(function), 1, args)));
+  }
+  for (intptr_t cid : kPretenuredCids) {
+    class_table->SetPretenureAllocationFor(cid, false);
+  }
+}
+#endif  // !defined(PRODUCT)
+
 static void WeakReference_Generations(Generation reference_space,
                                       Generation target_space,
                                       bool cleared_after_minor,
@@ -1267,4 +1453,55 @@ ISOLATE_UNIT_TEST_CASE(SweepDontNeed) {
 }
 #endif  // !defined(PRODUCT) && !defined(DART_HOST_OS_LINUX)
 
+ISOLATE_UNIT_TEST_CASE(Heap_IdleInterval) {
+  Heap* heap = thread->isolate_group()->heap();
+  const int64_t start = OS::GetCurrentMonotonicMicros();
+  heap->NotifyIdle(start);
+  OS::Sleep(10);
+  heap->NotifyIdle(OS::GetCurrentMonotonicMicros());
+  const int64_t elapsed = OS::GetCurrentMonotonicMicros() - start;
+  EXPECT_LE(10 * kMicrosecondsPerMillisecond, heap->IdleIntervalMicros());
+  EXPECT_LE(heap->IdleIntervalMicros(), elapsed);
+}
+
+TEST_CASE(Heap_ObjectLayoutStats) {
+  const char* kScriptChars = R"(
+    class Pair {
+      var a;
+      var b;
+      Pair(this.a, this.b);
+    }
+    main() => List.generate(100, (i) => Pair(i, i));
+  )";
+  Dart_Handle h_lib = TestCase::LoadTestScript(kScriptChars, nullptr);
+  Dart_EnterScope();
+  Dart_Handle result = Dart_Invoke(h_lib, NewString("main"), 0, nullptr);
+  EXPECT_VALID(result);
+  {
+    TransitionNativeToVM transition(thread);
+    Library& lib = Library::Handle();
+    lib ^= Api::UnwrapHandle(h_lib);
+    const Class& cls = Class::Handle(
+        lib.LookupClass(String::Handle(Symbols::New(thread, "Pair"))));
+    ASSERT(!cls.IsNull());
+    ClassTable* class_table = thread->isolate_group()->class_table();
+    const intptr_t num_cids = class_table->NumCids();
+    std::unique_ptr<Heap::ObjectLayoutStats[]> stats(
+        new Heap::ObjectLayoutStats[num_cids]);
+    thread->isolate_group()->heap()->CollectObjectLayoutStats(
+        thread, stats.get(), num_cids);
+    const Heap::ObjectLayoutStats& pairs = stats[cls.id()];
+    EXPECT_LE(100, pairs.count);
+    EXPECT_EQ(pairs.count * cls.host_instance_size(), pairs.size_in_bytes);
+    EXPECT_EQ(pairs.count * static_cast<intptr_t>(sizeof(UntaggedObject)),
+              pairs.header_in_bytes);
+    EXPECT_EQ(pairs.count * cls.host_next_field_offset(),
+              pairs.size_in_bytes - pairs.padding_in_bytes);
+    EXPECT_LE(pairs.compact_header_in_bytes,
+              pairs.compact_alignment_in_bytes);
+    EXPECT_LE(pairs.compact_alignment_in_bytes, pairs.size_in_bytes);
+  }
+  Dart_ExitScope();
+}
+
 }  // namespace dart
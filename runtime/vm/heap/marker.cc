@@ -435,6 +435,10 @@ class MarkingVisitorBase : public ObjectPointerVisitor {
     return work_list_.WaitForWork(num_busy);
   }
 
+  intptr_t steal_attempts() const { return work_list_.steal_attempts(); }
+  intptr_t steals() const { return work_list_.steals(); }
+  intptr_t shared_blocks() const { return work_list_.shared_blocks(); }
+
   void Flush(GCLinkedLists* global_list) {
     work_list_.Flush();
     new_work_list_.Flush();
@@ -591,11 +595,17 @@ void GCMarker::ResetSlices() {
 }
 
 void GCMarker::IterateRoots(ObjectPointerVisitor* visitor) {
+  // Only the time spent in slices is a pause phase: the thread holding the
+  // safepoint waits for all slices to finish, whereas a concurrent marker that
+  // finds none left is already running outside the pause.
+  const int64_t start = OS::GetCurrentMonotonicMicros();
+  bool visited_slices = false;
   for (;;) {
     intptr_t slice = root_slices_started_.fetch_add(1);
     if (slice >= root_slices_count_) {
       break;  // No more slices.
     }
+    visited_slices = true;
 
     switch (slice) {
       case kIsolate: {
@@ -613,17 +623,26 @@ void GCMarker::IterateRoots(ObjectPointerVisitor* visitor) {
       ml.Notify();
     }
   }
+  if (visited_slices) {
+    heap_->pause_stats()->AddPhaseMicros(
+        GCPhase::kMarkRoots, OS::GetCurrentMonotonicMicros() - start);
+  }
 }
 
 enum WeakSlices {
   kWeakHandles = 0,
-  kWeakTables,
   kObjectIdRing,
   kRememberedSet,
-  kNumWeakSlices,
+  // One slice per weak selector in each space, so the tables are pruned in
+  // parallel.
+  kWeakTables,
+  kNumWeakSlices = kWeakTables + 2 * Heap::kNumWeakSelectors,
 };
 
 void GCMarker::IterateWeakRoots(Thread* thread) {
+  // Weak roots are only processed when marking is finalized, so unlike the
+  // roots this is always inside the pause.
+  GCPhaseScope phase(heap_->pause_stats(), GCPhase::kMarkWeak);
   for (;;) {
     intptr_t slice = weak_slices_started_.fetch_add(1);
     if (slice >= kNumWeakSlices) {
@@ -634,17 +653,19 @@ void GCMarker::IterateWeakRoots(Thread* thread) {
       case kWeakHandles:
         ProcessWeakHandles(thread);
         break;
-      case kWeakTables:
-        ProcessWeakTables(thread);
-        break;
       case kObjectIdRing:
         ProcessObjectIdTable(thread);
         break;
       case kRememberedSet:
         ProcessRememberedSet(thread);
         break;
-      default:
-        UNREACHABLE();
+      default: {
+        ASSERT(slice >= kWeakTables);
+        const intptr_t table = slice - kWeakTables;
+        ProcessWeakTable(thread, table / 2,
+                         (table % 2) == 0 ? Heap::kOld : Heap::kNew);
+        break;
+      }
     }
   }
 }
@@ -657,46 +678,41 @@ void GCMarker::ProcessWeakHandles(Thread* thread) {
   isolate_group_->VisitWeakPersistentHandles(&visitor);
 }
 
-void GCMarker::ProcessWeakTables(Thread* thread) {
-  TIMELINE_FUNCTION_GC_DURATION(thread, "ProcessWeakTables");
-  for (int sel = 0; sel < Heap::kNumWeakSelectors; sel++) {
-    Dart_HeapSamplingDeleteCallback cleanup = nullptr;
+void GCMarker::ProcessWeakTable(Thread* thread,
+                                intptr_t sel,
+                                Heap::Space space) {
+  TIMELINE_FUNCTION_GC_DURATION(thread, "ProcessWeakTable");
+  const int64_t start = OS::GetCurrentMonotonicMicros();
+  const auto selector = static_cast<Heap::WeakSelector>(sel);
+  Dart_HeapSamplingDeleteCallback cleanup = nullptr;
 #if !defined(PRODUCT) || defined(FORCE_INCLUDE_SAMPLING_HEAP_PROFILER)
-    if (sel == Heap::kHeapSamplingData) {
-      cleanup = HeapProfileSampler::delete_callback();
-    }
+  if (selector == Heap::kHeapSamplingData) {
+    cleanup = HeapProfileSampler::delete_callback();
+  }
 #endif
-    WeakTable* table =
-        heap_->GetWeakTable(Heap::kOld, static_cast<Heap::WeakSelector>(sel));
-    intptr_t size = table->size();
-    for (intptr_t i = 0; i < size; i++) {
-      if (table->IsValidEntryAtExclusive(i)) {
-        // The object has been collected.
-        ObjectPtr obj = table->ObjectAtExclusive(i);
-        if (obj->IsHeapObject() && !obj->untag()->IsMarked()) {
-          if (cleanup != nullptr) {
-            cleanup(reinterpret_cast<void*>(table->ValueAtExclusive(i)));
-          }
-          table->InvalidateAtExclusive(i);
-        }
-      }
-    }
-    table =
-        heap_->GetWeakTable(Heap::kNew, static_cast<Heap::WeakSelector>(sel));
-    size = table->size();
-    for (intptr_t i = 0; i < size; i++) {
-      if (table->IsValidEntryAtExclusive(i)) {
-        // The object has been collected.
-        ObjectPtr obj = table->ObjectAtExclusive(i);
-        if (obj->IsHeapObject() && !obj->untag()->IsMarked()) {
-          if (cleanup != nullptr) {
-            cleanup(reinterpret_cast<void*>(table->ValueAtExclusive(i)));
-          }
-          table->InvalidateAtExclusive(i);
+  WeakTable* table = heap_->GetWeakTable(space, selector);
+  const intptr_t entries = table->count();
+  intptr_t size = table->size();
+  for (intptr_t i = 0; i < size; i++) {
+    if (table->IsValidEntryAtExclusive(i)) {
+      // The object has been collected.
+      ObjectPtr obj = table->ObjectAtExclusive(i);
+      if (obj->IsHeapObject() && !obj->untag()->IsMarked()) {
+        if (cleanup != nullptr) {
+          cleanup(reinterpret_cast<void*>(table->ValueAtExclusive(i)));
         }
+        table->InvalidateAtExclusive(i);
       }
     }
   }
+  heap_->AddWeakTableMicros(selector,
+                            OS::GetCurrentMonotonicMicros() - start);
+#if defined(SUPPORT_TIMELINE)
+  tbes.SetNumArguments(3);
+  tbes.CopyArgument(0, "Table", Heap::WeakSelectorToString(selector));
+  tbes.CopyArgument(1, "Space", space == Heap::kNew ? "new" : "old");
+  tbes.FormatArgument(2, "Entries", "%" Pd "", entries);
+#endif
 }
 
 void GCMarker::ProcessRememberedSet(Thread* thread) {
@@ -858,9 +874,20 @@ class ParallelMarkTask : public ThreadPool::Task {
       marker_->IterateWeakRoots(thread);
       int64_t stop = OS::GetCurrentMonotonicMicros();
       visitor_->AddMicros(stop - start);
+#if defined(SUPPORT_TIMELINE)
+      tbes.SetNumArguments(3);
+      tbes.FormatArgument(0, "Steal attempts", "%" Pd "",
+                          visitor_->steal_attempts());
+      tbes.FormatArgument(1, "Steals", "%" Pd "", visitor_->steals());
+      tbes.FormatArgument(2, "Shared blocks", "%" Pd "",
+                          visitor_->shared_blocks());
+#endif
       if (FLAG_log_marker_tasks) {
-        THR_Print("Task marked %" Pd " bytes in %" Pd64 " micros.\n",
-                  visitor_->marked_bytes(), visitor_->marked_micros());
+        THR_Print("Task marked %" Pd " bytes in %" Pd64 " micros, stole %" Pd
+                  " of %" Pd " attempts, shared %" Pd " blocks.\n",
+                  visitor_->marked_bytes(), visitor_->marked_micros(),
+                  visitor_->steals(), visitor_->steal_attempts(),
+                  visitor_->shared_blocks());
       }
     }
   }
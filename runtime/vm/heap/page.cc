@@ -23,27 +23,76 @@ namespace dart {
 
 // This cache needs to be at least as big as FLAG_new_gen_semi_max_size or
 // munmap will noticeably impact performance.
-static constexpr intptr_t kPageCacheCapacity = 8 * kWordSize;
+DEFINE_FLAG(int,
+            page_cache_capacity,
+            8 * kWordSize,
+            "Maximum number of freed heap pages kept mapped for reuse, shared "
+            "by all isolate groups.");
+DEFINE_FLAG(int,
+            page_cache_resident,
+            -1,
+            "Number of most recently cached pages whose memory is kept "
+            "resident. Older cached pages are released with madvise but stay "
+            "mapped for reuse, and idle notifications release rather than "
+            "unmap the cache. -1 keeps all cached pages resident.");
+
 static Mutex* page_cache_mutex = nullptr;
-static VirtualMemory* page_cache[kPageCacheCapacity] = {nullptr};
+static VirtualMemory** page_cache = nullptr;
+static intptr_t page_cache_capacity = 0;
 static intptr_t page_cache_size = 0;
+// Entries [0, page_cache_released) have had their memory released. The cache
+// is used as a stack, so these are the pages that have been idle the longest.
+static intptr_t page_cache_released = 0;
+static intptr_t page_cache_hits = 0;
+static intptr_t page_cache_misses = 0;
 
 void Page::Init() {
   ASSERT(page_cache_mutex == nullptr);
   page_cache_mutex = new Mutex(NOT_IN_PRODUCT("page_cache_mutex"));
+  page_cache_capacity = Utils::Maximum(FLAG_page_cache_capacity, 0);
+  page_cache = new VirtualMemory*[page_cache_capacity];
+  page_cache_size = 0;
+  page_cache_released = 0;
+  page_cache_hits = 0;
+  page_cache_misses = 0;
 }
 
 void Page::ClearCache() {
   MutexLocker ml(page_cache_mutex);
   ASSERT(page_cache_size >= 0);
-  ASSERT(page_cache_size <= kPageCacheCapacity);
+  ASSERT(page_cache_size <= page_cache_capacity);
   while (page_cache_size > 0) {
     delete page_cache[--page_cache_size];
   }
+  page_cache_released = 0;
+}
+
+static void ReleaseCachedPageLocked(intptr_t index) {
+  VirtualMemory* memory = page_cache[index];
+  VirtualMemory::DontNeed(memory->address(), memory->size());
+}
+
+void Page::ReleaseCachedMemory() {
+  MutexLocker ml(page_cache_mutex);
+  while (page_cache_released < page_cache_size) {
+    ReleaseCachedPageLocked(page_cache_released++);
+  }
+}
+
+void Page::NotifyIdle() {
+  if (FLAG_page_cache_resident >= 0) {
+    // Keep the mappings so a following burst of allocation does not go back
+    // to mmap.
+    ReleaseCachedMemory();
+  } else {
+    ClearCache();
+  }
 }
 
 void Page::Cleanup() {
   ClearCache();
+  delete[] page_cache;
+  page_cache = nullptr;
   delete page_cache_mutex;
   page_cache_mutex = nullptr;
 }
@@ -53,6 +102,21 @@ intptr_t Page::CachedSize() {
   return page_cache_size * kPageSize;
 }
 
+intptr_t Page::CachedResidentSize() {
+  MutexLocker ml(page_cache_mutex);
+  return (page_cache_size - page_cache_released) * kPageSize;
+}
+
+intptr_t Page::CacheHits() {
+  MutexLocker ml(page_cache_mutex);
+  return page_cache_hits;
+}
+
+intptr_t Page::CacheMisses() {
+  MutexLocker ml(page_cache_mutex);
+  return page_cache_misses;
+}
+
 static bool CanUseCache(uword flags) {
   return (flags & (Page::kExecutable | Page::kImage | Page::kLarge |
                    Page::kVMIsolate)) == 0;
@@ -72,9 +136,14 @@ Page* Page::Allocate(intptr_t size, uword flags) {
     ASSERT(size == kPageSize);
     MutexLocker ml(page_cache_mutex);
     ASSERT(page_cache_size >= 0);
-    ASSERT(page_cache_size <= kPageCacheCapacity);
+    ASSERT(page_cache_size <= page_cache_capacity);
     if (page_cache_size > 0) {
       memory = page_cache[--page_cache_size];
+      page_cache_released =
+          Utils::Minimum(page_cache_released, page_cache_size);
+      page_cache_hits++;
+    } else {
+      page_cache_misses++;
     }
   }
   if (memory == nullptr) {
@@ -151,8 +220,8 @@ void Page::Deallocate() {
     ASSERT(memory->size() == kPageSize);
     MutexLocker ml(page_cache_mutex);
     ASSERT(page_cache_size >= 0);
-    ASSERT(page_cache_size <= kPageCacheCapacity);
-    if (page_cache_size < kPageCacheCapacity) {
+    ASSERT(page_cache_size <= page_cache_capacity);
+    if (page_cache_size < page_cache_capacity) {
       intptr_t size = memory->size();
 #if defined(DEBUG)
       if ((flags_ & kNew) != 0) {
@@ -165,6 +234,11 @@ void Page::Deallocate() {
       MSAN_POISON(memory->address(), size);
       page_cache[page_cache_size++] = memory;
       memory = nullptr;
+      const intptr_t resident = FLAG_page_cache_resident;
+      if ((resident >= 0) &&
+          (page_cache_size - page_cache_released > resident)) {
+        ReleaseCachedPageLocked(page_cache_released++);
+      }
     }
   }
   delete memory;
@@ -207,13 +281,13 @@ void Page::VisitObjectPointers(ObjectPointerVisitor* visitor) const {
   ASSERT(obj_addr == end_addr);
 }
 
-void Page::VisitRememberedCards(ObjectPointerVisitor* visitor) {
+intptr_t Page::VisitRememberedCards(ObjectPointerVisitor* visitor) {
   ASSERT(Thread::Current()->OwnsGCSafepoint() ||
          (Thread::Current()->task_kind() == Thread::kScavengerTask));
   NoSafepointScope no_safepoint;
 
   if (card_table_ == nullptr) {
-    return;
+    return 0;
   }
 
   ArrayPtr obj =
@@ -228,51 +302,63 @@ void Page::VisitRememberedCards(ObjectPointerVisitor* visitor) {
   const size_t size_in_bits = card_table_size();
   const size_t size_in_words =
       Utils::RoundUp(size_in_bits, kBitsPerWord) >> kBitsPerWordLog2;
+  intptr_t cards_visited = 0;
   for (;;) {
-    const size_t word_offset = progress_bar_.fetch_add(1);
-    if (word_offset >= size_in_words) break;
-
-    uword cell = card_table_[word_offset];
-    if (cell == 0) continue;
-
-    for (intptr_t bit_offset = 0; bit_offset < kBitsPerWord; bit_offset++) {
-      const uword bit_mask = static_cast<uword>(1) << bit_offset;
-      if ((cell & bit_mask) == 0) continue;
-      const intptr_t i = (word_offset << kBitsPerWordLog2) + bit_offset;
-
-      CompressedObjectPtr* card_from =
-          reinterpret_cast<CompressedObjectPtr*>(this) +
-          (i << kSlotsPerCardLog2);
-      CompressedObjectPtr* card_to =
-          reinterpret_cast<CompressedObjectPtr*>(card_from) +
-          (1 << kSlotsPerCardLog2) - 1;
-      // Minus 1 because to is inclusive.
-
-      if (card_from < obj_from) {
-        // First card overlaps with header.
-        card_from = obj_from;
-      }
-      if (card_to > obj_to) {
-        // Last card(s) may extend past the object. Array truncation can make
-        // this happen for more than one card.
-        card_to = obj_to;
-      }
+    // Claim several words at once: for a huge array with only a few dirty
+    // cards, the atomic increment would otherwise dominate the scan.
+    const size_t first_word = progress_bar_.fetch_add(kCardTableWordsPerClaim);
+    if (first_word >= size_in_words) break;
+    const size_t last_word =
+        Utils::Minimum(first_word + kCardTableWordsPerClaim, size_in_words);
+
+    for (size_t word_offset = first_word; word_offset < last_word;
+         word_offset++) {
+      uword cell = card_table_[word_offset];
+      if (cell == 0) continue;
+
+      uword pending = cell;
+      while (pending != 0) {
+        const intptr_t bit_offset = Utils::CountTrailingZerosWord(pending);
+        const uword bit_mask = static_cast<uword>(1) << bit_offset;
+        pending ^= bit_mask;
+        const intptr_t i = (word_offset << kBitsPerWordLog2) + bit_offset;
+
+        CompressedObjectPtr* card_from =
+            reinterpret_cast<CompressedObjectPtr*>(this) +
+            (i << kSlotsPerCardLog2);
+        CompressedObjectPtr* card_to =
+            reinterpret_cast<CompressedObjectPtr*>(card_from) +
+            (1 << kSlotsPerCardLog2) - 1;
+        // Minus 1 because to is inclusive.
+
+        if (card_from < obj_from) {
+          // First card overlaps with header.
+          card_from = obj_from;
+        }
+        if (card_to > obj_to) {
+          // Last card(s) may extend past the object. Array truncation can make
+          // this happen for more than one card.
+          card_to = obj_to;
+        }
 
-      visitor->VisitCompressedPointers(heap_base, card_from, card_to);
+        visitor->VisitCompressedPointers(heap_base, card_from, card_to);
+        cards_visited++;
 
-      bool has_new_target = false;
-      for (CompressedObjectPtr* slot = card_from; slot <= card_to; slot++) {
-        if ((*slot)->IsNewObjectMayBeSmi()) {
-          has_new_target = true;
-          break;
+        bool has_new_target = false;
+        for (CompressedObjectPtr* slot = card_from; slot <= card_to; slot++) {
+          if ((*slot)->IsNewObjectMayBeSmi()) {
+            has_new_target = true;
+            break;
+          }
+        }
+        if (!has_new_target) {
+          cell ^= bit_mask;
         }
       }
-      if (!has_new_target) {
-        cell ^= bit_mask;
-      }
+      card_table_[word_offset] = cell;
     }
-    card_table_[word_offset] = cell;
   }
+  return cards_visited;
 }
 
 void Page::ResetProgressBar() {
@@ -61,8 +61,17 @@ static constexpr intptr_t kAllocationRedZoneSize = kObjectAlignment;
 class Page {
  public:
   static void Init();
+  // Unmaps all pages in the cache of freed pages.
   static void ClearCache();
+  // Releases the memory of all cached pages to the OS but keeps them mapped
+  // for reuse.
+  static void ReleaseCachedMemory();
+  // Either releases or clears the cache, depending on --page_cache_resident.
+  static void NotifyIdle();
   static intptr_t CachedSize();
+  static intptr_t CachedResidentSize();
+  static intptr_t CacheHits();
+  static intptr_t CacheMisses();
   static void Cleanup();
 
   enum PageFlags : uword {
@@ -159,6 +168,10 @@ class Page {
 
   static intptr_t card_table_offset() { return OFFSET_OF(Page, card_table_); }
 
+  // Number of card table words claimed at a time by each visitor of
+  // the remembered cards.
+  static constexpr intptr_t kCardTableWordsPerClaim = 16;
+
   void RememberCard(ObjectPtr const* slot) {
     RememberCard(reinterpret_cast<uword>(slot));
   }
@@ -173,7 +186,8 @@ class Page {
     return IsCardRemembered(reinterpret_cast<uword>(slot));
   }
 #endif
-  void VisitRememberedCards(ObjectPointerVisitor* visitor);
+  // Returns the number of remembered cards visited.
+  intptr_t VisitRememberedCards(ObjectPointerVisitor* visitor);
   void ResetProgressBar();
 
   Thread* owner() const {
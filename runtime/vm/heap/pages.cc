@@ -44,6 +44,29 @@ DEFINE_FLAG(bool,
             false,
             "Print free list statistics after a GC");
 DEFINE_FLAG(bool, log_growth, false, "Log PageSpace growth policy decisions.");
+DEFINE_FLAG(int,
+            compact_fragmentation_threshold,
+            0,
+            "Upgrade a mark-sweep to a mark-compact when more than this "
+            "percentage of old-space capacity is free after marking. 0 "
+            "disables fragmentation-driven compaction.");
+DEFINE_FLAG(int,
+            throughput_gc_time_target,
+            5,
+            "In the throughput performance mode, grow the heap so that at "
+            "most this percentage of time is spent in GC. 0 disables the "
+            "throughput growth policy.");
+DEFINE_FLAG(bool,
+            sweep_on_demand,
+            true,
+            "When old-space allocation fails during concurrent sweeping, sweep "
+            "pages on the allocating thread instead of waiting for the "
+            "sweeper.");
+DEFINE_FLAG(bool,
+            shard_old_space_allocation,
+            true,
+            "Spread mutator old-space allocation over the data freelists "
+            "instead of sharing a single freelist lock.");
 
 // The initial estimate of how many words we can mark per microsecond (usage
 // before / mark-sweep time). This is a conservative value observed running
@@ -63,6 +86,8 @@ PageSpace::PageSpace(Heap* heap, intptr_t max_capacity_in_words)
       tasks_(0),
       concurrent_marker_tasks_(0),
       concurrent_marker_tasks_active_(0),
+      concurrent_sweeper_tasks_(0),
+      concurrent_sweeper_tasks_large_(0),
       pause_concurrent_marking_(0),
       phase_(kDone),
 #if defined(DEBUG)
@@ -76,7 +101,8 @@ PageSpace::PageSpace(Heap* heap, intptr_t max_capacity_in_words)
       gc_time_micros_(0),
       collections_(0),
       mark_words_per_micro_(kConservativeInitialMarkSpeed),
-      enable_concurrent_mark_(FLAG_concurrent_mark) {
+      enable_concurrent_mark_(FLAG_concurrent_mark),
+      last_collection_compacted_(false) {
   ASSERT(heap != nullptr);
 
   // We aren't holding the lock but no one can reference us yet.
@@ -407,6 +433,9 @@ uword PageSpace::TryAllocateInternal(intptr_t size,
       result = freelist->TryAllocateLocked(size, is_protected);
     } else {
       result = freelist->TryAllocate(size, is_protected);
+      if (result == 0 && !is_exec) {
+        result = TryAllocateFromOtherFreeLists(size, freelist);
+      }
     }
     if (result == 0) {
       result = TryAllocateInFreshPage(size, freelist, is_exec, growth_policy,
@@ -423,6 +452,37 @@ uword PageSpace::TryAllocateInternal(intptr_t size,
   return result;
 }
 
+FreeList* PageSpace::MutatorFreeList() {
+  const intptr_t num_shards = num_freelists_ - kDataFreelist;
+  if (!FLAG_shard_old_space_allocation || num_shards == 1) {
+    return &freelists_[kDataFreelist];
+  }
+  // Thread objects are long-lived and reused, so hashing the current thread
+  // keeps each mutator on the same freelist between allocations.
+  const intptr_t hash =
+      Utils::WordHash(reinterpret_cast<intptr_t>(Thread::Current()));
+  return DataFreeList(hash % num_shards);
+}
+
+uword PageSpace::TryAllocateFromOtherFreeLists(intptr_t size, FreeList* home) {
+  // Before the heap is grown, free space may still be available in
+  // the freelists the sweeper distributed to the other shards.
+  const intptr_t num_shards = num_freelists_ - kDataFreelist;
+  if (!FLAG_shard_old_space_allocation || num_shards == 1) {
+    return 0;
+  }
+  const bool is_protected = false;
+  for (intptr_t i = 0; i < num_shards; i++) {
+    FreeList* freelist = DataFreeList(i);
+    if (freelist == home) continue;
+    uword result = freelist->TryAllocate(size, is_protected);
+    if (result != 0) {
+      return result;
+    }
+  }
+  return 0;
+}
+
 void PageSpace::AcquireLock(FreeList* freelist) {
   freelist->mutex()->Lock();
 }
@@ -648,6 +708,12 @@ void PageSpace::VisitObjects(ObjectVisitor* visitor) const {
   }
 }
 
+void PageSpace::AddPagesTo(MallocGrowableArray<Page*>* pages) const {
+  for (ExclusivePageIterator it(this); !it.Done(); it.Advance()) {
+    pages->Add(it.page());
+  }
+}
+
 void PageSpace::VisitObjectsNoImagePages(ObjectVisitor* visitor) const {
   for (ExclusivePageIterator it(this); !it.Done(); it.Advance()) {
     if (!it.page()->is_image()) {
@@ -676,7 +742,8 @@ void PageSpace::VisitObjectPointers(ObjectPointerVisitor* visitor) const {
   }
 }
 
-void PageSpace::VisitRememberedCards(ObjectPointerVisitor* visitor) const {
+intptr_t PageSpace::VisitRememberedCards(
+    ObjectPointerVisitor* visitor) const {
   ASSERT(Thread::Current()->OwnsGCSafepoint() ||
          (Thread::Current()->task_kind() == Thread::kScavengerTask));
 
@@ -699,11 +766,13 @@ void PageSpace::VisitRememberedCards(ObjectPointerVisitor* visitor) const {
     page = large_pages_;
     tail = large_pages_tail_;
   }
+  intptr_t cards_visited = 0;
   while (page != nullptr) {
-    page->VisitRememberedCards(visitor);
+    cards_visited += page->VisitRememberedCards(visitor);
     if (page == tail) break;
     page = page->next();
   }
+  return cards_visited;
 }
 
 void PageSpace::ResetProgressBars() const {
@@ -737,6 +806,12 @@ void PageSpace::PrintToJSONObject(JSONObject* object) const {
   space.AddProperty64("capacity", CapacityInWords() * kWordSize);
   space.AddProperty64("external", ExternalInWords() * kWordSize);
   space.AddProperty("time", MicrosecondsToSeconds(gc_time_micros()));
+  space.AddProperty("gcTimeFraction",
+                    static_cast<intptr_t>(
+                        page_space_controller_.last_gc_time_fraction()));
+  space.AddProperty("gcTimeTarget",
+                    static_cast<intptr_t>(
+                        page_space_controller_.ThroughputGCTimeTarget()));
   if (collections() > 0) {
     int64_t run_time = isolate_group->UptimeMicros();
     run_time = Utils::Maximum(run_time, static_cast<int64_t>(0));
@@ -823,13 +898,24 @@ void PageSpace::WriteProtectCode(bool read_only) {
   }
 }
 
-bool PageSpace::ShouldStartIdleMarkSweep(int64_t deadline) {
+bool PageSpace::ShouldStartIdleMarkSweep(int64_t deadline,
+                                         int64_t idle_interval_micros) {
   // To make a consistent decision, we should not yield for a safepoint in the
   // middle of deciding whether to perform an idle GC.
   NoSafepointScope no_safepoint;
 
   if (!page_space_controller_.ReachedIdleThreshold(usage_)) {
-    return false;
+    if (idle_interval_micros <= 0) {
+      return false;
+    }
+    // Start now if promotion at the recent rate would cross the soft
+    // threshold, and so start marking, before the next idle period.
+    SpaceUsage predicted = usage_;
+    predicted.used_in_words += static_cast<intptr_t>(
+        heap_->new_space()->PromotionWordsPerMicro() * idle_interval_micros);
+    if (!page_space_controller_.ReachedSoftThreshold(predicted)) {
+      return false;
+    }
   }
 
   {
@@ -850,18 +936,24 @@ bool PageSpace::ShouldStartIdleMarkSweep(int64_t deadline) {
   return estimated_mark_completion <= deadline;
 }
 
+double PageSpace::FragmentationRatio() const {
+  if (usage_.capacity_in_words == 0) {
+    return 0.0;
+  }
+  // Discount two pages to account for the newest data and code pages, whose
+  // partial use doesn't indicate fragmentation.
+  const intptr_t excess_in_words =
+      usage_.capacity_in_words - usage_.used_in_words - 2 * kPageSizeInWords;
+  return static_cast<double>(excess_in_words) /
+         static_cast<double>(usage_.capacity_in_words);
+}
+
 bool PageSpace::ShouldPerformIdleMarkCompact(int64_t deadline) {
   // To make a consistent decision, we should not yield for a safepoint in the
   // middle of deciding whether to perform an idle GC.
   NoSafepointScope no_safepoint;
 
-  // Discount two pages to account for the newest data and code pages, whose
-  // partial use doesn't indicate fragmentation.
-  const intptr_t excess_in_words =
-      usage_.capacity_in_words - usage_.used_in_words - 2 * kPageSizeInWords;
-  const double excess_ratio = static_cast<double>(excess_in_words) /
-                              static_cast<double>(usage_.capacity_in_words);
-  const bool fragmented = excess_ratio > 0.05;
+  const bool fragmented = FragmentationRatio() > 0.05;
 
   if (!fragmented && !page_space_controller_.ReachedIdleThreshold(usage_)) {
     return false;
@@ -1052,12 +1144,30 @@ void PageSpace::CollectGarbageHelper(Thread* thread,
   ReleaseBumpAllocation();
 
   marker_->MarkObjects(this);
-  usage_.used_in_words = marker_->marked_words() + allocated_black_in_words_;
+  // Permanent objects stay marked, so the marker neither traces nor counts
+  // them.
+  usage_.used_in_words = marker_->marked_words() + allocated_black_in_words_ +
+                         heap_->PermanentInWords();
   allocated_black_in_words_ = 0;
   mark_words_per_micro_ = marker_->MarkedWordsPerMicro();
   delete marker_;
   marker_ = nullptr;
 
+  // Marking has determined exactly how much of old-space is live, so compact
+  // only when the heap is actually fragmented instead of on every GC (as with
+  // --use_compactor) or never.
+  if (!compact && (FLAG_compact_fragmentation_threshold > 0)) {
+    const double fragmentation = FragmentationRatio();
+    if (fragmentation > (FLAG_compact_fragmentation_threshold / 100.0)) {
+      compact = true;
+      if (FLAG_verbose_gc) {
+        OS::PrintErr("[ Compacting ] %.1f%% of old-space is free\n",
+                     fragmentation * 100.0);
+      }
+    }
+  }
+  last_collection_compacted_ = compact;
+
   // Reset the freelists and setup sweeping.
   for (intptr_t i = 0; i < num_freelists_; i++) {
     freelists_[i].Reset();
@@ -1071,6 +1181,7 @@ void PageSpace::CollectGarbageHelper(Thread* thread,
     // Executable pages are always swept immediately to simplify
     // code protection.
     TIMELINE_FUNCTION_GC_DURATION(thread, "SweepExecutable");
+    GCPhaseScope phase(heap_->pause_stats(), GCPhase::kSweep);
     GCSweeper sweeper;
     Page* prev_page = nullptr;
     Page* page = exec_pages_;
@@ -1105,8 +1216,12 @@ void PageSpace::CollectGarbageHelper(Thread* thread,
   }
 
   bool can_verify;
-  SweepNew();
+  {
+    GCPhaseScope phase(heap_->pause_stats(), GCPhase::kSweep);
+    SweepNew();
+  }
   if (compact) {
+    GCPhaseScope phase(heap_->pause_stats(), GCPhase::kCompact);
     Compact(thread);
     set_phase(kDone);
     can_verify = true;
@@ -1114,6 +1229,7 @@ void PageSpace::CollectGarbageHelper(Thread* thread,
     ConcurrentSweep(isolate_group);
     can_verify = false;
   } else {
+    GCPhaseScope phase(heap_->pause_stats(), GCPhase::kSweep);
     SweepLarge();
     Sweep(/*exclusive*/ true);
     set_phase(kDone);
@@ -1214,26 +1330,8 @@ void PageSpace::Sweep(bool exclusive) {
     // evenly distributed among the freelists and so roughly evenly available
     // to each scavenger worker.
     shard = (shard + 1) % num_shards;
-    FreeList* freelist = DataFreeList(shard);
-    if (!exclusive) {
-      freelist->mutex()->Lock();
-    }
-    bool page_in_use = sweeper.SweepPage(page, freelist);
-    if (!exclusive) {
-      freelist->mutex()->Unlock();
-    }
-    intptr_t size;
-    if (!page_in_use) {
-      size = page->memory_->size();
-      page->Deallocate();
-    }
+    SweepRegularPage(&sweeper, page, DataFreeList(shard), exclusive);
     ml.Lock();
-
-    if (page_in_use) {
-      AddPageLocked(page);
-    } else {
-      IncreaseCapacityInWordsLocked(-(size >> kWordSizeLog2));
-    }
   }
 
   if (exclusive) {
@@ -1243,6 +1341,60 @@ void PageSpace::Sweep(bool exclusive) {
   }
 }
 
+void PageSpace::SweepRegularPage(GCSweeper* sweeper,
+                                 Page* page,
+                                 FreeList* freelist,
+                                 bool exclusive) {
+  if (!exclusive) {
+    freelist->mutex()->Lock();
+  }
+  bool page_in_use = sweeper->SweepPage(page, freelist);
+  if (!exclusive) {
+    freelist->mutex()->Unlock();
+  }
+  intptr_t size;
+  if (!page_in_use) {
+    size = page->memory_->size();
+    page->Deallocate();
+  }
+
+  MutexLocker ml(&pages_lock_);
+  if (page_in_use) {
+    AddPageLocked(page);
+  } else {
+    IncreaseCapacityInWordsLocked(-(size >> kWordSizeLog2));
+  }
+}
+
+uword PageSpace::TryAllocateSweepingOnDemand(intptr_t size) {
+  if (!FLAG_sweep_on_demand || !IsAllocatableViaFreeLists(size)) {
+    return 0;
+  }
+  GCSweeper sweeper;
+  FreeList* freelist = MutatorFreeList();
+  const bool is_protected = false;
+  for (;;) {
+    Page* page;
+    {
+      MutexLocker ml(&pages_lock_);
+      page = sweep_regular_;
+      if (page == nullptr) {
+        return 0;
+      }
+      sweep_regular_ = page->next();
+      page->set_next(nullptr);
+    }
+    ASSERT(!page->is_executable());
+    SweepRegularPage(&sweeper, page, freelist, /*exclusive*/ false);
+
+    uword result = freelist->TryAllocate(size, is_protected);
+    if (result != 0) {
+      usage_.used_in_words += (size >> kWordSizeLog2);
+      return result;
+    }
+  }
+}
+
 void PageSpace::ConcurrentSweep(IsolateGroup* isolate_group) {
   // Start the concurrent sweeper task now.
   GCSweeper::SweepConcurrent(isolate_group);
@@ -1402,6 +1554,14 @@ bool PageSpaceController::ReachedSoftThreshold(SpaceUsage after) const {
   return after.CombinedUsedInWords() > soft_gc_threshold_in_words_;
 }
 
+int PageSpaceController::ThroughputGCTimeTarget() const {
+  if ((heap_ == nullptr) ||
+      (heap_->mode() != Dart_PerformanceMode_Throughput)) {
+    return 0;
+  }
+  return Utils::Maximum(FLAG_throughput_gc_time_target, 0);
+}
+
 bool PageSpaceController::ReachedIdleThreshold(SpaceUsage current) const {
   if (heap_growth_ratio_ == 100) {
     return false;
@@ -1416,6 +1576,7 @@ void PageSpaceController::EvaluateGarbageCollection(SpaceUsage before,
   ASSERT(end >= start);
   history_.AddGarbageCollectionTime(start, end);
   const int gc_time_fraction = history_.GarbageCollectionTimeFraction();
+  last_gc_time_fraction_ = gc_time_fraction;
 
   // Assume garbage increases linearly with allocation:
   // G = kA, and estimate k from the previous cycle.
@@ -1491,6 +1652,17 @@ void PageSpaceController::EvaluateGarbageCollection(SpaceUsage before,
   }
   last_usage_ = after;
 
+  const char* reason = "gc";
+  const int gc_time_target = ThroughputGCTimeTarget();
+  if ((gc_time_target > 0) && (gc_time_fraction > gc_time_target) &&
+      (grow_heap > 0)) {
+    // The cost of a collection is roughly proportional to the live data, so
+    // stretching the allocation between collections by the ratio of the
+    // observed to the target GC time brings the GC time down to the target.
+    grow_heap = grow_heap * gc_time_fraction / gc_time_target;
+    reason = "throughput";
+  }
+
   intptr_t max_capacity_in_words = heap_->old_space()->max_capacity_in_words_;
   if (max_capacity_in_words != 0) {
     ASSERT(grow_heap >= 0);
@@ -1511,7 +1683,7 @@ void PageSpaceController::EvaluateGarbageCollection(SpaceUsage before,
     grow_heap = Utils::Maximum(min_step, grow_heap);
   }
 
-  RecordUpdate(before, after, grow_heap, "gc");
+  RecordUpdate(before, after, grow_heap, reason);
 }
 
 void PageSpaceController::EvaluateAfterLoading(SpaceUsage after) {
@@ -1559,7 +1731,7 @@ void PageSpaceController::RecordUpdate(SpaceUsage before,
   Thread* thread = Thread::Current();
   if (thread != nullptr) {
     TIMELINE_FUNCTION_GC_DURATION(thread, "UpdateGrowthLimit");
-    tbes.SetNumArguments(6);
+    tbes.SetNumArguments(7);
     tbes.CopyArgument(0, "Reason", reason);
     tbes.FormatArgument(1, "Before.CombinedUsed (kB)", "%" Pd "",
                         RoundWordsToKB(before.CombinedUsedInWords()));
@@ -1571,16 +1743,20 @@ void PageSpaceController::RecordUpdate(SpaceUsage before,
                         RoundWordsToKB(soft_gc_threshold_in_words_));
     tbes.FormatArgument(5, "Idle Threshold (kB)", "%" Pd "",
                         RoundWordsToKB(idle_gc_threshold_in_words_));
+    tbes.FormatArgument(6, "GC Time Fraction (%)", "%d",
+                        last_gc_time_fraction_);
   }
 #endif
 
   if (FLAG_log_growth || FLAG_verbose_gc) {
     THR_Print("%s: hard_threshold=%" Pd "MB, soft_threshold=%" Pd
-              "MB, idle_threshold=%" Pd "MB, reason=%s\n",
+              "MB, idle_threshold=%" Pd
+              "MB, gc_time=%d%%, gc_time_target=%d%%, reason=%s\n",
               heap_->isolate_group()->source()->name,
               RoundWordsToMB(hard_gc_threshold_in_words_),
               RoundWordsToMB(soft_gc_threshold_in_words_),
-              RoundWordsToMB(idle_gc_threshold_in_words_), reason);
+              RoundWordsToMB(idle_gc_threshold_in_words_),
+              last_gc_time_fraction_, ThroughputGCTimeTarget(), reason);
   }
 }
 
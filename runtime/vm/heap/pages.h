@@ -26,6 +26,7 @@ class ObjectPointerVisitor;
 class ObjectSet;
 class ForwardingPage;
 class GCMarker;
+class GCSweeper;
 
 // The history holds the timing information of the last garbage collection
 // runs.
@@ -72,6 +73,13 @@ class PageSpaceController {
   // Returns whether an idle GC is worthwhile.
   bool ReachedIdleThreshold(SpaceUsage current) const;
 
+  // The percentage of time the embedder is willing to spend in GC, or 0 if
+  // the heap is not in the throughput performance mode.
+  int ThroughputGCTimeTarget() const;
+
+  // Percentage of time spent in old-space GC over the recent history.
+  int last_gc_time_fraction() const { return last_gc_time_fraction_; }
+
   // Should be called after each collection to update the controller state.
   void EvaluateGarbageCollection(SpaceUsage before,
                                  SpaceUsage after,
@@ -121,6 +129,8 @@ class PageSpaceController {
 
   PageSpaceGarbageCollectionHistory history_;
 
+  int last_gc_time_fraction_ = 0;
+
   DISALLOW_IMPLICIT_CONSTRUCTORS(PageSpaceController);
 };
 
@@ -144,9 +154,13 @@ class PageSpace {
     bool is_protected = (is_executable) && FLAG_write_protect_code;
     bool is_locked = false;
     return TryAllocateInternal(
-        size, &freelists_[is_executable ? kExecutableFreelist : kDataFreelist],
+        size,
+        is_executable ? &freelists_[kExecutableFreelist] : MutatorFreeList(),
         is_executable, growth_policy, is_protected, is_locked);
   }
+  // Sweeps unswept regular pages on the allocating thread until 'size' can be
+  // allocated from the freelist. Returns 0 if sweeping did not help.
+  uword TryAllocateSweepingOnDemand(intptr_t size);
   DART_FORCE_INLINE
   uword TryAllocatePromoLocked(FreeList* freelist, intptr_t size) {
     if (LIKELY(IsAllocatableViaFreeLists(size))) {
@@ -226,15 +240,21 @@ class PageSpace {
 
   void VisitObjects(ObjectVisitor* visitor) const;
   void VisitObjectsNoImagePages(ObjectVisitor* visitor) const;
+  // Adds the pages visited by VisitObjects, in the same order.
+  void AddPagesTo(MallocGrowableArray<Page*>* pages) const;
   void VisitObjectsImagePages(ObjectVisitor* visitor) const;
   void VisitObjectsUnsafe(ObjectVisitor* visitor) const;
   void VisitObjectPointers(ObjectPointerVisitor* visitor) const;
 
-  void VisitRememberedCards(ObjectPointerVisitor* visitor) const;
+  // Returns the number of remembered cards visited.
+  intptr_t VisitRememberedCards(ObjectPointerVisitor* visitor) const;
   void ResetProgressBars() const;
 
   // Collect the garbage in the page space using mark-sweep or mark-compact.
   void CollectGarbage(Thread* thread, bool compact, bool finalize);
+  // Whether the last finalized collection compacted, either because it was
+  // requested or because marking found old-space fragmented.
+  bool last_collection_compacted() const { return last_collection_compacted_; }
 
   void AddRegionsToObjectSet(ObjectSet* set) const;
 
@@ -243,8 +263,13 @@ class PageSpace {
   void WriteProtect(bool read_only);
   void WriteProtectCode(bool read_only);
 
-  bool ShouldStartIdleMarkSweep(int64_t deadline);
+  // 'idle_interval_micros' is the expected time until the next idle
+  // notification, or 0 if unknown.
+  bool ShouldStartIdleMarkSweep(int64_t deadline,
+                                int64_t idle_interval_micros);
   bool ShouldPerformIdleMarkCompact(int64_t deadline);
+  // Fraction of capacity not used by live objects, per the last usage update.
+  double FragmentationRatio() const;
   void IncrementalMarkWithSizeBudget(intptr_t size);
   void IncrementalMarkWithTimeBudget(int64_t deadline);
   void AssistTasks(MonitorLocker* ml);
@@ -330,6 +355,24 @@ class PageSpace {
     DEBUG_ASSERT(tasks_lock_.IsOwnedByCurrentThread());
     concurrent_marker_tasks_active_ = val;
   }
+  intptr_t concurrent_sweeper_tasks() const {
+    DEBUG_ASSERT(tasks_lock_.IsOwnedByCurrentThread());
+    return concurrent_sweeper_tasks_;
+  }
+  void set_concurrent_sweeper_tasks(intptr_t val) {
+    ASSERT(val >= 0);
+    DEBUG_ASSERT(tasks_lock_.IsOwnedByCurrentThread());
+    concurrent_sweeper_tasks_ = val;
+  }
+  intptr_t concurrent_sweeper_tasks_large() const {
+    DEBUG_ASSERT(tasks_lock_.IsOwnedByCurrentThread());
+    return concurrent_sweeper_tasks_large_;
+  }
+  void set_concurrent_sweeper_tasks_large(intptr_t val) {
+    ASSERT(val >= 0);
+    DEBUG_ASSERT(tasks_lock_.IsOwnedByCurrentThread());
+    concurrent_sweeper_tasks_large_ = val;
+  }
   bool pause_concurrent_marking() const {
     return pause_concurrent_marking_.load() != 0;
   }
@@ -379,6 +422,12 @@ class PageSpace {
                             GrowthPolicy growth_policy,
                             bool is_protected,
                             bool is_locked);
+  // The data freelist the current thread allocates from first. Mutators are
+  // spread over the same freelists the scavenger workers use so that
+  // concurrent old-space allocation does not serialize on one mutex.
+  FreeList* MutatorFreeList();
+  // Tries the data freelists other than 'home' without growing the heap.
+  uword TryAllocateFromOtherFreeLists(intptr_t size, FreeList* home);
   uword TryAllocateInFreshPage(intptr_t size,
                                FreeList* freelist,
                                bool is_executable,
@@ -415,6 +464,10 @@ class PageSpace {
   void SweepNew();
   void SweepLarge();
   void Sweep(bool exclusive);
+  void SweepRegularPage(GCSweeper* sweeper,
+                        Page* page,
+                        FreeList* freelist,
+                        bool exclusive);
   void ConcurrentSweep(IsolateGroup* isolate_group);
   void Compact(Thread* thread);
 
@@ -437,7 +490,8 @@ class PageSpace {
   // FLAG_scavenger_tasks count of lists for data pages starting at
   // freelists_[kDataFreelist]. The sweeper inserts into the data page
   // freelists round-robin. The scavenger workers each use one of the data
-  // page freelists without locking.
+  // page freelists without locking. Outside of scavenges, mutators allocate
+  // from the data page freelists selected by MutatorFreeList.
   const intptr_t num_freelists_;
   enum {
     kExecutableFreelist = 0,
@@ -472,6 +526,10 @@ class PageSpace {
   intptr_t tasks_;
   intptr_t concurrent_marker_tasks_;
   intptr_t concurrent_marker_tasks_active_;
+  // Number of concurrent sweeper tasks still running, and of those, the
+  // number still sweeping large pages.
+  intptr_t concurrent_sweeper_tasks_;
+  intptr_t concurrent_sweeper_tasks_large_;
   AcqRelAtomic<uword> pause_concurrent_marking_;
   Phase phase_;
 
@@ -486,6 +544,7 @@ class PageSpace {
   intptr_t mark_words_per_micro_;
 
   bool enable_concurrent_mark_;
+  bool last_collection_compacted_;
 
   friend class BasePageIterator;
   friend class ExclusivePageIterator;
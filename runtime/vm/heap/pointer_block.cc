@@ -94,7 +94,7 @@ void BlockStack<BlockSize>::PushBlockImpl(Block* block) {
     MonitorLocker ml(&monitor_);
     bool was_empty = IsEmptyLocked();
     full_.Push(block);
-    if (was_empty) ml.Notify();
+    if (was_empty || HasWaiters()) ml.Notify();
   } else if (block->IsEmpty()) {
     MutexLocker ml(global_mutex_);
     global_empty_->Push(block);
@@ -103,7 +103,7 @@ void BlockStack<BlockSize>::PushBlockImpl(Block* block) {
     MonitorLocker ml(&monitor_);
     bool was_empty = IsEmptyLocked();
     partial_.Push(block);
-    if (was_empty) ml.Notify();
+    if (was_empty || HasWaiters()) ml.Notify();
   }
 }
 
@@ -130,7 +130,9 @@ typename BlockStack<BlockSize>::Block* BlockStack<BlockSize>::WaitForWork(
       num_busy->fetch_add(1u);
       return partial_.Pop();
     }
+    num_waiters_.fetch_add(1);
     ml.Wait();
+    num_waiters_.fetch_sub(1);
     if (num_busy->load() == 0) {
       return nullptr;
     }
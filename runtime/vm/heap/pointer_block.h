@@ -113,6 +113,10 @@ class BlockStack {
 
   Block* WaitForWork(RelaxedAtomic<uintptr_t>* num_busy, bool abort);
 
+  // Whether any worker is blocked in WaitForWork. Busy workers check this to
+  // decide when to publish their local work.
+  bool HasWaiters() const { return num_waiters_.load() > 0; }
+
   void VisitObjectPointers(ObjectPointerVisitor* visitor);
 
  protected:
@@ -144,6 +148,7 @@ class BlockStack {
   List full_;
   List partial_;
   Monitor monitor_;
+  RelaxedAtomic<intptr_t> num_waiters_ = {0};
 
   // Note: This is shared on the basis of block size.
   static constexpr intptr_t kMaxGlobalEmpty = 100;
@@ -188,6 +193,8 @@ class BlockWorkList : public ValueObject {
         // Generated code appends to marking stacks; tell MemorySanitizer.
         MSAN_UNPOISON(local_input_, sizeof(*local_input_));
       }
+    } else if (UNLIKELY(stack_->HasWaiters())) {
+      ShareLocalWork();
     }
     *object = local_input_->Pop();
     return true;
@@ -214,15 +221,24 @@ class BlockWorkList : public ValueObject {
 
   bool WaitForWork(RelaxedAtomic<uintptr_t>* num_busy, bool abort = false) {
     ASSERT(local_input_->IsEmpty() || abort);
+    steal_attempts_++;
     Block* new_work = stack_->WaitForWork(num_busy, abort);
     if (new_work == nullptr) {
       return false;
     }
+    steals_++;
     stack_->PushBlock(local_input_);
     local_input_ = new_work;
     return true;
   }
 
+  // Number of times this worker ran out of local work and waited for work
+  // from other workers, how many of those waits obtained work, and how many
+  // blocks this worker published because other workers were idle.
+  intptr_t steal_attempts() const { return steal_attempts_; }
+  intptr_t steals() const { return steals_; }
+  intptr_t shared_blocks() const { return shared_blocks_; }
+
   void Finalize() {
     ASSERT(local_output_->IsEmpty());
     stack_->PushBlock(local_output_);
@@ -255,9 +271,29 @@ class BlockWorkList : public ValueObject {
   bool IsEmpty() { return IsLocalEmpty() && stack_->IsEmpty(); }
 
  private:
+  // Publishes part of this worker's local work so that idle workers don't
+  // wait while this worker processes a large structure on its own. Keeps at
+  // least one object locally to continue with.
+  DART_NOINLINE void ShareLocalWork() {
+    if (!local_output_->IsEmpty()) {
+      stack_->PushBlock(local_output_);
+      local_output_ = stack_->PopEmptyBlock();
+      shared_blocks_++;
+    } else if (local_input_->Count() > 1) {
+      Block* shared = local_input_;
+      local_input_ = stack_->PopEmptyBlock();
+      local_input_->Push(shared->Pop());
+      stack_->PushBlock(shared);
+      shared_blocks_++;
+    }
+  }
+
   Block* local_output_;
   Block* local_input_;
   Stack* stack_;
+  intptr_t steal_attempts_ = 0;
+  intptr_t steals_ = 0;
+  intptr_t shared_blocks_ = 0;
 };
 
 static constexpr int kStoreBufferBlockSize = 1024;
@@ -5,12 +5,24 @@
 #include "vm/heap/safepoint.h"
 
 #include "vm/heap/heap.h"
+#include "vm/json_stream.h"
+#include "vm/os.h"
 #include "vm/thread.h"
 #include "vm/thread_registry.h"
 
 namespace dart {
 
 DEFINE_FLAG(bool, trace_safepoint, false, "Trace Safepoint logic.");
+DEFINE_FLAG(int,
+            safepoint_spin_micros,
+            50,
+            "How long a safepoint operation spins waiting for other threads "
+            "to check in before blocking.");
+DEFINE_FLAG(int,
+            slow_safepoint_micros,
+            0,
+            "Report safepoint operations that take longer than this for the "
+            "other threads to check in, naming the last one (0 disables).");
 
 SafepointOperationScope::SafepointOperationScope(Thread* T,
                                                  SafepointLevel level)
@@ -82,6 +94,7 @@ void SafepointHandler::SafepointThreads(Thread* T, SafepointLevel level) {
   ASSERT(T->current_safepoint_level() >= level);
 
   MallocGrowableArray<Dart_Port> oob_isolates;
+  int64_t start;
   {
     MonitorLocker tl(threads_lock());
 
@@ -119,6 +132,7 @@ void SafepointHandler::SafepointThreads(Thread* T, SafepointLevel level) {
     handlers_[level]->SetSafepointInProgress(T);
 
     // Ensure a thread is at a safepoint or notify it to get to one.
+    start = OS::GetCurrentMonotonicMicros();
     handlers_[level]->NotifyThreadsToGetToSafepointLevel(T, &oob_isolates);
   }
 
@@ -129,6 +143,7 @@ void SafepointHandler::SafepointThreads(Thread* T, SafepointLevel level) {
 
   // Now wait for all threads that are not already at a safepoint to check-in.
   handlers_[level]->WaitUntilThreadsReachedSafepointLevel();
+  RecordTimeToSafepoint(level, OS::GetCurrentMonotonicMicros() - start);
 
   // No other mutator is running at this point. We'll set ourselves as owners of
   // all the lower levels as well - since higher levels provide even more
@@ -189,8 +204,7 @@ void SafepointHandler::LevelHandler::NotifyThreadsToGetToSafepointLevel(
             current->ScheduleInterrupts(Thread::kVMInterrupt);
           }
         }
-        MonitorLocker sl(&parked_lock_);
-        num_threads_not_parked_++;
+        num_threads_not_parked_.fetch_add(1);
       }
     }
   }
@@ -220,6 +234,16 @@ void SafepointHandler::ResumeThreads(Thread* T, SafepointLevel level) {
 }
 
 void SafepointHandler::LevelHandler::WaitUntilThreadsReachedSafepointLevel() {
+  // Most threads check in within microseconds, so spin for a while rather
+  // than paying for a monitor wait and wake-up.
+  if ((FLAG_safepoint_spin_micros > 0) && (num_threads_not_parked_ > 0)) {
+    const int64_t deadline =
+        OS::GetCurrentMonotonicMicros() + FLAG_safepoint_spin_micros;
+    while ((num_threads_not_parked_ > 0) &&
+           (OS::GetCurrentMonotonicMicros() < deadline)) {
+    }
+  }
+
   MonitorLocker sl(&parked_lock_);
   intptr_t num_attempts = 0;
   while (num_threads_not_parked_ > 0) {
@@ -348,14 +372,82 @@ void SafepointHandler::EnterSafepointLocked(Thread* T,
 
 void SafepointHandler::LevelHandler::NotifyWeAreParked(Thread* T) {
   ASSERT(owner_ != nullptr);
-  MonitorLocker sl(&parked_lock_);
-  ASSERT(num_threads_not_parked_ > 0);
-  num_threads_not_parked_ -= 1;
-  if (num_threads_not_parked_ == 0) {
+  if (FLAG_slow_safepoint_micros > 0) {
+    MonitorLocker sl(&parked_lock_);
+    ASSERT(num_threads_not_parked_ > 0);
+    Isolate* isolate = T->isolate();
+    const char* thread_name = T->os_thread()->name();
+    Utils::SNPrint(last_parked_, sizeof(last_parked_), "%s (%s)",
+                   isolate != nullptr ? isolate->name() : "no isolate",
+                   thread_name != nullptr ? thread_name : "unnamed");
+    if (num_threads_not_parked_.fetch_sub(1) == 1) {
+      sl.Notify();
+    }
+    return;
+  }
+  const int32_t remaining = num_threads_not_parked_.fetch_sub(1) - 1;
+  ASSERT(remaining >= 0);
+  if (remaining == 0) {
+    // Taking the lock orders this notification after the waiter's check of
+    // the count in WaitUntilThreadsReachedSafepointLevel.
+    MonitorLocker sl(&parked_lock_);
     sl.Notify();
   }
 }
 
+void SafepointHandler::RecordTimeToSafepoint(SafepointLevel level,
+                                             int64_t micros) {
+  LevelHandler* handler = handlers_[level];
+  {
+    MutexLocker ml(&time_to_safepoint_lock_);
+    handler->time_to_safepoint_.Add(micros);
+  }
+  if ((FLAG_slow_safepoint_micros > 0) &&
+      (micros > FLAG_slow_safepoint_micros)) {
+    MonitorLocker sl(&handler->parked_lock_);
+    OS::PrintErr("[ Safepoint ] %s: %" Pd64
+                 " us for threads to check in, last was %s\n",
+                 LevelToString(level), micros, handler->last_parked_);
+  }
+}
+
+int64_t SafepointHandler::TimeToSafepointCount(SafepointLevel level) {
+  MutexLocker ml(&time_to_safepoint_lock_);
+  return handlers_[level]->time_to_safepoint_.Count();
+}
+
+int64_t SafepointHandler::TimeToSafepointPercentile(SafepointLevel level,
+                                                    double percentile) {
+  MutexLocker ml(&time_to_safepoint_lock_);
+  return handlers_[level]->time_to_safepoint_.Percentile(percentile);
+}
+
+#ifndef PRODUCT
+void SafepointHandler::PrintJSON(JSONObject* jsobj) {
+  MutexLocker ml(&time_to_safepoint_lock_);
+  JSONObject levels(jsobj, "timeToSafepoint");
+  for (intptr_t level = 0; level < SafepointLevel::kNumLevels; ++level) {
+    JSONObject histogram(&levels,
+                         LevelToString(static_cast<SafepointLevel>(level)));
+    handlers_[level]->time_to_safepoint_.PrintJSON(&histogram);
+  }
+}
+#endif  // !PRODUCT
+
+const char* SafepointHandler::LevelToString(SafepointLevel level) {
+  switch (level) {
+    case SafepointLevel::kGC:
+      return "GC";
+    case SafepointLevel::kGCAndDeopt:
+      return "GCAndDeopt";
+    case SafepointLevel::kGCAndDeoptAndReload:
+      return "GCAndDeoptAndReload";
+    default:
+      UNREACHABLE();
+      return "";
+  }
+}
+
 void SafepointHandler::ExitSafepointLocked(Thread* T,
                                            MonitorLocker* tl,
                                            SafepointLevel level) {
@@ -6,6 +6,7 @@
 #define RUNTIME_VM_HEAP_SAFEPOINT_H_
 
 #include "vm/globals.h"
+#include "vm/heap/gc_stats.h"
 #include "vm/isolate.h"
 #include "vm/lockers.h"
 #include "vm/thread.h"
@@ -105,6 +106,17 @@ class SafepointHandler {
   SafepointLevel InnermostSafepointOperation(
       const Thread* current_thread) const;
 
+  // The distribution of the time it took for the other threads to check in
+  // for the safepoint operations at 'level', in microseconds.
+  int64_t TimeToSafepointCount(SafepointLevel level);
+  int64_t TimeToSafepointPercentile(SafepointLevel level, double percentile);
+
+#ifndef PRODUCT
+  void PrintJSON(JSONObject* jsobj);
+#endif  // !PRODUCT
+
+  static const char* LevelToString(SafepointLevel level);
+
   bool AnySafepointInProgressLocked() {
     for (intptr_t level = 0; level < SafepointLevel::kNumLevels; ++level) {
       if (handlers_[level]->SafepointInProgress()) {
@@ -175,12 +187,21 @@ class SafepointHandler {
     std::atomic<int32_t> operation_count_ = 0;
 
     // Count the number of threads the currently in-progress safepoint operation
-    // is waiting for to check-in.
-    int32_t num_threads_not_parked_ = 0;
+    // is waiting for to check-in. Threads count down without taking
+    // [parked_lock_], and only the last one to check in notifies the waiter.
+    std::atomic<int32_t> num_threads_not_parked_ = 0;
+
+    // The last thread to check in, recorded when slow rendezvous are
+    // reported. Guarded by [parked_lock_].
+    char last_parked_[64] = {};
+
+    // Guarded by [SafepointHandler::time_to_safepoint_lock_].
+    PauseHistogram time_to_safepoint_;
   };
 
   void SafepointThreads(Thread* T, SafepointLevel level);
   void ResumeThreads(Thread* T, SafepointLevel level);
+  void RecordTimeToSafepoint(SafepointLevel level, int64_t micros);
 
   // Helper methods for [SafepointThreads]
   void AssertWeOwnLowerLevelSafepoints(Thread* T, SafepointLevel level);
@@ -202,6 +223,8 @@ class SafepointHandler {
 
   LevelHandler* handlers_[SafepointLevel::kNumLevels];
 
+  Mutex time_to_safepoint_lock_;
+
   friend class Isolate;
   friend class IsolateGroup;
   friend class SafepointOperationScope;
@@ -632,6 +632,26 @@ ISOLATE_UNIT_TEST_CASE(SafepointOperation_DeoptAndNonDeoptNesting) {
   }
 }
 
+ISOLATE_UNIT_TEST_CASE(SafepointOperation_TimeToSafepoint) {
+  auto safepoint_handler = thread->isolate_group()->safepoint_handler();
+  const int64_t gc_before =
+      safepoint_handler->TimeToSafepointCount(SafepointLevel::kGC);
+  const int64_t deopt_before =
+      safepoint_handler->TimeToSafepointCount(SafepointLevel::kGCAndDeopt);
+  {
+    GcSafepointOperationScope safepoint_scope(thread);
+    // Nested operations don't rendezvous again.
+    GcSafepointOperationScope safepoint_scope2(thread);
+  }
+  { DeoptSafepointOperationScope safepoint_scope(thread); }
+  // Other threads of the group may have run safepoint operations too.
+  EXPECT_LE(gc_before + 1,
+            safepoint_handler->TimeToSafepointCount(SafepointLevel::kGC));
+  EXPECT_LE(
+      deopt_before + 1,
+      safepoint_handler->TimeToSafepointCount(SafepointLevel::kGCAndDeopt));
+}
+
 ISOLATE_UNIT_TEST_CASE_WITH_EXPECTATION(
     SafepointOperation_NonDeoptAndDeoptNesting,
     "Crash") {
@@ -46,6 +46,19 @@ DEFINE_FLAG(int,
             90,
             "Grow new gen when less than this percentage is garbage.");
 DEFINE_FLAG(int, new_gen_growth_factor, 2, "Grow new gen by this factor.");
+DEFINE_FLAG(int,
+            pretenure_threshold,
+            0,
+            "When at least this percentage of a class's promotion candidates "
+            "survive a scavenge, allocate its instances directly in old space. "
+            "0 disables pretenuring.");
+DEFINE_FLAG(int,
+            pretenure_min_kb,
+            256,
+            "Minimum size of a class's promotion candidates before its "
+            "survival rate is considered for pretenuring.");
+DECLARE_FLAG(bool, log_growth);
+DECLARE_FLAG(int, throughput_gc_time_target);
 
 // Scavenger uses the kCardRememberedBit to distinguish forwarded and
 // non-forwarded objects. We must choose a bit that is clear for all new-space
@@ -142,8 +155,23 @@ class ScavengerVisitorBase : public ObjectPointerVisitor {
         freelist_(freelist),
         bytes_promoted_(0),
         visiting_old_object_(nullptr),
-        promoted_list_(promotion_stack) {}
-  ~ScavengerVisitorBase() {}
+        promoted_list_(promotion_stack) {
+#if !defined(PRODUCT)
+    if (scavenger->survival_num_cids_ > 0) {
+      survival_num_cids_ = scavenger->survival_num_cids_;
+      copied_words_by_cid_ = reinterpret_cast<intptr_t*>(
+          calloc(survival_num_cids_, sizeof(intptr_t)));
+      promoted_words_by_cid_ = reinterpret_cast<intptr_t*>(
+          calloc(survival_num_cids_, sizeof(intptr_t)));
+    }
+#endif  // !defined(PRODUCT)
+  }
+  ~ScavengerVisitorBase() {
+#if !defined(PRODUCT)
+    free(copied_words_by_cid_);
+    free(promoted_words_by_cid_);
+#endif  // !defined(PRODUCT)
+  }
 
 #ifdef DEBUG
   constexpr static const char* const kName = "Scavenger";
@@ -250,6 +278,17 @@ class ScavengerVisitorBase : public ObjectPointerVisitor {
 
   intptr_t bytes_promoted() const { return bytes_promoted_; }
 
+#if !defined(PRODUCT)
+  // Adds this worker's per-class survival counts to the scavenger's totals.
+  void MergeSurvivalFeedback(intptr_t* copied_words_by_cid,
+                             intptr_t* promoted_words_by_cid) const {
+    for (intptr_t cid = 0; cid < survival_num_cids_; cid++) {
+      copied_words_by_cid[cid] += copied_words_by_cid_[cid];
+      promoted_words_by_cid[cid] += promoted_words_by_cid_[cid];
+    }
+  }
+#endif  // !defined(PRODUCT)
+
   void ProcessRoots() {
     thread_ = Thread::Current();
     page_space_->AcquireLock(freelist_);
@@ -310,6 +349,10 @@ class ScavengerVisitorBase : public ObjectPointerVisitor {
     return promoted_list_.WaitForWork(num_busy, scavenger_->abort_);
   }
 
+  intptr_t steal_attempts() const { return promoted_list_.steal_attempts(); }
+  intptr_t steals() const { return promoted_list_.steals(); }
+  intptr_t shared_blocks() const { return promoted_list_.shared_blocks(); }
+
   void ProcessWeak() {
     if (!scavenger_->abort_) {
       ASSERT(!HasWork());
@@ -472,6 +515,11 @@ class ScavengerVisitorBase : public ObjectPointerVisitor {
           promoted_list_.Push(new_obj);
           bytes_promoted_ += size;
         }
+#if !defined(PRODUCT)
+        if (UNLIKELY(cid < survival_num_cids_)) {
+          RecordSurvivor(cid, size, new_obj->IsOldObject());
+        }
+#endif  // !defined(PRODUCT)
       } else {
         ASSERT(IsForwarding(header));
         if (new_obj->IsOldObject()) {
@@ -490,6 +538,16 @@ class ScavengerVisitorBase : public ObjectPointerVisitor {
     return new_obj;
   }
 
+#if !defined(PRODUCT)
+  void RecordSurvivor(intptr_t cid, intptr_t size, bool promoted) {
+    if (promoted) {
+      promoted_words_by_cid_[cid] += size >> kWordSizeLog2;
+    } else {
+      copied_words_by_cid_[cid] += size >> kWordSizeLog2;
+    }
+  }
+#endif  // !defined(PRODUCT)
+
   DART_FORCE_INLINE
   bool InstallForwardingPointer(uword addr,
                                 uword* old_header,
@@ -583,6 +641,13 @@ class ScavengerVisitorBase : public ObjectPointerVisitor {
   Page* tail_ = nullptr;  // Allocating from here.
   Page* scan_ = nullptr;  // Resolving from here.
 
+#if !defined(PRODUCT)
+  // Zero unless pretenuring feedback is being collected.
+  intptr_t survival_num_cids_ = 0;
+  intptr_t* copied_words_by_cid_ = nullptr;
+  intptr_t* promoted_words_by_cid_ = nullptr;
+#endif  // !defined(PRODUCT)
+
   DISALLOW_COPY_AND_ASSIGN(ScavengerVisitorBase);
 };
 
@@ -699,6 +764,15 @@ class ParallelScavengerTask : public ThreadPool::Task {
 
     // Phase 2: Weak processing, statistics.
     visitor_->ProcessWeak();
+
+#if defined(SUPPORT_TIMELINE)
+    tbes.SetNumArguments(3);
+    tbes.FormatArgument(0, "Steal attempts", "%" Pd "",
+                        visitor_->steal_attempts());
+    tbes.FormatArgument(1, "Steals", "%" Pd "", visitor_->steals());
+    tbes.FormatArgument(2, "Shared blocks", "%" Pd "",
+                        visitor_->shared_blocks());
+#endif
   }
 
  private:
@@ -799,6 +873,9 @@ Scavenger::~Scavenger() {
   ASSERT(!scavenging_);
   delete to_;
   ASSERT(blocks_ == nullptr);
+#if !defined(PRODUCT)
+  free(pretenure_candidate_words_);
+#endif  // !defined(PRODUCT)
 }
 
 intptr_t Scavenger::NewSizeInWords(intptr_t old_size_in_words,
@@ -826,6 +903,23 @@ intptr_t Scavenger::NewSizeInWords(intptr_t old_size_in_words,
     }
   }
 
+  if (!grow && (heap_->mode() == Dart_PerformanceMode_Throughput) &&
+      (FLAG_throughput_gc_time_target > 0)) {
+    // Each scavenge has a fixed cost for visiting the roots and the remembered
+    // set, so fewer scavenges of a larger new-space spend less time in GC.
+    const intptr_t gc_time_fraction = GCTimeFraction();
+    if (gc_time_fraction > FLAG_throughput_gc_time_target) {
+      grow = true;
+      if (FLAG_log_growth &&
+          (old_size_in_words < max_semi_capacity_in_words_)) {
+        THR_Print("%s: growing new-space, gc_time=%" Pd
+                  "%%, gc_time_target=%d%%\n",
+                  heap_->isolate_group()->source()->name, gc_time_fraction,
+                  FLAG_throughput_gc_time_target);
+      }
+    }
+  }
+
   if (grow) {
     return Utils::Minimum(max_semi_capacity_in_words_,
                           old_size_in_words * FLAG_new_gen_growth_factor);
@@ -833,6 +927,53 @@ intptr_t Scavenger::NewSizeInWords(intptr_t old_size_in_words,
   return old_size_in_words;
 }
 
+intptr_t Scavenger::GCTimeFraction() const {
+  int64_t gc_time = 0;
+  int64_t total_time = 0;
+  for (intptr_t i = 0; i < stats_history_.Size() - 1; i++) {
+    const ScavengeStats& current = stats_history_.Get(i);
+    const ScavengeStats& previous = stats_history_.Get(i + 1);
+    gc_time += current.DurationMicros();
+    total_time += current.EndMicros() - previous.EndMicros();
+  }
+  if (total_time <= 0) {
+    return 0;
+  }
+  return static_cast<intptr_t>(
+      (static_cast<double>(gc_time) / static_cast<double>(total_time)) * 100);
+}
+
+double Scavenger::AllocationWordsPerMicro() const {
+  intptr_t allocated_in_words = 0;
+  int64_t mutator_micros = 0;
+  for (intptr_t i = 0; i < stats_history_.Size() - 1; i++) {
+    const ScavengeStats& current = stats_history_.Get(i);
+    const ScavengeStats& previous = stats_history_.Get(i + 1);
+    allocated_in_words +=
+        current.UsedBeforeInWords() - previous.UsedAfterInWords();
+    mutator_micros += current.StartMicros() - previous.EndMicros();
+  }
+  if (mutator_micros <= 0) {
+    return 0.0;
+  }
+  return static_cast<double>(allocated_in_words) / mutator_micros;
+}
+
+double Scavenger::PromotionWordsPerMicro() const {
+  intptr_t promoted_in_words = 0;
+  int64_t total_micros = 0;
+  for (intptr_t i = 0; i < stats_history_.Size() - 1; i++) {
+    const ScavengeStats& current = stats_history_.Get(i);
+    const ScavengeStats& previous = stats_history_.Get(i + 1);
+    promoted_in_words += current.PromotedInWords();
+    total_micros += current.EndMicros() - previous.EndMicros();
+  }
+  if (total_micros <= 0) {
+    return 0.0;
+  }
+  return static_cast<double>(promoted_in_words) / total_micros;
+}
+
 class CollectStoreBufferVisitor : public ObjectPointerVisitor {
  public:
   CollectStoreBufferVisitor(ObjectSet* in_store_buffer, const char* msg)
@@ -1112,17 +1253,24 @@ void Scavenger::Epilogue(SemiSpace* from) {
   }
 }
 
-bool Scavenger::ShouldPerformIdleScavenge(int64_t deadline) {
+bool Scavenger::ShouldPerformIdleScavenge(int64_t deadline,
+                                          int64_t idle_interval_micros) {
   // To make a consistent decision, we should not yield for a safepoint in the
   // middle of deciding whether to perform an idle GC.
   NoSafepointScope no_safepoint;
 
-  // TODO(rmacnak): Investigate collecting a history of idle period durations.
   intptr_t used_in_words = UsedInWords() + freed_in_words_;
   intptr_t external_in_words = ExternalInWords();
   // Normal reason: new space is getting full.
   bool for_new_space = (used_in_words >= idle_scavenge_threshold_in_words_) ||
                        (external_in_words >= idle_scavenge_threshold_in_words_);
+  if (!for_new_space && (idle_interval_micros > 0)) {
+    // Predicted reason: at the recent allocation rate, new space would fill up
+    // before the next idle period, making the scavenge happen during work.
+    const double predicted_in_words =
+        used_in_words + AllocationWordsPerMicro() * idle_interval_micros;
+    for_new_space = predicted_in_words >= ThresholdInWords();
+  }
   if (!for_new_space) {
     return false;
   }
@@ -1135,6 +1283,7 @@ bool Scavenger::ShouldPerformIdleScavenge(int64_t deadline) {
 
 void Scavenger::IterateIsolateRoots(ObjectPointerVisitor* visitor) {
   TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "IterateIsolateRoots");
+  GCPhaseScope phase(heap_->pause_stats(), GCPhase::kScavengeRoots);
   heap_->isolate_group()->VisitObjectPointers(
       visitor, ValidationPolicy::kDontValidateFrames);
 }
@@ -1142,6 +1291,7 @@ void Scavenger::IterateIsolateRoots(ObjectPointerVisitor* visitor) {
 template <bool parallel>
 void Scavenger::IterateStoreBuffers(ScavengerVisitorBase<parallel>* visitor) {
   TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "IterateStoreBuffers");
+  GCPhaseScope phase(heap_->pause_stats(), GCPhase::kScavengeStoreBuffer);
 
   // Iterating through the store buffers.
   // Grab the deduplication sets out of the isolate's consolidated store buffer.
@@ -1171,12 +1321,22 @@ template <bool parallel>
 void Scavenger::IterateRememberedCards(
     ScavengerVisitorBase<parallel>* visitor) {
   TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "IterateRememberedCards");
-  heap_->old_space()->VisitRememberedCards(visitor);
+  GCPhaseScope phase(heap_->pause_stats(), GCPhase::kScavengeStoreBuffer);
+  const int64_t start = OS::GetCurrentMonotonicMicros();
+  const intptr_t cards = heap_->old_space()->VisitRememberedCards(visitor);
+  const int64_t end = OS::GetCurrentMonotonicMicros();
+  cards_scanned_.fetch_add(cards);
+  card_scan_micros_.fetch_add(end - start);
+#if defined(SUPPORT_TIMELINE)
+  tbes.SetNumArguments(1);
+  tbes.FormatArgument(0, "Cards", "%" Pd "", cards);
+#endif
 }
 
 void Scavenger::IterateObjectIdTable(ObjectPointerVisitor* visitor) {
 #ifndef PRODUCT
   TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "IterateObjectIdTable");
+  GCPhaseScope phase(heap_->pause_stats(), GCPhase::kScavengeRoots);
   heap_->isolate_group()->VisitObjectIdRingPointers(visitor);
 #endif  // !PRODUCT
 }
@@ -1216,14 +1376,17 @@ void Scavenger::IterateRoots(ScavengerVisitorBase<parallel>* visitor) {
 
 enum WeakSlices {
   kWeakHandles = 0,
-  kWeakTables,
+  kForwardTables,
   kProgressBars,
   kRememberLiveTemporaries,
   kPruneWeak,
-  kNumWeakSlices,
+  // One slice per weak selector, so the tables are rehashed in parallel.
+  kWeakTables,
+  kNumWeakSlices = kWeakTables + Heap::kNumWeakSelectors,
 };
 
 void Scavenger::IterateWeak() {
+  GCPhaseScope phase(heap_->pause_stats(), GCPhase::kScavengeWeak);
   for (;;) {
     intptr_t slice = weak_slices_started_.fetch_add(1);
     if (slice >= kNumWeakSlices) {
@@ -1234,8 +1397,8 @@ void Scavenger::IterateWeak() {
       case kWeakHandles:
         MournWeakHandles();
         break;
-      case kWeakTables:
-        MournWeakTables();
+      case kForwardTables:
+        MournForwardTables();
         break;
       case kProgressBars:
         heap_->old_space()->ResetProgressBars();
@@ -1251,7 +1414,9 @@ void Scavenger::IterateWeak() {
         }
       } break;
       default:
-        UNREACHABLE();
+        ASSERT(slice >= kWeakTables);
+        MournWeakTable(slice - kWeakTables);
+        break;
     }
   }
 
@@ -1399,57 +1564,72 @@ intptr_t ScavengerVisitorBase<parallel>::ProcessObject(ObjectPtr obj) {
   return obj->untag()->VisitPointersNonvirtual(this);
 }
 
-void Scavenger::MournWeakTables() {
-  TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "MournWeakTables");
-
-  auto rehash_weak_table = [](WeakTable* table, WeakTable* replacement_new,
-                              WeakTable* replacement_old,
-                              Dart_HeapSamplingDeleteCallback cleanup) {
-    intptr_t size = table->size();
-    for (intptr_t i = 0; i < size; i++) {
-      if (table->IsValidEntryAtExclusive(i)) {
-        ObjectPtr obj = table->ObjectAtExclusive(i);
-        ASSERT(obj->IsHeapObject());
-        uword raw_addr = UntaggedObject::ToAddr(obj);
-        uword header = *reinterpret_cast<uword*>(raw_addr);
-        if (IsForwarding(header)) {
-          // The object has survived.  Preserve its record.
-          obj = ForwardedObj(header);
-          auto replacement =
-              obj->IsNewObject() ? replacement_new : replacement_old;
-          replacement->SetValueExclusive(obj, table->ValueAtExclusive(i));
-        } else {
-          // The object has been collected.
-          if (cleanup != nullptr) {
-            cleanup(reinterpret_cast<void*>(table->ValueAtExclusive(i)));
-          }
+// Moves the entries of surviving objects from a new-space weak table to their
+// new location's table, and drops the entries of collected objects.
+static void RehashWeakTable(WeakTable* table,
+                            WeakTable* replacement_new,
+                            WeakTable* replacement_old,
+                            Dart_HeapSamplingDeleteCallback cleanup) {
+  intptr_t size = table->size();
+  for (intptr_t i = 0; i < size; i++) {
+    if (table->IsValidEntryAtExclusive(i)) {
+      ObjectPtr obj = table->ObjectAtExclusive(i);
+      ASSERT(obj->IsHeapObject());
+      uword raw_addr = UntaggedObject::ToAddr(obj);
+      uword header = *reinterpret_cast<uword*>(raw_addr);
+      if (IsForwarding(header)) {
+        // The object has survived.  Preserve its record.
+        obj = ForwardedObj(header);
+        auto replacement =
+            obj->IsNewObject() ? replacement_new : replacement_old;
+        replacement->SetValueExclusive(obj, table->ValueAtExclusive(i));
+      } else {
+        // The object has been collected.
+        if (cleanup != nullptr) {
+          cleanup(reinterpret_cast<void*>(table->ValueAtExclusive(i)));
         }
       }
     }
-  };
+  }
+}
+
+void Scavenger::MournWeakTable(intptr_t sel) {
+  TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "MournWeakTable");
+  const int64_t start = OS::GetCurrentMonotonicMicros();
+  const auto selector = static_cast<Heap::WeakSelector>(sel);
 
-  // Rehash the weak tables now that we know which objects survive this cycle.
-  for (int sel = 0; sel < Heap::kNumWeakSelectors; sel++) {
-    const auto selector = static_cast<Heap::WeakSelector>(sel);
-    auto table = heap_->GetWeakTable(Heap::kNew, selector);
-    auto table_old = heap_->GetWeakTable(Heap::kOld, selector);
+  // Rehash the weak table now that we know which objects survive this cycle.
+  auto table = heap_->GetWeakTable(Heap::kNew, selector);
+  auto table_old = heap_->GetWeakTable(Heap::kOld, selector);
+  const intptr_t entries = table->count();
 
-    // Create a new weak table for the new-space.
-    auto table_new = WeakTable::NewFrom(table);
+  // Create a new weak table for the new-space.
+  auto table_new = WeakTable::NewFrom(table);
 
-    Dart_HeapSamplingDeleteCallback cleanup = nullptr;
+  Dart_HeapSamplingDeleteCallback cleanup = nullptr;
 #if !defined(PRODUCT) || defined(FORCE_INCLUDE_SAMPLING_HEAP_PROFILER)
-    if (sel == Heap::kHeapSamplingData) {
-      cleanup = HeapProfileSampler::delete_callback();
-    }
+  if (selector == Heap::kHeapSamplingData) {
+    cleanup = HeapProfileSampler::delete_callback();
+  }
+#endif
+  RehashWeakTable(table, table_new, table_old, cleanup);
+  heap_->SetWeakTable(Heap::kNew, selector, table_new);
+
+  // Remove the old table as it has been replaced with the newly allocated
+  // table above.
+  delete table;
+
+  heap_->AddWeakTableMicros(selector,
+                            OS::GetCurrentMonotonicMicros() - start);
+#if defined(SUPPORT_TIMELINE)
+  tbes.SetNumArguments(2);
+  tbes.CopyArgument(0, "Table", Heap::WeakSelectorToString(selector));
+  tbes.FormatArgument(1, "Entries", "%" Pd "", entries);
 #endif
-    rehash_weak_table(table, table_new, table_old, cleanup);
-    heap_->SetWeakTable(Heap::kNew, selector, table_new);
+}
 
-    // Remove the old table as it has been replaced with the newly allocated
-    // table above.
-    delete table;
-  }
+void Scavenger::MournForwardTables() {
+  TIMELINE_FUNCTION_GC_DURATION(Thread::Current(), "MournForwardTables");
 
   // Each isolate might have a weak table used for fast snapshot writing (i.e.
   // isolate communication). Rehash those tables if need be.
@@ -1458,8 +1638,8 @@ void Scavenger::MournWeakTables() {
         auto table = isolate->forward_table_new();
         if (table != nullptr) {
           auto replacement = WeakTable::NewFrom(table);
-          rehash_weak_table(table, replacement, isolate->forward_table_old(),
-                            nullptr);
+          RehashWeakTable(table, replacement, isolate->forward_table_old(),
+                          nullptr);
           isolate->set_forward_table_new(replacement);
         }
       },
@@ -1621,6 +1801,13 @@ void Scavenger::VisitObjects(ObjectVisitor* visitor) const {
   }
 }
 
+void Scavenger::AddPagesTo(MallocGrowableArray<Page*>* pages) const {
+  ASSERT(Thread::Current()->OwnsGCSafepoint());
+  for (Page* page = to_->head(); page != nullptr; page = page->next()) {
+    pages->Add(page);
+  }
+}
+
 void Scavenger::AddRegionsToObjectSet(ObjectSet* set) const {
   for (Page* page = to_->head(); page != nullptr; page = page->next()) {
     set->AddRegion(page->start(), page->end());
@@ -1754,6 +1941,8 @@ void Scavenger::Scavenge(Thread* thread, GCType type, GCReason reason) {
   abort_ = false;
   root_slices_started_ = 0;
   weak_slices_started_ = 0;
+  cards_scanned_ = 0;
+  card_scan_micros_ = 0;
   freed_in_words_ = 0;
   intptr_t abandoned_bytes = 0;  // TODO(rmacnak): Count fragmentation?
   SpaceUsage usage_before = GetCurrentUsage();
@@ -1768,6 +1957,17 @@ void Scavenger::Scavenge(Thread* thread, GCType type, GCReason reason) {
   heap_->old_space()->PauseConcurrentMarking();
   SemiSpace* from = Prologue(reason);
 
+#if !defined(PRODUCT)
+  // Early tenuring promotes objects that were not promotion candidates, which
+  // would distort the per-class survival rates.
+  const bool collect_survival_feedback =
+      (FLAG_pretenure_threshold > 0) && !early_tenure_;
+  survival_num_cids_ =
+      collect_survival_feedback
+          ? heap_->isolate_group()->class_table()->NumCids()
+          : 0;
+#endif  // !defined(PRODUCT)
+
   intptr_t bytes_promoted;
   if (FLAG_scavenger_tasks == 0) {
     bytes_promoted = SerialScavenge(from);
@@ -1777,7 +1977,13 @@ void Scavenger::Scavenge(Thread* thread, GCType type, GCReason reason) {
   if (abort_) {
     ReverseScavenge(&from);
     bytes_promoted = 0;
+#if !defined(PRODUCT)
+    DiscardSurvivalFeedback();
+#endif  // !defined(PRODUCT)
   } else {
+#if !defined(PRODUCT)
+    UpdatePretenuring();
+#endif  // !defined(PRODUCT)
     if ((ThresholdInWords() - UsedInWords()) < KBInWords) {
       // Don't scavenge again until the next old-space GC has occurred. Prevents
       // performing one scavenge per allocation as the heap limit is approached.
@@ -1791,7 +1997,15 @@ void Scavenger::Scavenge(Thread* thread, GCType type, GCReason reason) {
   int64_t end = OS::GetCurrentMonotonicMicros();
   stats_history_.Add(ScavengeStats(
       start, end, usage_before, GetCurrentUsage(), promo_candidate_words,
-      bytes_promoted >> kWordSizeLog2, abandoned_bytes >> kWordSizeLog2));
+      bytes_promoted >> kWordSizeLog2, abandoned_bytes >> kWordSizeLog2,
+      cards_scanned_, card_scan_micros_));
+  if (FLAG_verbose_gc && (cards_scanned_ > 0)) {
+    // Summed over the workers, so this may exceed the scavenge's duration.
+    OS::PrintErr("[ Card scan ] %" Pd " cards, %.3f ms of %.3f ms\n",
+                 static_cast<intptr_t>(cards_scanned_),
+                 MicrosecondsToMilliseconds(card_scan_micros_),
+                 MicrosecondsToMilliseconds(end - start));
+  }
   Epilogue(from);
 
   if (FLAG_verify_after_gc) {
@@ -1819,6 +2033,9 @@ intptr_t Scavenger::SerialScavenge(SemiSpace* from) {
   visitor.ProcessWeak();
   visitor.Finalize();
   to_->AddList(visitor.head(), visitor.tail());
+#if !defined(PRODUCT)
+  MergeSurvivalFeedback(&visitor);
+#endif  // !defined(PRODUCT)
   return visitor.bytes_promoted();
 }
 
@@ -1856,6 +2073,9 @@ intptr_t Scavenger::ParallelScavenge(SemiSpace* from) {
     visitor->Finalize();
     to_->AddList(visitor->head(), visitor->tail());
     bytes_promoted += visitor->bytes_promoted();
+#if !defined(PRODUCT)
+    MergeSurvivalFeedback(visitor);
+#endif  // !defined(PRODUCT)
     delete visitor;
   }
 
@@ -1863,6 +2083,88 @@ intptr_t Scavenger::ParallelScavenge(SemiSpace* from) {
   return bytes_promoted;
 }
 
+#if !defined(PRODUCT)
+template <bool parallel>
+void Scavenger::MergeSurvivalFeedback(
+    ScavengerVisitorBase<parallel>* visitor) {
+  if (survival_num_cids_ == 0) {
+    return;
+  }
+  if (copied_words_by_cid_ == nullptr) {
+    copied_words_by_cid_ = reinterpret_cast<intptr_t*>(
+        calloc(survival_num_cids_, sizeof(intptr_t)));
+    promoted_words_by_cid_ = reinterpret_cast<intptr_t*>(
+        calloc(survival_num_cids_, sizeof(intptr_t)));
+  }
+  visitor->MergeSurvivalFeedback(copied_words_by_cid_, promoted_words_by_cid_);
+}
+
+void Scavenger::DiscardSurvivalFeedback() {
+  free(copied_words_by_cid_);
+  copied_words_by_cid_ = nullptr;
+  free(promoted_words_by_cid_);
+  promoted_words_by_cid_ = nullptr;
+  // The candidates recorded by the previous scavenge have been moved back to
+  // the from-space of the next attempt, so they remain valid.
+  survival_num_cids_ = 0;
+}
+
+void Scavenger::UpdatePretenuring() {
+  if (survival_num_cids_ == 0 || copied_words_by_cid_ == nullptr) {
+    // Feedback was not collected for this scavenge. Candidates from an older
+    // scavenge don't correspond to this scavenge's survivors.
+    free(pretenure_candidate_words_);
+    pretenure_candidate_words_ = nullptr;
+    pretenure_num_cids_ = 0;
+    DiscardSurvivalFeedback();
+    return;
+  }
+
+  // Objects copied within new space by the previous scavenge were this
+  // scavenge's promotion candidates. Compare with what was promoted, which is
+  // the per-class analog of ScavengeStats::PromoCandidatesSuccessFraction.
+  ClassTable* class_table = heap_->isolate_group()->class_table();
+  const intptr_t min_candidate_words = FLAG_pretenure_min_kb * KBInWords;
+  const intptr_t num_cids =
+      Utils::Minimum(pretenure_num_cids_, survival_num_cids_);
+  for (intptr_t cid = 1; cid < num_cids; cid++) {
+    const intptr_t candidates = pretenure_candidate_words_[cid];
+    if (candidates < min_candidate_words) continue;
+    const intptr_t promoted = promoted_words_by_cid_[cid];
+    if ((promoted * 100) < (candidates * FLAG_pretenure_threshold)) continue;
+    if (class_table->ShouldPretenureAllocationFor(cid)) continue;
+    class_table->SetPretenureAllocationFor(cid, true);
+    if (FLAG_verbose_gc) {
+      const char* name = class_table->UserVisibleNameFor(cid);
+      OS::PrintErr("[ Pretenuring ] cid %" Pd " (%s): %" Pd "%% of %" Pd
+                   "kB promoted\n",
+                   cid, name == nullptr ? "?" : name,
+                   (promoted * 100) / candidates,
+                   RoundWordsToKB(candidates));
+    }
+  }
+
+  free(pretenure_candidate_words_);
+  pretenure_candidate_words_ = copied_words_by_cid_;
+  pretenure_num_cids_ = survival_num_cids_;
+  copied_words_by_cid_ = nullptr;
+  free(promoted_words_by_cid_);
+  promoted_words_by_cid_ = nullptr;
+  survival_num_cids_ = 0;
+}
+
+void Scavenger::ResetPretenuring() {
+  if (FLAG_pretenure_threshold == 0) {
+    return;
+  }
+  ClassTable* class_table = heap_->isolate_group()->class_table();
+  const intptr_t num_cids = class_table->NumCids();
+  for (intptr_t cid = 1; cid < num_cids; cid++) {
+    class_table->SetPretenureAllocationFor(cid, false);
+  }
+}
+#endif  // !defined(PRODUCT)
+
 void Scavenger::ReverseScavenge(SemiSpace** from) {
   Thread* thread = Thread::Current();
   TIMELINE_FUNCTION_GC_DURATION(thread, "ReverseScavenge");
@@ -1979,6 +2281,7 @@ void Scavenger::PrintToJSONObject(JSONObject* object) const {
   space.AddProperty64("capacity", CapacityInWords() * kWordSize);
   space.AddProperty64("external", ExternalInWords() * kWordSize);
   space.AddProperty("time", MicrosecondsToSeconds(gc_time_micros()));
+  space.AddProperty("gcTimeFraction", GCTimeFraction());
 }
 #endif  // !PRODUCT
 
@@ -80,14 +80,18 @@ class ScavengeStats {
                 SpaceUsage after,
                 intptr_t promo_candidates_in_words,
                 intptr_t promoted_in_words,
-                intptr_t abandoned_in_words)
+                intptr_t abandoned_in_words,
+                intptr_t cards_scanned,
+                int64_t card_scan_micros)
       : start_micros_(start_micros),
         end_micros_(end_micros),
         before_(before),
         after_(after),
         promo_candidates_in_words_(promo_candidates_in_words),
         promoted_in_words_(promoted_in_words),
-        abandoned_in_words_(abandoned_in_words) {}
+        abandoned_in_words_(abandoned_in_words),
+        cards_scanned_(cards_scanned),
+        card_scan_micros_(card_scan_micros) {}
 
   // Of all data before scavenge, what fraction was found to be garbage?
   // If this scavenge included growth, assume the extra capacity would become
@@ -108,8 +112,17 @@ class ScavengeStats {
   }
 
   intptr_t UsedBeforeInWords() const { return before_.used_in_words; }
+  intptr_t UsedAfterInWords() const { return after_.used_in_words; }
+  intptr_t PromotedInWords() const { return promoted_in_words_; }
 
   int64_t DurationMicros() const { return end_micros_ - start_micros_; }
+  int64_t StartMicros() const { return start_micros_; }
+  int64_t EndMicros() const { return end_micros_; }
+
+  // Remembered cards visited and the time spent visiting them, summed over
+  // all scavenger workers.
+  intptr_t CardsScanned() const { return cards_scanned_; }
+  int64_t CardScanMicros() const { return card_scan_micros_; }
 
  private:
   int64_t start_micros_;
@@ -119,6 +132,8 @@ class ScavengeStats {
   intptr_t promo_candidates_in_words_;
   intptr_t promoted_in_words_;
   intptr_t abandoned_in_words_;
+  intptr_t cards_scanned_;
+  int64_t card_scan_micros_;
 };
 
 class Scavenger {
@@ -179,10 +194,20 @@ class Scavenger {
   void VisitObjectPointers(ObjectPointerVisitor* visitor) const;
 
   void AddRegionsToObjectSet(ObjectSet* set) const;
+  // Adds the pages visited by VisitObjects, in the same order.
+  void AddPagesTo(MallocGrowableArray<Page*>* pages) const;
 
   void WriteProtect(bool read_only);
 
-  bool ShouldPerformIdleScavenge(int64_t deadline);
+  // 'idle_interval_micros' is the expected time until the next idle
+  // notification, or 0 if unknown.
+  bool ShouldPerformIdleScavenge(int64_t deadline,
+                                 int64_t idle_interval_micros);
+
+  // Rates measured over the recent scavenges, per microsecond between
+  // scavenges.
+  double AllocationWordsPerMicro() const;
+  double PromotionWordsPerMicro() const;
 
   void AddGCTime(int64_t micros) { gc_time_micros_ += micros; }
 
@@ -194,6 +219,11 @@ class Scavenger {
 
 #ifndef PRODUCT
   void PrintToJSONObject(JSONObject* object) const;
+
+  // Forgets all pretenuring decisions so they are re-learned from scavenges.
+  // Called after old-space collections, since a pretenured class produces no
+  // further survival feedback.
+  void ResetPretenuring();
 #endif  // !PRODUCT
 
   // Tracks an external allocation by incrementing the new space's total
@@ -287,15 +317,25 @@ class Scavenger {
   void IterateRoots(ScavengerVisitorBase<parallel>* visitor);
   void IterateWeak();
   void MournWeakHandles();
-  void MournWeakTables();
+  void MournWeakTable(intptr_t sel);
+  void MournForwardTables();
   void Epilogue(SemiSpace* from);
 
+#if !defined(PRODUCT)
+  template <bool parallel>
+  void MergeSurvivalFeedback(ScavengerVisitorBase<parallel>* visitor);
+  void DiscardSurvivalFeedback();
+  void UpdatePretenuring();
+#endif  // !defined(PRODUCT)
+
   void VerifyStoreBuffers(const char* msg);
 
   void UpdateMaxHeapCapacity();
   void UpdateMaxHeapUsage();
 
   intptr_t NewSizeInWords(intptr_t old_size_in_words, GCReason reason) const;
+  // Percentage of time spent scavenging over the recent history.
+  intptr_t GCTimeFraction() const;
 
   Heap* heap_;
 
@@ -310,6 +350,8 @@ class Scavenger {
   bool early_tenure_ = false;
   RelaxedAtomic<intptr_t> root_slices_started_ = {0};
   RelaxedAtomic<intptr_t> weak_slices_started_ = {0};
+  RelaxedAtomic<intptr_t> cards_scanned_ = {0};
+  RelaxedAtomic<int64_t> card_scan_micros_ = {0};
   StoreBufferBlock* blocks_ = nullptr;
   MarkingStackBlock* mark_blocks_ = nullptr;
   MarkingStackBlock* new_blocks_ = nullptr;
@@ -327,6 +369,17 @@ class Scavenger {
   RelaxedAtomic<intptr_t> external_size_ = {0};
   intptr_t freed_in_words_ = 0;
 
+#if !defined(PRODUCT)
+  // Per-class survival feedback for --pretenure_threshold, indexed by cid.
+  // The words copied within new space by the last scavenge are the promotion
+  // candidates of the next one.
+  intptr_t survival_num_cids_ = 0;
+  intptr_t* copied_words_by_cid_ = nullptr;
+  intptr_t* promoted_words_by_cid_ = nullptr;
+  intptr_t pretenure_num_cids_ = 0;
+  intptr_t* pretenure_candidate_words_ = nullptr;
+#endif  // !defined(PRODUCT)
+
   RelaxedAtomic<bool> failed_to_promote_ = {false};
   RelaxedAtomic<bool> abort_ = {false};
 
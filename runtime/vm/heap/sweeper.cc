@@ -84,7 +84,10 @@ bool GCSweeper::SweepPage(Page* page, FreeList* freelist) {
     intptr_t obj_size = raw_obj->untag()->HeapSize(tags);
     if (UntaggedObject::IsMarked(tags)) {
       // Found marked object. Clear the mark bit and update swept bytes.
-      raw_obj->untag()->ClearMarkBit();
+      // Permanent objects stay marked so that the marker skips them.
+      if (!UntaggedObject::IsPermanent(tags)) {
+        raw_obj->untag()->ClearMarkBit();
+      }
       used_in_bytes += obj_size;
       // Large objects should never appear on regular pages.
       ASSERT(IsAllocatableViaFreeLists(obj_size) || page->is_large());
@@ -142,7 +145,9 @@ intptr_t GCSweeper::SweepLargePage(Page* page) {
   ObjectPtr raw_obj = UntaggedObject::FromAddr(page->object_start());
   ASSERT(Page::Of(raw_obj) == page);
   if (raw_obj->untag()->IsMarked()) {
-    raw_obj->untag()->ClearMarkBit();
+    if (!raw_obj->untag()->IsPermanent()) {
+      raw_obj->untag()->ClearMarkBit();
+    }
     words_to_end = (raw_obj->untag()->HeapSize() >> kWordSizeLog2);
   }
 #ifdef DEBUG
@@ -167,10 +172,6 @@ class ConcurrentSweeperTask : public ThreadPool::Task {
   explicit ConcurrentSweeperTask(IsolateGroup* isolate_group)
       : isolate_group_(isolate_group) {
     ASSERT(isolate_group != nullptr);
-    PageSpace* old_space = isolate_group->heap()->old_space();
-    MonitorLocker ml(old_space->tasks_lock());
-    old_space->set_tasks(old_space->tasks() + 1);
-    old_space->set_phase(PageSpace::kSweepingLarge);
   }
 
   virtual void Run() {
@@ -186,10 +187,15 @@ class ConcurrentSweeperTask : public ThreadPool::Task {
       old_space->SweepLarge();
 
       {
+        // The large page list is stable once every task has finished with it.
         MonitorLocker ml(old_space->tasks_lock());
         ASSERT(old_space->phase() == PageSpace::kSweepingLarge);
-        old_space->set_phase(PageSpace::kSweepingRegular);
-        ml.NotifyAll();
+        intptr_t remaining = old_space->concurrent_sweeper_tasks_large() - 1;
+        old_space->set_concurrent_sweeper_tasks_large(remaining);
+        if (remaining == 0) {
+          old_space->set_phase(PageSpace::kSweepingRegular);
+          ml.NotifyAll();
+        }
       }
 
       old_space->Sweep(/*exclusive*/ false);
@@ -200,8 +206,12 @@ class ConcurrentSweeperTask : public ThreadPool::Task {
     {
       MonitorLocker ml(old_space->tasks_lock());
       old_space->set_tasks(old_space->tasks() - 1);
-      ASSERT(old_space->phase() == PageSpace::kSweepingRegular);
-      old_space->set_phase(PageSpace::kDone);
+      intptr_t remaining = old_space->concurrent_sweeper_tasks() - 1;
+      old_space->set_concurrent_sweeper_tasks(remaining);
+      if (remaining == 0) {
+        ASSERT(old_space->phase() == PageSpace::kSweepingRegular);
+        old_space->set_phase(PageSpace::kDone);
+      }
       ml.NotifyAll();
     }
   }
@@ -211,8 +221,23 @@ class ConcurrentSweeperTask : public ThreadPool::Task {
 };
 
 void GCSweeper::SweepConcurrent(IsolateGroup* isolate_group) {
-  bool result = Dart::thread_pool()->Run<ConcurrentSweeperTask>(isolate_group);
-  ASSERT(result);
+  PageSpace* old_space = isolate_group->heap()->old_space();
+  const intptr_t num_tasks = Utils::Maximum(FLAG_sweeper_tasks, 1);
+  {
+    MonitorLocker ml(old_space->tasks_lock());
+    ASSERT(old_space->concurrent_sweeper_tasks() == 0);
+    old_space->set_tasks(old_space->tasks() + num_tasks);
+    old_space->set_concurrent_sweeper_tasks(num_tasks);
+    old_space->set_concurrent_sweeper_tasks_large(num_tasks);
+    old_space->set_phase(PageSpace::kSweepingLarge);
+  }
+  // The tasks share the page lists, taking one page at a time, so they
+  // naturally balance pages of differing cost.
+  for (intptr_t i = 0; i < num_tasks; i++) {
+    bool result =
+        Dart::thread_pool()->Run<ConcurrentSweeperTask>(isolate_group);
+    ASSERT(result);
+  }
 }
 
 }  // namespace dart
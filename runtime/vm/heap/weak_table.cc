@@ -30,22 +30,43 @@ intptr_t WeakTable::SizeFor(intptr_t count, intptr_t size) {
   return result;
 }
 
-void WeakTable::SetValueExclusive(ObjectPtr key, intptr_t val) {
-  const intptr_t mask = size() - 1;
-  intptr_t idx = Hash(key) & mask;
-  intptr_t empty_idx = -1;
-  ObjectPtr obj = ObjectAtExclusive(idx);
-
-  while (obj != static_cast<ObjectPtr>(kNoEntry)) {
-    if (obj == key) {
-      SetValueAt(idx, val);
-      return;
-    } else if ((empty_idx < 0) &&
-               (static_cast<intptr_t>(obj) == kDeletedEntry)) {
-      empty_idx = idx;  // Insert at this location if not found.
+void WeakTable::Allocate(intptr_t size) {
+  ASSERT(Utils::IsPowerOfTwo(size));
+  ASSERT(size >= kMinSize);
+  size_ = size;
+  uint8_t* memory = reinterpret_cast<uint8_t*>(malloc(size * kSlotBytes));
+  keys_ = reinterpret_cast<ObjectPtr*>(memory);
+  values_ = reinterpret_cast<intptr_t*>(memory + size * kWordSize);
+  tags_ = memory + 2 * size * kWordSize;
+  for (intptr_t i = 0; i < size; i++) {
+    values_[i] = kNoValue;
+  }
+  memset(tags_, kEmptyTag, size);
+}
+
+bool WeakTable::InsertNewExclusive(ObjectPtr key, intptr_t val) {
+  ASSERT(val != 0);
+  const uword hash = Hash(key);
+  const intptr_t mask = group_mask();
+  for (intptr_t g = FirstGroupFor(hash);; g = (g + 1) & mask) {
+    const Group group = LoadGroup(g);
+    const Group free = MatchNotFull(group);
+    if (free != 0) {
+      const intptr_t idx = SlotFor(g, free);
+      const bool was_empty = tags_[idx] == kEmptyTag;
+      tags_[idx] = TagFor(hash);
+      keys_[idx] = key;
+      values_[idx] = val;
+      return was_empty;
     }
-    idx = (idx + 1) & mask;
-    obj = ObjectAtExclusive(idx);
+  }
+}
+
+void WeakTable::SetValueExclusive(ObjectPtr key, intptr_t val) {
+  const intptr_t idx = FindExclusive(key);
+  if (idx >= 0) {
+    SetValueAt(idx, val);
+    return;
   }
 
   if (val == 0) {
@@ -55,18 +76,11 @@ void WeakTable::SetValueExclusive(ObjectPtr key, intptr_t val) {
     return;
   }
 
-  if (empty_idx >= 0) {
-    // We will be reusing a slot below.
-    set_used(used() - 1);
-    idx = empty_idx;
+  // Set the key and value, reusing a deleted slot if there is one on the
+  // probe sequence, and update the counts.
+  if (InsertNewExclusive(key, val)) {
+    set_used(used() + 1);
   }
-
-  ASSERT(!IsValidEntryAtExclusive(idx));
-  // Set the key and value.
-  SetObjectAt(idx, key);
-  SetValueAt(idx, val);
-  // Update the counts.
-  set_used(used() + 1);
   set_count(count() + 1);
 
   // Rehash if needed to ensure that there are empty slots available.
@@ -76,36 +90,14 @@ void WeakTable::SetValueExclusive(ObjectPtr key, intptr_t val) {
 }
 
 bool WeakTable::MarkValueExclusive(ObjectPtr key, intptr_t val) {
-  const intptr_t mask = size() - 1;
-  intptr_t idx = Hash(key) & mask;
-  intptr_t empty_idx = -1;
-  ObjectPtr obj = ObjectAtExclusive(idx);
-
-  while (obj != static_cast<ObjectPtr>(kNoEntry)) {
-    if (obj == key) {
-      return false;
-    } else if ((empty_idx < 0) &&
-               (static_cast<intptr_t>(obj) == kDeletedEntry)) {
-      empty_idx = idx;  // Insert at this location if not found.
-    }
-    idx = (idx + 1) & mask;
-    obj = ObjectAtExclusive(idx);
+  if (FindExclusive(key) >= 0) {
+    return false;
   }
 
   ASSERT(val != 0);
-
-  if (empty_idx >= 0) {
-    // We will be reusing a slot below.
-    set_used(used() - 1);
-    idx = empty_idx;
+  if (InsertNewExclusive(key, val)) {
+    set_used(used() + 1);
   }
-
-  ASSERT(!IsValidEntryAtExclusive(idx));
-  // Set the key and value.
-  SetObjectAt(idx, key);
-  SetValueAt(idx, val);
-  // Update the counts.
-  set_used(used() + 1);
   set_count(count() + 1);
 
   // Rehash if needed to ensure that there are empty slots available.
@@ -116,16 +108,10 @@ bool WeakTable::MarkValueExclusive(ObjectPtr key, intptr_t val) {
 }
 
 void WeakTable::Reset() {
-  intptr_t* old_data = data_;
+  free(keys_);
   used_ = 0;
   count_ = 0;
-  size_ = kMinSize;
-  free(old_data);
-  data_ = reinterpret_cast<intptr_t*>(malloc(size_ * kEntrySize * kWordSize));
-  for (intptr_t i = 0; i < size_; i++) {
-    data_[ObjectIndex(i)] = kNoEntry;
-    data_[ValueIndex(i)] = kNoValue;
-  }
+  Allocate(kMinSize);
 }
 
 void WeakTable::Forward(ObjectPointerVisitor* visitor) {
@@ -147,7 +133,7 @@ void WeakTable::ReportSurvivingAllocations(
   MutexLocker ml(&mutex_);
   for (intptr_t i = 0; i < size_; i++) {
     if (IsValidEntryAtExclusive(i)) {
-      void* data = reinterpret_cast<void*>(data_[ValueIndex(i)]);
+      void* data = reinterpret_cast<void*>(values_[i]);
       callback(context, data);
     }
   }
@@ -156,51 +142,33 @@ void WeakTable::ReportSurvivingAllocations(
 void WeakTable::CleanupValues(Dart_HeapSamplingDeleteCallback cleanup) {
   for (intptr_t i = 0; i < size_; i++) {
     if (IsValidEntryAtExclusive(i)) {
-      cleanup(reinterpret_cast<void*>(data_[ValueIndex(i)]));
+      cleanup(reinterpret_cast<void*>(values_[i]));
     }
   }
 }
 #endif
 
 void WeakTable::Rehash() {
-  intptr_t old_size = size();
-  intptr_t* old_data = data_;
-
-  intptr_t new_size = SizeFor(count(), size());
-  ASSERT(Utils::IsPowerOfTwo(new_size));
-  intptr_t* new_data =
-      reinterpret_cast<intptr_t*>(malloc(new_size * kEntrySize * kWordSize));
-  for (intptr_t i = 0; i < new_size; i++) {
-    new_data[ObjectIndex(i)] = kNoEntry;
-    new_data[ValueIndex(i)] = kNoValue;
-  }
+  const intptr_t old_size = size();
+  ObjectPtr* old_keys = keys_;
+  intptr_t* old_values = values_;
 
-  intptr_t mask = new_size - 1;
+  Allocate(SizeFor(count(), old_size));
   set_used(0);
   for (intptr_t i = 0; i < old_size; i++) {
-    if (IsValidEntryAtExclusive(i)) {
-      // Find the new hash location for this entry.
-      ObjectPtr key = ObjectAtExclusive(i);
-      intptr_t idx = Hash(key) & mask;
-      ObjectPtr obj = static_cast<ObjectPtr>(new_data[ObjectIndex(idx)]);
-      while (obj != static_cast<ObjectPtr>(kNoEntry)) {
-        ASSERT(obj != key);  // Duplicate entry is not expected.
-        idx = (idx + 1) & mask;
-        obj = static_cast<ObjectPtr>(new_data[ObjectIndex(idx)]);
-      }
-
-      new_data[ObjectIndex(idx)] = static_cast<intptr_t>(key);
-      new_data[ValueIndex(idx)] = ValueAtExclusive(i);
+    if (old_values[i] != kNoValue) {
+      ASSERT(FindExclusive(old_keys[i]) < 0);  // No duplicate entries.
+      const bool was_empty = InsertNewExclusive(old_keys[i], old_values[i]);
+      ASSERT(was_empty);
+      USE(was_empty);
       set_used(used() + 1);
     }
   }
   // We should only have used valid entries.
   ASSERT(used() == count());
 
-  // Switch to using the newly allocated backing store.
-  size_ = new_size;
-  data_ = new_data;
-  free(old_data);
+  // The old key array starts the old backing store.
+  free(old_keys);
 }
 
 }  // namespace dart
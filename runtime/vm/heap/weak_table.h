@@ -13,6 +13,12 @@
 
 namespace dart {
 
+// An open-addressed hash table from objects to non-zero values.
+//
+// Keys, values and one tag byte per slot are kept in separate arrays. The tag
+// of a full slot holds seven bits of its key's hash, so a probe compares the
+// tags of a whole group of kGroupSize slots with a few word operations and
+// only loads the keys whose tag matches (the "Swiss table" scheme).
 class WeakTable {
  public:
   static constexpr intptr_t kNoValue = 0;
@@ -24,23 +30,18 @@ class WeakTable {
     if (size < kMinSize) {
       size = kMinSize;
     }
-    // Get a max size that avoids overflows.
+    // Get a max size that avoids overflows (a slot takes less than four
+    // words).
     const intptr_t kMaxSize =
-        (kIntptrOne << (kBitsPerWord - 2)) / (kEntrySize * kWordSize);
+        (kIntptrOne << (kBitsPerWord - 2)) / (4 * kWordSize);
     ASSERT(Utils::IsPowerOfTwo(kMaxSize));
     if (size > kMaxSize) {
       size = kMaxSize;
     }
-    size_ = size;
-    ASSERT(Utils::IsPowerOfTwo(size_));
-    data_ = reinterpret_cast<intptr_t*>(malloc(size_ * kEntrySize * kWordSize));
-    for (intptr_t i = 0; i < size_; i++) {
-      data_[ObjectIndex(i)] = kNoEntry;
-      data_[ValueIndex(i)] = kNoValue;
-    }
+    Allocate(size);
   }
 
-  ~WeakTable() { free(data_); }
+  ~WeakTable() { free(keys_); }
 
   static WeakTable* NewFrom(WeakTable* original) {
     return new WeakTable(SizeFor(original->count(), original->size()));
@@ -78,12 +79,10 @@ class WeakTable {
   // This is mostly limited to GC related code (e.g. scavenger, marker, ...)
 
   bool IsValidEntryAtExclusive(intptr_t i) const {
-    ASSERT((ValueAtExclusive(i) == 0 &&
-            (data_[ObjectIndex(i)] == kNoEntry ||
-             data_[ObjectIndex(i)] == kDeletedEntry)) ||
-           (ValueAtExclusive(i) != 0 && data_[ObjectIndex(i)] != kNoEntry &&
-            data_[ObjectIndex(i)] != kDeletedEntry));
-    return (data_[ValueIndex(i)] != 0);
+    ASSERT(i >= 0);
+    ASSERT(i < size());
+    ASSERT((values_[i] == 0) == ((tags_[i] & kNotFullBit) != 0));
+    return (values_[i] != 0);
   }
 
   void InvalidateAtExclusive(intptr_t i) {
@@ -94,50 +93,33 @@ class WeakTable {
   ObjectPtr ObjectAtExclusive(intptr_t i) const {
     ASSERT(i >= 0);
     ASSERT(i < size());
-    return static_cast<ObjectPtr>(data_[ObjectIndex(i)]);
+    return keys_[i];
   }
 
   intptr_t ValueAtExclusive(intptr_t i) const {
     ASSERT(i >= 0);
     ASSERT(i < size());
-    return data_[ValueIndex(i)];
+    return values_[i];
   }
 
   void SetValueExclusive(ObjectPtr key, intptr_t val);
   bool MarkValueExclusive(ObjectPtr key, intptr_t val);
 
   intptr_t GetValueExclusive(ObjectPtr key) const {
-    intptr_t mask = size() - 1;
-    intptr_t idx = Hash(key) & mask;
-    ObjectPtr obj = ObjectAtExclusive(idx);
-    while (obj != static_cast<ObjectPtr>(kNoEntry)) {
-      if (obj == key) {
-        return ValueAtExclusive(idx);
-      }
-      idx = (idx + 1) & mask;
-      obj = ObjectAtExclusive(idx);
-    }
-    ASSERT(ValueAtExclusive(idx) == 0);
-    return kNoValue;
+    const intptr_t idx = FindExclusive(key);
+    return idx < 0 ? kNoValue : ValueAtExclusive(idx);
   }
 
   // Removes and returns the value associated with |key|. Returns 0 if there is
   // no value associated with |key|.
   intptr_t RemoveValueExclusive(ObjectPtr key) {
-    intptr_t mask = size() - 1;
-    intptr_t idx = Hash(key) & mask;
-    ObjectPtr obj = ObjectAtExclusive(idx);
-    while (obj != static_cast<ObjectPtr>(kNoEntry)) {
-      if (obj == key) {
-        intptr_t result = ValueAtExclusive(idx);
-        InvalidateAtExclusive(idx);
-        return result;
-      }
-      idx = (idx + 1) & mask;
-      obj = ObjectAtExclusive(idx);
+    const intptr_t idx = FindExclusive(key);
+    if (idx < 0) {
+      return kNoValue;
     }
-    ASSERT(ValueAtExclusive(idx) == 0);
-    return kNoValue;
+    intptr_t result = ValueAtExclusive(idx);
+    InvalidateAtExclusive(idx);
+    return result;
   }
 
   void Forward(ObjectPointerVisitor* visitor);
@@ -148,16 +130,24 @@ class WeakTable {
   void Reset();
 
  private:
-  enum {
-    kObjectOffset = 0,
-    kValueOffset,
-    kEntrySize,
-  };
-
-  static constexpr intptr_t kNoEntry = 1;       // Not a valid OOP.
-  static constexpr intptr_t kDeletedEntry = 3;  // Not a valid OOP.
+  // A key, a value and a tag.
+  static constexpr intptr_t kSlotBytes = 2 * kWordSize + 1;
   static constexpr intptr_t kMinSize = 8;
 
+  // Tags of free slots have the high bit set; full slots hold seven bits of
+  // their key's hash.
+  static constexpr uint8_t kNotFullBit = 0x80;
+  static constexpr uint8_t kEmptyTag = 0x80;
+  static constexpr uint8_t kDeletedTag = 0xfe;
+  static constexpr intptr_t kHashTagBits = 7;
+
+  // Tags are loaded and compared a group at a time.
+  typedef uint64_t Group;
+  static constexpr intptr_t kGroupSize = sizeof(Group);
+  static constexpr Group kLowBits = 0x0101010101010101ULL;
+  static constexpr Group kHighBits = 0x8080808080808080ULL;
+  COMPILE_ASSERT(kMinSize % kGroupSize == 0);
+
   static intptr_t SizeFor(intptr_t count, intptr_t size);
   static intptr_t LimitFor(intptr_t size) {
     // Maintain a maximum of 75% fill rate.
@@ -165,8 +155,6 @@ class WeakTable {
   }
   intptr_t limit() const { return LimitFor(size()); }
 
-  intptr_t index(intptr_t i) const { return i * kEntrySize; }
-
   void set_used(intptr_t val) {
     ASSERT(val <= limit());
     used_ = val;
@@ -178,20 +166,10 @@ class WeakTable {
     count_ = val;
   }
 
-  intptr_t ObjectIndex(intptr_t i) const { return index(i) + kObjectOffset; }
-
-  intptr_t ValueIndex(intptr_t i) const { return index(i) + kValueOffset; }
-
   ObjectPtr* ObjectPointerAt(intptr_t i) const {
     ASSERT(i >= 0);
     ASSERT(i < size());
-    return reinterpret_cast<ObjectPtr*>(&data_[ObjectIndex(i)]);
-  }
-
-  void SetObjectAt(intptr_t i, ObjectPtr key) {
-    ASSERT(i >= 0);
-    ASSERT(i < size());
-    data_[ObjectIndex(i)] = static_cast<intptr_t>(key);
+    return &keys_[i];
   }
 
   void SetValueAt(intptr_t i, intptr_t val) {
@@ -199,24 +177,89 @@ class WeakTable {
     ASSERT(i < size());
     // Setting a value of 0 is equivalent to invalidating the entry.
     if (val == 0) {
-      data_[ObjectIndex(i)] = kDeletedEntry;
+      tags_[i] = kDeletedTag;
       set_count(count() - 1);
     }
-    data_[ValueIndex(i)] = val;
+    values_[i] = val;
   }
 
+  // Allocates empty backing stores for 'size' slots.
+  void Allocate(intptr_t size);
   void Rehash();
 
+  // Stores a key that is known to be absent into the first free slot of its
+  // probe sequence and returns whether that slot was empty, rather than
+  // deleted.
+  bool InsertNewExclusive(ObjectPtr key, intptr_t val);
+
   static uword Hash(ObjectPtr key) {
-    return (static_cast<uword>(key) * 92821) ^ (static_cast<uword>(key) >> 8);
+    const uword hash = static_cast<uword>(key) * kHashMultiplier;
+    return hash ^ (hash >> (kBitsPerWord / 2));
+  }
+  static uint8_t TagFor(uword hash) {
+    return hash & ((1 << kHashTagBits) - 1);
+  }
+  intptr_t FirstGroupFor(uword hash) const {
+    return (hash >> kHashTagBits) & group_mask();
+  }
+  intptr_t group_mask() const { return (size() / kGroupSize) - 1; }
+
+  Group LoadGroup(intptr_t group) const {
+    Group result;
+    memcpy(&result, &tags_[group * kGroupSize], sizeof(result));
+    return result;
+  }
+  // The masks below have the high bit set in the bytes of the selected slots.
+  // The tag match may report a false positive next to a true match, so its
+  // results need the keys checked, but the other two masks are exact.
+  static Group MatchTag(Group group, uint8_t tag) {
+    const Group x = group ^ (kLowBits * tag);
+    return (x - kLowBits) & ~x & kHighBits;
+  }
+  static Group MatchEmpty(Group group) {
+    return group & ~(group << 6) & kHighBits;
   }
+  static Group MatchNotFull(Group group) { return group & kHighBits; }
+  static intptr_t SlotFor(intptr_t group, Group mask) {
+    // Tags are in memory order, so on a little-endian host the lowest set bit
+    // is the lowest slot.
+    return group * kGroupSize + (Utils::CountTrailingZeros64(mask) >> 3);
+  }
+
+  // Returns the slot of 'key', or -1 if it is absent.
+  intptr_t FindExclusive(ObjectPtr key) const {
+    const uword hash = Hash(key);
+    const uint8_t tag = TagFor(hash);
+    const intptr_t mask = group_mask();
+    for (intptr_t g = FirstGroupFor(hash);; g = (g + 1) & mask) {
+      const Group group = LoadGroup(g);
+      for (Group m = MatchTag(group, tag); m != 0; m &= m - 1) {
+        const intptr_t idx = SlotFor(g, m);
+        if (keys_[idx] == key) {
+          return idx;
+        }
+      }
+      if (MatchEmpty(group) != 0) {
+        return -1;
+      }
+    }
+  }
+
+#if defined(ARCH_IS_64_BIT)
+  static constexpr uword kHashMultiplier = 0x9e3779b97f4a7c15ULL;
+#else
+  static constexpr uword kHashMultiplier = 0x9e3779b9U;
+#endif
 
   Mutex mutex_;
 
-  // data_ contains size_ tuples of key/value.
-  intptr_t* data_;
-  // size_ keeps the number of entries in data_. used_ maintains the number of
-  // non-NULL entries and will trigger rehashing if needed. count_ stores the
+  // The key array starts the backing store, followed by the value and tag
+  // arrays, each of size_ entries.
+  ObjectPtr* keys_;
+  intptr_t* values_;
+  uint8_t* tags_;
+  // size_ keeps the number of slots. used_ maintains the number of full or
+  // deleted slots and will trigger rehashing if needed. count_ stores the
   // number valid entries, and will determine the size_ after rehashing.
   intptr_t size_;
   intptr_t used_;
@@ -59,4 +59,42 @@ ISOLATE_UNIT_TEST_CASE(WeakTables) {
   EXPECT_EQ(kNoValue, heap->GetObjectId(imm_obj.ptr()));
 }
 
+TEST_CASE(WeakTable_ProbeAndRehash) {
+  WeakTable table;
+  const intptr_t kNumKeys = 10000;
+  for (intptr_t i = 0; i < kNumKeys; i++) {
+    table.SetValueExclusive(Smi::New(i), i + 1);
+  }
+  EXPECT_EQ(kNumKeys, table.count());
+  EXPECT(table.used() <= 3 * (table.size() / 4));
+  for (intptr_t i = 0; i < kNumKeys; i++) {
+    EXPECT_EQ(i + 1, table.GetValueExclusive(Smi::New(i)));
+  }
+  EXPECT_EQ(WeakTable::kNoValue, table.GetValueExclusive(Smi::New(kNumKeys)));
+
+  // Deleted slots are skipped by lookups and reused by insertions.
+  for (intptr_t i = 0; i < kNumKeys; i += 2) {
+    EXPECT_EQ(i + 1, table.RemoveValueExclusive(Smi::New(i)));
+  }
+  EXPECT_EQ(kNumKeys / 2, table.count());
+  for (intptr_t i = 0; i < kNumKeys; i++) {
+    const intptr_t expected = (i % 2) == 0 ? WeakTable::kNoValue : i + 1;
+    EXPECT_EQ(expected, table.GetValueExclusive(Smi::New(i)));
+  }
+  const intptr_t used = table.used();
+  for (intptr_t i = 0; i < kNumKeys; i += 2) {
+    EXPECT(table.MarkValueExclusive(Smi::New(i), i + 2));
+    EXPECT(!table.MarkValueExclusive(Smi::New(i), i + 3));
+  }
+  EXPECT(table.used() <= used);
+  for (intptr_t i = 0; i < kNumKeys; i++) {
+    const intptr_t expected = (i % 2) == 0 ? i + 2 : i + 1;
+    EXPECT_EQ(expected, table.GetValueExclusive(Smi::New(i)));
+  }
+
+  table.Reset();
+  EXPECT_EQ(0, table.count());
+  EXPECT_EQ(WeakTable::kNoValue, table.GetValueExclusive(Smi::New(1)));
+}
+
 }  // namespace dart
@@ -57,6 +57,7 @@
 #include "vm/visitor.h"
 
 #if !defined(DART_PRECOMPILED_RUNTIME)
+#include "vm/compiler/aot/aot_profile.h"
 #include "vm/compiler/assembler/assembler.h"
 #include "vm/compiler/stub_code_compiler.h"
 #endif
@@ -2589,6 +2590,12 @@ void Isolate::LowLevelCleanup(Isolate* isolate) {
                                         /*bypass_safepoint=*/false);
 #if !defined(DART_PRECOMPILED_RUNTIME)
       BackgroundCompiler::Stop(isolate_group);
+      if (!IsolateGroup::IsSystemIsolateGroup(isolate_group)) {
+        Thread* thread = Thread::Current();
+        StackZone zone(thread);
+        HandleScope handle_scope(thread);
+        AotProfile::CollectIfRequested(thread);
+      }
 #endif  // !defined(DART_PRECOMPILED_RUNTIME)
 
       // Finalize any weak persistent handles with a non-null referent with
@@ -3056,6 +3063,10 @@ void Isolate::PrintJSON(JSONStream* stream, bool ref) {
   jsobj.AddProperty("runnable", is_runnable());
   jsobj.AddProperty("livePorts", open_ports_keepalive_);
   jsobj.AddProperty("pauseOnExit", message_handler()->should_pause_on_exit());
+  {
+    JSONObject jsqueue(&jsobj, "_messageQueue");
+    message_handler()->PrintQueueStatsJSON(&jsqueue);
+  }
 #if !defined(DART_PRECOMPILED_RUNTIME)
   jsobj.AddProperty("_isReloading", group()->IsReloading());
 #endif  // !defined(DART_PRECOMPILED_RUNTIME)
@@ -149,7 +149,7 @@ typedef FixedCache<intptr_t, CatchEntryMovesRefPtr, 16> CatchEntryMovesCache;
   V(PRODUCT, should_load_vmservice_library, ShouldLoadVmService,               \
     load_vmservice_library, false)                                             \
   V(NONPRODUCT, use_osr, UseOsr, use_osr, FLAG_use_osr)                        \
-  V(NONPRODUCT, snapshot_is_dontneed_safe, SnapshotIsDontNeedSafe,             \
+  V(PRODUCT, snapshot_is_dontneed_safe, SnapshotIsDontNeedSafe,                \
     snapshot_is_dontneed_safe, false)                                          \
   V(NONPRODUCT, branch_coverage, BranchCoverage, branch_coverage,              \
     FLAG_branch_coverage)
@@ -189,10 +189,12 @@ class IsolateGroupSource {
         script_kernel_buffer(nullptr),
         script_kernel_size(-1),
         loaded_blobs_(nullptr),
-        num_blob_loads_(0) {}
+        num_blob_loads_(0),
+        native_assets_script_uri(nullptr) {}
   ~IsolateGroupSource() {
     free(script_uri);
     free(name);
+    free(native_assets_script_uri.load());
   }
 
   void add_loaded_blob(Zone* zone_,
@@ -215,6 +217,10 @@ class IsolateGroupSource {
   // List of weak pointers to external typed data for loaded blobs.
   ArrayPtr loaded_blobs_;
   intptr_t num_blob_loads_;
+
+  // The file URI relative native assets are resolved against, created on
+  // first use.
+  AcqRelAtomic<char*> native_assets_script_uri;
 };
 
 // Tracks idle time and notifies heap when idle time expired.
@@ -1242,6 +1248,23 @@ class Isolate : public BaseIsolate, public IntrusiveDListEntry<Isolate> {
   ObjectIdRing* EnsureObjectIdRing();
 #endif  // !defined(PRODUCT)
 
+#if defined(SUPPORT_TIMELINE)
+  // Nesting depth of the synchronous timeline spans started by Dart code in
+  // this isolate, and a bit for each of the innermost 64 levels telling
+  // whether its begin event was dropped. See
+  // DartTimelineEventHelpers::ShouldReport.
+  intptr_t timeline_sync_depth() const { return timeline_sync_depth_; }
+  void set_timeline_sync_depth(intptr_t value) {
+    timeline_sync_depth_ = value;
+  }
+  uint64_t timeline_dropped_sync_levels() const {
+    return timeline_dropped_sync_levels_;
+  }
+  void set_timeline_dropped_sync_levels(uint64_t value) {
+    timeline_dropped_sync_levels_ = value;
+  }
+#endif  // defined(SUPPORT_TIMELINE)
+
   bool IsDeoptimizing() const { return deopt_context_ != nullptr; }
   DeoptContext* deopt_context() const { return deopt_context_; }
   void set_deopt_context(DeoptContext* value) {
@@ -1594,6 +1617,11 @@ class Isolate : public BaseIsolate, public IntrusiveDListEntry<Isolate> {
   }
   std::atomic<uint32_t> isolate_flags_;
 
+#if defined(SUPPORT_TIMELINE)
+  intptr_t timeline_sync_depth_ = 0;
+  uint64_t timeline_dropped_sync_levels_ = 0;
+#endif  // defined(SUPPORT_TIMELINE)
+
 // Fields that aren't needed in a product build go here with boolean flags at
 // the top.
 #if !defined(PRODUCT)
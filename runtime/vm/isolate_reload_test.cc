@@ -7,6 +7,7 @@
 #include "include/dart_api.h"
 #include "include/dart_tools_api.h"
 #include "platform/assert.h"
+#include "vm/compiler/jit/compiler.h"
 #include "vm/debugger_api_impl_test.h"
 #include "vm/globals.h"
 #include "vm/isolate.h"
@@ -6560,6 +6561,82 @@ TEST_CASE(IsolateReload_KeepPragma3) {
                               Symbols::vm_never_inline()));
 }
 
+static void OptimizeSideEffectSummaryTestFunctions(Thread* thread,
+                                                   Dart_Handle lib) {
+  TransitionNativeToVM transition(thread);
+  const auto& lib_handle =
+      Library::Handle(Library::RawCast(Api::UnwrapHandle(lib)));
+  const auto& helper = Function::Handle(lib_handle.LookupFunctionAllowPrivate(
+      String::Handle(String::New("helper"))));
+  const auto& foo = Function::Handle(lib_handle.LookupFunctionAllowPrivate(
+      String::Handle(String::New("foo"))));
+  EXPECT(!helper.IsNull());
+  EXPECT(!foo.IsNull());
+  EXPECT(Compiler::CompileOptimizedFunction(thread, helper) != Object::null());
+  EXPECT(Compiler::CompileOptimizedFunction(thread, foo) != Object::null());
+  // In JIT mode the summary would go stale when [helper] is reloaded.
+  EXPECT(!helper.has_no_side_effects());
+  EXPECT(!helper.is_pure());
+}
+
+TEST_CASE(IsolateReload_SideEffectSummary) {
+  const char* kScript = R"(
+class A {
+  int x;
+  A(this.x);
+}
+int counter = 0;
+@pragma('vm:never-inline')
+int helper(int v) => v * 3;
+int foo(A a) {
+  final r1 = a.x + helper(7);
+  final r2 = a.x + helper(7);
+  return r1 + r2;
+}
+main() {
+  counter = 0;
+  final result = foo(A(1));
+  return result + counter;
+}
+)";
+
+  Dart_Handle lib = TestCase::LoadTestScript(kScript, nullptr);
+  EXPECT_VALID(lib);
+  EXPECT_EQ(44, SimpleInvoke(lib, "main"));
+  OptimizeSideEffectSummaryTestFunctions(thread, lib);
+  EXPECT_EQ(44, SimpleInvoke(lib, "main"));
+
+  // [helper] now has side effects, so neither call may be removed.
+  const char* kReloadScript = R"(
+class A {
+  int x;
+  A(this.x);
+}
+int counter = 0;
+@pragma('vm:never-inline')
+int helper(int v) {
+  counter++;
+  return v * 3;
+}
+int foo(A a) {
+  final r1 = a.x + helper(7);
+  final r2 = a.x + helper(7);
+  return r1 + r2;
+}
+main() {
+  counter = 0;
+  final result = foo(A(1));
+  return result + counter;
+}
+)";
+
+  lib = TestCase::ReloadTestScript(kReloadScript);
+  EXPECT_VALID(lib);
+  EXPECT_EQ(46, SimpleInvoke(lib, "main"));
+  OptimizeSideEffectSummaryTestFunctions(thread, lib);
+  EXPECT_EQ(46, SimpleInvoke(lib, "main"));
+}
+
 #endif  // !defined(PRODUCT) && !defined(DART_PRECOMPILED_RUNTIME)
 
 }  // namespace dart
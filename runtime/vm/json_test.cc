@@ -55,6 +55,18 @@ TEST_CASE(JSON_JSONStream_Primitives) {
     }
     EXPECT_STREQ("[4]", js.ToCString());
   }
+  {
+    JSONStream js;
+    {
+      JSONArray jsarr(&js);
+      jsarr.AddValue(static_cast<intptr_t>(0));
+      jsarr.AddValue(static_cast<intptr_t>(-1234567));
+      jsarr.AddValue64(9007199254740991LL);
+      jsarr.AddValue64(-9007199254740991LL);
+    }
+    EXPECT_STREQ("[0,-1234567,9007199254740991,-9007199254740991]",
+                 js.ToCString());
+  }
   {
     JSONStream js;
     {
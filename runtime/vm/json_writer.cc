@@ -126,24 +126,24 @@ void JSONWriter::CloseArray() {
 
 void JSONWriter::PrintValueNull() {
   PrintCommaIfNeeded();
-  buffer_.Printf("null");
+  buffer_.AddString("null");
 }
 
 void JSONWriter::PrintValueBool(bool b) {
   PrintCommaIfNeeded();
-  buffer_.Printf("%s", b ? "true" : "false");
+  buffer_.AddString(b ? "true" : "false");
 }
 
 void JSONWriter::PrintValue(intptr_t i) {
   EnsureIntegerIsRepresentableInJavaScript(static_cast<int64_t>(i));
   PrintCommaIfNeeded();
-  buffer_.Printf("%" Pd "", i);
+  AddInteger(i);
 }
 
 void JSONWriter::PrintValue64(int64_t i) {
   EnsureIntegerIsRepresentableInJavaScript(i);
   PrintCommaIfNeeded();
-  buffer_.Printf("%" Pd64 "", i);
+  AddInteger(i);
 }
 
 void JSONWriter::PrintValue(double d) {
@@ -345,6 +345,23 @@ void JSONWriter::EnsureIntegerIsRepresentableInJavaScript(int64_t i) {
 #endif
 }
 
+void JSONWriter::AddInteger(int64_t i) {
+  // Enough for the 20 characters of INT64_MIN.
+  char digits[20];
+  intptr_t pos = sizeof(digits);
+  uint64_t magnitude =
+      i < 0 ? -static_cast<uint64_t>(i) : static_cast<uint64_t>(i);
+  do {
+    digits[--pos] = '0' + (magnitude % 10);
+    magnitude /= 10;
+  } while (magnitude != 0);
+  if (i < 0) {
+    digits[--pos] = '-';
+  }
+  buffer_.AddRaw(reinterpret_cast<const uint8_t*>(&digits[pos]),
+                 sizeof(digits) - pos);
+}
+
 void JSONWriter::AddEscapedUTF8String(const char* s) {
   if (s == nullptr) {
     return;
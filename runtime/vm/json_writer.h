@@ -92,6 +92,10 @@ class JSONWriter : ValueObject {
   bool NeedComma();
   bool AddDartString(const String& s, intptr_t offset, intptr_t count);
 
+  // Appends the decimal representation of [i] without going through printf,
+  // which dominates the cost of large responses such as CPU samples.
+  void AddInteger(int64_t i);
+
   // Debug only fatal assertion.
   static void EnsureIntegerIsRepresentableInJavaScript(int64_t i);
 
@@ -68,17 +68,23 @@ void MegamorphicCacheTable::PrintSizes(Thread* thread) {
   OS::PrintErr("%" Pd " megamorphic caches using %" Pd "KB.\n", table.Length(),
                size / 1024);
 
+  // Number of entries found after a given number of probes, and number of
+  // caches whose longest lookup takes a given number of probes.
   intptr_t* probe_counts = new intptr_t[max_size];
+  intptr_t* longest_probe_counts = new intptr_t[max_size];
   intptr_t entry_count = 0;
+  intptr_t total_probe_count = 0;
   intptr_t max_probe_count = 0;
   for (intptr_t i = 0; i < max_size; i++) {
     probe_counts[i] = 0;
+    longest_probe_counts[i] = 0;
   }
   for (intptr_t i = 0; i < table.Length(); i++) {
     cache ^= table.At(i);
     buckets = cache.buckets();
     intptr_t mask = cache.mask();
     intptr_t capacity = mask + 1;
+    intptr_t longest_probe_count = 0;
     for (intptr_t j = 0; j < capacity; j++) {
       intptr_t class_id =
           Smi::Value(Smi::RawCast(cache.GetClassId(buckets, j)));
@@ -97,12 +103,17 @@ void MegamorphicCacheTable::PrintSizes(Thread* thread) {
           probe_index = (probe_index + 1) & mask;
         }
         probe_counts[probe_count]++;
-        if (probe_count > max_probe_count) {
-          max_probe_count = probe_count;
+        total_probe_count += probe_count;
+        if (probe_count > longest_probe_count) {
+          longest_probe_count = probe_count;
         }
         entry_count++;
       }
     }
+    longest_probe_counts[longest_probe_count]++;
+    if (longest_probe_count > max_probe_count) {
+      max_probe_count = longest_probe_count;
+    }
   }
   intptr_t cumulative_entries = 0;
   for (intptr_t i = 0; i <= max_probe_count; i++) {
@@ -112,6 +123,14 @@ void MegamorphicCacheTable::PrintSizes(Thread* thread) {
                  static_cast<double>(cumulative_entries) /
                      static_cast<double>(entry_count));
   }
+  OS::PrintErr("Megamorphic average probe: %lf\n",
+               static_cast<double>(total_probe_count) /
+                   static_cast<double>(entry_count));
+  for (intptr_t i = 0; i <= max_probe_count; i++) {
+    OS::PrintErr("Megamorphic caches with longest probe %" Pd ": %" Pd "\n",
+                 i, longest_probe_counts[i]);
+  }
+  delete[] longest_probe_counts;
   delete[] probe_counts;
 }
 
@@ -101,6 +101,7 @@ void MessageQueue::Enqueue(std::unique_ptr<Message> msg0, bool before_events) {
 
   // Make sure messages are not reused.
   ASSERT(msg->next_ == nullptr);
+  length_++;
   if (head_ == nullptr) {
     // Only element in the queue.
     ASSERT(tail_ == nullptr);
@@ -142,6 +143,7 @@ void MessageQueue::Enqueue(std::unique_ptr<Message> msg0, bool before_events) {
 std::unique_ptr<Message> MessageQueue::Dequeue() {
   Message* result = head_;
   if (result != nullptr) {
+    length_--;
     head_ = result->next_;
     // The following update to tail_ is not strictly needed.
     if (head_ == nullptr) {
@@ -159,6 +161,7 @@ void MessageQueue::Clear() {
   std::unique_ptr<Message> cur(head_);
   head_ = nullptr;
   tail_ = nullptr;
+  length_ = 0;
   while (cur != nullptr) {
     std::unique_ptr<Message> next(cur->next_);
     cur = std::move(next);
@@ -188,16 +191,6 @@ Message* MessageQueue::Iterator::Next() {
   return current;
 }
 
-intptr_t MessageQueue::Length() const {
-  MessageQueue::Iterator it(this);
-  intptr_t length = 0;
-  while (it.HasNext()) {
-    it.Next();
-    length++;
-  }
-  return length;
-}
-
 Message* MessageQueue::FindMessageById(intptr_t id) {
   MessageQueue::Iterator it(this);
   while (it.HasNext()) {
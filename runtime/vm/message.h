@@ -128,6 +128,12 @@ class Message {
 
   intptr_t Id() const;
 
+#if !defined(PRODUCT)
+  // When the message was posted, or 0 if --message_queue_stats was off.
+  int64_t enqueue_micros() const { return enqueue_micros_; }
+  void set_enqueue_micros(int64_t micros) { enqueue_micros_ = micros; }
+#endif  // !defined(PRODUCT)
+
   static const char* PriorityAsString(Priority priority);
 
  private:
@@ -151,6 +157,9 @@ class Message {
   intptr_t snapshot_length_ = 0;
   MessageFinalizableData* finalizable_data_ = nullptr;
   Priority priority_;
+#if !defined(PRODUCT)
+  int64_t enqueue_micros_ = 0;
+#endif  // !defined(PRODUCT)
 
   DISALLOW_COPY_AND_ASSIGN(Message);
 };
@@ -190,7 +199,7 @@ class MessageQueue {
     Message* next_;
   };
 
-  intptr_t Length() const;
+  intptr_t Length() const { return length_; }
 
   // Returns the message with id or nullptr.
   Message* FindMessageById(intptr_t id);
@@ -200,6 +209,7 @@ class MessageQueue {
  private:
   Message* head_;
   Message* tail_;
+  intptr_t length_ = 0;
 
   DISALLOW_COPY_AND_ASSIGN(MessageQueue);
 };
@@ -7,19 +7,30 @@
 #include "vm/message_handler.h"
 
 #include "vm/dart.h"
+#include "vm/flags.h"
 #include "vm/heap/safepoint.h"
 #include "vm/isolate.h"
+#include "vm/json_stream.h"
 #include "vm/lockers.h"
 #include "vm/object.h"
 #include "vm/object_store.h"
 #include "vm/os.h"
 #include "vm/port.h"
 #include "vm/thread_interrupter.h"
+#include "vm/timeline.h"
 
 namespace dart {
 
 DECLARE_FLAG(bool, trace_service_pause_events);
 
+#if !defined(PRODUCT)
+DEFINE_FLAG(bool,
+            message_queue_stats,
+            false,
+            "Track the depth of isolate message queues and the time messages "
+            "wait in them.");
+#endif  // !defined(PRODUCT)
+
 class MessageHandlerTask : public ThreadPool::Task {
  public:
   explicit MessageHandlerTask(MessageHandler* handler) : handler_(handler) {
@@ -69,6 +80,7 @@ MessageHandler::MessageHandler()
       task_running_(false),
       delete_me_(false),
       pool_(nullptr),
+      last_worker_(nullptr),
       start_callback_(nullptr),
       end_callback_(nullptr),
       callback_data_(0) {
@@ -79,6 +91,9 @@ MessageHandler::MessageHandler()
 MessageHandler::~MessageHandler() {
   delete queue_;
   delete oob_queue_;
+#if !defined(PRODUCT)
+  delete queue_latency_;
+#endif  // !defined(PRODUCT)
   queue_ = nullptr;
   oob_queue_ = nullptr;
   pool_ = nullptr;
@@ -127,53 +142,109 @@ bool MessageHandler::Run(ThreadPool* pool,
   return result;
 }
 
+Message::Priority MessageHandler::EnqueueLocked(
+    std::unique_ptr<Message> message,
+    bool before_events) {
+  ASSERT(monitor_.IsOwnedByCurrentThread());
+  if (FLAG_trace_isolates) {
+    Isolate* source_isolate = Isolate::Current();
+    if (source_isolate != nullptr) {
+      OS::PrintErr(
+          "[>] Posting message:\n"
+          "\tlen:        %" Pd "\n\tsource:     (%" Pd64
+          ") %s\n\tdest:       %s\n"
+          "\tdest_port:  %" Pd64 "\n",
+          message->Size(), static_cast<int64_t>(source_isolate->main_port()),
+          source_isolate->name(), name(), message->dest_port());
+    } else {
+      OS::PrintErr(
+          "[>] Posting message:\n"
+          "\tlen:        %" Pd
+          "\n\tsource:     <native code>\n"
+          "\tdest:       %s\n"
+          "\tdest_port:  %" Pd64 "\n",
+          message->Size(), name(), message->dest_port());
+    }
+  }
+
+  const Message::Priority priority = message->priority();
+#if !defined(PRODUCT)
+  if (FLAG_message_queue_stats) {
+    message->set_enqueue_micros(OS::GetCurrentMonotonicMicros());
+  }
+#endif  // !defined(PRODUCT)
+  if (message->IsOOB()) {
+    oob_queue_->Enqueue(std::move(message), before_events);
+  } else {
+    queue_->Enqueue(std::move(message), before_events);
+  }
+#if !defined(PRODUCT)
+  if (FLAG_message_queue_stats) {
+    max_queue_depth_ = Utils::Maximum(max_queue_depth_,
+                                      queue_->Length() + oob_queue_->Length());
+  }
+#endif  // !defined(PRODUCT)
+  return priority;
+}
+
+void MessageHandler::WakeUpLocked(MonitorLocker* ml) {
+  if (paused_for_messages_) {
+    ml->Notify();
+  }
+
+  if (pool_ != nullptr && !task_running_) {
+    ASSERT(!delete_me_);
+    task_running_ = true;
+    const bool launched_successfully =
+        pool_->RunWithAffinity<MessageHandlerTask>(last_worker_, this);
+    ASSERT(launched_successfully);
+  }
+}
+
 void MessageHandler::PostMessage(std::unique_ptr<Message> message,
                                  bool before_events) {
   Message::Priority saved_priority;
 
   {
     MonitorLocker ml(&monitor_);
-    if (FLAG_trace_isolates) {
-      Isolate* source_isolate = Isolate::Current();
-      if (source_isolate != nullptr) {
-        OS::PrintErr(
-            "[>] Posting message:\n"
-            "\tlen:        %" Pd "\n\tsource:     (%" Pd64
-            ") %s\n\tdest:       %s\n"
-            "\tdest_port:  %" Pd64 "\n",
-            message->Size(), static_cast<int64_t>(source_isolate->main_port()),
-            source_isolate->name(), name(), message->dest_port());
-      } else {
-        OS::PrintErr(
-            "[>] Posting message:\n"
-            "\tlen:        %" Pd
-            "\n\tsource:     <native code>\n"
-            "\tdest:       %s\n"
-            "\tdest_port:  %" Pd64 "\n",
-            message->Size(), name(), message->dest_port());
-      }
-    }
+    saved_priority = EnqueueLocked(std::move(message), before_events);
+    WakeUpLocked(&ml);
+  }
 
-    saved_priority = message->priority();
-    if (message->IsOOB()) {
-      oob_queue_->Enqueue(std::move(message), before_events);
-    } else {
-      queue_->Enqueue(std::move(message), before_events);
-    }
-    if (paused_for_messages_) {
-      ml.Notify();
-    }
+  // Invoke any custom message notification.
+  MessageNotify(saved_priority);
+}
 
-    if (pool_ != nullptr && !task_running_) {
-      ASSERT(!delete_me_);
-      task_running_ = true;
-      const bool launched_successfully = pool_->Run<MessageHandlerTask>(this);
-      ASSERT(launched_successfully);
+void MessageHandler::PostMessages(MessageQueue* messages) {
+  if (messages->IsEmpty()) {
+    return;
+  }
+  intptr_t normal_count = 0;
+  intptr_t oob_count = 0;
+
+  {
+    MonitorLocker ml(&monitor_);
+    std::unique_ptr<Message> message = messages->Dequeue();
+    while (message != nullptr) {
+      if (EnqueueLocked(std::move(message), /*before_events=*/false) ==
+          Message::kOOBPriority) {
+        oob_count++;
+      } else {
+        normal_count++;
+      }
+      message = messages->Dequeue();
     }
+    WakeUpLocked(&ml);
   }
 
-  // Invoke any custom message notification.
-  MessageNotify(saved_priority);
+  // Invoke any custom message notification, once per message as embedders
+  // expect.
+  for (intptr_t i = 0; i < oob_count; i++) {
+    MessageNotify(Message::kOOBPriority);
+  }
+  for (intptr_t i = 0; i < normal_count; i++) {
+    MessageNotify(Message::kNormalPriority);
+  }
 }
 
 std::unique_ptr<Message> MessageHandler::DequeueMessage(
@@ -183,9 +254,50 @@ std::unique_ptr<Message> MessageHandler::DequeueMessage(
   if ((message == nullptr) && (min_priority < Message::kOOBPriority)) {
     message = queue_->Dequeue();
   }
+#if !defined(PRODUCT)
+  if ((message != nullptr) && (message->enqueue_micros() != 0)) {
+    RecordDequeueLocked(*message);
+  }
+#endif  // !defined(PRODUCT)
   return message;
 }
 
+#if !defined(PRODUCT)
+void MessageHandler::RecordDequeueLocked(const Message& message) {
+  const int64_t waited_micros =
+      OS::GetCurrentMonotonicMicros() - message.enqueue_micros();
+  if (queue_latency_ == nullptr) {
+    queue_latency_ = new PauseHistogram();
+  }
+  queue_latency_->Add(waited_micros);
+
+#if defined(SUPPORT_TIMELINE)
+  TimelineEvent* event = Timeline::GetIsolateStream()->StartEvent();
+  if (event != nullptr) {
+    event->Counter("MessageQueue");
+    event->SetNumArguments(2);
+    event->FormatArgument(0, "depth", "%" Pd "",
+                          queue_->Length() + oob_queue_->Length());
+    event->FormatArgument(1, "wait (us)", "%" Pd64 "", waited_micros);
+    event->Complete();
+  }
+#endif  // defined(SUPPORT_TIMELINE)
+}
+
+void MessageHandler::PrintQueueStatsJSON(JSONObject* jsobj) {
+  MonitorLocker ml(&monitor_);
+  jsobj->AddProperty("depth", queue_->Length());
+  jsobj->AddProperty("oobDepth", oob_queue_->Length());
+  if (FLAG_message_queue_stats) {
+    jsobj->AddProperty("maxDepth", max_queue_depth_);
+  }
+  if (queue_latency_ != nullptr) {
+    JSONObject latency(jsobj, "latency");
+    queue_latency_->PrintJSON(&latency);
+  }
+}
+#endif  // !defined(PRODUCT)
+
 void MessageHandler::ClearOOBQueue() {
   oob_queue_->Clear();
 }
@@ -387,6 +499,16 @@ bool MessageHandler::HasMessages() {
   return !queue_->IsEmpty();
 }
 
+intptr_t MessageHandler::MessageCount() {
+  MonitorLocker ml(&monitor_);
+  return queue_->Length();
+}
+
+intptr_t MessageHandler::OOBMessageCount() {
+  MonitorLocker ml(&monitor_);
+  return oob_queue_->Length();
+}
+
 void MessageHandler::TaskCallback() {
   ASSERT(Isolate::Current() == nullptr);
   MessageStatus status = kOK;
@@ -405,6 +527,7 @@ void MessageHandler::TaskCallback() {
     // other message handler tasks will be started until this one sets
     // [task_running_] to false.
     ASSERT(task_running_);
+    last_worker_ = pool_->CurrentWorkerAffinity();
 
 #if !defined(PRODUCT)
     if (ShouldPauseOnStart(kOK)) {
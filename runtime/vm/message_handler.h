@@ -7,6 +7,7 @@
 
 #include <memory>
 
+#include "vm/heap/gc_stats.h"
 #include "vm/isolate.h"
 #include "vm/lockers.h"
 #include "vm/message.h"
@@ -84,6 +85,10 @@ class MessageHandler {
   // handler.
   bool HasMessages();
 
+  // Returns the number of pending normal and OOB messages respectively.
+  intptr_t MessageCount();
+  intptr_t OOBMessageCount();
+
   // Whether to keep this message handler alive or whether it should shutdown.
   virtual bool KeepAliveLocked() {
     // By default we keep alive until the message handler was asked to shutdown
@@ -106,6 +111,10 @@ class MessageHandler {
 #if !defined(PRODUCT)
   void DebugDump();
 
+  // Prints the current queue depths and, with --message_queue_stats, the
+  // maximum depth and a histogram of the time messages spent in the queue.
+  void PrintQueueStatsJSON(JSONObject* jsobj);
+
   bool should_pause_on_start() const { return should_pause_on_start_; }
 
   void set_should_pause_on_start(bool should_pause_on_start) {
@@ -186,6 +195,11 @@ class MessageHandler {
   void PostMessage(std::unique_ptr<Message> message,
                    bool before_events = false);
 
+  // Posts all messages of [messages] on this handler's message queue, in
+  // order, taking the handler's lock and waking up the handler only once.
+  // [messages] is left empty.
+  void PostMessages(MessageQueue* messages);
+
   // Notifies this handler that a port is being closed.
   void ClosePort(Dart_Port port);
 
@@ -236,12 +250,24 @@ class MessageHandler {
   void PausedOnStartLocked(MonitorLocker* ml, bool paused);
   void PausedOnExitLocked(MonitorLocker* ml, bool paused);
 
+  // Appends [message] to the matching queue and returns its priority.
+  Message::Priority EnqueueLocked(std::unique_ptr<Message> message,
+                                  bool before_events);
+
+  // Wakes up a paused handler or starts a task to handle the new messages.
+  void WakeUpLocked(MonitorLocker* ml);
+
   // Dequeue the next message.  Prefer messages from the oob_queue_ to
   // messages from the queue_.
   std::unique_ptr<Message> DequeueMessage(Message::Priority min_priority);
 
   void ClearOOBQueue();
 
+#if !defined(PRODUCT)
+  // Records the time [message] spent in the queue with --message_queue_stats.
+  void RecordDequeueLocked(const Message& message);
+#endif  // !defined(PRODUCT)
+
   // Handles any pending messages.
   MessageStatus HandleMessages(MonitorLocker* ml,
                                bool allow_normal_messages,
@@ -266,10 +292,15 @@ class MessageHandler {
   // processed so that we can resume correctly(into potentially not-OK status).
   MessageStatus remembered_paused_on_exit_status_;
   int64_t paused_timestamp_;
+  // Only maintained with --message_queue_stats.
+  intptr_t max_queue_depth_ = 0;
+  PauseHistogram* queue_latency_ = nullptr;
 #endif
   bool task_running_;
   bool delete_me_;
   ThreadPool* pool_;
+  // The [pool_] worker which last ran [TaskCallback].
+  const void* last_worker_;
   StartCallback start_callback_;
   EndCallback end_callback_;
   CallbackData callback_data_;
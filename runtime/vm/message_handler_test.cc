@@ -10,6 +10,10 @@
 
 namespace dart {
 
+#if !defined(PRODUCT)
+DECLARE_FLAG(bool, message_queue_stats);
+#endif  // !defined(PRODUCT)
+
 class MessageHandlerTestPeer {
  public:
   explicit MessageHandlerTestPeer(MessageHandler* handler)
@@ -23,6 +27,10 @@ class MessageHandlerTestPeer {
 
   MessageQueue* queue() const { return handler_->queue_; }
   MessageQueue* oob_queue() const { return handler_->oob_queue_; }
+#if !defined(PRODUCT)
+  intptr_t max_queue_depth() const { return handler_->max_queue_depth_; }
+  PauseHistogram* queue_latency() const { return handler_->queue_latency_; }
+#endif  // !defined(PRODUCT)
 
  private:
   MessageHandler* handler_;
@@ -246,6 +254,27 @@ VM_UNIT_TEST_CASE(MessageHandler_HandleNextMessage) {
   EXPECT_EQ(port1, ports[2]);
 }
 
+#if !defined(PRODUCT)
+VM_UNIT_TEST_CASE(MessageHandler_QueueStats) {
+  SetFlagScope<bool> sfs(&FLAG_message_queue_stats, true);
+  TestMessageHandler handler;
+  MessageHandlerTestPeer handler_peer(&handler);
+  Dart_Port port1 = PortMap::CreatePort(&handler);
+  handler_peer.PostMessage(BlankMessage(port1, Message::kNormalPriority));
+  handler_peer.PostMessage(BlankMessage(port1, Message::kOOBPriority));
+  handler_peer.PostMessage(BlankMessage(port1, Message::kNormalPriority));
+  EXPECT_EQ(3, handler_peer.max_queue_depth());
+  EXPECT(handler_peer.queue_latency() == nullptr);
+
+  // We handle the oob message and a single normal message.
+  EXPECT_EQ(MessageHandler::kOK, handler.HandleNextMessage());
+  ASSERT(handler_peer.queue_latency() != nullptr);
+  EXPECT_EQ(2, handler_peer.queue_latency()->Count());
+  EXPECT_EQ(1, handler.MessageCount());
+  EXPECT_EQ(3, handler_peer.max_queue_depth());
+}
+#endif  // !defined(PRODUCT)
+
 VM_UNIT_TEST_CASE(MessageHandler_HandleNextMessage_ProcessOOBAfterError) {
   TestMessageHandler handler;
   MessageHandler::MessageStatus results[] = {
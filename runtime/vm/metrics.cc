@@ -7,6 +7,7 @@
 #include "vm/isolate.h"
 #include "vm/json_stream.h"
 #include "vm/log.h"
+#include "vm/message_handler.h"
 #include "vm/native_entry.h"
 #include "vm/object.h"
 #include "vm/runtime_entry.h"
@@ -192,6 +193,16 @@ int64_t MetricCurrentRSS::Value() const {
 int64_t MetricPeakRSS::Value() const {
   return Service::MaxRSS();
 }
+
+int64_t MetricMessageQueueLength::Value() const {
+  MessageHandler* handler = isolate()->message_handler();
+  return handler != nullptr ? handler->MessageCount() : 0;
+}
+
+int64_t MetricOOBMessageQueueLength::Value() const {
+  MessageHandler* handler = isolate()->message_handler();
+  return handler != nullptr ? handler->OOBMessageCount() : 0;
+}
 #endif  // !defined(PRODUCT)
 
 MaxMetric::MaxMetric() : Metric() {
@@ -48,7 +48,11 @@ class JSONStream;
 // All metrics are exposed via vm-service protocol.
 #define ISOLATE_METRIC_LIST(V)                                                 \
   V(Metric, RunnableLatency, "isolate.runnable.latency", kMicrosecond)         \
-  V(Metric, RunnableHeapSize, "isolate.runnable.heap", kByte)
+  V(Metric, RunnableHeapSize, "isolate.runnable.heap", kByte)                  \
+  V(MetricMessageQueueLength, MessageQueueLength,                              \
+    "isolate.messages.queue.length", kCounter)                                 \
+  V(MetricOOBMessageQueueLength, OOBMessageQueueLength,                        \
+    "isolate.messages.oob.length", kCounter)
 
 class Metric {
  public:
@@ -188,6 +192,18 @@ class MetricPeakRSS : public Metric {
  public:
   virtual int64_t Value() const;
 };
+
+// Number of normal priority messages waiting in the isolate's message queue.
+class MetricMessageQueueLength : public Metric {
+ public:
+  virtual int64_t Value() const;
+};
+
+// Number of out-of-band messages waiting in the isolate's message queue.
+class MetricOOBMessageQueueLength : public Metric {
+ public:
+  virtual int64_t Value() const;
+};
 #endif  // !defined(PRODUCT)
 
 class MetricHeapUsed : public Metric {
@@ -11,7 +11,9 @@
 #include "vm/dart_api_state.h"
 #include "vm/globals.h"
 #include "vm/json_stream.h"
+#include "vm/message.h"
 #include "vm/metrics.h"
+#include "vm/port.h"
 #include "vm/unit_test.h"
 // #include "vm/heap.h"
 
@@ -74,6 +76,24 @@ VM_UNIT_TEST_CASE(Metric_OnDemand) {
   }
   Dart_ShutdownIsolate();
 }
+
+ISOLATE_UNIT_TEST_CASE(Metric_MessageQueueLength) {
+  Isolate* isolate = thread->isolate();
+  EXPECT_EQ(0, isolate->GetMessageQueueLengthMetric()->Value());
+  EXPECT_EQ(0, isolate->GetOOBMessageQueueLengthMetric()->Value());
+
+  // The test isolate does not run its message handler, so posted messages
+  // stay in the queues until the isolate shuts down.
+  const Dart_Port port = isolate->main_port();
+  PortMap::PostMessage(
+      Message::New(port, Object::null(), Message::kNormalPriority));
+  PortMap::PostMessage(
+      Message::New(port, Object::null(), Message::kNormalPriority));
+  PortMap::PostMessage(
+      Message::New(port, Object::null(), Message::kOOBPriority));
+  EXPECT_EQ(2, isolate->GetMessageQueueLengthMetric()->Value());
+  EXPECT_EQ(1, isolate->GetOOBMessageQueueLengthMetric()->Value());
+}
 #endif  // !defined(PRODUCT)
 
 ISOLATE_UNIT_TEST_CASE(Metric_EmbedderAPI) {
@@ -60,6 +60,30 @@ DART_EXPORT bool Dart_PostCObject(Dart_Port port_id, Dart_CObject* message) {
   return PostCObjectHelper(port_id, message);
 }
 
+DART_EXPORT bool Dart_PostCObjects(Dart_Port port_id,
+                                   intptr_t num_messages,
+                                   Dart_CObject** messages) {
+  AllocOnlyStackZone zone;
+  MessageQueue batch;
+  for (intptr_t i = 0; i < num_messages; i++) {
+    std::unique_ptr<Message> msg = WriteApiMessage(
+        zone.GetZone(), messages[i], port_id, Message::kNormalPriority);
+    if (msg == nullptr) {
+      // Ownership of external data remains with the poster.
+      std::unique_ptr<Message> written = batch.Dequeue();
+      while (written != nullptr) {
+        written->DropFinalizers();
+        written = batch.Dequeue();
+      }
+      return false;
+    }
+    batch.Enqueue(std::move(msg), /*before_events=*/false);
+  }
+
+  // Post the messages at the given port.
+  return PortMap::PostMessages(port_id, &batch);
+}
+
 DART_EXPORT bool Dart_PostInteger(Dart_Port port_id, int64_t message) {
   if (Smi::IsValid(message)) {
     return PortMap::PostMessage(
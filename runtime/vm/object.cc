@@ -11286,6 +11286,7 @@ int32_t Function::SourceFingerprint() const {
 void Function::SaveICDataMap(
     const ZoneGrowableArray<const ICData*>& deopt_id_to_ic_data,
     const Array& edge_counters_array,
+    const Array& edge_counter_keys_array,
     const Array& coverage_array) const {
 #if !defined(DART_PRECOMPILED_RUNTIME)
   // Already installed nothing to do.
@@ -11314,6 +11315,7 @@ void Function::SaveICDataMap(
     }
   }
   array.SetAt(ICDataArrayIndices::kEdgeCounters, edge_counters_array);
+  array.SetAt(ICDataArrayIndices::kEdgeCounterKeys, edge_counter_keys_array);
   // Preserve coverage_array which is stored early after graph construction.
   array.SetAt(ICDataArrayIndices::kCoverageData, coverage_array);
   set_ic_data_array(array);
@@ -15674,6 +15676,20 @@ intptr_t InstructionsTable::FindEntry(InstructionsTablePtr table,
   const auto entries = rodata->entries();
   intptr_t lo = start_index;
   intptr_t hi = rodata->length - 1;
+  // Narrow the search down to the entries overlapping the page of pc.
+  const intptr_t page =
+      pc_offset >> UntaggedInstructionsTable::kPageIndexShift;
+  if (page < static_cast<intptr_t>(rodata->page_index_length)) {
+    const uint32_t* page_index = rodata->page_index();
+    lo = Utils::Maximum(lo, static_cast<intptr_t>(page_index[page]));
+    if (page + 1 < static_cast<intptr_t>(rodata->page_index_length)) {
+      hi = page_index[page + 1];
+    }
+  } else if (rodata->page_index_length > 0) {
+    lo = Utils::Maximum(
+        lo, static_cast<intptr_t>(
+                rodata->page_index()[rodata->page_index_length - 1]));
+  }
   while (lo <= hi) {
     intptr_t mid = (hi - lo + 1) / 2 + lo;
     ASSERT(mid >= lo);
@@ -18287,7 +18303,7 @@ void Code::NotifyCodeObservers(const char* name,
     const auto& instrs = Instructions::Handle(code.instructions());
     CodeObservers::NotifyAll(name, instrs.PayloadStart(),
                              code.GetPrologueOffset(), instrs.Size(), optimized,
-                             &code.comments());
+                             code);
   }
 #endif
 }
@@ -18979,17 +18995,38 @@ void MegamorphicCache::InsertEntryLocked(const Smi& class_id,
   ASSERT(static_cast<double>(filled_entry_count() + 1) <=
          (kLoadFactor * static_cast<double>(mask() + 1)));
   const Array& backing_array = Array::Handle(buckets());
-  intptr_t id_mask = mask();
-  intptr_t index = (class_id.Value() * kSpreadFactor) & id_mask;
-  intptr_t i = index;
-  do {
-    if (Smi::Value(Smi::RawCast(GetClassId(backing_array, i))) == kIllegalCid) {
-      SetEntry(backing_array, i, class_id, target);
+  const intptr_t id_mask = mask();
+
+  // Robin Hood insertion: an entry which is further away from its home slot
+  // than the entry occupying a slot takes the slot over, and insertion goes
+  // on with the displaced entry. Lookups are still linear probes from the
+  // home slot, but no entry ends up far behind it. This is safe because the
+  // mutators are stopped while the cache is modified.
+  Smi& cid = Smi::Handle(class_id.ptr());
+  Object& entry_target = Object::Handle(target.ptr());
+  Smi& other_cid = Smi::Handle();
+  Object& other_target = Object::Handle();
+  intptr_t i = (cid.Value() * kSpreadFactor) & id_mask;
+  intptr_t distance = 0;
+  for (intptr_t n = 0; n <= id_mask; ++n) {
+    other_cid ^= GetClassId(backing_array, i);
+    if (other_cid.Value() == kIllegalCid) {
+      SetEntry(backing_array, i, cid, entry_target);
       set_filled_entry_count(filled_entry_count() + 1);
       return;
     }
+    const intptr_t other_distance =
+        (i - ((other_cid.Value() * kSpreadFactor) & id_mask)) & id_mask;
+    if (other_distance < distance) {
+      other_target = GetTargetFunction(backing_array, i);
+      SetEntry(backing_array, i, cid, entry_target);
+      cid = other_cid.ptr();
+      entry_target = other_target.ptr();
+      distance = other_distance;
+    }
     i = (i + 1) & id_mask;
-  } while (i != index);
+    ++distance;
+  }
   UNREACHABLE();
 }
 
@@ -24393,6 +24430,9 @@ StringPtr String::Transform(int32_t (*mapping)(int32_t ch),
                             const String& str,
                             Heap::Space space) {
   ASSERT(!str.IsNull());
+  if (str.IsOneByteString()) {
+    return OneByteString::TransformOneByte(mapping, str, space);
+  }
   bool has_mapping = false;
   int32_t dst_max = 0;
   CodePointIterator it(str);
@@ -24415,12 +24455,10 @@ StringPtr String::Transform(int32_t (*mapping)(int32_t ch),
 }
 
 StringPtr String::ToUpperCase(const String& str, Heap::Space space) {
-  // TODO(cshapiro): create a fast-path for OneByteString instances.
   return Transform(CaseMapping::ToUpper, str, space);
 }
 
 StringPtr String::ToLowerCase(const String& str, Heap::Space space) {
-  // TODO(cshapiro): create a fast-path for OneByteString instances.
   return Transform(CaseMapping::ToLower, str, space);
 }
 
@@ -24726,6 +24764,47 @@ OneByteStringPtr OneByteString::Transform(int32_t (*mapping)(int32_t ch),
   return OneByteString::raw(result);
 }
 
+StringPtr OneByteString::TransformOneByte(int32_t (*mapping)(int32_t ch),
+                                          const String& str,
+                                          Heap::Space space) {
+  ASSERT(str.IsOneByteString());
+  const intptr_t len = str.Length();
+  // Most strings are already in the requested case, find the first character
+  // that is changed by the mapping before allocating anything.
+  intptr_t first_mapped = 0;
+  {
+    NoSafepointScope no_safepoint;
+    while (first_mapped < len) {
+      const int32_t ch = CharAt(str, first_mapped);
+      if (mapping(ch) != ch) break;
+      first_mapped++;
+    }
+  }
+  if (first_mapped == len) {
+    return str.ptr();
+  }
+  const String& result = String::Handle(OneByteString::New(len, space));
+  bool is_latin1 = true;
+  {
+    NoSafepointScope no_safepoint;
+    memmove(CharAddr(result, 0), CharAddr(str, 0), first_mapped);
+    for (intptr_t i = first_mapped; i < len; ++i) {
+      const int32_t ch = mapping(CharAt(str, i));
+      if (!Utf::IsLatin1(ch)) {
+        is_latin1 = false;
+        break;
+      }
+      *CharAddr(result, i) = ch;
+    }
+  }
+  if (!is_latin1) {
+    // Only a few characters, like the micro sign, leave Latin-1 when
+    // upper-cased.
+    return TwoByteString::Transform(mapping, str, space);
+  }
+  return result.ptr();
+}
+
 OneByteStringPtr OneByteString::SubStringUnchecked(const String& str,
                                                    intptr_t begin_index,
                                                    intptr_t length,
@@ -26785,7 +26864,7 @@ RegExpPtr RegExp::New(Zone* zone, Heap::Space space) {
   result.set_num_registers(/*is_one_byte=*/false, -1);
   result.set_num_registers(/*is_one_byte=*/true, -1);
 
-  if (!FLAG_interpret_irregexp) {
+  if (!FLAG_interpret_irregexp && FLAG_regexp_tier_up_threshold <= 0) {
     auto thread = Thread::Current();
     const Library& lib = Library::Handle(zone, Library::CoreLibrary());
     const Class& owner =
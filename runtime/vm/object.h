@@ -2487,6 +2487,7 @@ class ICData : public CallSiteData {
   V(DoubleToSmi)                                                               \
   V(CheckSmi)                                                                  \
   V(CheckClass)                                                                \
+  V(CheckArrayBound)                                                           \
   V(Unknown)                                                                   \
   V(PolymorphicInstanceCallTestFail)                                           \
   V(UnaryInt64Op)                                                              \
@@ -2494,7 +2495,6 @@ class ICData : public CallSiteData {
   V(UnaryOp)                                                                   \
   V(UnboxInteger)                                                              \
   V(Unbox)                                                                     \
-  V(CheckArrayBound)                                                           \
   V(AtCall)                                                                    \
   V(GuardField)                                                                \
   V(TestCids)                                                                  \
@@ -4046,6 +4046,7 @@ class Function : public Object {
   void SaveICDataMap(
       const ZoneGrowableArray<const ICData*>& deopt_id_to_ic_data,
       const Array& edge_counters_array,
+      const Array& edge_counter_keys_array,
       const Array& coverage_array) const;
   // Uses 'ic_data_array' to populate the table 'deopt_id_to_ic_data'. Clone
   // ic_data (array and descriptor) if 'clone_ic_data' is true.
@@ -4053,12 +4054,14 @@ class Function : public Object {
                         bool clone_ic_data) const;
 
   // ic_data_array attached to the function stores edge counters in the
-  // first element, coverage data array in the second element and the rest
-  // are ICData objects.
+  // first element, the deopt ids of the blocks owning the edge counters in
+  // the second element (only with --write_aot_profile_to), coverage data
+  // array in the third element and the rest are ICData objects.
   struct ICDataArrayIndices {
     static constexpr intptr_t kEdgeCounters = 0;
-    static constexpr intptr_t kCoverageData = 1;
-    static constexpr intptr_t kFirstICData = 2;
+    static constexpr intptr_t kEdgeCounterKeys = 1;
+    static constexpr intptr_t kCoverageData = 2;
+    static constexpr intptr_t kFirstICData = 3;
   };
 
   ArrayPtr ic_data_array() const;
@@ -4086,11 +4089,14 @@ class Function : public Object {
 // a hoisted instruction.
 // 'ProhibitsBoundsCheckGeneralization' is true if this function deoptimized
 // before on a generalized bounds check.
+// 'WasBaselineOptimized' is true if this function was optimized with the
+// baseline pipeline, so that its next optimization uses the full pipeline.
 #define STATE_BITS_LIST(V)                                                     \
   V(WasCompiled)                                                               \
   V(WasExecutedBit)                                                            \
   V(ProhibitsInstructionHoisting)                                              \
-  V(ProhibitsBoundsCheckGeneralization)
+  V(ProhibitsBoundsCheckGeneralization)                                        \
+  V(WasBaselineOptimized)
 
   enum StateBits {
 #define DECLARE_FLAG_POS(Name) k##Name##Pos,
@@ -4211,6 +4217,32 @@ class Function : public Object {
 #endif
   }
 
+#if !defined(DART_PRECOMPILED_RUNTIME)
+  // Set when compiling AOT once the optimized version of this function was
+  // found to neither write memory nor call anything that does, so that calls
+  // to it don't invalidate loads in the caller. Not recorded in JIT mode,
+  // where hot reload and deoptimization change the code it was derived from.
+  bool has_no_side_effects() const {
+    return untag()
+        ->packed_fields_.Read<UntaggedFunction::PackedHasNoSideEffects>();
+  }
+  void set_has_no_side_effects() const {
+    untag()
+        ->packed_fields_.UpdateBool<UntaggedFunction::PackedHasNoSideEffects>(
+            true);
+  }
+
+  // Set if additionally the result only depends on the arguments and is not
+  // a newly allocated object, so that calls to it with the same arguments can
+  // be replaced with each other.
+  bool is_pure() const {
+    return untag()->packed_fields_.Read<UntaggedFunction::PackedIsPure>();
+  }
+  void set_is_pure() const {
+    untag()->packed_fields_.UpdateBool<UntaggedFunction::PackedIsPure>(true);
+  }
+#endif  // !defined(DART_PRECOMPILED_RUNTIME)
+
   enum KindTagBits {
     kKindTagPos = 0,
     kKindTagSize = 5,
@@ -10584,6 +10616,12 @@ class OneByteString : public AllStatic {
                                     const String& str,
                                     Heap::Space space);
 
+  // Applies [mapping] to the characters of the one-byte string [str].
+  // Returns [str] itself if no character changes.
+  static StringPtr TransformOneByte(int32_t (*mapping)(int32_t ch),
+                                    const String& str,
+                                    Heap::Space space);
+
   // High performance version of substring for one-byte strings.
   // "str" must be OneByteString.
   static OneByteStringPtr SubStringUnchecked(const String& str,
@@ -10622,6 +10660,7 @@ class OneByteString : public AllStatic {
   friend class Class;
   friend class FlowGraphSerializer;
   friend class ImageWriter;
+  friend class IrregexpInterpreter;
   friend class String;
   friend class StringHasher;
   friend class Symbols;
@@ -10745,6 +10784,7 @@ class TwoByteString : public AllStatic {
   friend class Class;
   friend class FlowGraphSerializer;
   friend class ImageWriter;
+  friend class IrregexpInterpreter;
   friend class String;
   friend class StringHasher;
   friend class Symbols;
@@ -10796,7 +10836,9 @@ class Array : public Instance {
   // this many elements. Consequently WB elimination code should not eliminate
   // WB on arrays of larger lengths across instructions that can cause GC.
   // Note: we also can't restore WB invariant for arrays which use card marking.
-  static constexpr intptr_t kMaxLengthForWriteBarrierElimination = 8;
+  // The restoration only visits frames which called into the runtime, so the
+  // limit can cover arrays filled with freshly allocated objects in a loop.
+  static constexpr intptr_t kMaxLengthForWriteBarrierElimination = 64;
 
   intptr_t Length() const { return LengthOf(ptr()); }
   static intptr_t LengthOf(const ArrayPtr array) {
@@ -12757,6 +12799,15 @@ class RegExp : public Instance {
                     : &untag()->num_two_byte_registers_);
   }
 
+  // Records one more interpretation of this regexp and returns the number of
+  // times it has been interpreted so far (saturating).
+  intptr_t IncrementInterpretedCount() const {
+    std::atomic<uint16_t>* count = &untag()->interpreted_count_;
+    const uint16_t old = count->load(std::memory_order_relaxed);
+    if (old == kMaxUint16) return old;
+    return count->fetch_add(1, std::memory_order_relaxed) + 1;
+  }
+
   StringPtr pattern() const { return untag()->pattern(); }
   intptr_t num_bracket_expressions() const {
     return untag()->num_bracket_expressions_;
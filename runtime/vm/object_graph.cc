@@ -6,6 +6,7 @@
 
 #include "vm/dart.h"
 #include "vm/dart_api_state.h"
+#include "vm/flags.h"
 #include "vm/growable_array.h"
 #include "vm/isolate.h"
 #include "vm/native_symbol.h"
@@ -15,12 +16,20 @@
 #include "vm/raw_object.h"
 #include "vm/raw_object_fields.h"
 #include "vm/reusable_handles.h"
+#include "vm/thread_pool.h"
 #include "vm/visitor.h"
 
 namespace dart {
 
 #if defined(DART_ENABLE_HEAP_SNAPSHOT_WRITER)
 
+DEFINE_FLAG(int,
+            heap_snapshot_tasks,
+            2,
+            "The number of helper threads that visit the heap's pages when "
+            "writing a heap snapshot. 0 means the pages are visited only on "
+            "the thread writing the snapshot.");
+
 static bool IsUserClass(intptr_t cid) {
   if (cid == kContextCid) return true;
   if (cid == kTypeArgumentsCid) return false;
@@ -819,7 +828,7 @@ class CountingPage {
   DISALLOW_IMPLICIT_CONSTRUCTORS(CountingPage);
 };
 
-void HeapSnapshotWriter::EnsureAvailable(intptr_t needed) {
+void HeapSnapshotStream::EnsureAvailable(intptr_t needed) {
   intptr_t available = capacity_ - size_;
   if (available >= needed) {
     return;
@@ -831,27 +840,237 @@ void HeapSnapshotWriter::EnsureAvailable(intptr_t needed) {
   ASSERT(buffer_ == nullptr);
 
   intptr_t chunk_size = kPreferredChunkSize;
-  const intptr_t reserved_prefix = writer_->ReserveChunkPrefixSize();
-  if (chunk_size < (reserved_prefix + needed)) {
-    chunk_size = reserved_prefix + needed;
+  if (chunk_size < (reserved_prefix_ + needed)) {
+    chunk_size = reserved_prefix_ + needed;
   }
   buffer_ = reinterpret_cast<uint8_t*>(malloc(chunk_size));
-  size_ = reserved_prefix;
+  size_ = reserved_prefix_;
   capacity_ = chunk_size;
 }
 
-void HeapSnapshotWriter::Flush(bool last) {
+void HeapSnapshotStream::Flush(bool last) {
   if (size_ == 0 && !last) {
     return;
   }
 
-  writer_->WriteChunk(buffer_, size_, last);
+  WriteChunk(buffer_, size_, last);
 
   buffer_ = nullptr;
   size_ = 0;
   capacity_ = 0;
 }
 
+// Keeps the output of a slice until it can be appended to the snapshot.
+class BufferedHeapSnapshotStream : public HeapSnapshotStream {
+ public:
+  BufferedHeapSnapshotStream() : HeapSnapshotStream(0) {}
+  ~BufferedHeapSnapshotStream() {
+    for (const Chunk& chunk : chunks_) {
+      free(chunk.buffer);
+    }
+  }
+
+  void AppendTo(HeapSnapshotStream* stream) {
+    Flush();
+    for (const Chunk& chunk : chunks_) {
+      stream->WriteBytes(chunk.buffer, chunk.size);
+      free(chunk.buffer);
+    }
+    chunks_.Clear();
+  }
+
+ protected:
+  void WriteChunk(uint8_t* buffer, intptr_t size, bool last) override {
+    Chunk chunk = {buffer, size};
+    chunks_.Add(chunk);
+  }
+
+ private:
+  struct Chunk {
+    uint8_t* buffer;
+    intptr_t size;
+  };
+  MallocGrowableArray<Chunk> chunks_;
+
+  DISALLOW_COPY_AND_ASSIGN(BufferedHeapSnapshotStream);
+};
+
+// The objects of one page, visited by one task in each pass. Recording the
+// ids of a page's objects only touches its own counting page.
+class HeapSnapshotSlice {
+ public:
+  HeapSnapshotSlice() {}
+
+  Page* page = nullptr;
+  intptr_t object_count = 0;
+  intptr_t next_id = 0;
+  intptr_t reference_count = 0;
+  // The Smis referenced from the slice, in order of first reference. Only
+  // recently added values are filtered out, so the list may have duplicates.
+  MallocGrowableArray<SmiPtr> smis;
+  SmiPtr recent_smis[64] = {};
+  BufferedHeapSnapshotStream stream;
+
+  void AddSmi(SmiPtr smi) {
+    const intptr_t index =
+        Utils::WordHash(static_cast<intptr_t>(static_cast<uword>(smi))) &
+        (ARRAY_SIZE(recent_smis) - 1);
+    if (recent_smis[index] != smi) {
+      recent_smis[index] = smi;
+      smis.Add(smi);
+    }
+  }
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(HeapSnapshotSlice);
+};
+
+// One pass over the heap's pages.
+class HeapSnapshotSliceVisitor {
+ public:
+  HeapSnapshotSliceVisitor() {}
+  virtual ~HeapSnapshotSliceVisitor() {}
+
+  // Called on any thread, once for each slice.
+  virtual void VisitSlice(HeapSnapshotSlice* slice) = 0;
+
+  // Called on the thread writing the snapshot, in page order, after the slice
+  // has been visited.
+  virtual void ConsumeSlice(HeapSnapshotSlice* slice) = 0;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(HeapSnapshotSliceVisitor);
+};
+
+// Visits slices on helper threads, while the thread writing the snapshot
+// consumes the visited slices in order.
+class HeapSnapshotTasks : public ValueObject {
+ public:
+
+  HeapSnapshotTasks(IsolateGroup* isolate_group,
+                    HeapSnapshotSlice* slices,
+                    intptr_t num_slices)
+      : isolate_group_(isolate_group),
+        slices_(slices),
+        num_slices_(num_slices),
+        visited_(new bool[num_slices]) {}
+
+  void Run(HeapSnapshotSliceVisitor* visitor);
+
+  // Body of a helper thread.
+  void Work();
+
+ private:
+  // Bounds the buffered output of slices that are visited but not consumed.
+  static constexpr intptr_t kMaxSlicesAhead = 64;
+
+  bool CanClaimSlice() const {
+    return (next_slice_ < num_slices_) &&
+           (next_slice_ < consumed_ + kMaxSlicesAhead);
+  }
+
+  IsolateGroup* const isolate_group_;
+  HeapSnapshotSlice* const slices_;
+  const intptr_t num_slices_;
+  HeapSnapshotSliceVisitor* visitor_ = nullptr;
+
+  // Guards the fields below.
+  Monitor monitor_;
+  std::unique_ptr<bool[]> visited_;
+  intptr_t next_slice_ = 0;
+  intptr_t consumed_ = 0;
+  intptr_t running_tasks_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(HeapSnapshotTasks);
+};
+
+class HeapSnapshotTask : public ThreadPool::Task {
+ public:
+  explicit HeapSnapshotTask(HeapSnapshotTasks* tasks) : tasks_(tasks) {}
+
+  void Run() override { tasks_->Work(); }
+
+ private:
+  HeapSnapshotTasks* const tasks_;
+
+  DISALLOW_COPY_AND_ASSIGN(HeapSnapshotTask);
+};
+
+void HeapSnapshotTasks::Run(HeapSnapshotSliceVisitor* visitor) {
+  const intptr_t num_tasks =
+      Utils::Minimum<intptr_t>(FLAG_heap_snapshot_tasks, num_slices_);
+  visitor_ = visitor;
+  for (intptr_t i = 0; i < num_slices_; i++) {
+    visited_[i] = false;
+  }
+  next_slice_ = 0;
+  consumed_ = 0;
+  running_tasks_ = 0;
+  for (intptr_t i = 0; i < num_tasks; i++) {
+    {
+      MonitorLocker ml(&monitor_);
+      running_tasks_++;
+    }
+    if (!Dart::thread_pool()->Run<HeapSnapshotTask>(this)) {
+      MonitorLocker ml(&monitor_);
+      running_tasks_--;
+      break;
+    }
+  }
+
+  MonitorLocker ml(&monitor_);
+  for (intptr_t i = 0; i < num_slices_; i++) {
+    while (!visited_[i]) {
+      if ((running_tasks_ == 0) && CanClaimSlice()) {
+        // No helper threads, or they all failed to start: visit the slices
+        // on this thread.
+        const intptr_t index = next_slice_++;
+        ml.Exit();
+        visitor->VisitSlice(&slices_[index]);
+        ml.Enter();
+        visited_[index] = true;
+      } else {
+        ml.Wait();
+      }
+    }
+    ml.Exit();
+    visitor->ConsumeSlice(&slices_[i]);
+    ml.Enter();
+    consumed_ = i + 1;
+    ml.NotifyAll();
+  }
+  while (running_tasks_ > 0) {
+    ml.Wait();
+  }
+  visitor_ = nullptr;
+}
+
+void HeapSnapshotTasks::Work() {
+  if (Thread::EnterIsolateGroupAsNonMutator(isolate_group_,
+                                            Thread::kHeapSnapshotTask)) {
+    {
+      StackZone stack_zone(Thread::Current());
+      MonitorLocker ml(&monitor_);
+      while (next_slice_ < num_slices_) {
+        if (!CanClaimSlice()) {
+          ml.Wait();
+          continue;
+        }
+        const intptr_t index = next_slice_++;
+        ml.Exit();
+        visitor_->VisitSlice(&slices_[index]);
+        ml.Enter();
+        visited_[index] = true;
+        ml.NotifyAll();
+      }
+    }
+    Thread::ExitIsolateGroupAsNonMutator();
+  }
+  MonitorLocker ml(&monitor_);
+  running_tasks_--;
+  ml.NotifyAll();
+}
+
 void HeapSnapshotWriter::SetupImagePageBoundaries() {
   MallocGrowableArray<ImagePageRange> ranges(4);
 
@@ -919,18 +1138,22 @@ CountingPage* HeapSnapshotWriter::FindCountingPage(ObjectPtr obj) const {
 }
 
 void HeapSnapshotWriter::AssignObjectId(ObjectPtr obj) {
+  AssignObjectId(obj, ++object_count_);
+}
+
+void HeapSnapshotWriter::AssignObjectId(ObjectPtr obj, intptr_t id) {
   if (!obj->IsHeapObject()) {
-    thread()->heap()->SetObjectId(obj, ++object_count_);
+    thread()->heap()->SetObjectId(obj, id);
     return;
   }
 
   CountingPage* counting_page = FindCountingPage(obj);
   if (counting_page != nullptr) {
     // Likely: object on an ordinary page.
-    counting_page->Record(UntaggedObject::ToAddr(obj), ++object_count_);
+    counting_page->Record(UntaggedObject::ToAddr(obj), id);
   } else {
     // Unlikely: new space object, or object on a large or image page.
-    thread()->heap()->SetObjectId(obj, ++object_count_);
+    thread()->heap()->SetObjectId(obj, id);
   }
 }
 
@@ -977,17 +1200,26 @@ class Pass1Visitor : public ObjectVisitor,
                      public ObjectPointerVisitor,
                      public HandleVisitor {
  public:
-  explicit Pass1Visitor(HeapSnapshotWriter* writer, ObjectSlots* object_slots)
+  // If [slice] is given, the objects are on its page: their ids follow the
+  // slice's, and the references and Smis are recorded in the slice.
+  Pass1Visitor(HeapSnapshotWriter* writer,
+               ObjectSlots* object_slots,
+               HeapSnapshotSlice* slice = nullptr)
       : ObjectVisitor(),
         ObjectPointerVisitor(IsolateGroup::Current()),
         HandleVisitor(Thread::Current()),
         writer_(writer),
-        object_slots_(object_slots) {}
+        object_slots_(object_slots),
+        slice_(slice) {}
 
   void VisitObject(ObjectPtr obj) override {
     if (obj->IsPseudoObject()) return;
 
-    writer_->AssignObjectId(obj);
+    if (slice_ != nullptr) {
+      writer_->AssignObjectId(obj, slice_->next_id++);
+    } else {
+      writer_->AssignObjectId(obj);
+    }
     const auto cid = obj->GetClassId();
 
     if (object_slots_->ContainsOnlyTaggedPointers(cid)) {
@@ -999,7 +1231,7 @@ class Pass1Visitor : public ObjectVisitor,
               UntaggedObject::ToAddr(obj->untag()) + slot.offset);
           VisitCompressedPointers(obj->heap_base(), target, target);
         } else {
-          writer_->CountReferences(1);
+          CountReferences(1);
         }
       }
     }
@@ -1009,9 +1241,9 @@ class Pass1Visitor : public ObjectVisitor,
     for (ObjectPtr* ptr = from; ptr <= to; ptr++) {
       ObjectPtr obj = *ptr;
       if (!obj->IsHeapObject()) {
-        writer_->AddSmi(static_cast<SmiPtr>(obj));
+        AddSmi(static_cast<SmiPtr>(obj));
       }
-      writer_->CountReferences(1);
+      CountReferences(1);
     }
   }
 
@@ -1022,9 +1254,9 @@ class Pass1Visitor : public ObjectVisitor,
     for (CompressedObjectPtr* ptr = from; ptr <= to; ptr++) {
       ObjectPtr obj = ptr->Decompress(heap_base);
       if (!obj->IsHeapObject()) {
-        writer_->AddSmi(static_cast<SmiPtr>(obj));
+        AddSmi(static_cast<SmiPtr>(obj));
       }
-      writer_->CountReferences(1);
+      CountReferences(1);
     }
   }
 #endif
@@ -1040,8 +1272,25 @@ class Pass1Visitor : public ObjectVisitor,
   }
 
  private:
+  void CountReferences(intptr_t count) {
+    if (slice_ != nullptr) {
+      slice_->reference_count += count;
+    } else {
+      writer_->CountReferences(count);
+    }
+  }
+
+  void AddSmi(SmiPtr smi) {
+    if (slice_ != nullptr) {
+      slice_->AddSmi(smi);
+    } else {
+      writer_->AddSmi(smi);
+    }
+  }
+
   HeapSnapshotWriter* const writer_;
   ObjectSlots* object_slots_;
+  HeapSnapshotSlice* const slice_;
 
   DISALLOW_COPY_AND_ASSIGN(Pass1Visitor);
 };
@@ -1113,117 +1362,121 @@ class Pass2Visitor : public ObjectVisitor,
                      public ObjectPointerVisitor,
                      public HandleVisitor {
  public:
-  explicit Pass2Visitor(HeapSnapshotWriter* writer, ObjectSlots* object_slots)
+  // Writes to [stream] if given, otherwise to [writer].
+  Pass2Visitor(HeapSnapshotWriter* writer,
+               ObjectSlots* object_slots,
+               HeapSnapshotStream* stream = nullptr)
       : ObjectVisitor(),
         ObjectPointerVisitor(IsolateGroup::Current()),
         HandleVisitor(Thread::Current()),
         writer_(writer),
+        stream_(stream != nullptr ? stream : writer),
         object_slots_(object_slots) {}
 
   void VisitObject(ObjectPtr obj) override {
     if (obj->IsPseudoObject()) return;
 
     intptr_t cid = obj->GetClassId();
-    writer_->WriteUnsigned(cid + kNumExtraCids);
-    writer_->WriteUnsigned(discount_sizes_ ? 0 : obj->untag()->HeapSize());
+    stream_->WriteUnsigned(cid + kNumExtraCids);
+    stream_->WriteUnsigned(discount_sizes_ ? 0 : obj->untag()->HeapSize());
 
     if (cid == kNullCid) {
-      writer_->WriteUnsigned(kNullData);
+      stream_->WriteUnsigned(kNullData);
     } else if (cid == kBoolCid) {
-      writer_->WriteUnsigned(kBoolData);
-      writer_->WriteUnsigned(
+      stream_->WriteUnsigned(kBoolData);
+      stream_->WriteUnsigned(
           static_cast<uintptr_t>(static_cast<BoolPtr>(obj)->untag()->value_));
     } else if (cid == kSentinelCid) {
       if (obj == Object::sentinel().ptr()) {
-        writer_->WriteUnsigned(kNameData);
-        writer_->WriteUtf8("uninitialized");
+        stream_->WriteUnsigned(kNameData);
+        stream_->WriteUtf8("uninitialized");
       } else if (obj == Object::transition_sentinel().ptr()) {
-        writer_->WriteUnsigned(kNameData);
-        writer_->WriteUtf8("initializing");
+        stream_->WriteUnsigned(kNameData);
+        stream_->WriteUtf8("initializing");
       } else {
-        writer_->WriteUnsigned(kNoData);
+        stream_->WriteUnsigned(kNoData);
       }
     } else if (cid == kSmiCid) {
       UNREACHABLE();
     } else if (cid == kMintCid) {
-      writer_->WriteUnsigned(kIntData);
-      writer_->WriteSigned(static_cast<MintPtr>(obj)->untag()->value_);
+      stream_->WriteUnsigned(kIntData);
+      stream_->WriteSigned(static_cast<MintPtr>(obj)->untag()->value_);
     } else if (cid == kDoubleCid) {
-      writer_->WriteUnsigned(kDoubleData);
-      writer_->WriteBytes(&(static_cast<DoublePtr>(obj)->untag()->value_),
+      stream_->WriteUnsigned(kDoubleData);
+      stream_->WriteBytes(&(static_cast<DoublePtr>(obj)->untag()->value_),
                           sizeof(double));
     } else if (cid == kOneByteStringCid) {
       OneByteStringPtr str = static_cast<OneByteStringPtr>(obj);
       intptr_t len = Smi::Value(str->untag()->length());
       intptr_t trunc_len = Utils::Minimum(len, kMaxStringElements);
-      writer_->WriteUnsigned(kLatin1Data);
-      writer_->WriteUnsigned(len);
-      writer_->WriteUnsigned(trunc_len);
-      writer_->WriteBytes(&str->untag()->data()[0], trunc_len);
+      stream_->WriteUnsigned(kLatin1Data);
+      stream_->WriteUnsigned(len);
+      stream_->WriteUnsigned(trunc_len);
+      stream_->WriteBytes(&str->untag()->data()[0], trunc_len);
     } else if (cid == kTwoByteStringCid) {
       TwoByteStringPtr str = static_cast<TwoByteStringPtr>(obj);
       intptr_t len = Smi::Value(str->untag()->length());
       intptr_t trunc_len = Utils::Minimum(len, kMaxStringElements);
-      writer_->WriteUnsigned(kUTF16Data);
-      writer_->WriteUnsigned(len);
-      writer_->WriteUnsigned(trunc_len);
-      writer_->WriteBytes(&str->untag()->data()[0], trunc_len * 2);
+      stream_->WriteUnsigned(kUTF16Data);
+      stream_->WriteUnsigned(len);
+      stream_->WriteUnsigned(trunc_len);
+      stream_->WriteBytes(&str->untag()->data()[0], trunc_len * 2);
     } else if (cid == kArrayCid || cid == kImmutableArrayCid) {
-      writer_->WriteUnsigned(kLengthData);
-      writer_->WriteUnsigned(
+      stream_->WriteUnsigned(kLengthData);
+      stream_->WriteUnsigned(
           Smi::Value(static_cast<ArrayPtr>(obj)->untag()->length()));
     } else if (cid == kGrowableObjectArrayCid) {
-      writer_->WriteUnsigned(kLengthData);
-      writer_->WriteUnsigned(Smi::Value(
+      stream_->WriteUnsigned(kLengthData);
+      stream_->WriteUnsigned(Smi::Value(
           static_cast<GrowableObjectArrayPtr>(obj)->untag()->length()));
     } else if (cid == kMapCid || cid == kConstMapCid) {
-      writer_->WriteUnsigned(kLengthData);
-      writer_->WriteUnsigned(
+      stream_->WriteUnsigned(kLengthData);
+      stream_->WriteUnsigned(
           Smi::Value(static_cast<MapPtr>(obj)->untag()->used_data()));
     } else if (cid == kSetCid || cid == kConstSetCid) {
-      writer_->WriteUnsigned(kLengthData);
-      writer_->WriteUnsigned(
+      stream_->WriteUnsigned(kLengthData);
+      stream_->WriteUnsigned(
           Smi::Value(static_cast<SetPtr>(obj)->untag()->used_data()));
     } else if (cid == kObjectPoolCid) {
-      writer_->WriteUnsigned(kLengthData);
-      writer_->WriteUnsigned(static_cast<ObjectPoolPtr>(obj)->untag()->length_);
+      stream_->WriteUnsigned(kLengthData);
+      stream_->WriteUnsigned(static_cast<ObjectPoolPtr>(obj)->untag()->length_);
     } else if (IsTypedDataClassId(cid)) {
-      writer_->WriteUnsigned(kLengthData);
-      writer_->WriteUnsigned(
+      stream_->WriteUnsigned(kLengthData);
+      stream_->WriteUnsigned(
           Smi::Value(static_cast<TypedDataPtr>(obj)->untag()->length()));
     } else if (IsExternalTypedDataClassId(cid)) {
-      writer_->WriteUnsigned(kLengthData);
-      writer_->WriteUnsigned(Smi::Value(
+      stream_->WriteUnsigned(kLengthData);
+      stream_->WriteUnsigned(Smi::Value(
           static_cast<ExternalTypedDataPtr>(obj)->untag()->length()));
     } else if (cid == kFunctionCid) {
-      writer_->WriteUnsigned(kNameData);
+      stream_->WriteUnsigned(kNameData);
       ScrubAndWriteUtf8(static_cast<FunctionPtr>(obj)->untag()->name());
     } else if (cid == kCodeCid) {
       ObjectPtr owner = static_cast<CodePtr>(obj)->untag()->owner_;
       if (!owner->IsHeapObject()) {
         // Precompiler removed owner object from the snapshot,
         // only leaving Smi classId.
-        writer_->WriteUnsigned(kNoData);
+        stream_->WriteUnsigned(kNoData);
       } else if (owner->IsFunction()) {
-        writer_->WriteUnsigned(kNameData);
+        stream_->WriteUnsigned(kNameData);
         ScrubAndWriteUtf8(static_cast<FunctionPtr>(owner)->untag()->name());
       } else if (owner->IsClass()) {
-        writer_->WriteUnsigned(kNameData);
+        stream_->WriteUnsigned(kNameData);
         ScrubAndWriteUtf8(static_cast<ClassPtr>(owner)->untag()->name());
       } else {
-        writer_->WriteUnsigned(kNoData);
+        stream_->WriteUnsigned(kNoData);
       }
     } else if (cid == kFieldCid) {
-      writer_->WriteUnsigned(kNameData);
+      stream_->WriteUnsigned(kNameData);
       ScrubAndWriteUtf8(static_cast<FieldPtr>(obj)->untag()->name());
     } else if (cid == kClassCid) {
-      writer_->WriteUnsigned(kNameData);
+      stream_->WriteUnsigned(kNameData);
       ScrubAndWriteUtf8(static_cast<ClassPtr>(obj)->untag()->name());
     } else if (cid == kLibraryCid) {
-      writer_->WriteUnsigned(kNameData);
+      stream_->WriteUnsigned(kNameData);
       ScrubAndWriteUtf8(static_cast<LibraryPtr>(obj)->untag()->url());
     } else if (cid == kScriptCid) {
-      writer_->WriteUnsigned(kNameData);
+      stream_->WriteUnsigned(kNameData);
       ScrubAndWriteUtf8(static_cast<ScriptPtr>(obj)->untag()->url());
     } else if (cid == kTypeArgumentsCid) {
       // Handle scope so we do not change the root set.
@@ -1235,10 +1488,10 @@ class Pass2Visitor : public ObjectVisitor,
       TextBuffer buffer(128);
       args.PrintSubvectorName(0, args.Length(), TypeArguments::kScrubbedName,
                               &buffer);
-      writer_->WriteUnsigned(kNameData);
-      writer_->WriteUtf8(buffer.buffer());
+      stream_->WriteUnsigned(kNameData);
+      stream_->WriteUtf8(buffer.buffer());
     } else {
-      writer_->WriteUnsigned(kNoData);
+      stream_->WriteUnsigned(kNoData);
     }
 
     if (object_slots_->ContainsOnlyTaggedPointers(cid)) {
@@ -1257,7 +1510,7 @@ class Pass2Visitor : public ObjectVisitor,
               UntaggedObject::ToAddr(obj->untag()) + slot.offset);
           VisitCompressedPointers(obj->heap_base(), target, target);
         } else {
-          writer_->WriteUnsigned(0);
+          stream_->WriteUnsigned(0);
         }
         written_++;
         total_++;
@@ -1267,12 +1520,12 @@ class Pass2Visitor : public ObjectVisitor,
 
   void ScrubAndWriteUtf8(StringPtr str) {
     if (str == String::null()) {
-      writer_->WriteUtf8("null");
+      stream_->WriteUtf8("null");
     } else {
       String handle;
       handle = str;
       char* value = handle.ToMallocCString();
-      writer_->ScrubAndWriteUtf8(value);
+      stream_->ScrubAndWriteUtf8(value);
       free(value);
     }
   }
@@ -1286,7 +1539,7 @@ class Pass2Visitor : public ObjectVisitor,
   }
   void DoWrite() {
     writing_ = true;
-    writer_->WriteUnsigned(counted_);
+    stream_->WriteUnsigned(counted_);
   }
 
   void VisitPointers(ObjectPtr* from, ObjectPtr* to) override {
@@ -1295,7 +1548,7 @@ class Pass2Visitor : public ObjectVisitor,
         ObjectPtr target = *ptr;
         written_++;
         total_++;
-        writer_->WriteUnsigned(writer_->GetObjectId(target));
+        stream_->WriteUnsigned(writer_->GetObjectId(target));
       }
     } else {
       intptr_t count = to - from + 1;
@@ -1313,7 +1566,7 @@ class Pass2Visitor : public ObjectVisitor,
         ObjectPtr target = ptr->Decompress(heap_base);
         written_++;
         total_++;
-        writer_->WriteUnsigned(writer_->GetObjectId(target));
+        stream_->WriteUnsigned(writer_->GetObjectId(target));
       }
     } else {
       intptr_t count = to - from + 1;
@@ -1330,12 +1583,12 @@ class Pass2Visitor : public ObjectVisitor,
       return;  // Free handle.
     }
 
-    writer_->WriteUnsigned(writer_->GetObjectId(weak_persistent_handle->ptr()));
-    writer_->WriteUnsigned(weak_persistent_handle->external_size());
+    stream_->WriteUnsigned(writer_->GetObjectId(weak_persistent_handle->ptr()));
+    stream_->WriteUnsigned(weak_persistent_handle->external_size());
     // Attempt to include a native symbol name.
     auto const name = NativeSymbolResolver::LookupSymbolName(
         reinterpret_cast<uword>(weak_persistent_handle->callback()), nullptr);
-    writer_->WriteUtf8((name == nullptr) ? "Unknown native function" : name);
+    stream_->WriteUtf8((name == nullptr) ? "Unknown native function" : name);
     if (name != nullptr) {
       NativeSymbolResolver::FreeSymbolName(name);
     }
@@ -1348,12 +1601,13 @@ class Pass2Visitor : public ObjectVisitor,
   void WriteExtraRef(intptr_t oid) {
     ASSERT(writing_);
     written_++;
-    writer_->WriteUnsigned(oid);
+    stream_->WriteUnsigned(oid);
   }
 
  private:
   IsolateGroup* isolate_group_;
   HeapSnapshotWriter* const writer_;
+  HeapSnapshotStream* const stream_;
   ObjectSlots* object_slots_;
   bool writing_ = false;
   intptr_t counted_ = 0;
@@ -1366,20 +1620,20 @@ class Pass2Visitor : public ObjectVisitor,
 
 class Pass3Visitor : public ObjectVisitor {
  public:
-  explicit Pass3Visitor(HeapSnapshotWriter* writer)
-      : ObjectVisitor(), thread_(Thread::Current()), writer_(writer) {}
+  explicit Pass3Visitor(HeapSnapshotStream* stream)
+      : ObjectVisitor(), thread_(Thread::Current()), stream_(stream) {}
 
   void VisitObject(ObjectPtr obj) override {
     if (obj->IsPseudoObject()) {
       return;
     }
-    writer_->WriteUnsigned(
+    stream_->WriteUnsigned(
         HeapSnapshotWriter::GetHeapSnapshotIdentityHash(thread_, obj));
   }
 
  private:
   Thread* thread_;
-  HeapSnapshotWriter* const writer_;
+  HeapSnapshotStream* const stream_;
 
   DISALLOW_COPY_AND_ASSIGN(Pass3Visitor);
 };
@@ -1486,6 +1740,105 @@ void CallbackHeapSnapshotWriter::WriteChunk(uint8_t* buffer,
   callback_(context_, buffer, size, last);
 }
 
+// Counts the objects of each page, and gives them consecutive ids in page
+// order.
+class CountSliceVisitor : public HeapSnapshotSliceVisitor {
+ public:
+  explicit CountSliceVisitor(intptr_t* object_count)
+      : object_count_(object_count) {}
+
+  void VisitSlice(HeapSnapshotSlice* slice) override {
+    CountImagePageRefs counter;
+    slice->page->VisitObjectsUnsafe(&counter);
+    slice->object_count = counter.count();
+  }
+
+  void ConsumeSlice(HeapSnapshotSlice* slice) override {
+    slice->next_id = *object_count_ + 1;
+    *object_count_ += slice->object_count;
+  }
+
+ private:
+  intptr_t* const object_count_;
+
+  DISALLOW_COPY_AND_ASSIGN(CountSliceVisitor);
+};
+
+class Pass1SliceVisitor : public HeapSnapshotSliceVisitor {
+ public:
+  Pass1SliceVisitor(HeapSnapshotWriter* writer, ObjectSlots* object_slots)
+      : writer_(writer), object_slots_(object_slots) {}
+
+  void VisitSlice(HeapSnapshotSlice* slice) override {
+    Pass1Visitor page_visitor(writer_, object_slots_, slice);
+    slice->page->VisitObjectsUnsafe(&page_visitor);
+  }
+
+  void ConsumeSlice(HeapSnapshotSlice* slice) override {
+    writer_->CountReferences(slice->reference_count);
+    for (SmiPtr smi : slice->smis) {
+      writer_->AddSmi(smi);
+    }
+    slice->smis.Clear();
+  }
+
+ private:
+  HeapSnapshotWriter* const writer_;
+  ObjectSlots* const object_slots_;
+
+  DISALLOW_COPY_AND_ASSIGN(Pass1SliceVisitor);
+};
+
+class Pass2SliceVisitor : public HeapSnapshotSliceVisitor {
+ public:
+  Pass2SliceVisitor(HeapSnapshotWriter* writer, ObjectSlots* object_slots)
+      : writer_(writer), object_slots_(object_slots) {}
+
+  void VisitSlice(HeapSnapshotSlice* slice) override {
+    Pass2Visitor page_visitor(writer_, object_slots_, &slice->stream);
+    slice->page->VisitObjectsUnsafe(&page_visitor);
+  }
+
+  void ConsumeSlice(HeapSnapshotSlice* slice) override {
+    slice->stream.AppendTo(writer_);
+  }
+
+ private:
+  HeapSnapshotWriter* const writer_;
+  ObjectSlots* const object_slots_;
+
+  DISALLOW_COPY_AND_ASSIGN(Pass2SliceVisitor);
+};
+
+class Pass3SliceVisitor : public HeapSnapshotSliceVisitor {
+ public:
+  explicit Pass3SliceVisitor(HeapSnapshotWriter* writer) : writer_(writer) {}
+
+  void VisitSlice(HeapSnapshotSlice* slice) override {
+    Pass3Visitor page_visitor(&slice->stream);
+    slice->page->VisitObjectsUnsafe(&page_visitor);
+  }
+
+  void ConsumeSlice(HeapSnapshotSlice* slice) override {
+    slice->stream.AppendTo(writer_);
+  }
+
+ private:
+  HeapSnapshotWriter* const writer_;
+
+  DISALLOW_COPY_AND_ASSIGN(Pass3SliceVisitor);
+};
+
+void HeapSnapshotWriter::AssignPageObjectIds(HeapSnapshotTasks* tasks,
+                                             ObjectSlots* object_slots) {
+  // Count the objects of each page first, so that the ids of a page's objects
+  // are known before they are visited.
+  CountSliceVisitor counter(&object_count_);
+  tasks->Run(&counter);
+  Pass1SliceVisitor pass1(this, object_slots);
+  tasks->Run(&pass1);
+}
+
 void HeapSnapshotWriter::Write() {
   HeapIterationScope iteration(thread());
 
@@ -1612,6 +1965,15 @@ void HeapSnapshotWriter::Write() {
   SetupImagePageBoundaries();
   SetupCountingPages();
 
+  MallocGrowableArray<Page*> pages;
+  iteration.CollectPages(&pages);
+  std::unique_ptr<HeapSnapshotSlice[]> slices(
+      new HeapSnapshotSlice[pages.length()]);
+  for (intptr_t i = 0; i < pages.length(); i++) {
+    slices[i].page = pages[i];
+  }
+  HeapSnapshotTasks tasks(isolate_group(), slices.get(), pages.length());
+
   intptr_t num_isolates = 0;
   intptr_t num_image_objects = 0;
   {
@@ -1646,7 +2008,7 @@ void HeapSnapshotWriter::Write() {
 
     // Heap objects.
     iteration.IterateVMIsolateObjects(&visitor);
-    iteration.IterateObjects(&visitor);
+    AssignPageObjectIds(&tasks, &object_slots);
 
     // External properties.
     isolate()->group()->VisitWeakPersistentHandles(&visitor);
@@ -1712,7 +2074,8 @@ void HeapSnapshotWriter::Write() {
     visitor.set_discount_sizes(true);
     iteration.IterateVMIsolateObjects(&visitor);
     visitor.set_discount_sizes(false);
-    iteration.IterateObjects(&visitor);
+    Pass2SliceVisitor pass2(this, &object_slots);
+    tasks.Run(&pass2);
 
     // Smis.
     for (SmiPtr smi : smis_) {
@@ -1742,7 +2105,8 @@ void HeapSnapshotWriter::Write() {
 
     // Handle visit rest of the objects.
     iteration.IterateVMIsolateObjects(&visitor);
-    iteration.IterateObjects(&visitor);
+    Pass3SliceVisitor pass3(this);
+    tasks.Run(&pass3);
     for (SmiPtr smi : smis_) {
       USE(smi);
       WriteUnsigned(0);  // No identity hash.
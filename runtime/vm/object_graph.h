@@ -167,13 +167,12 @@ class VmServiceHeapSnapshotChunkedWriter : public ChunkedWriter {
   static constexpr intptr_t kMetadataReservation = 512;
 };
 
-// Generates a dump of the heap, whose format is described in
-// runtime/vm/service/heap_snapshot.md.
-class HeapSnapshotWriter : public ThreadStackResource {
+// Encodes the values of a heap snapshot and passes them on in chunks.
+class HeapSnapshotStream {
  public:
-  HeapSnapshotWriter(Thread* thread, ChunkedWriter* writer)
-      : ThreadStackResource(thread), writer_(writer) {}
-  ~HeapSnapshotWriter() { free(image_page_ranges_); }
+  explicit HeapSnapshotStream(intptr_t reserved_prefix)
+      : reserved_prefix_(reserved_prefix) {}
+  virtual ~HeapSnapshotStream() { free(buffer_); }
 
   void WriteSigned(int64_t value) {
     EnsureAvailable((sizeof(value) * kBitsPerByte) / 7 + 1);
@@ -230,7 +229,45 @@ class HeapSnapshotWriter : public ThreadStackResource {
     WriteBytes(value, len);
   }
 
+  void Flush(bool last = false);
+
+ protected:
+  // Takes ownership of [buffer], must be freed with [free].
+  virtual void WriteChunk(uint8_t* buffer, intptr_t size, bool last) = 0;
+
+ private:
+  static constexpr intptr_t kPreferredChunkSize = MB;
+
+  void EnsureAvailable(intptr_t needed);
+
+  const intptr_t reserved_prefix_;
+  uint8_t* buffer_ = nullptr;
+  intptr_t size_ = 0;
+  intptr_t capacity_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(HeapSnapshotStream);
+};
+
+class HeapSnapshotTasks;
+class ObjectSlots;
+
+// Generates a dump of the heap, whose format is described in
+// runtime/vm/service/heap_snapshot.md.
+//
+// The heap's pages are visited on FLAG_heap_snapshot_tasks helper threads.
+// Their output is passed on in page order, so the snapshot is the same as
+// with a single thread except for newly assigned identity hashes.
+class HeapSnapshotWriter : public ThreadStackResource,
+                           public HeapSnapshotStream {
+ public:
+  HeapSnapshotWriter(Thread* thread, ChunkedWriter* writer)
+      : ThreadStackResource(thread),
+        HeapSnapshotStream(writer->ReserveChunkPrefixSize()),
+        writer_(writer) {}
+  ~HeapSnapshotWriter() { free(image_page_ranges_); }
+
   void AssignObjectId(ObjectPtr obj);
+  void AssignObjectId(ObjectPtr obj, intptr_t id);
   intptr_t GetObjectId(ObjectPtr obj) const;
   void ClearObjectIds();
   void CountReferences(intptr_t count);
@@ -244,22 +281,21 @@ class HeapSnapshotWriter : public ThreadStackResource {
  private:
   static uint32_t GetHashHelper(Thread* thread, ObjectPtr obj);
 
-  static constexpr intptr_t kPreferredChunkSize = MB;
+  void WriteChunk(uint8_t* buffer, intptr_t size, bool last) override {
+    writer_->WriteChunk(buffer, size, last);
+  }
 
   void SetupImagePageBoundaries();
   void SetupCountingPages();
   bool OnImagePage(ObjectPtr obj) const;
   CountingPage* FindCountingPage(ObjectPtr obj) const;
 
-  void EnsureAvailable(intptr_t needed);
-  void Flush(bool last = false);
+  // Assigns ids to the objects of the heap's pages, counts their references
+  // and collects the Smis they refer to.
+  void AssignPageObjectIds(HeapSnapshotTasks* tasks, ObjectSlots* object_slots);
 
   ChunkedWriter* writer_ = nullptr;
 
-  uint8_t* buffer_ = nullptr;
-  intptr_t size_ = 0;
-  intptr_t capacity_ = 0;
-
   intptr_t class_count_ = 0;
   intptr_t object_count_ = 0;
   intptr_t reference_count_ = 0;
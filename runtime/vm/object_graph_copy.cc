@@ -103,6 +103,7 @@ DEFINE_FLAG(bool,
             "Cause a GC when falling off the fast path for fast object copy.");
 
 const char* kFastAllocationFailed = "fast allocation failed";
+const char* kFastSafepointRequested = "fast copy interrupted by safepoint";
 
 struct PtrTypes {
   using Object = ObjectPtr;
@@ -181,6 +182,92 @@ bool CanShareObjectAcrossIsolates(ObjectPtr obj) {
   return CanShareObject(obj, tags);
 }
 
+// Unmodifiable lists and records are immutable but not deeply immutable.
+// Once their contents are found to be shareable we set their immutability bit,
+// after which they are shared like any other deeply immutable object.
+DART_FORCE_INLINE
+static bool CanMarkDeeplyImmutable(uword tags) {
+  const auto cid = UntaggedObject::ClassIdTag::decode(tags);
+  return cid == kImmutableArrayCid || cid == kRecordCid;
+}
+
+class DeeplyImmutableVisitor : public ObjectPointerVisitor {
+ public:
+  DeeplyImmutableVisitor(IsolateGroup* isolate_group,
+                         GrowableArray<ObjectPtr>* pending)
+      : ObjectPointerVisitor(isolate_group), pending_(pending) {}
+
+  bool failed() const { return failed_; }
+
+  void VisitPointers(ObjectPtr* from, ObjectPtr* to) override {
+    for (ObjectPtr* ptr = from; ptr <= to; ptr++) {
+      VisitObject(*ptr);
+    }
+  }
+
+#if defined(DART_COMPRESSED_POINTERS)
+  void VisitCompressedPointers(uword heap_base,
+                               CompressedObjectPtr* from,
+                               CompressedObjectPtr* to) override {
+    for (CompressedObjectPtr* ptr = from; ptr <= to; ptr++) {
+      VisitObject(ptr->Decompress(heap_base));
+    }
+  }
+#endif
+
+ private:
+  void VisitObject(ObjectPtr obj) {
+    if (failed_ || !obj->IsHeapObject()) return;
+    const uword tags = TagsFromUntaggedObject(obj.untag());
+    if (CanShareObject(obj, tags)) return;
+    if (!CanMarkDeeplyImmutable(tags)) {
+      failed_ = true;
+      return;
+    }
+    pending_->Add(obj);
+  }
+
+  GrowableArray<ObjectPtr>* const pending_;
+  bool failed_ = false;
+};
+
+// Marks [root] and the unmodifiable lists and records it reaches as deeply
+// immutable if all other objects in the graph can be shared. Lists and
+// records whose contents turn out to be shareable keep the bit even if the
+// rest of the graph does not. Returns whether [root] can be shared.
+static bool TryMarkDeeplyImmutable(Thread* thread, ObjectPtr root) {
+  constexpr intptr_t kMaxPending = 1 * MB;
+  const uword tags = TagsFromUntaggedObject(root.untag());
+  if (CanShareObject(root, tags)) return true;
+  if (!CanMarkDeeplyImmutable(tags)) return false;
+
+  NoSafepointScope no_safepoint_scope;
+  // The bit is set in post-order: an object is pushed a second time, below a
+  // null separator, when its children are pushed.
+  GrowableArray<ObjectPtr> pending(thread->zone(), 16);
+  DeeplyImmutableVisitor visitor(thread->isolate_group(), &pending);
+  pending.Add(root);
+  while (!pending.is_empty()) {
+    ObjectPtr obj = pending.RemoveLast();
+    if (obj == Object::null()) {
+      obj = pending.RemoveLast();
+      obj->untag()->SetImmutable();
+      continue;
+    }
+    if (obj->untag()->IsImmutable()) continue;  // Reached more than once.
+    // Lists made unmodifiable in place could in principle reach themselves,
+    // which would otherwise keep us going forever.
+    if (thread->IsSafepointRequested() || pending.length() > kMaxPending) {
+      return false;
+    }
+    pending.Add(obj);
+    pending.Add(Object::null());
+    obj->untag()->VisitPointers(&visitor);
+    if (visitor.failed()) return false;
+  }
+  return true;
+}
+
 // Whether executing `get:hashCode` (possibly in a different isolate) on an
 // object with the given [tags] might return a different answer than the source
 // object (if copying is needed) or on the same object (if the object is
@@ -244,6 +331,24 @@ void SetNewSpaceTaggingWord(ObjectPtr to, classid_t cid, uint32_t size) {
   to.untag()->tags_ = tags;
 }
 
+DART_FORCE_INLINE
+void SetOldSpaceTaggingWord(ObjectPtr to, classid_t cid, uint32_t size) {
+  uword tags = 0;
+
+  tags = UntaggedObject::SizeTag::update(size, tags);
+  tags = UntaggedObject::ClassIdTag::update(cid, tags);
+  tags = UntaggedObject::AlwaysSetBit::update(true, tags);
+  tags = UntaggedObject::NotMarkedBit::update(true, tags);
+  tags = UntaggedObject::OldAndNotRememberedBit::update(true, tags);
+  tags = UntaggedObject::CanonicalBit::update(false, tags);
+  tags = UntaggedObject::NewBit::update(false, tags);
+  tags = UntaggedObject::ImmutableBit::update(false, tags);
+#if defined(HASH_IN_OBJECT_HEADER)
+  tags = UntaggedObject::HashTag::update(0, tags);
+#endif
+  to.untag()->tags_ = tags;
+}
+
 DART_FORCE_INLINE
 ObjectPtr AllocateObject(intptr_t cid,
                          intptr_t size,
@@ -1410,11 +1515,39 @@ class FastObjectCopyBase : public ObjectCopyBase {
         }
         return to;
       }
+    } else if (IsTypedDataClassId(cid)) {
+      return ForwardLargeTypedData(cid, from, size);
     }
     exception_msg_ = kFastAllocationFailed;
     return Marker();
   }
 
+  // Internal typed data holds no pointers, so a copy too large for new space
+  // can be made in old space without bailing out to the slow path: the fast
+  // path never stores into it without barriers. The copy is GC-safe right
+  // away, only its payload is filled later.
+  ObjectPtr ForwardLargeTypedData(intptr_t cid, ObjectPtr from, uword size) {
+    PageSpace* old_space = thread_->heap()->old_space();
+    const uword alloc = old_space->TryAllocate(size);
+    if (alloc == 0) {
+      exception_msg_ = kFastAllocationFailed;
+      return Marker();
+    }
+    TypedDataPtr to(reinterpret_cast<UntaggedTypedData*>(alloc));
+    const uword header_size =
+        UntaggedObject::SizeTag::SizeFits(size) ? size : 0;
+    SetOldSpaceTaggingWord(to, cid, header_size);
+    UpdateLengthField(cid, from, to);
+    to.untag()->RecomputeDataField();
+    if (UNLIKELY(thread_->is_marking())) {
+      // Black allocation, as in Object::Allocate.
+      to.untag()->SetMarkBitRelease();
+      old_space->AllocateBlack(size);
+    }
+    fast_forward_map_.Insert(from, to, size);
+    return to;
+  }
+
   void EnqueueTransferable(TransferableTypedDataPtr from,
                            TransferableTypedDataPtr to) {
     fast_forward_map_.AddTransferable(from, to);
@@ -2129,6 +2262,15 @@ class FastObjectCopy : public ObjectCopy<FastObjectCopyBase> {
     if (root_copy == Marker()) {
       return root_copy;
     }
+    return ContinueCopyGraphFast(root_copy);
+  }
+
+  // Fills the objects that are still pending in the forwarding list, e.g.
+  // after the copy was interrupted by a safepoint request.
+  ObjectPtr ContinueCopyGraphFast(ObjectPtr root_copy) {
+    NoSafepointScope no_safepoint_scope;
+
+    exception_msg_ = nullptr;
     auto& from_weak_property = WeakProperty::Handle(zone_);
     auto& to_weak_property = WeakProperty::Handle(zone_);
     auto& weak_property_key = Object::Handle(zone_);
@@ -2151,9 +2293,9 @@ class FastObjectCopy : public ObjectCopy<FastObjectCopyBase> {
         fast_forward_map_.fill_cursor_ += 2;
 
         // To maintain responsiveness we regularly check whether safepoints are
-        // requested - if so, we bail to slow path which will then checkin.
+        // requested - if so, we bail out so the caller can check in.
         if (thread_->IsSafepointRequested()) {
-          exception_msg_ = kFastAllocationFailed;
+          exception_msg_ = kFastSafepointRequested;
           return root_copy;
         }
       }
@@ -2260,14 +2402,19 @@ class FastObjectCopy : public ObjectCopy<FastObjectCopyBase> {
     const intptr_t cid = UntaggedObject::ClassIdTag::decode(tags);
     const intptr_t size = UntaggedObject::SizeTag::decode(tags);
 
-    // Ensure the last word is GC-safe (our heap objects are 2-word aligned, the
-    // object header stores the size in multiples of kObjectAlignment, the GC
-    // uses the information from the header and therefore might visit one slot
-    // more than the actual size of the instance).
-    *reinterpret_cast<ObjectPtr*>(UntaggedObject::ToAddr(to) +
-                                  from.untag()->HeapSize() - kWordSize) =
-        nullptr;
-    SetNewSpaceTaggingWord(to, cid, size);
+    if (LIKELY(to->IsNewObject())) {
+      // Ensure the last word is GC-safe (our heap objects are 2-word aligned,
+      // the object header stores the size in multiples of kObjectAlignment, the
+      // GC uses the information from the header and therefore might visit one
+      // slot more than the actual size of the instance).
+      *reinterpret_cast<ObjectPtr*>(UntaggedObject::ToAddr(to) +
+                                    from.untag()->HeapSize() - kWordSize) =
+          nullptr;
+      SetNewSpaceTaggingWord(to, cid, size);
+    } else {
+      // See [ForwardLargeTypedData].
+      ASSERT(IsTypedDataClassId(cid));
+    }
 
     // Fall back to virtual variant for predefined classes
     if (cid < kNumPredefinedCids && cid != kInstanceCid) {
@@ -2493,7 +2640,7 @@ class ObjectGraphCopier : public StackResource {
       return result_array.ptr();
     }
     const uword tags = TagsFromUntaggedObject(root.ptr().untag());
-    if (CanShareObject(root.ptr(), tags)) {
+    if (TryMarkDeeplyImmutable(thread_, root.ptr())) {
       result_array.SetAt(0, root);
       return result_array.ptr();
     }
@@ -2513,9 +2660,27 @@ class ObjectGraphCopier : public StackResource {
     if (FLAG_enable_fast_object_copy) {
       {
         NoSafepointScope no_safepoint_scope;
-
         result = fast_object_copy_.TryCopyGraphFast(root.ptr());
-        if (result.ptr() != Marker()) {
+      }
+
+      // A copy that was only interrupted by a safepoint request continues on
+      // the fast path once we checked in, which keeps large messages from
+      // spending most of their time on the slow path.
+      bool switched_to_slow = false;
+      while (result.ptr() != Marker() &&
+             fast_object_copy_.exception_msg_ == kFastSafepointRequested) {
+        if (!CheckInForSafepoint()) {
+          switched_to_slow = true;
+          break;
+        }
+        NoSafepointScope no_safepoint_scope;
+        result = fast_object_copy_.ContinueCopyGraphFast(result.ptr());
+      }
+
+      {
+        NoSafepointScope no_safepoint_scope;
+
+        if (result.ptr() != Marker() && !switched_to_slow) {
           if (fast_object_copy_.exception_msg_ == nullptr) {
             result_array.SetAt(0, result);
             fast_object_copy_.tmp_ = fast_object_copy_.raw_objects_to_rehash_;
@@ -2580,11 +2745,64 @@ class ObjectGraphCopier : public StackResource {
     return result_array.ptr();
   }
 
+  // Checks into the safepoint that interrupted the fast copy, with the fast
+  // forwarding list temporarily held in handles. Returns whether the fast copy
+  // can continue, which is not the case once the GC promoted an object that is
+  // yet to be filled, as the fast path fills objects without barriers. The
+  // copy then stays on the slow forwarding list.
+  bool CheckInForSafepoint() {
+    bool can_resume;
+    {
+      HandleScope handle_scope(thread_);
+      MakeUninitializedNewSpaceObjectsGCSafe();
+      HandlifyFastForwardingList();
+      thread_->CheckForSafepoint();
+
+      NoSafepointScope no_safepoint_scope;
+      RawifySlowForwardingList();
+      can_resume = CanResumeFastCopy();
+    }
+    NoSafepointScope no_safepoint_scope;
+    if (can_resume) {
+      fast_object_copy_.exception_msg_ = nullptr;
+      return true;
+    }
+    // The handles above did not survive their scope. The pending objects were
+    // already made GC-safe and may now live in old space.
+    HandlifyFastForwardingList();
+    fast_object_copy_.exception_msg_ = kFastAllocationFailed;
+    return false;
+  }
+
+  bool CanResumeFastCopy() {
+    auto& fast_forward_map = fast_object_copy_.fast_forward_map_;
+    const intptr_t length = fast_forward_map.raw_from_to_.length();
+    for (intptr_t i = fast_forward_map.fill_cursor_ + 1; i < length; i += 2) {
+      ObjectPtr to = fast_forward_map.raw_from_to_[i];
+      if (!to->IsNewObject() && !IsTypedDataClassId(to->GetClassId())) {
+        return false;
+      }
+    }
+    // The values of weak properties are forwarded without barriers when their
+    // keys become reachable.
+    for (WeakPropertyPtr weak_property :
+         fast_forward_map.raw_weak_properties_) {
+      if (!fast_forward_map.ForwardedObject(weak_property)->IsNewObject()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
   void SwitchToSlowForwardingList() {
+    MakeUninitializedNewSpaceObjectsGCSafe();
+    HandlifyFastForwardingList();
+  }
+
+  void HandlifyFastForwardingList() {
     auto& fast_forward_map = fast_object_copy_.fast_forward_map_;
     auto& slow_forward_map = slow_object_copy_.slow_forward_map_;
 
-    MakeUninitializedNewSpaceObjectsGCSafe();
     HandlifyTransferables();
     HandlifyWeakProperties();
     HandlifyWeakReferences();
@@ -2605,9 +2823,10 @@ class ObjectGraphCopier : public StackResource {
       auto to = fast_forward_map.raw_from_to_[i + 1];
       const uword tags = TagsFromUntaggedObject(from.untag());
       const intptr_t cid = UntaggedObject::ClassIdTag::decode(tags);
-      // External typed data is already initialized.
+      // External typed data, views and typed data copied into old space are
+      // already initialized.
       if (!IsExternalTypedDataClassId(cid) && !IsTypedDataViewClassId(cid) &&
-          !IsUnmodifiableTypedDataViewClassId(cid)) {
+          !IsUnmodifiableTypedDataViewClassId(cid) && to->IsNewObject()) {
 #if defined(DART_COMPRESSED_POINTERS)
         const bool compressed = true;
 #else
@@ -2639,6 +2858,27 @@ class ObjectGraphCopier : public StackResource {
       }
     }
   }
+  // The inverse of [HandlifyFastForwardingList].
+  void RawifySlowForwardingList() {
+    auto& fast_forward_map = fast_object_copy_.fast_forward_map_;
+    auto& slow_forward_map = slow_object_copy_.slow_forward_map_;
+
+    Rawify(&slow_forward_map.transferables_from_to_,
+           &fast_forward_map.raw_transferables_from_to_);
+    Rawify(&slow_forward_map.weak_properties_,
+           &fast_forward_map.raw_weak_properties_);
+    Rawify(&slow_forward_map.weak_references_,
+           &fast_forward_map.raw_weak_references_);
+    Rawify(&slow_forward_map.external_typed_data_,
+           &fast_forward_map.raw_external_typed_data_to_);
+    Rawify(&slow_forward_map.objects_to_rehash_,
+           &fast_forward_map.raw_objects_to_rehash_);
+    Rawify(&slow_forward_map.expandos_to_rehash_,
+           &fast_forward_map.raw_expandos_to_rehash_);
+    Rawify(&slow_forward_map.from_to_transition_,
+           &fast_forward_map.raw_from_to_);
+  }
+
   void HandlifyTransferables() {
     Handlify(&fast_object_copy_.fast_forward_map_.raw_transferables_from_to_,
              &slow_object_copy_.slow_forward_map_.transferables_from_to_);
@@ -2675,6 +2915,16 @@ class ObjectGraphCopier : public StackResource {
       from->Clear();
     }
   }
+  template <typename HandleType, typename PtrType>
+  void Rawify(GrowableArray<const HandleType*>* from,
+              GrowableArray<PtrType>* to) {
+    const auto length = from->length();
+    to->Resize(length);
+    for (intptr_t i = 0; i < length; i++) {
+      (*to)[i] = static_cast<PtrType>((*from)[i]->ptr());
+    }
+    from->Clear();
+  }
   void HandlifyFromToObjects() {
     auto& fast_forward_map = fast_object_copy_.fast_forward_map_;
     auto& slow_forward_map = slow_object_copy_.slow_forward_map_;
@@ -0,0 +1,64 @@
+// Copyright (c) 2024, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/object_graph_copy.h"
+#include "platform/assert.h"
+#include "vm/object.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+static ObjectPtr CopiedMessage(const Object& root) {
+  const auto& result =
+      Array::Handle(Array::RawCast(CopyMutableObjectGraph(root)));
+  return result.At(0);
+}
+
+ISOLATE_UNIT_TEST_CASE(ObjectGraphCopy_SharesImmutableListsAndRecords) {
+  const auto& record = Record::Handle(Record::New(RecordShape::ForUnnamed(2)));
+  record.SetFieldAt(0, Smi::Handle(Smi::New(42)));
+  record.SetFieldAt(1, String::Handle(String::New("a")));
+  const auto& list = Array::Handle(ImmutableArray::New(2));
+  list.SetAt(0, String::Handle(String::New("b")));
+  list.SetAt(1, record);
+  EXPECT(!CanShareObjectAcrossIsolates(list.ptr()));
+
+  // Sent by reference, and from then on shareable.
+  EXPECT_EQ(list.ptr(), CopiedMessage(list));
+  EXPECT(CanShareObjectAcrossIsolates(list.ptr()));
+  EXPECT(CanShareObjectAcrossIsolates(record.ptr()));
+}
+
+ISOLATE_UNIT_TEST_CASE(ObjectGraphCopy_CopiesListsReachingMutableObjects) {
+  const auto& inner = Array::Handle(ImmutableArray::New(1));
+  inner.SetAt(0, String::Handle(String::New("a")));
+  const auto& list = Array::Handle(ImmutableArray::New(2));
+  list.SetAt(0, inner);
+  list.SetAt(1, Array::Handle(Array::New(1)));
+
+  EXPECT_NE(list.ptr(), CopiedMessage(list));
+  EXPECT(!CanShareObjectAcrossIsolates(list.ptr()));
+}
+
+ISOLATE_UNIT_TEST_CASE(ObjectGraphCopy_LargeTypedData) {
+  const intptr_t kLength = 4 * kNewAllocatableSize;
+  const auto& data = TypedData::Handle(
+      TypedData::New(kTypedDataUint8ArrayCid, kLength, Heap::kOld));
+  for (intptr_t i = 0; i < kLength; i++) {
+    data.SetUint8(i, static_cast<uint8_t>(i));
+  }
+  const auto& list = Array::Handle(Array::New(2));
+  list.SetAt(0, data);
+  list.SetAt(1, Array::Handle(Array::New(1)));
+
+  const auto& copy = Array::Handle(Array::RawCast(CopiedMessage(list)));
+  const auto& data_copy = TypedData::Handle(TypedData::RawCast(copy.At(0)));
+  EXPECT_NE(data.ptr(), data_copy.ptr());
+  EXPECT(data_copy.ptr()->IsOldObject());
+  EXPECT_EQ(kLength, data_copy.Length());
+  EXPECT_EQ(0, memcmp(data.DataAddr(0), data_copy.DataAddr(0), kLength));
+  EXPECT(copy.At(1) != list.At(1));
+}
+
+}  // namespace dart
@@ -10,6 +10,8 @@ namespace dart {
 
 #if !defined(PRODUCT)
 
+DECLARE_FLAG(int, heap_snapshot_tasks);
+
 class CounterVisitor : public ObjectGraph::Visitor {
  public:
   // Records the number of objects and total size visited, excluding 'skip'
@@ -190,6 +192,56 @@ ISOLATE_UNIT_TEST_CASE(RetainingPathGCRoot) {
   EXPECT_STREQ(result.gc_root_type, "local handle");
 }
 
+class CollectingHeapSnapshotWriter : public ChunkedWriter {
+ public:
+  explicit CollectingHeapSnapshotWriter(Thread* thread)
+      : ChunkedWriter(thread) {}
+
+  virtual void WriteChunk(uint8_t* buffer, intptr_t size, bool last) {
+    for (intptr_t i = 0; i < size; i++) {
+      bytes_.Add(buffer[i]);
+    }
+    free(buffer);
+  }
+
+  const MallocGrowableArray<uint8_t>& bytes() const { return bytes_; }
+
+ private:
+  MallocGrowableArray<uint8_t> bytes_;
+};
+
+ISOLATE_UNIT_TEST_CASE(HeapSnapshotWriter_Parallel) {
+  // Some objects in new space and on several old-space pages.
+  const intptr_t kLength = 100;
+  const Array& array = Array::Handle(Array::New(kLength, Heap::kOld));
+  for (intptr_t i = 0; i < kLength; i++) {
+    array.SetAt(i, Array::Handle(Array::New(1000, Heap::kOld)));
+  }
+  const Array& young = Array::Handle(Array::New(10, Heap::kNew));
+  young.SetAt(0, array);
+
+  const intptr_t saved_tasks = FLAG_heap_snapshot_tasks;
+  // The serial snapshot assigns identity hashes, which the parallel one
+  // then reuses.
+  FLAG_heap_snapshot_tasks = 0;
+  CollectingHeapSnapshotWriter serial(thread);
+  {
+    HeapSnapshotWriter writer(thread, &serial);
+    writer.Write();
+  }
+  FLAG_heap_snapshot_tasks = 4;
+  CollectingHeapSnapshotWriter parallel(thread);
+  {
+    HeapSnapshotWriter writer(thread, &parallel);
+    writer.Write();
+  }
+  FLAG_heap_snapshot_tasks = saved_tasks;
+
+  EXPECT_EQ(serial.bytes().length(), parallel.bytes().length());
+  EXPECT(memcmp(serial.bytes().data(), parallel.bytes().data(),
+                serial.bytes().length()) == 0);
+}
+
 #endif  // !defined(PRODUCT)
 
 }  // namespace dart
@@ -10,6 +10,7 @@
 #include "vm/object_graph.h"
 #include "vm/object_store.h"
 #include "vm/resolver.h"
+#include "vm/runtime_entry.h"
 #include "vm/stub_code.h"
 #include "vm/symbols.h"
 
@@ -976,6 +977,18 @@ void CallSiteData::PrintImplementationFieldsImpl(
   UNREACHABLE();
 }
 
+static void AddDeoptReasons(JSONObject* jsobj,
+                            const char* name,
+                            uint32_t reasons) {
+  JSONArray jsarr(jsobj, name);
+  for (intptr_t i = 0; i <= ICData::kLastRecordedDeoptReason; i++) {
+    if ((reasons & (1 << i)) != 0) {
+      jsarr.AddValue(
+          DeoptReasonToCString(static_cast<ICData::DeoptReasonId>(i)));
+    }
+  }
+}
+
 void ICData::PrintJSONImpl(JSONStream* stream, bool ref) const {
   JSONObject jsobj(stream);
   AddCommonObjectProperties(&jsobj, "Object", ref);
@@ -988,6 +1001,7 @@ void ICData::PrintJSONImpl(JSONStream* stream, bool ref) const {
   jsobj.AddProperty("_argumentsDescriptor",
                     Object::Handle(arguments_descriptor()));
   jsobj.AddProperty("_entries", Object::Handle(entries()));
+  AddDeoptReasons(&jsobj, "_deoptReasons", DeoptReasons());
 }
 
 void ICData::PrintToJSONArray(const JSONArray& jsarray,
@@ -999,8 +1013,9 @@ void ICData::PrintToJSONArray(const JSONArray& jsarray,
   JSONObject jsobj(&jsarray);
   jsobj.AddProperty("name", String::Handle(target_name()).ToCString());
   jsobj.AddProperty("tokenPos", static_cast<intptr_t>(token_pos.Serialize()));
-  // TODO(rmacnak): Figure out how to stringify DeoptReasons().
-  // jsobj.AddProperty("deoptReasons", ...);
+  if (HasDeoptReasons()) {
+    AddDeoptReasons(&jsobj, "deoptReasons", DeoptReasons());
+  }
 
   JSONArray cache_entries(&jsobj, "cacheEntries");
   for (intptr_t i = 0; i < NumberOfChecks(); i++) {
@@ -1965,27 +1980,23 @@ void RegExp::PrintJSONImpl(JSONStream* stream, bool ref) const {
   jsobj.AddProperty("isCaseSensitive", !flags().IgnoreCase());
   jsobj.AddProperty("isMultiLine", flags().IsMultiLine());
 
-  if (!FLAG_interpret_irregexp) {
-    Function& func = Function::Handle();
-    func = function(kOneByteStringCid, /*sticky=*/false);
-    jsobj.AddProperty("_oneByteFunction", func);
-    func = function(kTwoByteStringCid, /*sticky=*/false);
-    jsobj.AddProperty("_twoByteFunction", func);
-    func = function(kOneByteStringCid, /*sticky=*/true);
-    jsobj.AddProperty("_oneByteFunctionSticky", func);
-    func = function(kTwoByteStringCid, /*sticky=*/true);
-    jsobj.AddProperty("_twoByteFunctionSticky", func);
-  } else {
-    TypedData& bc = TypedData::Handle();
-    bc = bytecode(/*is_one_byte=*/true, /*sticky=*/false);
-    jsobj.AddProperty("_oneByteBytecode", bc);
-    bc = bytecode(/*is_one_byte=*/false, /*sticky=*/false);
-    jsobj.AddProperty("_twoByteBytecode", bc);
-    bc = bytecode(/*is_one_byte=*/true, /*sticky=*/true);
-    jsobj.AddProperty("_oneByteBytecodeSticky", bc);
-    bc = bytecode(/*is_one_byte=*/false, /*sticky=*/true);
-    jsobj.AddProperty("_twoByteBytecodeSticky", bc);
-  }
+  // Each slot holds a function once the regexp is compiled to machine code
+  // and bytecode (or null) while it is interpreted.
+  Object& code = Object::Handle();
+  code = function(kOneByteStringCid, /*sticky=*/false);
+  jsobj.AddProperty(
+      code.IsFunction() ? "_oneByteFunction" : "_oneByteBytecode", code);
+  code = function(kTwoByteStringCid, /*sticky=*/false);
+  jsobj.AddProperty(
+      code.IsFunction() ? "_twoByteFunction" : "_twoByteBytecode", code);
+  code = function(kOneByteStringCid, /*sticky=*/true);
+  jsobj.AddProperty(
+      code.IsFunction() ? "_oneByteFunctionSticky" : "_oneByteBytecodeSticky",
+      code);
+  code = function(kTwoByteStringCid, /*sticky=*/true);
+  jsobj.AddProperty(
+      code.IsFunction() ? "_twoByteFunctionSticky" : "_twoByteBytecodeSticky",
+      code);
 }
 
 void RegExp::PrintImplementationFieldsImpl(
@@ -293,7 +293,10 @@ class ObjectPointerVisitor;
   RW(Code, suspend_sync_star_at_start_stub)                                    \
   RW(Code, suspend_sync_star_at_yield_stub)                                    \
   RW(Array, dispatch_table_code_entries)                                       \
+  RW(Array, code_order)                                                        \
+  RW(Array, cold_code)                                                         \
   RW(GrowableObjectArray, instructions_tables)                                 \
+  RW(GrowableObjectArray, permanent_roots)                                     \
   RW(Array, obfuscation_map)                                                   \
   RW(Array, loading_unit_uris)                                                 \
   RW(Class, ffi_pointer_class)                                                 \
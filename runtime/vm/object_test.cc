@@ -1436,6 +1436,35 @@ ISOLATE_UNIT_TEST_CASE(StringSubStringDifferentWidth) {
   EXPECT(foursub4.IsTwoByteString());
 }
 
+ISOLATE_UNIT_TEST_CASE(StringCaseMapping) {
+  // Strings that are unchanged by the mapping are returned as is.
+  const String& lower = String::Handle(String::New("content-type"));
+  EXPECT_EQ(lower.ptr(), String::ToLowerCase(lower));
+  const String& upper = String::Handle(String::New("ETAG"));
+  EXPECT_EQ(upper.ptr(), String::ToUpperCase(upper));
+
+  const String& mixed = String::Handle(String::New("Content-Type"));
+  String& result = String::Handle(String::ToLowerCase(mixed));
+  EXPECT(result.IsOneByteString());
+  EXPECT(result.Equals("content-type"));
+  result = String::ToUpperCase(mixed);
+  EXPECT(result.IsOneByteString());
+  EXPECT(result.Equals("CONTENT-TYPE"));
+
+  // Latin-1 letters stay one-byte, except for the few that leave Latin-1
+  // when upper-cased, like the micro sign.
+  const String& latin1 = String::Handle(String::New("\xC3\xA9t\xC3\xA9"));
+  EXPECT(latin1.IsOneByteString());
+  result = String::ToUpperCase(latin1);
+  EXPECT(result.IsOneByteString());
+  EXPECT(result.Equals("\xC3\x89T\xC3\x89"));
+  const String& micro = String::Handle(String::New("a\xC2\xB5"));
+  EXPECT(micro.IsOneByteString());
+  result = String::ToUpperCase(micro);
+  EXPECT(result.IsTwoByteString());
+  EXPECT(result.Equals("A\xCE\x9C"));
+}
+
 ISOLATE_UNIT_TEST_CASE(StringFromUtf8Literal) {
   // Create a 1-byte string from a UTF-8 encoded string literal.
   {
@@ -3195,6 +3224,31 @@ ISOLATE_UNIT_TEST_CASE(MegamorphicCache) {
       EXPECT(Smi::Cast(value).Equals(Smi::Cast(expected)));
     }
   }
+
+  // Insert keys which displace each other from their home slots.
+  {
+    const auto& cache =
+        MegamorphicCache::Handle(MegamorphicCache::New(name, args_descriptor));
+
+    // With the initial capacity 16, 16, 32 and 48 have home slot 0 and 7
+    // has home slot 1.
+    const intptr_t kCids[] = {16, 32, 7, 48};
+    auto& cid = Smi::Handle();
+    auto& value = Object::Handle();
+    for (intptr_t i = 0; i < 4; ++i) {
+      cid = Smi::New(kCids[i]);
+      value = Smi::New(i);
+      cache.EnsureContains(cid, value);
+    }
+    EXPECT_EQ(4, cache.filled_entry_count());
+    auto& expected = Object::Handle();
+    for (intptr_t i = 0; i < 4; ++i) {
+      cid = Smi::New(kCids[i]);
+      expected = Smi::New(i);
+      value = cache.Lookup(cid);
+      EXPECT(Smi::Cast(value).Equals(Smi::Cast(expected)));
+    }
+  }
 }
 
 ISOLATE_UNIT_TEST_CASE(FieldTests) {
@@ -74,7 +74,7 @@ class PerfCodeObserver : public CodeObserver {
                       uword prologue_offset,
                       uword size,
                       bool optimized,
-                      const CodeComments* comments) {
+                      const Code& code) {
     Dart_FileWriteCallback file_write = Dart::file_write_callback();
     if ((file_write == nullptr) || (out_file_ == nullptr)) {
       return;
@@ -25,6 +25,7 @@
 #include "platform/memory_sanitizer.h"
 #include "platform/utils.h"
 #include "vm/code_comments.h"
+#include "vm/code_descriptors.h"
 #include "vm/code_observers.h"
 #include "vm/dart.h"
 #include "vm/flags.h"
@@ -63,6 +64,12 @@ DEFINE_FLAG(bool,
             "Generate jitdump file to use with perf-inject (disables dual code "
             "mapping)");
 
+DEFINE_FLAG(bool,
+            perf_jitdump_source_positions,
+            false,
+            "Use source positions instead of code comments as the debug info "
+            "in the jitdump file");
+
 DECLARE_FLAG(bool, write_protect_code);
 DECLARE_FLAG(bool, write_protect_vm_isolate);
 #if !defined(DART_PRECOMPILED_RUNTIME)
@@ -107,7 +114,7 @@ class PerfCodeObserver : public CodeObserver {
                       uword prologue_offset,
                       uword size,
                       bool optimized,
-                      const CodeComments* comments) {
+                      const Code& code) {
     Dart_FileWriteCallback file_write = Dart::file_write_callback();
     if ((file_write == nullptr) || (out_file_ == nullptr)) {
       return;
@@ -138,6 +145,11 @@ class PerfCodeObserver : public CodeObserver {
 //   $ perf inject -j -i perf.data -o perf.data.jitted
 //   $ perf report -i perf.data.jitted
 //
+// With --perf-jitdump-source-positions the debug info maps PCs to the Dart
+// source lines (of inlined functions, if any) instead of code comments.
+// No unwinding info records are emitted: Dart frames keep the frame pointer
+// chain, which perf can walk with --call-graph fp.
+//
 // [1] see linux/tools/perf/Documentation/jitdump-specification.txt for
 //     JITDUMP binary format.
 class JitDumpCodeObserver : public CodeObserver {
@@ -184,8 +196,10 @@ class JitDumpCodeObserver : public CodeObserver {
     FLAG_write_protect_vm_isolate = false;
 
 #if !defined(DART_PRECOMPILED_RUNTIME)
-    // Enable code comments.
-    FLAG_code_comments = true;
+    // Enable code comments unless source positions are used instead.
+    if (!FLAG_perf_jitdump_source_positions) {
+      FLAG_code_comments = true;
+    }
 #endif
 
     // Write JITDUMP header.
@@ -213,14 +227,18 @@ class JitDumpCodeObserver : public CodeObserver {
                       uword prologue_offset,
                       uword size,
                       bool optimized,
-                      const CodeComments* comments) {
+                      const Code& code) {
     MutexLocker ml(CodeObservers::mutex());
 
     const char* marker = optimized ? "*" : "";
     char* buffer = OS::SCreate(Thread::Current()->zone(), "%s%s", marker, name);
     const size_t name_length = strlen(buffer);
 
-    WriteDebugInfo(base, comments);
+    if (FLAG_perf_jitdump_source_positions) {
+      WriteSourcePositions(base, code);
+    } else {
+      WriteDebugInfo(base, &code.comments());
+    }
 
     CodeLoadEvent ev;
     ev.event = BaseEvent::kLoad;
@@ -365,6 +383,83 @@ class JitDumpCodeObserver : public CodeObserver {
     free(comments_file_name);
   }
 
+  struct SourceLine {
+    uword pc_offset;
+    int32_t line;
+    int32_t column;
+    const char* file_name;
+  };
+
+  // Emits a DebugInfoEvent mapping the PCs of [code] to the lines of the
+  // innermost, possibly inlined, function they were generated for.
+  void WriteSourcePositions(uword base, const Code& code) {
+    Zone* zone = Thread::Current()->zone();
+    const auto& map = CodeSourceMap::Handle(zone, code.code_source_map());
+    const auto& root = Function::Handle(zone, code.function());
+    if (map.IsNull() || root.IsNull()) {
+      return;
+    }
+    const auto& functions =
+        Array::Handle(zone, code.inlined_id_to_function());
+    GrowableArray<CodeSourceMapReader::SourcePositionRange> ranges;
+    CodeSourceMapReader reader(map, functions, root);
+    reader.GetSourcePositionRanges(&ranges);
+
+    GrowableArray<SourceLine> lines;
+    auto& script = Script::Handle(zone);
+    auto& url = String::Handle(zone);
+    intptr_t entries_size = 0;
+    for (intptr_t i = 0; i < ranges.length(); i++) {
+      const auto& range = ranges[i];
+      if (!range.position.IsReal()) continue;
+      script = range.function->script();
+      intptr_t line = -1;
+      intptr_t column = -1;
+      if (script.IsNull() ||
+          !script.GetTokenLocation(range.position, &line, &column)) {
+        continue;
+      }
+      url = script.url();
+      const char* file_name = url.ToCString();
+      const char* const kFileScheme = "file://";
+      if (strncmp(file_name, kFileScheme, strlen(kFileScheme)) == 0) {
+        file_name += strlen(kFileScheme);
+      }
+      if (!lines.is_empty() && lines.Last().line == line &&
+          strcmp(lines.Last().file_name, file_name) == 0) {
+        continue;
+      }
+      lines.Add({static_cast<uword>(range.start), static_cast<int32_t>(line),
+                 static_cast<int32_t>(column), file_name});
+      entries_size += sizeof(DebugInfoEntry) + strlen(file_name) + 1;
+    }
+    if (lines.is_empty()) {
+      return;
+    }
+
+    DebugInfoEvent info;
+    info.event = BaseEvent::kDebugInfo;
+    info.time_stamp = OS::GetCurrentMonotonicTicks();
+    info.address = base;
+    info.entry_count = lines.length();
+    info.size = sizeof(info) + entries_size;
+    const int32_t padding = Utils::RoundUp(info.size, 8) - info.size;
+    info.size += padding;
+
+    WriteFully(&info, sizeof(info));
+    for (intptr_t i = 0; i < lines.length(); i++) {
+      DebugInfoEntry entry;
+      entry.address = base + lines[i].pc_offset + sizeof(ElfW(Ehdr));
+      entry.line_number = lines[i].line;
+      entry.column = lines[i].column;
+      WriteFully(&entry, sizeof(entry));
+      WriteFully(lines[i].file_name, strlen(lines[i].file_name) + 1);
+    }
+
+    const char padding_bytes[8] = {0};
+    WriteFully(padding_bytes, padding);
+  }
+
   void WriteHeader() {
     Header header;
     header.elf_mach_target = GetElfMachineArchitecture();
@@ -379,8 +474,9 @@ class JitDumpCodeObserver : public CodeObserver {
     fputc('\n', f);
 
     intptr_t line_count = 1;
-    while ((comment = strstr(comment, "\n")) != nullptr) {
+    while ((comment = strchr(comment, '\n')) != nullptr) {
       line_count++;
+      comment++;
     }
     return line_count;
   }
@@ -17,17 +17,28 @@
 
 namespace dart {
 
+struct PortMap::Shard {
+  // Lock protecting access to [ports].
+  Mutex mutex;
+  PortSet<Entry>* ports = nullptr;
+};
+
 Mutex* PortMap::mutex_ = nullptr;
-PortSet<PortMap::Entry>* PortMap::ports_ = nullptr;
+PortMap::Shard* PortMap::shards_ = nullptr;
 Random* PortMap::prng_ = nullptr;
 
+PortMap::Shard* PortMap::ShardFor(Dart_Port port) {
+  // The low bits of port ids are fixed (see [AllocatePort]) and are used by
+  // the [PortSet] hashing, so pick the shard from the high bits.
+  return &shards_[(static_cast<uint64_t>(port) >> 32) % kNumShards];
+}
+
 Dart_Port PortMap::AllocatePort() {
   Dart_Port result;
 
   ASSERT(mutex_->IsOwnedByCurrentThread());
 
-  // Keep getting new values while we have an illegal port number or the port
-  // number is already in use.
+  // Keep getting new values while we have an illegal port number.
   do {
     // Ensure port ids are never valid object pointers so that reinterpreting
     // an object pointer as a port id never produces a used port id.
@@ -39,23 +50,18 @@ Dart_Port PortMap::AllocatePort() {
 
     // The two special marker ports are used for the hashset implementation and
     // cannot be used as actual ports.
-    if (result == PortSet<Entry>::kFreePort ||
-        result == PortSet<Entry>::kDeletedPort) {
-      continue;
-    }
-
-    ASSERT(!static_cast<ObjectPtr>(static_cast<uword>(result))->IsWellFormed());
-  } while (ports_->Contains(result));
+  } while (result == PortSet<Entry>::kFreePort ||
+           result == PortSet<Entry>::kDeletedPort);
 
+  ASSERT(!static_cast<ObjectPtr>(static_cast<uword>(result))->IsWellFormed());
   ASSERT(result != 0);
-  ASSERT(!ports_->Contains(result));
   return result;
 }
 
 Dart_Port PortMap::CreatePort(MessageHandler* handler) {
   ASSERT(handler != nullptr);
   MutexLocker ml(mutex_);
-  if (ports_ == nullptr) {
+  if (prng_ == nullptr) {
     return ILLEGAL_PORT;
   }
 
@@ -63,28 +69,37 @@ Dart_Port PortMap::CreatePort(MessageHandler* handler) {
   handler->CheckAccess();
 #endif
 
-  const Dart_Port port = AllocatePort();
+  while (true) {
+    const Dart_Port port = AllocatePort();
+    Shard* shard = ShardFor(port);
+    MutexLocker sl(&shard->mutex);
+    ASSERT(shard->ports != nullptr);
+    if (shard->ports->Contains(port)) {
+      // The port number is already in use.
+      continue;
+    }
 
-  // The MessageHandler::ports_ is only accessed by [PortMap], it is guarded
-  // by the [PortMap::mutex_] we already hold.
-  MessageHandler::PortSetEntry isolate_entry;
-  isolate_entry.port = port;
-  handler->ports_.Insert(isolate_entry);
-
-  Entry entry;
-  entry.port = port;
-  entry.handler = handler;
-  ports_->Insert(entry);
-
-  if (FLAG_trace_isolates) {
-    OS::PrintErr(
-        "[+] Opening port: \n"
-        "\thandler:    %s\n"
-        "\tport:       %" Pd64 "\n",
-        handler->name(), entry.port);
-  }
+    // The MessageHandler::ports_ is only accessed by [PortMap], it is guarded
+    // by the [PortMap::mutex_] we already hold.
+    MessageHandler::PortSetEntry isolate_entry;
+    isolate_entry.port = port;
+    handler->ports_.Insert(isolate_entry);
+
+    Entry entry;
+    entry.port = port;
+    entry.handler = handler;
+    shard->ports->Insert(entry);
+
+    if (FLAG_trace_isolates) {
+      OS::PrintErr(
+          "[+] Opening port: \n"
+          "\thandler:    %s\n"
+          "\tport:       %" Pd64 "\n",
+          handler->name(), entry.port);
+    }
 
-  return entry.port;
+    return entry.port;
+  }
 }
 
 bool PortMap::ClosePort(Dart_Port port, MessageHandler** message_handler) {
@@ -93,25 +108,29 @@ bool PortMap::ClosePort(Dart_Port port, MessageHandler** message_handler) {
   MessageHandler* handler = nullptr;
   {
     MutexLocker ml(mutex_);
-    if (ports_ == nullptr) {
-      return false;
-    }
-    auto it = ports_->TryLookup(port);
-    if (it == ports_->end()) {
+    if (prng_ == nullptr) {
       return false;
     }
-    Entry entry = *it;
-    handler = entry.handler;
-    ASSERT(handler != nullptr);
+    Shard* shard = ShardFor(port);
+    {
+      MutexLocker sl(&shard->mutex);
+      auto it = shard->ports->TryLookup(port);
+      if (it == shard->ports->end()) {
+        return false;
+      }
+      Entry entry = *it;
+      handler = entry.handler;
+      ASSERT(handler != nullptr);
 
 #if defined(DEBUG)
-    handler->CheckAccess();
+      handler->CheckAccess();
 #endif
 
-    // Delete the port entry before releasing the lock to avoid holding the lock
-    // while flushing the messages below.
-    it.Delete();
-    ports_->Rebalance();
+      // Delete the port entry before releasing the lock to avoid holding the
+      // lock while flushing the messages below.
+      it.Delete();
+      shard->ports->Rebalance();
+    }
 
     // The MessageHandler::ports_ is only accessed by [PortMap], it is guarded
     // by the [PortMap::mutex_] we already hold.
@@ -128,35 +147,38 @@ bool PortMap::ClosePort(Dart_Port port, MessageHandler** message_handler) {
 void PortMap::ClosePorts(MessageHandler* handler) {
   {
     MutexLocker ml(mutex_);
-    if (ports_ == nullptr) {
+    if (prng_ == nullptr) {
       return;
     }
     // The MessageHandler::ports_ is only accessed by [PortMap], it is guarded
     // by the [PortMap::mutex_] we already hold.
     for (auto isolate_it = handler->ports_.begin();
          isolate_it != handler->ports_.end(); ++isolate_it) {
-      auto it = ports_->TryLookup((*isolate_it).port);
-      ASSERT(it != ports_->end());
+      Shard* shard = ShardFor((*isolate_it).port);
+      MutexLocker sl(&shard->mutex);
+      auto it = shard->ports->TryLookup((*isolate_it).port);
+      ASSERT(it != shard->ports->end());
       Entry entry = *it;
       ASSERT(entry.port == (*isolate_it).port);
       ASSERT(entry.handler == handler);
       it.Delete();
+      shard->ports->Rebalance();
       isolate_it.Delete();
     }
     ASSERT(handler->ports_.IsEmpty());
-    ports_->Rebalance();
   }
   handler->CloseAllPorts();
 }
 
 bool PortMap::PostMessage(std::unique_ptr<Message> message,
                           bool before_events) {
-  MutexLocker ml(mutex_);
-  if (ports_ == nullptr) {
+  Shard* shard = ShardFor(message->dest_port());
+  MutexLocker ml(&shard->mutex);
+  if (shard->ports == nullptr) {
     return false;
   }
-  auto it = ports_->TryLookup(message->dest_port());
-  if (it == ports_->end()) {
+  auto it = shard->ports->TryLookup(message->dest_port());
+  if (it == shard->ports->end()) {
     // Ownership of external data remains with the poster.
     message->DropFinalizers();
     return false;
@@ -167,24 +189,49 @@ bool PortMap::PostMessage(std::unique_ptr<Message> message,
   return true;
 }
 
+bool PortMap::PostMessages(Dart_Port port, MessageQueue* messages) {
+  Shard* shard = ShardFor(port);
+  MutexLocker ml(&shard->mutex);
+  MessageHandler* handler = nullptr;
+  if (shard->ports != nullptr) {
+    auto it = shard->ports->TryLookup(port);
+    if (it != shard->ports->end()) {
+      handler = (*it).handler;
+    }
+  }
+  if (handler == nullptr) {
+    // Ownership of external data remains with the poster.
+    std::unique_ptr<Message> message = messages->Dequeue();
+    while (message != nullptr) {
+      message->DropFinalizers();
+      message = messages->Dequeue();
+    }
+    return false;
+  }
+  handler->PostMessages(messages);
+  return true;
+}
+
 #if defined(TESTING)
 bool PortMap::PortExists(Dart_Port id) {
-  MutexLocker ml(mutex_);
-  if (ports_ == nullptr) {
+  Shard* shard = ShardFor(id);
+  MutexLocker ml(&shard->mutex);
+  if (shard->ports == nullptr) {
     return false;
   }
-  auto it = ports_->TryLookup(id);
-  return it != ports_->end();
+  auto it = shard->ports->TryLookup(id);
+  return it != shard->ports->end();
 }
 #endif  // defined(TESTING)
 
 Isolate* PortMap::GetIsolate(Dart_Port id) {
-  MutexLocker ml(mutex_);
-  if (ports_ == nullptr) {
+  Shard* shard = ShardFor(id);
+  MutexLocker ml(&shard->mutex);
+  if (shard->ports == nullptr) {
     return nullptr;
   }
-  auto it = ports_->TryLookup(id);
-  if (it == ports_->end()) {
+  auto it = shard->ports->TryLookup(id);
+  if (it == shard->ports->end()) {
     // Port does not exist.
     return nullptr;
   }
@@ -194,12 +241,13 @@ Isolate* PortMap::GetIsolate(Dart_Port id) {
 }
 
 Dart_Port PortMap::GetOriginId(Dart_Port id) {
-  MutexLocker ml(mutex_);
-  if (ports_ == nullptr) {
+  Shard* shard = ShardFor(id);
+  MutexLocker ml(&shard->mutex);
+  if (shard->ports == nullptr) {
     return ILLEGAL_PORT;
   }
-  auto it = ports_->TryLookup(id);
-  if (it == ports_->end()) {
+  auto it = shard->ports->TryLookup(id);
+  if (it == shard->ports->end()) {
     // Port does not exist.
     return ILLEGAL_PORT;
   }
@@ -216,7 +264,7 @@ Dart_Port PortMap::GetOriginId(Dart_Port id) {
 #if defined(TESTING)
 bool PortMap::HasPorts(MessageHandler* handler) {
   MutexLocker ml(mutex_);
-  if (ports_ == nullptr) {
+  if (prng_ == nullptr) {
     return false;
   }
   // The MessageHandler::ports_ is only accessed by [PortMap], it is guarded
@@ -227,13 +275,14 @@ bool PortMap::HasPorts(MessageHandler* handler) {
 
 bool PortMap::IsReceiverInThisIsolateGroupOrClosed(Dart_Port receiver,
                                                    IsolateGroup* group) {
-  MutexLocker ml(mutex_);
-  if (ports_ == nullptr) {
+  Shard* shard = ShardFor(receiver);
+  MutexLocker ml(&shard->mutex);
+  if (shard->ports == nullptr) {
     // Port was closed.
     return true;
   }
-  auto it = ports_->TryLookup(receiver);
-  if (it == ports_->end()) {
+  auto it = shard->ports->TryLookup(receiver);
+  if (it == shard->ports->end()) {
     // Port was closed.
     return true;
   }
@@ -253,28 +302,40 @@ void PortMap::Init() {
   if (prng_ == nullptr) {
     prng_ = new Random();
   }
-  if (ports_ == nullptr) {
-    ports_ = new PortSet<Entry>();
+  if (shards_ == nullptr) {
+    shards_ = new Shard[kNumShards];
+  }
+  for (intptr_t i = 0; i < kNumShards; i++) {
+    if (shards_[i].ports == nullptr) {
+      shards_[i].ports = new PortSet<Entry>();
+    }
   }
 }
 
 void PortMap::Cleanup() {
-  ASSERT(ports_ != nullptr);
+  ASSERT(shards_ != nullptr);
   ASSERT(prng_ != nullptr);
-  for (auto it = ports_->begin(); it != ports_->end(); ++it) {
-    const auto& entry = *it;
-    ASSERT(entry.handler != nullptr);
-    delete entry.handler;
-    it.Delete();
+  for (intptr_t i = 0; i < kNumShards; i++) {
+    PortSet<Entry>* ports = shards_[i].ports;
+    ASSERT(ports != nullptr);
+    for (auto it = ports->begin(); it != ports->end(); ++it) {
+      const auto& entry = *it;
+      ASSERT(entry.handler != nullptr);
+      delete entry.handler;
+      it.Delete();
+    }
+    ports->Rebalance();
   }
-  ports_->Rebalance();
 
-  // Grab the mutex and delete the port set.
+  // Grab the mutexes and delete the port sets.
   MutexLocker ml(mutex_);
   delete prng_;
   prng_ = nullptr;
-  delete ports_;
-  ports_ = nullptr;
+  for (intptr_t i = 0; i < kNumShards; i++) {
+    MutexLocker sl(&shards_[i].mutex);
+    delete shards_[i].ports;
+    shards_[i].ports = nullptr;
+  }
 }
 
 void PortMap::PrintPortsForMessageHandler(MessageHandler* handler,
@@ -285,17 +346,19 @@ void PortMap::PrintPortsForMessageHandler(MessageHandler* handler,
   Object& msg_handler = Object::Handle();
   {
     JSONArray ports(&jsobj, "ports");
-    SafepointMutexLocker ml(mutex_);
-    if (ports_ == nullptr) {
-      return;
-    }
-    for (auto& entry : *ports_) {
-      if (entry.handler == handler) {
-        JSONObject port(&ports);
-        port.AddProperty("type", "_Port");
-        port.AddPropertyF("name", "Isolate Port (%" Pd64 ")", entry.port);
-        msg_handler = DartLibraryCalls::LookupHandler(entry.port);
-        port.AddProperty("handler", msg_handler);
+    for (intptr_t i = 0; i < kNumShards; i++) {
+      SafepointMutexLocker ml(&shards_[i].mutex);
+      if (shards_[i].ports == nullptr) {
+        return;
+      }
+      for (auto& entry : *shards_[i].ports) {
+        if (entry.handler == handler) {
+          JSONObject port(&ports);
+          port.AddProperty("type", "_Port");
+          port.AddPropertyF("name", "Isolate Port (%" Pd64 ")", entry.port);
+          msg_handler = DartLibraryCalls::LookupHandler(entry.port);
+          port.AddProperty("handler", msg_handler);
+        }
       }
     }
   }
@@ -303,16 +366,18 @@ void PortMap::PrintPortsForMessageHandler(MessageHandler* handler,
 }
 
 void PortMap::DebugDumpForMessageHandler(MessageHandler* handler) {
-  SafepointMutexLocker ml(mutex_);
-  if (ports_ == nullptr) {
-    return;
-  }
   Object& msg_handler = Object::Handle();
-  for (auto& entry : *ports_) {
-    if (entry.handler == handler) {
-      OS::PrintErr("Port = %" Pd64 "\n", entry.port);
-      msg_handler = DartLibraryCalls::LookupHandler(entry.port);
-      OS::PrintErr("Handler = %s\n", msg_handler.ToCString());
+  for (intptr_t i = 0; i < kNumShards; i++) {
+    SafepointMutexLocker ml(&shards_[i].mutex);
+    if (shards_[i].ports == nullptr) {
+      return;
+    }
+    for (auto& entry : *shards_[i].ports) {
+      if (entry.handler == handler) {
+        OS::PrintErr("Port = %" Pd64 "\n", entry.port);
+        msg_handler = DartLibraryCalls::LookupHandler(entry.port);
+        OS::PrintErr("Handler = %s\n", msg_handler.ToCString());
+      }
     }
   }
 }
@@ -19,6 +19,7 @@ namespace dart {
 class Isolate;
 class Message;
 class MessageHandler;
+class MessageQueue;
 class Mutex;
 
 class PortMap : public AllStatic {
@@ -42,6 +43,11 @@ class PortMap : public AllStatic {
   static bool PostMessage(std::unique_ptr<Message> message,
                           bool before_events = false);
 
+  // Enqueues all messages of [messages] in the port with id [port], in
+  // order. Returns false if the port is not active any longer.
+  //
+  // Claims ownership of the messages and leaves [messages] empty.
+  static bool PostMessages(Dart_Port port, MessageQueue* messages);
 
   // Returns the owning Isolate for port 'id'.
   static Isolate* GetIsolate(Dart_Port id);
@@ -73,13 +79,21 @@ class PortMap : public AllStatic {
     MessageHandler* handler;
   };
 
-  // Allocate a new unique port.
+  // Ports are spread over shards by id, each with its own lock, so that
+  // messages posted to unrelated ports do not contend on a single lock.
+  struct Shard;
+  static constexpr intptr_t kNumShards = 32;
+  static Shard* ShardFor(Dart_Port port);
+
+  // Produce a candidate port id. Uniqueness is checked by the caller under
+  // the lock of the candidate's shard.
   static Dart_Port AllocatePort();
 
-  // Lock protecting access to the port map.
+  // Lock protecting port allocation and the ports of each [MessageHandler].
+  // It is always acquired before any shard lock.
   static Mutex* mutex_;
 
-  static PortSet<Entry>* ports_;
+  static Shard* shards_;
 
   static Random* prng_;
 };
@@ -167,9 +167,9 @@ class UntaggedObject {
     kAlwaysSetBit = 4,            // Incremental barrier source.
     kOldAndNotRememberedBit = 5,  // Generational barrier source.
     kImmutableBit = 6,
-    kReservedBit = 7,
+    kPermanentBit = 7,
 
-    kSizeTagPos = kReservedBit + 1,  // = 8
+    kSizeTagPos = kPermanentBit + 1,  // = 8
     kSizeTagSize = 4,
     kClassIdTagPos = kSizeTagPos + kSizeTagSize,  // = 12
     kClassIdTagSize = 20,
@@ -278,7 +278,9 @@ class UntaggedObject {
   // See also Class::kIsDeeplyImmutableBit.
   class ImmutableBit : public BitField<uword, bool, kImmutableBit, 1> {};
 
-  class ReservedBit : public BitField<uword, intptr_t, kReservedBit, 1> {};
+  // Set on old-space objects frozen by Heap::MakePermanent. Such objects keep
+  // their mark bit across collections, so the marker never traces them again.
+  class PermanentBit : public BitField<uword, bool, kPermanentBit, 1> {};
 
   // Assumes this is a heap object.
   bool IsNewObject() const {
@@ -334,6 +336,15 @@ class UntaggedObject {
   void SetImmutable() { tags_.UpdateBool<ImmutableBit>(true); }
   void ClearImmutable() { tags_.UpdateBool<ImmutableBit>(false); }
 
+  static bool IsPermanent(uword tags) { return PermanentBit::decode(tags); }
+  bool IsPermanent() const { return tags_.Read<PermanentBit>(); }
+  void SetPermanentUnsynchronized() {
+    tags_.UpdateUnsynchronized<PermanentBit>(true);
+  }
+  void ClearPermanentUnsynchronized() {
+    tags_.UpdateUnsynchronized<PermanentBit>(false);
+  }
+
   bool InVMIsolateHeap() const;
 
   // Support for GC remembered bit.
@@ -821,6 +832,7 @@ class UntaggedObject {
   friend class Object;
   friend uword TagsFromUntaggedObject(UntaggedObject*);                // tags_
   friend void SetNewSpaceTaggingWord(ObjectPtr, classid_t, uint32_t);  // tags_
+  friend void SetOldSpaceTaggingWord(ObjectPtr, classid_t, uint32_t);  // tags_
   friend class ObjectCopyBase;  // LoadPointer/StorePointer
   friend void ReportImpossibleNullError(intptr_t cid,
                                         StackFrame* caller_frame,
@@ -1436,6 +1448,16 @@ class UntaggedFunction : public UntaggedObject {
 
   using PackedOptimizable =
       BitField<decltype(packed_fields_), bool, 0, kMaxOptimizableBits>;
+  // Summary of the side effects of the optimized code of this function,
+  // see Function::has_no_side_effects().
+  using PackedHasNoSideEffects = BitField<decltype(packed_fields_),
+                                          bool,
+                                          PackedOptimizable::kNextBit,
+                                          1>;
+  using PackedIsPure = BitField<decltype(packed_fields_),
+                                bool,
+                                PackedHasNoSideEffects::kNextBit,
+                                1>;
 #endif  // !defined(DART_PRECOMPILED_RUNTIME)
 };
 
@@ -2272,21 +2294,35 @@ class UntaggedInstructionsTable : public UntaggedObject {
   };
   static_assert(sizeof(DataEntry) == sizeof(uint32_t) * 2);
 
+  // Granularity of the page index, which maps every such page of the
+  // instructions to the entry containing its first byte. This narrows the
+  // binary search over all entries down to the few entries of a page.
+  static constexpr intptr_t kPageIndexShift = 12;
+
   struct Data {
     uint32_t canonical_stack_map_entries_offset;
     uint32_t length;
     uint32_t first_entry_with_code;
+    // Offset of the page index (from the beginning of the Data object) and
+    // its number of uint32_t elements.
+    uint32_t page_index_offset;
+    uint32_t page_index_length;
     uint32_t padding;
 
     const DataEntry* entries() const { OPEN_ARRAY_START(DataEntry, uint32_t); }
 
+    const uint32_t* page_index() const {
+      return reinterpret_cast<const uint32_t*>(
+          reinterpret_cast<uword>(this) + page_index_offset);
+    }
+
     const UntaggedCompressedStackMaps::Payload* StackMapAt(
         intptr_t offset) const {
       return reinterpret_cast<UntaggedCompressedStackMaps::Payload*>(
           reinterpret_cast<uword>(this) + offset);
     }
   };
-  static_assert(sizeof(Data) == sizeof(uint32_t) * 4);
+  static_assert(sizeof(Data) == sizeof(uint32_t) * 6);
 
   intptr_t length_;
   const Data* rodata_;
@@ -3525,6 +3561,10 @@ class UntaggedRegExp : public UntaggedInstance {
   // It is possible multiple compilers race to update the flags concurrently.
   // That should be safe since all updates update to the same values..
   AtomicBitFieldContainer<int8_t> type_flags_;
+
+  // Number of times the regexp was interpreted before being compiled, see
+  // --regexp_tier_up_threshold. Fits into the padding after type_flags_.
+  std::atomic<uint16_t> interpreted_count_;
 };
 
 class UntaggedWeakProperty : public UntaggedInstance {
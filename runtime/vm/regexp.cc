@@ -5409,13 +5409,63 @@ RegExpEngine::CompilationResult RegExpEngine::CompileIR(
 }
 #endif  // !defined(DART_PRECOMPILED_RUNTIME)
 
+// Returns the code unit every match of [tree] starts with, or -1 if there is
+// no such code unit.
+static intptr_t RequiredFirstCharacter(RegExpTree* tree) {
+  if (tree->IsAtom()) {
+    RegExpAtom* atom = tree->AsAtom();
+    if (atom->ignore_case() || atom->length() == 0) return -1;
+    return atom->data()->At(0);
+  }
+  if (tree->IsCharacterClass()) {
+    RegExpCharacterClass* char_class = tree->AsCharacterClass();
+    if (char_class->is_negated() || char_class->flags().IgnoreCase()) {
+      return -1;
+    }
+    ZoneGrowableArray<CharacterRange>* ranges = char_class->ranges();
+    if (ranges->length() != 1 || ranges->At(0).from() != ranges->At(0).to()) {
+      return -1;
+    }
+    return ranges->At(0).from();
+  }
+  if (tree->IsText()) {
+    return RequiredFirstCharacter(tree->AsText()->elements()->At(0).tree());
+  }
+  if (tree->IsAlternative()) {
+    // Skip the leading assertions and lookarounds, which consume nothing.
+    ZoneGrowableArray<RegExpTree*>* nodes = tree->AsAlternative()->nodes();
+    for (intptr_t i = 0; i < nodes->length(); i++) {
+      if (nodes->At(i)->max_match() > 0) {
+        return RequiredFirstCharacter(nodes->At(i));
+      }
+    }
+    return -1;
+  }
+  if (tree->IsDisjunction()) {
+    ZoneGrowableArray<RegExpTree*>* alternatives =
+        tree->AsDisjunction()->alternatives();
+    const intptr_t c = RequiredFirstCharacter(alternatives->At(0));
+    for (intptr_t i = 1; i < alternatives->length(); i++) {
+      if (RequiredFirstCharacter(alternatives->At(i)) != c) return -1;
+    }
+    return c;
+  }
+  if (tree->IsCapture()) {
+    return RequiredFirstCharacter(tree->AsCapture()->body());
+  }
+  if (tree->IsQuantifier() && tree->AsQuantifier()->min() > 0) {
+    return RequiredFirstCharacter(tree->AsQuantifier()->body());
+  }
+  return -1;
+}
+
 RegExpEngine::CompilationResult RegExpEngine::CompileBytecode(
     RegExpCompileData* data,
     const RegExp& regexp,
     bool is_one_byte,
     bool is_sticky,
     Zone* zone) {
-  ASSERT(FLAG_interpret_irregexp);
+  ASSERT(FLAG_interpret_irregexp || FLAG_regexp_tier_up_threshold > 0);
   const String& pattern = String::Handle(zone, regexp.pattern());
 
   ASSERT(!regexp.IsNull());
@@ -5498,6 +5548,15 @@ RegExpEngine::CompilationResult RegExpEngine::CompileBytecode(
     macro_assembler->SetCurrentPositionFromEnd(max_length);
   }
 
+  // Search for the first possible start of a match with memchr rather than
+  // by trying to match at every position.
+  if (!is_start_anchored && !is_sticky && !is_unicode) {
+    const intptr_t first_character = RequiredFirstCharacter(data->tree);
+    if (first_character >= 0) {
+      macro_assembler->SkipUntilCharacter(first_character);
+    }
+  }
+
   if (is_global) {
     RegExpMacroAssembler::GlobalMode mode = RegExpMacroAssembler::GLOBAL;
     if (data->tree->min_match() > 0) {
@@ -5582,7 +5641,9 @@ RegExpPtr RegExpEngine::CreateRegExp(Thread* thread,
   regexp.set_is_complex();
   regexp.set_is_global();  // All dart regexps are global.
 
-  if (!FLAG_interpret_irregexp) {
+  // Regexps that tier up get their functions once they are used enough, see
+  // RegExpEngine::TierUpIfNeeded.
+  if (!FLAG_interpret_irregexp && FLAG_regexp_tier_up_threshold <= 0) {
     const Library& lib = Library::Handle(zone, Library::CoreLibrary());
     const Class& owner =
         Class::Handle(zone, lib.LookupClass(Symbols::RegExp()));
@@ -5598,4 +5659,34 @@ RegExpPtr RegExpEngine::CreateRegExp(Thread* thread,
   return regexp.ptr();
 }
 
+bool RegExpEngine::TierUpIfNeeded(Thread* thread,
+                                  const RegExp& regexp,
+                                  intptr_t specialization_cid,
+                                  bool sticky) {
+  ASSERT(!FLAG_interpret_irregexp);
+  Zone* zone = thread->zone();
+  Object& code =
+      Object::Handle(zone, regexp.function(specialization_cid, sticky));
+  if (code.IsFunction()) {
+    return true;
+  }
+  if (regexp.IncrementInterpretedCount() <= FLAG_regexp_tier_up_threshold) {
+    return false;
+  }
+
+  const Library& lib = Library::Handle(zone, Library::CoreLibrary());
+  const Class& owner = Class::Handle(zone, lib.LookupClass(Symbols::RegExp()));
+
+  // Regexps are shared between the isolates of a group. Once a slot holds a
+  // function it is never reset to bytecode, see the bytecode installation in
+  // BytecodeRegExpMacroAssembler::Interpret.
+  SafepointWriteRwLocker ml(thread, thread->isolate_group()->program_lock());
+  code = regexp.function(specialization_cid, sticky);
+  if (!code.IsFunction()) {
+    CreateSpecializedFunction(thread, zone, regexp, specialization_cid, sticky,
+                              owner);
+  }
+  return true;
+}
+
 }  // namespace dart
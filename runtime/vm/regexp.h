@@ -1515,6 +1515,16 @@ class RegExpEngine : public AllStatic {
                                 const String& pattern,
                                 RegExpFlags flags);
 
+  // Counts an interpretation of [regexp] against strings of
+  // [specialization_cid] and, once it exceeds --regexp_tier_up_threshold,
+  // creates the function that runs it as machine code.
+  //
+  // Returns whether the regexp should be run through its function.
+  static bool TierUpIfNeeded(Thread* thread,
+                             const RegExp& regexp,
+                             intptr_t specialization_cid,
+                             bool sticky);
+
   static void DotPrint(const char* label, RegExpNode* node, bool ignore_case);
 };
 
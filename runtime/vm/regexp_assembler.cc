@@ -100,8 +100,9 @@ DEFINE_RAW_LEAF_RUNTIME_ENTRY(
 
 BlockLabel::BlockLabel() {
 #if !defined(DART_PRECOMPILED_RUNTIME)
-  if (!FLAG_interpret_irregexp) {
-    // Only needed by the compiled IR backend.
+  // Only needed by the compiled IR backend. Bytecode compiled in JIT mode
+  // for regexps that are not tiered up yet has no compiler state.
+  if (!FLAG_interpret_irregexp && Thread::Current()->HasCompilerState()) {
     block_ =
         new JoinEntryInstr(-1, -1, CompilerState::Current().GetNextDeoptId());
   }
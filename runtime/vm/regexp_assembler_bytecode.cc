@@ -11,11 +11,14 @@
 #include "vm/regexp_assembler_bytecode_inl.h"
 #include "vm/regexp_bytecodes.h"
 #include "vm/regexp_interpreter.h"
+#include "vm/regexp_linear.h"
 #include "vm/regexp_parser.h"
 #include "vm/timeline.h"
 
 namespace dart {
 
+DECLARE_FLAG(int, regexp_backtracks_before_fallback);
+
 BytecodeRegExpMacroAssembler::BytecodeRegExpMacroAssembler(
     ZoneGrowableArray<uint8_t>* buffer,
     Zone* zone)
@@ -116,6 +119,10 @@ void BytecodeRegExpMacroAssembler::SetCurrentPositionFromEnd(intptr_t by) {
   Emit(BC_SET_CURRENT_POSITION_FROM_END, by);
 }
 
+void BytecodeRegExpMacroAssembler::SkipUntilCharacter(uint16_t c) {
+  Emit(BC_SKIP_UNTIL_CHAR, c);
+}
+
 void BytecodeRegExpMacroAssembler::SetRegister(intptr_t register_index,
                                                intptr_t to) {
   ASSERT(register_index >= 0);
@@ -422,10 +429,17 @@ void BytecodeRegExpMacroAssembler::Expand() {
 static intptr_t Prepare(const RegExp& regexp,
                         const String& subject,
                         bool sticky,
+                        TypedData* bytecode,
                         Zone* zone) {
   bool is_one_byte = subject.IsOneByteString();
 
-  if (regexp.bytecode(is_one_byte, sticky) == TypedData::null()) {
+  // When regexps tier up (see --regexp_tier_up_threshold) the slot is read
+  // only once, as another isolate may replace its bytecode with a function.
+  const Object& code = Object::Handle(
+      zone, regexp.function(subject.GetClassId(), sticky));
+  if (code.IsTypedData()) {
+    *bytecode = TypedData::Cast(code).ptr();
+  } else {
     const String& pattern = String::Handle(zone, regexp.pattern());
 #if defined(SUPPORT_TIMELINE)
     TimelineBeginEndScope tbes(Thread::Current(), Timeline::GetCompilerStream(),
@@ -458,7 +472,15 @@ static intptr_t Prepare(const RegExp& regexp,
     ASSERT(regexp.num_registers(is_one_byte) == -1 ||
            regexp.num_registers(is_one_byte) == result.num_registers);
     regexp.set_num_registers(is_one_byte, result.num_registers);
-    regexp.set_bytecode(is_one_byte, sticky, *(result.bytecode));
+    *bytecode = result.bytecode->ptr();
+    if (code.IsNull()) {
+      Thread* thread = Thread::Current();
+      SafepointWriteRwLocker ml(thread,
+                                thread->isolate_group()->program_lock());
+      if (regexp.function(subject.GetClassId(), sticky) == Function::null()) {
+        regexp.set_bytecode(is_one_byte, sticky, *bytecode);
+      }
+    }
   }
 
   ASSERT(regexp.num_registers(is_one_byte) != -1);
@@ -468,14 +490,13 @@ static intptr_t Prepare(const RegExp& regexp,
 }
 
 static ObjectPtr ExecRaw(const RegExp& regexp,
+                         const TypedData& bytecode,
                          const String& subject,
                          int32_t index,
                          bool sticky,
                          int32_t* output,
                          intptr_t output_size,
                          Zone* zone) {
-  bool is_one_byte = subject.IsOneByteString();
-
   // We must have done EnsureCompiledIrregexp, so we can get the number of
   // registers.
   int number_of_capture_registers = (regexp.num_bracket_expressions() + 1) * 2;
@@ -488,11 +509,24 @@ static ObjectPtr ExecRaw(const RegExp& regexp,
     raw_output[i] = -1;
   }
 
-  const TypedData& bytecode =
-      TypedData::Handle(zone, regexp.bytecode(is_one_byte, sticky));
   ASSERT(!bytecode.IsNull());
-  const Object& result = Object::Handle(
-      zone, IrregexpInterpreter::Match(bytecode, subject, raw_output, index));
+  Object& result = Object::Handle(
+      zone, IrregexpInterpreter::Match(bytecode, subject, raw_output, index,
+                                       FLAG_regexp_backtracks_before_fallback));
+  if (result.ptr() == Object::sentinel().ptr()) {
+    // The regexp backtracks excessively on this subject. Finish in linear
+    // time if the regexp allows for it and otherwise without a limit.
+    result = LinearRegExpMatcher::Match(regexp, subject, output, index, sticky,
+                                        zone);
+    if (!result.IsNull()) {
+      return result.ptr();
+    }
+    for (int i = number_of_capture_registers - 1; i >= 0; i--) {
+      raw_output[i] = -1;
+    }
+    result = IrregexpInterpreter::Match(bytecode, subject, raw_output, index,
+                                        /*backtrack_limit=*/0);
+  }
 
   if (result.ptr() == Bool::True().ptr()) {
     // Copy capture results to the start of the registers array.
@@ -506,12 +540,17 @@ static ObjectPtr ExecRaw(const RegExp& regexp,
   return result.ptr();
 }
 
-ObjectPtr BytecodeRegExpMacroAssembler::Interpret(const RegExp& regexp,
-                                                  const String& subject,
-                                                  const Smi& start_index,
-                                                  bool sticky,
-                                                  Zone* zone) {
-  intptr_t required_registers = Prepare(regexp, subject, sticky, zone);
+// Runs [regexp] on [subject] and on success sets [*captures] to the start and
+// end of each capture.
+static bool InterpretMatch(const RegExp& regexp,
+                           const String& subject,
+                           const Smi& start_index,
+                           bool sticky,
+                           int32_t** captures,
+                           Zone* zone) {
+  TypedData& bytecode = TypedData::Handle(zone);
+  intptr_t required_registers =
+      Prepare(regexp, subject, sticky, &bytecode, zone);
   if (required_registers < 0) {
     // Compiling failed with an exception.
     UNREACHABLE();
@@ -521,31 +560,23 @@ ObjectPtr BytecodeRegExpMacroAssembler::Interpret(const RegExp& regexp,
   int32_t* output_registers = zone->Alloc<int32_t>(required_registers);
 
   const Object& result =
-      Object::Handle(zone, ExecRaw(regexp, subject, start_index.Value(), sticky,
+      Object::Handle(zone, ExecRaw(regexp, bytecode, subject,
+                                   start_index.Value(), sticky,
                                    output_registers, required_registers, zone));
   if (result.ptr() == Bool::True().ptr()) {
-    intptr_t capture_count = regexp.num_bracket_expressions();
-    intptr_t capture_register_count = (capture_count + 1) * 2;
-    ASSERT(required_registers >= capture_register_count);
-
-    const TypedData& result = TypedData::Handle(
-        TypedData::New(kTypedDataInt32ArrayCid, capture_register_count));
-    {
 #ifdef DEBUG
-      // These indices will be used with substring operations that don't check
-      // bounds, so sanity check them here.
-      for (intptr_t i = 0; i < capture_register_count; i++) {
-        int32_t val = output_registers[i];
-        ASSERT(val == -1 || (val >= 0 && val <= subject.Length()));
-      }
-#endif
-
-      NoSafepointScope no_safepoint;
-      memmove(result.DataAddr(0), output_registers,
-              capture_register_count * sizeof(int32_t));
+    // These indices will be used with substring operations that don't check
+    // bounds, so sanity check them here.
+    intptr_t capture_register_count =
+        (regexp.num_bracket_expressions() + 1) * 2;
+    ASSERT(required_registers >= capture_register_count);
+    for (intptr_t i = 0; i < capture_register_count; i++) {
+      int32_t val = output_registers[i];
+      ASSERT(val == -1 || (val >= 0 && val <= subject.Length()));
     }
-
-    return result.ptr();
+#endif
+    *captures = output_registers;
+    return true;
   }
   if (result.ptr() == Object::null()) {
     // internal exception
@@ -556,7 +587,46 @@ ObjectPtr BytecodeRegExpMacroAssembler::Interpret(const RegExp& regexp,
     UNREACHABLE();
   }
   ASSERT(result.ptr() == Bool::False().ptr());
-  return Instance::null();
+  return false;
+}
+
+ObjectPtr BytecodeRegExpMacroAssembler::Interpret(const RegExp& regexp,
+                                                  const String& subject,
+                                                  const Smi& start_index,
+                                                  bool sticky,
+                                                  Zone* zone) {
+  int32_t* captures = nullptr;
+  if (!InterpretMatch(regexp, subject, start_index, sticky, &captures, zone)) {
+    return Instance::null();
+  }
+  intptr_t capture_register_count = (regexp.num_bracket_expressions() + 1) * 2;
+  const TypedData& result = TypedData::Handle(
+      TypedData::New(kTypedDataInt32ArrayCid, capture_register_count));
+  {
+    NoSafepointScope no_safepoint;
+    memmove(result.DataAddr(0), captures,
+            capture_register_count * sizeof(int32_t));
+  }
+  return result.ptr();
+}
+
+bool BytecodeRegExpMacroAssembler::InterpretInto(const RegExp& regexp,
+                                                 const String& subject,
+                                                 const Smi& start_index,
+                                                 bool sticky,
+                                                 const TypedData& indices,
+                                                 Zone* zone) {
+  int32_t* captures = nullptr;
+  if (!InterpretMatch(regexp, subject, start_index, sticky, &captures, zone)) {
+    return false;
+  }
+  intptr_t capture_register_count = (regexp.num_bracket_expressions() + 1) * 2;
+  ASSERT(indices.GetClassId() == kTypedDataInt32ArrayCid);
+  ASSERT(indices.Length() >= capture_register_count);
+  NoSafepointScope no_safepoint;
+  memmove(indices.DataAddr(0), captures,
+          capture_register_count * sizeof(int32_t));
+  return true;
 }
 
 }  // namespace dart
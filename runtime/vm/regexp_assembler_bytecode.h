@@ -44,6 +44,10 @@ class BytecodeRegExpMacroAssembler : public RegExpMacroAssembler {
   virtual void PushRegister(intptr_t register_index);
   virtual void AdvanceRegister(intptr_t reg, intptr_t by);  // r[reg] += by.
   virtual void SetCurrentPositionFromEnd(intptr_t by);
+  // Advances the current position to the next occurrence of [c], or to the
+  // end of the subject if there is none. Only valid on entry, for regexps
+  // whose matches all start with [c].
+  void SkipUntilCharacter(uint16_t c);
   virtual void SetRegister(intptr_t register_index, intptr_t to);
   virtual void WriteCurrentPositionToRegister(intptr_t reg, intptr_t cp_offset);
   virtual void ClearRegisters(intptr_t reg_from, intptr_t reg_to);
@@ -113,6 +117,15 @@ class BytecodeRegExpMacroAssembler : public RegExpMacroAssembler {
                              bool is_sticky,
                              Zone* zone);
 
+  // As [Interpret], but stores the match indices in the Int32List [indices]
+  // instead of allocating a new one. Returns whether there was a match.
+  static bool InterpretInto(const RegExp& regexp,
+                            const String& str,
+                            const Smi& start_index,
+                            bool is_sticky,
+                            const TypedData& indices,
+                            Zone* zone);
+
  private:
   void Expand();
   // Code and bitmap emission.
@@ -24,6 +24,11 @@ DEFINE_FLAG(int,
             regexp_backtrack_stack_size_kb,
             256,
             "Size of backtracking stack");
+DEFINE_FLAG(int,
+            regexp_backtracks_before_fallback,
+            0,
+            "Give up on backtracking after this many backtracks and match the "
+            "regexp in linear time if it allows for it (0 means no limit).");
 
 typedef unibrow::Mapping<unibrow::Ecma262Canonicalize> Canonicalize;
 
@@ -177,13 +182,15 @@ class BacktrackStack {
 };
 
 // Returns True if success, False if failure, Null if internal exception,
-// Error if VM error needs to be propagated up the callchain.
+// Sentinel if [backtrack_limit] was exceeded, Error if VM error needs to be
+// propagated up the callchain.
 template <typename Char>
 static ObjectPtr RawMatch(const TypedData& bytecode,
                           const String& subject,
                           int32_t* registers,
                           int32_t current,
-                          uint32_t current_char) {
+                          uint32_t current_char,
+                          intptr_t backtrack_limit) {
   // BacktrackStack ensures that the memory allocated for the backtracking stack
   // is returned to the system or cached if there is no stack being cached at
   // the moment.
@@ -195,6 +202,8 @@ static ObjectPtr RawMatch(const TypedData& bytecode,
   int32_t* backtrack_stack_base = backtrack_stack.data();
   int32_t* backtrack_sp = backtrack_stack_base;
   intptr_t backtrack_stack_space = backtrack_stack.max_size();
+  intptr_t backtracks_left =
+      backtrack_limit > 0 ? backtrack_limit : kIntptrMax;
 
   // TODO(zerny): Optimize as single instance. V8 has this as an
   // isolate member.
@@ -292,6 +301,9 @@ static ObjectPtr RawMatch(const TypedData& bytecode,
         pc += BC_POP_CP_LENGTH;
         break;
         BYTECODE(POP_BT)
+        if (--backtracks_left < 0) {
+          return Object::sentinel().ptr();
+        }
         backtrack_stack_space++;
         --backtrack_sp;
         pc = code_base + *backtrack_sp;
@@ -679,6 +691,17 @@ static ObjectPtr RawMatch(const TypedData& bytecode,
           pc += BC_SET_CURRENT_POSITION_FROM_END_LENGTH;
           break;
         }
+        BYTECODE(SKIP_UNTIL_CHAR) {
+          const uint16_t c = static_cast<uint32_t>(insn) >> BYTECODE_SHIFT;
+          const intptr_t found =
+              IrregexpInterpreter::FindCharacter(subject, c, current);
+          if (found != current) {
+            current = found;
+            current_char = subject.CharAt(current - 1);
+          }
+          pc += BC_SKIP_UNTIL_CHAR_LENGTH;
+          break;
+        }
         default:
           UNREACHABLE();
           break;
@@ -687,12 +710,33 @@ static ObjectPtr RawMatch(const TypedData& bytecode,
   }
 }
 
+intptr_t IrregexpInterpreter::FindCharacter(const String& subject,
+                                           uint16_t c,
+                                           intptr_t from) {
+  const intptr_t length = subject.Length();
+  if (subject.IsOneByteString()) {
+    if (c > kMaxUint8 || from >= length) return length;
+    // memchr is vectorized by the C library.
+    const uint8_t* start = OneByteString::DataStart(subject);
+    const void* found = memchr(start + from, c, length - from);
+    if (found == nullptr) return length;
+    return static_cast<const uint8_t*>(found) - start;
+  }
+  const uint16_t* start = TwoByteString::DataStart(subject);
+  for (intptr_t i = from; i < length; i++) {
+    if (start[i] == c) return i;
+  }
+  return length;
+}
+
 // Returns True if success, False if failure, Null if internal exception,
-// Error if VM error needs to be propagated up the callchain.
+// Sentinel if [backtrack_limit] was exceeded, Error if VM error needs to be
+// propagated up the callchain.
 ObjectPtr IrregexpInterpreter::Match(const TypedData& bytecode,
                                      const String& subject,
                                      int32_t* registers,
-                                     int32_t start_position) {
+                                     int32_t start_position,
+                                     intptr_t backtrack_limit) {
   uint16_t previous_char = '\n';
   if (start_position != 0) {
     previous_char = subject.CharAt(start_position - 1);
@@ -700,10 +744,10 @@ ObjectPtr IrregexpInterpreter::Match(const TypedData& bytecode,
 
   if (subject.IsOneByteString()) {
     return RawMatch<uint8_t>(bytecode, subject, registers, start_position,
-                             previous_char);
+                             previous_char, backtrack_limit);
   } else if (subject.IsTwoByteString()) {
     return RawMatch<uint16_t>(bytecode, subject, registers, start_position,
-                              previous_char);
+                              previous_char, backtrack_limit);
   } else {
     UNREACHABLE();
     return Bool::False().ptr();
@@ -17,11 +17,20 @@ class IrregexpInterpreter : public AllStatic {
  public:
   // Returns True in case of a success, False in case of a failure,
   // Null in case of internal exception,
+  // Sentinel if more than [backtrack_limit] backtracks (if positive) were
+  // needed,
   // Error in case VM error has to propagated up to the caller.
   static ObjectPtr Match(const TypedData& bytecode,
                          const String& subject,
                          int32_t* captures,
-                         int32_t start_position);
+                         int32_t start_position,
+                         intptr_t backtrack_limit);
+
+  // Returns the position of the first [c] in [subject] at or after [from],
+  // or the length of [subject] if there is none.
+  static intptr_t FindCharacter(const String& subject,
+                                uint16_t c,
+                                intptr_t from);
 };
 
 }  // namespace dart
@@ -0,0 +1,533 @@
+// Copyright (c) 2024, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/regexp_linear.h"
+
+#include "vm/regexp_ast.h"
+#include "vm/regexp_parser.h"
+#include "vm/thread.h"
+
+namespace dart {
+
+// Bounded repetitions are unrolled, this limits the size of the result.
+static constexpr intptr_t kMaxProgramSize = 10000;
+
+// Limits the memory used for the registers of the simulated threads.
+static constexpr intptr_t kMaxThreadRegisters = 1 * MB;
+
+namespace {
+
+struct NfaInstruction {
+  enum Opcode {
+    // Consumes a character that is (or if negated is not) in one of the
+    // ranges [arg0, arg0 + arg1).
+    kConsume,
+    // Continues at arg0 and, with lower priority, at arg1.
+    kSplit,
+    // Continues at arg0.
+    kJump,
+    // Sets register arg0 to the current position.
+    kSave,
+    // Resets registers [arg0, arg1] to -1.
+    kClear,
+    // Continues only if the RegExpAssertion::AssertionType arg0 holds.
+    kAssert,
+    // Reports a match.
+    kAccept,
+  };
+
+  Opcode opcode;
+  bool negated;
+  int32_t arg0;
+  int32_t arg1;
+};
+
+// Translates a regexp tree into a program for the NFA simulation. The
+// program tries alternatives in the same order as the backtracking engine.
+class LinearCompiler : public RegExpVisitor {
+ public:
+  LinearCompiler() : code_(), ranges_(), too_large_(false) {}
+
+  // Returns false if the program would be too large.
+  bool Compile(RegExpTree* tree) {
+    Emit(NfaInstruction::kSave, RegExpCapture::StartRegister(0));
+    tree->Accept(this, nullptr);
+    Emit(NfaInstruction::kSave, RegExpCapture::EndRegister(0));
+    Emit(NfaInstruction::kAccept);
+    return !too_large_;
+  }
+
+  const GrowableArray<NfaInstruction>& code() const { return code_; }
+  const GrowableArray<CharacterRange>& ranges() const { return ranges_; }
+
+  void* VisitDisjunction(RegExpDisjunction* that, void* data) {
+    ZoneGrowableArray<RegExpTree*>* alternatives = that->alternatives();
+    GrowableArray<intptr_t> jumps;
+    for (intptr_t i = 0; i < alternatives->length() - 1; i++) {
+      const intptr_t split = Emit(NfaInstruction::kSplit);
+      code_[split].arg0 = pc();
+      alternatives->At(i)->Accept(this, data);
+      jumps.Add(Emit(NfaInstruction::kJump));
+      code_[split].arg1 = pc();
+    }
+    alternatives->Last()->Accept(this, data);
+    for (intptr_t i = 0; i < jumps.length(); i++) {
+      code_[jumps[i]].arg0 = pc();
+    }
+    return nullptr;
+  }
+
+  void* VisitAlternative(RegExpAlternative* that, void* data) {
+    ZoneGrowableArray<RegExpTree*>* nodes = that->nodes();
+    for (intptr_t i = 0; i < nodes->length(); i++) {
+      nodes->At(i)->Accept(this, data);
+    }
+    return nullptr;
+  }
+
+  void* VisitAssertion(RegExpAssertion* that, void* data) {
+    Emit(NfaInstruction::kAssert, that->assertion_type());
+    return nullptr;
+  }
+
+  void* VisitCharacterClass(RegExpCharacterClass* that, void* data) {
+    ZoneGrowableArray<CharacterRange>* ranges = that->ranges();
+    const intptr_t start = ranges_.length();
+    for (intptr_t i = 0; i < ranges->length(); i++) {
+      ranges_.Add(ranges->At(i));
+    }
+    const intptr_t consume =
+        Emit(NfaInstruction::kConsume, start, ranges->length());
+    code_[consume].negated = that->is_negated();
+    return nullptr;
+  }
+
+  void* VisitAtom(RegExpAtom* that, void* data) {
+    ZoneGrowableArray<uint16_t>* chars = that->data();
+    for (intptr_t i = 0; i < chars->length(); i++) {
+      ranges_.Add(CharacterRange::Singleton(chars->At(i)));
+      Emit(NfaInstruction::kConsume, ranges_.length() - 1, 1);
+    }
+    return nullptr;
+  }
+
+  void* VisitQuantifier(RegExpQuantifier* that, void* data) {
+    RegExpTree* body = that->body();
+    const Interval captures = body->CaptureRegisters();
+    const bool greedy = !that->is_non_greedy();
+    for (intptr_t i = 0; i < that->min() && !too_large_; i++) {
+      EmitIteration(body, captures, data);
+    }
+    if (that->max() == RegExpTree::kInfinity) {
+      const intptr_t loop = Emit(NfaInstruction::kSplit);
+      const intptr_t iteration = pc();
+      EmitIteration(body, captures, data);
+      Emit(NfaInstruction::kJump, loop);
+      PatchSplit(loop, iteration, pc(), greedy);
+    } else {
+      GrowableArray<intptr_t> splits;
+      for (intptr_t i = that->min(); i < that->max() && !too_large_; i++) {
+        splits.Add(Emit(NfaInstruction::kSplit));
+        EmitIteration(body, captures, data);
+      }
+      for (intptr_t i = 0; i < splits.length(); i++) {
+        PatchSplit(splits[i], splits[i] + 1, pc(), greedy);
+      }
+    }
+    return nullptr;
+  }
+
+  void* VisitCapture(RegExpCapture* that, void* data) {
+    Emit(NfaInstruction::kSave, RegExpCapture::StartRegister(that->index()));
+    that->body()->Accept(this, data);
+    Emit(NfaInstruction::kSave, RegExpCapture::EndRegister(that->index()));
+    return nullptr;
+  }
+
+  void* VisitLookaround(RegExpLookaround* that, void* data) {
+    UNREACHABLE();
+    return nullptr;
+  }
+
+  void* VisitBackReference(RegExpBackReference* that, void* data) {
+    UNREACHABLE();
+    return nullptr;
+  }
+
+  void* VisitEmpty(RegExpEmpty* that, void* data) { return nullptr; }
+
+  void* VisitText(RegExpText* that, void* data) {
+    GrowableArray<TextElement>* elements = that->elements();
+    for (intptr_t i = 0; i < elements->length(); i++) {
+      elements->At(i).tree()->Accept(this, data);
+    }
+    return nullptr;
+  }
+
+ private:
+  intptr_t pc() const { return code_.length(); }
+
+  intptr_t Emit(NfaInstruction::Opcode opcode,
+                intptr_t arg0 = 0,
+                intptr_t arg1 = 0) {
+    if (code_.length() >= kMaxProgramSize) {
+      // Keep emitting into the last slot so that patching stays in bounds.
+      too_large_ = true;
+      return code_.length() - 1;
+    }
+    NfaInstruction instruction = {opcode, false, static_cast<int32_t>(arg0),
+                                  static_cast<int32_t>(arg1)};
+    code_.Add(instruction);
+    return code_.length() - 1;
+  }
+
+  // Captures inside a quantified expression are reset on every iteration.
+  void EmitIteration(RegExpTree* body, Interval captures, void* data) {
+    if (!captures.is_empty()) {
+      Emit(NfaInstruction::kClear, captures.from(), captures.to());
+    }
+    body->Accept(this, data);
+  }
+
+  void PatchSplit(intptr_t split, intptr_t body, intptr_t exit, bool greedy) {
+    code_[split].arg0 = greedy ? body : exit;
+    code_[split].arg1 = greedy ? exit : body;
+  }
+
+  GrowableArray<NfaInstruction> code_;
+  GrowableArray<CharacterRange> ranges_;
+  bool too_large_;
+
+  DISALLOW_COPY_AND_ASSIGN(LinearCompiler);
+};
+
+// The threads of the simulation that wait for the next character, in priority
+// order, each with its own copy of the registers.
+class ThreadList : public ValueObject {
+ public:
+  ThreadList(Zone* zone, intptr_t capacity, intptr_t num_registers)
+      : length_(0),
+        num_registers_(num_registers),
+        pcs_(zone->Alloc<int32_t>(capacity)),
+        registers_(zone->Alloc<int32_t>(capacity * num_registers)) {}
+
+  intptr_t length() const { return length_; }
+  int32_t pc(intptr_t i) const { return pcs_[i]; }
+  int32_t* registers(intptr_t i) const {
+    return &registers_[i * num_registers_];
+  }
+
+  void Add(int32_t pc, const int32_t* registers) {
+    pcs_[length_] = pc;
+    memmove(this->registers(length_), registers,
+            num_registers_ * sizeof(int32_t));
+    length_++;
+  }
+  void Clear() { length_ = 0; }
+
+ private:
+  intptr_t length_;
+  const intptr_t num_registers_;
+  int32_t* const pcs_;
+  int32_t* const registers_;
+
+  DISALLOW_COPY_AND_ASSIGN(ThreadList);
+};
+
+static bool IsLineTerminator(int32_t c) {
+  return c == '\n' || c == '\r' || c == 0x2028 || c == 0x2029;
+}
+
+static bool IsWordCharacter(int32_t c) {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+         (c >= '0' && c <= '9') || c == '_';
+}
+
+class NfaSimulation : public ValueObject {
+ public:
+  NfaSimulation(Zone* zone,
+                const LinearCompiler& compiler,
+                intptr_t num_registers,
+                intptr_t num_threads)
+      : code_(compiler.code()),
+        ranges_(compiler.ranges()),
+        num_registers_(num_registers),
+        list_a_(zone, num_threads, num_registers),
+        list_b_(zone, num_threads, num_registers),
+        visited_(zone->Alloc<int32_t>(compiler.code().length())),
+        generation_(0),
+        scratch_(zone->Alloc<int32_t>(num_registers)),
+        stack_() {
+    for (intptr_t i = 0; i < code_.length(); i++) {
+      visited_[i] = -1;
+    }
+  }
+
+  ObjectPtr Run(const String& subject,
+                intptr_t start_position,
+                bool sticky,
+                int32_t* captures) {
+    Thread* thread = Thread::Current();
+    const intptr_t length = subject.Length();
+    ThreadList* current = &list_a_;
+    ThreadList* next = &list_b_;
+    bool matched = false;
+    for (intptr_t pos = start_position; pos <= length; pos++) {
+      if (UNLIKELY(thread->HasScheduledInterrupts())) {
+        ErrorPtr error = thread->HandleInterrupts();
+        if (error != Object::null()) {
+          return error;
+        }
+      }
+      // A new attempt starting here has the lowest priority, the ones that
+      // started earlier give leftmost matches.
+      if (!matched && (!sticky || pos == start_position)) {
+        for (intptr_t i = 0; i < num_registers_; i++) {
+          scratch_[i] = -1;
+        }
+        AddThread(current, 0, subject, pos);
+      }
+      if (current->length() == 0) {
+        if (matched || sticky) break;
+        generation_++;
+        continue;
+      }
+
+      generation_++;
+      next->Clear();
+      const int32_t c = pos < length ? subject.CharAt(pos) : -1;
+      for (intptr_t i = 0; i < current->length(); i++) {
+        const NfaInstruction& instruction = code_[current->pc(i)];
+        if (instruction.opcode == NfaInstruction::kAccept) {
+          // Threads with lower priority than a match are dropped.
+          memmove(captures, current->registers(i),
+                  num_registers_ * sizeof(int32_t));
+          matched = true;
+          break;
+        }
+        ASSERT(instruction.opcode == NfaInstruction::kConsume);
+        if (c >= 0 && Matches(instruction, c)) {
+          memmove(scratch_, current->registers(i),
+                  num_registers_ * sizeof(int32_t));
+          AddThread(next, current->pc(i) + 1, subject, pos + 1);
+        }
+      }
+      ThreadList* temp = current;
+      current = next;
+      next = temp;
+    }
+    return Bool::Get(matched).ptr();
+  }
+
+ private:
+  struct Job {
+    // The instruction to follow, or -1 to restore [reg] to [value].
+    int32_t pc;
+    int32_t reg;
+    int32_t value;
+  };
+
+  // Follows the instructions that do not consume characters from [pc] with
+  // the registers in scratch_, adding the threads that reach a consuming
+  // instruction or a match to [list].
+  void AddThread(ThreadList* list,
+                 int32_t pc,
+                 const String& subject,
+                 intptr_t pos) {
+    PushFollow(pc);
+    while (!stack_.is_empty()) {
+      const Job job = stack_.RemoveLast();
+      if (job.pc < 0) {
+        scratch_[job.reg] = job.value;
+        continue;
+      }
+      if (visited_[job.pc] == generation_) continue;
+      visited_[job.pc] = generation_;
+      const NfaInstruction& instruction = code_[job.pc];
+      switch (instruction.opcode) {
+        case NfaInstruction::kConsume:
+        case NfaInstruction::kAccept:
+          list->Add(job.pc, scratch_);
+          break;
+        case NfaInstruction::kSplit:
+          PushFollow(instruction.arg1);
+          PushFollow(instruction.arg0);
+          break;
+        case NfaInstruction::kJump:
+          PushFollow(instruction.arg0);
+          break;
+        case NfaInstruction::kSave:
+          PushRestore(instruction.arg0);
+          scratch_[instruction.arg0] = pos;
+          PushFollow(job.pc + 1);
+          break;
+        case NfaInstruction::kClear:
+          for (int32_t reg = instruction.arg0; reg <= instruction.arg1; reg++) {
+            PushRestore(reg);
+            scratch_[reg] = -1;
+          }
+          PushFollow(job.pc + 1);
+          break;
+        case NfaInstruction::kAssert:
+          if (AssertionHolds(instruction.arg0, subject, pos)) {
+            PushFollow(job.pc + 1);
+          }
+          break;
+      }
+    }
+  }
+
+  void PushFollow(int32_t pc) {
+    Job job = {pc, -1, 0};
+    stack_.Add(job);
+  }
+
+  // Restores the current value of [reg] once the instructions pushed after
+  // it are followed.
+  void PushRestore(int32_t reg) {
+    Job job = {-1, reg, scratch_[reg]};
+    stack_.Add(job);
+  }
+
+  bool Matches(const NfaInstruction& instruction, int32_t c) const {
+    for (intptr_t i = instruction.arg0; i < instruction.arg0 + instruction.arg1;
+         i++) {
+      if (ranges_[i].Contains(c)) return !instruction.negated;
+    }
+    return instruction.negated;
+  }
+
+  static bool AssertionHolds(int32_t type,
+                             const String& subject,
+                             intptr_t pos) {
+    const intptr_t length = subject.Length();
+    switch (type) {
+      case RegExpAssertion::START_OF_INPUT:
+        return pos == 0;
+      case RegExpAssertion::END_OF_INPUT:
+        return pos == length;
+      case RegExpAssertion::START_OF_LINE:
+        return pos == 0 || IsLineTerminator(subject.CharAt(pos - 1));
+      case RegExpAssertion::END_OF_LINE:
+        return pos == length || IsLineTerminator(subject.CharAt(pos));
+      case RegExpAssertion::BOUNDARY:
+      case RegExpAssertion::NON_BOUNDARY: {
+        const bool before = pos > 0 && IsWordCharacter(subject.CharAt(pos - 1));
+        const bool after = pos < length && IsWordCharacter(subject.CharAt(pos));
+        return (before != after) == (type == RegExpAssertion::BOUNDARY);
+      }
+    }
+    UNREACHABLE();
+    return false;
+  }
+
+  const GrowableArray<NfaInstruction>& code_;
+  const GrowableArray<CharacterRange>& ranges_;
+  const intptr_t num_registers_;
+  ThreadList list_a_;
+  ThreadList list_b_;
+  // The generation in which each instruction was last followed, so that
+  // every instruction is reached by at most one thread per position.
+  int32_t* const visited_;
+  int32_t generation_;
+  int32_t* const scratch_;
+  GrowableArray<Job> stack_;
+
+  DISALLOW_COPY_AND_ASSIGN(NfaSimulation);
+};
+
+}  // namespace
+
+static bool CanHandleFlags(RegExpFlags flags) {
+  return !flags.IgnoreCase() && !flags.IsUnicode();
+}
+
+static bool CanHandleTree(RegExpTree* tree) {
+  if (tree->IsDisjunction()) {
+    ZoneGrowableArray<RegExpTree*>* alternatives =
+        tree->AsDisjunction()->alternatives();
+    for (intptr_t i = 0; i < alternatives->length(); i++) {
+      if (!CanHandleTree(alternatives->At(i))) return false;
+    }
+    return true;
+  }
+  if (tree->IsAlternative()) {
+    ZoneGrowableArray<RegExpTree*>* nodes = tree->AsAlternative()->nodes();
+    for (intptr_t i = 0; i < nodes->length(); i++) {
+      if (!CanHandleTree(nodes->At(i))) return false;
+    }
+    return true;
+  }
+  if (tree->IsText()) {
+    GrowableArray<TextElement>* elements = tree->AsText()->elements();
+    for (intptr_t i = 0; i < elements->length(); i++) {
+      if (!CanHandleTree(elements->At(i).tree())) return false;
+    }
+    return true;
+  }
+  if (tree->IsAtom()) {
+    return CanHandleFlags(tree->AsAtom()->flags());
+  }
+  if (tree->IsCharacterClass()) {
+    return CanHandleFlags(tree->AsCharacterClass()->flags());
+  }
+  if (tree->IsQuantifier()) {
+    RegExpQuantifier* quantifier = tree->AsQuantifier();
+    // Optional iterations that match the empty string are rejected, which
+    // makes the result depend on more than the position in the program.
+    if (quantifier->is_possessive() ||
+        (quantifier->max() > quantifier->min() &&
+         quantifier->body()->min_match() == 0)) {
+      return false;
+    }
+    return CanHandleTree(quantifier->body());
+  }
+  if (tree->IsCapture()) {
+    return CanHandleTree(tree->AsCapture()->body());
+  }
+  return tree->IsAssertion() || tree->IsEmpty();
+}
+
+bool LinearRegExpMatcher::CanHandle(RegExpTree* tree, RegExpFlags flags) {
+  return CanHandleFlags(flags) && CanHandleTree(tree);
+}
+
+ObjectPtr LinearRegExpMatcher::Match(const RegExp& regexp,
+                                     const String& subject,
+                                     int32_t* captures,
+                                     int32_t start_position,
+                                     bool sticky,
+                                     Zone* zone) {
+  const String& pattern = String::Handle(zone, regexp.pattern());
+  RegExpCompileData* compile_data = new (zone) RegExpCompileData();
+  // Parsing failures are handled in the RegExp factory constructor.
+  RegExpParser::ParseRegExp(pattern, regexp.flags(), compile_data);
+  if (!CanHandle(compile_data->tree, regexp.flags())) {
+    return Object::null();
+  }
+
+  LinearCompiler compiler;
+  if (!compiler.Compile(compile_data->tree)) {
+    return Object::null();
+  }
+
+  // Only consuming instructions and matches end up in the thread lists.
+  intptr_t num_threads = 0;
+  for (intptr_t i = 0; i < compiler.code().length(); i++) {
+    const NfaInstruction::Opcode opcode = compiler.code()[i].opcode;
+    if ((opcode == NfaInstruction::kConsume) ||
+        (opcode == NfaInstruction::kAccept)) {
+      num_threads++;
+    }
+  }
+  const intptr_t num_registers = (compile_data->capture_count + 1) * 2;
+  if (num_threads * num_registers > kMaxThreadRegisters) {
+    return Object::null();
+  }
+
+  NfaSimulation simulation(zone, compiler, num_registers, num_threads);
+  return simulation.Run(subject, start_position, sticky, captures);
+}
+
+}  // namespace dart
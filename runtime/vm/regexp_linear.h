@@ -0,0 +1,47 @@
+// Copyright (c) 2024, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// A regexp matcher that does not backtrack and runs in time linear in the
+// length of the subject.
+
+#ifndef RUNTIME_VM_REGEXP_LINEAR_H_
+#define RUNTIME_VM_REGEXP_LINEAR_H_
+
+#include "vm/allocation.h"
+#include "vm/object.h"
+#include "vm/regexp.h"
+#include "vm/zone.h"
+
+namespace dart {
+
+// Simulates an NFA compiled from the regexp tree (a Pike VM), tracking all
+// alternatives in lock step in the order the backtracking engine would try
+// them, so the results are the same as irregexp's.
+//
+// Only a subset of regexps is supported: no back references, lookarounds,
+// case insensitive or unicode matching, and no optional repetitions of
+// subexpressions that can match the empty string.
+class LinearRegExpMatcher : public AllStatic {
+ public:
+  // Returns whether [tree] can be matched by this matcher.
+  static bool CanHandle(RegExpTree* tree, RegExpFlags flags);
+
+  // Matches [regexp] against [subject] starting at [start_position], only at
+  // that position if [sticky]. On success [captures] holds the start and end
+  // of each capture, -1 for those that did not participate.
+  //
+  // Returns True in case of a success, False in case of a failure,
+  // Null if the regexp can not be handled by this matcher,
+  // Error in case VM error has to propagated up to the caller.
+  static ObjectPtr Match(const RegExp& regexp,
+                         const String& subject,
+                         int32_t* captures,
+                         int32_t start_position,
+                         bool sticky,
+                         Zone* zone);
+};
+
+}  // namespace dart
+
+#endif  // RUNTIME_VM_REGEXP_LINEAR_H_
@@ -7,11 +7,16 @@
 #include "vm/isolate.h"
 #include "vm/object.h"
 #include "vm/regexp.h"
+#include "vm/regexp_assembler_bytecode.h"
 #include "vm/regexp_assembler_ir.h"
+#include "vm/regexp_interpreter.h"
+#include "vm/regexp_linear.h"
 #include "vm/unit_test.h"
 
 namespace dart {
 
+DECLARE_FLAG(int, regexp_backtracks_before_fallback);
+
 static ArrayPtr Match(const String& pat, const String& str) {
   Thread* thread = Thread::Current();
   Zone* zone = thread->zone();
@@ -66,4 +71,181 @@ ISOLATE_UNIT_TEST_CASE(RegExp_TwoByteString) {
   EXPECT_EQ(3, smi_2.Value());
 }
 
+ISOLATE_UNIT_TEST_CASE(RegExp_TierUp) {
+  if (FLAG_interpret_irregexp) return;
+  SetFlagScope<int> sfs(&FLAG_regexp_tier_up_threshold, 2);
+
+  const String& str = String::Handle(String::New("abcba"));
+  const String& pat = String::Handle(String::New("bc"));
+  const RegExp& regexp =
+      RegExp::Handle(RegExpEngine::CreateRegExp(thread, pat, RegExpFlags()));
+  const intptr_t cid = str.GetClassId();
+  Object& code = Object::Handle(regexp.function(cid, /*sticky=*/false));
+  EXPECT(code.IsNull());
+
+  // The first uses are interpreted and install bytecode in the slot.
+  for (intptr_t i = 0; i < 2; i++) {
+    EXPECT(!RegExpEngine::TierUpIfNeeded(thread, regexp, cid,
+                                         /*sticky=*/false));
+    const TypedData& res =
+        TypedData::Handle(TypedData::RawCast(
+            BytecodeRegExpMacroAssembler::Interpret(regexp, str,
+                                                    Object::smi_zero(),
+                                                    /*sticky=*/false,
+                                                    thread->zone())));
+    EXPECT_EQ(2, res.Length());
+    EXPECT_EQ(1, res.GetInt32(0));
+    EXPECT_EQ(3, res.GetInt32(sizeof(int32_t)));
+    code = regexp.function(cid, /*sticky=*/false);
+    EXPECT(code.IsTypedData());
+  }
+
+  // Then the regexp is compiled; the sticky variant is tiered up separately
+  // but shares the count.
+  EXPECT(RegExpEngine::TierUpIfNeeded(thread, regexp, cid, /*sticky=*/false));
+  code = regexp.function(cid, /*sticky=*/false);
+  EXPECT(code.IsFunction());
+  code = regexp.function(cid, /*sticky=*/true);
+  EXPECT(code.IsNull());
+
+  const Array& res = Array::Handle(IRRegExpMacroAssembler::Execute(
+      regexp, str, Object::smi_zero(), /*sticky=*/false, thread->zone()));
+  EXPECT_EQ(2, res.Length());
+  EXPECT_EQ(Smi::New(1), res.At(0));
+  EXPECT_EQ(Smi::New(3), res.At(1));
+}
+
+// Runs the linear matcher and returns the number of captures or -1 if the
+// regexp is not supported.
+static intptr_t LinearMatch(const char* pattern,
+                            const char* subject,
+                            bool sticky,
+                            int32_t* captures) {
+  Thread* thread = Thread::Current();
+  const RegExp& regexp = RegExp::Handle(RegExpEngine::CreateRegExp(
+      thread, String::Handle(String::New(pattern)), RegExpFlags()));
+  const Object& result = Object::Handle(LinearRegExpMatcher::Match(
+      regexp, String::Handle(String::New(subject)), captures,
+      /*start_position=*/0, sticky, thread->zone()));
+  if (result.IsNull()) return -1;
+  return Bool::Cast(result).value() ? 1 : 0;
+}
+
+ISOLATE_UNIT_TEST_CASE(RegExp_LinearMatcher) {
+  int32_t captures[8];
+
+  // Alternatives and quantifiers are prioritized like in irregexp.
+  EXPECT_EQ(1, LinearMatch("(a|ab)(c|bcd)(d*)", "abcd", false, captures));
+  EXPECT_EQ(0, captures[0]);
+  EXPECT_EQ(4, captures[1]);
+  EXPECT_EQ(0, captures[2]);
+  EXPECT_EQ(1, captures[3]);
+  EXPECT_EQ(1, captures[4]);
+  EXPECT_EQ(4, captures[5]);
+  EXPECT_EQ(4, captures[6]);
+  EXPECT_EQ(4, captures[7]);
+
+  EXPECT_EQ(1, LinearMatch("a+?", "baaa", false, captures));
+  EXPECT_EQ(1, captures[0]);
+  EXPECT_EQ(2, captures[1]);
+
+  // Captures are reset on every iteration.
+  EXPECT_EQ(1, LinearMatch("(?:(a)|b)+", "ab", false, captures));
+  EXPECT_EQ(0, captures[0]);
+  EXPECT_EQ(2, captures[1]);
+  EXPECT_EQ(-1, captures[2]);
+  EXPECT_EQ(-1, captures[3]);
+
+  EXPECT_EQ(1, LinearMatch("\\bfoo\\b", "a foo", false, captures));
+  EXPECT_EQ(2, captures[0]);
+  EXPECT_EQ(5, captures[1]);
+  EXPECT_EQ(0, LinearMatch("\\bfoo\\b", "afoo", false, captures));
+
+  EXPECT_EQ(0, LinearMatch("b", "ab", true, captures));
+  EXPECT_EQ(1, LinearMatch("a[^b]{2,3}", "accb", true, captures));
+  EXPECT_EQ(0, captures[0]);
+  EXPECT_EQ(3, captures[1]);
+  EXPECT_EQ(1, LinearMatch("a[^b]{2,3}", "xaccca", false, captures));
+  EXPECT_EQ(1, captures[0]);
+  EXPECT_EQ(5, captures[1]);
+
+  EXPECT_EQ(-1, LinearMatch("(a)\\1", "aa", false, captures));
+  EXPECT_EQ(-1, LinearMatch("a(?=b)", "ab", false, captures));
+  EXPECT_EQ(-1, LinearMatch("(a*)*b", "aab", false, captures));
+}
+
+ISOLATE_UNIT_TEST_CASE(RegExp_BacktrackLimit) {
+  SetFlagScope<bool> sfs_interpret(&FLAG_interpret_irregexp, true);
+  SetFlagScope<int> sfs_limit(&FLAG_regexp_backtracks_before_fallback, 1000);
+
+  const String& pat = String::Handle(String::New("(a+)+b"));
+  const RegExp& regexp =
+      RegExp::Handle(RegExpEngine::CreateRegExp(thread, pat, RegExpFlags()));
+
+  // Exponential for the backtracking engine.
+  const String& no_match =
+      String::Handle(String::New("aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"));
+  EXPECT(BytecodeRegExpMacroAssembler::Interpret(regexp, no_match,
+                                                 Object::smi_zero(),
+                                                 /*sticky=*/false,
+                                                 thread->zone()) ==
+         Object::null());
+
+  const String& match = String::Handle(String::New("aaaaaaaaaaaaaaaaaaaab"));
+  const TypedData& res =
+      TypedData::Handle(TypedData::RawCast(
+          BytecodeRegExpMacroAssembler::Interpret(regexp, match,
+                                                  Object::smi_zero(),
+                                                  /*sticky=*/false,
+                                                  thread->zone())));
+  EXPECT_EQ(4, res.Length());
+  EXPECT_EQ(0, res.GetInt32(0 * sizeof(int32_t)));
+  EXPECT_EQ(21, res.GetInt32(1 * sizeof(int32_t)));
+  EXPECT_EQ(0, res.GetInt32(2 * sizeof(int32_t)));
+  EXPECT_EQ(20, res.GetInt32(3 * sizeof(int32_t)));
+}
+
+ISOLATE_UNIT_TEST_CASE(RegExp_FindCharacter) {
+  const String& one_byte = String::Handle(String::New("abcabc"));
+  EXPECT_EQ(2, IrregexpInterpreter::FindCharacter(one_byte, 'c', 0));
+  EXPECT_EQ(5, IrregexpInterpreter::FindCharacter(one_byte, 'c', 3));
+  EXPECT_EQ(6, IrregexpInterpreter::FindCharacter(one_byte, 'd', 0));
+  EXPECT_EQ(6, IrregexpInterpreter::FindCharacter(one_byte, 0x100, 0));
+  EXPECT_EQ(6, IrregexpInterpreter::FindCharacter(one_byte, 'a', 6));
+
+  const uint16_t chars[] = {'a', 0x100, 'b', 0x100};
+  const String& two_byte =
+      String::Handle(String::FromUTF16(chars, ARRAY_SIZE(chars)));
+  EXPECT(two_byte.IsTwoByteString());
+  EXPECT_EQ(1, IrregexpInterpreter::FindCharacter(two_byte, 0x100, 0));
+  EXPECT_EQ(3, IrregexpInterpreter::FindCharacter(two_byte, 0x100, 2));
+  EXPECT_EQ(4, IrregexpInterpreter::FindCharacter(two_byte, 'c', 0));
+}
+
+// Returns the start of the first match or -1.
+static intptr_t InterpretedMatchStart(const char* pattern,
+                                      const char* subject,
+                                      intptr_t start) {
+  Thread* thread = Thread::Current();
+  const RegExp& regexp = RegExp::Handle(RegExpEngine::CreateRegExp(
+      thread, String::Handle(String::New(pattern)), RegExpFlags()));
+  const TypedData& res = TypedData::Handle(
+      TypedData::RawCast(BytecodeRegExpMacroAssembler::Interpret(
+          regexp, String::Handle(String::New(subject)),
+          Smi::Handle(Smi::New(start)), /*sticky=*/false, thread->zone())));
+  return res.IsNull() ? -1 : res.GetInt32(0);
+}
+
+ISOLATE_UNIT_TEST_CASE(RegExp_SkipToFirstCharacter) {
+  SetFlagScope<bool> sfs(&FLAG_interpret_irregexp, true);
+
+  EXPECT_EQ(4, InterpretedMatchStart("foo", "fofofoo", 0));
+  EXPECT_EQ(-1, InterpretedMatchStart("foo", "fofofo", 0));
+  EXPECT_EQ(7, InterpretedMatchStart("foo", "foo.fo.foo", 1));
+  EXPECT_EQ(3, InterpretedMatchStart("(?:ab|ac)+", "aadac", 0));
+  EXPECT_EQ(4, InterpretedMatchStart("\\bab", "dab ab", 0));
+  EXPECT_EQ(4, InterpretedMatchStart("(?<=b)a", "aaaba", 0));
+  EXPECT_EQ(0, InterpretedMatchStart("a?b", "bab", 0));
+}
+
 }  // namespace dart
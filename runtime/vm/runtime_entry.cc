@@ -352,6 +352,19 @@ static Heap::Space SpaceForRuntimeAllocation() {
   return UNLIKELY(FLAG_runtime_allocate_old) ? Heap::kOld : Heap::kNew;
 }
 
+// Allocation stubs and inlined allocations of pretenured classes fall
+// through to the runtime, which places the instance directly in old space.
+static Heap::Space SpaceForRuntimeAllocation(Thread* thread, intptr_t cid) {
+#if !defined(PRODUCT)
+  if (UNLIKELY(
+          thread->isolate_group()->class_table()->ShouldPretenureAllocationFor(
+              cid))) {
+    return Heap::kOld;
+  }
+#endif  // !defined(PRODUCT)
+  return SpaceForRuntimeAllocation();
+}
+
 static void RuntimeAllocationEpilogue(Thread* thread) {
   if (UNLIKELY(FLAG_runtime_allocate_spill_tlab)) {
     static RelaxedAtomic<uword> count = 0;
@@ -389,7 +402,8 @@ DEFINE_RUNTIME_ENTRY(AllocateArray, 2) {
 
   const Array& array = Array::Handle(
       zone,
-      Array::New(static_cast<intptr_t>(len), SpaceForRuntimeAllocation()));
+      Array::New(static_cast<intptr_t>(len),
+                 SpaceForRuntimeAllocation(thread, kArrayCid)));
   TypeArguments& element_type =
       TypeArguments::CheckedHandle(zone, arguments.ArgAt(1));
   // An Array is raw or takes one type argument. However, its type argument
@@ -406,29 +420,31 @@ DEFINE_RUNTIME_ENTRY_NO_LAZY_DEOPT(AllocateDouble, 0) {
   if (FLAG_shared_slow_path_triggers_gc) {
     isolate->group()->heap()->CollectAllGarbage(GCReason::kDebugging);
   }
-  arguments.SetReturn(
-      Object::Handle(zone, Double::New(0.0, SpaceForRuntimeAllocation())));
+  arguments.SetReturn(Object::Handle(
+      zone, Double::New(0.0, SpaceForRuntimeAllocation(thread, kDoubleCid))));
   RuntimeAllocationEpilogue(thread);
 }
 
 DEFINE_RUNTIME_ENTRY_NO_LAZY_DEOPT(BoxDouble, 0) {
   const double val = thread->unboxed_double_runtime_arg();
-  arguments.SetReturn(
-      Object::Handle(zone, Double::New(val, SpaceForRuntimeAllocation())));
+  arguments.SetReturn(Object::Handle(
+      zone, Double::New(val, SpaceForRuntimeAllocation(thread, kDoubleCid))));
   RuntimeAllocationEpilogue(thread);
 }
 
 DEFINE_RUNTIME_ENTRY_NO_LAZY_DEOPT(BoxFloat32x4, 0) {
   const auto val = thread->unboxed_simd128_runtime_arg();
-  arguments.SetReturn(
-      Object::Handle(zone, Float32x4::New(val, SpaceForRuntimeAllocation())));
+  arguments.SetReturn(Object::Handle(
+      zone,
+      Float32x4::New(val, SpaceForRuntimeAllocation(thread, kFloat32x4Cid))));
   RuntimeAllocationEpilogue(thread);
 }
 
 DEFINE_RUNTIME_ENTRY_NO_LAZY_DEOPT(BoxFloat64x2, 0) {
   const auto val = thread->unboxed_simd128_runtime_arg();
-  arguments.SetReturn(
-      Object::Handle(zone, Float64x2::New(val, SpaceForRuntimeAllocation())));
+  arguments.SetReturn(Object::Handle(
+      zone,
+      Float64x2::New(val, SpaceForRuntimeAllocation(thread, kFloat64x2Cid))));
   RuntimeAllocationEpilogue(thread);
 }
 
@@ -437,7 +453,8 @@ DEFINE_RUNTIME_ENTRY_NO_LAZY_DEOPT(AllocateMint, 0) {
     isolate->group()->heap()->CollectAllGarbage(GCReason::kDebugging);
   }
   arguments.SetReturn(Object::Handle(
-      zone, Integer::New(kMaxInt64, SpaceForRuntimeAllocation())));
+      zone,
+      Integer::New(kMaxInt64, SpaceForRuntimeAllocation(thread, kMintCid))));
   RuntimeAllocationEpilogue(thread);
 }
 
@@ -446,7 +463,8 @@ DEFINE_RUNTIME_ENTRY_NO_LAZY_DEOPT(AllocateFloat32x4, 0) {
     isolate->group()->heap()->CollectAllGarbage(GCReason::kDebugging);
   }
   arguments.SetReturn(Object::Handle(
-      zone, Float32x4::New(0.0, 0.0, 0.0, 0.0, SpaceForRuntimeAllocation())));
+      zone, Float32x4::New(0.0, 0.0, 0.0, 0.0,
+                           SpaceForRuntimeAllocation(thread, kFloat32x4Cid))));
   RuntimeAllocationEpilogue(thread);
 }
 
@@ -455,7 +473,8 @@ DEFINE_RUNTIME_ENTRY_NO_LAZY_DEOPT(AllocateFloat64x2, 0) {
     isolate->group()->heap()->CollectAllGarbage(GCReason::kDebugging);
   }
   arguments.SetReturn(Object::Handle(
-      zone, Float64x2::New(0.0, 0.0, SpaceForRuntimeAllocation())));
+      zone, Float64x2::New(0.0, 0.0,
+                           SpaceForRuntimeAllocation(thread, kFloat64x2Cid))));
   RuntimeAllocationEpilogue(thread);
 }
 
@@ -464,7 +483,8 @@ DEFINE_RUNTIME_ENTRY_NO_LAZY_DEOPT(AllocateInt32x4, 0) {
     isolate->group()->heap()->CollectAllGarbage(GCReason::kDebugging);
   }
   arguments.SetReturn(Object::Handle(
-      zone, Int32x4::New(0, 0, 0, 0, SpaceForRuntimeAllocation())));
+      zone, Int32x4::New(0, 0, 0, 0,
+                         SpaceForRuntimeAllocation(thread, kInt32x4Cid))));
   RuntimeAllocationEpilogue(thread);
 }
 
@@ -489,7 +509,8 @@ DEFINE_RUNTIME_ENTRY(AllocateTypedData, 2) {
   }
   const auto& typed_data =
       TypedData::Handle(zone, TypedData::New(cid, static_cast<intptr_t>(len),
-                                             SpaceForRuntimeAllocation()));
+                                             SpaceForRuntimeAllocation(
+                                                 thread, cid)));
   arguments.SetReturn(typed_data);
   RuntimeAllocationEpilogue(thread);
 }
@@ -519,7 +540,8 @@ DEFINE_RUNTIME_ENTRY(AllocateObject, 2) {
   const Class& cls = Class::CheckedHandle(zone, arguments.ArgAt(0));
   ASSERT(cls.is_allocate_finalized());
   const Instance& instance = Instance::Handle(
-      zone, Instance::NewAlreadyFinalized(cls, SpaceForRuntimeAllocation()));
+      zone, Instance::NewAlreadyFinalized(
+                cls, SpaceForRuntimeAllocation(thread, cls.id())));
   if (cls.NumTypeArguments() == 0) {
     // No type arguments required for a non-parameterized type.
     ASSERT(Instance::CheckedHandle(zone, arguments.ArgAt(1)).IsNull());
@@ -720,7 +742,7 @@ DEFINE_RUNTIME_ENTRY(AllocateClosure, 4) {
   const Closure& closure = Closure::Handle(
       zone, Closure::New(instantiator_type_args, Object::null_type_arguments(),
                          delayed_type_args, function, context,
-                         SpaceForRuntimeAllocation()));
+                         SpaceForRuntimeAllocation(thread, kClosureCid)));
   arguments.SetReturn(closure);
   RuntimeAllocationEpilogue(thread);
 }
@@ -731,7 +753,8 @@ DEFINE_RUNTIME_ENTRY(AllocateClosure, 4) {
 DEFINE_RUNTIME_ENTRY(AllocateContext, 1) {
   const Smi& num_variables = Smi::CheckedHandle(zone, arguments.ArgAt(0));
   const Context& context = Context::Handle(
-      zone, Context::New(num_variables.Value(), SpaceForRuntimeAllocation()));
+      zone, Context::New(num_variables.Value(),
+                         SpaceForRuntimeAllocation(thread, kContextCid)));
   arguments.SetReturn(context);
   RuntimeAllocationEpilogue(thread);
 }
@@ -743,7 +766,8 @@ DEFINE_RUNTIME_ENTRY(AllocateContext, 1) {
 DEFINE_RUNTIME_ENTRY(CloneContext, 1) {
   const Context& ctx = Context::CheckedHandle(zone, arguments.ArgAt(0));
   Context& cloned_ctx = Context::Handle(
-      zone, Context::New(ctx.num_variables(), SpaceForRuntimeAllocation()));
+      zone, Context::New(ctx.num_variables(),
+                         SpaceForRuntimeAllocation(thread, kContextCid)));
   cloned_ctx.set_parent(Context::Handle(zone, ctx.parent()));
   Object& inst = Object::Handle(zone);
   for (int i = 0; i < ctx.num_variables(); i++) {
@@ -759,8 +783,8 @@ DEFINE_RUNTIME_ENTRY(CloneContext, 1) {
 // Return value: newly allocated record.
 DEFINE_RUNTIME_ENTRY(AllocateRecord, 1) {
   const RecordShape shape(Smi::RawCast(arguments.ArgAt(0)));
-  const Record& record =
-      Record::Handle(zone, Record::New(shape, SpaceForRuntimeAllocation()));
+  const Record& record = Record::Handle(
+      zone, Record::New(shape, SpaceForRuntimeAllocation(thread, kRecordCid)));
   arguments.SetReturn(record);
   RuntimeAllocationEpilogue(thread);
 }
@@ -774,8 +798,8 @@ DEFINE_RUNTIME_ENTRY(AllocateSmallRecord, 4) {
   const auto& value0 = Instance::CheckedHandle(zone, arguments.ArgAt(1));
   const auto& value1 = Instance::CheckedHandle(zone, arguments.ArgAt(2));
   const auto& value2 = Instance::CheckedHandle(zone, arguments.ArgAt(3));
-  const Record& record =
-      Record::Handle(zone, Record::New(shape, SpaceForRuntimeAllocation()));
+  const Record& record = Record::Handle(
+      zone, Record::New(shape, SpaceForRuntimeAllocation(thread, kRecordCid)));
   const intptr_t num_fields = shape.num_fields();
   ASSERT(num_fields == 2 || num_fields == 3);
   record.SetFieldAt(0, value0);
@@ -813,8 +837,9 @@ DEFINE_RUNTIME_ENTRY(AllocateSuspendState, 2) {
               object_store->async_star_stream_controller_async_star_body()),
           Object::null_object());
     }
-    result = SuspendState::New(frame_size, function_data,
-                               SpaceForRuntimeAllocation());
+    result = SuspendState::New(
+        frame_size, function_data,
+        SpaceForRuntimeAllocation(thread, kSuspendStateCid));
     if (function_data.GetClassId() ==
         Class::Handle(zone, object_store->sync_star_iterator_class()).id()) {
       // Refresh _SyncStarIterator._state with the new SuspendState object.
@@ -823,8 +848,9 @@ DEFINE_RUNTIME_ENTRY(AllocateSuspendState, 2) {
           result);
     }
   } else {
-    result = SuspendState::New(frame_size, Instance::Cast(previous_state),
-                               SpaceForRuntimeAllocation());
+    result = SuspendState::New(
+        frame_size, Instance::Cast(previous_state),
+        SpaceForRuntimeAllocation(thread, kSuspendStateCid));
   }
   arguments.SetReturn(result);
   RuntimeAllocationEpilogue(thread);
@@ -837,7 +863,9 @@ DEFINE_RUNTIME_ENTRY(CloneSuspendState, 1) {
   const SuspendState& src =
       SuspendState::CheckedHandle(zone, arguments.ArgAt(0));
   const SuspendState& dst = SuspendState::Handle(
-      zone, SuspendState::Clone(thread, src, SpaceForRuntimeAllocation()));
+      zone,
+      SuspendState::Clone(thread, src,
+                          SpaceForRuntimeAllocation(thread, kSuspendStateCid)));
   arguments.SetReturn(dst);
   RuntimeAllocationEpilogue(thread);
 }
@@ -2302,6 +2330,14 @@ void PatchableCallHandler::DoICDataMissAOT(const ICData& ic_data,
           zone_, MegamorphicCacheTable::Lookup(thread_, name, descriptor));
       const Code& stub = StubCode::MegamorphicCall();
 
+      // Seed the cache with the current receiver so the megamorphic stub
+      // does not miss on it right away. The targets of the other classes
+      // seen by this call site can't be read back from the ICData in AOT,
+      // so they are added by the megamorphic miss handler.
+      const Smi& class_id =
+          Smi::Handle(zone_, Smi::New(receiver().GetClassId()));
+      cache.EnsureContains(class_id, target_function);
+
       CodePatcher::PatchSwitchableCallAt(caller_frame_->pc(), caller_code_,
                                          cache, stub);
       ReturnAOT(stub, cache);
@@ -3743,6 +3779,73 @@ DEFINE_RUNTIME_ENTRY(ResumeFrame, 2) {
   }
 }
 
+#if !defined(PRODUCT)
+RuntimeEntryStats* RuntimeEntryStats::first_ = nullptr;
+
+RuntimeEntryStats::RuntimeEntryStats(const char* name)
+    : name_(name), next_(first_) {
+  // Only called from static initializers, so no locking is needed.
+  first_ = this;
+}
+
+RuntimeEntryStats* RuntimeEntryStats::Lookup(const char* name) {
+  for (RuntimeEntryStats* stats = first_; stats != nullptr;
+       stats = stats->next_) {
+    if (strcmp(stats->name_, name) == 0) {
+      return stats;
+    }
+  }
+  return nullptr;
+}
+
+void RuntimeEntryStats::PrintAll() {
+  MallocGrowableArray<RuntimeEntryStats*> called;
+  for (RuntimeEntryStats* stats = first_; stats != nullptr;
+       stats = stats->next_) {
+    if (stats->calls_.load() > 0) {
+      called.Add(stats);
+    }
+  }
+  called.Sort([](RuntimeEntryStats* const* a, RuntimeEntryStats* const* b) {
+    const int64_t a_ticks = (*a)->ticks_.load();
+    const int64_t b_ticks = (*b)->ticks_.load();
+    return a_ticks > b_ticks ? -1 : (a_ticks < b_ticks ? 1 : 0);
+  });
+  // Scaling ticks to nanoseconds overflows int64 after a few seconds of
+  // total time, so convert in double.
+  const double frequency =
+      static_cast<double>(OS::GetCurrentMonotonicFrequency());
+  OS::PrintErr("%-40s %12s %12s %10s\n", "Runtime entry", "Calls",
+               "Total (us)", "Avg (ns)");
+  for (RuntimeEntryStats* stats : called) {
+    const int64_t calls = stats->calls_.load();
+    const double seconds = stats->ticks_.load() / frequency;
+    OS::PrintErr("%-40s %12" Pd64 " %12.0f %10.0f\n", stats->name_, calls,
+                 seconds * kMicrosecondsPerSecond,
+                 seconds * kNanosecondsPerSecond / calls);
+    // One "<bound:count" pair per non-empty bucket, the bound being the
+    // bucket's exclusive upper limit in nanoseconds.
+    OS::PrintErr("%-40s", "  latency (ns)");
+    for (intptr_t i = 0; i < kLatencyBuckets; i++) {
+      const int64_t count = stats->latency_counts_[i].load();
+      if (count == 0) continue;
+      if (i == kLatencyBuckets - 1) {
+        OS::PrintErr(" >=%.0f:%" Pd64,
+                     (static_cast<double>(int64_t{1} << (i - 1)) / frequency) *
+                         kNanosecondsPerSecond,
+                     count);
+      } else {
+        OS::PrintErr(" <%.0f:%" Pd64,
+                     (static_cast<double>(int64_t{1} << i) / frequency) *
+                         kNanosecondsPerSecond,
+                     count);
+      }
+    }
+    OS::PrintErr("\n");
+  }
+}
+#endif  // !defined(PRODUCT)
+
 void OnEveryRuntimeEntryCall(Thread* thread,
                              const char* runtime_call_name,
                              bool can_lazy_deopt) {
@@ -5,6 +5,7 @@
 #ifndef RUNTIME_VM_RUNTIME_ENTRY_H_
 #define RUNTIME_VM_RUNTIME_ENTRY_H_
 
+#include "platform/atomic.h"
 #include "vm/allocation.h"
 #if !defined(DART_PRECOMPILED_RUNTIME)
 #include "vm/compiler/runtime_api.h"
@@ -13,6 +14,7 @@
 #include "vm/heap/safepoint.h"
 #include "vm/log.h"
 #include "vm/native_arguments.h"
+#include "vm/os.h"
 #include "vm/runtime_entry_list.h"
 
 namespace dart {
@@ -67,6 +69,91 @@ class RuntimeEntry : public BaseRuntimeEntry {
   DISALLOW_COPY_AND_ASSIGN(RuntimeEntry);
 };
 
+#if !defined(PRODUCT)
+// Number of calls and time spent in one runtime entry, collected when
+// --print_runtime_entry_stats is set. Instances are static and link
+// themselves into a VM-wide list.
+//
+// Besides the total, the time of each call is counted in a log2 histogram:
+// bucket 0 holds calls of zero ticks and bucket i > 0 holds calls of
+// [2^(i-1), 2^i) ticks. The last bucket also holds all longer calls.
+class RuntimeEntryStats {
+ public:
+  static constexpr intptr_t kLatencyBuckets = 32;
+
+  explicit RuntimeEntryStats(const char* name);
+
+  const char* name() const { return name_; }
+  int64_t calls() const { return calls_.load(); }
+  int64_t latency_count(intptr_t bucket) const {
+    ASSERT((bucket >= 0) && (bucket < kLatencyBuckets));
+    return latency_counts_[bucket].load();
+  }
+
+  void RecordCall() { calls_.fetch_add(1); }
+  void RecordTicks(int64_t ticks) {
+    ticks_.fetch_add(ticks);
+    latency_counts_[LatencyBucket(ticks)].fetch_add(1);
+  }
+
+  static intptr_t LatencyBucket(int64_t ticks) {
+    if (ticks <= 0) return 0;
+    const intptr_t bucket = Utils::BitLength(ticks);
+    return bucket < kLatencyBuckets ? bucket : kLatencyBuckets - 1;
+  }
+
+  // Returns the stats of the runtime entry called [name], or nullptr.
+  static RuntimeEntryStats* Lookup(const char* name);
+
+  // Prints all entries that were called, sorted by total time.
+  static void PrintAll();
+
+ private:
+  const char* const name_;
+  RelaxedAtomic<int64_t> calls_ = {0};
+  RelaxedAtomic<int64_t> ticks_ = {0};
+  RelaxedAtomic<int64_t> latency_counts_[kLatencyBuckets];
+  RuntimeEntryStats* next_;
+
+  static RuntimeEntryStats* first_;
+
+  DISALLOW_COPY_AND_ASSIGN(RuntimeEntryStats);
+};
+
+// Counts a call to a runtime entry and, if the entry returns normally, the
+// time spent in it. Calls that unwind by throwing are counted but not timed.
+class RuntimeEntryStatsScope : public ValueObject {
+ public:
+  explicit RuntimeEntryStatsScope(RuntimeEntryStats* stats)
+      : stats_(FLAG_print_runtime_entry_stats ? stats : nullptr),
+        start_(0) {
+    if (UNLIKELY(stats_ != nullptr)) {
+      stats_->RecordCall();
+      start_ = OS::GetCurrentMonotonicTicks();
+    }
+  }
+  ~RuntimeEntryStatsScope() {
+    if (UNLIKELY(stats_ != nullptr)) {
+      stats_->RecordTicks(OS::GetCurrentMonotonicTicks() - start_);
+    }
+  }
+
+ private:
+  RuntimeEntryStats* const stats_;
+  int64_t start_;
+
+  DISALLOW_COPY_AND_ASSIGN(RuntimeEntryStatsScope);
+};
+
+#define DEFINE_RUNTIME_ENTRY_STATS(name)                                       \
+  static RuntimeEntryStats DRT_Stats##name("" #name);
+#define RUNTIME_ENTRY_STATS_SCOPE(name)                                        \
+  RuntimeEntryStatsScope runtime_entry_stats_scope(&DRT_Stats##name);
+#else
+#define DEFINE_RUNTIME_ENTRY_STATS(name)
+#define RUNTIME_ENTRY_STATS_SCOPE(name)
+#endif  // !defined(PRODUCT)
+
 #ifdef DEBUG
 #define TRACE_RUNTIME_CALL(format, name)                                       \
   if (FLAG_trace_runtime_calls) {                                              \
@@ -96,12 +183,14 @@ class RuntimeEntry : public BaseRuntimeEntry {
                                                   false, can_lazy_deopt);      \
   static void DRT_Helper##name(Isolate* isolate, Thread* thread, Zone* zone,   \
                                NativeArguments arguments);                     \
+  DEFINE_RUNTIME_ENTRY_STATS(name)                                             \
   void DRT_##name(NativeArguments arguments) {                                 \
     CHECK_STACK_ALIGNMENT;                                                     \
     /* Tell MemorySanitizer 'arguments' is initialized by generated code. */   \
     MSAN_UNPOISON(&arguments, sizeof(arguments));                              \
     ASSERT(arguments.ArgCount() == argument_count);                            \
     TRACE_RUNTIME_CALL("%s", "" #name);                                        \
+    RUNTIME_ENTRY_STATS_SCOPE(name)                                            \
     {                                                                          \
       Thread* thread = arguments.thread();                                     \
       ASSERT(thread == Thread::Current());                                     \
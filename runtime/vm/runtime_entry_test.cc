@@ -0,0 +1,69 @@
+// Copyright (c) 2024, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "vm/runtime_entry.h"
+#include "platform/assert.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+#if !defined(PRODUCT)
+TEST_CASE(RuntimeEntryStats_CountsCalls) {
+  const char* kScriptChars = R"(
+int throwAndCatch(int n) {
+  int caught = 0;
+  for (int i = 0; i < n; i++) {
+    try {
+      throw 'x';
+    } catch (_) {
+      caught++;
+    }
+  }
+  return caught;
+}
+)";
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, nullptr);
+  RuntimeEntryStats* stats = RuntimeEntryStats::Lookup("Throw");
+  ASSERT(stats != nullptr);
+  EXPECT_STREQ("Throw", stats->name());
+  EXPECT(RuntimeEntryStats::Lookup("NoSuchRuntimeEntry") == nullptr);
+
+  const bool saved_flag = FLAG_print_runtime_entry_stats;
+  const intptr_t kThrows = 3;
+  Dart_Handle args[] = {Dart_NewInteger(kThrows)};
+
+  // Calls are not counted with the flag off.
+  FLAG_print_runtime_entry_stats = false;
+  int64_t calls = stats->calls();
+  EXPECT_VALID(
+      Dart_Invoke(lib, NewString("throwAndCatch"), ARRAY_SIZE(args), args));
+  EXPECT_EQ(calls, stats->calls());
+
+  FLAG_print_runtime_entry_stats = true;
+  EXPECT_VALID(
+      Dart_Invoke(lib, NewString("throwAndCatch"), ARRAY_SIZE(args), args));
+  EXPECT_EQ(calls + kThrows, stats->calls());
+  FLAG_print_runtime_entry_stats = saved_flag;
+}
+
+TEST_CASE(RuntimeEntryStats_LatencyBuckets) {
+  EXPECT_EQ(0, RuntimeEntryStats::LatencyBucket(0));
+  EXPECT_EQ(1, RuntimeEntryStats::LatencyBucket(1));
+  EXPECT_EQ(2, RuntimeEntryStats::LatencyBucket(2));
+  EXPECT_EQ(2, RuntimeEntryStats::LatencyBucket(3));
+  EXPECT_EQ(3, RuntimeEntryStats::LatencyBucket(4));
+  EXPECT_EQ(10, RuntimeEntryStats::LatencyBucket(1000));
+  EXPECT_EQ(RuntimeEntryStats::kLatencyBuckets - 1,
+            RuntimeEntryStats::LatencyBucket(kMaxInt64));
+
+  RuntimeEntryStats* stats = RuntimeEntryStats::Lookup("Throw");
+  ASSERT(stats != nullptr);
+  const intptr_t bucket = RuntimeEntryStats::LatencyBucket(1000);
+  const int64_t count = stats->latency_count(bucket);
+  stats->RecordTicks(1000);
+  EXPECT_EQ(count + 1, stats->latency_count(bucket));
+}
+#endif  // !defined(PRODUCT)
+
+}  // namespace dart
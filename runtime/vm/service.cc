@@ -1624,6 +1624,26 @@ static void GetIsolateGroupMemoryUsage(Thread* thread, JSONStream* js) {
   });
 }
 
+static const MethodParameter* const get_gc_stats_params[] = {
+    ISOLATE_GROUP_PARAMETER,
+    nullptr,
+};
+
+static void GetGCStats(Thread* thread, JSONStream* js) {
+  ActOnIsolateGroup(js, [&](IsolateGroup* isolate_group) {
+    isolate_group->heap()->PrintGCStatsJSON(js);
+  });
+}
+
+static const MethodParameter* const get_object_layout_stats_params[] = {
+    ISOLATE_PARAMETER,
+    nullptr,
+};
+
+static void GetObjectLayoutStats(Thread* thread, JSONStream* js) {
+  thread->isolate_group()->heap()->PrintObjectLayoutJSON(thread, js);
+}
+
 static const MethodParameter* const get_isolate_pause_event_params[] = {
     ISOLATE_PARAMETER,
     nullptr,
@@ -4758,6 +4778,9 @@ static intptr_t GetProcessMemoryUsageHelper(JSONStream* js) {
         intptr_t size = Page::CachedSize();
         vm_size += size;
         semi.AddProperty64("size", size);
+        semi.AddProperty64("residentSize", Page::CachedResidentSize());
+        semi.AddProperty64("hits", Page::CacheHits());
+        semi.AddProperty64("misses", Page::CacheMisses());
         JSONArray(&semi, "children");
       }
 
@@ -5633,6 +5656,7 @@ static void SetFlag(Thread* thread, JSONStream* js) {
       "pause_isolates_on_unhandled_exceptions",
       "profile_period",
       "profiler",
+      "timeline_dart_events_per_second",
   };
 
   bool allowed = false;
@@ -5888,6 +5912,8 @@ static const ServiceMethodDescriptor service_methods_[] = {
     get_cpu_samples_params },
   { "getFlagList", GetFlagList,
     get_flag_list_params },
+  { "_getGCStats", GetGCStats,
+    get_gc_stats_params },
   { "_getHeapMap", GetHeapMap,
     get_heap_map_params },
   { "_getImplementationFields", GetImplementationFields,
@@ -5924,6 +5950,8 @@ static const ServiceMethodDescriptor service_methods_[] = {
     get_isolate_pause_event_params },
   { "getObject", GetObject,
     get_object_params },
+  { "_getObjectLayoutStats", GetObjectLayoutStats,
+    get_object_layout_stats_params },
   { "_getObjectStore", GetObjectStore,
     get_object_store_params },
   { "_getPersistentHandles", GetPersistentHandles,
@@ -479,6 +479,37 @@ StringPtr Symbols::FromCharCode(Thread* thread, uint16_t char_code) {
   return predefined_[char_code];
 }
 
+// Prints the number of probes a lookup needs to find the symbols in the
+// table of [isolate_group]. The probe sequences are replayed here instead of
+// being recorded on every lookup, since lookups don't take the symbols lock.
+static void PrintProbeStats(const char* name, IsolateGroup* isolate_group) {
+  Object& key = Object::Handle();
+  CanonicalStringSet table(isolate_group->object_store()->symbol_table());
+  const intptr_t mask = table.NumEntries() - 1;
+  intptr_t count = 0;
+  intptr_t total_probes = 0;
+  intptr_t max_probes = 0;
+  CanonicalStringSet::Iterator it(&table);
+  while (it.MoveNext()) {
+    const intptr_t entry = it.Current();
+    key = table.GetKey(entry);
+    // Same probe sequence as HashTable::FindKey.
+    intptr_t probe = String::Cast(key).Hash() & mask;
+    intptr_t probes = 1;
+    while (probe != entry) {
+      probe = (probe + probes) & mask;
+      probes++;
+    }
+    count++;
+    total_probes += probes;
+    max_probes = Utils::Maximum(max_probes, probes);
+  }
+  table.Release();
+  OS::PrintErr("%s: Average number of probes : %g\n", name,
+               count == 0 ? 0.0 : static_cast<double>(total_probes) / count);
+  OS::PrintErr("%s: Maximum number of probes : %" Pd "\n", name, max_probes);
+}
+
 void Symbols::DumpStats(IsolateGroup* isolate_group) {
   intptr_t size = -1;
   intptr_t capacity = -1;
@@ -486,12 +517,12 @@ void Symbols::DumpStats(IsolateGroup* isolate_group) {
   GetStats(Dart::vm_isolate_group(), &size, &capacity);
   OS::PrintErr("VM Isolate: Number of symbols : %" Pd "\n", size);
   OS::PrintErr("VM Isolate: Symbol table capacity : %" Pd "\n", capacity);
+  PrintProbeStats("VM Isolate", Dart::vm_isolate_group());
   // Now dump regular isolate symbol table stats.
   GetStats(isolate_group, &size, &capacity);
   OS::PrintErr("Isolate: Number of symbols : %" Pd "\n", size);
   OS::PrintErr("Isolate: Symbol table capacity : %" Pd "\n", capacity);
-  // TODO(koda): Consider recording growth and collision stats in HashTable,
-  // in DEBUG mode.
+  PrintProbeStats("Isolate", isolate_group);
 }
 
 void Symbols::DumpTable(IsolateGroup* isolate_group) {
@@ -560,6 +560,7 @@ class ObjectPointerVisitor;
   V(vm_prefer_inline, "vm:prefer-inline")                                      \
   V(vm_recognized, "vm:recognized")                                            \
   V(vm_testing_print_flow_graph, "vm:testing:print-flow-graph")                \
+  V(vm_thorough_register_allocation, "vm:thorough-register-allocation")        \
   V(vm_trace_entrypoints, "vm:testing.unsafe.trace-entrypoints-fn")            \
   V(vm_unsafe_no_interrupts, "vm:unsafe:no-interrupts")
 
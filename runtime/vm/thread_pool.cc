@@ -15,6 +15,12 @@ DEFINE_FLAG(int,
             5000,
             "Free workers when they have been idle for this amount of time.");
 
+DEFINE_FLAG(bool,
+            thread_pool_affinity,
+            false,
+            "Run tasks posted with an affinity on the worker they prefer if "
+            "that worker is idle.");
+
 static int64_t ComputeTimeout(int64_t idle_start) {
   int64_t worker_timeout_micros =
       FLAG_worker_timeout_millis * kMicrosecondsPerMillisecond;
@@ -81,14 +87,14 @@ void ThreadPool::Shutdown() {
   ASSERT(dead_workers_.IsEmpty());
 }
 
-bool ThreadPool::RunImpl(std::unique_ptr<Task> task) {
+bool ThreadPool::RunImpl(std::unique_ptr<Task> task, const void* affinity) {
   Worker* new_worker = nullptr;
   {
     MonitorLocker ml(&pool_monitor_);
     if (shutting_down_) {
       return false;
     }
-    new_worker = ScheduleTaskLocked(&ml, std::move(task));
+    new_worker = ScheduleTaskLocked(&ml, std::move(task), affinity);
   }
   if (new_worker != nullptr) {
     new_worker->StartThread();
@@ -102,6 +108,12 @@ bool ThreadPool::CurrentThreadIsWorker() {
   return worker != nullptr && worker->pool_ == this;
 }
 
+const void* ThreadPool::CurrentWorkerAffinity() {
+  auto worker =
+      static_cast<Worker*>(OSThread::Current()->owning_thread_pool_worker_);
+  return (worker != nullptr && worker->pool_ == this) ? worker : nullptr;
+}
+
 void ThreadPool::MarkCurrentWorkerAsBlocked() {
   auto worker =
       static_cast<Worker*>(OSThread::Current()->owning_thread_pool_worker_);
@@ -149,23 +161,25 @@ void ThreadPool::WorkerLoop(Worker* worker) {
   while (true) {
     MonitorLocker ml(&pool_monitor_);
 
-    if (!tasks_.IsEmpty()) {
+    if (HasTaskForLocked(worker)) {
       IdleToRunningLocked(worker);
-      while (!tasks_.IsEmpty()) {
-        std::unique_ptr<Task> task(tasks_.RemoveFirst());
-        pending_tasks_--;
+      Task* next = nullptr;
+      while ((next = TakeTaskLocked(worker)) != nullptr) {
+        std::unique_ptr<Task> task(next);
         MonitorLeaveScope mls(&ml);
         task->Run();
         ASSERT(Isolate::Current() == nullptr);
         task.reset();
       }
+      worker->running_lifo_task_ = false;
       RunningToIdleLocked(worker);
     }
 
-    if (running_workers_.IsEmpty()) {
-      ASSERT(tasks_.IsEmpty());
+    // Tasks can only be pending here in the LIFO slot of an idle worker we
+    // just woke up.
+    if (running_workers_.IsEmpty() && !TasksWaitingToRunLocked()) {
       OnEnterIdleLocked(&ml);
-      if (!tasks_.IsEmpty()) {
+      if (HasTaskForLocked(worker)) {
         continue;
       }
     }
@@ -183,7 +197,7 @@ void ThreadPool::WorkerLoop(Worker* worker) {
       const auto result = ml.WaitMicros(ComputeTimeout(idle_start));
 
       // We have to drain all pending tasks.
-      if (!tasks_.IsEmpty()) break;
+      if (HasTaskForLocked(worker)) break;
 
       if (shutting_down_ || result == Monitor::kTimedOut) {
         done = true;
@@ -214,6 +228,7 @@ void ThreadPool::IdleToRunningLocked(Worker* worker) {
 
 void ThreadPool::RunningToIdleLocked(Worker* worker) {
   ASSERT(tasks_.IsEmpty());
+  ASSERT(worker->lifo_task_ == nullptr);
 
   ASSERT(running_workers_.ContainsForDebugging(worker));
   running_workers_.Remove(worker);
@@ -224,6 +239,7 @@ void ThreadPool::RunningToIdleLocked(Worker* worker) {
 
 void ThreadPool::IdleToDeadLocked(Worker* worker) {
   ASSERT(tasks_.IsEmpty());
+  ASSERT(worker->lifo_task_ == nullptr);
 
   ASSERT(idle_workers_.ContainsForDebugging(worker));
   idle_workers_.Remove(worker);
@@ -259,8 +275,84 @@ void ThreadPool::JoinDeadWorkersLocked(WorkerList* dead_workers_to_join) {
   ASSERT(dead_workers_to_join->IsEmpty());
 }
 
+bool ThreadPool::HasTaskForLocked(Worker* worker) {
+  if (worker->lifo_task_ != nullptr || !tasks_.IsEmpty()) {
+    return true;
+  }
+  for (Worker* other : running_workers_) {
+    if (other->lifo_task_ != nullptr) {
+      return true;
+    }
+  }
+  return false;
+}
+
+ThreadPool::Task* ThreadPool::TakeTaskLocked(Worker* worker) {
+  Task* task = nullptr;
+  bool from_lifo_slot = false;
+  if (worker->lifo_task_ != nullptr) {
+    // Prefer the task this worker posted last: it most likely consumes data
+    // the worker just produced.
+    task = worker->lifo_task_;
+    worker->lifo_task_ = nullptr;
+    from_lifo_slot = true;
+  } else if (!tasks_.IsEmpty()) {
+    task = tasks_.RemoveFirst();
+  } else {
+    // Steal from the LIFO slot of a worker still busy with its current task.
+    for (Worker* other : running_workers_) {
+      if (other->lifo_task_ != nullptr) {
+        task = other->lifo_task_;
+        other->lifo_task_ = nullptr;
+        break;
+      }
+    }
+  }
+  if (task != nullptr) {
+    pending_tasks_--;
+  }
+  worker->running_lifo_task_ = from_lifo_slot;
+  return task;
+}
+
 ThreadPool::Worker* ThreadPool::ScheduleTaskLocked(MonitorLocker* ml,
-                                                   std::unique_ptr<Task> task) {
+                                                   std::unique_ptr<Task> task,
+                                                   const void* affinity) {
+  // Hand the task to the idle worker it prefers, e.g. the one that ran the
+  // previous task of the same isolate and still has its data in cache. The
+  // idle workers share [pool_monitor_], so all of them are woken up and the
+  // others go back to sleep. A busy preferred worker is ignored.
+  if (FLAG_thread_pool_affinity && affinity != nullptr) {
+    for (Worker* idle : idle_workers_) {
+      if (idle == affinity && idle->lifo_task_ == nullptr) {
+        idle->lifo_task_ = task.release();
+        pending_tasks_++;
+        ml->NotifyAll();
+        return nullptr;
+      }
+    }
+  }
+
+  // If the pool is saturated the new task would wait behind all other queued
+  // tasks. When it is posted from one of our workers, run it on that worker
+  // right after the current task instead, which keeps ping-pong patterns (e.g.
+  // two isolates exchanging messages) on a warm thread.
+  //
+  // A task taken from the LIFO slot cannot refill it, so a pair of such tasks
+  // cannot starve the tasks in [tasks_].
+  const bool saturated = max_pool_size_ > 0 && idle_workers_.IsEmpty() &&
+                         (count_idle_ + count_running_) >= max_pool_size_;
+  if (saturated) {
+    auto worker =
+        static_cast<Worker*>(OSThread::Current()->owning_thread_pool_worker_);
+    if (worker != nullptr && worker->pool_ == this && !worker->is_blocked_ &&
+        !worker->running_lifo_task_ && worker->lifo_task_ == nullptr) {
+      worker->lifo_task_ = task.release();
+      pending_tasks_++;
+      return nullptr;
+    }
+  }
+
   // Enqueue the new task.
   tasks_.Append(task.release());
   pending_tasks_++;
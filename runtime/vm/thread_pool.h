@@ -46,9 +46,22 @@ class ThreadPool {
     return RunImpl(std::unique_ptr<Task>(new T(std::forward<Args>(args)...)));
   }
 
+  // Runs a task on the thread pool, preferring the worker identified by
+  // [affinity] if that worker is idle (see --thread_pool_affinity).
+  template <typename T, typename... Args>
+  bool RunWithAffinity(const void* affinity, Args&&... args) {
+    return RunImpl(std::unique_ptr<Task>(new T(std::forward<Args>(args)...)),
+                   affinity);
+  }
+
   // Returns `true` if the current thread is running on the [this] thread pool.
   bool CurrentThreadIsWorker();
 
+  // Returns an opaque token identifying the current worker of [this] thread
+  // pool for [RunWithAffinity], or `nullptr` if the current thread is not one
+  // of its workers. The token is never dereferenced once the worker died.
+  const void* CurrentWorkerAffinity();
+
   // Mark the current thread as being blocked (e.g. in native code). This might
   // temporarily increase the max thread pool size.
   void MarkCurrentWorkerAsBlocked();
@@ -88,6 +101,12 @@ class ThreadPool {
     OSThread* os_thread_ = nullptr;
     bool is_blocked_ = false;
 
+    // A task this worker will run next (see [ScheduleTaskLocked]). Other
+    // workers can steal it while this worker is running.
+    Task* lifo_task_ = nullptr;
+    // Whether the task this worker is running was taken from a LIFO slot.
+    bool running_lifo_task_ = false;
+
     DISALLOW_COPY_AND_ASSIGN(Worker);
   };
 
@@ -102,16 +121,20 @@ class ThreadPool {
   bool ShuttingDownLocked() { return shutting_down_; }
 
   // Whether new tasks are ready to be run.
-  bool TasksWaitingToRunLocked() { return !tasks_.IsEmpty(); }
+  bool TasksWaitingToRunLocked() { return pending_tasks_ > 0; }
 
  private:
   using TaskList = IntrusiveDList<Task>;
   using WorkerList = IntrusiveDList<Worker>;
 
-  bool RunImpl(std::unique_ptr<Task> task);
+  bool RunImpl(std::unique_ptr<Task> task, const void* affinity = nullptr);
   void WorkerLoop(Worker* worker);
 
-  Worker* ScheduleTaskLocked(MonitorLocker* ml, std::unique_ptr<Task> task);
+  Worker* ScheduleTaskLocked(MonitorLocker* ml,
+                             std::unique_ptr<Task> task,
+                             const void* affinity);
+  bool HasTaskForLocked(Worker* worker);
+  Task* TakeTaskLocked(Worker* worker);
 
   void IdleToRunningLocked(Worker* worker);
   void RunningToIdleLocked(Worker* worker);
@@ -127,6 +150,7 @@ class ThreadPool {
   WorkerList running_workers_;
   WorkerList idle_workers_;
   WorkerList dead_workers_;
+  // Includes the tasks in the [Worker::lifo_task_] slots.
   uint64_t pending_tasks_ = 0;
   TaskList tasks_;
 
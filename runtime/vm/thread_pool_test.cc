@@ -256,4 +256,73 @@ THREAD_POOL_UNIT_TEST_CASE(ThreadPool_RecursiveSpawn) {
   EXPECT_EQ(kTotalTasks, done);
 }
 
+class LifoOrderTask : public ThreadPool::Task {
+ public:
+  LifoOrderTask(ThreadPool* pool,
+                Monitor* sync,
+                bool* posted,
+                intptr_t id,
+                intptr_t* order,
+                intptr_t* count)
+      : pool_(pool),
+        sync_(sync),
+        posted_(posted),
+        id_(id),
+        order_(order),
+        count_(count) {}
+
+  virtual void Run() {
+    MonitorLocker ml(sync_);
+    if (posted_ != nullptr) {
+      // Wait until the main thread has queued its task behind us.
+      while (!*posted_) {
+        ml.Wait();
+      }
+    }
+    order_[(*count_)++] = id_;
+    if (id_ < 2) {
+      // Task 0 posts task 1, task 1 posts task 3.
+      const intptr_t next_id = id_ == 0 ? 1 : 3;
+      pool_->Run<LifoOrderTask>(pool_, sync_, nullptr, next_id, order_,
+                                count_);
+    }
+    ml.Notify();
+  }
+
+ private:
+  ThreadPool* pool_;
+  Monitor* sync_;
+  bool* posted_;
+  intptr_t id_;
+  intptr_t* order_;
+  intptr_t* count_;
+};
+
+THREAD_POOL_UNIT_TEST_CASE(ThreadPool_LifoSlot) {
+  ThreadPool thread_pool(/*max_pool_size=*/1);
+  Monitor sync;
+  bool posted = false;
+  intptr_t order[4] = {-1, -1, -1, -1};
+  intptr_t count = 0;
+  thread_pool.Run<LifoOrderTask>(&thread_pool, &sync, &posted, 0, order,
+                                 &count);
+  thread_pool.Run<LifoOrderTask>(&thread_pool, &sync, nullptr, 2, order,
+                                 &count);
+  {
+    MonitorLocker ml(&sync);
+    posted = true;
+    ml.NotifyAll();
+    while (count < 4) {
+      ml.Wait();
+    }
+  }
+  // Task 1 was posted by a worker of the saturated pool, so it runs before
+  // the older task 2. Task 3 was posted by a task taken from the LIFO slot
+  // and goes to the back of the queue.
+  EXPECT_EQ(0, order[0]);
+  EXPECT_EQ(1, order[1]);
+  EXPECT_EQ(2, order[2]);
+  EXPECT_EQ(3, order[3]);
+}
+
 }  // namespace dart
@@ -82,6 +82,11 @@ DEFINE_FLAG(charp,
             DEFAULT_TIMELINE_RECORDER,
             "Select the timeline recorder used. "
             "Valid values: none, " SUPPORTED_TIMELINE_RECORDERS)
+DEFINE_FLAG(int,
+            timeline_dart_events_per_second,
+            0,
+            "Maximum number of synchronous and instant events reported by "
+            "Dart code to record per second. 0 means no limit.");
 
 // Implementation notes:
 //
@@ -383,6 +388,8 @@ void Timeline::PrintFlagsToJSON(JSONStream* js) {
     TIMELINE_STREAM_LIST(ADD_RECORDED_STREAM_NAME);
 #undef ADD_RECORDED_STREAM_NAME
   }
+  obj.AddProperty64("_droppedDartEvents",
+                    DartTimelineEventHelpers::dropped_events());
 }
 #endif
 
@@ -2042,16 +2049,16 @@ void TimelineEventFileRecorderBase::Drain() {
       ml.Wait();
       continue;  // Recheck empty and shutting down.
     }
+    // Take all pending events at once and write them out without holding
+    // the lock, so threads completing events only contend on the list.
     TimelineEvent* event = head_;
-    TimelineEvent* next = event->next();
-    head_ = next;
-    if (next == nullptr) {
-      tail_ = nullptr;
-    }
+    head_ = tail_ = nullptr;
     ml.Exit();
-    {
+    while (event != nullptr) {
+      TimelineEvent* next = event->next();
       DrainImpl(*event);
       delete event;
+      event = next;
     }
     ml.Enter();
   }
@@ -2079,11 +2086,12 @@ void TimelineEventFileRecorderBase::CompleteEvent(TimelineEvent* event) {
   event->set_next(nullptr);
   if (tail_ == nullptr) {
     head_ = tail_ = event;
+    // The drain thread only waits once it has found the list empty.
+    ml.Notify();
   } else {
     tail_->set_next(event);
     tail_ = event;
   }
-  ml.Notify();
 }
 
 // Must be called in derived class destructors.
@@ -2469,6 +2477,75 @@ void DartTimelineEventHelpers::ReportTaskEvent(
   event->CompleteWithPreSerializedArgs(args);
 }
 
+RelaxedAtomic<int64_t> DartTimelineEventHelpers::window_start_micros_ = {0};
+RelaxedAtomic<int64_t> DartTimelineEventHelpers::window_events_ = {0};
+RelaxedAtomic<int64_t> DartTimelineEventHelpers::dropped_events_ = {0};
+
+bool DartTimelineEventHelpers::TryAcquireRateToken(int64_t (*clock)()) {
+  const intptr_t limit = FLAG_timeline_dart_events_per_second;
+  if (limit <= 0) {
+    return true;
+  }
+  const int64_t now = clock();
+  int64_t window_start = window_start_micros_.load();
+  if ((now - window_start >= kMicrosecondsPerSecond) &&
+      window_start_micros_.compare_exchange_strong(window_start, now)) {
+    window_events_.store(0);
+  }
+  if (window_events_.fetch_add(1) < limit) {
+    return true;
+  }
+  dropped_events_.fetch_add(1);
+  return false;
+}
+
+bool DartTimelineEventHelpers::ShouldReport(Isolate* isolate,
+                                            intptr_t type,
+                                            int64_t (*clock)()) {
+  ASSERT(isolate != nullptr);
+  constexpr intptr_t kTrackedLevels = sizeof(uint64_t) * kBitsPerByte;
+  uint64_t dropped_levels = isolate->timeline_dropped_sync_levels();
+  switch (static_cast<TimelineEvent::EventType>(type)) {
+    case TimelineEvent::kBegin: {
+      const intptr_t level = isolate->timeline_sync_depth();
+      isolate->set_timeline_sync_depth(level + 1);
+      if (level >= kTrackedLevels) {
+        // Too deep to remember, always keep these.
+        return true;
+      }
+      const uint64_t bit = static_cast<uint64_t>(1) << level;
+      const bool keep = TryAcquireRateToken(clock);
+      isolate->set_timeline_dropped_sync_levels(
+          keep ? (dropped_levels & ~bit) : (dropped_levels | bit));
+      return keep;
+    }
+    case TimelineEvent::kEnd: {
+      if (isolate->timeline_sync_depth() == 0) {
+        // Unbalanced end event.
+        return true;
+      }
+      const intptr_t level = isolate->timeline_sync_depth() - 1;
+      isolate->set_timeline_sync_depth(level);
+      if (level >= kTrackedLevels) {
+        return true;
+      }
+      const uint64_t bit = static_cast<uint64_t>(1) << level;
+      if ((dropped_levels & bit) != 0) {
+        isolate->set_timeline_dropped_sync_levels(dropped_levels & ~bit);
+        dropped_events_.fetch_add(1);
+        return false;
+      }
+      return true;
+    }
+    case TimelineEvent::kInstant:
+      return TryAcquireRateToken(clock);
+    default:
+      // Async and flow events are matched by id, possibly across isolates,
+      // so they are never dropped.
+      return true;
+  }
+}
+
 }  // namespace dart
 
 #endif  // defined(SUPPORT_TIMELINE)
@@ -1326,6 +1326,29 @@ class DartTimelineEventHelpers : public AllStatic {
                               intptr_t type,
                               char* name,
                               char* args);
+
+  // Returns false if an event of |type| reported by Dart code in |isolate|
+  // should be dropped because of --timeline_dart_events_per_second. The end
+  // event of a dropped synchronous begin event is dropped as well. Must be
+  // called for every event reported, whether or not it ends up being
+  // recorded. Synchronous spans are tracked per isolate, since they can
+  // straddle awaits and the isolate can move between threads meanwhile.
+  // |clock| returns the current time in microseconds; tests pass their own.
+  static bool ShouldReport(
+      Isolate* isolate,
+      intptr_t type,
+      int64_t (*clock)() = &OS::GetCurrentMonotonicMicros);
+
+  // Number of events dropped by |ShouldReport|.
+  static int64_t dropped_events() { return dropped_events_.load(); }
+
+ private:
+  static bool TryAcquireRateToken(int64_t (*clock)());
+
+  // Start and number of events of the current one second rate window.
+  static RelaxedAtomic<int64_t> window_start_micros_;
+  static RelaxedAtomic<int64_t> window_events_;
+  static RelaxedAtomic<int64_t> dropped_events_;
 };
 #endif  // defined(SUPPORT_TIMELINE)
 
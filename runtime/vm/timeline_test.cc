@@ -17,6 +17,8 @@ namespace dart {
 
 #ifndef PRODUCT
 
+DECLARE_FLAG(int, timeline_dart_events_per_second);
+
 template <class T>
 class TimelineRecorderOverride : public ValueObject {
  public:
@@ -512,6 +514,51 @@ TEST_CASE(TimelineTrackMetadataRace) {
 #undef FAKE_PROCESS_ID
 #undef FAKE_TRACE_ID
 
+static int64_t rate_limit_test_now = 0;
+
+static int64_t RateLimitTestClock() {
+  return rate_limit_test_now;
+}
+
+static bool ShouldReportAtTestTime(TimelineEvent::EventType type) {
+  return DartTimelineEventHelpers::ShouldReport(Isolate::Current(), type,
+                                                &RateLimitTestClock);
+}
+
+TEST_CASE(TimelineDartEventsRateLimit) {
+  SetFlagScope<int> sfs(&FLAG_timeline_dart_events_per_second, 2);
+  const int64_t dropped = DartTimelineEventHelpers::dropped_events();
+
+  // The rate window is only used while the limit is set, so starting the
+  // test clock at the current time opens a new window.
+  rate_limit_test_now = OS::GetCurrentMonotonicMicros();
+  EXPECT(ShouldReportAtTestTime(TimelineEvent::kBegin));
+  rate_limit_test_now += kMicrosecondsPerSecond / 2;
+  EXPECT(ShouldReportAtTestTime(TimelineEvent::kBegin));
+  EXPECT(!ShouldReportAtTestTime(TimelineEvent::kBegin));
+  EXPECT(!ShouldReportAtTestTime(TimelineEvent::kInstant));
+  EXPECT(ShouldReportAtTestTime(TimelineEvent::kAsyncBegin));
+  // The dropped begin is remembered by the isolate, not the thread.
+  Isolate* isolate = Isolate::Current();
+  EXPECT_EQ(3, isolate->timeline_sync_depth());
+  EXPECT_EQ(static_cast<uint64_t>(1) << 2,
+            isolate->timeline_dropped_sync_levels());
+  // The end of the dropped begin is dropped, the others are kept.
+  EXPECT(!ShouldReportAtTestTime(TimelineEvent::kEnd));
+  EXPECT_EQ(0u, isolate->timeline_dropped_sync_levels());
+  EXPECT(ShouldReportAtTestTime(TimelineEvent::kEnd));
+  EXPECT(ShouldReportAtTestTime(TimelineEvent::kEnd));
+  EXPECT_EQ(0, isolate->timeline_sync_depth());
+  EXPECT_EQ(dropped + 3, DartTimelineEventHelpers::dropped_events());
+
+  // A second after the window opened, the next one starts.
+  rate_limit_test_now += kMicrosecondsPerSecond / 2;
+  EXPECT(ShouldReportAtTestTime(TimelineEvent::kInstant));
+  EXPECT(ShouldReportAtTestTime(TimelineEvent::kInstant));
+  EXPECT(!ShouldReportAtTestTime(TimelineEvent::kInstant));
+  EXPECT_EQ(dropped + 4, DartTimelineEventHelpers::dropped_events());
+}
+
 #endif  // !PRODUCT
 
 #if defined(SUPPORT_TIMELINE)
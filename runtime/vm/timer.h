@@ -134,6 +134,8 @@ class Timer : public ValueObject {
 
   bool IsReset() const { return monotonic_.IsReset(); }
 
+  bool running() const { return monotonic_.running(); }
+
   void AddTotal(const Timer& other) {
     monotonic_.AddTotal(other.monotonic_);
     cpu_.AddTotal(other.cpu_);
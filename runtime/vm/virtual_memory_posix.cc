@@ -21,6 +21,7 @@
 
 #include "platform/assert.h"
 #include "platform/utils.h"
+#include "vm/flags.h"
 #include "vm/heap/pages.h"
 #include "vm/isolate.h"
 #include "vm/virtual_memory_compressed.h"
@@ -50,6 +51,13 @@ DECLARE_FLAG(bool, generate_perf_events_symbols);
 DECLARE_FLAG(bool, generate_perf_jitdump);
 #endif
 
+#if defined(DART_HOST_OS_ANDROID) || defined(DART_HOST_OS_LINUX)
+DEFINE_FLAG(bool,
+            transparent_huge_pages,
+            false,
+            "Ask the kernel to back heap memory with transparent huge pages.");
+#endif
+
 uword VirtualMemory::page_size_ = 0;
 VirtualMemory* VirtualMemory::compressed_heap_ = nullptr;
 
@@ -87,6 +95,21 @@ static void Unmap(uword start, uword end) {
   }
 }
 
+// Marks [address, address + size) as eligible for transparent huge pages.
+// This is only a hint: the kernel ignores it for ranges that don't cover a
+// whole huge page, and it fails harmlessly if THP is disabled.
+static void AdviseHugePages(void* address, intptr_t size) {
+#if (defined(DART_HOST_OS_ANDROID) || defined(DART_HOST_OS_LINUX)) &&          \
+    defined(MADV_HUGEPAGE)
+  if (FLAG_transparent_huge_pages) {
+    if (madvise(address, size, MADV_HUGEPAGE) != 0) {
+      LOG_INFO("madvise(%p, 0x%" Px ", MADV_HUGEPAGE) failed\n", address,
+               size);
+    }
+  }
+#endif
+}
+
 static void* GenericMapAligned(void* hint,
                                int prot,
                                intptr_t size,
@@ -314,6 +337,9 @@ VirtualMemory* VirtualMemory::AllocateAligned(intptr_t size,
 #endif
   prctl(PR_SET_VMA, PR_SET_VMA_ANON_NAME, address, size, name);
 #endif
+  if (!is_executable) {
+    AdviseHugePages(address, size);
+  }
 
   MemoryRegion region(reinterpret_cast<void*>(address), size);
   return new VirtualMemory(region, region);
@@ -346,6 +372,10 @@ void VirtualMemory::Commit(void* address, intptr_t size) {
     FATAL("Failed to commit: %d (%s)", error,
           Utils::StrError(error, error_buf, kBufferSize));
   }
+  // Committed memory is carved out of one large reservation (the compressed
+  // heap), so consecutive commits form ranges that can be collapsed into
+  // huge pages.
+  AdviseHugePages(address, size);
 }
 
 void VirtualMemory::Decommit(void* address, intptr_t size) {
@@ -81,6 +81,7 @@ base class _SecureFilterImpl extends NativeFieldWrapperClass1
   @pragma("vm:external-name", "SecureSocket_Connect")
   external void connect(
       String hostName,
+      int port,
       SecurityContext context,
       bool isServer,
       bool requestClientCertificate,
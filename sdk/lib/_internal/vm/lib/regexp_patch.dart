@@ -183,6 +183,9 @@ class _RegExp implements RegExp {
   bool hasMatch(String input) {
     // TODO: Remove these null checks once all code is opted into strong nonnullable mode.
     if (input == null) throw new ArgumentError.notNull('input');
+    if (_matchesInterpreted) {
+      return _ExecuteMatchInto(input, 0, _getMatchIndices(_groupCount));
+    }
     List? match = _ExecuteMatch(input, 0);
     return (match == null) ? false : true;
   }
@@ -190,6 +193,13 @@ class _RegExp implements RegExp {
   String? stringMatch(String input) {
     // TODO: Remove these null checks once all code is opted into strong nonnullable mode.
     if (input == null) throw new ArgumentError.notNull('input');
+    if (_matchesInterpreted) {
+      final indices = _getMatchIndices(_groupCount);
+      if (!_ExecuteMatchInto(input, 0, indices)) {
+        return null;
+      }
+      return input._substringUnchecked(indices[0], indices[1]);
+    }
     List? match = _ExecuteMatch(input, 0);
     if (match == null) {
       return null;
@@ -197,6 +207,33 @@ class _RegExp implements RegExp {
     return input._substringUnchecked(match[0], match[1]);
   }
 
+  /// Calls [onMatch] with the start and end of each match of this regexp in
+  /// [string], the same matches [allMatches] would find, but without
+  /// allocating a [RegExpMatch] for each of them.
+  void _forEachMatchRange(String string, void onMatch(int start, int end)) {
+    final groupCount = _groupCount;
+    int index = 0;
+    while (index <= string.length) {
+      final int start;
+      final int end;
+      if (_matchesInterpreted) {
+        // [onMatch] may use this regexp or others, so re-fetch the indices
+        // after each call.
+        final indices = _getMatchIndices(groupCount);
+        if (!_ExecuteMatchInto(string, index, indices)) return;
+        start = indices[0];
+        end = indices[1];
+      } else {
+        final match = _ExecuteMatch(string, index);
+        if (match == null) return;
+        start = match[0];
+        end = match[1];
+      }
+      onMatch(start, end);
+      index = _AllMatchesIterator._nextSearchIndex(this, string, start, end);
+    }
+  }
+
   @pragma("vm:external-name", "RegExp_getPattern")
   external String get pattern;
 
@@ -297,6 +334,33 @@ class _RegExp implements RegExp {
   @pragma("vm:external-name", "RegExp_ExecuteMatchSticky")
   external List<int>? _ExecuteMatchSticky(String str, int start_index);
 
+  /// Whether matches are always found by the regexp interpreter, as in AOT.
+  /// Otherwise [_ExecuteMatch] is intrinsified to call the generated code of
+  /// the regexp directly, which is faster than [_ExecuteMatchInto].
+  static final bool _matchesInterpreted = _interpretsMatches;
+
+  @pragma("vm:external-name", "RegExp_interpretsMatches")
+  external static bool get _interpretsMatches;
+
+  /// As [_ExecuteMatch], but stores the match indices in [indices], which
+  /// must have room for those of all groups, and returns whether there was
+  /// a match. Only used if [_matchesInterpreted].
+  @pragma("vm:external-name", "RegExp_ExecuteMatchInto")
+  external bool _ExecuteMatchInto(
+      String str, int start_index, Int32List indices);
+
+  /// Returns a buffer for the match indices of a regexp with [groupCount]
+  /// groups, shared by all regexps. Its contents are only valid until the
+  /// next match.
+  static Int32List _getMatchIndices(int groupCount) {
+    final length = (groupCount + 1) * 2;
+    var indices = _matchIndices;
+    if (indices == null || indices.length < length) {
+      _matchIndices = indices = Int32List(length);
+    }
+    return indices;
+  }
+
   static Int32List _getRegisters(int registers_count) {
     var registers = _registers;
     if (registers == null || registers.length < registers_count) {
@@ -319,6 +383,8 @@ class _RegExp implements RegExp {
 
   static Int32List? _registers;
 
+  static Int32List? _matchIndices;
+
   static Int32List _backtrackingStack =
       Int32List(_initialBacktrackingStackSize);
 }
@@ -352,6 +418,22 @@ class _AllMatchesIterator implements Iterator<RegExpMatch> {
     return c >= 0xdc00 && c <= 0xdfff;
   }
 
+  /// Returns where to look for the match following the one from [start] to
+  /// [end] of [re] in [str].
+  static int _nextSearchIndex(_RegExp re, String str, int start, int end) {
+    if (end != start) return end;
+    // Zero-width match. Advance by one more, unless the regexp
+    // is in unicode mode and it would put us within a surrogate
+    // pair. In that case, advance past the code point as a whole.
+    if (re.isUnicode &&
+        end + 1 < str.length &&
+        _isLeadSurrogate(str.codeUnitAt(end)) &&
+        _isTrailSurrogate(str.codeUnitAt(end + 1))) {
+      return end + 2;
+    }
+    return end + 1;
+  }
+
   bool moveNext() {
     final re = _re;
     if (re == null) return false; // Cleared after a failed match.
@@ -360,19 +442,7 @@ class _AllMatchesIterator implements Iterator<RegExpMatch> {
       if (match != null) {
         var current = new _RegExpMatch._(re, _str, match);
         _current = current;
-        _nextIndex = current.end;
-        if (_nextIndex == current.start) {
-          // Zero-width match. Advance by one more, unless the regexp
-          // is in unicode mode and it would put us within a surrogate
-          // pair. In that case, advance past the code point as a whole.
-          if (re.isUnicode &&
-              _nextIndex + 1 < _str.length &&
-              _isLeadSurrogate(_str.codeUnitAt(_nextIndex)) &&
-              _isTrailSurrogate(_str.codeUnitAt(_nextIndex + 1))) {
-            _nextIndex++;
-          }
-          _nextIndex++;
-        }
+        _nextIndex = _nextSearchIndex(re, _str, current.start, current.end);
         return true;
       }
     }
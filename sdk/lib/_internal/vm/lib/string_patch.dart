@@ -372,10 +372,14 @@ abstract final class _StringBase implements String {
     }
     if (pattern is String) {
       String other = pattern;
+      if (other.isEmpty) return start;
       int maxIndex = this.length - other.length;
+      // Only compare the whole pattern where its first code unit matches.
       // TODO: Use an efficient string search (e.g. BMH).
+      final first = other.codeUnitAt(0);
       for (int index = start; index <= maxIndex; index++) {
-        if (_substringMatches(index, other)) {
+        if (this.codeUnitAt(index) == first &&
+            _substringMatches(index, other)) {
           return index;
         }
       }
@@ -663,7 +667,17 @@ abstract final class _StringBase implements String {
     int length = 0; // Length of all fragments.
     int replacementLength = replacement.length;
 
-    if (replacementLength == 0) {
+    if (pattern is _RegExp) {
+      // Only the match boundaries are needed, avoid allocating the matches.
+      pattern._forEachMatchRange(this, (int start, int end) {
+        length += _addReplaceSlice(matches, startIndex, start);
+        if (replacementLength != 0) {
+          matches.add(replacement);
+          length += replacementLength;
+        }
+        startIndex = end;
+      });
+    } else if (replacementLength == 0) {
       for (Match match in pattern.allMatches(this)) {
         length += _addReplaceSlice(matches, startIndex, match.start);
         startIndex = match.end;
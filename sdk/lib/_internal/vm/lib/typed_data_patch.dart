@@ -50,6 +50,10 @@ class ByteData implements TypedData {
   }
 }
 
+// The number of elements fillRange stores one by one before it copies the
+// elements already filled.
+const int _fillLoopLength = 16;
+
 // Based class for _TypedList that provides common methods for implementing
 // the collection and list interfaces.
 // This class does not extend ListBase<T> since that would add type arguments
@@ -137,6 +141,18 @@ abstract final class _TypedListBase {
 
   // Internal utility methods.
   void _fastSetRange(int start, int count, _TypedListBase from, int skipCount);
+
+  // Copies the elements in [start, start + filled), which must already hold
+  // the fill value, over the rest of [start, end). The filled part doubles
+  // each time, so long ranges are filled using bulk memory copies.
+  void _fillByDoubling(int start, int end, int filled) {
+    while (filled < end - start) {
+      final remaining = end - start - filled;
+      final count = remaining < filled ? remaining : filled;
+      _fastSetRange(start + filled, count, this, start);
+      filled += count;
+    }
+  }
   void _slowSetRange(int start, int end, Iterable from, int skipCount);
 
   @pragma("vm:prefer-inline")
@@ -472,9 +488,12 @@ base mixin _IntListMixin on _TypedListBase implements List<int> {
     if (fillValue == null) {
       throw ArgumentError.notNull("fillValue");
     }
-    for (var i = start; i < end; ++i) {
+    final loopEnd =
+        (end - start) > _fillLoopLength ? start + _fillLoopLength : end;
+    for (var i = start; i < loopEnd; ++i) {
       this[i] = fillValue;
     }
+    _fillByDoubling(start, end, loopEnd - start);
   }
 
   @pragma("vm:prefer-inline")
@@ -809,9 +828,12 @@ base mixin _DoubleListMixin on _TypedListBase implements List<double> {
     if (fillValue == null) {
       throw ArgumentError.notNull("fillValue");
     }
-    for (var i = start; i < end; ++i) {
+    final loopEnd =
+        (end - start) > _fillLoopLength ? start + _fillLoopLength : end;
+    for (var i = start; i < loopEnd; ++i) {
       this[i] = fillValue;
     }
+    _fillByDoubling(start, end, loopEnd - start);
   }
 
   @pragma("vm:prefer-inline")
@@ -88,7 +88,6 @@ class _BigIntImpl implements BigInt {
   static final _BigIntImpl _minusOne = -one;
   static final _BigIntImpl _oneDigitMask = new _BigIntImpl._fromInt(_digitMask);
   static final _BigIntImpl _twoDigitMask = (one << (2 * _digitBits)) - one;
-  static final _BigIntImpl _oneBillion = new _BigIntImpl._fromInt(1000000000);
   static const int _minInt = -0x8000000000000000;
   static const int _maxInt = 0x7fffffffffffffff;
 
@@ -177,9 +176,13 @@ class _BigIntImpl implements BigInt {
   static _BigIntImpl _parseDecimal(String source, bool isNegative) {
     const _0 = 48;
 
+    // Every part of 9 decimal digits adds less than 30 bits to the result.
+    int partCount = source.length ~/ 9 + 1;
+    var digits = _newDigits(partCount * 30 ~/ _digitBits + 1);
+    int used = 0;
     int part = 0;
-    _BigIntImpl result = zero;
-    // Read in the source 9 digits at a time.
+    // Read in the source 9 digits at a time, accumulating the result in
+    // place instead of allocating a new big integer for every part.
     // The first part may have a few leading virtual '0's to make the remaining
     // parts all have exactly 9 digits.
     int digitInPartCount = 9 - unsafeCast<int>(source.length.remainder(9));
@@ -187,13 +190,30 @@ class _BigIntImpl implements BigInt {
     for (int i = 0; i < source.length; i++) {
       part = part * 10 + source.codeUnitAt(i) - _0;
       if (++digitInPartCount == 9) {
-        result = result * _oneBillion + new _BigIntImpl._fromInt(part);
+        used = _mulAddSmall(digits, used, 1000000000, part);
         part = 0;
         digitInPartCount = 0;
       }
     }
-    if (isNegative) return -result;
-    return result;
+    if (used == 0) return zero;
+    return new _BigIntImpl._(isNegative, used, digits);
+  }
+
+  /// Replaces `digits[0..used-1]` by `digits[0..used-1] * multiplier + addend`
+  /// and returns the new number of used digits.
+  ///
+  /// The [multiplier] and [addend] must be less than 2^30, so that intermediate
+  /// values fit in 63 bits, and [digits] must have room for one more digit.
+  static int _mulAddSmall(
+      Uint32List digits, int used, int multiplier, int addend) {
+    int carry = addend;
+    for (int i = 0; i < used; i++) {
+      int t = digits[i] * multiplier + carry;
+      digits[i] = t & _digitMask;
+      carry = t >> _digitBits;
+    }
+    if (carry != 0) digits[used++] = carry;
+    return used;
   }
 
   /// Returns the value of a given source digit.
@@ -2462,12 +2482,23 @@ class _BigIntImpl implements BigInt {
       return _digits[0].toString();
     }
 
-    // Generate in chunks of 9 digits.
-    // The chunks are in reversed order.
+    // Generate in chunks of 9 digits by repeatedly dividing a copy of the
+    // magnitude by 10^9 in place. The chunks are in reversed order.
     var decimalDigitChunks = <String>[];
-    var rest = isNegative ? -this : this;
-    while (rest._used > 1) {
-      var digits9 = rest.remainder(_oneBillion).toString();
+    var restUsed = _used;
+    var restDigits = _cloneDigits(_digits, 0, _used, _used);
+    while (restUsed > 1) {
+      int remainder = 0;
+      for (int i = restUsed - 1; i >= 0; i--) {
+        // Since remainder < 10^9 < 2^30, t fits in 62 bits.
+        int t = (remainder << _digitBits) | restDigits[i];
+        int quotient = t ~/ 1000000000;
+        restDigits[i] = quotient;
+        remainder = t - quotient * 1000000000;
+      }
+      // 10^9 < 2^32, so the division removes at most one digit.
+      if (restDigits[restUsed - 1] == 0) restUsed--;
+      var digits9 = remainder.toString();
       decimalDigitChunks.add(digits9);
       var zeros = 9 - digits9.length;
       if (zeros == 8) {
@@ -2485,9 +2516,8 @@ class _BigIntImpl implements BigInt {
           decimalDigitChunks.add("0");
         }
       }
-      rest = rest ~/ _oneBillion;
     }
-    decimalDigitChunks.add(rest._digits[0].toString());
+    decimalDigitChunks.add(restDigits[0].toString());
     if (_isNegative) decimalDigitChunks.add("-");
     return decimalDigitChunks.reversed.join();
   }
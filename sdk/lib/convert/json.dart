@@ -1073,13 +1073,8 @@ class _JsonUtf8Stringifier extends _JsonStringifier {
 
   /// Write a string that is known to not have non-ASCII characters.
   void writeAsciiString(String string) {
-    // TODO(lrn): Optimize by copying directly into buffer instead of going
-    // through writeCharCode;
-    for (var i = 0; i < string.length; i++) {
-      var char = string.codeUnitAt(i);
-      assert(char <= 0x7f);
-      writeByte(char);
-    }
+    assert(string.codeUnits.every((char) => char <= 0x7f));
+    writeStringSlice(string, 0, string.length);
   }
 
   void writeString(String string) {
@@ -1087,36 +1082,63 @@ class _JsonUtf8Stringifier extends _JsonStringifier {
   }
 
   void writeStringSlice(String string, int start, int end) {
-    // TODO(lrn): Optimize by copying directly into buffer instead of going
-    // through writeCharCode/writeByte. Assumption is the most characters
-    // in strings are plain ASCII.
-    for (var i = start; i < end; i++) {
+    var i = start;
+    while (i < end) {
       var char = string.codeUnitAt(i);
       if (char <= 0x7f) {
-        writeByte(char);
-      } else {
-        if ((char & 0xF800) == 0xD800) {
-          // Surrogate.
-          if (char < 0xDC00 && i + 1 < end) {
-            // Lead surrogate.
-            var nextChar = string.codeUnitAt(i + 1);
-            if ((nextChar & 0xFC00) == 0xDC00) {
-              // Tail surrogate.
-              char = 0x10000 + ((char & 0x3ff) << 10) + (nextChar & 0x3ff);
-              writeFourByteCharCode(char);
-              i++;
-              continue;
-            }
+        // Assumption is that most characters in strings are plain ASCII.
+        i = _writeAsciiRun(string, i, end);
+        continue;
+      }
+      i++;
+      if ((char & 0xF800) == 0xD800) {
+        // Surrogate.
+        if (char < 0xDC00 && i < end) {
+          // Lead surrogate.
+          var nextChar = string.codeUnitAt(i);
+          if ((nextChar & 0xFC00) == 0xDC00) {
+            // Tail surrogate.
+            char = 0x10000 + ((char & 0x3ff) << 10) + (nextChar & 0x3ff);
+            writeFourByteCharCode(char);
+            i++;
+            continue;
           }
-          // Unpaired surrogate.
-          writeMultiByteCharCode(unicodeReplacementCharacterRune);
-          continue;
         }
-        writeMultiByteCharCode(char);
+        // Unpaired surrogate.
+        writeMultiByteCharCode(unicodeReplacementCharacterRune);
+        continue;
       }
+      writeMultiByteCharCode(char);
     }
   }
 
+  /// Copies the ASCII characters of [string] from [start] directly into the
+  /// buffer, stopping at [end], at the first non-ASCII character or when the
+  /// buffer is full.
+  ///
+  /// The character at [start] must be ASCII. Returns the index after the last
+  /// character written.
+  int _writeAsciiRun(String string, int start, int end) {
+    if (index == buffer.length) {
+      addChunk(buffer, 0, index);
+      buffer = Uint8List(bufferSize);
+      index = 0;
+    }
+    var bytes = buffer;
+    var position = index;
+    var limit = start + (bytes.length - position);
+    if (limit > end) limit = end;
+    var i = start;
+    do {
+      var char = string.codeUnitAt(i);
+      if (char > 0x7f) break;
+      bytes[position++] = char;
+      i++;
+    } while (i < limit);
+    index = position;
+    return i;
+  }
+
   void writeCharCode(int charCode) {
     if (charCode <= 0x7f) {
       writeByte(charCode);
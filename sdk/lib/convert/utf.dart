@@ -103,9 +103,24 @@ final class Utf8Encoder extends Converter<String, List<int>> {
     end = RangeError.checkValidRange(start, end, stringLength);
     var length = end - start;
     if (length == 0) return Uint8List(0);
+    // ASCII has the same representation in UTF-8 and UTF-16, so as long as
+    // the string is ASCII it encodes to exactly one byte per code unit.
+    var asciiLength = 0;
+    while (asciiLength < length &&
+        string.codeUnitAt(start + asciiLength) <= _ONE_BYTE_LIMIT) {
+      asciiLength++;
+    }
+    if (asciiLength == length) {
+      var ascii = Uint8List(length);
+      for (var i = 0; i < length; i++) {
+        ascii[i] = string.codeUnitAt(start + i);
+      }
+      return ascii;
+    }
     // Create a new encoder with a length that is guaranteed to be big enough.
     // A single code unit uses at most 3 bytes, a surrogate pair at most 4.
-    var encoder = _Utf8Encoder.withBufferSize(length * 3);
+    var encoder =
+        _Utf8Encoder.withBufferSize(asciiLength + (length - asciiLength) * 3);
     var endPosition = encoder._fillBuffer(string, start, end);
     assert(endPosition >= end - 1);
     if (endPosition != end) {
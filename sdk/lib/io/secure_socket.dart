@@ -650,6 +650,7 @@ class _RawSecureSocket extends Stream<RawSocketEvent>
           SecurityContext._protocolsToLengthEncoding(supportedProtocols);
       secureFilter.connect(
           address.host,
+          _socket.remotePort,
           context,
           isServer,
           requestClientCertificate || requireClientCertificate,
@@ -1341,6 +1342,7 @@ abstract class _SecureFilter {
 
   void connect(
       String hostName,
+      int port,
       SecurityContext context,
       bool isServer,
       bool requestClientCertificate,
@@ -0,0 +1,55 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Verifies that concurrent lookups of the same host, which share a single
+// resolver call, each get the full result, including when the lookup fails.
+
+import "dart:io";
+
+import "package:async_helper/async_helper.dart";
+import "package:expect/expect.dart";
+
+const lookupCount = 32;
+
+Future<void> testSameHost() async {
+  final expected = await InternetAddress.lookup("localhost");
+  Expect.isTrue(expected.isNotEmpty);
+  final results = await Future.wait([
+    for (int i = 0; i < lookupCount; i++) InternetAddress.lookup("localhost"),
+  ]);
+  for (final result in results) {
+    Expect.setEquals(
+        expected.map((a) => a.address), result.map((a) => a.address));
+  }
+}
+
+Future<void> testSameHostByType() async {
+  final results = await Future.wait([
+    for (int i = 0; i < lookupCount; i++)
+      InternetAddress.lookup("localhost",
+          type: i.isEven ? InternetAddressType.IPv4 : InternetAddressType.any),
+  ]);
+  for (int i = 0; i < lookupCount; i += 2) {
+    Expect.isTrue(results[i].every((a) => a.type == InternetAddressType.IPv4));
+  }
+}
+
+Future<void> testSameBadHost() async {
+  final lookups = [
+    for (int i = 0; i < lookupCount; i++)
+      InternetAddress.lookup("some.bad.host.name.7654321")
+          .then<Object?>((_) => null, onError: (e) => e),
+  ];
+  for (final error in await Future.wait(lookups)) {
+    Expect.type<SocketException>(error);
+  }
+}
+
+void main() {
+  asyncTest(() async {
+    await testSameHost();
+    await testSameHostByType();
+    await testSameBadHost();
+  });
+}
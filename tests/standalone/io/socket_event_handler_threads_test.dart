@@ -0,0 +1,67 @@
+// Copyright (c) 2026, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+//
+// Test echoing over many connections while their descriptors are spread
+// across several event handler threads.
+//
+// VMOptions=--event-handler-threads=4
+// VMOptions=--event-handler-threads=4 --short_socket_read --short_socket_write
+
+import "dart:async";
+import "dart:io";
+
+import "package:async_helper/async_helper.dart";
+import "package:expect/expect.dart";
+
+const connectionsCount = 64;
+const messageSize = 10000;
+
+Future<void> echoOnce(int port, int id) async {
+  final socket = await Socket.connect(InternetAddress.loopbackIPv4, port);
+  final message = List<int>.generate(messageSize, (i) => (i + id) & 0xff);
+  final received = <int>[];
+  final done = socket.listen(received.addAll).asFuture<void>();
+  socket.add(message);
+  await socket.close();
+  await done;
+  Expect.listEquals(message, received);
+}
+
+Future<void> testEcho() async {
+  final server = await ServerSocket.bind(InternetAddress.loopbackIPv4, 0);
+  server.listen((client) {
+    client.cast<List<int>>().pipe(client);
+  });
+  await Future.wait([
+    for (int i = 0; i < connectionsCount; i++) echoOnce(server.port, i),
+  ]);
+  await server.close();
+}
+
+Future<void> testTimersWhileConnecting() async {
+  final server = await ServerSocket.bind(InternetAddress.loopbackIPv4, 0);
+  server.listen((client) => client.destroy());
+  final ticks = Completer<void>();
+  int count = 0;
+  Timer.periodic(const Duration(milliseconds: 1), (timer) {
+    if (++count == 20) {
+      timer.cancel();
+      ticks.complete();
+    }
+  });
+  for (int i = 0; i < connectionsCount; i++) {
+    final socket =
+        await Socket.connect(InternetAddress.loopbackIPv4, server.port);
+    socket.destroy();
+  }
+  await ticks.future;
+  await server.close();
+}
+
+void main() {
+  asyncTest(() async {
+    await testEcho();
+    await testTimersWhileConnecting();
+  });
+}